@@ -0,0 +1,135 @@
+#!/usr/bin/env python3
+#
+# Copyright (c) 2024 The ZMK Contributors
+# SPDX-License-Identifier: MIT
+#
+# Pre-render the digits of an lv_font_conv generated LVGL font (.c) into
+# a fixed-cell A8 atlas for digit_label (CONFIG_PROSPECTOR_DIGIT_ATLAS).
+#
+# Every character becomes one cell of the same size: the widest advance
+# of the set by the font's line height, with the glyph placed on the
+# baseline the way LVGL's text renderer would. Cells are stored one after
+# the other, so each is a complete A8 image of its own.
+#
+# Usage:
+#   lvgl_digit_atlas.py --chars "0123456789/-" \
+#       -o out/digit_atlas_FR_Regular_30.c src/fonts_carrefinho/FR_Regular_30.c
+
+import argparse
+import os
+import re
+import sys
+
+sys.path.insert(0, os.path.dirname(os.path.abspath(__file__)))
+from lvgl_font_subset import format_numbers, parse_glyphs  # noqa: E402
+
+DSC_FIELD = re.compile(r"\.(adv_w|box_w|box_h|ofs_x|ofs_y) = (-?\d+)")
+
+
+def fail(msg):
+    sys.exit(f"lvgl_digit_atlas: {msg}")
+
+
+def font_field(src, name):
+    m = re.search(r"\." + name + r" = (-?\d+)", src)
+    if not m:
+        fail(f".{name} not found")
+    return int(m.group(1))
+
+
+def unpack(data, count, bpp):
+    """Plain (uncompressed) glyph bitmap: pixels packed MSB first, no row padding"""
+    mask = (1 << bpp) - 1
+    pixels = []
+    for i in range(count):
+        bit = i * bpp
+        byte = data[bit // 8]
+        pixels.append((byte >> (8 - bpp - bit % 8)) & mask)
+    return [p * 255 // mask for p in pixels]
+
+
+def render(src, chars):
+    if font_field(src, "bitmap_format") != 0:
+        fail("compressed fonts are not supported (regenerate with --no-compress)")
+    bpp = font_field(src, "bpp")
+    line_height = font_field(src, "line_height")
+    base_line = font_field(src, "base_line")
+
+    glyphs = {}
+    for cp, data, tail in parse_glyphs(src):
+        glyphs[cp] = (data, dict((k, int(v)) for k, v in DSC_FIELD.findall(tail)))
+    missing = [c for c in chars if ord(c) not in glyphs]
+    if missing:
+        fail(f"glyphs not in the font: {''.join(missing)!r}")
+
+    dscs = [glyphs[ord(c)][1] for c in chars]
+    cell_w = max(max((d["adv_w"] + 15) // 16, d["ofs_x"] + d["box_w"]) for d in dscs)
+    cell_h = line_height
+
+    cells = []
+    for c in chars:
+        data, d = glyphs[ord(c)]
+        cell = [0] * (cell_w * cell_h)
+        pixels = unpack(data, d["box_w"] * d["box_h"], bpp) if data else []
+        top = line_height - base_line - d["box_h"] - d["ofs_y"]
+        for y in range(d["box_h"]):
+            for x in range(d["box_w"]):
+                cx, cy = d["ofs_x"] + x, top + y
+                if 0 <= cx < cell_w and 0 <= cy < cell_h:
+                    cell[cy * cell_w + cx] = pixels[y * d["box_w"] + x]
+        cells.append(cell)
+    return cell_w, cell_h, cells
+
+
+def c_string(chars):
+    return '"' + chars.replace("\\", "\\\\").replace('"', '\\"') + '"'
+
+
+def emit(font, chars, cell_w, cell_h, cells):
+    out = [
+        "/*\n",
+        f" * Generated by scripts/lvgl_digit_atlas.py from {font}.c - do not edit\n",
+        f" * {len(chars)} cells of {cell_w}x{cell_h} A8: {chars}\n",
+        " */\n\n",
+        '#include "digit_label.h"\n\n',
+        f"static const uint8_t atlas_map[{len(chars)} * {cell_w} * {cell_h}] = {{\n",
+    ]
+    for c, cell in zip(chars, cells):
+        out.append(f"    /* {c_string(c)} */\n")
+        out.append(format_numbers(cell, per_line=cell_w, fmt="0x{:02x}") + ",\n")
+    out.append("};\n\n")
+    out.append("static const lv_image_dsc_t atlas_glyphs[] = {\n")
+    for i in range(len(chars)):
+        out.append(f"    DIGIT_ATLAS_GLYPH(atlas_map, {i}, {cell_w}, {cell_h}),\n")
+    out.append("};\n\n")
+    out.append(f"const struct digit_atlas digit_atlas_{font} = {{\n")
+    out.append(f"    .chars = {c_string(chars)},\n")
+    out.append(f"    .cell_w = {cell_w},\n")
+    out.append(f"    .cell_h = {cell_h},\n")
+    out.append("    .glyphs = atlas_glyphs,\n")
+    out.append("};\n")
+    return "".join(out)
+
+
+def main():
+    ap = argparse.ArgumentParser(description=__doc__)
+    ap.add_argument("input")
+    ap.add_argument("-o", "--output", required=True)
+    ap.add_argument("--chars", required=True, help="characters to pre-render, in atlas order")
+    args = ap.parse_args()
+
+    if len(set(args.chars)) != len(args.chars):
+        fail("--chars has duplicates")
+    with open(args.input, encoding="utf-8") as f:
+        src = f.read()
+
+    font = os.path.basename(args.input).rsplit(".", 1)[0]
+    cell_w, cell_h, cells = render(src, args.chars)
+    with open(args.output, "w", encoding="utf-8") as f:
+        f.write(emit(font, args.chars, cell_w, cell_h, cells))
+    print(f"{font}: {len(cells)} cells of {cell_w}x{cell_h}, "
+          f"{len(cells) * cell_w * cell_h} bytes")
+
+
+if __name__ == "__main__":
+    main()
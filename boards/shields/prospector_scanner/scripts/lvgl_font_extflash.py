@@ -0,0 +1,159 @@
+#!/usr/bin/env python3
+#
+# Copyright (c) 2024 The ZMK Contributors
+# SPDX-License-Identifier: MIT
+#
+# Move the glyph bitmaps of lv_font_conv generated LVGL fonts (.c) into
+# one image for the font_storage flash partition
+# (CONFIG_PROSPECTOR_FONT_EXT_FLASH).
+#
+# Each font is rewritten without its glyph_bitmap[] array: the descriptor,
+# character maps and kerning stay in internal flash, and the font gets
+# font_storage_get_glyph_bitmap() plus the location of its bitmaps in the
+# image. The image is a 16-byte header (magic, version, payload size,
+# CRC-32 of the payload) followed by the fonts' bitmaps, 4-byte aligned.
+# The header written next to the fonts lets the firmware check that the
+# programmed image is the one it was built with.
+#
+# Usage:
+#   lvgl_font_extflash.py -o out/ --image out/font_storage --base 0x12000000 \
+#       --max-size 0x80000 src/fonts_carrefinho/FR_Regular_36.c ...
+#
+# writes out/<font>.c, out/font_storage_image.h, and the image as
+# font_storage.bin and font_storage.hex (Intel HEX at --base).
+
+import argparse
+import os
+import re
+import struct
+import sys
+import zlib
+
+sys.path.insert(0, os.path.dirname(os.path.abspath(__file__)))
+from lvgl_font_subset import array_body, numbers  # noqa: E402
+
+MAGIC = 0x544E4650  # "PFNT"
+VERSION = 1
+HEADER = struct.Struct("<IHHII")
+
+
+def fail(msg):
+    sys.exit(f"lvgl_font_extflash: {msg}")
+
+
+def replace_once(src, pattern, repl, what):
+    out, count = re.subn(pattern, repl, src, count=1, flags=re.M)
+    if count != 1:
+        fail(f"{what} not found")
+    return out
+
+
+def externalize(src, offset):
+    """(rewritten source, bitmap bytes, glyph count, largest glyph in bytes)"""
+    span = array_body(src, "glyph_bitmap")
+    if not span:
+        fail("glyph_bitmap[] not found")
+    bitmap = bytes(numbers(src[span[0]:span[1]]))
+
+    span = array_body(src, "glyph_dsc")
+    if not span:
+        fail("glyph_dsc[] not found")
+    index = [int(i) for i in re.findall(r"\.bitmap_index = (\d+)", src[span[0]:span[1]])]
+    ends = index[2:] + [len(bitmap)]
+    largest = max((end - start for start, end in zip(index[1:], ends)), default=0)
+
+    decl = re.search(r"^static [^\n]*\bglyph_bitmap\[\] = \{", src, flags=re.M)
+    end = src.index("};", decl.end()) + len("};")
+    src = (src[:decl.start()] +
+           f"/*In the font_storage partition (scripts/lvgl_font_extflash.py)*/\n"
+           f"static const struct font_storage_src font_storage_src = {{\n"
+           f"    .offset = {offset},\n"
+           f"    .size = {len(bitmap)},\n"
+           f"    .glyph_count = {len(index)},\n"
+           f"}};" + src[end:])
+
+    src = replace_once(src, r"(^#include [<\"]lvgl\.h[>\"]\n)", r'\1#include "font_storage.h"\n',
+                       "lvgl.h include")
+    src = replace_once(src, r"\.glyph_bitmap = glyph_bitmap,", ".glyph_bitmap = NULL,",
+                       ".glyph_bitmap")
+    src = replace_once(src, r"\.get_glyph_bitmap = lv_font_get_bitmap_fmt_txt,",
+                       ".get_glyph_bitmap = font_storage_get_glyph_bitmap,", ".get_glyph_bitmap")
+    src = replace_once(src, r"\.user_data = NULL,", ".user_data = (void *)&font_storage_src,",
+                       ".user_data")
+    return src, bitmap, len(index), largest
+
+
+def ihex_record(kind, address, data):
+    rec = bytes([len(data), (address >> 8) & 0xFF, address & 0xFF, kind]) + data
+    return ":" + (rec + bytes([-sum(rec) & 0xFF])).hex().upper() + "\n"
+
+
+def write_ihex(path, base, image):
+    out = []
+    upper = None
+    for pos in range(0, len(image), 16):
+        address = base + pos
+        if address >> 16 != upper:
+            upper = address >> 16
+            out.append(ihex_record(4, 0, struct.pack(">H", upper)))
+        out.append(ihex_record(0, address & 0xFFFF, image[pos:pos + 16]))
+    out.append(ihex_record(1, 0, b""))
+    with open(path, "w", encoding="ascii") as f:
+        f.write("".join(out))
+
+
+def emit_header(size, crc, largest):
+    return (
+        "/*\n"
+        " * Generated by scripts/lvgl_font_extflash.py - do not edit\n"
+        " */\n\n"
+        "#pragma once\n\n"
+        f"#define FONT_STORAGE_MAGIC      0x{MAGIC:08X}\n"
+        f"#define FONT_STORAGE_VERSION    {VERSION}\n"
+        f"#define FONT_STORAGE_IMAGE_SIZE {size}\n"
+        f"#define FONT_STORAGE_IMAGE_CRC  0x{crc:08X}\n"
+        f"#define FONT_STORAGE_MAX_GLYPH  {largest}\n")
+
+
+def main():
+    ap = argparse.ArgumentParser(description=__doc__)
+    ap.add_argument("inputs", nargs="+")
+    ap.add_argument("-o", "--output-dir", required=True)
+    ap.add_argument("--image", required=True, help="image path without extension")
+    ap.add_argument("--base", type=lambda v: int(v, 0), default=0,
+                    help="address of the partition in the Intel HEX output")
+    ap.add_argument("--max-size", type=lambda v: int(v, 0), default=0,
+                    help="partition size: fail if the image does not fit")
+    args = ap.parse_args()
+
+    payload = bytearray()
+    largest = 0
+    for path in args.inputs:
+        with open(path, encoding="utf-8") as f:
+            src = f.read()
+        name = os.path.basename(path)
+        offset = HEADER.size + len(payload)
+        out, bitmap, glyphs, biggest = externalize(src, offset)
+        payload += bitmap + bytes(-len(bitmap) % 4)
+        largest = max(largest, biggest)
+        with open(os.path.join(args.output_dir, name), "w", encoding="utf-8") as f:
+            f.write(out)
+        print(f"{name}: {glyphs - 1} glyphs, {len(bitmap)} bytes at 0x{offset:x}")
+
+    crc = zlib.crc32(payload)
+    image = HEADER.pack(MAGIC, VERSION, 0, len(payload), crc) + payload
+    if args.max_size and len(image) > args.max_size:
+        fail(f"image is {len(image)} bytes, partition {args.max_size}")
+
+    with open(os.path.join(args.output_dir, "font_storage_image.h"), "w",
+              encoding="utf-8") as f:
+        f.write(emit_header(len(payload), crc, largest))
+    with open(args.image + ".bin", "wb") as f:
+        f.write(image)
+    write_ihex(args.image + ".hex", args.base, image)
+    print(f"font_storage: {len(image)} bytes, largest glyph {largest} bytes, "
+          f"crc 0x{crc:08x}")
+
+
+if __name__ == "__main__":
+    main()
@@ -0,0 +1,267 @@
+#!/usr/bin/env python3
+#
+# Copyright (c) 2024 The ZMK Contributors
+# SPDX-License-Identifier: MIT
+#
+# Subset an lv_font_conv generated LVGL font (.c) to the glyphs a layout
+# actually renders (CONFIG_PROSPECTOR_FONT_SUBSET).
+#
+# The source TTFs are not part of the module, so this works on the
+# generated C: it keeps the requested glyphs' bitmaps and descriptors,
+# rebuilds the character maps, and remaps kerning (class mappings or
+# pairs) to the new glyph ids. Everything else is copied through.
+#
+# Usage:
+#   lvgl_font_subset.py --chars "BASE0123456789" --codepoints 0x2D,0x100194-0x100195 \
+#       -o out/FR_Regular_36.c src/fonts_carrefinho/FR_Regular_36.c
+#
+# --chars and --codepoints may be given several times; --all keeps the
+# whole font (the file is copied unchanged).
+
+import argparse
+import re
+import sys
+
+# A run of consecutive codepoints this long gets its own FORMAT0_TINY map;
+# shorter runs go into sparse maps (a map entry costs ~20 bytes, a sparse
+# code 2 bytes)
+MIN_RANGE_RUN = 8
+
+NUM = re.compile(r"-?0x[0-9a-fA-F]+|-?\d+")
+
+
+def fail(msg):
+    sys.exit(f"lvgl_font_subset: {msg}")
+
+
+def parse_codepoints(spec):
+    cps = set()
+    for part in spec.split(","):
+        part = part.strip()
+        if not part:
+            continue
+        if "-" in part:
+            lo, hi = part.split("-", 1)
+            cps.update(range(int(lo, 0), int(hi, 0) + 1))
+        else:
+            cps.add(int(part, 0))
+    return cps
+
+
+def array_body(src, name):
+    """Span (start, end) of the initializer body of `name[] = { ... };`"""
+    m = re.search(r"\b" + re.escape(name) + r"\[\]\s*=\s*\{", src)
+    if not m:
+        return None
+    end = src.index("};", m.end())
+    return m.end(), end
+
+
+def numbers(text):
+    text = re.sub(r"/\*.*?\*/", "", text, flags=re.S)
+    return [int(n, 0) for n in NUM.findall(text)]
+
+
+def format_numbers(values, per_line=8, fmt="{}"):
+    lines = []
+    for i in range(0, len(values), per_line):
+        lines.append("    " + ", ".join(fmt.format(v) for v in values[i:i + per_line]))
+    return ",\n".join(lines)
+
+
+def section_span(src, title):
+    """Span of a lv_font_conv section: from just after its header to the next header"""
+    m = re.search(r"/\*-+\n \*\s+" + re.escape(title) + r"\n \*-+\*/\n", src)
+    if not m:
+        fail(f"section {title} not found")
+    nxt = re.search(r"\n/\*-+\n \*\s+[A-Z ]+\n \*-+\*/", src[m.end():])
+    return m.end(), m.end() + nxt.start() + 1
+
+
+def parse_glyphs(src):
+    """[(codepoint, [bitmap bytes], descriptor tail)] in glyph id order (id 1..n)"""
+    start, end = array_body(src, "glyph_bitmap")
+    body = src[start:end]
+    marks = list(re.finditer(r"/\* U\+([0-9A-Fa-f]+) .*?\*/", body))
+    bitmaps = []
+    for i, m in enumerate(marks):
+        block_end = marks[i + 1].start() if i + 1 < len(marks) else len(body)
+        bitmaps.append((int(m.group(1), 16), numbers(body[m.end():block_end])))
+
+    start, end = array_body(src, "glyph_dsc")
+    dscs = re.findall(r"\{\.bitmap_index = (\d+), (.*?)\}", src[start:end])
+    if len(dscs) != len(bitmaps) + 1:
+        fail(f"{len(dscs) - 1} glyph descriptors for {len(bitmaps)} bitmaps")
+
+    glyphs = []
+    offset = 0
+    prev_cp = -1
+    for (cp, data), (index, tail) in zip(bitmaps, dscs[1:]):
+        if int(index) != offset and data:
+            fail(f"U+{cp:04X}: bitmap_index {index}, expected {offset}")
+        if cp <= prev_cp:
+            fail(f"glyphs not in codepoint order at U+{cp:04X}")
+        glyphs.append((cp, data, tail))
+        offset += len(data)
+        prev_cp = cp
+    return glyphs
+
+
+def split_runs(cps):
+    """Sorted codepoints as lists of consecutive runs"""
+    runs = []
+    for cp in cps:
+        if runs and cp == runs[-1][-1] + 1:
+            runs[-1].append(cp)
+        else:
+            runs.append([cp])
+    return runs
+
+
+def build_cmaps(cps):
+    """Split sorted codepoints into (start, [codes], sparse) maps with consecutive glyph ids"""
+    maps = []
+    for run in split_runs(cps):
+        if len(run) >= MIN_RANGE_RUN:
+            maps.append((run[0], run, False))
+        elif maps and maps[-1][2] and run[-1] - maps[-1][0] < 0x10000:
+            maps[-1][1].extend(run)
+        else:
+            maps.append((run[0], list(run), True))
+    return maps
+
+
+def emit_cmaps(maps):
+    out = ["\n"]
+    for i, (start, codes, sparse) in enumerate(maps):
+        if sparse and len(codes) > 1:
+            ofs = [c - start for c in codes]
+            out.append(f"static const uint16_t unicode_list_{i}[] = {{\n")
+            out.append(format_numbers(ofs, fmt="0x{:x}") + "\n};\n\n")
+    out.append("/*Collect the unicode lists and glyph_id offsets*/\n")
+    out.append("static const lv_font_fmt_txt_cmap_t cmaps[] =\n{\n")
+    entries = []
+    glyph_id = 1
+    for i, (start, codes, sparse) in enumerate(maps):
+        length = codes[-1] - start + 1
+        if sparse and len(codes) > 1:
+            ulist, count, kind = f"unicode_list_{i}", len(codes), "SPARSE_TINY"
+        else:
+            ulist, count, kind = "NULL", 0, "FORMAT0_TINY"
+        entries.append(
+            "    {\n"
+            f"        .range_start = {start}, .range_length = {length}, "
+            f".glyph_id_start = {glyph_id},\n"
+            f"        .unicode_list = {ulist}, .glyph_id_ofs_list = NULL, "
+            f".list_length = {count}, .type = LV_FONT_FMT_TXT_CMAP_{kind}\n"
+            "    }")
+        glyph_id += len(codes)
+    out.append(",\n".join(entries) + "\n};\n\n")
+    return "".join(out)
+
+
+def replace_array(src, name, values, fmt="{}"):
+    span = array_body(src, name)
+    if not span:
+        return src
+    start, end = span
+    return src[:start] + "\n" + format_numbers(values, fmt=fmt) + "\n" + src[end:]
+
+
+def subset(src, keep):
+    glyphs = parse_glyphs(src)
+    kept = [(old_id, g) for old_id, g in enumerate(glyphs, 1) if g[0] in keep]
+    if not kept:
+        fail("no requested glyph is in the font")
+    new_id = {old_id: i for i, (old_id, _) in enumerate(kept, 1)}
+
+    # Bitmaps and descriptors
+    bitmap_lines = []
+    dsc_lines = ["    {.bitmap_index = 0, .adv_w = 0, .box_w = 0, .box_h = 0, "
+                 ".ofs_x = 0, .ofs_y = 0} /* id = 0 reserved */"]
+    offset = 0
+    for _, (cp, data, tail) in kept:
+        label = chr(cp) if 0x20 < cp < 0x7F and chr(cp) not in "\\\"" else ""
+        bitmap_lines.append(f"    /* U+{cp:04X} \"{label}\" */")
+        if data:
+            bitmap_lines.append(format_numbers(data, fmt="0x{:x}") + ",")
+        bitmap_lines.append("")
+        dsc_lines.append(f"    {{.bitmap_index = {offset}, {tail}}}")
+        offset += len(data)
+    start, end = array_body(src, "glyph_bitmap")
+    src = src[:start] + "\n" + "\n".join(bitmap_lines) + "\n" + src[end:]
+    start, end = array_body(src, "glyph_dsc")
+    src = src[:start] + "\n" + ",\n".join(dsc_lines) + "\n" + src[end:]
+
+    # Character maps
+    maps = build_cmaps([cp for _, (cp, _, _) in kept])
+    start, end = section_span(src, "CHARACTER MAPPING")
+    src = src[:start] + emit_cmaps(maps) + src[end:]
+    src = re.sub(r"\.cmap_num = \d+", f".cmap_num = {len(maps)}", src)
+
+    # Kerning classes are per glyph id: keep the kept glyphs' entries
+    for name in ("kern_left_class_mapping", "kern_right_class_mapping"):
+        span = array_body(src, name)
+        if span:
+            old = numbers(src[span[0]:span[1]])
+            src = replace_array(src, name, [old[0]] + [old[o] for o, _ in kept])
+
+    # Kerning pairs: keep pairs of kept glyphs, renumbered
+    span = array_body(src, "kern_pair_glyph_ids")
+    if span:
+        ids = numbers(src[span[0]:span[1]])
+        vals = numbers(src[slice(*array_body(src, "kern_pair_values"))])
+        pairs = [(new_id[ids[2 * i]], new_id[ids[2 * i + 1]], vals[i])
+                 for i in range(len(vals))
+                 if ids[2 * i] in new_id and ids[2 * i + 1] in new_id]
+        wide = len(kept) > 255
+        flat = [x for left, right, _ in pairs for x in (left, right)] or [0, 0]
+        src = replace_array(src, "kern_pair_glyph_ids", flat)
+        src = replace_array(src, "kern_pair_values", [v for _, _, v in pairs] or [0])
+        src = re.sub(r"static const uint(8|16)_t kern_pair_glyph_ids\[\]",
+                     f"static const uint{16 if wide else 8}_t kern_pair_glyph_ids[]", src)
+        src = re.sub(r"\.pair_cnt = \d+", f".pair_cnt = {len(pairs)}", src)
+        src = re.sub(r"\.glyph_ids_size = \d+", f".glyph_ids_size = {int(wide)}", src)
+
+    return src, len(glyphs), len(kept), sum(len(g[1]) for g in glyphs), offset
+
+
+def main():
+    ap = argparse.ArgumentParser(description=__doc__)
+    ap.add_argument("input")
+    ap.add_argument("-o", "--output", required=True)
+    ap.add_argument("--chars", action="append", default=[],
+                    help="literal characters to keep")
+    ap.add_argument("--codepoints", action="append", default=[],
+                    help="comma-separated codepoints or ranges (0x20-0x7E)")
+    ap.add_argument("--all", action="store_true", help="keep every glyph")
+    args = ap.parse_args()
+
+    with open(args.input, encoding="utf-8") as f:
+        src = f.read()
+
+    keep = set()
+    for chars in args.chars:
+        keep.update(ord(c) for c in chars)
+    for spec in args.codepoints:
+        keep.update(parse_codepoints(spec))
+
+    name = args.input.rsplit("/", 1)[-1]
+    if args.all or not keep:
+        out = src
+        print(f"{name}: kept whole font")
+    else:
+        keep.add(0x20)  # Space is always needed for layout
+        out, total, kept, old_bytes, new_bytes = subset(src, keep)
+        note = ",".join(f"0x{r[0]:X}" if len(r) == 1 else f"0x{r[0]:X}-0x{r[-1]:X}"
+                        for r in split_runs(sorted(keep)))
+        banner_end = " " + "*" * 78 + "/"
+        out = out.replace(banner_end, f" * Subset: {note}\n{banner_end}", 1)
+        print(f"{name}: {kept}/{total} glyphs, bitmap {old_bytes} -> {new_bytes} bytes")
+
+    with open(args.output, "w", encoding="utf-8") as f:
+        f.write(out)
+
+
+if __name__ == "__main__":
+    main()
@@ -0,0 +1,128 @@
+/*
+ * Copyright (c) 2024 The ZMK Contributors
+ *
+ * SPDX-License-Identifier: MIT
+ *
+ * Backlight fade engine - see backlight_fade.h
+ *
+ * Levels are in 1/10000 units. The backlight circuit is inverted (as in
+ * set_pwm_brightness()): light = 10000 - duty. The ramp is spaced evenly
+ * in sqrt(light), which looks even to the eye, unlike equal duty steps
+ * that rush through the bright end and crawl through the dark one.
+ *
+ * The ISR calls pwm_set_dt() directly; the nRF PWM driver only updates
+ * the sequence buffer there, which is safe in interrupt context.
+ */
+
+#include <zephyr/kernel.h>
+#include <zephyr/device.h>
+#include <zephyr/drivers/pwm.h>
+#include <zephyr/logging/log.h>
+
+#include "backlight_fade.h"
+
+LOG_MODULE_DECLARE(zmk, CONFIG_ZMK_LOG_LEVEL);
+
+#define BACKLIGHT_PWM_NODE DT_NODELABEL(backlight)
+
+#if !DT_NODE_HAS_STATUS(BACKLIGHT_PWM_NODE, okay)
+#error "CONFIG_PROSPECTOR_BACKLIGHT_HW_FADE needs a 'backlight' pwm-leds child node"
+#endif
+
+#define FADE_TICK_MS 8       /* ~125 steps per second */
+#define FADE_MAX_STEPS 128
+#define LEVEL_MAX 10000
+
+static const struct pwm_dt_spec backlight_pwm = PWM_DT_SPEC_GET(BACKLIGHT_PWM_NODE);
+
+/* Written by the thread while the timer is stopped, read by the ISR */
+static uint32_t ramp[FADE_MAX_STEPS];
+static uint8_t ramp_len;
+static uint8_t ramp_pos;
+
+static uint32_t pulse_now;        /* Last pulse width written (ns), ISR-owned while fading */
+static bool pulse_known = false;  /* False until the first write: boot level is not ours */
+
+static uint32_t isqrt32(uint32_t n) {
+    uint32_t x = n;
+    uint32_t y = (x + 1) / 2;
+    while (y < x) {
+        x = y;
+        y = (x + n / x) / 2;
+    }
+    return x;
+}
+
+static uint32_t pulse_from_brightness(uint8_t brightness) {
+    uint32_t duty = LEVEL_MAX - (uint32_t)CLAMP(brightness, 1, 100) * (LEVEL_MAX / 100);
+    return (uint32_t)((uint64_t)backlight_pwm.period * duty / LEVEL_MAX);
+}
+
+/* Perceived lightness (0..LEVEL_MAX) of a pulse width */
+static uint32_t lightness_from_pulse(uint32_t pulse) {
+    uint32_t duty = (uint32_t)((uint64_t)pulse * LEVEL_MAX / backlight_pwm.period);
+    uint32_t light = LEVEL_MAX - MIN(duty, LEVEL_MAX);
+    return isqrt32(light * LEVEL_MAX);
+}
+
+static uint32_t pulse_from_lightness(uint32_t lightness) {
+    uint32_t light = lightness * lightness / LEVEL_MAX;
+    return (uint32_t)((uint64_t)backlight_pwm.period * (LEVEL_MAX - light) / LEVEL_MAX);
+}
+
+static void pwm_write(uint32_t pulse) {
+    pwm_set_dt(&backlight_pwm, backlight_pwm.period, pulse);
+    pulse_now = pulse;
+}
+
+static void fade_timer_cb(struct k_timer *timer) {
+    pwm_write(ramp[ramp_pos++]);
+    if (ramp_pos >= ramp_len) {
+        k_timer_stop(timer);
+    }
+}
+
+K_TIMER_DEFINE(fade_timer, fade_timer_cb, NULL);
+
+void backlight_fade_set(uint8_t brightness) {
+    if (!pwm_is_ready_dt(&backlight_pwm)) {
+        return;
+    }
+    k_timer_stop(&fade_timer);
+    pwm_write(pulse_from_brightness(brightness));
+    pulse_known = true;
+}
+
+void backlight_fade_to(uint8_t brightness) {
+    if (!pwm_is_ready_dt(&backlight_pwm)) {
+        LOG_WRN("Backlight PWM not ready");
+        return;
+    }
+    k_timer_stop(&fade_timer);
+
+    uint32_t target = pulse_from_brightness(brightness);
+    if (!pulse_known) {
+        backlight_fade_set(brightness);
+        return;
+    }
+    if (target == pulse_now) {
+        return;
+    }
+
+    uint32_t from = lightness_from_pulse(pulse_now);
+    uint32_t to = lightness_from_pulse(target);
+    int steps = CLAMP(CONFIG_PROSPECTOR_BRIGHTNESS_FADE_DURATION_MS / FADE_TICK_MS, 1,
+                      FADE_MAX_STEPS);
+
+    for (int i = 1; i < steps; i++) {
+        int32_t delta = ((int32_t)to - (int32_t)from) * i / steps;
+        ramp[i - 1] = pulse_from_lightness((uint32_t)((int32_t)from + delta));
+    }
+    ramp[steps - 1] = target;  /* Land exactly, whatever the rounding did */
+    ramp_len = (uint8_t)steps;
+    ramp_pos = 0;
+
+    uint32_t tick_ms = MAX(CONFIG_PROSPECTOR_BRIGHTNESS_FADE_DURATION_MS / steps, 1);
+    k_timer_start(&fade_timer, K_MSEC(tick_ms), K_MSEC(tick_ms));
+    LOG_DBG("Backlight fade to %u%%: %d steps of %u ms", brightness, steps, tick_ms);
+}
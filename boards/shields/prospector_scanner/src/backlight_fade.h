@@ -0,0 +1,25 @@
+/*
+ * Copyright (c) 2024 The ZMK Contributors
+ *
+ * SPDX-License-Identifier: MIT
+ *
+ * Timer-driven backlight fades (CONFIG_PROSPECTOR_BACKLIGHT_HW_FADE)
+ *
+ * The caller only hands over a target. The ramp from the current level is
+ * computed once, evenly spaced in perceived lightness (gamma 2), and a
+ * k_timer ISR writes one pulse width per tick straight to the PWM
+ * channel, so a fade costs the LVGL thread nothing after it started.
+ */
+
+#pragma once
+
+#include <stdint.h>
+
+/* LVGL thread: fade to @p brightness (1-100 %) over
+ * CONFIG_PROSPECTOR_BRIGHTNESS_FADE_DURATION_MS, from wherever a running
+ * fade has got to */
+void backlight_fade_to(uint8_t brightness);
+
+/* LVGL thread: go to @p brightness at once, cancelling any fade
+ * (slider drags, where the light has to follow the finger) */
+void backlight_fade_set(uint8_t brightness);
@@ -12,6 +12,10 @@
 #include <zephyr/drivers/display.h>
 #include <zephyr/logging/log.h>
 
+#if IS_ENABLED(CONFIG_PROSPECTOR_BOOT_TIMING)
+#include "boot_timing.h"
+#endif
+
 LOG_MODULE_REGISTER(backlight_init, LOG_LEVEL_INF);
 
 /* Backlight PWM LED node */
@@ -68,6 +72,9 @@ static int backlight_init(void) {
     }
 
     LOG_INF("Backlight turned ON at %d%% brightness", DEFAULT_BRIGHTNESS);
+#if IS_ENABLED(CONFIG_PROSPECTOR_BOOT_TIMING)
+    boot_timing_mark(BOOT_MARK_BACKLIGHT);
+#endif
 
     /* Start heartbeat timer - every 3 seconds */
     k_timer_start(&heartbeat_timer, K_SECONDS(3), K_SECONDS(3));
@@ -0,0 +1,211 @@
+/*
+ * Copyright (c) 2024 The ZMK Contributors
+ *
+ * SPDX-License-Identifier: MIT
+ */
+
+#include <stdio.h>
+#include <lvgl.h>
+
+#include "battery_strip.h"
+
+#define BAR_HEIGHT  4
+#define TEXT_GAP    5   /* Text bottom to bar top */
+#define TEXT_HALF_W 20  /* Percentage or × centered over the bar */
+#define NAME_HALF_W 16  /* Names are centered on the bar's left edge */
+
+#define COLOR_TRACK     0x202020
+#define COLOR_GRAD_END  0xf0f0f0
+#define COLOR_NC_BAR    0x9e2121
+#define COLOR_NC_SYMBOL 0xe63030
+#define COLOR_NAME      0x808080
+
+struct strip_layout {
+    int16_t bar_w;
+    int16_t x[BATTERY_STRIP_MAX_CELLS];  /* Bar centers from the strip's center */
+    const char *names[BATTERY_STRIP_MAX_CELLS];
+};
+
+static const struct strip_layout layouts[BATTERY_STRIP_MAX_CELLS] = {
+    {165, {0}, {NULL}},
+    {110, {-70, 70}, {"L", "R"}},
+    {70, {-90, 0, 90}, {"L", "R", "Aux"}},
+    {52, {-100, -35, 35, 100}, {"L", "R", "A1", "A2"}},
+};
+
+struct battery_strip {
+    uint8_t count;
+    bool named;
+    int8_t level[BATTERY_STRIP_MAX_CELLS];  /* 1..100, 0 = ×, -1 = hidden */
+    lv_color_t color[BATTERY_STRIP_MAX_CELLS];
+    char pct[BATTERY_STRIP_MAX_CELLS][4];   /* Read by the draw task: kept here */
+};
+
+static const struct strip_layout *layout_of(const struct battery_strip *bs) {
+    return &layouts[bs->count - 1];
+}
+
+/* Bar of cell @p i in screen coordinates */
+static void bar_area(lv_obj_t *obj, const struct battery_strip *bs, int i, lv_area_t *area) {
+    const struct strip_layout *l = layout_of(bs);
+    lv_obj_get_coords(obj, area);
+    area->x1 += (lv_area_get_width(area) - l->bar_w) / 2 + l->x[i];
+    area->x2 = area->x1 + l->bar_w - 1;
+    area->y1 = area->y2 - BAR_HEIGHT + 1;
+}
+
+/* Text row, @p half_w either side of @p center_x */
+static void text_area(lv_obj_t *obj, int32_t center_x, int32_t half_w, lv_area_t *area) {
+    lv_obj_get_coords(obj, area);
+    area->x1 = center_x - half_w;
+    area->x2 = center_x + half_w - 1;
+    area->y2 -= BAR_HEIGHT + TEXT_GAP;
+}
+
+/* Bars are wider than the percentage, so the cell is its bar plus the name */
+static void invalidate_cell(lv_obj_t *obj, const struct battery_strip *bs, int i) {
+    lv_area_t area;
+    lv_area_t bar;
+    lv_obj_get_coords(obj, &area);
+    bar_area(obj, bs, i, &bar);
+    area.x1 = bar.x1 - NAME_HALF_W;
+    area.x2 = bar.x2;
+    lv_obj_invalidate_area(obj, &area);
+}
+
+static void draw_text(lv_layer_t *layer, lv_obj_t *obj, int32_t center_x, int32_t half_w,
+                      const char *text, lv_color_t color) {
+    lv_draw_label_dsc_t dsc;
+    lv_draw_label_dsc_init(&dsc);
+    dsc.font = &lv_font_montserrat_12;
+    dsc.color = color;
+    dsc.align = LV_TEXT_ALIGN_CENTER;
+    dsc.text = text;
+
+    lv_area_t area;
+    text_area(obj, center_x, half_w, &area);
+    area.y1 = area.y2 - lv_font_get_line_height(dsc.font) + 1;
+    lv_draw_label(layer, &dsc, &area);
+}
+
+static void draw_cell(lv_layer_t *layer, lv_obj_t *obj, const struct battery_strip *bs, int i) {
+    lv_area_t bar;
+    bar_area(obj, bs, i, &bar);
+    int32_t center_x = bar.x1 + lv_area_get_width(&bar) / 2;
+
+    lv_draw_rect_dsc_t rect;
+    lv_draw_rect_dsc_init(&rect);
+    rect.radius = 1;
+    rect.bg_opa = LV_OPA_COVER;
+
+    if (bs->level[i] > 0) {
+        rect.bg_color = lv_color_hex(COLOR_TRACK);
+        lv_draw_rect(layer, &rect, &bar);
+
+        /* Indicator: battery color fading to white, as lv_bar drew it */
+        lv_area_t ind = bar;
+        ind.x2 = ind.x1 + lv_area_get_width(&bar) * bs->level[i] / 100 - 1;
+        if (ind.x2 >= ind.x1) {
+            rect.bg_color = bs->color[i];
+            rect.bg_grad.dir = LV_GRAD_DIR_HOR;
+            rect.bg_grad.stops_count = 2;
+            rect.bg_grad.stops[0].color = bs->color[i];
+            rect.bg_grad.stops[0].opa = LV_OPA_COVER;
+            rect.bg_grad.stops[0].frac = 0;
+            rect.bg_grad.stops[1].color = lv_color_hex(COLOR_GRAD_END);
+            rect.bg_grad.stops[1].opa = LV_OPA_COVER;
+            rect.bg_grad.stops[1].frac = 255;
+            lv_draw_rect(layer, &rect, &ind);
+        }
+        draw_text(layer, obj, center_x, TEXT_HALF_W, bs->pct[i], bs->color[i]);
+    } else {
+        rect.bg_color = lv_color_hex(COLOR_NC_BAR);
+        lv_draw_rect(layer, &rect, &bar);
+        draw_text(layer, obj, center_x, TEXT_HALF_W, LV_SYMBOL_CLOSE,
+                  lv_color_hex(COLOR_NC_SYMBOL));
+    }
+
+    const char *name = bs->named ? layout_of(bs)->names[i] : NULL;
+    if (name) {
+        draw_text(layer, obj, bar.x1, NAME_HALF_W, name, lv_color_hex(COLOR_NAME));
+    }
+}
+
+static void event_cb(lv_event_t *e) {
+    lv_obj_t *obj = lv_event_get_target(e);
+    struct battery_strip *bs = lv_obj_get_user_data(obj);
+
+    switch (lv_event_get_code(e)) {
+    case LV_EVENT_DRAW_MAIN: {
+        lv_layer_t *layer = lv_event_get_layer(e);
+        for (int i = 0; i < bs->count; i++) {
+            if (bs->level[i] >= 0) {
+                draw_cell(layer, obj, bs, i);
+            }
+        }
+        break;
+    }
+    case LV_EVENT_DELETE:
+        lv_free(bs);
+        break;
+    default:
+        break;
+    }
+}
+
+lv_obj_t *battery_strip_create(lv_obj_t *parent) {
+    struct battery_strip *bs = lv_malloc(sizeof(*bs));
+    if (!bs) {
+        return NULL;
+    }
+    bs->count = 2;
+    bs->named = false;
+    for (int i = 0; i < BATTERY_STRIP_MAX_CELLS; i++) {
+        bs->level[i] = i < bs->count ? 0 : -1;
+        bs->color[i] = lv_color_white();
+        bs->pct[i][0] = '\0';
+    }
+
+    lv_obj_t *obj = lv_obj_create(parent);
+    lv_obj_remove_style_all(obj);
+    lv_obj_clear_flag(obj, LV_OBJ_FLAG_CLICKABLE | LV_OBJ_FLAG_SCROLLABLE);
+    lv_obj_set_user_data(obj, bs);
+    lv_obj_add_event_cb(obj, event_cb, LV_EVENT_ALL, NULL);
+    lv_obj_set_size(obj, LV_PCT(100),
+                    lv_font_get_line_height(&lv_font_montserrat_12) + TEXT_GAP + BAR_HEIGHT);
+    return obj;
+}
+
+void battery_strip_set_count(lv_obj_t *obj, uint8_t count) {
+    struct battery_strip *bs = lv_obj_get_user_data(obj);
+    count = LV_CLAMP(1, count, BATTERY_STRIP_MAX_CELLS);
+    if (!bs || (count == bs->count && bs->named)) {
+        return;
+    }
+
+    bs->count = count;
+    bs->named = true;
+    for (int i = count; i < BATTERY_STRIP_MAX_CELLS; i++) {
+        bs->level[i] = -1;
+    }
+    lv_obj_invalidate(obj);
+}
+
+void battery_strip_set_level(lv_obj_t *obj, uint8_t index, int level, lv_color_t color) {
+    struct battery_strip *bs = lv_obj_get_user_data(obj);
+    if (!bs || index >= bs->count) {
+        return;
+    }
+
+    int8_t shown = level < 0 ? -1 : LV_MIN(level, 100);
+    if (shown == bs->level[index] &&
+        (shown <= 0 || lv_color_eq(color, bs->color[index]))) {
+        return;
+    }
+    bs->level[index] = shown;
+    bs->color[index] = color;
+    if (shown > 0) {
+        snprintf(bs->pct[index], sizeof(bs->pct[index]), "%d", shown);
+    }
+    invalidate_cell(obj, bs, index);
+}
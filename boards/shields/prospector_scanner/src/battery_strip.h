@@ -0,0 +1,37 @@
+/*
+ * Copyright (c) 2024 The ZMK Contributors
+ *
+ * SPDX-License-Identifier: MIT
+ *
+ * Keyboard battery row of the main screen, as one custom-drawn object
+ *
+ * Replaces the bar, percentage, name, disconnected bar and × label the
+ * main screen used to keep per battery: every cell is drawn in the draw
+ * callback from a small state array. Changing the battery count is a
+ * state change plus one invalidation; a level change only invalidates
+ * its own cell.
+ *
+ * Cells follow the main screen's layouts: 1 centered bar 165 px wide,
+ * 2 bars of 110 (L/R), 3 of 70 (L/R/Aux) or 4 of 52 (L/R/A1/A2). The
+ * object spans its parent's width; align it by its bottom edge, which
+ * is the bars' bottom edge.
+ */
+
+#pragma once
+
+#include <lvgl.h>
+
+#define BATTERY_STRIP_MAX_CELLS 4
+
+/* LVGL thread: strip on @p parent in the 2-cell layout, both cells
+ * disconnected and unnamed (the main screen's look before any data) */
+lv_obj_t *battery_strip_create(lv_obj_t *parent);
+
+/* LVGL thread: lay out @p count cells (clamped to 1..4) with their names.
+ * Cells beyond the count are hidden. Same count is a no-op. */
+void battery_strip_set_count(lv_obj_t *obj, uint8_t count);
+
+/* LVGL thread: show cell @p index as a bar and percentage in @p color
+ * (level 1..100), disconnected (0) or not at all (negative).
+ * The same state again is a no-op. */
+void battery_strip_set_level(lv_obj_t *obj, uint8_t index, int level, lv_color_t color);
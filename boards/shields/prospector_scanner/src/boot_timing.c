@@ -0,0 +1,71 @@
+/*
+ * Copyright (c) 2024 The ZMK Contributors
+ *
+ * SPDX-License-Identifier: MIT
+ */
+
+#include <zephyr/kernel.h>
+#include <zephyr/sys/atomic.h>
+#include <zephyr/logging/log.h>
+#include <lvgl.h>
+
+#include "boot_timing.h"
+
+LOG_MODULE_REGISTER(boot_timing, LOG_LEVEL_INF);
+
+static const char *const mark_names[BOOT_MARK_COUNT] = {
+    "backlight", "screen", "first frame", "ui ready", "scanning", "keyboard",
+};
+
+static ATOMIC_DEFINE(marked, BOOT_MARK_COUNT);
+static uint32_t mark_ms[BOOT_MARK_COUNT];
+static bool keyboard_applied;  /* LVGL thread only */
+
+static void log_summary(void) {
+    LOG_INF("Boot timing (ms): backlight %u, screen %u, first frame %u, ui ready %u, "
+            "scanning %u, keyboard %u",
+            mark_ms[BOOT_MARK_BACKLIGHT], mark_ms[BOOT_MARK_SCREEN],
+            mark_ms[BOOT_MARK_FIRST_FRAME], mark_ms[BOOT_MARK_UI_READY],
+            mark_ms[BOOT_MARK_SCANNING], mark_ms[BOOT_MARK_KEYBOARD]);
+}
+
+void boot_timing_mark(enum boot_mark mark) {
+    if (mark >= BOOT_MARK_COUNT || atomic_test_and_set_bit(marked, mark)) {
+        return;
+    }
+    mark_ms[mark] = k_uptime_get_32();
+    LOG_INF("Boot: %s at %u ms", mark_names[mark], mark_ms[mark]);
+}
+
+uint32_t boot_timing_get(enum boot_mark mark) {
+    if (mark >= BOOT_MARK_COUNT || !atomic_test_bit(marked, mark)) {
+        return 0;
+    }
+    return mark_ms[mark];
+}
+
+void boot_timing_keyboard_applied(void) {
+    keyboard_applied = true;
+}
+
+/* LV_EVENT_REFR_READY fires at the end of every refresh timer run and the
+ * flush is synchronous (see latency_stats.c): the first run is the first
+ * frame, the first one after keyboard_applied shows the keyboard */
+static void refr_ready_cb(lv_event_t *e) {
+    ARG_UNUSED(e);
+    if (!keyboard_applied || atomic_test_bit(marked, BOOT_MARK_KEYBOARD)) {
+        boot_timing_mark(BOOT_MARK_FIRST_FRAME);
+        return;
+    }
+    boot_timing_mark(BOOT_MARK_KEYBOARD);
+    log_summary();
+}
+
+void boot_timing_attach_display(void) {
+    lv_display_t *disp = lv_display_get_default();
+    if (!disp) {
+        LOG_WRN("No default display - frame milestones disabled");
+        return;
+    }
+    lv_display_add_event_cb(disp, refr_ready_cb, LV_EVENT_REFR_READY, NULL);
+}
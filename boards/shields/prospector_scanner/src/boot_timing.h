@@ -0,0 +1,43 @@
+/*
+ * Copyright (c) 2024 The ZMK Contributors
+ *
+ * SPDX-License-Identifier: MIT
+ *
+ * Boot milestones in ms since kernel start (CONFIG_PROSPECTOR_BOOT_TIMING)
+ *
+ * Each milestone is recorded and logged once, the first time it is
+ * reached, so startup regressions show up as one log line each:
+ *   backlight     backlight_init set the PWM (SYS_INIT 50)
+ *   screen        zmk_display_status_screen() returned a screen
+ *   first frame   the first LVGL refresh reached the panel
+ *   ui ready      the initial screen's widgets were built
+ *   scanning      the BLE scanner started
+ *   keyboard      a keyboard's data was first on the display
+ */
+
+#pragma once
+
+#include <stdint.h>
+
+enum boot_mark {
+    BOOT_MARK_BACKLIGHT = 0,
+    BOOT_MARK_SCREEN,
+    BOOT_MARK_FIRST_FRAME,
+    BOOT_MARK_UI_READY,
+    BOOT_MARK_SCANNING,
+    BOOT_MARK_KEYBOARD,
+    BOOT_MARK_COUNT,
+};
+
+/* Any thread: record @p mark now, unless it already was */
+void boot_timing_mark(enum boot_mark mark);
+
+/* LVGL thread: the first keyboard's data was applied to the widgets.
+ * BOOT_MARK_KEYBOARD is recorded when the next refresh has drawn it. */
+void boot_timing_keyboard_applied(void);
+
+/* LVGL thread: register the display refresh hook (call once after LVGL init) */
+void boot_timing_attach_display(void);
+
+/* Uptime in ms at which @p mark was reached, 0 if not yet */
+uint32_t boot_timing_get(enum boot_mark mark);
@@ -11,6 +11,7 @@
 #include <zephyr/kernel.h>
 #include <zephyr/device.h>
 #include <zephyr/drivers/i2c.h>
+#include <zephyr/drivers/gpio.h>
 #include <zephyr/init.h>
 #include <zephyr/logging/log.h>
 
@@ -18,6 +19,12 @@ LOG_MODULE_DECLARE(zmk, CONFIG_ZMK_LOG_LEVEL);
 
 #include "brightness_control.h"
 
+#if IS_ENABLED(CONFIG_PROSPECTOR_ALS_INTERRUPT)
+/* Weak function - overridden by custom_status_screen.c */
+__attribute__((weak)) void brightness_control_light_changed(void) {
+}
+#endif
+
 // Auto brightness configuration defaults
 #ifndef CONFIG_PROSPECTOR_ALS_MIN_BRIGHTNESS
 #define CONFIG_PROSPECTOR_ALS_MIN_BRIGHTNESS 5   // 5% minimum brightness in dark
@@ -43,16 +50,20 @@ LOG_MODULE_DECLARE(zmk, CONFIG_ZMK_LOG_LEVEL);
 // APDS9960 Register Addresses
 #define APDS9960_ENABLE_REG     0x80
 #define APDS9960_ATIME_REG      0x81
+#define APDS9960_AILTL_REG      0x84  // ALS low threshold, AILTL..AIHTH auto-increment
+#define APDS9960_PERS_REG       0x8C
 #define APDS9960_CONTROL_REG    0x8F
 #define APDS9960_ID_REG         0x92
 #define APDS9960_STATUS_REG     0x93
 #define APDS9960_CDATAL_REG     0x94
 #define APDS9960_CDATAH_REG     0x95
+#define APDS9960_CICLEAR_REG    0xE6  // Clear ALS interrupt
 #define APDS9960_AICLEAR_REG    0xE7
 
 // APDS9960 Enable Register bits
 #define APDS9960_ENABLE_PON     0x01  // Power ON
 #define APDS9960_ENABLE_AEN     0x02  // ALS Enable
+#define APDS9960_ENABLE_AIEN    0x10  // ALS Interrupt Enable
 
 // APDS9960 Status Register bits
 #define APDS9960_STATUS_AVALID  0x01  // ALS data valid
@@ -70,12 +81,28 @@ LOG_MODULE_DECLARE(zmk, CONFIG_ZMK_LOG_LEVEL);
 // Default ADC integration time (219 = ~103ms)
 #define APDS9960_DEFAULT_ATIME  219
 
+// APERS 4 = 5 consecutive cycles out of the window (~0.5s) before INT asserts
+#define APDS9960_DEFAULT_APERS  4
+
+// Threshold interrupt mode: the window is at least this wide either side
+#define ALS_WINDOW_MIN_COUNTS   4
+
+#define ALS_INT_NODE DT_NODELABEL(apds9960)
+#define ALS_INTERRUPT_SUPPORTED \
+    (IS_ENABLED(CONFIG_PROSPECTOR_ALS_INTERRUPT) && DT_NODE_HAS_PROP(ALS_INT_NODE, int_gpios))
+
 // Sensor state
 static const struct device *i2c_dev = NULL;
 static struct k_work_delayable brightness_sensor_work;
 static bool sensor_available = false;
 static bool auto_brightness_enabled = true;
 
+#if ALS_INTERRUPT_SUPPORTED
+static const struct gpio_dt_spec als_int = GPIO_DT_SPEC_GET(ALS_INT_NODE, int_gpios);
+static struct gpio_callback als_int_cb;
+#endif
+static bool als_irq_active = false;  // Threshold interrupt armed instead of polling
+
 // I2C Helper functions
 static int apds9960_read_reg(uint8_t reg, uint8_t *val) {
     if (!i2c_dev) return -ENODEV;
@@ -140,6 +167,81 @@ static int apds9960_init_als(void) {
     return 0;
 }
 
+#if ALS_INTERRUPT_SUPPORTED
+// Set the ALS window: INT asserts once CDATA stays outside [low, high]
+static int apds9960_set_window(uint16_t low, uint16_t high) {
+    uint8_t buf[5] = {APDS9960_AILTL_REG, low & 0xFF, low >> 8, high & 0xFF, high >> 8};
+    return i2c_write(i2c_dev, buf, sizeof(buf), APDS9960_I2C_ADDR);
+}
+
+// Hysteresis band around @p light; above the mapping threshold brightness
+// is already at max, so only a drop back below it matters
+static void als_window_around(uint16_t light, uint16_t *low, uint16_t *high) {
+    uint32_t band = MAX((uint32_t)light * CONFIG_PROSPECTOR_ALS_INTERRUPT_HYSTERESIS / 100,
+                        ALS_WINDOW_MIN_COUNTS);
+    uint32_t threshold = CONFIG_PROSPECTOR_ALS_SENSOR_THRESHOLD;
+
+    *low = light > band ? light - band : 0;
+    if (light >= threshold) {
+        *low = MIN(*low, threshold - 1);
+        *high = UINT16_MAX;
+    } else {
+        *high = (uint16_t)MIN((uint32_t)light + band, UINT16_MAX);
+    }
+}
+
+// INT is edge-triggered, so an INT left asserted - a read that failed or
+// was skipped, a crossing before the clear - never fires again: release it
+// after every read and, if the pin is still active, ask for another read
+static void als_int_release(void) {
+    int ret = apds9960_write_reg(APDS9960_CICLEAR_REG, 0x00);
+    if (ret < 0) {
+        LOG_WRN("ALS interrupt clear failed: %d", ret);
+    } else if (gpio_pin_get_dt(&als_int) > 0) {
+        brightness_control_light_changed();
+    }
+}
+
+// ISR: the reading left the window - have the main thread read it
+static void als_int_handler(const struct device *port, struct gpio_callback *cb,
+                            gpio_port_pins_t pins) {
+    ARG_UNUSED(port);
+    ARG_UNUSED(cb);
+    ARG_UNUSED(pins);
+    brightness_control_light_changed();
+}
+
+// Arm the threshold interrupt; on failure the caller falls back to polling
+static int apds9960_init_als_interrupt(void) {
+    int ret;
+
+    if (!gpio_is_ready_dt(&als_int)) {
+        LOG_WRN("APDS9960 INT GPIO not ready");
+        return -ENODEV;
+    }
+    ret = gpio_pin_configure_dt(&als_int, GPIO_INPUT);
+    if (ret < 0) return ret;
+    gpio_init_callback(&als_int_cb, als_int_handler, BIT(als_int.pin));
+    ret = gpio_add_callback(als_int.port, &als_int_cb);
+    if (ret < 0) return ret;
+
+    // Empty window (low above high): the first reading fires at once
+    ret = apds9960_set_window(UINT16_MAX, 0);
+    if (ret < 0) return ret;
+    ret = apds9960_write_reg(APDS9960_PERS_REG, APDS9960_DEFAULT_APERS);
+    if (ret < 0) return ret;
+    ret = apds9960_write_reg(APDS9960_ENABLE_REG,
+                             APDS9960_ENABLE_PON | APDS9960_ENABLE_AEN | APDS9960_ENABLE_AIEN);
+    if (ret < 0) return ret;
+    ret = gpio_pin_interrupt_configure_dt(&als_int, GPIO_INT_EDGE_TO_ACTIVE);
+    if (ret < 0) return ret;
+
+    LOG_INF("✅ APDS9960 ALS threshold interrupt armed (±%d%%)",
+            CONFIG_PROSPECTOR_ALS_INTERRUPT_HYSTERESIS);
+    return 0;
+}
+#endif
+
 // Read ambient light value (Clear channel)
 static int apds9960_read_light(uint16_t *light_val) {
     uint8_t status;
@@ -147,18 +249,29 @@ static int apds9960_read_light(uint16_t *light_val) {
 
     // Check if data is valid
     ret = apds9960_read_reg(APDS9960_STATUS_REG, &status);
-    if (ret < 0) return ret;
-
-    if (!(status & APDS9960_STATUS_AVALID)) {
-        // Data not ready yet
-        return -EAGAIN;
+    if (ret == 0 && !(status & APDS9960_STATUS_AVALID)) {
+        ret = -EAGAIN;  // Data not ready yet
     }
 
     // Read Clear channel (ambient light)
-    ret = apds9960_read_word(APDS9960_CDATAL_REG, light_val);
-    if (ret < 0) return ret;
+    if (ret == 0) {
+        ret = apds9960_read_word(APDS9960_CDATAL_REG, light_val);
+    }
 
-    return 0;
+#if ALS_INTERRUPT_SUPPORTED
+    // Re-centre the window on this reading, then release INT either way
+    if (als_irq_active) {
+        if (ret == 0) {
+            uint16_t low, high;
+            als_window_around(*light_val, &low, &high);
+            ret = apds9960_set_window(low, high);
+            LOG_DBG("ALS window %u..%u around %u", low, high, *light_val);
+        }
+        als_int_release();
+    }
+#endif
+
+    return ret;
 }
 
 // API: Get I2C device (main thread only!)
@@ -171,6 +284,11 @@ bool brightness_control_sensor_available(void) {
     return sensor_available;
 }
 
+// API: Check if the sensor reports changes itself (no periodic reads needed)
+bool brightness_control_is_event_driven(void) {
+    return als_irq_active;
+}
+
 // API: Read light sensor (main thread only!)
 int brightness_control_read_sensor(uint16_t *light_val) {
     return apds9960_read_light(light_val);
@@ -232,6 +350,20 @@ reschedule:
 void brightness_control_set_auto(bool enabled) {
     auto_brightness_enabled = enabled;
 
+#if ALS_INTERRUPT_SUPPORTED
+    if (als_irq_active) {
+        // No wakeups while auto is off; the caller's first read re-arms the window
+        gpio_pin_interrupt_configure_dt(&als_int,
+                                        enabled ? GPIO_INT_EDGE_TO_ACTIVE : GPIO_INT_DISABLE);
+        // INT may have asserted while reads were off: that edge is gone
+        if (enabled && gpio_pin_get_dt(&als_int) > 0) {
+            brightness_control_light_changed();
+        }
+        LOG_INF("🔆 Auto brightness %s (threshold interrupt)", enabled ? "enabled" : "disabled");
+        return;
+    }
+#endif
+
     if (enabled && sensor_available) {
         // Trigger immediate sensor read
         k_work_schedule(&brightness_sensor_work, K_NO_WAIT);
@@ -271,6 +403,16 @@ static int brightness_control_init(void) {
 
     sensor_available = true;
 
+#if ALS_INTERRUPT_SUPPORTED
+    ret = apds9960_init_als_interrupt();
+    if (ret == 0) {
+        als_irq_active = true;
+        LOG_INF("✅ Sensor brightness control ready (threshold interrupt mode)");
+        return 0;  // No polling work: the sensor wakes us when the light moves
+    }
+    LOG_WRN("APDS9960 interrupt setup failed (%d) - polling instead", ret);
+#endif
+
     LOG_INF("✅ Sensor brightness control ready (message queue mode)");
     LOG_INF("📊 Settings: Min=%u%%, Max=%u%%, Threshold=%u, Interval=%ums",
             CONFIG_PROSPECTOR_ALS_MIN_BRIGHTNESS,
@@ -311,6 +453,10 @@ bool brightness_control_sensor_available(void) {
     return false;
 }
 
+bool brightness_control_is_event_driven(void) {
+    return false;
+}
+
 int brightness_control_read_sensor(uint16_t *light_val) {
     ARG_UNUSED(light_val);
     return -ENODEV;
@@ -28,8 +28,17 @@ const struct device *brightness_control_get_i2c_dev(void);
 bool brightness_control_sensor_available(void);
 
 // Read light sensor value (main thread only!)
+// In threshold interrupt mode this also re-arms the window around the reading
 // Returns 0 on success, negative error code otherwise
 int brightness_control_read_sensor(uint16_t *light_val);
 
+// True when the sensor's threshold interrupt reports light changes
+// (CONFIG_PROSPECTOR_ALS_INTERRUPT); no periodic reads are needed then
+bool brightness_control_is_event_driven(void);
+
+// Called from ISR context when the light left the window - schedule a
+// brightness_control_read_sensor() on the main thread
+void brightness_control_light_changed(void);
+
 // Map light value to brightness percentage
 uint8_t brightness_control_map_light_to_brightness(uint32_t light_value);
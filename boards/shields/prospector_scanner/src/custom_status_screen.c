@@ -9,6 +9,8 @@
  * - Main Screen → RIGHT → Quick Actions (System Settings)
  * - Display Settings → UP → Main Screen
  * - Quick Actions → LEFT → Main Screen
+ * - Main Screen → DOUBLE TAP → Dashboard (CONFIG_PROSPECTOR_DASHBOARD)
+ * - Dashboard → any gesture → Main Screen
  *
  * CRITICAL DESIGN PRINCIPLES (from CLAUDE.md):
  * 1. ISR/Callback から LVGL API を呼ばない - フラグを立てるだけ
@@ -22,11 +24,16 @@
 #include <zephyr/retention/bootmode.h>  /* For bootmode_set() - Zephyr 4.x bootloader entry */
 #include <zephyr/drivers/led.h>  /* For PWM backlight control */
 #include <string.h>
+#include <stdlib.h>
+#include <stdarg.h>
+#include <limits.h>
 #include <lvgl.h>
 #include <zmk/display.h>
 #include <zmk/display/status_screen.h>
 #include <zmk/event_manager.h>
 #include <zmk/status_scanner.h>
+#include <zmk/keyboard_names.h>
+#include <zmk/prospector_trace.h>
 #if IS_ENABLED(CONFIG_USB_DEVICE_STACK)
 #include <zmk/usb.h>
 #endif
@@ -36,34 +43,45 @@
 #include "brightness_control.h"  /* For auto brightness sensor control */
 #include "display_settings.h"   /* NVS persistence for display settings */
 #include "prospector_layouts.h"  /* Carrefinho-inspired display layouts */
+#include "scanner_stub.h"        /* Pending display data shared with the work handler */
+#include "layer_name_cache.h"    /* Layer names by index, from the static packet */
+#include "battery_strip.h"       /* Custom-drawn keyboard battery row */
+#if IS_ENABLED(CONFIG_PROSPECTOR_BACKLIGHT_HW_FADE)
+#include "backlight_fade.h"     /* Timer-driven gamma-corrected fades */
+#endif
+#if IS_ENABLED(CONFIG_PROSPECTOR_LATENCY_STATS)
+#include "latency_stats.h"      /* Keypress-to-pixel latency histograms */
+#endif
+#if IS_ENABLED(CONFIG_PROSPECTOR_BOOT_TIMING)
+#include "boot_timing.h"        /* Boot milestone timings */
+#endif
+#if IS_ENABLED(CONFIG_PROSPECTOR_LVGL_HEAP_STATS)
+#include "lvgl_heap_stats.h"    /* LVGL heap usage per screen */
+#endif
+#if IS_ENABLED(CONFIG_PROSPECTOR_TOUCH_LATENCY_BENCH)
+#include "touch_latency_bench.h"  /* Touch-to-photon stage timings */
+#endif
+#if IS_ENABLED(CONFIG_PROSPECTOR_DRAW_BUFFER_BENCH)
+#include "draw_buffer_bench.h"  /* Frame time per draw buffer preset */
+#endif
+#if IS_ENABLED(CONFIG_PROSPECTOR_PERF_PANEL)
+#include "perf_panel.h"  /* Quick Actions performance overlay */
+#endif
+#if IS_ENABLED(CONFIG_PROSPECTOR_ST7789V_LOW_POWER) && \
+    DT_NODE_HAS_COMPAT(DT_CHOSEN(zephyr_display), sitronix_st7789v)
+#include <zephyr/drivers/mipi_dbi.h>  /* Idle / partial panel modes */
+#include <zephyr/sys/byteorder.h>
+#define PANEL_LOW_POWER 1
+#endif
 
 LOG_MODULE_REGISTER(display_screen, LOG_LEVEL_INF);
 
 /* ========== Pending Display Data from scanner_stub.c ========== */
-/* Work queue sets data + flag, LVGL timer here processes it in main thread */
-#define MAX_NAME_LEN 32
-struct pending_display_data {
-    volatile bool update_pending;
-    volatile bool signal_update_pending;  /* Signal widget updates separately (1Hz) */
-    volatile bool no_keyboards;           /* True when all keyboards timed out */
-    char device_name[MAX_NAME_LEN];
-    char layer_name[4];
-    int layer;
-    int wpm;
-    bool usb_ready;
-    bool ble_connected;
-    bool ble_bonded;
-    int profile;
-    uint8_t modifiers;
-    int bat[4];
-    int8_t rssi;
-    float rate_hz;
-    int scanner_battery;
-    bool scanner_battery_pending;
-};
+/* Work queue sets data + flag, LVGL timer here processes it in main thread.
+ * struct pending_display_data is shared through scanner_stub.h. */
+#define MAX_NAME_LEN (ZMK_KEYBOARD_NAME_MAX + 1)
 
 /* Defined in scanner_stub.c */
-extern bool scanner_get_pending_update(struct pending_display_data *out);
 extern bool scanner_is_signal_pending(void);
 extern volatile int8_t scanner_signal_rssi;
 extern volatile int32_t scanner_signal_rate_x100;  /* rate * 100 */
@@ -71,8 +89,158 @@ extern bool scanner_get_pending_battery(int *level);
 extern bool scanner_get_kb_version(uint8_t *major, uint8_t *minor, uint8_t *patch,
                                     bool *is_dev, char *name, size_t name_len);
 
+#if !IS_ENABLED(CONFIG_PROSPECTOR_UI_DISPATCHER)
 /* LVGL timer for processing pending updates in main thread */
 static lv_timer_t *pending_update_timer = NULL;
+#endif
+
+#if IS_ENABLED(CONFIG_PROSPECTOR_UI_DISPATCHER)
+/* ========== UI Dispatcher ========== */
+/* One LVGL timer replaces the swipe, pending-update, keyboard-select and
+ * auto-brightness timers. Producers post event bits from any thread and
+ * kick the timer through the display work queue. Periodic jobs are
+ * deadlines with some slack (prospector_sched.h), so jobs that are nearly
+ * due together share one wake. With no event and nothing armed, the timer
+ * is paused and LVGL only wakes for layout animations. */
+#include <zmk/prospector_sched.h>
+
+enum ui_event {
+    UI_EVENT_SWIPE = BIT(0),    /* pending_swipe set by the gesture listener */
+    UI_EVENT_PENDING = BIT(1),  /* pending_data ready in scanner_stub.c */
+    UI_EVENT_ALS = BIT(2),      /* Ambient light left the sensor's threshold window */
+};
+
+enum ui_deadline {
+    UI_DEADLINE_KS_REFRESH = 0,     /* Keyboard select RSSI / entry refresh */
+    UI_DEADLINE_AUTO_BRIGHTNESS,    /* Ambient light sensor read */
+    UI_DEADLINE_COUNT,
+};
+
+static atomic_t ui_events = ATOMIC_INIT(0);
+static lv_timer_t *ui_dispatch_timer = NULL;
+static struct prospector_sched_class ui_deadlines[UI_DEADLINE_COUNT];
+
+static void ui_dispatch_kick_work_handler(struct k_work *work) {
+    ARG_UNUSED(work);
+    if (ui_dispatch_timer) {
+        lv_timer_resume(ui_dispatch_timer);
+        lv_timer_ready(ui_dispatch_timer);  /* Runs on the next LVGL tick */
+    }
+}
+
+static K_WORK_DEFINE(ui_dispatch_kick_work, ui_dispatch_kick_work_handler);
+
+/* Any thread (incl. ISR): queue @events for the LVGL thread */
+static void ui_post(atomic_val_t events) {
+    atomic_or(&ui_events, events);
+    if (zmk_display_is_initialized()) {
+        k_work_submit_to_queue(zmk_display_work_q(), &ui_dispatch_kick_work);
+    }
+}
+
+/* LVGL thread: sleep until the earliest deadline, or until the next event */
+static void ui_dispatch_reschedule(uint32_t now) {
+    if (!ui_dispatch_timer) {
+        return;
+    }
+    uint32_t wake = prospector_sched_next_wake(ui_deadlines, UI_DEADLINE_COUNT, now);
+    if (wake == PROSPECTOR_SCHED_IDLE_MS) {
+        lv_timer_pause(ui_dispatch_timer);
+        return;
+    }
+    lv_timer_set_period(ui_dispatch_timer, MAX(wake, 1));
+    lv_timer_reset(ui_dispatch_timer);
+    lv_timer_resume(ui_dispatch_timer);
+}
+
+/* LVGL thread: (re)arm a periodic job, first run @delay_ms from now */
+static void ui_deadline_arm(enum ui_deadline d, uint32_t delay_ms) {
+    uint32_t now = k_uptime_get_32();
+    prospector_sched_arm(&ui_deadlines[d], now, delay_ms, delay_ms / 4);
+    ui_dispatch_reschedule(now);
+}
+
+static void ui_deadline_disarm(enum ui_deadline d) {
+    prospector_sched_disarm(&ui_deadlines[d]);
+    ui_dispatch_reschedule(k_uptime_get_32());
+}
+#endif
+
+#if IS_ENABLED(CONFIG_PROSPECTOR_SCANNER_EVENT_DRIVEN)
+/* Normally run by scanner_display_wake(); the period only picks up
+ * updates that arrived during a transition or on another screen */
+#define PENDING_UPDATE_PERIOD_MS 1000
+
+#if IS_ENABLED(CONFIG_PROSPECTOR_UI_DISPATCHER)
+/* Called by scanner_stub.c from any thread when pending data is ready */
+void scanner_display_wake(void) {
+    ui_post(UI_EVENT_PENDING);
+}
+#else
+static void pending_wake_work_handler(struct k_work *work) {
+    ARG_UNUSED(work);
+    if (pending_update_timer) {
+        lv_timer_ready(pending_update_timer);  /* Runs on the next LVGL tick */
+    }
+}
+
+static K_WORK_DEFINE(pending_wake_work, pending_wake_work_handler);
+
+/* Called by scanner_stub.c from any thread when pending data is ready */
+void scanner_display_wake(void) {
+    if (zmk_display_is_initialized()) {
+        k_work_submit_to_queue(zmk_display_work_q(), &pending_wake_work);
+    }
+}
+#endif
+#else
+#define PENDING_UPDATE_PERIOD_MS 100
+#endif
+
+#if IS_ENABLED(CONFIG_PROSPECTOR_SCANNER_DISPLAY_SLEEP)
+/* While asleep lv_timer_handler() returns at once: no LVGL timers,
+ * animations, rendering or SPI flushes. scanner_stub.c keeps collecting
+ * keyboard data, which is applied in one go on wake. */
+static atomic_t display_asleep = ATOMIC_INIT(0);
+
+/* LVGL thread: freeze the panel on the current frame */
+static void display_sleep_enter(void) {
+    if (atomic_set(&display_asleep, 1)) {
+        return;
+    }
+    lv_refr_now(NULL);  /* Get "Scanning..." onto the panel first */
+    lv_timer_enable(false);
+    LOG_INF("Display asleep - LVGL timers and rendering paused");
+}
+
+static void display_sleep_wake_work_handler(struct k_work *work) {
+    ARG_UNUSED(work);
+    if (!atomic_cas(&display_asleep, 1, 0)) {
+        return;
+    }
+    lv_timer_enable(true);
+    lv_obj_invalidate(lv_screen_active());  /* Single full refresh */
+#if IS_ENABLED(CONFIG_PROSPECTOR_UI_DISPATCHER)
+    ui_post(UI_EVENT_PENDING);
+#else
+    if (pending_update_timer) {
+        lv_timer_ready(pending_update_timer);
+    }
+#endif
+    LOG_INF("Display awake - full refresh");
+}
+
+static K_WORK_DEFINE(display_sleep_wake_work, display_sleep_wake_work_handler);
+
+/* Called from any thread (incl. ISR) to leave display sleep */
+void scanner_display_resume(void) {
+    if (atomic_get(&display_asleep) && zmk_display_is_initialized()) {
+        k_work_submit_to_queue(zmk_display_work_q(), &display_sleep_wake_work);
+    }
+}
+#else
+static inline void display_sleep_enter(void) {}
+#endif
 
 /* ========== Screen State Management ========== */
 enum screen_state {
@@ -81,10 +249,20 @@ enum screen_state {
     SCREEN_SYSTEM_SETTINGS,
     SCREEN_KEYBOARD_SELECT,
     SCREEN_PROSPECTOR_DISPLAY,
+#if IS_ENABLED(CONFIG_PROSPECTOR_DASHBOARD)
+    SCREEN_DASHBOARD,
+#endif
 };
 
 static enum screen_state current_screen = SCREEN_MAIN;
-static lv_obj_t *screen_obj = NULL;
+static lv_obj_t *screen_obj = NULL;  /* Parent for the current screen's widgets */
+
+#if IS_ENABLED(CONFIG_PROSPECTOR_SCREEN_CACHE)
+/* The lv_screen handed to ZMK; each screen_state gets a container in it */
+static lv_obj_t *base_screen = NULL;
+static lv_obj_t *screen_root_get(enum screen_state s);
+static void screen_cache_switch(enum screen_state from, enum screen_state to);
+#endif
 
 /* Transition protection flag - checked by work queues */
 volatile bool transition_in_progress = false;
@@ -92,12 +270,53 @@ volatile bool transition_in_progress = false;
 /* Prospector Display active flag - modifies data routing */
 volatile bool prospector_display_active = false;
 
+#if IS_ENABLED(CONFIG_PROSPECTOR_TOUCH_GESTURES)
+/* Gestures from the listener (input thread) to the LVGL thread, in order:
+ * one arriving while another is handled waits instead of being dropped */
+#define SWIPE_QUEUE_SIZE 4  /* Power of two */
+static enum swipe_direction swipe_queue[SWIPE_QUEUE_SIZE];
+static atomic_t swipe_queue_head = ATOMIC_INIT(0);  /* Listener only */
+static atomic_t swipe_queue_tail = ATOMIC_INIT(0);  /* LVGL thread only */
+
+static bool swipe_queue_push(enum swipe_direction dir) {
+    atomic_val_t head = atomic_get(&swipe_queue_head);
+    if (head - atomic_get(&swipe_queue_tail) >= SWIPE_QUEUE_SIZE) {
+        return false;
+    }
+    swipe_queue[head & (SWIPE_QUEUE_SIZE - 1)] = dir;
+    atomic_set(&swipe_queue_head, head + 1);  /* Entry written before it is visible */
+    return true;
+}
+
+static bool swipe_queue_empty(void) {
+    return atomic_get(&swipe_queue_head) == atomic_get(&swipe_queue_tail);
+}
+
+static enum swipe_direction swipe_take(void) {
+    atomic_val_t tail = atomic_get(&swipe_queue_tail);
+    if (tail == atomic_get(&swipe_queue_head)) {
+        return SWIPE_DIRECTION_NONE;
+    }
+    enum swipe_direction dir = swipe_queue[tail & (SWIPE_QUEUE_SIZE - 1)];
+    atomic_set(&swipe_queue_tail, tail + 1);
+    return dir;
+}
+#else
 /* Pending swipe direction - set by ISR listener, processed by LVGL timer */
 static volatile enum swipe_direction pending_swipe = SWIPE_DIRECTION_NONE;
+
+static enum swipe_direction swipe_take(void) {
+    enum swipe_direction dir = pending_swipe;
+    pending_swipe = SWIPE_DIRECTION_NONE;
+    return dir;
+}
+#endif
+#if !IS_ENABLED(CONFIG_PROSPECTOR_UI_DISPATCHER)
 static lv_timer_t *swipe_process_timer = NULL;
 
 /* Auto brightness timer - reads sensor and adjusts brightness when auto mode enabled */
 static lv_timer_t *auto_brightness_timer = NULL;
+#endif
 #define AUTO_BRIGHTNESS_INTERVAL_MS 1000  /* Check sensor every 1 second */
 
 /* Forward declarations */
@@ -111,16 +330,28 @@ static void destroy_keyboard_select_widgets(void);
 static void create_keyboard_select_widgets(void);
 static void destroy_prospector_display_widgets(void);
 static void create_prospector_display_widgets(void);
+#if IS_ENABLED(CONFIG_PROSPECTOR_DASHBOARD)
+static void destroy_dashboard_widgets(void);
+static void create_dashboard_widgets(void);
+static void db_update_tiles(void);
+#endif
 static void swipe_process_timer_cb(lv_timer_t *timer);
+static void pending_update_timer_cb(lv_timer_t *timer);
+#if IS_ENABLED(CONFIG_PROSPECTOR_UI_DISPATCHER)
+static void ui_dispatch_timer_cb(lv_timer_t *timer);
+static void ks_update_timer_cb(lv_timer_t *timer);
+static void auto_brightness_timer_cb(lv_timer_t *timer);
+#endif
 
 /* Display update functions - called from pending_update_timer_cb */
-void display_update_device_name(const char *name);
+void display_update_device_name(zmk_keyboard_name_t name);
 void display_update_layer(int layer);
 void display_update_wpm(int wpm);
 void display_update_connection(bool usb_rdy, bool ble_conn, bool ble_bond, int profile);
 void display_update_modifiers(uint8_t mods);
 void display_update_keyboard_battery_4(int bat0, int bat1, int bat2, int bat3);
 void display_update_scanner_battery(int level);
+static void display_update_signal_x100(int8_t rssi_val, int32_t rate_x100);
 
 /* Custom slider state for inverted drag handling */
 /* Due to 180° touch panel rotation, LVGL X decreases when user drags right */
@@ -178,7 +409,8 @@ static int ble_profile = 0;
 static bool usb_ready = false;
 static bool ble_connected = false;
 static bool ble_bonded = false;
-static char cached_device_name[32] = "Scanning...";
+/* Referenced: the name label shows the interned string in place */
+static zmk_keyboard_name_t cached_device_name = ZMK_KEYBOARD_NAME_NONE;  /* "Scanning..." */
 static uint8_t cached_modifiers = 0;
 
 /* Static text buffers for lv_label_set_text_static()
@@ -189,10 +421,69 @@ static char stbuf_rssi[16] = "?";
 static char stbuf_rate[16] = "-.--Hz";
 static char stbuf_wpm[8] = "0";
 static char stbuf_scanner_bat[8] = "?";
-static char stbuf_kb_bat[MAX_KB_BATTERIES][16] = {"0", "0", "0", "0"};
 static char stbuf_transport[48] = "";
 static char stbuf_modifier[64] = "";
 
+/* Format into @buf and hand it to @label only if the text differs from
+ * what the label shows now: every set_text invalidates the label, even
+ * with identical text. Comparing against the label (not a cached value)
+ * keeps this right after the widgets are recreated. */
+static bool label_set_static_fmt(lv_obj_t *label, char *buf, size_t size, const char *fmt, ...) {
+    char text[64];
+    va_list args;
+
+    va_start(args, fmt);
+    vsnprintf(text, MIN(size, sizeof(text)), fmt, args);
+    va_end(args);
+
+    if (strcmp(lv_label_get_text(label), text) == 0) {
+        return false;
+    }
+    strcpy(buf, text);
+    lv_label_set_text_static(label, buf);
+    return true;
+}
+
+/* The same gating for widgets without a static buffer or shown_* state
+ * (the layer labels): read back what the widget has now, set only on a
+ * difference. Style setters invalidate like set_text does. */
+static void label_set_text_if_changed(lv_obj_t *label, const char *text) {
+    if (strcmp(lv_label_get_text(label), text) != 0) {
+        lv_label_set_text(label, text);
+    }
+}
+
+static void obj_set_text_color_if_changed(lv_obj_t *obj, lv_color_t color) {
+    if (!lv_color_eq(lv_obj_get_style_text_color(obj, LV_PART_MAIN), color)) {
+        lv_obj_set_style_text_color(obj, color, 0);
+    }
+}
+
+static void obj_set_text_opa_if_changed(lv_obj_t *obj, lv_opa_t opa) {
+    if (lv_obj_get_style_text_opa(obj, LV_PART_MAIN) != opa) {
+        lv_obj_set_style_text_opa(obj, opa, 0);
+    }
+}
+
+static void obj_set_pos_if_changed(lv_obj_t *obj, int32_t x, int32_t y) {
+    if (lv_obj_get_style_x(obj, LV_PART_MAIN) != x ||
+        lv_obj_get_style_y(obj, LV_PART_MAIN) != y) {
+        lv_obj_set_pos(obj, x, y);
+    }
+}
+
+/* What the non-label main screen widgets show, for the same gating.
+ * Reset whenever they are (re)created so the restore pass repaints.
+ * The keyboard battery strip keeps its own. */
+#define SHOWN_UNKNOWN INT_MIN
+static int shown_rssi_bars = SHOWN_UNKNOWN;
+static int shown_scanner_bat = SHOWN_UNKNOWN;  /* level | charging << 8, -1 = hidden */
+
+static void main_widgets_shown_reset(void) {
+    shown_rssi_bars = SHOWN_UNKNOWN;
+    shown_scanner_bat = SHOWN_UNKNOWN;
+}
+
 /* ========== PWM Backlight Control ========== */
 #if DT_HAS_COMPAT_STATUS_OKAY(pwm_leds)
 #define BACKLIGHT_NODE DT_COMPAT_GET_ANY_STATUS_OKAY(pwm_leds)
@@ -210,6 +501,11 @@ static void set_pwm_brightness(uint8_t brightness) {
     if (brightness < 1) {
         brightness = 1;
     }
+#if IS_ENABLED(CONFIG_PROSPECTOR_BACKLIGHT_HW_FADE)
+    /* Hand the target over; the steps run from a k_timer, not this thread */
+    backlight_fade_to(brightness);
+    LOG_INF("Backlight: fading to %d%%", brightness);
+#else
     /* INVERT: Backlight circuit is inverted (100% PWM = dark, 0% = bright)
      * So we invert: user's 100% brightness → 0% PWM duty, 1% brightness → 99% PWM */
     uint8_t pwm_value = 100 - brightness;
@@ -219,7 +515,95 @@ static void set_pwm_brightness(uint8_t brightness) {
     } else {
         LOG_INF("Backlight: user=%d%% -> PWM=%d%%", brightness, pwm_value);
     }
+#endif
+}
+
+/* ========== Panel low-power modes ========== */
+#ifdef PANEL_LOW_POWER
+/* Zephyr's ST7789V driver has no call for these modes, so the commands go
+ * to the panel over its MIPI DBI bus. Each is one transfer under the bus
+ * driver's lock, and none moves the driver's write window. */
+#define PANEL_NODE DT_CHOSEN(zephyr_display)
+#define ST7789V_CMD_PTLON  0x12
+#define ST7789V_CMD_NORON  0x13
+#define ST7789V_CMD_PTLAR  0x30
+#define ST7789V_CMD_IDMOFF 0x38
+#define ST7789V_CMD_IDMON  0x39
+#define ST7789V_MADCTL_MV  0x20
+#define ST7789V_MADCTL_MX  0x40
+#define ST7789V_MADCTL_MY  0x80
+#define ST7789V_FRAME_ROWS 320U  /* Frame memory is 240x320 whatever the panel size */
+
+static const struct device *panel_dev = DEVICE_DT_GET(PANEL_NODE);
+static const struct device *panel_dbi = DEVICE_DT_GET(DT_PARENT(PANEL_NODE));
+static const struct mipi_dbi_config panel_dbi_config =
+    MIPI_DBI_CONFIG_DT(PANEL_NODE, SPI_OP_MODE_MASTER | SPI_WORD_SET(8), 0);
+static bool panel_low_power_active = false;
+
+static void panel_cmd(uint8_t cmd, const uint8_t *data, size_t len) {
+    int err = mipi_dbi_command_write(panel_dbi, &panel_dbi_config, cmd, data, len);
+    if (err) {
+        LOG_WRN("Panel command 0x%02x failed: %d", cmd, err);
+    }
+}
+
+/* PTLAR takes frame memory rows. The panel's fixed MADCTL (mdac) maps them
+ * like the driver's writes: with MV a screen column selects the row, and
+ * MY (MX with MV) runs rows bottom up. False if @area doesn't fit. */
+static bool panel_set_partial_rows(const lv_area_t *area) {
+    const uint8_t madctl = DT_PROP(PANEL_NODE, mdac);
+    bool mv = (madctl & ST7789V_MADCTL_MV) != 0;
+    uint16_t start = mv ? area->x1 + DT_PROP(PANEL_NODE, x_offset)
+                        : area->y1 + DT_PROP(PANEL_NODE, y_offset);
+    uint16_t end = start + (mv ? lv_area_get_width(area) : lv_area_get_height(area)) - 1;
+
+    if (end >= ST7789V_FRAME_ROWS) {
+        return false;
+    }
+    if (madctl & (mv ? ST7789V_MADCTL_MX : ST7789V_MADCTL_MY)) {
+        uint16_t flipped = ST7789V_FRAME_ROWS - 1 - end;
+
+        end = ST7789V_FRAME_ROWS - 1 - start;
+        start = flipped;
+    }
+
+    uint8_t rows[4];
+
+    sys_put_be16(start, &rows[0]);
+    sys_put_be16(end, &rows[2]);
+    panel_cmd(ST7789V_CMD_PTLAR, rows, sizeof(rows));
+    panel_cmd(ST7789V_CMD_PTLON, NULL, 0);
+    return true;
+}
+
+/* 8-color idle mode, refreshing only the scan lines under @keep (NULL = all) */
+static void panel_set_low_power(bool enable, lv_obj_t *keep) {
+    if (enable == panel_low_power_active || !device_is_ready(panel_dev) ||
+        !device_is_ready(panel_dbi)) {
+        return;
+    }
+    panel_low_power_active = enable;
+
+    lv_area_t area;
+    bool partial = false;
+
+    if (enable && keep) {
+        lv_obj_update_layout(keep);
+        lv_obj_get_coords(keep, &area);
+        partial = panel_set_partial_rows(&area);
+    }
+    if (!partial) {
+        panel_cmd(ST7789V_CMD_NORON, NULL, 0);
+    }
+    panel_cmd(enable ? ST7789V_CMD_IDMON : ST7789V_CMD_IDMOFF, NULL, 0);
+    LOG_INF("Panel %s", enable ? "idle + partial mode" : "back to normal mode");
+}
+#else
+static inline void panel_set_low_power(bool enable, lv_obj_t *keep) {
+    ARG_UNUSED(enable);
+    ARG_UNUSED(keep);
 }
+#endif
 
 /* ========== Widget references (NO CONTAINERS) ========== */
 
@@ -254,22 +638,8 @@ static int layer_slide_window_start = 0;  /* First visible layer number in the w
 /* Modifier - placeholder for now (no NerdFont in ZMK test) */
 static lv_obj_t *modifier_label = NULL;
 
-/* Keyboard battery - array for up to 4 batteries */
-static lv_obj_t *kb_bat_bar[MAX_KB_BATTERIES] = {NULL};      /* Battery bars (connected) */
-static lv_obj_t *kb_bat_pct[MAX_KB_BATTERIES] = {NULL};      /* Percentage labels */
-static lv_obj_t *kb_bat_name[MAX_KB_BATTERIES] = {NULL};     /* Name labels (L, R, Aux, A1, A2) */
-static lv_obj_t *kb_bat_nc_bar[MAX_KB_BATTERIES] = {NULL};   /* Disconnected state bars */
-static lv_obj_t *kb_bat_nc_label[MAX_KB_BATTERIES] = {NULL}; /* Disconnected state × symbols */
-
-/* Battery name labels based on count:
- * 1: (no label)
- * 2: "L", "R"
- * 3: "L", "R", "Aux"
- * 4: "L", "R", "A1", "A2"
- */
-static const char *battery_names_2[] = {"L", "R", NULL, NULL};
-static const char *battery_names_3[] = {"L", "R", "Aux", NULL};
-static const char *battery_names_4[] = {"L", "R", "A1", "A2"};
+/* Keyboard battery - one custom-drawn strip for up to 4 batteries */
+static lv_obj_t *kb_bat_strip = NULL;
 
 /* Signal status */
 static lv_obj_t *channel_label = NULL;
@@ -278,6 +648,20 @@ static lv_obj_t *rssi_bar = NULL;
 static lv_obj_t *rssi_label = NULL;
 static lv_obj_t *rate_label = NULL;
 
+#if IS_ENABLED(CONFIG_PROSPECTOR_LATENCY_STATS) && IS_ENABLED(CONFIG_PROSPECTOR_DEBUG_WIDGET)
+/* Debug: end-to-end latency p50/p95/p99 (top-left corner) */
+static lv_obj_t *latency_label = NULL;
+static char stbuf_latency[32] = "lat: --";
+
+static void create_latency_label(lv_obj_t *parent) {
+    latency_label = lv_label_create(parent);
+    lv_obj_set_style_text_font(latency_label, &lv_font_unscii_8, 0);
+    lv_obj_set_style_text_color(latency_label, lv_color_make(0x80, 0x80, 0x80), 0);
+    lv_label_set_text_static(latency_label, stbuf_latency);
+    lv_obj_set_pos(latency_label, 4, 6);
+}
+#endif
+
 /* ========== Display Settings Screen Widgets (NO CONTAINER) ========== */
 static lv_obj_t *ds_title_label = NULL;
 static lv_obj_t *ds_brightness_label = NULL;
@@ -347,12 +731,21 @@ static lv_obj_t *ss_kb_version_label = NULL;
 static lv_obj_t *ss_bootloader_btn = NULL;
 static lv_obj_t *ss_reset_btn = NULL;
 static lv_obj_t *ss_nav_hint = NULL;
+#if IS_ENABLED(CONFIG_PROSPECTOR_LVGL_HEAP_STATS)
+static lv_obj_t *ss_heap_label = NULL;
+#endif
+#if IS_ENABLED(CONFIG_PROSPECTOR_PERF_PANEL)
+static lv_obj_t *ss_perf_btn = NULL;
+#endif
 
 /* ========== Keyboard Select Screen Widgets (NO CONTAINER) ========== */
 #define KS_MAX_KEYBOARDS 6  /* Maximum displayable keyboards */
 static lv_obj_t *ks_title_label = NULL;
 static lv_obj_t *ks_nav_hint = NULL;
+#if !IS_ENABLED(CONFIG_PROSPECTOR_UI_DISPATCHER)
 static lv_timer_t *ks_update_timer = NULL;
+#endif
+#define KS_UPDATE_INTERVAL_MS 1000
 static int ks_selected_keyboard = -1;  /* Currently selected keyboard index */
 
 /* Per-keyboard entry widgets */
@@ -362,10 +755,30 @@ struct ks_keyboard_entry {
     lv_obj_t *rssi_bar;      /* Signal strength bar */
     lv_obj_t *rssi_label;    /* RSSI dBm value */
     lv_obj_t *channel_badge; /* Channel number badge */
+    lv_obj_t *channel_label; /* Number inside the badge */
     int keyboard_index;      /* Index in scanner's keyboard array */
+    uint32_t gen;            /* Slot generation the labels were set from */
+    /* What the widgets currently show, so a refresh only touches what moved */
+    zmk_keyboard_name_t name;
+    uint8_t row;             /* List position (y) */
+    uint8_t rssi_bars;
+    int8_t rssi_shown;
+    uint8_t channel;
+    bool selected;
+#if IS_ENABLED(CONFIG_PROSPECTOR_LINK_STATS)
+    lv_obj_t *stats_label;   /* Packets/s and change loss under the dBm value */
+    uint16_t pps_x10_shown;
+    int16_t loss_pct_shown;  /* -1: no sequence numbers */
+#endif
 };
+/* Sorted by keyboard_index; rows are patched, added and removed in place */
 static struct ks_keyboard_entry ks_entries[KS_MAX_KEYBOARDS] = {0};
 static uint8_t ks_entry_count = 0;
+static uint8_t ks_entries_filter = 0xFF;  /* Channel filter the rows were built for */
+
+#define KS_LIST_Y 55           /* First row, below title/channel selector */
+#define KS_LIST_SPACING 40
+#define KS_RSSI_LABEL_STEP_DB 3  /* Smaller swings leave the dBm label alone */
 
 /* Channel selector UI in keyboard select header */
 static lv_obj_t *ks_channel_container = NULL;  /* Tappable channel display */
@@ -507,15 +920,34 @@ static lv_color_t get_rssi_color(uint8_t bars) {
 }
 
 /* ========== Pending Update Timer Callback (runs in main thread) ========== */
-static char last_keyboard_name[MAX_NAME_LEN] = "";  /* Track keyboard changes */
+
+/* PENDING_DIRTY_* → PROSPECTOR_KB_CHANGED_* for prospector_layouts_update() */
+static uint32_t layouts_changed_from(uint32_t dirty) {
+    uint32_t changed = 0;
+
+    if (dirty & PENDING_DIRTY_NAME) {
+        return PROSPECTOR_KB_CHANGED_ALL;  /* Different keyboard: redraw everything */
+    }
+    if (dirty & PENDING_DIRTY_LAYER) changed |= PROSPECTOR_KB_CHANGED_LAYER;
+    if (dirty & PENDING_DIRTY_MODIFIERS) changed |= PROSPECTOR_KB_CHANGED_MODIFIERS;
+    if (dirty & PENDING_DIRTY_WPM) changed |= PROSPECTOR_KB_CHANGED_WPM;
+    if (dirty & PENDING_DIRTY_BATTERY) changed |= PROSPECTOR_KB_CHANGED_BATTERY;
+    if (dirty & PENDING_DIRTY_CONNECTION) changed |= PROSPECTOR_KB_CHANGED_CONNECTION;
+    return changed;
+}
+static zmk_keyboard_name_t last_keyboard_name;  /* Track keyboard changes (not referenced) */
 
 static void pending_update_timer_cb(lv_timer_t *timer) {
     ARG_UNUSED(timer);
+    PSPTR_TRACE_SCOPE("psptr_pending", current_screen);
 
     /* Heartbeat: log every 30 seconds to detect display thread hangs */
     static uint32_t heartbeat_counter = 0;
-    if (++heartbeat_counter % 300 == 0) {  /* 300 × 100ms = 30s */
-        LOG_INF("Display heartbeat #%u (screen=%d)", heartbeat_counter / 300, current_screen);
+    static uint32_t heartbeat_last = 0;
+    uint32_t heartbeat_now = k_uptime_get_32();
+    if (heartbeat_now - heartbeat_last >= 30000) {
+        heartbeat_last = heartbeat_now;
+        LOG_INF("Display heartbeat #%u (screen=%d)", ++heartbeat_counter, current_screen);
     }
 
     /* Ring buffer is drained by process_work in scanner_stub.c (work queue context).
@@ -526,6 +958,14 @@ static void pending_update_timer_cb(lv_timer_t *timer) {
         return;
     }
 
+#if IS_ENABLED(CONFIG_PROSPECTOR_DASHBOARD)
+    /* Dashboard tiles are patched straight from the per-slot generations */
+    if (current_screen == SCREEN_DASHBOARD) {
+        db_update_tiles();
+        return;
+    }
+#endif
+
     /* Only process updates on main screen or prospector display */
     if (current_screen != SCREEN_MAIN && current_screen != SCREEN_PROSPECTOR_DISPLAY) {
         return;
@@ -539,7 +979,7 @@ static void pending_update_timer_cb(lv_timer_t *timer) {
             LOG_INF("All keyboards timed out - returning to Scanning... state");
 
             /* Reset display to initial "Scanning..." state */
-            display_update_device_name("Scanning...");
+            display_update_device_name(ZMK_KEYBOARD_NAME_NONE);
             display_update_layer(0);
             display_update_wpm(0);
             display_update_connection(false, false, false, 0);
@@ -547,7 +987,7 @@ static void pending_update_timer_cb(lv_timer_t *timer) {
             display_update_keyboard_battery_4(0, 0, 0, 0);
 
             /* Clear last keyboard name so next keyboard triggers battery reposition */
-            last_keyboard_name[0] = '\0';
+            last_keyboard_name = ZMK_KEYBOARD_NAME_NONE;
             active_battery_count = -1;
 
             /* Apply timeout brightness if configured */
@@ -557,16 +997,22 @@ static void pending_update_timer_cb(lv_timer_t *timer) {
                 LOG_INF("Timeout brightness set to %d%%", CONFIG_PROSPECTOR_SCANNER_TIMEOUT_BRIGHTNESS);
             }
 #endif
+            /* Nothing but "Scanning..." changes from here on */
+            panel_set_low_power(true, current_screen == SCREEN_MAIN ? device_name_label : NULL);
+            display_sleep_enter();
             return;
         }
 
+        panel_set_low_power(false, NULL);
+
         /* Detect keyboard change - reset battery count to force full reposition */
-        if (strcmp(last_keyboard_name, data.device_name) != 0) {
-            LOG_INF("Keyboard changed: %s -> %s, resetting battery layout",
-                    last_keyboard_name, data.device_name);
-            strncpy(last_keyboard_name, data.device_name, MAX_NAME_LEN - 1);
-            last_keyboard_name[MAX_NAME_LEN - 1] = '\0';
+        if (last_keyboard_name != data.device_name) {
+            char name[MAX_NAME_LEN];
+            zmk_keyboard_name_copy(data.device_name, name, sizeof(name));
+            LOG_INF("Keyboard changed to %s, resetting battery layout", name);
+            last_keyboard_name = data.device_name;
             active_battery_count = -1;  /* Force reposition on next battery update */
+            data.dirty |= PENDING_DIRTY_BATTERY;
 
             /* Restore normal brightness when keyboard activity resumes */
 #ifdef CONFIG_PROSPECTOR_FIXED_BRIGHTNESS
@@ -585,34 +1031,62 @@ static void pending_update_timer_cb(lv_timer_t *timer) {
             kb_data.peripheral_battery[0] = data.bat[1];
             kb_data.peripheral_battery[1] = data.bat[2];
             kb_data.peripheral_battery[2] = data.bat[3];
+            memcpy(kb_data.peripheral_rssi, data.peripheral_rssi, sizeof(kb_data.peripheral_rssi));
             kb_data.profile_slot = data.profile;
             kb_data.usb_connected = data.usb_ready;
             kb_data.ble_connected = data.ble_connected;
             kb_data.ble_bonded = data.ble_bonded;
             kb_data.has_dynamic_data = true;
-            strncpy(kb_data.keyboard_name, data.device_name,
-                    sizeof(kb_data.keyboard_name) - 1);
-            /* Layer name from BLE advertisement (4 chars, not null-terminated) */
-            memcpy(kb_data.current_layer_name, data.layer_name, 4);
-            kb_data.current_layer_name[4] = '\0';
+            kb_data.changed = layouts_changed_from(data.dirty);
+            kb_data.keyboard_name = data.device_name;
+            /* Layer names are read by index from the layer name cache (static
+             * packet); the advertised one (4 chars legacy, up to 7 extended)
+             * is only copied for keyboards without a table */
+            kb_data.layer_names = data.layer_names;
+            if (!layer_name_cache_get(data.layer_names, data.layer)) {
+                strncpy(kb_data.current_layer_name, data.layer_name,
+                        sizeof(kb_data.current_layer_name) - 1);
+            }
+            kb_data.layer_count = layer_name_cache_count(data.layer_names);
+            kb_data.has_static_data = kb_data.layer_count > 0;
             prospector_layouts_update(&kb_data);
         } else {
-            /* SCREEN_MAIN: Update YADS-style widgets */
-            display_update_device_name(data.device_name);
-            display_update_layer(data.layer);
-            display_update_wpm(data.wpm);
-            display_update_connection(data.usb_ready, data.ble_connected,
-                                      data.ble_bonded, data.profile);
-            display_update_modifiers(data.modifiers);
+            /* SCREEN_MAIN: Update YADS-style widgets whose source changed */
+            if (data.dirty & PENDING_DIRTY_NAME) {
+                display_update_device_name(data.device_name);
+            }
+            if (data.dirty & PENDING_DIRTY_LAYER) {
+                display_update_layer(data.layer);
+            }
+            if (data.dirty & PENDING_DIRTY_WPM) {
+                display_update_wpm(data.wpm);
+            }
+            if (data.dirty & PENDING_DIRTY_CONNECTION) {
+                display_update_connection(data.usb_ready, data.ble_connected,
+                                          data.ble_bonded, data.profile);
+            }
+            if (data.dirty & PENDING_DIRTY_MODIFIERS) {
+                display_update_modifiers(data.modifiers);
+            }
 
             /* Battery update */
-            if (data.bat[1] == 0 && data.bat[2] == 0 && data.bat[3] == 0) {
-                display_update_keyboard_battery_4(data.bat[0], 0, 0, 0);
-            } else {
-                display_update_keyboard_battery_4(data.bat[0], data.bat[1],
-                                                  data.bat[2], data.bat[3]);
+            if (data.dirty & PENDING_DIRTY_BATTERY) {
+                if (data.bat[1] == 0 && data.bat[2] == 0 && data.bat[3] == 0) {
+                    display_update_keyboard_battery_4(data.bat[0], 0, 0, 0);
+                } else {
+                    display_update_keyboard_battery_4(data.bat[0], data.bat[1],
+                                                      data.bat[2], data.bat[3]);
+                }
             }
         }
+#if IS_ENABLED(CONFIG_PROSPECTOR_LATENCY_STATS)
+        latency_probe_applied();
+#endif
+#if IS_ENABLED(CONFIG_PROSPECTOR_BOOT_TIMING)
+        if (data.kb_version_valid) {
+            boot_timing_keyboard_applied();
+        }
+#endif
     }
 
     /* Check for pending signal update (separate from main data, updates at 1Hz) */
@@ -621,30 +1095,14 @@ static void pending_update_timer_cb(lv_timer_t *timer) {
         int8_t sig_rssi = scanner_signal_rssi;
         int32_t sig_rate_x100 = scanner_signal_rate_x100;
 
-        /* Update signal display INLINE (no function call with float param) */
-        rssi = sig_rssi;
-        rate_hz = (float)sig_rate_x100 / 100.0f;
-
-        uint8_t bars = rssi_to_bars(sig_rssi);
-        if (rssi_bar) {
-            lv_bar_set_value(rssi_bar, bars, LV_ANIM_OFF);
-            lv_obj_set_style_bg_color(rssi_bar, get_rssi_color(bars), LV_PART_INDICATOR);
-        }
-        if (rssi_label) {
-            snprintf(stbuf_rssi, sizeof(stbuf_rssi), "%ddBm", sig_rssi);
-            lv_label_set_text_static(rssi_label, stbuf_rssi);
-        }
-        if (rate_label) {
-            if (sig_rate_x100 < 0) {
-                snprintf(stbuf_rate, sizeof(stbuf_rate), "-.--Hz");
-            } else {
-                /* Display from integer directly: rate_x100 / 100 . rate_x100 % 100 */
-                int whole = sig_rate_x100 / 100;
-                int frac = (sig_rate_x100 % 100) / 10;  /* One decimal place */
-                snprintf(stbuf_rate, sizeof(stbuf_rate), "%d.%dHz", whole, frac);
-            }
-            lv_label_set_text_static(rate_label, stbuf_rate);
+        /* Integer path: no function call with float param */
+        display_update_signal_x100(sig_rssi, sig_rate_x100);
+#if IS_ENABLED(CONFIG_PROSPECTOR_LATENCY_STATS) && IS_ENABLED(CONFIG_PROSPECTOR_DEBUG_WIDGET)
+        if (latency_label) {
+            latency_stats_format(stbuf_latency, sizeof(stbuf_latency));
+            lv_label_set_text_static(latency_label, stbuf_latency);
         }
+#endif
     }
 
     /* Check for pending scanner battery update */
@@ -656,21 +1114,166 @@ static void pending_update_timer_cb(lv_timer_t *timer) {
 
 /* ========== Main Screen Creation (NO CONTAINERS) ========== */
 
+/* LVGL thread, once the initial screen exists */
+static void ui_timers_register(void) {
+#if IS_ENABLED(CONFIG_PROSPECTOR_UI_DISPATCHER)
+    /* Single dispatcher for swipes, pending data and periodic jobs.
+     * Starts ready so anything posted before init is picked up. */
+    if (!ui_dispatch_timer) {
+        ui_dispatch_timer = lv_timer_create(ui_dispatch_timer_cb, 1000, NULL);
+        lv_timer_ready(ui_dispatch_timer);
+        LOG_INF("UI dispatcher registered (event driven)");
+#if IS_ENABLED(CONFIG_PROSPECTOR_LATENCY_STATS)
+        latency_stats_attach_display();
+#endif
+#if IS_ENABLED(CONFIG_PROSPECTOR_TOUCH_LATENCY_BENCH)
+        touch_bench_attach_display();
+#endif
+#if IS_ENABLED(CONFIG_PROSPECTOR_DRAW_BUFFER_BENCH)
+        draw_bench_attach_display();
+#endif
+    }
+#else
+    /* Register LVGL timer for swipe processing in main thread
+     * This timer checks the pending_swipe flag every 50ms and processes
+     * screen transitions safely in the LVGL timer context (main thread).
+     *
+     * DESIGN: ISR sets flag → LVGL timer processes → Thread-safe LVGL ops
+     */
+    if (!swipe_process_timer) {
+        swipe_process_timer = lv_timer_create(swipe_process_timer_cb, 50, NULL);
+        LOG_INF("Swipe processing timer registered (50ms interval)");
+    }
+
+    /* Create pending update timer - processes Work Queue data in main thread */
+    if (!pending_update_timer) {
+        pending_update_timer = lv_timer_create(pending_update_timer_cb,
+                                               PENDING_UPDATE_PERIOD_MS, NULL);
+        LOG_INF("Pending update timer registered (%dms interval)", PENDING_UPDATE_PERIOD_MS);
+#if IS_ENABLED(CONFIG_PROSPECTOR_LATENCY_STATS)
+        latency_stats_attach_display();
+#endif
+#if IS_ENABLED(CONFIG_PROSPECTOR_TOUCH_LATENCY_BENCH)
+        touch_bench_attach_display();
+#endif
+#if IS_ENABLED(CONFIG_PROSPECTOR_DRAW_BUFFER_BENCH)
+        draw_bench_attach_display();
+#endif
+    }
+#endif
+}
+
+#if IS_ENABLED(CONFIG_PROSPECTOR_FAST_BOOT)
+/* Only thing on the screen ZMK loads; the initial screen is built after it */
+static lv_obj_t *boot_splash = NULL;
+
+static void boot_build_timer_cb(lv_timer_t *timer);
+
+static void boot_splash_show(lv_obj_t *display_screen) {
+    boot_splash = lv_label_create(display_screen);
+    lv_obj_set_style_text_font(boot_splash, &lv_font_montserrat_16, 0);
+    lv_obj_set_style_text_color(boot_splash, lv_color_make(0xA0, 0xA0, 0xA0), 0);
+    lv_label_set_text_static(boot_splash, "Prospector");
+    lv_obj_center(boot_splash);
+
+    /* Period 0: runs on the next lv_timer_handler() pass, after ZMK loaded the screen */
+    lv_timer_t *timer = lv_timer_create(boot_build_timer_cb, 0, NULL);
+    lv_timer_set_repeat_count(timer, 1);
+}
+#endif
+
+#if IS_ENABLED(CONFIG_PROSPECTOR_TRACE)
+/* Pixel writes: psptr_flush spans the flush callback (the whole SPI write,
+ * or only the hand-off to LVGL's flush thread), psptr_flush_wait the time
+ * LVGL blocks until the previous band is off the bus */
+static void trace_flush_cb(lv_event_t *e) {
+    lv_display_t *disp = lv_event_get_target(e);
+    const lv_area_t *area;
+
+    switch (lv_event_get_code(e)) {
+    case LV_EVENT_FLUSH_START:
+        area = lv_event_get_param(e);
+        PSPTR_TRACE_BEGIN("psptr_flush",
+                          area ? lv_area_get_size(area) *
+                                     lv_color_format_get_size(lv_display_get_color_format(disp))
+                               : 0);
+        break;
+    case LV_EVENT_FLUSH_FINISH:
+        PSPTR_TRACE_END("psptr_flush", 0);
+        break;
+    case LV_EVENT_FLUSH_WAIT_START:
+        PSPTR_TRACE_BEGIN("psptr_flush_wait", 0);
+        break;
+    case LV_EVENT_FLUSH_WAIT_FINISH:
+        PSPTR_TRACE_END("psptr_flush_wait", 0);
+        break;
+    default:
+        break;
+    }
+}
+
+static void trace_attach_display(void) {
+    lv_display_t *disp = lv_display_get_default();
+    if (!disp) {
+        return;
+    }
+    lv_display_add_event_cb(disp, trace_flush_cb, LV_EVENT_FLUSH_START, NULL);
+    lv_display_add_event_cb(disp, trace_flush_cb, LV_EVENT_FLUSH_FINISH, NULL);
+    lv_display_add_event_cb(disp, trace_flush_cb, LV_EVENT_FLUSH_WAIT_START, NULL);
+    lv_display_add_event_cb(disp, trace_flush_cb, LV_EVENT_FLUSH_WAIT_FINISH, NULL);
+}
+#endif
+
 lv_obj_t *zmk_display_status_screen(void) {
     LOG_INF("=============================================");
     LOG_INF("=== Full Widget Test - NO CONTAINER ===");
     LOG_INF("=== All widgets use absolute positioning ===");
     LOG_INF("=============================================");
 
+#if IS_ENABLED(CONFIG_PROSPECTOR_BOOT_TIMING)
+    boot_timing_attach_display();
+#endif
+#if IS_ENABLED(CONFIG_PROSPECTOR_TRACE)
+    trace_attach_display();
+#endif
+#if IS_ENABLED(CONFIG_PROSPECTOR_FAST_BOOT)
+    /* Settings are loaded by now: scan while the UI is being built */
+    scanner_boot_start();
+#endif
+
     /* Load persisted display settings from NVS flash */
     load_display_settings();
 
+#if IS_ENABLED(CONFIG_PROSPECTOR_LVGL_HEAP_STATS)
+    lvgl_heap_stats_set_tag(SCREEN_MAIN, "MAIN");
+#endif
+
     /* Create main screen */
     LOG_INF("[INIT] Creating main_screen...");
-    lv_obj_t *screen = lv_obj_create(NULL);
-    lv_obj_set_style_bg_color(screen, lv_color_black(), 0);
-    lv_obj_set_style_bg_opa(screen, LV_OPA_COVER, 0);
-    lv_obj_clear_flag(screen, LV_OBJ_FLAG_SCROLLABLE);
+    lv_obj_t *display_screen = lv_obj_create(NULL);
+    lv_obj_set_style_bg_color(display_screen, lv_color_black(), 0);
+    lv_obj_set_style_bg_opa(display_screen, LV_OPA_COVER, 0);
+    lv_obj_clear_flag(display_screen, LV_OBJ_FLAG_SCROLLABLE);
+#if IS_ENABLED(CONFIG_PROSPECTOR_FAST_BOOT)
+#if IS_ENABLED(CONFIG_PROSPECTOR_SCREEN_CACHE)
+    base_screen = display_screen;
+#else
+    screen_obj = display_screen;
+#endif
+    boot_splash_show(display_screen);
+#if IS_ENABLED(CONFIG_PROSPECTOR_BOOT_TIMING)
+    boot_timing_mark(BOOT_MARK_SCREEN);
+#endif
+    return display_screen;
+#else
+#if IS_ENABLED(CONFIG_PROSPECTOR_SCREEN_CACHE)
+    /* Main widgets go into their own container so swipes only hide them */
+    base_screen = display_screen;
+    lv_obj_t *screen = screen_root_get(SCREEN_MAIN);
+    lv_obj_clear_flag(screen, LV_OBJ_FLAG_HIDDEN);
+#else
+    lv_obj_t *screen = display_screen;
+#endif
     LOG_INF("[INIT] main_screen created");
 
     /* ===== 1. Device Name (TOP_MID, y=25) ===== */
@@ -775,92 +1378,10 @@ lv_obj_t *zmk_display_status_screen(void) {
     LOG_INF("[INIT] modifier widget created");
 
     /* ===== 7. Keyboard Battery (dynamic layout for 1-4 batteries) ===== */
-    LOG_INF("[INIT] Creating keyboard battery widgets...");
-
-    /* Position constants - configurable for different battery counts */
-    #define KB_BAR_HEIGHT      4
-    #define KB_BAR_Y_OFFSET    -33    /* Distance from bottom */
-    #define KB_PCT_Y_OFFSET    -42    /* Percentage label above bar */
-    #define KB_NAME_X_OFFSET   0      /* Name label right edge aligns with bar left edge */
-
-    /* Layout for different battery counts (bar width and positions) */
-    /* 1 battery: centered, width 165 (1.5x of 110) */
-    /* 2 batteries: L/R side by side, width 110 each */
-    /* 3 batteries: width 70 each, spread across */
-    /* 4 batteries: width 52 each, spread across */
-    #define KB_BAR_WIDTH_1     165
-    #define KB_BAR_WIDTH_2     110
-    #define KB_BAR_WIDTH_3     70
-    #define KB_BAR_WIDTH_4     52
-
-    /* X offsets for each layout (from center) */
-    static const int16_t kb_x_offsets_1[] = {0};
-    static const int16_t kb_x_offsets_2[] = {-70, 70};
-    static const int16_t kb_x_offsets_3[] = {-90, 0, 90};
-    static const int16_t kb_x_offsets_4[] = {-100, -35, 35, 100};
-
-    /* Create all 4 battery slot widgets (initially hidden) */
-    for (int i = 0; i < MAX_KB_BATTERIES; i++) {
-        /* Default to 2-battery layout initially */
-        int16_t bar_width = KB_BAR_WIDTH_2;
-        int16_t x_offset = (i < 2) ? kb_x_offsets_2[i] : 0;
-
-        /* Connected state bar */
-        kb_bat_bar[i] = lv_bar_create(screen);
-        lv_obj_set_size(kb_bat_bar[i], bar_width, KB_BAR_HEIGHT);
-        lv_obj_align(kb_bat_bar[i], LV_ALIGN_BOTTOM_MID, x_offset, KB_BAR_Y_OFFSET);
-        lv_bar_set_range(kb_bat_bar[i], 0, 100);
-        lv_bar_set_value(kb_bat_bar[i], 0, LV_ANIM_OFF);
-        lv_obj_set_style_bg_color(kb_bat_bar[i], lv_color_hex(0x202020), LV_PART_MAIN);
-        lv_obj_set_style_bg_opa(kb_bat_bar[i], 255, LV_PART_MAIN);
-        lv_obj_set_style_radius(kb_bat_bar[i], 1, LV_PART_MAIN);
-        lv_obj_set_style_bg_color(kb_bat_bar[i], lv_color_hex(0x909090), LV_PART_INDICATOR);
-        lv_obj_set_style_bg_opa(kb_bat_bar[i], 255, LV_PART_INDICATOR);
-        lv_obj_set_style_bg_grad_color(kb_bat_bar[i], lv_color_hex(0xf0f0f0), LV_PART_INDICATOR);
-        lv_obj_set_style_bg_grad_dir(kb_bat_bar[i], LV_GRAD_DIR_HOR, LV_PART_INDICATOR);
-        lv_obj_set_style_radius(kb_bat_bar[i], 1, LV_PART_INDICATOR);
-        lv_obj_set_style_opa(kb_bat_bar[i], 0, LV_PART_MAIN);
-        lv_obj_set_style_opa(kb_bat_bar[i], 0, LV_PART_INDICATOR);
-
-        /* Percentage label (above bar, centered) */
-        kb_bat_pct[i] = lv_label_create(screen);
-        lv_obj_set_style_text_font(kb_bat_pct[i], &lv_font_montserrat_12, 0);
-        lv_obj_set_style_text_color(kb_bat_pct[i], lv_color_white(), 0);
-        lv_obj_align(kb_bat_pct[i], LV_ALIGN_BOTTOM_MID, x_offset, KB_PCT_Y_OFFSET);
-        lv_label_set_text(kb_bat_pct[i], "0");
-        lv_obj_set_style_opa(kb_bat_pct[i], 0, 0);
-
-        /* Name label (left of bar, same height as percentage) */
-        kb_bat_name[i] = lv_label_create(screen);
-        lv_obj_set_style_text_font(kb_bat_name[i], &lv_font_montserrat_12, 0);
-        lv_obj_set_style_text_color(kb_bat_name[i], lv_color_hex(0x808080), 0);
-        lv_obj_align(kb_bat_name[i], LV_ALIGN_BOTTOM_MID, x_offset - bar_width/2 + KB_NAME_X_OFFSET, KB_PCT_Y_OFFSET);
-        lv_obj_set_style_text_align(kb_bat_name[i], LV_TEXT_ALIGN_RIGHT, 0);
-        lv_label_set_text(kb_bat_name[i], "");
-        lv_obj_set_style_opa(kb_bat_name[i], 0, 0);
-
-        /* Disconnected state bar */
-        kb_bat_nc_bar[i] = lv_obj_create(screen);
-        lv_obj_set_size(kb_bat_nc_bar[i], bar_width, KB_BAR_HEIGHT);
-        lv_obj_align(kb_bat_nc_bar[i], LV_ALIGN_BOTTOM_MID, x_offset, KB_BAR_Y_OFFSET);
-        lv_obj_set_style_bg_color(kb_bat_nc_bar[i], lv_color_hex(0x9e2121), LV_PART_MAIN);
-        lv_obj_set_style_bg_opa(kb_bat_nc_bar[i], 255, LV_PART_MAIN);
-        lv_obj_set_style_radius(kb_bat_nc_bar[i], 1, LV_PART_MAIN);
-        lv_obj_set_style_border_width(kb_bat_nc_bar[i], 0, 0);
-        lv_obj_set_style_pad_all(kb_bat_nc_bar[i], 0, 0);
-        /* Initially hide slots 2 and 3 (only show first 2 by default) */
-        lv_obj_set_style_opa(kb_bat_nc_bar[i], (i < 2) ? 255 : 0, 0);
-
-        /* Disconnected state label (× symbol) */
-        kb_bat_nc_label[i] = lv_label_create(screen);
-        lv_obj_set_style_text_font(kb_bat_nc_label[i], &lv_font_montserrat_12, 0);
-        lv_obj_set_style_text_color(kb_bat_nc_label[i], lv_color_hex(0xe63030), 0);
-        lv_obj_align(kb_bat_nc_label[i], LV_ALIGN_BOTTOM_MID, x_offset, KB_PCT_Y_OFFSET);
-        lv_label_set_text(kb_bat_nc_label[i], LV_SYMBOL_CLOSE);
-        lv_obj_set_style_opa(kb_bat_nc_label[i], (i < 2) ? 255 : 0, 0);
-    }
-
-    LOG_INF("[INIT] keyboard battery widgets created (4 slots)");
+    LOG_INF("[INIT] Creating keyboard battery strip...");
+    kb_bat_strip = battery_strip_create(screen);
+    lv_obj_align(kb_bat_strip, LV_ALIGN_BOTTOM_MID, 0, -33);
+    LOG_INF("[INIT] keyboard battery strip created (4 cells)");
 
     /* ===== 8. Signal Status (BOTTOM, y=220) ===== */
     LOG_INF("[INIT] Creating signal status...");
@@ -902,6 +1423,10 @@ lv_obj_t *zmk_display_status_screen(void) {
     lv_obj_set_pos(rate_label, 222, 219);  /* 5px down, 5px left */
     LOG_INF("[INIT] signal status created");
 
+#if IS_ENABLED(CONFIG_PROSPECTOR_LATENCY_STATS) && IS_ENABLED(CONFIG_PROSPECTOR_DEBUG_WIDGET)
+    create_latency_label(screen);
+#endif
+
     LOG_INF("=============================================");
     LOG_INF("=== Full Widget Test Complete ===");
     LOG_INF("=== Swipe DOWN for Settings, UP to return ===");
@@ -916,6 +1441,13 @@ lv_obj_t *zmk_display_status_screen(void) {
      * In non-touch mode this is the permanent screen.
      * In touch mode this is the initial screen (changeable via swipe). */
     {
+#if IS_ENABLED(CONFIG_PROSPECTOR_LVGL_HEAP_STATS)
+        lvgl_heap_stats_set_tag(SCREEN_PROSPECTOR_DISPLAY, "PROSPECTOR_DISPLAY");
+#endif
+#if IS_ENABLED(CONFIG_PROSPECTOR_SCREEN_CACHE)
+        /* YADS widgets stay cached behind the layout for the first swipe */
+        screen_cache_switch(SCREEN_MAIN, SCREEN_PROSPECTOR_DISPLAY);
+#else
         /* Destroy YADS widgets that were just created above */
         destroy_main_screen_widgets();
         lv_obj_clean(screen);
@@ -923,6 +1455,7 @@ lv_obj_t *zmk_display_status_screen(void) {
 
         /* Create Prospector Display with configured layout */
         create_prospector_display_widgets();
+#endif
 
         /* Override NVS-saved layout with Kconfig default on first boot */
         prospector_layout_t kconfig_layout = (prospector_layout_t)CONFIG_PROSPECTOR_DEFAULT_LAYOUT;
@@ -937,46 +1470,49 @@ lv_obj_t *zmk_display_status_screen(void) {
 #else
     current_screen = SCREEN_MAIN;
 #endif
+#if IS_ENABLED(CONFIG_PROSPECTOR_LVGL_HEAP_STATS)
+    lvgl_heap_stats_sample(NULL);  /* Baseline for the first transition */
+#endif
 
-    /* Register LVGL timer for swipe processing in main thread
-     * This timer checks the pending_swipe flag every 50ms and processes
-     * screen transitions safely in the LVGL timer context (main thread).
-     *
-     * DESIGN: ISR sets flag → LVGL timer processes → Thread-safe LVGL ops
-     */
-    if (!swipe_process_timer) {
-        swipe_process_timer = lv_timer_create(swipe_process_timer_cb, 50, NULL);
-        LOG_INF("Swipe processing timer registered (50ms interval)");
-    }
-
-    /* Create pending update timer - processes Work Queue data in main thread */
-    if (!pending_update_timer) {
-        pending_update_timer = lv_timer_create(pending_update_timer_cb, 100, NULL);
-        LOG_INF("Pending update timer registered (100ms interval)");
-    }
+    ui_timers_register();
+#if IS_ENABLED(CONFIG_PROSPECTOR_BOOT_TIMING)
+    boot_timing_mark(BOOT_MARK_SCREEN);
+    boot_timing_mark(BOOT_MARK_UI_READY);
+#endif
 
-    return screen;
+    return display_screen;
+#endif /* CONFIG_PROSPECTOR_FAST_BOOT */
 }
 
 /* ========== Widget Update Functions (called from scanner_stub.c) ========== */
 
-void display_update_device_name(const char *name) {
-    if (name) {
-        strncpy(cached_device_name, name, sizeof(cached_device_name) - 1);
-        cached_device_name[sizeof(cached_device_name) - 1] = '\0';
+/* ZMK_KEYBOARD_NAME_NONE shows "Scanning..." */
+void display_update_device_name(zmk_keyboard_name_t name) {
+    PSPTR_TRACE_SCOPE("psptr_upd_name", 0);
+    if (name != cached_device_name) {
+        zmk_keyboard_name_t held = zmk_keyboard_name_hold(name);
+        zmk_keyboard_name_release(cached_device_name);
+        cached_device_name = held;
     }
-    if (device_name_label && name) {
-        lv_label_set_text_static(device_name_label, cached_device_name);
+    const char *text = cached_device_name != ZMK_KEYBOARD_NAME_NONE
+                           ? zmk_keyboard_name_str(cached_device_name)
+                           : "Scanning...";
+    if (device_name_label && lv_label_get_text(device_name_label) != text) {
+        lv_label_set_text_static(device_name_label, text);
     }
 }
 
 void display_update_scanner_battery(int level) {
+    PSPTR_TRACE_SCOPE("psptr_upd_scanner_bat", level);
     scanner_battery = level;
 
     /* If scanner battery widget is disabled via settings, hide it */
     if (!ds_battery_visible) {
-        if (scanner_bat_icon) lv_obj_set_style_opa(scanner_bat_icon, 0, 0);
-        if (scanner_bat_pct) lv_obj_set_style_opa(scanner_bat_pct, 0, 0);
+        if (shown_scanner_bat != -1) {
+            if (scanner_bat_icon) lv_obj_set_style_opa(scanner_bat_icon, 0, 0);
+            if (scanner_bat_pct) lv_obj_set_style_opa(scanner_bat_pct, 0, 0);
+            shown_scanner_bat = -1;
+        }
         return;
     }
 
@@ -986,6 +1522,12 @@ void display_update_scanner_battery(int level) {
     is_charging = zmk_usb_is_powered();
 #endif
 
+    int shown = level | (is_charging ? 1 << 8 : 0);
+    if (shown == shown_scanner_bat) {
+        return;
+    }
+    shown_scanner_bat = shown;
+
     /* Charging: Blue color (0x007FFF), show charge symbol + battery icon */
     lv_color_t display_color = is_charging ? lv_color_hex(0x007FFF) : get_scanner_battery_color(level);
 
@@ -1331,7 +1873,7 @@ static void slide_reset_positions(void) {
             int y_adj = get_slide_slot_y_adj(i);
             int x_offset = get_slide_slot_x_offset(i);
             int x_pos = start_x + (i * SLIDE_SLOT_SPACING) - (label_width / 2) + x_offset;
-            lv_obj_set_pos(layer_slide_labels[i], x_pos, 105 + y_adj);
+            obj_set_pos_if_changed(layer_slide_labels[i], x_pos, 105 + y_adj);
         }
     }
 }
@@ -1392,17 +1934,17 @@ static void update_layer_slide_display(int layer, bool animate) {
         } else {
             text[0] = '\0';  /* Empty for negative */
         }
-        lv_label_set_text(layer_slide_labels[i], text);
+        label_set_text_if_changed(layer_slide_labels[i], text);
 
         /* Update styling with gradient */
         if (layer_num < 0) {
             /* Negative layer = invisible */
-            lv_obj_set_style_text_opa(layer_slide_labels[i], LV_OPA_TRANSP, 0);
+            obj_set_text_opa_if_changed(layer_slide_labels[i], LV_OPA_TRANSP);
         } else if (is_active) {
             /* Active layer = Hue-based color, full opacity */
-            lv_obj_set_style_text_color(layer_slide_labels[i],
-                get_slide_layer_color(layer_num, ds_layer_slide_max), 0);
-            lv_obj_set_style_text_opa(layer_slide_labels[i], LV_OPA_COVER, 0);
+            obj_set_text_color_if_changed(layer_slide_labels[i],
+                get_slide_layer_color(layer_num, ds_layer_slide_max));
+            obj_set_text_opa_if_changed(layer_slide_labels[i], LV_OPA_COVER);
 
             /* Pulse animation on active layer change */
             if (animate) {
@@ -1410,8 +1952,8 @@ static void update_layer_slide_display(int layer, bool animate) {
             }
         } else {
             /* Inactive = gray with gradient opacity based on slot position */
-            lv_obj_set_style_text_color(layer_slide_labels[i], lv_color_make(80, 80, 80), 0);
-            lv_obj_set_style_text_opa(layer_slide_labels[i], get_slide_slot_opa(i), 0);
+            obj_set_text_color_if_changed(layer_slide_labels[i], lv_color_make(80, 80, 80));
+            obj_set_text_opa_if_changed(layer_slide_labels[i], get_slide_slot_opa(i));
         }
     }
 
@@ -1447,6 +1989,7 @@ static void update_layer_slide_display(int layer, bool animate) {
 }
 
 void display_update_layer(int layer) {
+    PSPTR_TRACE_SCOPE("psptr_upd_layer", layer);
     if (layer < 0 || layer > 255) return;
 
     int prev_layer = active_layer;
@@ -1526,16 +2069,16 @@ void display_update_layer(int layer) {
         /* Update normal layer list - just update colors, pulse on active */
         for (int i = 0; i < ds_max_layers && i < 10 && layer_labels[i]; i++) {
             if (i == active_layer) {
-                lv_obj_set_style_text_color(layer_labels[i], get_layer_color(i), 0);
-                lv_obj_set_style_text_opa(layer_labels[i], LV_OPA_COVER, 0);
+                obj_set_text_color_if_changed(layer_labels[i], get_layer_color(i));
+                obj_set_text_opa_if_changed(layer_labels[i], LV_OPA_COVER);
 
                 /* Pulse animation on active layer change */
                 if (prev_layer != layer) {
                     start_pulse_anim(layer_labels[i]);
                 }
             } else {
-                lv_obj_set_style_text_color(layer_labels[i], lv_color_make(40, 40, 40), 0);
-                lv_obj_set_style_text_opa(layer_labels[i], LV_OPA_30, 0);
+                obj_set_text_color_if_changed(layer_labels[i], lv_color_make(40, 40, 40));
+                obj_set_text_opa_if_changed(layer_labels[i], LV_OPA_30);
             }
         }
     }
@@ -1544,14 +2087,15 @@ void display_update_layer(int layer) {
 }
 
 void display_update_wpm(int wpm) {
+    PSPTR_TRACE_SCOPE("psptr_upd_wpm", wpm);
     wpm_value = wpm;  /* Cache for screen transitions */
     if (wpm_value_label) {
-        snprintf(stbuf_wpm, sizeof(stbuf_wpm), "%d", wpm);
-        lv_label_set_text_static(wpm_value_label, stbuf_wpm);
+        label_set_static_fmt(wpm_value_label, stbuf_wpm, sizeof(stbuf_wpm), "%d", wpm);
     }
 }
 
 void display_update_connection(bool usb_rdy, bool ble_conn, bool ble_bond, int profile) {
+    PSPTR_TRACE_SCOPE("psptr_upd_connection", profile);
     usb_ready = usb_rdy;
     ble_connected = ble_conn;
     ble_bonded = ble_bond;
@@ -1561,7 +2105,8 @@ void display_update_connection(bool usb_rdy, bool ble_conn, bool ble_bond, int p
         /* Exclusive display: USB or BLE (not both) */
         if (usb_ready) {
             /* USB connected - show USB only */
-            snprintf(stbuf_transport, sizeof(stbuf_transport), "#ffffff USB#");
+            label_set_static_fmt(transport_label, stbuf_transport, sizeof(stbuf_transport),
+                                 "#ffffff USB#");
         } else {
             /* USB not connected - show BLE with profile number on new line
              * BLE text colors:
@@ -1578,143 +2123,33 @@ void display_update_connection(bool usb_rdy, bool ble_conn, bool ble_bond, int p
             } else {
                 ble_color = "ffffff";  /* White - not bonded */
             }
-            snprintf(stbuf_transport, sizeof(stbuf_transport),
-                    "#%s BLE#\n#ffffff %d#", ble_color, profile);
+            label_set_static_fmt(transport_label, stbuf_transport, sizeof(stbuf_transport),
+                                 "#%s BLE#\n#ffffff %d#", ble_color, profile);
         }
-        lv_label_set_text_static(transport_label, stbuf_transport);
     }
 
     /* Hide profile label - now integrated into transport_label */
-    if (ble_profile_label) {
+    if (ble_profile_label && lv_label_get_text(ble_profile_label)[0] != '\0') {
         lv_label_set_text_static(ble_profile_label, "");
     }
 }
 
 void display_update_modifiers(uint8_t mods) {
+    PSPTR_TRACE_SCOPE("psptr_upd_modifiers", mods);
     cached_modifiers = mods;  /* Cache for screen transitions */
     if (modifier_label) {
-        int pos = 0;
-        stbuf_modifier[0] = '\0';
-
-        /* Build NerdFont icon string - YADS style */
-        if (mods & (ZMK_MOD_FLAG_LCTL | ZMK_MOD_FLAG_RCTL)) {
-            pos += snprintf(stbuf_modifier + pos, sizeof(stbuf_modifier) - pos, "%s", mod_symbols[0]);
-        }
-        if (mods & (ZMK_MOD_FLAG_LSFT | ZMK_MOD_FLAG_RSFT)) {
-            pos += snprintf(stbuf_modifier + pos, sizeof(stbuf_modifier) - pos, "%s", mod_symbols[1]);
-        }
-        if (mods & (ZMK_MOD_FLAG_LALT | ZMK_MOD_FLAG_RALT)) {
-            pos += snprintf(stbuf_modifier + pos, sizeof(stbuf_modifier) - pos, "%s", mod_symbols[2]);
-        }
-        if (mods & (ZMK_MOD_FLAG_LGUI | ZMK_MOD_FLAG_RGUI)) {
-            pos += snprintf(stbuf_modifier + pos, sizeof(stbuf_modifier) - pos, "%s", mod_symbols[3]);
-        }
-
-        /* Empty string when no modifiers active */
-        lv_label_set_text_static(modifier_label, stbuf_modifier);
-    }
-}
-
-/* Helper function to reposition battery widgets based on count */
-static void reposition_battery_widgets(int count) {
-    if (count < 1) count = 1;
-    if (count > MAX_KB_BATTERIES) count = MAX_KB_BATTERIES;
-
-    /* Select layout based on count */
-    static const int16_t kb_x_offsets_1[] = {0, 0, 0, 0};
-    static const int16_t kb_x_offsets_2[] = {-70, 70, 0, 0};
-    static const int16_t kb_x_offsets_3[] = {-90, 0, 90, 0};
-    static const int16_t kb_x_offsets_4[] = {-100, -35, 35, 100};
-
-    const int16_t *x_offsets;
-    int16_t bar_width;
-
-    switch (count) {
-    case 1:
-        x_offsets = kb_x_offsets_1;
-        bar_width = 165;  /* 1.5x of standard width */
-        break;
-    case 2:
-        x_offsets = kb_x_offsets_2;
-        bar_width = 110;
-        break;
-    case 3:
-        x_offsets = kb_x_offsets_3;
-        bar_width = 70;
-        break;
-    case 4:
-    default:
-        x_offsets = kb_x_offsets_4;
-        bar_width = 52;
-        break;
-    }
-
-    /* Get name labels based on count */
-    const char **names = NULL;
-    if (count == 2) names = battery_names_2;
-    else if (count == 3) names = battery_names_3;
-    else if (count == 4) names = battery_names_4;
-
-    #define KB_BAR_Y_OFFSET_R    -33
-    #define KB_PCT_Y_OFFSET_R    -42
-    #define KB_NAME_X_OFFSET_R   0
-
-    for (int i = 0; i < MAX_KB_BATTERIES; i++) {
-        bool visible = (i < count);
-        int16_t x_off = x_offsets[i];
-
-        /* Reposition bar */
-        if (kb_bat_bar[i]) {
-            lv_obj_set_size(kb_bat_bar[i], bar_width, 4);
-            lv_obj_align(kb_bat_bar[i], LV_ALIGN_BOTTOM_MID, x_off, KB_BAR_Y_OFFSET_R);
-        }
-
-        /* Reposition percentage label */
-        if (kb_bat_pct[i]) {
-            lv_obj_align(kb_bat_pct[i], LV_ALIGN_BOTTOM_MID, x_off, KB_PCT_Y_OFFSET_R);
-        }
-
-        /* Reposition and set name label */
-        if (kb_bat_name[i]) {
-            lv_obj_align(kb_bat_name[i], LV_ALIGN_BOTTOM_MID, x_off - bar_width/2 + KB_NAME_X_OFFSET_R, KB_PCT_Y_OFFSET_R);
-            if (visible && names && names[i]) {
-                lv_label_set_text(kb_bat_name[i], names[i]);
-            } else {
-                lv_label_set_text(kb_bat_name[i], "");
-            }
-        }
-
-        /* Reposition nc bar */
-        if (kb_bat_nc_bar[i]) {
-            lv_obj_set_size(kb_bat_nc_bar[i], bar_width, 4);
-            lv_obj_align(kb_bat_nc_bar[i], LV_ALIGN_BOTTOM_MID, x_off, KB_BAR_Y_OFFSET_R);
-            /* Hide unused slots, but keep visible slots ready (visibility controlled by update function) */
-            if (!visible) {
-                lv_obj_set_style_opa(kb_bat_nc_bar[i], 0, 0);
-            }
-            lv_obj_invalidate(kb_bat_nc_bar[i]);  /* Force redraw */
-        }
-
-        /* Reposition nc label */
-        if (kb_bat_nc_label[i]) {
-            lv_obj_align(kb_bat_nc_label[i], LV_ALIGN_BOTTOM_MID, x_off, KB_PCT_Y_OFFSET_R);
-            /* Hide unused slots */
-            if (!visible) {
-                lv_obj_set_style_opa(kb_bat_nc_label[i], 0, 0);
-            }
-            lv_obj_invalidate(kb_bat_nc_label[i]);  /* Force redraw */
-        }
-
-        /* Force redraw for bar, pct, name */
-        if (kb_bat_bar[i]) lv_obj_invalidate(kb_bat_bar[i]);
-        if (kb_bat_pct[i]) lv_obj_invalidate(kb_bat_pct[i]);
-        if (kb_bat_name[i]) lv_obj_invalidate(kb_bat_name[i]);
-    }
-
-    LOG_INF("Battery widgets repositioned for count=%d", count);
-}
+        /* Build NerdFont icon string - YADS style (empty when no modifiers active) */
+        const char *ctl = (mods & (ZMK_MOD_FLAG_LCTL | ZMK_MOD_FLAG_RCTL)) ? mod_symbols[0] : "";
+        const char *sft = (mods & (ZMK_MOD_FLAG_LSFT | ZMK_MOD_FLAG_RSFT)) ? mod_symbols[1] : "";
+        const char *alt = (mods & (ZMK_MOD_FLAG_LALT | ZMK_MOD_FLAG_RALT)) ? mod_symbols[2] : "";
+        const char *gui = (mods & (ZMK_MOD_FLAG_LGUI | ZMK_MOD_FLAG_RGUI)) ? mod_symbols[3] : "";
+        label_set_static_fmt(modifier_label, stbuf_modifier, sizeof(stbuf_modifier), "%s%s%s%s",
+                             ctl, sft, alt, gui);
+    }
+}
 
 void display_update_keyboard_battery_4(int bat0, int bat1, int bat2, int bat3) {
+    PSPTR_TRACE_SCOPE("psptr_upd_kb_battery", bat0);
     int values[MAX_KB_BATTERIES] = {bat0, bat1, bat2, bat3};
 
     /* Count active batteries */
@@ -1724,60 +2159,23 @@ void display_update_keyboard_battery_4(int bat0, int bat1, int bat2, int bat3) {
         if (values[i] > 0) count++;
     }
 
-    /* If count changed, reposition widgets (including count=0 case) */
+    /* If count changed, lay the strip out again (count=0 hides all cells below) */
     if (count != active_battery_count) {
         active_battery_count = count;
-        if (count > 0) {
-            reposition_battery_widgets(count);
+        if (count > 0 && kb_bat_strip) {
+            battery_strip_set_count(kb_bat_strip, count);
         }
-        /* When count=0, hide all widgets below */
     }
 
-    /* Update each battery slot */
+    /* The strip redraws only the cells whose shown state changed */
+    if (!kb_bat_strip) {
+        return;
+    }
     for (int i = 0; i < MAX_KB_BATTERIES; i++) {
         bool slot_visible = (count > 0 && i < count);
         int val = values[i];
-
-        if (slot_visible && val > 0) {
-            /* Connected: show bar and percentage, hide × */
-            if (kb_bat_nc_bar[i]) lv_obj_set_style_opa(kb_bat_nc_bar[i], 0, 0);
-            if (kb_bat_nc_label[i]) lv_obj_set_style_opa(kb_bat_nc_label[i], 0, 0);
-            if (kb_bat_bar[i]) {
-                lv_obj_set_style_opa(kb_bat_bar[i], 255, LV_PART_MAIN);
-                lv_obj_set_style_opa(kb_bat_bar[i], 255, LV_PART_INDICATOR);
-                lv_bar_set_value(kb_bat_bar[i], val, LV_ANIM_OFF);
-                lv_obj_set_style_bg_color(kb_bat_bar[i], get_keyboard_battery_color(val), LV_PART_INDICATOR);
-            }
-            if (kb_bat_pct[i]) {
-                lv_obj_set_style_opa(kb_bat_pct[i], 255, 0);
-                snprintf(stbuf_kb_bat[i], sizeof(stbuf_kb_bat[i]), "%d", val);
-                lv_label_set_text_static(kb_bat_pct[i], stbuf_kb_bat[i]);
-                lv_obj_set_style_text_color(kb_bat_pct[i], get_keyboard_battery_color(val), 0);
-            }
-            if (kb_bat_name[i]) {
-                lv_obj_set_style_opa(kb_bat_name[i], 255, 0);
-            }
-        } else if (slot_visible) {
-            /* Disconnected: show ×, hide bar and percentage */
-            if (kb_bat_bar[i]) {
-                lv_obj_set_style_opa(kb_bat_bar[i], 0, LV_PART_MAIN);
-                lv_obj_set_style_opa(kb_bat_bar[i], 0, LV_PART_INDICATOR);
-            }
-            if (kb_bat_pct[i]) lv_obj_set_style_opa(kb_bat_pct[i], 0, 0);
-            if (kb_bat_name[i]) lv_obj_set_style_opa(kb_bat_name[i], 255, 0);
-            if (kb_bat_nc_bar[i]) lv_obj_set_style_opa(kb_bat_nc_bar[i], 255, 0);
-            if (kb_bat_nc_label[i]) lv_obj_set_style_opa(kb_bat_nc_label[i], 255, 0);
-        } else {
-            /* Slot not visible (beyond active count or count=0) - hide everything */
-            if (kb_bat_bar[i]) {
-                lv_obj_set_style_opa(kb_bat_bar[i], 0, LV_PART_MAIN);
-                lv_obj_set_style_opa(kb_bat_bar[i], 0, LV_PART_INDICATOR);
-            }
-            if (kb_bat_pct[i]) lv_obj_set_style_opa(kb_bat_pct[i], 0, 0);
-            if (kb_bat_name[i]) lv_obj_set_style_opa(kb_bat_name[i], 0, 0);
-            if (kb_bat_nc_bar[i]) lv_obj_set_style_opa(kb_bat_nc_bar[i], 0, 0);
-            if (kb_bat_nc_label[i]) lv_obj_set_style_opa(kb_bat_nc_label[i], 0, 0);
-        }
+        int shown = slot_visible ? MAX(val, 0) : -1;
+        battery_strip_set_level(kb_bat_strip, i, shown, get_keyboard_battery_color(val));
     }
 }
 
@@ -1786,40 +2184,47 @@ void display_update_keyboard_battery(int left, int right) {
     display_update_keyboard_battery_4(left, right, 0, 0);
 }
 
-void display_update_signal(int8_t rssi_val, float rate) {
+/* Labels are compared at their displayed precision (1 dBm, 0.1 Hz) and
+ * the bar by bucket, so sub-display noise causes no redraw */
+static void display_update_signal_x100(int8_t rssi_val, int32_t rate_x100) {
+    PSPTR_TRACE_SCOPE("psptr_upd_signal", rate_x100);
     rssi = rssi_val;
-    rate_hz = rate;
+    rate_hz = (float)rate_x100 / 100.0f;
 
     uint8_t bars = rssi_to_bars(rssi_val);
-
-    if (rssi_bar) {
+    if (rssi_bar && bars != shown_rssi_bars) {
         lv_bar_set_value(rssi_bar, bars, LV_ANIM_OFF);
         lv_obj_set_style_bg_color(rssi_bar, get_rssi_color(bars), LV_PART_INDICATOR);
+        shown_rssi_bars = bars;
     }
 
     if (rssi_label) {
-        snprintf(stbuf_rssi, sizeof(stbuf_rssi), "%ddBm", rssi_val);
-        lv_label_set_text_static(rssi_label, stbuf_rssi);
+        label_set_static_fmt(rssi_label, stbuf_rssi, sizeof(stbuf_rssi), "%ddBm", rssi_val);
     }
 
     if (rate_label) {
-        /* Robust rate display: handle invalid/out-of-range values */
-        if (rate < 0.0f) {
+        if (rate_x100 < 0) {
             /* Negative = no data yet */
-            snprintf(stbuf_rate, sizeof(stbuf_rate), "-.--Hz");
-        } else if (rate > 999.9f || rate != rate) {  /* rate != rate checks for NaN */
-            LOG_WRN("Invalid rate value: %.2f, displaying as -.--", (double)rate);
-            snprintf(stbuf_rate, sizeof(stbuf_rate), "-.--Hz");
+            label_set_static_fmt(rate_label, stbuf_rate, sizeof(stbuf_rate), "-.--Hz");
         } else {
-            /* Safe conversion with rounding */
-            int rate_int = (int)(rate * 10.0f + 0.5f);
-            if (rate_int > 9999) rate_int = 9999;  /* Cap at 999.9Hz */
-            snprintf(stbuf_rate, sizeof(stbuf_rate), "%d.%dHz", rate_int / 10, rate_int % 10);
+            int tenths = MIN((rate_x100 + 5) / 10, 9999);  /* Cap at 999.9Hz */
+            label_set_static_fmt(rate_label, stbuf_rate, sizeof(stbuf_rate), "%d.%dHz",
+                                 tenths / 10, tenths % 10);
         }
-        lv_label_set_text_static(rate_label, stbuf_rate);
     }
 }
 
+void display_update_signal(int8_t rssi_val, float rate) {
+    /* Robust rate display: handle invalid/out-of-range values */
+    int32_t rate_x100 = -1;  /* Negative = no data yet */
+    if (rate > 999.9f || rate != rate) {  /* rate != rate checks for NaN */
+        LOG_WRN("Invalid rate value: %.2f, displaying as -.--", (double)rate);
+    } else if (rate >= 0.0f) {
+        rate_x100 = (int32_t)(rate * 100.0f + 0.5f);
+    }
+    display_update_signal_x100(rssi_val, rate_x100);
+}
+
 /* ========== Screen Transition Functions ========== */
 
 static void destroy_main_screen_widgets(void) {
@@ -1842,18 +2247,14 @@ static void destroy_main_screen_widgets(void) {
     }
 
     if (rate_label) { lv_obj_del(rate_label); rate_label = NULL; }
+#if IS_ENABLED(CONFIG_PROSPECTOR_LATENCY_STATS) && IS_ENABLED(CONFIG_PROSPECTOR_DEBUG_WIDGET)
+    if (latency_label) { lv_obj_del(latency_label); latency_label = NULL; }
+#endif
     if (rssi_label) { lv_obj_del(rssi_label); rssi_label = NULL; }
     if (rssi_bar) { lv_obj_del(rssi_bar); rssi_bar = NULL; }
     if (rx_title_label) { lv_obj_del(rx_title_label); rx_title_label = NULL; }
     if (channel_label) { lv_obj_del(channel_label); channel_label = NULL; }
-    /* Keyboard battery - delete all 4 slots */
-    for (int i = 0; i < MAX_KB_BATTERIES; i++) {
-        if (kb_bat_nc_label[i]) { lv_obj_del(kb_bat_nc_label[i]); kb_bat_nc_label[i] = NULL; }
-        if (kb_bat_nc_bar[i]) { lv_obj_del(kb_bat_nc_bar[i]); kb_bat_nc_bar[i] = NULL; }
-        if (kb_bat_name[i]) { lv_obj_del(kb_bat_name[i]); kb_bat_name[i] = NULL; }
-        if (kb_bat_pct[i]) { lv_obj_del(kb_bat_pct[i]); kb_bat_pct[i] = NULL; }
-        if (kb_bat_bar[i]) { lv_obj_del(kb_bat_bar[i]); kb_bat_bar[i] = NULL; }
-    }
+    if (kb_bat_strip) { lv_obj_del(kb_bat_strip); kb_bat_strip = NULL; }
     if (modifier_label) { lv_obj_del(modifier_label); modifier_label = NULL; }
     for (int i = 0; i < 10; i++) {
         if (layer_labels[i]) { lv_obj_del(layer_labels[i]); layer_labels[i] = NULL; }
@@ -1962,66 +2363,9 @@ static void create_main_screen_widgets(void) {
     lv_label_set_text(modifier_label, "");
     lv_obj_align(modifier_label, LV_ALIGN_TOP_MID, 0, 145);
 
-    /* === Keyboard battery widgets (4 slots, dynamic layout) === */
-    static const int16_t kb_x_offsets_2_r[] = {-70, 70, 0, 0};
-    int16_t bar_width_r = 110;  /* Default to 2-battery layout */
-
-    for (int i = 0; i < MAX_KB_BATTERIES; i++) {
-        int16_t x_offset_r = (i < 2) ? kb_x_offsets_2_r[i] : 0;
-
-        /* Connected state bar */
-        kb_bat_bar[i] = lv_bar_create(screen_obj);
-        lv_obj_set_size(kb_bat_bar[i], bar_width_r, 4);
-        lv_obj_align(kb_bat_bar[i], LV_ALIGN_BOTTOM_MID, x_offset_r, -33);
-        lv_bar_set_range(kb_bat_bar[i], 0, 100);
-        lv_bar_set_value(kb_bat_bar[i], 0, LV_ANIM_OFF);
-        lv_obj_set_style_bg_color(kb_bat_bar[i], lv_color_hex(0x202020), LV_PART_MAIN);
-        lv_obj_set_style_bg_opa(kb_bat_bar[i], 255, LV_PART_MAIN);
-        lv_obj_set_style_radius(kb_bat_bar[i], 1, LV_PART_MAIN);
-        lv_obj_set_style_bg_color(kb_bat_bar[i], lv_color_hex(0x909090), LV_PART_INDICATOR);
-        lv_obj_set_style_bg_opa(kb_bat_bar[i], 255, LV_PART_INDICATOR);
-        lv_obj_set_style_bg_grad_color(kb_bat_bar[i], lv_color_hex(0xf0f0f0), LV_PART_INDICATOR);
-        lv_obj_set_style_bg_grad_dir(kb_bat_bar[i], LV_GRAD_DIR_HOR, LV_PART_INDICATOR);
-        lv_obj_set_style_radius(kb_bat_bar[i], 1, LV_PART_INDICATOR);
-        lv_obj_set_style_opa(kb_bat_bar[i], 0, LV_PART_MAIN);
-        lv_obj_set_style_opa(kb_bat_bar[i], 0, LV_PART_INDICATOR);
-
-        /* Percentage label */
-        kb_bat_pct[i] = lv_label_create(screen_obj);
-        lv_obj_set_style_text_font(kb_bat_pct[i], &lv_font_montserrat_12, 0);
-        lv_obj_set_style_text_color(kb_bat_pct[i], lv_color_white(), 0);
-        lv_obj_align(kb_bat_pct[i], LV_ALIGN_BOTTOM_MID, x_offset_r, -42);
-        lv_label_set_text(kb_bat_pct[i], "0");
-        lv_obj_set_style_opa(kb_bat_pct[i], 0, 0);
-
-        /* Name label */
-        kb_bat_name[i] = lv_label_create(screen_obj);
-        lv_obj_set_style_text_font(kb_bat_name[i], &lv_font_montserrat_12, 0);
-        lv_obj_set_style_text_color(kb_bat_name[i], lv_color_hex(0x808080), 0);
-        lv_obj_align(kb_bat_name[i], LV_ALIGN_BOTTOM_MID, x_offset_r - bar_width_r/2, -42);
-        lv_obj_set_style_text_align(kb_bat_name[i], LV_TEXT_ALIGN_RIGHT, 0);
-        lv_label_set_text(kb_bat_name[i], "");
-        lv_obj_set_style_opa(kb_bat_name[i], 0, 0);
-
-        /* Disconnected state bar */
-        kb_bat_nc_bar[i] = lv_obj_create(screen_obj);
-        lv_obj_set_size(kb_bat_nc_bar[i], bar_width_r, 4);
-        lv_obj_align(kb_bat_nc_bar[i], LV_ALIGN_BOTTOM_MID, x_offset_r, -33);
-        lv_obj_set_style_bg_color(kb_bat_nc_bar[i], lv_color_hex(0x9e2121), LV_PART_MAIN);
-        lv_obj_set_style_bg_opa(kb_bat_nc_bar[i], 255, LV_PART_MAIN);
-        lv_obj_set_style_radius(kb_bat_nc_bar[i], 1, LV_PART_MAIN);
-        lv_obj_set_style_border_width(kb_bat_nc_bar[i], 0, 0);
-        lv_obj_set_style_pad_all(kb_bat_nc_bar[i], 0, 0);
-        lv_obj_set_style_opa(kb_bat_nc_bar[i], (i < 2) ? 255 : 0, 0);
-
-        /* Disconnected state label */
-        kb_bat_nc_label[i] = lv_label_create(screen_obj);
-        lv_obj_set_style_text_font(kb_bat_nc_label[i], &lv_font_montserrat_12, 0);
-        lv_obj_set_style_text_color(kb_bat_nc_label[i], lv_color_hex(0xe63030), 0);
-        lv_obj_align(kb_bat_nc_label[i], LV_ALIGN_BOTTOM_MID, x_offset_r, -42);
-        lv_label_set_text(kb_bat_nc_label[i], LV_SYMBOL_CLOSE);
-        lv_obj_set_style_opa(kb_bat_nc_label[i], (i < 2) ? 255 : 0, 0);
-    }
+    /* === Keyboard battery strip (4 cells, dynamic layout) === */
+    kb_bat_strip = battery_strip_create(screen_obj);
+    lv_obj_align(kb_bat_strip, LV_ALIGN_BOTTOM_MID, 0, -33);
 
     channel_label = lv_label_create(screen_obj);
     lv_obj_set_style_text_font(channel_label, &lv_font_montserrat_12, 0);
@@ -2059,9 +2403,14 @@ static void create_main_screen_widgets(void) {
     lv_label_set_text(rate_label, "-.--Hz");
     lv_obj_set_pos(rate_label, 222, 219);  /* 5px down, 5px left */
 
+#if IS_ENABLED(CONFIG_PROSPECTOR_LATENCY_STATS) && IS_ENABLED(CONFIG_PROSPECTOR_DEBUG_WIDGET)
+    create_latency_label(screen_obj);
+#endif
+
     LOG_INF("Main screen widgets created, restoring cached values...");
 
     /* Restore all cached values to newly created widgets */
+    main_widgets_shown_reset();
     display_update_device_name(cached_device_name);
     display_update_scanner_battery(scanner_battery);
     display_update_wpm(wpm_value);
@@ -2075,11 +2424,11 @@ static void create_main_screen_widgets(void) {
     for (int i = 0; i < MAX_KB_BATTERIES; i++) {
         if (battery_values[i] > 0) cached_count++;
     }
-    if (cached_count > 0) {
+    if (cached_count > 0 && kb_bat_strip) {
         /* Force reposition with cached count */
         active_battery_count = cached_count;
-        reposition_battery_widgets(cached_count);
-        LOG_INF("Battery widgets repositioned for cached count=%d", cached_count);
+        battery_strip_set_count(kb_bat_strip, cached_count);
+        LOG_INF("Battery strip laid out for cached count=%d", cached_count);
     }
     /* Now update battery display with values */
     display_update_keyboard_battery_4(battery_values[0], battery_values[1], battery_values[2], battery_values[3]);
@@ -2176,7 +2525,11 @@ static void ds_custom_slider_drag_cb(lv_event_t *e) {
             /* Update brightness label */
             lv_label_set_text_fmt(ds_brightness_value, "%d%%", (int)new_value);
             /* Apply brightness in real-time for immediate visual feedback */
+#if IS_ENABLED(CONFIG_PROSPECTOR_BACKLIGHT_HW_FADE)
+            backlight_fade_set((uint8_t)new_value);
+#else
             set_pwm_brightness((uint8_t)new_value);
+#endif
         } else if (slider == ds_layer_slider && ds_layer_value) {
             /* Update layer count label */
             lv_label_set_text_fmt(ds_layer_value, "%d", (int)new_value);
@@ -2234,6 +2587,29 @@ static void auto_brightness_timer_cb(lv_timer_t *timer) {
     LOG_DBG("Auto brightness: light=%u -> brightness=%u%%", light_val, target_brightness);
 }
 
+#if IS_ENABLED(CONFIG_PROSPECTOR_ALS_INTERRUPT)
+/* Called by brightness_control.c from its INT handler: read on the LVGL
+ * thread, which also re-arms the sensor's window */
+#if IS_ENABLED(CONFIG_PROSPECTOR_UI_DISPATCHER)
+void brightness_control_light_changed(void) {
+    ui_post(UI_EVENT_ALS);
+}
+#else
+static void als_read_work_handler(struct k_work *work) {
+    ARG_UNUSED(work);
+    auto_brightness_timer_cb(NULL);
+}
+
+static K_WORK_DEFINE(als_read_work, als_read_work_handler);
+
+void brightness_control_light_changed(void) {
+    if (zmk_display_is_initialized()) {
+        k_work_submit_to_queue(zmk_display_work_q(), &als_read_work);
+    }
+}
+#endif
+#endif
+
 /* Auto brightness switch handler */
 static void ds_auto_switch_event_cb(lv_event_t *e) {
     lv_event_code_t code = lv_event_get_code(e);
@@ -2248,8 +2624,19 @@ static void ds_auto_switch_event_cb(lv_event_t *e) {
     brightness_control_set_auto(checked);
 
     /* Start/stop auto brightness timer */
+#if IS_ENABLED(CONFIG_PROSPECTOR_UI_DISPATCHER)
+    if (checked && brightness_control_sensor_available()) {
+        /* With the threshold interrupt the sensor itself says when to read */
+        if (!brightness_control_is_event_driven()) {
+            ui_deadline_arm(UI_DEADLINE_AUTO_BRIGHTNESS, AUTO_BRIGHTNESS_INTERVAL_MS);
+        }
+        auto_brightness_timer_cb(NULL);
+    } else {
+        ui_deadline_disarm(UI_DEADLINE_AUTO_BRIGHTNESS);
+    }
+#else
     if (checked && brightness_control_sensor_available()) {
-        if (!auto_brightness_timer) {
+        if (!auto_brightness_timer && !brightness_control_is_event_driven()) {
             auto_brightness_timer = lv_timer_create(auto_brightness_timer_cb, AUTO_BRIGHTNESS_INTERVAL_MS, NULL);
             LOG_INF("Auto brightness timer started (%d ms interval)", AUTO_BRIGHTNESS_INTERVAL_MS);
         }
@@ -2260,6 +2647,7 @@ static void ds_auto_switch_event_cb(lv_event_t *e) {
         auto_brightness_timer = NULL;
         LOG_INF("Auto brightness timer stopped");
     }
+#endif
 
     /* Enable/disable manual slider based on auto state */
     if (ds_brightness_slider) {
@@ -2386,6 +2774,7 @@ static void ss_bootloader_btn_event_cb(lv_event_t *e) {
             return;
         }
         LOG_INF("Bootmode set to BOOTLOADER - rebooting...");
+        display_settings_flush();
         sys_reboot(SYS_REBOOT_WARM);
     }
 }
@@ -2402,10 +2791,19 @@ static void ss_reset_btn_event_cb(lv_event_t *e) {
 
     if (code == LV_EVENT_CLICKED || code == LV_EVENT_SHORT_CLICKED) {
         LOG_INF("Reset button ACTIVATED - performing system reset");
+        display_settings_flush();
         sys_reboot(SYS_REBOOT_WARM);
     }
 }
 
+#if IS_ENABLED(CONFIG_PROSPECTOR_PERF_PANEL)
+static void ss_perf_btn_event_cb(lv_event_t *e) {
+    if (lv_event_get_code(e) == LV_EVENT_CLICKED) {
+        perf_panel_toggle(screen_obj);
+    }
+}
+#endif
+
 /* ========== Display Settings Screen (NO CONTAINER) ========== */
 
 static void destroy_display_settings_widgets(void) {
@@ -2649,7 +3047,14 @@ static void create_display_settings_widgets(void) {
 
 static void destroy_system_settings_widgets(void) {
     LOG_INF("Destroying system settings widgets...");
+#if IS_ENABLED(CONFIG_PROSPECTOR_PERF_PANEL)
+    perf_panel_close();
+    if (ss_perf_btn) { lv_obj_del(ss_perf_btn); ss_perf_btn = NULL; }
+#endif
     if (ss_nav_hint) { lv_obj_del(ss_nav_hint); ss_nav_hint = NULL; }
+#if IS_ENABLED(CONFIG_PROSPECTOR_LVGL_HEAP_STATS)
+    if (ss_heap_label) { lv_obj_del(ss_heap_label); ss_heap_label = NULL; }
+#endif
     if (ss_reset_btn) { lv_obj_del(ss_reset_btn); ss_reset_btn = NULL; }
     if (ss_bootloader_btn) { lv_obj_del(ss_bootloader_btn); ss_bootloader_btn = NULL; }
     if (ss_kb_version_label) { lv_obj_del(ss_kb_version_label); ss_kb_version_label = NULL; }
@@ -2658,6 +3063,42 @@ static void destroy_system_settings_widgets(void) {
     LOG_INF("System settings widgets destroyed");
 }
 
+/* Also run when a cached Quick Actions screen is shown again */
+static void ss_update_kb_version_label(void) {
+    static char kb_ver_buf[64];
+    uint8_t kb_maj, kb_min, kb_pat;
+    bool kb_dev;
+    char kb_name[MAX_NAME_LEN];
+
+    if (!ss_kb_version_label) return;
+
+    if (scanner_get_kb_version(&kb_maj, &kb_min, &kb_pat, &kb_dev, kb_name, sizeof(kb_name))) {
+        if (kb_maj == 0) {
+            /* Legacy protocol (version=0x01): major decodes as 0, which never existed */
+            snprintf(kb_ver_buf, sizeof(kb_ver_buf), "KB: %s (< v2.2)", kb_name);
+        } else {
+            snprintf(kb_ver_buf, sizeof(kb_ver_buf), "KB: %s v%d.%d.%d%s",
+                     kb_name, kb_maj, kb_min, kb_pat, kb_dev ? "-dev" : "");
+        }
+    } else {
+        snprintf(kb_ver_buf, sizeof(kb_ver_buf), "KB: not connected");
+    }
+    lv_label_set_text(ss_kb_version_label, kb_ver_buf);
+    lv_obj_align(ss_kb_version_label, LV_ALIGN_TOP_MID, 0, 65);
+}
+
+#if IS_ENABLED(CONFIG_PROSPECTOR_LVGL_HEAP_STATS)
+/* Refreshed after each transition, once the new snapshot is taken */
+static void ss_update_heap_label(void) {
+    static char heap_buf[48];
+
+    if (!ss_heap_label) return;
+    lvgl_heap_stats_format(heap_buf, sizeof(heap_buf));
+    lv_label_set_text_static(ss_heap_label, heap_buf);
+    lv_obj_align(ss_heap_label, LV_ALIGN_BOTTOM_MID, 0, -30);
+}
+#endif
+
 static void create_system_settings_widgets(void) {
     if (!screen_obj) return;
     LOG_INF("Creating system settings widgets (NO CONTAINER)...");
@@ -2684,25 +3125,7 @@ static void create_system_settings_widgets(void) {
     ss_kb_version_label = lv_label_create(screen_obj);
     lv_obj_set_style_text_font(ss_kb_version_label, &lv_font_montserrat_12, 0);
     lv_obj_set_style_text_color(ss_kb_version_label, lv_color_hex(0x606060), 0);
-    {
-        static char kb_ver_buf[64];
-        uint8_t kb_maj, kb_min, kb_pat;
-        bool kb_dev;
-        char kb_name[MAX_NAME_LEN];
-        if (scanner_get_kb_version(&kb_maj, &kb_min, &kb_pat, &kb_dev, kb_name, sizeof(kb_name))) {
-            if (kb_maj == 0) {
-                /* Legacy protocol (version=0x01): major decodes as 0, which never existed */
-                snprintf(kb_ver_buf, sizeof(kb_ver_buf), "KB: %s (< v2.2)", kb_name);
-            } else {
-                snprintf(kb_ver_buf, sizeof(kb_ver_buf), "KB: %s v%d.%d.%d%s",
-                         kb_name, kb_maj, kb_min, kb_pat, kb_dev ? "-dev" : "");
-            }
-        } else {
-            snprintf(kb_ver_buf, sizeof(kb_ver_buf), "KB: not connected");
-        }
-        lv_label_set_text(ss_kb_version_label, kb_ver_buf);
-    }
-    lv_obj_align(ss_kb_version_label, LV_ALIGN_TOP_MID, 0, 65);
+    ss_update_kb_version_label();
 
     /* Bootloader button (blue) - compact for version info space */
     ss_bootloader_btn = lv_btn_create(screen_obj);
@@ -2759,6 +3182,32 @@ static void create_system_settings_widgets(void) {
     lv_label_set_text(ss_nav_hint, LV_SYMBOL_LEFT " Main");
     lv_obj_align(ss_nav_hint, LV_ALIGN_BOTTOM_MID, 0, -10);
 
+#if IS_ENABLED(CONFIG_PROSPECTOR_LVGL_HEAP_STATS)
+    /* Debug: LVGL heap usage, between the Reset button and the hint */
+    ss_heap_label = lv_label_create(screen_obj);
+    lv_obj_set_style_text_font(ss_heap_label, &lv_font_unscii_8, 0);
+    lv_obj_set_style_text_color(ss_heap_label, lv_color_hex(0x606060), 0);
+    ss_update_heap_label();
+#endif
+
+#if IS_ENABLED(CONFIG_PROSPECTOR_PERF_PANEL)
+    /* Debug: performance panel toggle, top right clear of the title */
+    ss_perf_btn = lv_btn_create(screen_obj);
+    lv_obj_set_size(ss_perf_btn, 44, 24);
+    lv_obj_align(ss_perf_btn, LV_ALIGN_TOP_RIGHT, -6, 6);
+    lv_obj_set_style_bg_color(ss_perf_btn, lv_color_hex(0x303030), LV_STATE_DEFAULT);
+    lv_obj_set_style_bg_color(ss_perf_btn, lv_color_hex(0x505050), LV_STATE_PRESSED);
+    lv_obj_set_style_radius(ss_perf_btn, 6, LV_STATE_DEFAULT);
+    lv_obj_set_style_shadow_width(ss_perf_btn, 0, LV_STATE_DEFAULT);
+    lv_obj_add_event_cb(ss_perf_btn, ss_perf_btn_event_cb, LV_EVENT_CLICKED, NULL);
+
+    lv_obj_t *perf_label = lv_label_create(ss_perf_btn);
+    lv_label_set_text(perf_label, "Perf");
+    lv_obj_set_style_text_font(perf_label, &lv_font_montserrat_12, LV_STATE_DEFAULT);
+    lv_obj_set_style_text_color(perf_label, lv_color_hex(0xC0C0C0), LV_STATE_DEFAULT);
+    lv_obj_center(perf_label);
+#endif
+
     LOG_INF("System settings widgets created");
 }
 
@@ -2787,6 +3236,30 @@ static lv_color_t ks_get_rssi_color(uint8_t bars) {
     return lv_color_hex(0x606060);                 /* Gray */
 }
 
+static void ks_entry_set_selected(struct ks_keyboard_entry *entry, bool selected) {
+    if (selected) {
+        lv_obj_set_style_bg_color(entry->container, lv_color_hex(0x2A4A6A), 0);
+        lv_obj_set_style_border_color(entry->container, lv_color_hex(0x4A90E2), 0);
+        lv_obj_set_style_border_width(entry->container, 2, 0);
+    } else {
+        lv_obj_set_style_bg_color(entry->container, lv_color_hex(0x1A1A1A), 0);
+        lv_obj_set_style_border_color(entry->container, lv_color_hex(0x303030), 0);
+        lv_obj_set_style_border_width(entry->container, 1, 0);
+    }
+    entry->selected = selected;
+}
+
+/* Restyle only the rows whose selected state changed */
+static void ks_update_selection(void) {
+    for (int i = 0; i < ks_entry_count; i++) {
+        struct ks_keyboard_entry *entry = &ks_entries[i];
+        bool selected = (entry->keyboard_index == ks_selected_keyboard);
+        if (entry->container && entry->selected != selected) {
+            ks_entry_set_selected(entry, selected);
+        }
+    }
+}
+
 /* Keyboard entry click handler */
 static void ks_entry_click_cb(lv_event_t *e) {
     lv_event_code_t code = lv_event_get_code(e);
@@ -2801,38 +3274,69 @@ static void ks_entry_click_cb(lv_event_t *e) {
     scanner_set_selected_keyboard(keyboard_index);
 
     /* Update visual state for all entries */
-    for (int i = 0; i < ks_entry_count; i++) {
-        struct ks_keyboard_entry *entry = &ks_entries[i];
-        if (!entry->container) continue;
-
-        bool is_selected = (entry->keyboard_index == ks_selected_keyboard);
-        if (is_selected) {
-            lv_obj_set_style_bg_color(entry->container, lv_color_hex(0x2A4A6A), 0);
-            lv_obj_set_style_border_color(entry->container, lv_color_hex(0x4A90E2), 0);
-            lv_obj_set_style_border_width(entry->container, 2, 0);
-        } else {
-            lv_obj_set_style_bg_color(entry->container, lv_color_hex(0x1A1A1A), 0);
-            lv_obj_set_style_border_color(entry->container, lv_color_hex(0x303030), 0);
-            lv_obj_set_style_border_width(entry->container, 1, 0);
-        }
-    }
+    ks_update_selection();
 }
 
 /* Forward declaration for badge tap callback */
 static void ks_badge_tap_cb(lv_event_t *e);
 
-/* Create a single keyboard entry at absolute position */
-static void ks_create_entry(int entry_idx, int y_pos, int keyboard_index,
-                            const char *name, int8_t rssi, uint8_t channel) {
-    if (entry_idx >= KS_MAX_KEYBOARDS) return;
+/* RSSI shown for a slot: the link average when kept, else the last frame */
+static int8_t ks_rssi_of(const struct zmk_keyboard_status *kbd) {
+#if IS_ENABLED(CONFIG_PROSPECTOR_LINK_STATS)
+    if (kbd->link.frames > 0) {
+        return prospector_link_stats_rssi(&kbd->link);
+    }
+#endif
+    return kbd->rssi;
+}
+
+#if IS_ENABLED(CONFIG_PROSPECTOR_LINK_STATS)
+static void ks_set_stats_text(struct ks_keyboard_entry *entry,
+                              const struct zmk_keyboard_status *kbd) {
+    uint16_t pps_x10 = prospector_link_stats_pps_x100(&kbd->link, k_uptime_get_32()) / 10;
+    int loss = prospector_link_stats_loss_permille(&kbd->link);
+    int16_t loss_pct = loss < 0 ? -1 : (int16_t)((loss + 5) / 10);
+    char buf[20];
+
+    if (pps_x10 == entry->pps_x10_shown && loss_pct == entry->loss_pct_shown) {
+        return;
+    }
+    if (loss_pct < 0) {
+        snprintf(buf, sizeof(buf), "%u.%u/s", pps_x10 / 10, pps_x10 % 10);
+    } else {
+        snprintf(buf, sizeof(buf), "%u.%u/s %d%%", pps_x10 / 10, pps_x10 % 10, loss_pct);
+    }
+    lv_label_set_text(entry->stats_label, buf);
+    entry->pps_x10_shown = pps_x10;
+    entry->loss_pct_shown = loss_pct;
+}
+#endif
+
+/* Label text for a slot's name: copied into buf, "Unknown" if it has none */
+static const char *kbd_name_text(const struct zmk_keyboard_status *kbd, char *buf, size_t size) {
+    return zmk_keyboard_name_copy(kbd->name, buf, size) > 0 ? buf : "Unknown";
+}
+
+/* Create a single keyboard entry at absolute position (list row @row) */
+static void ks_create_entry(struct ks_keyboard_entry *entry, int row, int keyboard_index,
+                            const struct zmk_keyboard_status *kbd, uint32_t gen) {
+    char name_buf[MAX_NAME_LEN];
+    const char *name = kbd_name_text(kbd, name_buf, sizeof(name_buf));
+    int8_t rssi = ks_rssi_of(kbd);
+    uint8_t channel = kbd->data.channel;
 
-    struct ks_keyboard_entry *entry = &ks_entries[entry_idx];
     entry->keyboard_index = keyboard_index;
+    entry->gen = gen;
+    entry->name = kbd->name;
+    entry->row = row;
+    entry->rssi_shown = rssi;
+    entry->channel = channel;
+    entry->selected = false;
 
     /* Clickable container - absolute position */
     entry->container = lv_obj_create(screen_obj);
     lv_obj_set_size(entry->container, 250, 32);
-    lv_obj_set_pos(entry->container, 15, y_pos);
+    lv_obj_set_pos(entry->container, 15, KS_LIST_Y + row * KS_LIST_SPACING);
     lv_obj_set_style_bg_color(entry->container, lv_color_hex(0x1A1A1A), 0);
     lv_obj_set_style_bg_opa(entry->container, LV_OPA_COVER, 0);
     lv_obj_set_style_border_width(entry->container, 1, 0);
@@ -2845,9 +3349,7 @@ static void ks_create_entry(int entry_idx, int y_pos, int keyboard_index,
 
     /* Apply selection styling if this is selected */
     if (keyboard_index == ks_selected_keyboard) {
-        lv_obj_set_style_bg_color(entry->container, lv_color_hex(0x2A4A6A), 0);
-        lv_obj_set_style_border_color(entry->container, lv_color_hex(0x4A90E2), 0);
-        lv_obj_set_style_border_width(entry->container, 2, 0);
+        ks_entry_set_selected(entry, true);
     }
 
     /* Channel badge (only shown when scanner channel is "All") */
@@ -2860,13 +3362,13 @@ static void ks_create_entry(int entry_idx, int y_pos, int keyboard_index,
     lv_obj_set_style_border_width(entry->channel_badge, 0, 0);
     lv_obj_set_style_pad_all(entry->channel_badge, 0, 0);
 
-    lv_obj_t *ch_label = lv_label_create(entry->channel_badge);
+    entry->channel_label = lv_label_create(entry->channel_badge);
     char ch_buf[4];
     snprintf(ch_buf, sizeof(ch_buf), "%d", channel);
-    lv_label_set_text(ch_label, ch_buf);
-    lv_obj_set_style_text_color(ch_label, lv_color_hex(0x000000), 0);  /* Dark text */
-    lv_obj_set_style_text_font(ch_label, &lv_font_montserrat_12, 0);
-    lv_obj_center(ch_label);
+    lv_label_set_text(entry->channel_label, ch_buf);
+    lv_obj_set_style_text_color(entry->channel_label, lv_color_hex(0x000000), 0);  /* Dark text */
+    lv_obj_set_style_text_font(entry->channel_label, &lv_font_montserrat_12, 0);
+    lv_obj_center(entry->channel_label);
 
     /* Make badge clickable to filter by this channel */
     lv_obj_add_flag(entry->channel_badge, LV_OBJ_FLAG_CLICKABLE);
@@ -2882,6 +3384,7 @@ static void ks_create_entry(int entry_idx, int y_pos, int keyboard_index,
     lv_obj_set_size(entry->rssi_bar, 30, 8);
     lv_bar_set_range(entry->rssi_bar, 0, 5);
     uint8_t bars = ks_rssi_to_bars(rssi);
+    entry->rssi_bars = bars;
     lv_bar_set_value(entry->rssi_bar, bars, LV_ANIM_OFF);
     lv_obj_set_style_bg_color(entry->rssi_bar, lv_color_hex(0x202020), LV_PART_MAIN);
     lv_obj_set_style_bg_opa(entry->rssi_bar, LV_OPA_COVER, LV_PART_MAIN);
@@ -2898,7 +3401,18 @@ static void ks_create_entry(int entry_idx, int y_pos, int keyboard_index,
     lv_label_set_text(entry->rssi_label, rssi_buf);
     lv_obj_set_style_text_color(entry->rssi_label, lv_color_hex(0xA0A0A0), 0);
     lv_obj_set_style_text_font(entry->rssi_label, &lv_font_montserrat_12, 0);
+#if IS_ENABLED(CONFIG_PROSPECTOR_LINK_STATS)
+    lv_obj_align(entry->rssi_label, LV_ALIGN_LEFT_MID, left_offset + 34, -6);
+
+    entry->stats_label = lv_label_create(entry->container);
+    lv_obj_set_style_text_color(entry->stats_label, lv_color_hex(0x808080), 0);
+    lv_obj_set_style_text_font(entry->stats_label, &lv_font_unscii_8, 0);
+    lv_obj_align(entry->stats_label, LV_ALIGN_LEFT_MID, left_offset + 34, 8);
+    entry->pps_x10_shown = UINT16_MAX;  /* Nothing shown yet */
+    ks_set_stats_text(entry, kbd);
+#else
     lv_obj_align(entry->rssi_label, LV_ALIGN_LEFT_MID, left_offset + 34, 0);
+#endif
 
     /* Keyboard name */
     entry->name_label = lv_label_create(entry->container);
@@ -2907,7 +3421,48 @@ static void ks_create_entry(int entry_idx, int y_pos, int keyboard_index,
     lv_obj_set_style_text_font(entry->name_label, &lv_font_montserrat_16, 0);
     lv_obj_align(entry->name_label, LV_ALIGN_LEFT_MID, left_offset + 92, 0);
 
-    LOG_DBG("Created keyboard entry %d: %s (rssi=%d, ch=%d)", entry_idx, name, rssi, channel);
+    LOG_DBG("Created keyboard entry %d: %s (rssi=%d, ch=%d)", row, name, rssi, channel);
+}
+
+/* Bring an existing row up to date with a newer snapshot of its slot */
+static void ks_patch_entry(struct ks_keyboard_entry *entry, const struct zmk_keyboard_status *kbd,
+                           uint32_t gen) {
+    if (kbd->name != entry->name) {
+        char name[MAX_NAME_LEN];
+        lv_label_set_text(entry->name_label, kbd_name_text(kbd, name, sizeof(name)));
+        entry->name = kbd->name;
+    }
+
+    int8_t rssi = ks_rssi_of(kbd);
+    uint8_t bars = ks_rssi_to_bars(rssi);
+    if (bars != entry->rssi_bars) {
+        lv_bar_set_value(entry->rssi_bar, bars, LV_ANIM_OFF);
+        lv_obj_set_style_bg_color(entry->rssi_bar, ks_get_rssi_color(bars), LV_PART_INDICATOR);
+        entry->rssi_bars = bars;
+    }
+    if (bars != ks_rssi_to_bars(entry->rssi_shown) ||
+        abs(rssi - entry->rssi_shown) >= KS_RSSI_LABEL_STEP_DB) {
+        char rssi_buf[16];
+        snprintf(rssi_buf, sizeof(rssi_buf), "%ddBm", rssi);
+        lv_label_set_text(entry->rssi_label, rssi_buf);
+        entry->rssi_shown = rssi;
+    }
+#if IS_ENABLED(CONFIG_PROSPECTOR_LINK_STATS)
+    ks_set_stats_text(entry, kbd);
+#endif
+
+    if (kbd->data.channel != entry->channel) {
+        uint8_t channel = kbd->data.channel;
+        char ch_buf[4];
+        snprintf(ch_buf, sizeof(ch_buf), "%d", channel);
+        lv_label_set_text(entry->channel_label, ch_buf);
+        lv_obj_set_style_bg_color(entry->channel_badge, get_channel_color(channel), 0);
+        lv_obj_remove_event_cb(entry->channel_badge, ks_badge_tap_cb);
+        lv_obj_add_event_cb(entry->channel_badge, ks_badge_tap_cb, LV_EVENT_CLICKED,
+                            (void *)(intptr_t)channel);
+        entry->channel = channel;
+    }
+    entry->gen = gen;
 }
 
 /* Destroy a single keyboard entry */
@@ -2920,6 +3475,10 @@ static void ks_destroy_entry(struct ks_keyboard_entry *entry) {
     entry->rssi_label = NULL;
     entry->name_label = NULL;
     entry->channel_badge = NULL;
+    entry->channel_label = NULL;
+#if IS_ENABLED(CONFIG_PROSPECTOR_LINK_STATS)
+    entry->stats_label = NULL;
+#endif
     entry->keyboard_index = -1;
 }
 
@@ -3146,119 +3705,92 @@ static void ks_badge_tap_cb(lv_event_t *e) {
     ks_channel_change((uint8_t)channel);
 }
 
-/* Update keyboard entries with current scanner data */
+/* Update keyboard entries with current scanner data.
+ * Rows are matched to slots by keyboard_index: a slot whose generation
+ * hasn't moved keeps its row untouched, a changed slot only has the
+ * widgets that differ patched, and rows are added or removed (shifting
+ * the ones below) without rebuilding the list. */
 static void ks_update_entries(void) {
-    /* Count active keyboards (with channel filtering) */
-    int active_keyboards[KS_MAX_KEYBOARDS];
-    int active_count = 0;
-
     uint8_t scanner_ch = scanner_get_runtime_channel();
-
-    for (int i = 0; i < CONFIG_PROSPECTOR_MAX_KEYBOARDS && active_count < KS_MAX_KEYBOARDS; i++) {
-        struct zmk_keyboard_status *kbd = zmk_status_scanner_get_keyboard(i);
-        if (!kbd || !kbd->active) continue;
+    bool refilter = scanner_ch != ks_entries_filter;
+    ks_entries_filter = scanner_ch;
+
+    /* Slots are copied with scanner_snapshot_keyboard(): the work handler
+     * keeps writing keyboards[] while this runs */
+    struct zmk_keyboard_status kbd;
+    uint32_t gen;
+    struct ks_keyboard_entry next[KS_MAX_KEYBOARDS];
+    int next_count = 0;
+    int old = 0;  /* Walks ks_entries[] alongside the slots */
+    int old_count = ks_entry_count;
+
+    for (int i = 0; i < CONFIG_PROSPECTOR_MAX_KEYBOARDS && next_count < KS_MAX_KEYBOARDS; i++) {
+        /* Rows of earlier slots that are no longer listed */
+        while (old < ks_entry_count && ks_entries[old].keyboard_index < i) {
+            ks_destroy_entry(&ks_entries[old++]);
+        }
+        struct ks_keyboard_entry *row =
+            (old < ks_entry_count && ks_entries[old].keyboard_index == i) ? &ks_entries[old] : NULL;
+
+        /* Unchanged slot, same filter: nothing to redraw */
+        if (row && !refilter && scanner_keyboard_generation(i) == row->gen) {
+            next[next_count++] = *row;
+            old++;
+            continue;
+        }
 
         /* Channel filtering:
          *   scanner_ch = CHANNEL_ALL (10): Show all keyboards
          *   scanner_ch = 0-9: Only show keyboards with matching channel
          */
-        if (scanner_ch != CHANNEL_ALL && kbd->data.channel != scanner_ch) {
-            continue;  /* Skip keyboards that don't match filter */
+        if (!scanner_snapshot_keyboard(i, &kbd, &gen) ||
+            (scanner_ch != CHANNEL_ALL && kbd.data.channel != scanner_ch)) {
+            continue;  /* Its row, if any, goes on the next pass of the loop above */
         }
 
-        active_keyboards[active_count++] = i;
+        if (row) {
+            ks_patch_entry(row, &kbd, gen);
+            next[next_count++] = *row;
+            old++;
+        } else {
+            ks_create_entry(&next[next_count], next_count, i, &kbd, gen);
+            next_count++;
+        }
     }
-
-    /* Auto-select first keyboard if none selected */
-    if (ks_selected_keyboard < 0 && active_count > 0) {
-        ks_selected_keyboard = active_keyboards[0];
-        LOG_INF("Auto-selected keyboard index %d", ks_selected_keyboard);
+    while (old < ks_entry_count) {
+        ks_destroy_entry(&ks_entries[old++]);
     }
 
-    /* Check if selected keyboard is still active */
-    if (ks_selected_keyboard >= 0 && active_count > 0) {
-        bool found = false;
-        for (int i = 0; i < active_count; i++) {
-            if (active_keyboards[i] == ks_selected_keyboard) {
-                found = true;
-                break;
-            }
-        }
-        if (!found) {
-            ks_selected_keyboard = active_keyboards[0];
-            LOG_INF("Selected keyboard lost, switched to index %d", ks_selected_keyboard);
+    /* Shift surviving rows into their new positions */
+    for (int i = 0; i < next_count; i++) {
+        if (next[i].row != i) {
+            lv_obj_set_y(next[i].container, KS_LIST_Y + i * KS_LIST_SPACING);
+            next[i].row = i;
         }
+        ks_entries[i] = next[i];
+    }
+    for (int i = next_count; i < KS_MAX_KEYBOARDS; i++) {
+        ks_entries[i] = (struct ks_keyboard_entry){.keyboard_index = -1};
+    }
+    ks_entry_count = next_count;
+    if (next_count != old_count) {
+        LOG_INF("Keyboard count changed: %d -> %d", old_count, next_count);
     }
 
-    /* Recreate entries if count changed */
-    if (active_count != ks_entry_count) {
-        LOG_INF("Keyboard count changed: %d -> %d", ks_entry_count, active_count);
-
-        /* Destroy all existing entries */
-        for (int i = 0; i < ks_entry_count; i++) {
-            ks_destroy_entry(&ks_entries[i]);
-        }
-        ks_entry_count = 0;
-
-        /* Create new entries */
-        int y_pos = 55;  /* Start below title/channel selector */
-        int spacing = 40;
-
-        for (int i = 0; i < active_count; i++) {
-            int kbd_idx = active_keyboards[i];
-            struct zmk_keyboard_status *kbd = zmk_status_scanner_get_keyboard(kbd_idx);
-            if (!kbd) continue;
-
-            const char *name = kbd->ble_name[0] ? kbd->ble_name : "Unknown";
-            uint8_t channel = kbd->data.channel;  /* Get keyboard's channel */
-            ks_create_entry(i, y_pos + (i * spacing), kbd_idx, name, kbd->rssi, channel);
-        }
-        ks_entry_count = active_count;
-    } else {
-        /* Just update existing entries (same channel filter as creation path) */
-        int entry_idx = 0;
-        for (int i = 0; i < CONFIG_PROSPECTOR_MAX_KEYBOARDS && entry_idx < ks_entry_count; i++) {
-            struct zmk_keyboard_status *kbd = zmk_status_scanner_get_keyboard(i);
-            if (!kbd || !kbd->active) continue;
-
-            /* Apply same channel filter as creation path */
-            if (scanner_ch != CHANNEL_ALL && kbd->data.channel != scanner_ch) {
-                continue;
-            }
-
-            struct ks_keyboard_entry *entry = &ks_entries[entry_idx];
-            if (!entry->container) {
-                entry_idx++;
-                continue;
-            }
-
-            /* Update name */
-            const char *name = kbd->ble_name[0] ? kbd->ble_name : "Unknown";
-            lv_label_set_text(entry->name_label, name);
-
-            /* Update RSSI */
-            uint8_t bars = ks_rssi_to_bars(kbd->rssi);
-            lv_bar_set_value(entry->rssi_bar, bars, LV_ANIM_OFF);
-            lv_obj_set_style_bg_color(entry->rssi_bar, ks_get_rssi_color(bars), LV_PART_INDICATOR);
-            char rssi_buf[16];
-            snprintf(rssi_buf, sizeof(rssi_buf), "%ddBm", kbd->rssi);
-            lv_label_set_text(entry->rssi_label, rssi_buf);
-
-            /* Update selection styling */
-            bool is_selected = (entry->keyboard_index == ks_selected_keyboard);
-            if (is_selected) {
-                lv_obj_set_style_bg_color(entry->container, lv_color_hex(0x2A4A6A), 0);
-                lv_obj_set_style_border_color(entry->container, lv_color_hex(0x4A90E2), 0);
-                lv_obj_set_style_border_width(entry->container, 2, 0);
-            } else {
-                lv_obj_set_style_bg_color(entry->container, lv_color_hex(0x1A1A1A), 0);
-                lv_obj_set_style_border_color(entry->container, lv_color_hex(0x303030), 0);
-                lv_obj_set_style_border_width(entry->container, 1, 0);
-            }
-
-            entry_idx++;
+    /* Auto-select the first keyboard if none is selected or it was lost */
+    bool found = false;
+    for (int i = 0; i < ks_entry_count; i++) {
+        if (ks_entries[i].keyboard_index == ks_selected_keyboard) {
+            found = true;
+            break;
         }
     }
+    if (!found && ks_entry_count > 0) {
+        LOG_INF("%s keyboard index %d", ks_selected_keyboard < 0 ? "Auto-selected" :
+                "Selected keyboard lost, switched to", ks_entries[0].keyboard_index);
+        ks_selected_keyboard = ks_entries[0].keyboard_index;
+    }
+    ks_update_selection();
 }
 
 /* LVGL timer callback for periodic updates */
@@ -3276,10 +3808,14 @@ static void destroy_keyboard_select_widgets(void) {
     LOG_INF("Destroying keyboard select widgets...");
 
     /* Stop update timer */
+#if IS_ENABLED(CONFIG_PROSPECTOR_UI_DISPATCHER)
+    ui_deadline_disarm(UI_DEADLINE_KS_REFRESH);
+#else
     if (ks_update_timer) {
         lv_timer_del(ks_update_timer);
         ks_update_timer = NULL;
     }
+#endif
 
     /* Destroy all keyboard entries */
     for (int i = 0; i < ks_entry_count; i++) {
@@ -3356,11 +3892,350 @@ static void create_keyboard_select_widgets(void) {
     ks_update_entries();
 
     /* Start update timer (1 second interval) */
-    ks_update_timer = lv_timer_create(ks_update_timer_cb, 1000, NULL);
+#if IS_ENABLED(CONFIG_PROSPECTOR_UI_DISPATCHER)
+    ui_deadline_arm(UI_DEADLINE_KS_REFRESH, KS_UPDATE_INTERVAL_MS);
+#else
+    ks_update_timer = lv_timer_create(ks_update_timer_cb, KS_UPDATE_INTERVAL_MS, NULL);
+#endif
 
     LOG_INF("Keyboard select widgets created (%d keyboards)", ks_entry_count);
 }
 
+#if IS_ENABLED(CONFIG_PROSPECTOR_SCREEN_CACHE)
+/* Cached keyboard select shown again: catch up, then resume polling */
+static void ks_screen_shown(void) {
+    ks_selected_keyboard = scanner_get_selected_keyboard();
+    ks_update_channel_display();
+    ks_update_entries();
+#if IS_ENABLED(CONFIG_PROSPECTOR_UI_DISPATCHER)
+    ui_deadline_arm(UI_DEADLINE_KS_REFRESH, KS_UPDATE_INTERVAL_MS);
+#else
+    if (ks_update_timer) {
+        lv_timer_resume(ks_update_timer);
+    }
+#endif
+}
+
+static void ks_screen_hidden(void) {
+    ks_close_channel_popup();
+#if IS_ENABLED(CONFIG_PROSPECTOR_UI_DISPATCHER)
+    ui_deadline_disarm(UI_DEADLINE_KS_REFRESH);
+#else
+    if (ks_update_timer) {
+        lv_timer_pause(ks_update_timer);
+    }
+#endif
+}
+#endif
+
+/* ========== Dashboard Screen Widgets (CONFIG_PROSPECTOR_DASHBOARD) ========== */
+
+#if IS_ENABLED(CONFIG_PROSPECTOR_DASHBOARD)
+#define DB_MAX_TILES 4          /* Rows that fit below the title */
+#define DB_LIST_Y 42
+#define DB_TILE_SPACING 46
+#define DB_GEN_NONE UINT32_MAX  /* Odd: never a real generation */
+#define DB_NAME_NONE UINT16_MAX  /* Entry index no name table has */
+
+/* One tile per scanner slot, created while the slot is active */
+struct db_tile {
+    lv_obj_t *container;      /* Clickable: selects this keyboard */
+    lv_obj_t *name_label;
+    lv_obj_t *battery_label;
+    lv_obj_t *layer_label;
+    lv_obj_t *mods_label;
+    uint32_t gen;             /* Slot generation the tile was last checked at */
+    /* What the widgets currently show, so a refresh only touches what moved */
+    zmk_keyboard_name_t name;
+    uint8_t row;
+    uint8_t layer;
+    uint8_t mods;
+    uint8_t bat[4];
+    bool selected;
+};
+static struct db_tile db_tiles[CONFIG_PROSPECTOR_MAX_KEYBOARDS];
+static uint32_t db_visible = 0;  /* Slots with a tile, as a bit mask */
+static lv_obj_t *db_title_label = NULL;
+static lv_obj_t *db_empty_label = NULL;
+static lv_obj_t *db_nav_hint = NULL;
+
+static void db_tile_click_cb(lv_event_t *e) {
+    if (lv_event_get_code(e) != LV_EVENT_CLICKED) return;
+
+    int keyboard_index = (int)(intptr_t)lv_event_get_user_data(e);
+    LOG_INF("Dashboard: keyboard selected: index=%d", keyboard_index);
+    scanner_set_selected_keyboard(keyboard_index);
+    db_update_tiles();  /* Move the highlight now, not on the next change */
+}
+
+static void db_tile_set_selected(struct db_tile *tile, bool selected) {
+    lv_obj_set_style_border_color(tile->container,
+                                  lv_color_hex(selected ? 0x4A90E2 : 0x303030), 0);
+    lv_obj_set_style_border_width(tile->container, selected ? 2 : 1, 0);
+    tile->selected = selected;
+}
+
+static void db_set_layer_text(struct db_tile *tile, const struct zmk_keyboard_status *kbd) {
+    uint8_t layer = kbd->data.active_layer;
+    char buf[ZMK_STATUS_ADV_EXT_LAYER_NAME_MAX + 8];
+
+    /* Full name from the static packet's table, else the advertised short one */
+    if (layer < kbd->static_info.layer_count && layer < ZMK_STATUS_ADV_STATIC_MAX_LAYERS &&
+        kbd->static_info.layer_names[layer][0]) {
+        snprintf(buf, sizeof(buf), "L%u %s", layer, kbd->static_info.layer_names[layer]);
+    } else {
+        snprintf(buf, sizeof(buf), "L%u %.4s", layer, kbd->data.layer_name);
+    }
+    lv_label_set_text(tile->layer_label, buf);
+    tile->layer = layer;
+}
+
+static void db_set_mods_text(struct db_tile *tile, uint8_t mods) {
+    static const struct {
+        uint8_t flags;
+        const char *text;
+    } db_mods[] = {
+        {ZMK_MOD_FLAG_LCTL | ZMK_MOD_FLAG_RCTL, "Ctl"},
+        {ZMK_MOD_FLAG_LSFT | ZMK_MOD_FLAG_RSFT, "Sft"},
+        {ZMK_MOD_FLAG_LALT | ZMK_MOD_FLAG_RALT, "Alt"},
+        {ZMK_MOD_FLAG_LGUI | ZMK_MOD_FLAG_RGUI, "Gui"},
+    };
+    char buf[20] = "";
+    int len = 0;
+
+    for (int i = 0; i < ARRAY_SIZE(db_mods); i++) {
+        if (mods & db_mods[i].flags) {
+            len += snprintf(buf + len, sizeof(buf) - len, "%s%s", len ? " " : "",
+                            db_mods[i].text);
+        }
+    }
+    lv_label_set_text(tile->mods_label, buf);
+    tile->mods = mods;
+}
+
+static void db_set_battery_text(struct db_tile *tile, const uint8_t bat[4]) {
+    char buf[24] = "";
+    int len = 0;
+
+    for (int i = 0; i < 4; i++) {
+        if (bat[i] > 0) {
+            len += snprintf(buf + len, sizeof(buf) - len, "%s%u%%", len ? " " : "", bat[i]);
+        }
+    }
+    lv_label_set_text(tile->battery_label, buf);
+    memcpy(tile->bat, bat, sizeof(tile->bat));
+}
+
+static void db_create_tile(struct db_tile *tile, int keyboard_index) {
+    tile->container = lv_obj_create(screen_obj);
+    lv_obj_set_size(tile->container, 250, 40);
+    lv_obj_set_pos(tile->container, 15, DB_LIST_Y);
+    lv_obj_set_style_bg_color(tile->container, lv_color_hex(0x1A1A1A), 0);
+    lv_obj_set_style_bg_opa(tile->container, LV_OPA_COVER, 0);
+    lv_obj_set_style_radius(tile->container, 6, 0);
+    lv_obj_set_style_pad_all(tile->container, 0, 0);
+    lv_obj_clear_flag(tile->container, LV_OBJ_FLAG_SCROLLABLE);
+    lv_obj_add_flag(tile->container, LV_OBJ_FLAG_CLICKABLE);
+    lv_obj_add_event_cb(tile->container, db_tile_click_cb, LV_EVENT_CLICKED,
+                        (void *)(intptr_t)keyboard_index);
+    db_tile_set_selected(tile, false);
+
+    tile->name_label = lv_label_create(tile->container);
+    lv_obj_set_style_text_font(tile->name_label, &lv_font_montserrat_16, 0);
+    lv_obj_set_style_text_color(tile->name_label, lv_color_white(), 0);
+    lv_label_set_long_mode(tile->name_label, LV_LABEL_LONG_DOT);
+    lv_obj_set_width(tile->name_label, 150);
+    lv_label_set_text(tile->name_label, "");
+    lv_obj_align(tile->name_label, LV_ALIGN_TOP_LEFT, 8, 2);
+
+    tile->battery_label = lv_label_create(tile->container);
+    lv_obj_set_style_text_font(tile->battery_label, &lv_font_montserrat_12, 0);
+    lv_obj_set_style_text_color(tile->battery_label, lv_color_hex(0x00CC66), 0);
+    lv_obj_align(tile->battery_label, LV_ALIGN_TOP_RIGHT, -8, 4);
+
+    tile->layer_label = lv_label_create(tile->container);
+    lv_obj_set_style_text_font(tile->layer_label, &lv_font_montserrat_12, 0);
+    lv_obj_set_style_text_color(tile->layer_label, lv_color_hex(0x4A90E2), 0);
+    lv_obj_align(tile->layer_label, LV_ALIGN_BOTTOM_LEFT, 8, -3);
+
+    tile->mods_label = lv_label_create(tile->container);
+    lv_obj_set_style_text_font(tile->mods_label, &lv_font_montserrat_12, 0);
+    lv_obj_set_style_text_color(tile->mods_label, lv_color_hex(0xFFCC00), 0);
+    lv_obj_align(tile->mods_label, LV_ALIGN_BOTTOM_RIGHT, -8, -3);
+
+    /* Nothing shown yet: the first patch sets every label */
+    tile->name = DB_NAME_NONE;
+    tile->row = 0;
+    tile->layer = UINT8_MAX;
+    tile->mods = UINT8_MAX;
+    memset(tile->bat, UINT8_MAX, sizeof(tile->bat));
+}
+
+/* Set the widgets of a tile whose slot changed, only where the value did */
+static void db_patch_tile(struct db_tile *tile, const struct zmk_keyboard_status *kbd) {
+    if (kbd->name != tile->name) {
+        char name[MAX_NAME_LEN];
+        lv_label_set_text(tile->name_label, kbd_name_text(kbd, name, sizeof(name)));
+        tile->name = kbd->name;
+    }
+
+    /* The layer table arrives after the first frames: recheck until it has */
+    if (kbd->data.active_layer != tile->layer || kbd->static_info.hash == 0) {
+        db_set_layer_text(tile, kbd);
+    }
+    if (kbd->data.modifier_flags != tile->mods) {
+        db_set_mods_text(tile, kbd->data.modifier_flags);
+    }
+
+    uint8_t bat[4] = {kbd->data.battery_level, kbd->data.peripheral_battery[0],
+                      kbd->data.peripheral_battery[1], kbd->data.peripheral_battery[2]};
+    if (memcmp(bat, tile->bat, sizeof(bat)) != 0) {
+        db_set_battery_text(tile, bat);
+    }
+}
+
+static void db_destroy_tile(struct db_tile *tile) {
+    if (tile->container) {
+        lv_obj_del(tile->container);  /* Deletes all children too */
+    }
+    *tile = (struct db_tile){.gen = DB_GEN_NONE};
+}
+
+/* Refresh the dashboard. A slot whose generation hasn't moved costs one
+ * atomic read; a changed one gets one snapshot and only its differing
+ * widgets set. Tiles keep slot order and only move when a keyboard
+ * appears or goes. The first DB_MAX_TILES active slots get a tile; any
+ * tile past that is deleted, so none is left at a stale row. */
+static void db_update_tiles(void) {
+    if (!db_title_label) {
+        return;  /* Not built */
+    }
+
+    struct zmk_keyboard_status kbd;
+    uint32_t gen;
+    uint32_t visible = 0;
+    int shown = 0;
+
+    for (int i = 0; i < CONFIG_PROSPECTOR_MAX_KEYBOARDS; i++) {
+        struct db_tile *tile = &db_tiles[i];
+
+        if (scanner_keyboard_generation(i) == tile->gen) {
+            if (tile->container && shown >= DB_MAX_TILES) {
+                /* Pushed down by a lower slot that appeared: no row left */
+                db_destroy_tile(tile);
+            } else if (tile->container) {
+                visible |= BIT(i);
+                shown++;
+            }
+            continue;
+        }
+        if (!scanner_snapshot_keyboard(i, &kbd, &gen)) {
+            db_destroy_tile(tile);
+            tile->gen = gen;  /* Odd if the copy failed: retried next pass */
+            continue;
+        }
+        if (shown >= DB_MAX_TILES) {
+            db_destroy_tile(tile);  /* No room: looked at again next pass */
+            continue;
+        }
+        if (!tile->container) {
+            db_create_tile(tile, i);
+        }
+        db_patch_tile(tile, &kbd);
+        tile->gen = gen;
+        visible |= BIT(i);
+        shown++;
+    }
+
+    /* Rows follow slot order among the visible tiles */
+    if (visible != db_visible) {
+        int row = 0;
+        for (int i = 0; i < CONFIG_PROSPECTOR_MAX_KEYBOARDS; i++) {
+            if (!(visible & BIT(i))) {
+                continue;
+            }
+            if (db_tiles[i].row != row || !(db_visible & BIT(i))) {
+                lv_obj_set_y(db_tiles[i].container, DB_LIST_Y + row * DB_TILE_SPACING);
+                db_tiles[i].row = row;
+            }
+            row++;
+        }
+        if (visible == 0) {
+            lv_obj_clear_flag(db_empty_label, LV_OBJ_FLAG_HIDDEN);
+        } else {
+            lv_obj_add_flag(db_empty_label, LV_OBJ_FLAG_HIDDEN);
+        }
+        LOG_INF("Dashboard: %d keyboard(s) shown", shown);
+        db_visible = visible;
+    }
+
+    int selected = scanner_get_selected_keyboard();
+    for (int i = 0; i < CONFIG_PROSPECTOR_MAX_KEYBOARDS; i++) {
+        if (db_tiles[i].container && db_tiles[i].selected != (i == selected)) {
+            db_tile_set_selected(&db_tiles[i], i == selected);
+        }
+    }
+}
+
+static void destroy_dashboard_widgets(void) {
+    LOG_INF("Destroying dashboard widgets...");
+    scanner_watch_all_keyboards(false);
+
+    for (int i = 0; i < CONFIG_PROSPECTOR_MAX_KEYBOARDS; i++) {
+        db_destroy_tile(&db_tiles[i]);
+    }
+    db_visible = 0;
+
+    if (db_nav_hint) { lv_obj_del(db_nav_hint); db_nav_hint = NULL; }
+    if (db_empty_label) { lv_obj_del(db_empty_label); db_empty_label = NULL; }
+    if (db_title_label) { lv_obj_del(db_title_label); db_title_label = NULL; }
+}
+
+static void create_dashboard_widgets(void) {
+    LOG_INF("Creating dashboard widgets...");
+
+    db_title_label = lv_label_create(screen_obj);
+    lv_obj_set_style_text_font(db_title_label, &lv_font_montserrat_20, 0);
+    lv_obj_set_style_text_color(db_title_label, lv_color_white(), 0);
+    lv_label_set_text(db_title_label, "Dashboard");
+    lv_obj_align(db_title_label, LV_ALIGN_TOP_LEFT, 15, 12);
+
+    db_nav_hint = lv_label_create(screen_obj);
+    lv_obj_set_style_text_font(db_nav_hint, &lv_font_montserrat_12, 0);
+    lv_obj_set_style_text_color(db_nav_hint, lv_color_hex(0x808080), 0);
+    lv_label_set_text(db_nav_hint, "Swipe: Main");
+    lv_obj_align(db_nav_hint, LV_ALIGN_TOP_RIGHT, -15, 18);
+
+    /* Shown while no keyboard is active */
+    db_empty_label = lv_label_create(screen_obj);
+    lv_obj_set_style_text_font(db_empty_label, &lv_font_montserrat_16, 0);
+    lv_obj_set_style_text_color(db_empty_label, lv_color_hex(0x808080), 0);
+    lv_label_set_text(db_empty_label, "Scanning...");
+    lv_obj_center(db_empty_label);
+
+    for (int i = 0; i < CONFIG_PROSPECTOR_MAX_KEYBOARDS; i++) {
+        db_tiles[i] = (struct db_tile){.gen = DB_GEN_NONE};
+    }
+    db_visible = 0;
+    db_update_tiles();
+    scanner_watch_all_keyboards(true);
+
+    LOG_INF("Dashboard widgets created");
+}
+
+#if IS_ENABLED(CONFIG_PROSPECTOR_SCREEN_CACHE)
+/* Cached dashboard shown again: catch up, then follow every slot again */
+static void db_screen_shown(void) {
+    db_update_tiles();
+    scanner_watch_all_keyboards(true);
+}
+
+static void db_screen_hidden(void) {
+    scanner_watch_all_keyboards(false);
+}
+#endif
+#endif /* CONFIG_PROSPECTOR_DASHBOARD */
+
 /* ========== Prospector Display (Carrefinho-inspired layouts) ========== */
 
 static void destroy_prospector_display_widgets(void) {
@@ -3428,20 +4303,230 @@ static inline void ensure_lvgl_indev_registered(void) {}
  * - Display Settings → UP → Main Screen
  * - Keyboard Select → DOWN → Main Screen
  * - Quick Actions → LEFT → Main Screen
+ * - Main Screen → DOUBLE TAP → Dashboard (CONFIG_PROSPECTOR_DASHBOARD)
+ * - Dashboard → any gesture → Main Screen
  *
  * Coordinate transform corrected - swipe directions now match user's physical gesture
  */
+/* ========== Screen Transitions ========== */
+
+struct screen_desc {
+    const char *name;
+    uint32_t bg_hex;
+    void (*create)(void);
+    void (*destroy)(void);
+    void (*on_show)(void);  /* Cached screen made visible again (optional) */
+    void (*on_hide)(void);  /* Cached screen about to be hidden (optional) */
+    bool save_on_leave;     /* Flush dirty display settings to NVS when leaving */
+    bool memory_heavy;      /* Never cached: freed when left, rebuilt on return */
+};
+
+static const struct screen_desc screens[] = {
+    [SCREEN_MAIN] = {
+        .name = "MAIN", .bg_hex = 0x000000,
+        .create = create_main_screen_widgets, .destroy = destroy_main_screen_widgets,
+    },
+    [SCREEN_DISPLAY_SETTINGS] = {
+        .name = "DISPLAY_SETTINGS", .bg_hex = 0x0A0A0A,
+        .create = create_display_settings_widgets, .destroy = destroy_display_settings_widgets,
+        .save_on_leave = true,
+    },
+    [SCREEN_SYSTEM_SETTINGS] = {
+        .name = "QUICK_ACTIONS", .bg_hex = 0x0A0A0A,
+        .create = create_system_settings_widgets, .destroy = destroy_system_settings_widgets,
+        .on_show = ss_update_kb_version_label,
+#if IS_ENABLED(CONFIG_PROSPECTOR_PERF_PANEL)
+        .on_hide = perf_panel_close,  /* No sampling behind a hidden screen */
+#endif
+        .save_on_leave = true,
+    },
+    [SCREEN_KEYBOARD_SELECT] = {
+        .name = "KEYBOARD_SELECT", .bg_hex = 0x0A0A0A,
+        .create = create_keyboard_select_widgets, .destroy = destroy_keyboard_select_widgets,
+#if IS_ENABLED(CONFIG_PROSPECTOR_SCREEN_CACHE)
+        .on_show = ks_screen_shown, .on_hide = ks_screen_hidden,
+#endif
+    },
+    /* Layout objects and their animation timers are the bulk of the LVGL pool */
+    [SCREEN_PROSPECTOR_DISPLAY] = {
+        .name = "PROSPECTOR_DISPLAY", .bg_hex = 0x000000,
+        .create = create_prospector_display_widgets,
+        .destroy = destroy_prospector_display_widgets,
+        .save_on_leave = true, .memory_heavy = true,
+    },
+#if IS_ENABLED(CONFIG_PROSPECTOR_DASHBOARD)
+    [SCREEN_DASHBOARD] = {
+        .name = "DASHBOARD", .bg_hex = 0x0A0A0A,
+        .create = create_dashboard_widgets, .destroy = destroy_dashboard_widgets,
+#if IS_ENABLED(CONFIG_PROSPECTOR_SCREEN_CACHE)
+        .on_show = db_screen_shown, .on_hide = db_screen_hidden,
+#endif
+    },
+#endif
+};
+
+#if IS_ENABLED(CONFIG_PROSPECTOR_SCREEN_CACHE)
+static lv_obj_t *screen_roots[ARRAY_SIZE(screens)];
+
+/* Full-screen container for a screen's widgets, created hidden on first use */
+static lv_obj_t *screen_root_get(enum screen_state s) {
+    if (!screen_roots[s]) {
+        lv_obj_t *root = lv_obj_create(base_screen);
+        lv_obj_remove_style_all(root);
+        lv_obj_set_size(root, LV_PCT(100), LV_PCT(100));
+        lv_obj_set_style_bg_color(root, lv_color_hex(screens[s].bg_hex), 0);
+        lv_obj_set_style_bg_opa(root, LV_OPA_COVER, 0);
+        lv_obj_clear_flag(root, LV_OBJ_FLAG_SCROLLABLE);
+        lv_obj_add_flag(root, LV_OBJ_FLAG_HIDDEN);
+        screen_roots[s] = root;
+    }
+    return screen_roots[s];
+}
+
+/* Hide @from (free it if memory-heavy) and show @to, building it on first use */
+static void screen_cache_switch(enum screen_state from, enum screen_state to) {
+    if (screen_roots[from]) {
+        if (screens[from].memory_heavy) {
+            screens[from].destroy();
+            lv_obj_del(screen_roots[from]);
+            screen_roots[from] = NULL;
+        } else {
+            if (screens[from].on_hide) {
+                screens[from].on_hide();
+            }
+            lv_obj_add_flag(screen_roots[from], LV_OBJ_FLAG_HIDDEN);
+        }
+    }
+
+    bool cached = screen_roots[to] != NULL;
+    screen_obj = screen_root_get(to);
+    lv_obj_clear_flag(screen_obj, LV_OBJ_FLAG_HIDDEN);
+    if (!cached) {
+        screens[to].create();
+    } else if (screens[to].on_show) {
+        screens[to].on_show();
+    }
+}
+#endif
+
+#if IS_ENABLED(CONFIG_PROSPECTOR_FAST_BOOT)
+/* One-shot: build only the screen shown first; the others are built on first use */
+static void boot_build_timer_cb(lv_timer_t *timer) {
+    ARG_UNUSED(timer);
+
+    /* Get the splash on the panel before spending time on the build */
+    lv_refr_now(NULL);
+
+#if CONFIG_PROSPECTOR_DEFAULT_LAYOUT > 0
+    enum screen_state initial = SCREEN_PROSPECTOR_DISPLAY;
+#else
+    enum screen_state initial = SCREEN_MAIN;
+#endif
+    uint32_t start = k_uptime_get_32();
+
+#if IS_ENABLED(CONFIG_PROSPECTOR_LVGL_HEAP_STATS)
+    lvgl_heap_stats_set_tag(initial, screens[initial].name);
+#endif
+    lv_obj_del(boot_splash);
+    boot_splash = NULL;
+#if IS_ENABLED(CONFIG_PROSPECTOR_SCREEN_CACHE)
+    screen_obj = screen_root_get(initial);
+    lv_obj_clear_flag(screen_obj, LV_OBJ_FLAG_HIDDEN);
+#else
+    lv_obj_set_style_bg_color(screen_obj, lv_color_hex(screens[initial].bg_hex), 0);
+#endif
+    screens[initial].create();
+
+#if CONFIG_PROSPECTOR_DEFAULT_LAYOUT > 0
+    /* Override NVS-saved layout with Kconfig default on first boot */
+    prospector_layout_t kconfig_layout = (prospector_layout_t)CONFIG_PROSPECTOR_DEFAULT_LAYOUT;
+    if (prospector_layouts_get_style() != kconfig_layout) {
+        prospector_layouts_set_style(kconfig_layout);
+    }
+#endif
+    current_screen = initial;
+#if IS_ENABLED(CONFIG_PROSPECTOR_LVGL_HEAP_STATS)
+    lvgl_heap_stats_sample(NULL);  /* Baseline for the first transition */
+#endif
+
+    ui_timers_register();
+    /* Keyboards found while the screen was being built */
+    scanner_msg_send_display_refresh();
+    LOG_INF("Initial screen %s built in %u ms", screens[initial].name,
+            k_uptime_get_32() - start);
+#if IS_ENABLED(CONFIG_PROSPECTOR_BOOT_TIMING)
+    boot_timing_mark(BOOT_MARK_UI_READY);
+#endif
+}
+#endif
+
+/* Called with transition_in_progress set, from the LVGL thread */
+static void switch_screen(enum screen_state to) {
+    enum screen_state from = current_screen;
+
+    LOG_INF(">>> Transitioning: %s -> %s", screens[from].name, screens[to].name);
+    if (screens[from].save_on_leave) {
+        display_settings_save_if_dirty();
+    }
+
+#if IS_ENABLED(CONFIG_PROSPECTOR_LVGL_HEAP_STATS)
+    struct lvgl_heap_snapshot heap_before;
+    lvgl_heap_stats_sample(&heap_before);
+    lvgl_heap_stats_set_tag(to, screens[to].name);
+#endif
+
+#if IS_ENABLED(CONFIG_PROSPECTOR_SCREEN_CACHE)
+    screen_cache_switch(from, to);
+#else
+    screens[from].destroy();
+    lv_obj_clean(screen_obj);
+    lv_obj_set_style_bg_color(screen_obj, lv_color_hex(screens[to].bg_hex), 0);
+    lv_obj_invalidate(screen_obj);
+    screens[to].create();
+#endif
+
+    if (to != SCREEN_MAIN) {
+        ensure_lvgl_indev_registered();  /* Sliders, switches, buttons, taps */
+    }
+    current_screen = to;
+    if (to == SCREEN_MAIN) {
+        scanner_msg_send_display_refresh();
+    }
+
+#if IS_ENABLED(CONFIG_PROSPECTOR_LVGL_HEAP_STATS)
+    /* Without the cache every screen left is destroyed */
+    bool from_dropped = !IS_ENABLED(CONFIG_PROSPECTOR_SCREEN_CACHE) || screens[from].memory_heavy;
+    lvgl_heap_stats_log_transition(screens[from].name, from, from_dropped, screens[to].name,
+                                   &heap_before);
+    if (to == SCREEN_SYSTEM_SETTINGS) {
+        ss_update_heap_label();
+    }
+#endif
+    LOG_INF(">>> Transition complete");
+}
+
 static void swipe_process_timer_cb(lv_timer_t *timer) {
     ARG_UNUSED(timer);
 
-    /* Check for pending swipe */
-    enum swipe_direction dir = pending_swipe;
+    /* Take the pending swipe, if any */
+    enum swipe_direction dir = swipe_take();
     if (dir == SWIPE_DIRECTION_NONE) {
         return;  /* No pending swipe */
     }
+#if IS_ENABLED(CONFIG_PROSPECTOR_TOUCH_LATENCY_BENCH)
+    touch_bench_mark(TOUCH_BENCH_PICKUP);
+#endif
 
-    /* Clear pending flag immediately (atomic read-then-clear) */
-    pending_swipe = SWIPE_DIRECTION_NONE;
+#if IS_ENABLED(CONFIG_PROSPECTOR_TOUCH_GESTURES)
+    /* One gesture per run, so each transition gets its frame */
+    if (!swipe_queue_empty()) {
+#if IS_ENABLED(CONFIG_PROSPECTOR_UI_DISPATCHER)
+        ui_post(UI_EVENT_SWIPE);
+#else
+        lv_timer_ready(swipe_process_timer);
+#endif
+    }
+#endif
 
     /* Skip if UI interaction in progress (slider dragging) */
     if (ui_interaction_active) {
@@ -3457,10 +4542,19 @@ static void swipe_process_timer_cb(lv_timer_t *timer) {
 
     LOG_INF("[MAIN THREAD] Processing swipe: direction=%d, current_screen=%d",
             dir, current_screen);
+    PSPTR_TRACE_SCOPE("psptr_swipe", ((uint32_t)dir << 8) | current_screen);
 
     /* Set transition flag to protect against concurrent operations */
     transition_in_progress = true;
 
+    /* The next screen needs the whole panel in full color */
+    panel_set_low_power(false, NULL);
+
+#if IS_ENABLED(CONFIG_PROSPECTOR_DASHBOARD)
+    if (current_screen == SCREEN_DASHBOARD) {
+        switch_screen(SCREEN_MAIN);  /* Every gesture leads back */
+    } else
+#endif
     switch (dir) {
     case SWIPE_DIRECTION_DOWN:
         /* Prospector Display: cycle layout */
@@ -3472,25 +4566,9 @@ static void swipe_process_timer_cb(lv_timer_t *timer) {
         }
         /* Main → Display Settings OR Keyboard Select → Main */
         if (current_screen == SCREEN_MAIN) {
-            LOG_INF(">>> Transitioning: MAIN -> DISPLAY_SETTINGS");
-            destroy_main_screen_widgets();
-            lv_obj_clean(screen_obj);
-            lv_obj_set_style_bg_color(screen_obj, lv_color_hex(0x0A0A0A), 0);
-            lv_obj_invalidate(screen_obj);
-            create_display_settings_widgets();
-            ensure_lvgl_indev_registered();  /* Register for slider/switch touch */
-            current_screen = SCREEN_DISPLAY_SETTINGS;
-            LOG_INF(">>> Transition complete");
+            switch_screen(SCREEN_DISPLAY_SETTINGS);
         } else if (current_screen == SCREEN_KEYBOARD_SELECT) {
-            LOG_INF(">>> Transitioning: KEYBOARD_SELECT -> MAIN");
-            destroy_keyboard_select_widgets();
-            lv_obj_clean(screen_obj);
-            lv_obj_set_style_bg_color(screen_obj, lv_color_black(), 0);
-            lv_obj_invalidate(screen_obj);
-            create_main_screen_widgets();
-            current_screen = SCREEN_MAIN;
-            scanner_msg_send_display_refresh();
-            LOG_INF(">>> Transition complete");
+            switch_screen(SCREEN_MAIN);
         }
         break;
 
@@ -3504,52 +4582,18 @@ static void swipe_process_timer_cb(lv_timer_t *timer) {
         }
         /* Display Settings → Main OR Main → Keyboard Select */
         if (current_screen == SCREEN_DISPLAY_SETTINGS) {
-            LOG_INF(">>> Transitioning: DISPLAY_SETTINGS -> MAIN");
-            display_settings_save_if_dirty();
-            destroy_display_settings_widgets();
-            lv_obj_clean(screen_obj);
-            lv_obj_set_style_bg_color(screen_obj, lv_color_black(), 0);
-            lv_obj_invalidate(screen_obj);
-            create_main_screen_widgets();
-            current_screen = SCREEN_MAIN;
-            scanner_msg_send_display_refresh();
-            LOG_INF(">>> Transition complete");
+            switch_screen(SCREEN_MAIN);
         } else if (current_screen == SCREEN_MAIN) {
-            LOG_INF(">>> Transitioning: MAIN -> KEYBOARD_SELECT");
-            destroy_main_screen_widgets();
-            lv_obj_clean(screen_obj);
-            lv_obj_set_style_bg_color(screen_obj, lv_color_hex(0x0A0A0A), 0);
-            lv_obj_invalidate(screen_obj);
-            create_keyboard_select_widgets();
-            ensure_lvgl_indev_registered();  /* Register for keyboard entry touch */
-            current_screen = SCREEN_KEYBOARD_SELECT;
-            LOG_INF(">>> Transition complete");
+            switch_screen(SCREEN_KEYBOARD_SELECT);
         }
         break;
 
     case SWIPE_DIRECTION_LEFT:
-        /* Main → Pong Wars OR Quick Actions → Main */
+        /* Main → Prospector Display OR Quick Actions → Main */
         if (current_screen == SCREEN_MAIN) {
-            LOG_INF(">>> Transitioning: MAIN -> PROSPECTOR_DISPLAY");
-            destroy_main_screen_widgets();
-            lv_obj_clean(screen_obj);
-            lv_obj_set_style_bg_color(screen_obj, lv_color_black(), 0);
-            lv_obj_invalidate(screen_obj);
-            create_prospector_display_widgets();
-            ensure_lvgl_indev_registered();  /* Register for tap-to-reset */
-            current_screen = SCREEN_PROSPECTOR_DISPLAY;
-            LOG_INF(">>> Transition complete");
+            switch_screen(SCREEN_PROSPECTOR_DISPLAY);
         } else if (current_screen == SCREEN_SYSTEM_SETTINGS) {
-            LOG_INF(">>> Transitioning: QUICK_ACTIONS -> MAIN");
-            display_settings_save_if_dirty();
-            destroy_system_settings_widgets();
-            lv_obj_clean(screen_obj);
-            lv_obj_set_style_bg_color(screen_obj, lv_color_black(), 0);
-            lv_obj_invalidate(screen_obj);
-            create_main_screen_widgets();
-            current_screen = SCREEN_MAIN;
-            scanner_msg_send_display_refresh();
-            LOG_INF(">>> Transition complete");
+            switch_screen(SCREEN_MAIN);
         } else if (current_screen == SCREEN_KEYBOARD_SELECT) {
             /* Channel decrement on left swipe */
             ks_close_channel_popup();  /* Close popup if open */
@@ -3559,28 +4603,11 @@ static void swipe_process_timer_cb(lv_timer_t *timer) {
         break;
 
     case SWIPE_DIRECTION_RIGHT:
-        /* Pong Wars → Main OR Main → Quick Actions */
+        /* Prospector Display → Main OR Main → Quick Actions */
         if (current_screen == SCREEN_PROSPECTOR_DISPLAY) {
-            LOG_INF(">>> Transitioning: PROSPECTOR_DISPLAY -> MAIN");
-            display_settings_save_if_dirty();
-            destroy_prospector_display_widgets();
-            lv_obj_clean(screen_obj);
-            lv_obj_set_style_bg_color(screen_obj, lv_color_black(), 0);
-            lv_obj_invalidate(screen_obj);
-            create_main_screen_widgets();
-            current_screen = SCREEN_MAIN;
-            scanner_msg_send_display_refresh();
-            LOG_INF(">>> Transition complete");
+            switch_screen(SCREEN_MAIN);
         } else if (current_screen == SCREEN_MAIN) {
-            LOG_INF(">>> Transitioning: MAIN -> QUICK_ACTIONS");
-            destroy_main_screen_widgets();
-            lv_obj_clean(screen_obj);
-            lv_obj_set_style_bg_color(screen_obj, lv_color_hex(0x0A0A0A), 0);
-            lv_obj_invalidate(screen_obj);
-            create_system_settings_widgets();
-            ensure_lvgl_indev_registered();  /* Register for button touch */
-            current_screen = SCREEN_SYSTEM_SETTINGS;
-            LOG_INF(">>> Transition complete");
+            switch_screen(SCREEN_SYSTEM_SETTINGS);
         } else if (current_screen == SCREEN_KEYBOARD_SELECT) {
             /* Channel increment on right swipe */
             ks_close_channel_popup();  /* Close popup if open */
@@ -3590,10 +4617,14 @@ static void swipe_process_timer_cb(lv_timer_t *timer) {
         break;
 
     case SWIPE_DIRECTION_DOUBLE_TAP:
-        /* Double-tap: cycle color palette on Prospector Display */
+        /* Double-tap: cycle color palette on Prospector Display, dashboard from Main */
         if (current_screen == SCREEN_PROSPECTOR_DISPLAY) {
             LOG_INF(">>> Prospector Display: cycle palette (double-tap)");
             prospector_layouts_cycle_palette();
+#if IS_ENABLED(CONFIG_PROSPECTOR_DASHBOARD)
+        } else if (current_screen == SCREEN_MAIN) {
+            switch_screen(SCREEN_DASHBOARD);
+#endif
         }
         break;
 
@@ -3602,13 +4633,59 @@ static void swipe_process_timer_cb(lv_timer_t *timer) {
                 dir, current_screen);
         break;
     }
+#if IS_ENABLED(CONFIG_PROSPECTOR_TOUCH_LATENCY_BENCH)
+    touch_bench_mark(TOUCH_BENCH_CREATED);
+#endif
 
     /* Clear transition flag */
     transition_in_progress = false;
 }
 
+#if IS_ENABLED(CONFIG_PROSPECTOR_UI_DISPATCHER)
+static void ui_dispatch_timer_cb(lv_timer_t *timer) {
+    ARG_UNUSED(timer);
+    atomic_val_t events = atomic_clear(&ui_events);
+
+    if (events & UI_EVENT_SWIPE) {
+        swipe_process_timer_cb(NULL);
+    }
+    if (events & UI_EVENT_ALS) {
+        auto_brightness_timer_cb(NULL);
+    }
+    /* A swipe onto a data screen also picks up what arrived meanwhile */
+    if (events & (UI_EVENT_PENDING | UI_EVENT_SWIPE)) {
+        pending_update_timer_cb(NULL);
+    }
+
+    uint32_t now = k_uptime_get_32();
+    if (prospector_sched_due(&ui_deadlines[UI_DEADLINE_KS_REFRESH], now)) {
+        prospector_sched_arm(&ui_deadlines[UI_DEADLINE_KS_REFRESH], now, KS_UPDATE_INTERVAL_MS,
+                             KS_UPDATE_INTERVAL_MS / 4);
+        ks_update_timer_cb(NULL);
+    }
+    if (prospector_sched_due(&ui_deadlines[UI_DEADLINE_AUTO_BRIGHTNESS], now)) {
+        prospector_sched_arm(&ui_deadlines[UI_DEADLINE_AUTO_BRIGHTNESS], now,
+                             AUTO_BRIGHTNESS_INTERVAL_MS, AUTO_BRIGHTNESS_INTERVAL_MS / 4);
+        auto_brightness_timer_cb(NULL);
+    }
+
+    ui_dispatch_reschedule(k_uptime_get_32());
+}
+#endif
+
 /* ========== Swipe Event Handler (runs in ISR context - just set flag!) ========== */
 
+#if IS_ENABLED(CONFIG_PROSPECTOR_TOUCH_GESTURES) && !IS_ENABLED(CONFIG_PROSPECTOR_UI_DISPATCHER)
+static void swipe_kick_work_handler(struct k_work *work) {
+    ARG_UNUSED(work);
+    if (swipe_process_timer) {
+        lv_timer_ready(swipe_process_timer);  /* Runs on the next LVGL tick */
+    }
+}
+
+static K_WORK_DEFINE(swipe_kick_work, swipe_kick_work_handler);
+#endif
+
 /**
  * ZMK event listener - runs synchronously in the thread that raises the event.
  * Since touch_handler raises events from INPUT thread (ISR context),
@@ -3620,6 +4697,15 @@ static int swipe_gesture_listener(const zmk_event_t *eh) {
     const struct zmk_swipe_gesture_event *ev = as_zmk_swipe_gesture_event(eh);
     if (ev == NULL) return ZMK_EV_EVENT_BUBBLE;
 
+#if IS_ENABLED(CONFIG_PROSPECTOR_TOUCH_GESTURES)
+    /* The gesture engine already gives one gesture per contact: queue it */
+    if (!swipe_queue_push(ev->direction)) {
+        LOG_WRN("Swipe dropped - %d gestures already queued", SWIPE_QUEUE_SIZE);
+        return ZMK_EV_EVENT_BUBBLE;
+    }
+    LOG_INF("[ISR] Swipe event received: direction=%d speed=%u (queued)", ev->direction,
+            ev->speed);
+#else
     /* Skip if already have pending swipe (debounce) */
     if (pending_swipe != SWIPE_DIRECTION_NONE) {
         LOG_DBG("Swipe queued - already have pending swipe");
@@ -3631,6 +4717,21 @@ static int swipe_gesture_listener(const zmk_event_t *eh) {
 
     /* Just set the flag - processing happens in LVGL timer (main thread) */
     pending_swipe = ev->direction;
+#endif
+#if IS_ENABLED(CONFIG_PROSPECTOR_TOUCH_LATENCY_BENCH)
+    touch_bench_mark(TOUCH_BENCH_LISTENER);
+#endif
+#if IS_ENABLED(CONFIG_PROSPECTOR_SCANNER_DISPLAY_SLEEP)
+    scanner_display_resume();  /* The swipe timer is paused while asleep */
+#endif
+#if IS_ENABLED(CONFIG_PROSPECTOR_UI_DISPATCHER)
+    ui_post(UI_EVENT_SWIPE);
+#elif IS_ENABLED(CONFIG_PROSPECTOR_TOUCH_GESTURES)
+    /* Handle it on the next LVGL tick instead of the next 50ms poll */
+    if (zmk_display_is_initialized()) {
+        k_work_submit_to_queue(zmk_display_work_q(), &swipe_kick_work);
+    }
+#endif
 
     return ZMK_EV_EVENT_BUBBLE;
 }
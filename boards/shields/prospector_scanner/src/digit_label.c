@@ -0,0 +1,111 @@
+/*
+ * Copyright (c) 2024 The ZMK Contributors
+ *
+ * SPDX-License-Identifier: MIT
+ */
+
+#include <string.h>
+#include <lvgl.h>
+
+#include "digit_label.h"
+
+struct digit_label {
+    const struct digit_atlas *atlas;
+    uint8_t len;
+    int8_t cells[DIGIT_LABEL_MAX_CHARS];  /* atlas index, -1 = blank */
+    char text[DIGIT_LABEL_MAX_CHARS + 1];
+};
+
+static int32_t cell_advance(lv_obj_t *obj, const struct digit_label *dl) {
+    return dl->atlas->cell_w + lv_obj_get_style_text_letter_space(obj, LV_PART_MAIN);
+}
+
+static void draw_text(lv_obj_t *obj, const struct digit_label *dl, lv_layer_t *layer) {
+    const struct digit_atlas *atlas = dl->atlas;
+    lv_area_t area;
+    lv_obj_get_content_coords(obj, &area);
+
+    lv_draw_image_dsc_t dsc;
+    lv_draw_image_dsc_init(&dsc);
+    /* A8 images are drawn as a mask in the recolor */
+    dsc.recolor = lv_obj_get_style_text_color(obj, LV_PART_MAIN);
+    dsc.recolor_opa = LV_OPA_COVER;
+    dsc.opa = lv_obj_get_style_text_opa(obj, LV_PART_MAIN);
+
+    int32_t advance = cell_advance(obj, dl);
+    area.y2 = area.y1 + atlas->cell_h - 1;
+    for (int i = 0; i < dl->len; i++, area.x1 += advance) {
+        if (dl->cells[i] < 0) {
+            continue;
+        }
+        area.x2 = area.x1 + atlas->cell_w - 1;
+        dsc.src = &atlas->glyphs[dl->cells[i]];
+        lv_draw_image(layer, &dsc, &area);
+    }
+}
+
+static void event_cb(lv_event_t *e) {
+    lv_obj_t *obj = lv_event_get_target(e);
+    struct digit_label *dl = lv_obj_get_user_data(obj);
+
+    switch (lv_event_get_code(e)) {
+    case LV_EVENT_DRAW_MAIN:
+        draw_text(obj, dl, lv_event_get_layer(e));
+        break;
+    case LV_EVENT_GET_SELF_SIZE: {
+        lv_point_t *size = lv_event_get_param(e);
+        int32_t w = dl->len ? dl->len * cell_advance(obj, dl) -
+                                  lv_obj_get_style_text_letter_space(obj, LV_PART_MAIN)
+                            : 0;
+        size->x = LV_MAX(size->x, w);
+        size->y = LV_MAX(size->y, dl->atlas->cell_h);
+        break;
+    }
+    case LV_EVENT_DELETE:
+        lv_free(dl);
+        break;
+    default:
+        break;
+    }
+}
+
+lv_obj_t *digit_label_create(lv_obj_t *parent, const struct digit_atlas *atlas) {
+    struct digit_label *dl = lv_malloc(sizeof(*dl));
+    if (!dl) {
+        return NULL;
+    }
+    dl->atlas = atlas;
+    dl->len = 0;
+    dl->text[0] = '\0';
+
+    lv_obj_t *obj = lv_obj_create(parent);
+    lv_obj_remove_style_all(obj);
+    lv_obj_clear_flag(obj, LV_OBJ_FLAG_CLICKABLE | LV_OBJ_FLAG_SCROLLABLE);
+    lv_obj_set_user_data(obj, dl);
+    lv_obj_add_event_cb(obj, event_cb, LV_EVENT_ALL, NULL);
+    lv_obj_set_size(obj, LV_SIZE_CONTENT, LV_SIZE_CONTENT);
+    return obj;
+}
+
+void digit_label_set_text(lv_obj_t *obj, const char *text) {
+    struct digit_label *dl = lv_obj_get_user_data(obj);
+    if (!dl || strncmp(dl->text, text, DIGIT_LABEL_MAX_CHARS) == 0) {
+        return;
+    }
+
+    uint8_t old_len = dl->len;
+    uint8_t len = 0;
+    for (; text[len] && len < DIGIT_LABEL_MAX_CHARS; len++) {
+        const char *cell = strchr(dl->atlas->chars, text[len]);
+        dl->cells[len] = cell ? (int8_t)(cell - dl->atlas->chars) : -1;
+        dl->text[len] = text[len];
+    }
+    dl->text[len] = '\0';
+    dl->len = len;
+
+    if (len != old_len) {
+        /* Width follows the digit count; re-runs the parent's alignment */
+        lv_obj_refresh_self_size(obj);
+    }
+    lv_obj_invalidate(obj);
+}
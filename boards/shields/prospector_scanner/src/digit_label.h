@@ -0,0 +1,53 @@
+/*
+ * Copyright (c) 2024 The ZMK Contributors
+ *
+ * SPDX-License-Identifier: MIT
+ *
+ * Numeric label drawn from a pre-rendered digit atlas
+ * (CONFIG_PROSPECTOR_DIGIT_ATLAS)
+ *
+ * scripts/lvgl_digit_atlas.py renders the few characters a number needs
+ * ("0123456789/-") of one font into fixed-size A8 cells at build time.
+ * A digit_label draws its text as one image per character, in the text
+ * color, so a changing WPM or battery figure costs a handful of small
+ * blits instead of LVGL's glyph lookup, decoding and text layout.
+ *
+ * Every character is one cell wide (fixed-width digits). The object is
+ * sized to its text like a label; text_color, text_opa and
+ * text_letter_space styles apply as they do to lv_label. Characters not
+ * in the atlas are left blank.
+ */
+
+#pragma once
+
+#include <lvgl.h>
+
+/* Longest text a digit_label shows ("100/100") */
+#define DIGIT_LABEL_MAX_CHARS 7
+
+struct digit_atlas {
+    const char *chars;               /* cell order */
+    uint8_t cell_w;
+    uint8_t cell_h;
+    const lv_image_dsc_t *glyphs;    /* one A8 image per character */
+};
+
+/* Image descriptor of cell @p index of a generated atlas map */
+#define DIGIT_ATLAS_GLYPH(map, index, cw, ch)                                                      \
+    {                                                                                              \
+        .header = {.magic = LV_IMAGE_HEADER_MAGIC, .cf = LV_COLOR_FORMAT_A8,                       \
+                   .w = (cw), .h = (ch), .stride = (cw)},                                          \
+        .data_size = (cw) * (ch),                                                                  \
+        .data = &(map)[(index) * (cw) * (ch)],                                                     \
+    }
+
+/* Generated per font by lvgl_digit_atlas.py (see CMakeLists.txt) */
+extern const struct digit_atlas digit_atlas_FR_Regular_30;
+extern const struct digit_atlas digit_atlas_FR_Medium_32;
+
+/* LVGL thread: a digit_label on @p parent showing "" */
+lv_obj_t *digit_label_create(lv_obj_t *parent, const struct digit_atlas *atlas);
+
+/* LVGL thread: show @p text (copied, at most DIGIT_LABEL_MAX_CHARS).
+ * Same text is a no-op; same length only invalidates the object. */
+void digit_label_set_text(lv_obj_t *obj, const char *text);
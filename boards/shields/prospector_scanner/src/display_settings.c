@@ -13,11 +13,17 @@
  *   "prosp/channel"     - scanner channel (uint8_t)
  *   "prosp/layout"      - layout style (uint8_t)
  *   "prosp/batviz"      - scanner battery visibility (bool)
+ *
+ * Each key has its own dirty bit. A change (re)starts a debounce on a
+ * system work queue item, which writes only the keys that changed, so a
+ * slider drag or a run of layout swipes ends up as one flash write and
+ * the LVGL thread never waits for flash.
  */
 
 #include "display_settings.h"
 
 #include <zephyr/kernel.h>
+#include <zephyr/sys/atomic.h>
 #include <zephyr/settings/settings.h>
 #include <zephyr/logging/log.h>
 
@@ -25,6 +31,15 @@ LOG_MODULE_REGISTER(display_settings, CONFIG_ZMK_LOG_LEVEL);
 
 /* ========== Persisted State Structures ========== */
 
+enum setting_key {
+    SETTING_BRIGHTNESS,
+    SETTING_LAYERS,
+    SETTING_CHANNEL,
+    SETTING_LAYOUT,
+    SETTING_BATVIZ,
+    SETTING_COUNT,
+};
+
 struct brightness_settings {
     bool auto_enabled;
     uint8_t manual_level;
@@ -145,29 +160,58 @@ static int display_settings_handle_set(const char *name, size_t len,
 SETTINGS_STATIC_HANDLER_DEFINE(prosp_display, "prosp", NULL,
                                display_settings_handle_set, NULL, NULL);
 
-/* ========== Dirty Flag Save ========== */
+/* ========== Per-Key Deferred Save ========== */
+
+#define SAVE_DEBOUNCE_MS 3000  /* Quiet time after the last change */
+#define SAVE_LEAVE_MS 500      /* Leaving a settings screen: after its transition */
+
+static const struct {
+    const char *key;
+    const void *value;
+    size_t len;
+} save_keys[SETTING_COUNT] = {
+    [SETTING_BRIGHTNESS] = {"prosp/brightness", &brightness, sizeof(brightness)},
+    [SETTING_LAYERS] = {"prosp/layers", &layers, sizeof(layers)},
+    [SETTING_CHANNEL] = {"prosp/channel", &scanner_channel, sizeof(scanner_channel)},
+    [SETTING_LAYOUT] = {"prosp/layout", &layout_style, sizeof(layout_style)},
+    [SETTING_BATVIZ] = {"prosp/batviz", &battery_visible, sizeof(battery_visible)},
+};
+
+static atomic_t dirty_mask = ATOMIC_INIT(0);
+
+static void save_work_handler(struct k_work *work);
+static K_WORK_DELAYABLE_DEFINE(save_work, save_work_handler);
 
-static bool dirty = false;
+static void save_work_handler(struct k_work *work) {
+    ARG_UNUSED(work);
+    /* Taken first: a change made while writing is saved by the next run */
+    atomic_val_t mask = atomic_clear(&dirty_mask);
 
-static void do_save(void) {
-    settings_save_one("prosp/brightness", &brightness, sizeof(brightness));
-    settings_save_one("prosp/layers", &layers, sizeof(layers));
-    settings_save_one("prosp/channel", &scanner_channel, sizeof(scanner_channel));
-    settings_save_one("prosp/layout", &layout_style, sizeof(layout_style));
-    settings_save_one("prosp/batviz", &battery_visible, sizeof(battery_visible));
-    dirty = false;
-    LOG_INF("Display settings saved to NVS");
+    for (int i = 0; i < SETTING_COUNT; i++) {
+        if (!(mask & BIT(i))) {
+            continue;
+        }
+        int rc = settings_save_one(save_keys[i].key, save_keys[i].value, save_keys[i].len);
+        if (rc != 0) {
+            LOG_WRN("Saving %s failed: %d", save_keys[i].key, rc);
+            atomic_or(&dirty_mask, BIT(i));  /* Retried with the next change */
+        }
+    }
+    LOG_INF("Display settings saved to NVS (mask 0x%02lX)", (unsigned long)mask);
 }
 
-static void mark_dirty(void) {
+static void mark_dirty(enum setting_key key) {
     if (settings_loaded) {
-        dirty = true;
+        atomic_or(&dirty_mask, BIT(key));
+        k_work_reschedule(&save_work, K_MSEC(SAVE_DEBOUNCE_MS));
     }
 }
 
 #else /* !CONFIG_SETTINGS */
 
-static void mark_dirty(void) {}
+static void mark_dirty(enum setting_key key) {
+    ARG_UNUSED(key);
+}
 
 #endif /* CONFIG_SETTINGS */
 
@@ -195,10 +239,22 @@ void display_settings_init(void) {
 
 void display_settings_save_if_dirty(void) {
 #if IS_ENABLED(CONFIG_SETTINGS)
-    if (!settings_loaded || !dirty) {
+    if (!settings_loaded || atomic_get(&dirty_mask) == 0) {
         return;
     }
-    do_save();
+    /* Only brings the debounced write forward; never blocks the caller */
+    k_work_reschedule(&save_work, K_MSEC(SAVE_LEAVE_MS));
+#endif
+}
+
+void display_settings_flush(void) {
+#if IS_ENABLED(CONFIG_SETTINGS)
+    struct k_work_sync sync;
+
+    k_work_cancel_delayable_sync(&save_work, &sync);
+    if (atomic_get(&dirty_mask) != 0) {
+        save_work_handler(NULL);
+    }
 #endif
 }
 
@@ -213,7 +269,7 @@ void display_settings_set_auto_brightness(bool enabled) {
         return;
     }
     brightness.auto_enabled = enabled;
-    mark_dirty();
+    mark_dirty(SETTING_BRIGHTNESS);
 }
 
 uint8_t display_settings_get_manual_brightness(void) {
@@ -225,7 +281,7 @@ void display_settings_set_manual_brightness(uint8_t level) {
         return;
     }
     brightness.manual_level = level;
-    mark_dirty();
+    mark_dirty(SETTING_BRIGHTNESS);
 }
 
 /* ========== Layer Getters/Setters ========== */
@@ -239,7 +295,7 @@ void display_settings_set_max_layers(uint8_t max) {
         return;
     }
     layers.max_layers = max;
-    mark_dirty();
+    mark_dirty(SETTING_LAYERS);
 }
 
 bool display_settings_get_layer_slide_mode(void) {
@@ -251,7 +307,7 @@ void display_settings_set_layer_slide_mode(bool enabled) {
         return;
     }
     layers.slide_mode = enabled;
-    mark_dirty();
+    mark_dirty(SETTING_LAYERS);
 }
 
 /* ========== Channel Getters/Setters ========== */
@@ -265,7 +321,7 @@ void display_settings_set_channel(uint8_t channel) {
         return;
     }
     scanner_channel = channel;
-    mark_dirty();
+    mark_dirty(SETTING_CHANNEL);
 }
 
 /* ========== Layout Getters/Setters ========== */
@@ -279,7 +335,7 @@ void display_settings_set_layout(uint8_t layout) {
         return;
     }
     layout_style = layout;
-    mark_dirty();
+    mark_dirty(SETTING_LAYOUT);
 }
 
 /* ========== Battery Visibility Getters/Setters ========== */
@@ -293,5 +349,5 @@ void display_settings_set_battery_visible(bool visible) {
         return;
     }
     battery_visible = visible;
-    mark_dirty();
+    mark_dirty(SETTING_BATVIZ);
 }
@@ -6,7 +6,8 @@
  *
  * Persists user-configurable display settings across reboots using
  * Zephyr Settings Subsystem (NVS backend). Settings are loaded at boot.
- * Call display_settings_save_if_dirty() when leaving a settings screen.
+ * Changed keys are written in the background a few seconds after the
+ * last change; display_settings_save_if_dirty() brings that forward.
  *
  * Settings stored:
  *   - Brightness (auto/manual mode, manual level)
@@ -28,12 +29,19 @@
 void display_settings_init(void);
 
 /**
- * Save settings to NVS if any value has changed since last save.
+ * Write the changed settings soon instead of after the debounce window.
  * Call when leaving a settings screen (swipe away, screen transition).
+ * Returns at once: the write runs on the system work queue.
  * No-op if nothing changed.
  */
 void display_settings_save_if_dirty(void);
 
+/**
+ * Write the changed settings now, blocking until done.
+ * Only for a reboot that would otherwise lose them.
+ */
+void display_settings_flush(void);
+
 /* ========== Brightness ========== */
 
 bool display_settings_get_auto_brightness(void);
@@ -0,0 +1,340 @@
+/*
+ * Copyright (c) 2024 The ZMK Contributors
+ *
+ * SPDX-License-Identifier: MIT
+ */
+
+#include <zephyr/kernel.h>
+#include <zephyr/devicetree.h>
+#include <zephyr/sys/atomic.h>
+#include <zephyr/logging/log.h>
+#include <string.h>
+#include <lvgl.h>
+
+#include "draw_buffer_bench.h"
+#include "prospector_layouts.h"
+#include "layer_name_cache.h"
+#if IS_ENABLED(CONFIG_PROSPECTOR_LVGL_HEAP_STATS)
+#include "lvgl_heap_stats.h"
+#endif
+
+LOG_MODULE_REGISTER(draw_bench, LOG_LEVEL_INF);
+
+#define POLL_MS 200
+#define IDLE_TICK_MS 100
+#define SCENE_MS (CONFIG_PROSPECTOR_DRAW_BUFFER_BENCH_SCENE_S * 1000U)
+
+#define DISPLAY_NODE DT_CHOSEN(zephyr_display)
+
+/* Same arithmetic as the LVGL glue's static buffers */
+#define DRAW_BUF_BYTES                                                                          \
+    (CONFIG_LV_Z_BITS_PER_PIXEL *                                                               \
+     ((CONFIG_LV_Z_VDB_SIZE * DT_PROP(DISPLAY_NODE, width) * DT_PROP(DISPLAY_NODE, height)) /   \
+      100) / 8)
+#define DRAW_BUF_COUNT (IS_ENABLED(CONFIG_LV_Z_DOUBLE_VDB) ? 2 : 1)
+
+#if IS_ENABLED(CONFIG_PROSPECTOR_DRAW_BUFFER_BAND)
+#define PRESET_NAME "band"
+#elif IS_ENABLED(CONFIG_PROSPECTOR_DRAW_BUFFER_DOUBLE_BAND)
+#define PRESET_NAME "double band"
+#elif IS_ENABLED(CONFIG_PROSPECTOR_DRAW_BUFFER_FULL_FRAME)
+#define PRESET_NAME "full frame"
+#else
+#define PRESET_NAME "custom"
+#endif
+
+enum bench_state {
+    BENCH_IDLE = 0,
+    BENCH_REQUESTED,
+    BENCH_RUNNING,
+};
+
+static atomic_t state = ATOMIC_INIT(BENCH_IDLE);
+
+/* ========== Frame Statistics ========== */
+/* LVGL thread only. RENDER_START only fires for refresh runs with dirty
+ * areas, so idle refresh timer runs don't count as frames. */
+
+static struct {
+    uint32_t frames;
+    uint64_t sum_us;
+    uint32_t max_us;
+    uint32_t heap_peak;
+    uint32_t start_cyc;
+    bool rendering;
+} st;
+
+static uint32_t heap_used(void) {
+#if IS_ENABLED(CONFIG_PROSPECTOR_LVGL_HEAP_STATS)
+    struct lvgl_heap_snapshot snap;
+
+    lvgl_heap_stats_sample(&snap);
+    return snap.used;
+#else
+    lv_mem_monitor_t mon;
+
+    lv_mem_monitor(&mon);
+    return mon.total_size - mon.free_size;  /* 0 when Zephyr's pool backs LVGL */
+#endif
+}
+
+static void render_start_cb(lv_event_t *e) {
+    ARG_UNUSED(e);
+    st.start_cyc = k_cycle_get_32();
+    st.rendering = true;
+}
+
+static void refr_ready_cb(lv_event_t *e) {
+    ARG_UNUSED(e);
+    if (!st.rendering) {
+        return;
+    }
+    uint32_t us = k_cyc_to_us_floor32(k_cycle_get_32() - st.start_cyc);
+
+    st.rendering = false;
+    st.frames++;
+    st.sum_us += us;
+    st.max_us = MAX(st.max_us, us);
+}
+
+/* ========== Scenes ========== */
+
+static lv_obj_t *overlay;
+static struct prospector_keyboard_data kb;
+
+static void overlay_create(void) {
+    overlay = lv_obj_create(lv_layer_top());
+    lv_obj_remove_style_all(overlay);
+    lv_obj_set_size(overlay, LV_PCT(100), LV_PCT(100));
+    lv_obj_set_style_bg_color(overlay, lv_color_black(), 0);
+    lv_obj_set_style_bg_opa(overlay, LV_OPA_COVER, 0);
+    lv_obj_clear_flag(overlay, LV_OBJ_FLAG_SCROLLABLE);
+}
+
+static void overlay_delete(void) {
+    prospector_layouts_destroy();
+    if (overlay) {
+        lv_obj_del(overlay);
+        overlay = NULL;
+    }
+}
+
+static void kb_reset(void) {
+    memset(&kb, 0, sizeof(kb));
+    kb.layer_count = 4;
+    kb.layer_names = LAYER_NAME_CACHE_NONE;
+    kb.battery_level = 80;
+    kb.peripheral_battery[0] = 75;
+    kb.ble_connected = true;
+    kb.ble_bonded = true;
+    kb.has_dynamic_data = true;
+    kb.has_static_data = true;
+    kb.changed = PROSPECTOR_KB_CHANGED_ALL;
+}
+
+/* Overlay with @p layout shown, false if it's compiled out or doesn't fit */
+static bool layout_scene_setup(prospector_layout_t layout) {
+    overlay_create();
+    prospector_layouts_init(overlay);
+    prospector_layouts_set_style(layout);
+    if (prospector_layouts_get_style() != layout) {
+        overlay_delete();
+        return false;
+    }
+    kb_reset();
+    prospector_layouts_update(&kb);
+    return true;
+}
+
+static bool field_setup(void) {
+    return IS_ENABLED(CONFIG_PROSPECTOR_LAYOUT_FIELD) &&
+           layout_scene_setup(PROSPECTOR_LAYOUT_FIELD);
+}
+
+static void field_tick(uint32_t n) {
+    kb.wpm_value = (uint8_t)(n % 160);
+    kb.battery_level = (uint8_t)(100 - n % 100);
+    kb.changed = PROSPECTOR_KB_CHANGED_WPM | PROSPECTOR_KB_CHANGED_BATTERY;
+    prospector_layouts_update(&kb);
+}
+
+static bool radii_setup(void) {
+    return IS_ENABLED(CONFIG_PROSPECTOR_LAYOUT_RADII) &&
+           layout_scene_setup(PROSPECTOR_LAYOUT_RADII);
+}
+
+static void layer_tick(uint32_t n) {
+    kb.active_layer = (uint8_t)(n % kb.layer_count);
+    kb.changed = PROSPECTOR_KB_CHANGED_LAYER;
+    prospector_layouts_update(&kb);
+}
+
+static bool transition_setup(void) {
+    kb_reset();
+    return true;
+}
+
+/* Odd ticks build the Prospector display over the main screen, even ones
+ * free it again, as leaving a memory-heavy screen does */
+static void transition_tick(uint32_t n) {
+    if (n % 2) {
+        overlay_create();
+        prospector_layouts_init(overlay);
+        prospector_layouts_update(&kb);
+    } else {
+        overlay_delete();
+    }
+}
+
+struct scene {
+    const char *name;
+    bool (*setup)(void);      // NULL: nothing to set up; false: skip the scene
+    void (*tick)(uint32_t n); // NULL: no changes
+    uint32_t tick_ms;
+};
+
+static const struct scene scenes[] = {
+    {"classic idle", NULL, NULL, 0},
+    {"field 30hz", field_setup, field_tick, 33},
+    {"radii spin", radii_setup, layer_tick, 500},
+    {"transition", transition_setup, transition_tick, 500},
+};
+
+/* ========== Run ========== */
+
+static lv_timer_t *run_timer;
+static prospector_layout_t saved_style;
+static int scene_idx;
+static uint32_t scene_start;
+static uint32_t scene_ticks;
+
+static void scene_log(const struct scene *sc, uint32_t ms) {
+    uint32_t avg_us = st.frames ? (uint32_t)(st.sum_us / st.frames) : 0;
+
+    LOG_INF("⏱   %-12s %5u frames %3u fps  avg %6u us  max %6u us  heap %6u B", sc->name,
+            st.frames, ms ? st.frames * 1000U / ms : 0, avg_us, st.max_us, st.heap_peak);
+}
+
+static bool scene_begin(void) {
+    const struct scene *sc = &scenes[scene_idx];
+
+    if (sc->setup && !sc->setup()) {
+        LOG_INF("⏱   %-12s skipped (layout not built in or too big for the pool)", sc->name);
+        return false;
+    }
+    memset(&st, 0, sizeof(st));
+    st.heap_peak = heap_used();
+    scene_start = k_uptime_get_32();
+    scene_ticks = 0;
+    lv_timer_set_period(run_timer, sc->tick_ms ? sc->tick_ms : IDLE_TICK_MS);
+    return true;
+}
+
+static void run_finish(void) {
+    lv_display_t *disp = lv_display_get_default();
+
+    /* The Prospector display comes back in the layout it had */
+    if (prospector_layouts_get_style() != saved_style) {
+        overlay_create();
+        prospector_layouts_init(overlay);
+        prospector_layouts_set_style(saved_style);
+    }
+    overlay_delete();
+    lv_timer_del(run_timer);
+    run_timer = NULL;
+    lv_display_remove_event_cb_with_user_data(disp, render_start_cb, NULL);
+    lv_display_remove_event_cb_with_user_data(disp, refr_ready_cb, NULL);
+    LOG_INF("⏱ Draw buffer bench done");
+    atomic_set(&state, BENCH_IDLE);
+}
+
+/* Next scene that sets up, or the end of the run */
+static void scene_advance(void) {
+    while (++scene_idx < (int)ARRAY_SIZE(scenes)) {
+        if (scene_begin()) {
+            return;
+        }
+    }
+    run_finish();
+}
+
+static void run_timer_cb(lv_timer_t *timer) {
+    ARG_UNUSED(timer);
+    const struct scene *sc = &scenes[scene_idx];
+    uint32_t elapsed = k_uptime_get_32() - scene_start;
+
+    st.heap_peak = MAX(st.heap_peak, heap_used());
+    if (elapsed >= SCENE_MS) {
+        scene_log(sc, elapsed);
+        overlay_delete();
+        scene_advance();
+        return;
+    }
+    if (sc->tick) {
+        sc->tick(++scene_ticks);
+    }
+}
+
+static void run_begin(void) {
+    lv_display_t *disp = lv_display_get_default();
+
+    if (!disp || prospector_layouts_is_active()) {
+        LOG_WRN("⏱ Draw buffer bench needs the main screen");
+        atomic_set(&state, BENCH_IDLE);
+        return;
+    }
+    lv_display_add_event_cb(disp, render_start_cb, LV_EVENT_RENDER_START, NULL);
+    lv_display_add_event_cb(disp, refr_ready_cb, LV_EVENT_REFR_READY, NULL);
+
+    LOG_INF("⏱ Draw buffer bench: %s preset, %d x %u bytes, %u s per scene", PRESET_NAME,
+            DRAW_BUF_COUNT, (uint32_t)DRAW_BUF_BYTES, CONFIG_PROSPECTOR_DRAW_BUFFER_BENCH_SCENE_S);
+    saved_style = prospector_layouts_get_style();
+    run_timer = lv_timer_create(run_timer_cb, IDLE_TICK_MS, NULL);
+    scene_idx = -1;
+    scene_advance();
+}
+
+static void poll_timer_cb(lv_timer_t *timer) {
+    ARG_UNUSED(timer);
+    if (atomic_cas(&state, BENCH_REQUESTED, BENCH_RUNNING)) {
+        run_begin();
+    }
+}
+
+int draw_bench_start(void) {
+    return atomic_cas(&state, BENCH_IDLE, BENCH_REQUESTED) ? 0 : -EBUSY;
+}
+
+#if CONFIG_PROSPECTOR_DRAW_BUFFER_BENCH_START_S > 0
+static void start_work_handler(struct k_work *work) {
+    ARG_UNUSED(work);
+    draw_bench_start();
+}
+static K_WORK_DELAYABLE_DEFINE(start_work, start_work_handler);
+#endif
+
+void draw_bench_attach_display(void) {
+    lv_timer_create(poll_timer_cb, POLL_MS, NULL);
+#if CONFIG_PROSPECTOR_DRAW_BUFFER_BENCH_START_S > 0
+    k_work_schedule(&start_work, K_SECONDS(CONFIG_PROSPECTOR_DRAW_BUFFER_BENCH_START_S));
+    LOG_INF("⏱ Draw buffer bench starts in %ds", CONFIG_PROSPECTOR_DRAW_BUFFER_BENCH_START_S);
+#endif
+}
+
+#if IS_ENABLED(CONFIG_SHELL)
+#include <zephyr/shell/shell.h>
+
+static int cmd_draw_bench(const struct shell *sh, size_t argc, char **argv) {
+    ARG_UNUSED(argc);
+    ARG_UNUSED(argv);
+    if (draw_bench_start() == -EBUSY) {
+        shell_error(sh, "A run is already in progress");
+        return -EBUSY;
+    }
+    shell_print(sh, "Running %u scenes from the main screen; results go to the log",
+                (unsigned int)ARRAY_SIZE(scenes));
+    return 0;
+}
+
+SHELL_CMD_REGISTER(draw_bench, NULL, "LVGL draw buffer bench", cmd_draw_bench);
+#endif
@@ -0,0 +1,28 @@
+/*
+ * Copyright (c) 2024 The ZMK Contributors
+ *
+ * SPDX-License-Identifier: MIT
+ *
+ * LVGL draw buffer benchmark (CONFIG_PROSPECTOR_DRAW_BUFFER_BENCH)
+ *
+ * Renders a fixed set of scenes for CONFIG_PROSPECTOR_DRAW_BUFFER_BENCH_SCENE_S
+ * each and logs, per scene, the frames rendered, their render + flush time
+ * and the LVGL heap high-water mark, next to the draw buffer RAM of the
+ * preset the image was built with (CONFIG_PROSPECTOR_DRAW_BUFFER_*):
+ *   classic idle   the main screen as it is, nothing changing
+ *   field 30hz     Field layout, WPM and battery updated every 33 ms
+ *   radii spin     Radii layout, a layer change (wheel rotation) every 500 ms
+ *   transition     Prospector display built and freed every 500 ms, the
+ *                  main screen redrawn in between (memory-heavy screen switch)
+ * Layout scenes run in an overlay on the top layer, so the run should start
+ * from the main screen; layouts that are compiled out are skipped.
+ */
+
+#pragma once
+
+/* LVGL thread: register the start poller (call once after LVGL init) */
+void draw_bench_attach_display(void);
+
+/* Any thread: run every scene once, starting on the LVGL thread's next poll;
+ * -EBUSY if a run is pending or in progress */
+int draw_bench_start(void);
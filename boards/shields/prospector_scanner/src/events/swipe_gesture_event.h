@@ -22,6 +22,7 @@ enum swipe_direction {
 // Swipe gesture event - raised by touch handler, processed by display thread
 struct zmk_swipe_gesture_event {
     enum swipe_direction direction;
+    uint16_t speed;  /* Release speed in pixels/s, 0 if unknown (hardware gesture, tap) */
 };
 
 ZMK_EVENT_DECLARE(zmk_swipe_gesture_event);
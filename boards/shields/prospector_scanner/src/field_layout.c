@@ -13,11 +13,15 @@
 
 #include "field_layout.h"
 #include "fonts_carrefinho.h"
+#if IS_ENABLED(CONFIG_PROSPECTOR_DIGIT_ATLAS)
+#include "digit_label.h"
+#endif
 #include <zephyr/kernel.h>
 #include <zephyr/logging/log.h>
 #include <string.h>
 #include <stdio.h>
 #include <math.h>
+#include <stdlib.h>
 
 LOG_MODULE_REGISTER(field_layout, CONFIG_ZMK_LOG_LEVEL);
 
@@ -184,6 +188,39 @@ static const field_color_palette_t color_palettes[4] = {
 #define PALETTE_COUNT 4
 static uint8_t current_palette = 0;
 
+/* One shared style per palette role. Active colors are selected with
+ * LV_STATE_CHECKED, so a palette change only rewrites these styles. */
+static struct {
+    lv_style_t background;
+    lv_style_t layer_text;
+    lv_style_t battery_text;
+    lv_style_t mod;
+    lv_style_t mod_active;
+    lv_style_t output;
+    lv_style_t output_active;
+    bool initialized;
+} styles;
+
+static void styles_set_palette(const field_color_palette_t *p) {
+    if (!styles.initialized) {
+        lv_style_init(&styles.background);
+        lv_style_init(&styles.layer_text);
+        lv_style_init(&styles.battery_text);
+        lv_style_init(&styles.mod);
+        lv_style_init(&styles.mod_active);
+        lv_style_init(&styles.output);
+        lv_style_init(&styles.output_active);
+        styles.initialized = true;
+    }
+    lv_style_set_bg_color(&styles.background, lv_color_hex(p->background));
+    lv_style_set_text_color(&styles.layer_text, lv_color_hex(p->layer_text));
+    lv_style_set_text_color(&styles.battery_text, lv_color_hex(p->battery_text));
+    lv_style_set_text_color(&styles.mod, lv_color_hex(p->mod_inactive));
+    lv_style_set_text_color(&styles.mod_active, lv_color_hex(p->mod_active));
+    lv_style_set_text_color(&styles.output, lv_color_hex(p->output_inactive));
+    lv_style_set_text_color(&styles.output_active, lv_color_hex(p->output_active));
+}
+
 /* ========== Per-Cell Animation State ========== */
 
 static float smoothed_angles[GRID_TOTAL];    /* Current smoothed angle (radians) */
@@ -313,19 +350,7 @@ static void compute_exclusions(void) {
 
 /* ========== Line Animation Update (from carrefinho) ========== */
 
-static void lines_update(void) {
-    uint32_t now = k_uptime_get_32();
-    uint32_t idle_ms = now - last_wpm_active_time;
-
-    /* Update decay parameters */
-    flow_state = compute_decay(flow_state, current_wpm, idle_ms,
-                               FLOW_DECAY_SEC * 1000);
-    intensity_state = compute_decay(intensity_state, current_wpm, idle_ms,
-                                    INTENSITY_DECAY_SEC * 1000);
-
-    float flow = flow_state.current_value;
-    float intensity = intensity_state.current_value;
-
+static void lines_update_float(float flow, float intensity) {
     /* Advance time based on WPM */
     float speed = ANIM_BASE_SPEED +
                   clampf((float)current_wpm / WPM_REFERENCE, 0, 1) * ANIM_WPM_SPEED_MULTIPLIER;
@@ -389,6 +414,396 @@ static void lines_update(void) {
     }
 }
 
+#if IS_ENABLED(CONFIG_PROSPECTOR_FIELD_FIXED_POINT)
+/* ========== Q15 Fixed-Point Field ========== */
+/* Same simulation as lines_update_float(), in integers:
+ * - Angles are int16 in units of 2π/32768, so the 16-bit wrap is two full
+ *   turns and sin/cos stay continuous across it. The top 8 bits of one
+ *   turn index a Q15 sine LUT (same resolution as the float LUT).
+ * - Noise, sin, flow, intensity, length scale and opacity are Q15.
+ * - The per-cell spatial terms (x * 0.007, c * 0.3 + r * 0.2, ...) never
+ *   change and are precomputed; the time terms are uint32 phase
+ *   accumulators (angle << 16) that wrap instead of losing precision.
+ * Cells are processed in pairs packed into one 32-bit word: phases and
+ * sums use dual 16-bit adds, the noise mix and angle smoothing are dual
+ * 16x16 multiply-accumulates. LUT lookups stay scalar. */
+
+#if defined(__ARM_FEATURE_DSP) && __ARM_FEATURE_DSP
+#include <cmsis_core.h>
+#define FIELD_HAVE_DSP 1
+#else
+#define FIELD_HAVE_DSP 0
+#endif
+
+#define ANG_PER_RAD       5215.18917f     /* 32768 / 2π */
+#define PHASE_PER_RAD     (ANG_PER_RAD * 65536.0f)
+#define ANG(rad)          ((int32_t)((rad) * ANG_PER_RAD))
+#define Q15(f)            ((int32_t)((f) * 32768.0f))
+#define Q15_ONE           32767
+#define Q15_ROUND         (1 << 14)
+#define ANG_QUARTER_TURN  8192
+
+/* Noise: (n1 + 0.7 * n2) / 1.7 as one dual MAC */
+#define NOISE_K_N1        Q15(1.0f / 1.7f)
+#define NOISE_K_N2        Q15(0.7f / 1.7f)
+/* Smoothing: s * (1 - rate) + target * rate; the weights sum to exactly 1.0 */
+#define SMOOTH_K_TARGET   Q15(ANGLE_SMOOTHING_RATE)
+#define SMOOTH_K_KEEP     (32768 - SMOOTH_K_TARGET)
+
+/* Per-frame phase steps. lines_time advances by speed * 2 per frame */
+#define DT_BASE           ((uint32_t)(ANIM_BASE_SPEED * 2.0f * PHASE_PER_RAD))
+#define DT_WPM            ((uint32_t)(ANIM_WPM_SPEED_MULTIPLIER * 2.0f * PHASE_PER_RAD))
+#define DT_WOBBLE         ((uint32_t)(0.02f * WOBBLE_FREQUENCY * PHASE_PER_RAD))
+
+/* Terms of the field, in the order of the offset tables and accumulators */
+enum field_term {
+    TERM_NOISE_X,    /* sin(x * 0.007 + t * 0.15) */
+    TERM_NOISE_Y,    /* cos(y * 0.008 - t * 0.12) */
+    TERM_NOISE_XY,   /* sin(y * 0.006 + x * 0.005 + t * 0.1) */
+    TERM_OPA_X,      /* The same three at half the coordinates and 0.2x time */
+    TERM_OPA_Y,
+    TERM_OPA_XY,
+    TERM_BREATH,     /* sin(t * 0.3 + c * 0.5 + r * 0.4) */
+    TERM_WOBBLE,     /* sin(wobble_t * 0.5 + c * 0.3 + r * 0.2), own clock */
+    TERM_COUNT,
+};
+
+/* Time coefficient of each lines_time-driven term, Q15 */
+static const int32_t term_time_k[TERM_WOBBLE] = {
+    [TERM_NOISE_X] = Q15(0.15f),
+    [TERM_NOISE_Y] = -Q15(0.12f),
+    [TERM_NOISE_XY] = Q15(0.1f),
+    [TERM_OPA_X] = Q15(0.15f * OPACITY_VARIATION_FREQ),
+    [TERM_OPA_Y] = -Q15(0.12f * OPACITY_VARIATION_FREQ),
+    [TERM_OPA_XY] = Q15(0.1f * OPACITY_VARIATION_FREQ),
+    [TERM_BREATH] = Q15(LENGTH_BREATH_FREQ),
+};
+
+static int16_t sin_lut_q15[LUT_SIZE];
+static uint32_t term_offsets[TERM_COUNT][GRID_TOTAL / 2];  /* Cell pairs, packed */
+static uint32_t term_phase[TERM_COUNT];
+static int16_t smoothed_angles_q15[GRID_TOTAL];
+static bool q15_tables_ready = false;
+
+#define PACK16(lo, hi) ((uint32_t)(uint16_t)(lo) | ((uint32_t)(uint16_t)(hi) << 16))
+#define LANE(v, k) ((int16_t)((v) >> (16 * (k))))
+
+static inline uint32_t q_sadd16(uint32_t a, uint32_t b) {
+#if FIELD_HAVE_DSP
+    return __SADD16(a, b);
+#else
+    return PACK16(LANE(a, 0) + LANE(b, 0), LANE(a, 1) + LANE(b, 1));
+#endif
+}
+
+static inline int16_t q_sat16(int32_t v) {
+    return v > INT16_MAX ? INT16_MAX : (v < INT16_MIN ? INT16_MIN : v);
+}
+
+static inline uint32_t q_qadd16(uint32_t a, uint32_t b) {
+#if FIELD_HAVE_DSP
+    return __QADD16(a, b);
+#else
+    return PACK16(q_sat16(LANE(a, 0) + LANE(b, 0)), q_sat16(LANE(a, 1) + LANE(b, 1)));
+#endif
+}
+
+static inline int32_t q_smlad(uint32_t a, uint32_t b, int32_t acc) {
+#if FIELD_HAVE_DSP
+    return (int32_t)__SMLAD(a, b, (uint32_t)acc);
+#else
+    return LANE(a, 0) * LANE(b, 0) + LANE(a, 1) * LANE(b, 1) + acc;
+#endif
+}
+
+static inline int16_t sin_q15(uint16_t ang) {
+    return sin_lut_q15[(ang >> 7) & LUT_MASK];
+}
+
+static inline int16_t cos_q15(uint16_t ang) {
+    return sin_q15(ang + ANG_QUARTER_TURN);
+}
+
+static inline int32_t clamp_q15(int32_t v, int32_t lo, int32_t hi) {
+    return v < lo ? lo : (v > hi ? hi : v);
+}
+
+static void init_q15_tables(void) {
+    if (q15_tables_ready) return;
+    for (int i = 0; i < LUT_SIZE; i++) {
+        sin_lut_q15[i] = (int16_t)(sin_lut[i] * Q15_ONE);
+    }
+
+    for (int r = 0; r < GRID_ROWS; r++) {
+        for (int c = 0; c < GRID_COLS; c++) {
+            int idx = r * GRID_COLS + c;
+            float x = (float)grid_cx[c];
+            float y = (float)grid_cy[r];
+            float ox = x * NOISE_SPATIAL_X_SCALE;
+            float oy = y * NOISE_SPATIAL_Y_SCALE;
+            int16_t off[TERM_COUNT] = {
+                [TERM_NOISE_X] = ANG(x * 0.007f),
+                [TERM_NOISE_Y] = ANG(y * 0.008f),
+                [TERM_NOISE_XY] = ANG(y * 0.006f + x * 0.005f),
+                [TERM_OPA_X] = ANG(ox * 0.007f),
+                [TERM_OPA_Y] = ANG(oy * 0.008f),
+                [TERM_OPA_XY] = ANG(oy * 0.006f + ox * 0.005f),
+                [TERM_BREATH] = ANG(c * LENGTH_BREATH_COL + r * LENGTH_BREATH_ROW),
+                [TERM_WOBBLE] = ANG(c * WOBBLE_SPATIAL_COL + r * WOBBLE_SPATIAL_ROW),
+            };
+            for (int t = 0; t < TERM_COUNT; t++) {
+                uint32_t *pair = &term_offsets[t][idx / 2];
+                *pair |= (uint32_t)(uint16_t)off[t] << (16 * (idx & 1));
+            }
+        }
+    }
+    q15_tables_ready = true;
+}
+
+static void lines_reset_q15(void) {
+    memset(term_phase, 0, sizeof(term_phase));
+    for (int i = 0; i < GRID_TOTAL; i++) {
+        smoothed_angles_q15[i] = (int16_t)-ANG(M_PI_F / 4.0f);
+    }
+}
+
+/* Noise of one lane of three packed phase pairs, Q15 */
+static inline int32_t noise_q15(uint32_t ph_x, uint32_t ph_y, uint32_t ph_xy, int k) {
+    int32_t n1 = (sin_q15(LANE(ph_x, k)) * cos_q15(LANE(ph_y, k))) >> 15;
+    int32_t n2 = sin_q15(LANE(ph_xy, k));
+    return q_smlad(PACK16(n1, n2), PACK16(NOISE_K_N1, NOISE_K_N2), Q15_ROUND) >> 15;
+}
+
+static void lines_update_q15(float flow, float intensity) {
+    int32_t flow_q = (int32_t)(flow * Q15_ONE);
+    int32_t intensity_q = (int32_t)(intensity * Q15_ONE);
+    int32_t wpm = MIN(current_wpm, WPM_REFERENCE);
+
+    /* Advance the time terms */
+    uint32_t dt = DT_BASE + (uint32_t)((uint64_t)DT_WPM * wpm / WPM_REFERENCE);
+    uint32_t t_pair[TERM_COUNT];
+    for (int t = 0; t < TERM_WOBBLE; t++) {
+        term_phase[t] += (uint32_t)(int32_t)(((int64_t)dt * term_time_k[t]) >> 15);
+    }
+    term_phase[TERM_WOBBLE] += DT_WOBBLE;
+    for (int t = 0; t < TERM_COUNT; t++) {
+        t_pair[t] = (term_phase[t] >> 16) * 0x00010001u;
+    }
+
+    /* Per-frame constants */
+    int32_t base_scale = Q15(LENGTH_BASE_IDLE) + ((flow_q * Q15(LENGTH_BASE_ACTIVE)) >> 15);
+    int32_t opa_var_k = (intensity_q * Q15(OPACITY_VARIATION_SCALE)) >> 15;
+    int32_t opa_base = Q15(OPACITY_BASE_IDLE) + ((intensity_q * Q15(OPACITY_BASE_ACTIVE)) >> 15) -
+                       ((intensity_q * Q15(OPACITY_DECAY_FACTOR)) >> 15);
+    uint32_t opa_base_pair = PACK16(opa_base, opa_base);
+    const uint32_t smooth_k = PACK16(SMOOTH_K_KEEP, SMOOTH_K_TARGET);
+
+    for (int p = 0; p < GRID_TOTAL / 2; p++) {
+        uint32_t ph[TERM_COUNT];
+        for (int t = 0; t < TERM_COUNT; t++) {
+            ph[t] = q_sadd16(term_offsets[t][p], t_pair[t]);
+        }
+
+        int16_t wobble[2];
+        int16_t opa_var[2];
+        for (int k = 0; k < 2; k++) {
+            int idx = 2 * p + k;
+
+            /* Angle: smooth toward the noise-driven target */
+            int32_t noise = noise_q15(ph[TERM_NOISE_X], ph[TERM_NOISE_Y],
+                                      ph[TERM_NOISE_XY], k);
+            int32_t offset = (noise * ANG(M_PI_F * NOISE_ANGLE_INFLUENCE)) >> 15;
+            int32_t target = -ANG(M_PI_F / 4.0f) + ((offset * flow_q) >> 15);
+            smoothed_angles_q15[idx] = (int16_t)(
+                q_smlad(PACK16(smoothed_angles_q15[idx], target), smooth_k, Q15_ROUND) >> 15);
+
+            wobble[k] = (sin_q15(LANE(ph[TERM_WOBBLE], k)) * ANG(WOBBLE_AMPLITUDE)) >> 15;
+
+            /* Opacity variation, (noise + 1) / 2 scaled by intensity */
+            int32_t spatial = noise_q15(ph[TERM_OPA_X], ph[TERM_OPA_Y], ph[TERM_OPA_XY], k);
+            opa_var[k] = (int16_t)((((spatial + 32768) >> 1) * opa_var_k) >> 15);
+        }
+
+        uint32_t angles = q_qadd16(
+            PACK16(smoothed_angles_q15[2 * p], smoothed_angles_q15[2 * p + 1]),
+            PACK16(wobble[0], wobble[1]));
+        uint32_t opa = q_qadd16(opa_base_pair, PACK16(opa_var[0], opa_var[1]));
+
+        for (int k = 0; k < 2; k++) {
+            int idx = 2 * p + k;
+            uint16_t a = (uint16_t)LANE(angles, k);
+
+            /* Length scale (breathing) */
+            int32_t breath = (sin_q15(LANE(ph[TERM_BREATH], k)) *
+                              Q15(LENGTH_BREATH_AMPLITUDE)) >> 15;
+            int32_t scale = clamp_q15(base_scale + ((breath * flow_q) >> 15),
+                                      Q15(LENGTH_MIN), Q15_ONE);
+            line_length_scale[idx] = (float)scale / 32768.0f;
+
+            /* Division truncates toward zero like the float path's cast */
+            line_dx[idx] = (int16_t)(LINE_LENGTH * ((scale * cos_q15(a)) >> 15) / 32768);
+            line_dy[idx] = (int16_t)(LINE_LENGTH * ((scale * sin_q15(a)) >> 15) / 32768);
+
+            int32_t final_opa = clamp_q15(LANE(opa, k), Q15(OPACITY_MIN_F),
+                                          Q15(OPACITY_MAX_F));
+            line_opacity[idx] = (lv_opa_t)((final_opa * 255) >> 15);
+        }
+    }
+}
+#endif /* CONFIG_PROSPECTOR_FIELD_FIXED_POINT */
+
+#if IS_ENABLED(CONFIG_PROSPECTOR_FIELD_BENCH)
+/* ========== Float vs Q15 Frame-Time Comparison ========== */
+/* Both paths run every frame with their own state; the Q15 result is the
+ * one drawn. Every FIELD_BENCH_FRAMES frames the average cost of each is
+ * logged with its share of the current frame period, and the largest
+ * endpoint / opacity deviation of Q15 from the float reference. */
+
+#define FIELD_BENCH_FRAMES 64
+
+static struct {
+    uint32_t float_cycles;
+    uint32_t q15_cycles;
+    int max_endpoint_err;
+    int max_opa_err;
+    int frames;
+} bench;
+
+static void lines_update_bench(float flow, float intensity) {
+    int16_t ref_dx[GRID_TOTAL];
+    int16_t ref_dy[GRID_TOTAL];
+    lv_opa_t ref_opa[GRID_TOTAL];
+
+    uint32_t start = k_cycle_get_32();
+    lines_update_float(flow, intensity);
+    uint32_t mid = k_cycle_get_32();
+    memcpy(ref_dx, line_dx, sizeof(ref_dx));
+    memcpy(ref_dy, line_dy, sizeof(ref_dy));
+    memcpy(ref_opa, line_opacity, sizeof(ref_opa));
+    uint32_t resume = k_cycle_get_32();
+    lines_update_q15(flow, intensity);
+    uint32_t end = k_cycle_get_32();
+
+    bench.float_cycles += mid - start;
+    bench.q15_cycles += end - resume;
+    for (int i = 0; i < GRID_TOTAL; i++) {
+        bench.max_endpoint_err = MAX(bench.max_endpoint_err,
+                                     MAX(abs(line_dx[i] - ref_dx[i]), abs(line_dy[i] - ref_dy[i])));
+        bench.max_opa_err = MAX(bench.max_opa_err, abs(line_opacity[i] - ref_opa[i]));
+    }
+
+    if (++bench.frames < FIELD_BENCH_FRAMES) {
+        return;
+    }
+
+    uint32_t float_us = k_cyc_to_us_floor32(bench.float_cycles / FIELD_BENCH_FRAMES);
+    uint32_t q15_us = k_cyc_to_us_floor32(bench.q15_cycles / FIELD_BENCH_FRAMES);
+    uint32_t period_us = last_timer_period * 1000;
+    LOG_INF("FIELD bench: float %u us (%u.%02u%%), q15 %u us (%u.%02u%%) per %u ms frame, "
+            "max err endpoint %d px opa %d",
+            float_us, float_us * 100 / period_us, float_us * 10000 / period_us % 100, q15_us,
+            q15_us * 100 / period_us, q15_us * 10000 / period_us % 100, last_timer_period,
+            bench.max_endpoint_err, bench.max_opa_err);
+    memset(&bench, 0, sizeof(bench));
+}
+#endif /* CONFIG_PROSPECTOR_FIELD_BENCH */
+
+static void lines_update(void) {
+    uint32_t now = k_uptime_get_32();
+    uint32_t idle_ms = now - last_wpm_active_time;
+
+    /* Update decay parameters */
+    flow_state = compute_decay(flow_state, current_wpm, idle_ms,
+                               FLOW_DECAY_SEC * 1000);
+    intensity_state = compute_decay(intensity_state, current_wpm, idle_ms,
+                                    INTENSITY_DECAY_SEC * 1000);
+
+    float flow = flow_state.current_value;
+    float intensity = intensity_state.current_value;
+
+#if IS_ENABLED(CONFIG_PROSPECTOR_FIELD_BENCH)
+    lines_update_bench(flow, intensity);
+#elif IS_ENABLED(CONFIG_PROSPECTOR_FIELD_FIXED_POINT)
+    lines_update_q15(flow, intensity);
+#else
+    lines_update_float(flow, intensity);
+#endif
+}
+
+#if IS_ENABLED(CONFIG_PROSPECTOR_FIELD_DIRTY_CELLS)
+/* ========== Dirty-Cell Invalidation ========== */
+/* What each cell last put on screen. A frame invalidates only the cells
+ * whose quantized line changed, each with a box covering both the old and
+ * the new line. Boxes of neighbouring cells never overlap (the longest
+ * line spans 28 px on a 34 px grid), so draw_cb can skip every cell
+ * outside the area being redrawn. */
+
+#define DIRTY_MAX_AREAS 16  /* More than this and one union box is sent instead */
+#define LINE_BOX_MARGIN 2   /* Half the line width, rounded up */
+
+static int16_t drawn_dx[GRID_TOTAL];
+static int16_t drawn_dy[GRID_TOTAL];
+static lv_opa_t drawn_opa[GRID_TOTAL];
+static bool drawn_valid = false;
+
+static void invalidate_dirty_cells(void) {
+    if (!drawn_valid) {
+        memcpy(drawn_dx, line_dx, sizeof(drawn_dx));
+        memcpy(drawn_dy, line_dy, sizeof(drawn_dy));
+        memcpy(drawn_opa, line_opacity, sizeof(drawn_opa));
+        drawn_valid = true;
+        lv_obj_invalidate(line_canvas_obj);
+        return;
+    }
+
+    lv_area_t coords;
+    lv_obj_get_coords(line_canvas_obj, &coords);
+
+    lv_area_t boxes[DIRTY_MAX_AREAS];
+    lv_area_t all = {0};
+    int dirty = 0;
+
+    for (int idx = 0; idx < GRID_TOTAL; idx++) {
+        if ((excluded_cells & (1ULL << idx)) ||
+            (line_dx[idx] == drawn_dx[idx] && line_dy[idx] == drawn_dy[idx] &&
+             line_opacity[idx] == drawn_opa[idx])) {
+            continue;
+        }
+
+        int half_x = MAX(abs(line_dx[idx]), abs(drawn_dx[idx])) + LINE_BOX_MARGIN;
+        int half_y = MAX(abs(line_dy[idx]), abs(drawn_dy[idx])) + LINE_BOX_MARGIN;
+        int cx = coords.x1 + grid_cx[idx % GRID_COLS];
+        int cy = coords.y1 + grid_cy[idx / GRID_COLS];
+        lv_area_t box = {cx - half_x, cy - half_y, cx + half_x, cy + half_y};
+
+        if (dirty == 0) {
+            all = box;
+        } else {
+            all.x1 = MIN(all.x1, box.x1);
+            all.y1 = MIN(all.y1, box.y1);
+            all.x2 = MAX(all.x2, box.x2);
+            all.y2 = MAX(all.y2, box.y2);
+        }
+        if (dirty < DIRTY_MAX_AREAS) {
+            boxes[dirty] = box;
+        }
+        dirty++;
+
+        drawn_dx[idx] = line_dx[idx];
+        drawn_dy[idx] = line_dy[idx];
+        drawn_opa[idx] = line_opacity[idx];
+    }
+
+    if (dirty > DIRTY_MAX_AREAS) {
+        lv_obj_invalidate_area(line_canvas_obj, &all);
+        return;
+    }
+    for (int i = 0; i < dirty; i++) {
+        lv_obj_invalidate_area(line_canvas_obj, &boxes[i]);
+    }
+}
+#endif /* CONFIG_PROSPECTOR_FIELD_DIRTY_CELLS */
+
 /* ========== Draw Callback (from carrefinho) ========== */
 
 static void draw_cb(lv_event_t *e) {
@@ -409,6 +824,10 @@ static void draw_cb(lv_event_t *e) {
     line_dsc.round_start = 0;
     line_dsc.round_end = 0;
 
+#if IS_ENABLED(CONFIG_PROSPECTOR_FIELD_DIRTY_CELLS)
+    const lv_area_t *clip = &layer->_clip_area;
+#endif
+
     for (int r = 0; r < GRID_ROWS; r++) {
         for (int c = 0; c < GRID_COLS; c++) {
             int idx = r * GRID_COLS + c;
@@ -426,6 +845,16 @@ static void draw_cb(lv_event_t *e) {
             int16_t dx = line_dx[idx];
             int16_t dy = line_dy[idx];
 
+#if IS_ENABLED(CONFIG_PROSPECTOR_FIELD_DIRTY_CELLS)
+            /* Not in the area being redrawn: its pixels are still on screen */
+            int half_x = abs(dx) + LINE_BOX_MARGIN;
+            int half_y = abs(dy) + LINE_BOX_MARGIN;
+            if (obj_x1 + cx + half_x < clip->x1 || obj_x1 + cx - half_x > clip->x2 ||
+                obj_y1 + cy + half_y < clip->y1 || obj_y1 + cy - half_y > clip->y2) {
+                continue;
+            }
+#endif
+
             line_dsc.p1.x = obj_x1 + cx - dx;
             line_dsc.p1.y = obj_y1 + cy - dy;
             line_dsc.p2.x = obj_x1 + cx + dx;
@@ -464,40 +893,53 @@ static void animation_timer_cb(lv_timer_t *timer) {
     lines_update();
 
     /* Invalidate to trigger draw callback */
+#if IS_ENABLED(CONFIG_PROSPECTOR_FIELD_DIRTY_CELLS)
+    invalidate_dirty_cells();
+#else
     lv_obj_invalidate(line_canvas_obj);
+#endif
 }
 
 /* ========== Create Functions ========== */
 
-static void create_labels(lv_obj_t *parent) {
-    const field_color_palette_t *p = &color_palettes[current_palette];
+static void set_battery_text(const char *text) {
+#if IS_ENABLED(CONFIG_PROSPECTOR_DIGIT_ATLAS)
+    digit_label_set_text(battery_label, text);
+#else
+    lv_label_set_text_static(battery_label, text);
+#endif
+}
 
+static void create_labels(lv_obj_t *parent) {
     /* Layer name label (top-left) - FR_Regular_36 */
     layer_label = lv_label_create(parent);
     lv_obj_set_style_text_font(layer_label, &FR_Regular_36, LV_PART_MAIN);
-    lv_obj_set_style_text_color(layer_label, lv_color_hex(p->layer_text), LV_PART_MAIN);
+    lv_obj_add_style(layer_label, &styles.layer_text, LV_PART_MAIN);
     lv_obj_set_pos(layer_label, 9, 14);
     lv_label_set_text(layer_label, "BASE");
 
     /* Output indicator (BLE profile, below layer) - FG_Medium_26 */
     output_label = lv_label_create(parent);
     lv_obj_set_style_text_font(output_label, &FG_Medium_26, LV_PART_MAIN);
-    lv_obj_set_style_text_color(output_label, lv_color_hex(p->output_inactive), LV_PART_MAIN);
+    lv_obj_add_style(output_label, &styles.output, LV_PART_MAIN);
+    lv_obj_add_style(output_label, &styles.output_active, LV_PART_MAIN | LV_STATE_CHECKED);
     lv_obj_set_pos(output_label, 9, 52);
     lv_label_set_text(output_label, "");
 
     /* Battery label (bottom-left) - FR_Regular_30 */
+#if IS_ENABLED(CONFIG_PROSPECTOR_DIGIT_ATLAS)
+    battery_label = digit_label_create(parent, &digit_atlas_FR_Regular_30);
+#else
     battery_label = lv_label_create(parent);
     lv_obj_set_style_text_font(battery_label, &FR_Regular_30, LV_PART_MAIN);
-    lv_obj_set_style_text_color(battery_label, lv_color_hex(p->battery_text), LV_PART_MAIN);
+#endif
+    lv_obj_add_style(battery_label, &styles.battery_text, LV_PART_MAIN);
     lv_obj_set_style_text_letter_space(battery_label, -1, LV_PART_MAIN);
     lv_obj_align(battery_label, LV_ALIGN_BOTTOM_LEFT, 9, -20);
-    lv_label_set_text(battery_label, "-/-");
+    set_battery_text("-/-");
 }
 
 static void create_modifiers(lv_obj_t *parent) {
-    const field_color_palette_t *p = &color_palettes[current_palette];
-
     /* Mac-style modifier symbols on right side (column 7, rows 2-5) */
     /* Order matches Radii: CMD, OPT, CTRL, SHIFT */
     static const char *mod_symbols[] = {
@@ -513,7 +955,8 @@ static void create_modifiers(lv_obj_t *parent) {
         int y = grid_cy[r] - 4;
         mod_labels[i] = lv_label_create(parent);
         lv_obj_set_style_text_font(mod_labels[i], &Symbols_Semibold_32, LV_PART_MAIN);
-        lv_obj_set_style_text_color(mod_labels[i], lv_color_hex(p->mod_inactive), LV_PART_MAIN);
+        lv_obj_add_style(mod_labels[i], &styles.mod, LV_PART_MAIN);
+        lv_obj_add_style(mod_labels[i], &styles.mod_active, LV_PART_MAIN | LV_STATE_CHECKED);
         lv_obj_set_pos(mod_labels[i], x, y);
         lv_label_set_text(mod_labels[i], mod_symbols[i]);
     }
@@ -523,7 +966,6 @@ static void create_modifiers(lv_obj_t *parent) {
 
 static void update_layer(const char *layer_name) {
     if (!layer_label) return;
-    const field_color_palette_t *p = &color_palettes[current_palette];
 
     if (layer_name && layer_name[0]) {
         int i;
@@ -536,12 +978,9 @@ static void update_layer(const char *layer_name) {
     } else {
         lv_label_set_text_static(layer_label, "BASE");
     }
-    lv_obj_set_style_text_color(layer_label, lv_color_hex(p->layer_text), LV_PART_MAIN);
 }
 
 static void update_modifiers(uint8_t flags) {
-    const field_color_palette_t *p = &color_palettes[current_palette];
-
     /* Order: CMD, OPT, CTRL, SHIFT (matches symbol order) */
     bool mods[4] = {
         (flags & 0x88) != 0,  /* GUI/CMD */
@@ -552,8 +991,7 @@ static void update_modifiers(uint8_t flags) {
 
     for (int i = 0; i < 4; i++) {
         if (mod_labels[i]) {
-            lv_obj_set_style_text_color(mod_labels[i],
-                lv_color_hex(mods[i] ? p->mod_active : p->mod_inactive), LV_PART_MAIN);
+            lv_obj_set_state(mod_labels[i], LV_STATE_CHECKED, mods[i]);
         }
     }
 }
@@ -561,7 +999,6 @@ static void update_modifiers(uint8_t flags) {
 static void update_battery(uint8_t central, bool central_ok,
                             uint8_t peripheral, bool peripheral_ok) {
     if (!battery_label) return;
-    const field_color_palette_t *p = &color_palettes[current_palette];
 
     if (central_ok && peripheral_ok && peripheral > 0) {
         snprintf(fl_stbuf_battery, sizeof(fl_stbuf_battery), "%d/%d", central, peripheral);
@@ -570,24 +1007,19 @@ static void update_battery(uint8_t central, bool central_ok,
     } else {
         snprintf(fl_stbuf_battery, sizeof(fl_stbuf_battery), "-");
     }
-    lv_label_set_text_static(battery_label, fl_stbuf_battery);
-    lv_obj_set_style_text_color(battery_label, lv_color_hex(p->battery_text), LV_PART_MAIN);
+    set_battery_text(fl_stbuf_battery);
 }
 
 static void update_output(bool usb_connected, uint8_t ble_profile, bool ble_connected) {
     if (!output_label) return;
-    const field_color_palette_t *p = &color_palettes[current_palette];
 
     if (usb_connected) {
         snprintf(fl_stbuf_output, sizeof(fl_stbuf_output), "USB");
-        lv_label_set_text_static(output_label, fl_stbuf_output);
-        lv_obj_set_style_text_color(output_label, lv_color_hex(p->output_active), LV_PART_MAIN);
     } else {
         snprintf(fl_stbuf_output, sizeof(fl_stbuf_output), "BLE %d", ble_profile);
-        lv_label_set_text_static(output_label, fl_stbuf_output);
-        lv_obj_set_style_text_color(output_label,
-            lv_color_hex(ble_connected ? p->output_active : p->output_inactive), LV_PART_MAIN);
     }
+    lv_label_set_text_static(output_label, fl_stbuf_output);
+    lv_obj_set_state(output_label, LV_STATE_CHECKED, usb_connected || ble_connected);
 }
 
 /* ========== Palette Application ========== */
@@ -596,26 +1028,10 @@ static void apply_palette(void) {
     if (!layout_created) return;
     const field_color_palette_t *p = &color_palettes[current_palette];
 
-    if (layout_container) {
-        lv_obj_set_style_bg_color(layout_container,
-            lv_color_hex(p->background), LV_PART_MAIN);
-    }
-    if (layer_label) {
-        lv_obj_set_style_text_color(layer_label, lv_color_hex(p->layer_text), LV_PART_MAIN);
-    }
-    if (battery_label) {
-        lv_obj_set_style_text_color(battery_label, lv_color_hex(p->battery_text), LV_PART_MAIN);
-    }
-    if (output_label) {
-        lv_obj_set_style_text_color(output_label, lv_color_hex(p->output_inactive), LV_PART_MAIN);
-    }
-    for (int i = 0; i < 4; i++) {
-        if (mod_labels[i]) {
-            lv_obj_set_style_text_color(mod_labels[i], lv_color_hex(p->mod_inactive), LV_PART_MAIN);
-        }
-    }
-
-    /* Line colors update on next draw callback */
+    /* Refreshing the container's styles redraws it and its children;
+     * line colors are read again by the draw callback */
+    styles_set_palette(p);
+    lv_obj_refresh_style(layout_container, LV_PART_ANY, LV_STYLE_PROP_ANY);
     LOG_INF("FIELD: Applied palette %s", p->name);
 }
 
@@ -628,12 +1044,16 @@ lv_obj_t *field_layout_create(lv_obj_t *parent) {
     }
 
     init_lut();
+#if IS_ENABLED(CONFIG_PROSPECTOR_FIELD_FIXED_POINT)
+    init_q15_tables();
+#endif
+
+    styles_set_palette(&color_palettes[current_palette]);
 
     layout_container = lv_obj_create(parent);
     lv_obj_set_size(layout_container, 280, 240);
     lv_obj_set_pos(layout_container, 0, 0);
-    lv_obj_set_style_bg_color(layout_container,
-        lv_color_hex(color_palettes[current_palette].background), LV_PART_MAIN);
+    lv_obj_add_style(layout_container, &styles.background, LV_PART_MAIN);
     lv_obj_set_style_bg_opa(layout_container, LV_OPA_COVER, LV_PART_MAIN);
     lv_obj_set_style_border_width(layout_container, 0, LV_PART_MAIN);
     lv_obj_set_style_pad_all(layout_container, 0, LV_PART_MAIN);
@@ -654,6 +1074,9 @@ lv_obj_t *field_layout_create(lv_obj_t *parent) {
     last_wpm_active_time = k_uptime_get_32();
     animation_started = false;
     last_timer_period = TIMER_PERIOD_2HZ;
+#if IS_ENABLED(CONFIG_PROSPECTOR_FIELD_DIRTY_CELLS)
+    drawn_valid = false;
+#endif
 
     /* Initialize smoothed angles to -45° */
     for (int i = 0; i < GRID_TOTAL; i++) {
@@ -661,6 +1084,9 @@ lv_obj_t *field_layout_create(lv_obj_t *parent) {
         line_length_scale[i] = LENGTH_BASE_IDLE;
         line_opacity[i] = (lv_opa_t)(OPACITY_BASE_IDLE * 255.0f);
     }
+#if IS_ENABLED(CONFIG_PROSPECTOR_FIELD_FIXED_POINT)
+    lines_reset_q15();
+#endif
 
     /* Compute exclusion zones */
     compute_exclusions();
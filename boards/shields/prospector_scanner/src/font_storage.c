@@ -0,0 +1,158 @@
+/*
+ * Copyright (c) 2024 The ZMK Contributors
+ *
+ * SPDX-License-Identifier: MIT
+ */
+
+#include <zephyr/kernel.h>
+#include <zephyr/storage/flash_map.h>
+#include <zephyr/logging/log.h>
+#include <lvgl.h>
+
+#include "font_storage.h"
+#include "font_storage_image.h"
+
+LOG_MODULE_REGISTER(font_storage, LOG_LEVEL_INF);
+
+#define CACHE_ENTRIES CONFIG_PROSPECTOR_FONT_GLYPH_CACHE_ENTRIES
+#define SLOT_SIZE     ROUND_UP(MAX(FONT_STORAGE_MAX_GLYPH, 1), 4)
+
+/* Header of the image, as written by scripts/lvgl_font_extflash.py */
+struct image_header {
+    uint32_t magic;
+    uint16_t version;
+    uint16_t reserved;
+    uint32_t size;
+    uint32_t crc;
+} __packed;
+
+struct cache_entry {
+    const lv_font_t *font;  /* NULL = free */
+    uint32_t gid;
+    uint32_t last_use;
+};
+
+enum storage_state {
+    STORAGE_UNCHECKED = 0,
+    STORAGE_READY,
+    STORAGE_FAILED,
+};
+
+static enum storage_state state;
+static const struct flash_area *area;
+static struct cache_entry entries[CACHE_ENTRIES];
+static uint8_t slots[CACHE_ENTRIES][SLOT_SIZE] __aligned(4);
+static uint32_t use_clock;
+static struct font_storage_stats stats = {.capacity = CACHE_ENTRIES};
+
+static bool storage_open(void) {
+    struct image_header hdr;
+    int err = flash_area_open(FIXED_PARTITION_ID(font_storage), &area);
+
+    if (err == 0) {
+        err = flash_area_read(area, 0, &hdr, sizeof(hdr));
+    }
+    if (err) {
+        LOG_ERR("font_storage partition not readable: %d", err);
+        return false;
+    }
+    if (hdr.magic != FONT_STORAGE_MAGIC || hdr.version != FONT_STORAGE_VERSION ||
+        hdr.size != FONT_STORAGE_IMAGE_SIZE || hdr.crc != FONT_STORAGE_IMAGE_CRC) {
+        LOG_ERR("font_storage holds image crc 0x%08x (%u B), this build needs 0x%08x (%u B):"
+                " program zephyr/font_storage.hex", hdr.crc, hdr.size,
+                FONT_STORAGE_IMAGE_CRC, FONT_STORAGE_IMAGE_SIZE);
+        return false;
+    }
+    LOG_INF("Font bitmaps: %u B in external flash, %u x %u B glyph cache",
+            FONT_STORAGE_IMAGE_SIZE, CACHE_ENTRIES, SLOT_SIZE);
+    return true;
+}
+
+/* Slot holding the bitmap of @p gid, read from flash on a miss */
+static const uint8_t *cache_get(const lv_font_t *font, uint32_t gid, uint32_t offset,
+                                uint32_t size) {
+    struct cache_entry *victim = &entries[0];
+    int i;
+
+    use_clock++;
+    for (i = 0; i < CACHE_ENTRIES; i++) {
+        struct cache_entry *e = &entries[i];
+        if (e->font == font && e->gid == gid) {
+            e->last_use = use_clock;
+            stats.hits++;
+            return slots[i];
+        }
+        if (!victim->font) {
+            continue;  /* Already have a free slot */
+        }
+        if (!e->font || e->last_use < victim->last_use) {
+            victim = e;
+        }
+    }
+
+    i = victim - entries;
+    if (victim->font) {
+        stats.evictions++;
+    } else {
+        stats.entries++;
+    }
+    victim->font = NULL;
+    int err = flash_area_read(area, offset, slots[i], size);
+    if (err) {
+        stats.entries--;
+        stats.read_errors++;
+        LOG_WRN("Glyph read at 0x%x failed: %d", offset, err);
+        return NULL;
+    }
+    stats.misses++;
+    victim->font = font;
+    victim->gid = gid;
+    victim->last_use = use_clock;
+    return slots[i];
+}
+
+const void *font_storage_get_glyph_bitmap(lv_font_glyph_dsc_t *g_dsc, lv_draw_buf_t *draw_buf) {
+    const lv_font_t *font = g_dsc->resolved_font;
+    const lv_font_fmt_txt_dsc_t *fdsc = font->dsc;
+    const struct font_storage_src *src = font->user_data;
+    uint32_t gid = g_dsc->gid.index;
+
+    if (state == STORAGE_UNCHECKED) {
+        state = storage_open() ? STORAGE_READY : STORAGE_FAILED;
+    }
+    if (state != STORAGE_READY || gid == 0 || gid >= src->glyph_count) {
+        return NULL;
+    }
+
+    /* A glyph's bitmap runs up to the next glyph's */
+    const lv_font_fmt_txt_glyph_dsc_t *gdsc = &fdsc->glyph_dsc[gid];
+    uint32_t end = gid + 1 < src->glyph_count ? fdsc->glyph_dsc[gid + 1].bitmap_index
+                                              : src->size;
+    uint32_t size = end - gdsc->bitmap_index;
+    if (size == 0 || size > SLOT_SIZE) {
+        return NULL;
+    }
+
+    const uint8_t *bitmap = cache_get(font, gid, src->offset + gdsc->bitmap_index, size);
+    if (!bitmap) {
+        return NULL;
+    }
+
+    /* Let LVGL decode it: the same font with this one glyph, as glyph 1 of a
+     * bitmap that is the cache slot */
+    lv_font_fmt_txt_glyph_dsc_t glyph[2] = {{0}, *gdsc};
+    glyph[1].bitmap_index = 0;
+    lv_font_fmt_txt_dsc_t slot_dsc = *fdsc;
+    slot_dsc.glyph_bitmap = bitmap;
+    slot_dsc.glyph_dsc = glyph;
+    lv_font_t slot_font = *font;
+    slot_font.dsc = &slot_dsc;
+    lv_font_glyph_dsc_t slot_g = *g_dsc;
+    slot_g.resolved_font = &slot_font;
+    slot_g.gid.index = 1;
+    return lv_font_get_bitmap_fmt_txt(&slot_g, draw_buf);
+}
+
+void font_storage_get_stats(struct font_storage_stats *out) {
+    *out = stats;
+}
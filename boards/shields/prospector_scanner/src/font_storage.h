@@ -0,0 +1,47 @@
+/*
+ * Copyright (c) 2024 The ZMK Contributors
+ *
+ * SPDX-License-Identifier: MIT
+ *
+ * Font glyph bitmaps in external flash (CONFIG_PROSPECTOR_FONT_EXT_FLASH)
+ *
+ * At build time scripts/lvgl_font_extflash.py moves the glyph bitmaps of
+ * the layout fonts into one image for the font_storage partition (QSPI
+ * NOR on the XIAO) and points the fonts' get_glyph_bitmap here. Glyph
+ * descriptors, character maps and kerning stay in internal flash, so
+ * text measuring and layout never touch external flash.
+ *
+ * Bitmaps are read per glyph into a RAM cache of
+ * CONFIG_PROSPECTOR_FONT_GLYPH_CACHE_ENTRIES slots, each sized for the
+ * largest glyph in the image, with least recently used replacement. A
+ * hit is decoded from RAM just as LVGL decodes from internal flash. The
+ * image header is checked against the build once: if the partition does
+ * not hold this build's image, glyphs are not drawn and an error is
+ * logged.
+ */
+
+#pragma once
+
+#include <stdint.h>
+#include <lvgl.h>
+
+/* Where a font's glyph_bitmap[] went (font->user_data, generated) */
+struct font_storage_src {
+    uint32_t offset;       /* From the start of the partition */
+    uint32_t size;
+    uint16_t glyph_count;  /* glyph_dsc[] entries, reserved id 0 included */
+};
+
+struct font_storage_stats {
+    uint32_t hits;
+    uint32_t misses;       /* Read from flash */
+    uint32_t evictions;
+    uint32_t read_errors;
+    uint16_t entries;      /* Cache slots in use */
+    uint16_t capacity;
+};
+
+/* LVGL thread: lv_font_t.get_glyph_bitmap of the moved fonts */
+const void *font_storage_get_glyph_bitmap(lv_font_glyph_dsc_t *g_dsc, lv_draw_buf_t *draw_buf);
+
+void font_storage_get_stats(struct font_storage_stats *out);
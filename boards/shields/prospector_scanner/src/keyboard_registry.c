@@ -0,0 +1,134 @@
+/*
+ * Copyright (c) 2024 The ZMK Contributors
+ *
+ * SPDX-License-Identifier: MIT
+ *
+ * Keyboard registry - see keyboard_registry.h
+ *
+ * NVS key structure:
+ *   "prosp/kbreg/<slot>"  - struct keyboard_registry_record
+ *   "prosp/kbreg/sel"     - selected slot (int8_t)
+ */
+
+#include <zephyr/kernel.h>
+#include <zephyr/logging/log.h>
+#include <zephyr/sys/atomic.h>
+#include <zephyr/settings/settings.h>
+#include <stdio.h>
+#include <string.h>
+#include <stdlib.h>
+#include <zmk/status_scanner.h>
+
+#include "keyboard_registry.h"
+
+LOG_MODULE_REGISTER(keyboard_registry, LOG_LEVEL_INF);
+
+#define REGISTRY_SIZE ZMK_STATUS_SCANNER_MAX_KEYBOARDS
+#define SAVE_DELAY_MS 10000  /* A keyboard's name usually settles within seconds */
+#define SAVE_SELECTED BIT(31)
+
+static struct keyboard_registry_record records[REGISTRY_SIZE];
+static int8_t selected_slot = -1;
+/* Slots (and SAVE_SELECTED) changed since the last save; selection
+ * changes come from the LVGL thread, everything else from the work handler */
+static atomic_t save_mask = ATOMIC_INIT(0);
+
+static void save_work_handler(struct k_work *work) {
+    ARG_UNUSED(work);
+    atomic_val_t mask = atomic_clear(&save_mask);
+    char key[24];
+
+    for (int i = 0; i < REGISTRY_SIZE; i++) {
+        if (!(mask & BIT(i))) {
+            continue;
+        }
+        snprintf(key, sizeof(key), "prosp/kbreg/%d", i);
+        int rc = settings_save_one(key, &records[i], sizeof(records[i]));
+        if (rc != 0) {
+            LOG_WRN("Saving keyboard %d failed: %d", i, rc);
+        }
+    }
+    if (mask & SAVE_SELECTED) {
+        settings_save_one("prosp/kbreg/sel", &selected_slot, sizeof(selected_slot));
+    }
+    LOG_INF("Keyboard registry saved (mask 0x%lX)", (unsigned long)mask);
+}
+
+static K_WORK_DELAYABLE_DEFINE(save_work, save_work_handler);
+
+static void mark_dirty(uint32_t bit) {
+    atomic_or(&save_mask, bit);
+    k_work_reschedule(&save_work, K_MSEC(SAVE_DELAY_MS));
+}
+
+static int keyboard_registry_handle_set(const char *name, size_t len, settings_read_cb read_cb,
+                                        void *cb_arg) {
+    const char *next;
+    int rc;
+
+    if (settings_name_steq(name, "sel", &next) && !next) {
+        if (len != sizeof(selected_slot)) {
+            return -EINVAL;
+        }
+        rc = read_cb(cb_arg, &selected_slot, sizeof(selected_slot));
+        if (rc < 0) {
+            return rc;
+        }
+        if (selected_slot >= REGISTRY_SIZE) {
+            selected_slot = -1;
+        }
+        return 0;
+    }
+
+    char *end;
+    long i = strtol(name, &end, 10);
+    if (end == name || *end != '\0' || i < 0 || i >= REGISTRY_SIZE) {
+        return -ENOENT;  /* Slot beyond a smaller CONFIG_PROSPECTOR_MAX_KEYBOARDS */
+    }
+    if (len != sizeof(records[i])) {
+        return -EINVAL;
+    }
+    rc = read_cb(cb_arg, &records[i], sizeof(records[i]));
+    if (rc < 0) {
+        return rc;
+    }
+    records[i].name[sizeof(records[i].name) - 1] = '\0';
+    LOG_INF("Loaded keyboard %ld: %s (ID=%08X)", i, records[i].name, records[i].keyboard_id);
+    return 0;
+}
+
+SETTINGS_STATIC_HANDLER_DEFINE(prosp_kbreg, "prosp/kbreg", NULL, keyboard_registry_handle_set,
+                               NULL, NULL);
+
+bool keyboard_registry_get(int slot, struct keyboard_registry_record *out) {
+    if (slot < 0 || slot >= REGISTRY_SIZE || !records[slot].used) {
+        return false;
+    }
+    *out = records[slot];
+    return true;
+}
+
+void keyboard_registry_update(int slot, const struct keyboard_registry_record *rec) {
+    if (slot < 0 || slot >= REGISTRY_SIZE) {
+        return;
+    }
+    struct keyboard_registry_record next = *rec;
+    next.used = 1;
+    if (memcmp(&records[slot], &next, sizeof(next)) == 0) {
+        return;
+    }
+    records[slot] = next;
+    mark_dirty(BIT(slot));
+}
+
+int keyboard_registry_get_selected(void) {
+    return selected_slot;
+}
+
+void keyboard_registry_set_selected(int slot) {
+    if (slot < 0 || slot >= REGISTRY_SIZE || slot == selected_slot) {
+        return;
+    }
+    selected_slot = (int8_t)slot;
+    mark_dirty(SAVE_SELECTED);
+}
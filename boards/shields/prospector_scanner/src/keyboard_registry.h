@@ -0,0 +1,43 @@
+/*
+ * Copyright (c) 2024 The ZMK Contributors
+ *
+ * SPDX-License-Identifier: MIT
+ *
+ * Persistent keyboard registry (CONFIG_PROSPECTOR_KEYBOARD_REGISTRY)
+ *
+ * Remembers, per keyboards[] slot, which keyboard lived there (BLE
+ * address, keyboard_id, role, name) and which slot was selected. At boot
+ * scanner_stub.c reserves those slots, so the first advertisement of a
+ * known keyboard lands in its old slot with its name, and the accept list
+ * can filter from the start. Layer names are restored by the layer name
+ * cache (CONFIG_PROSPECTOR_LAYER_NAME_CACHE_PERSIST), keyed by address.
+ *
+ * All calls are made with scanner_stub.c's data_mutex held.
+ */
+
+#pragma once
+
+#include <stdbool.h>
+#include <stdint.h>
+
+struct keyboard_registry_record {
+    uint8_t used;  /* 0 = slot has no record */
+    uint8_t addr[6];
+    uint8_t addr_type;
+    uint8_t role;
+    uint32_t keyboard_id;
+    char name[32];
+} __packed;
+
+/* Record of @p slot, false if it has none */
+bool keyboard_registry_get(int slot, struct keyboard_registry_record *out);
+
+/* Remember @p rec for @p slot; written to flash after a quiet period,
+ * and only if it differs from what is stored */
+void keyboard_registry_update(int slot, const struct keyboard_registry_record *rec);
+
+/* Selected slot at the last save, -1 if none */
+int keyboard_registry_get_selected(void);
+
+/* The user selected @p slot */
+void keyboard_registry_set_selected(int slot);
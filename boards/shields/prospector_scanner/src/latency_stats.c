@@ -0,0 +1,184 @@
+/*
+ * Copyright (c) 2024 The ZMK Contributors
+ *
+ * SPDX-License-Identifier: MIT
+ */
+
+#include <zephyr/kernel.h>
+#include <zephyr/sys/atomic.h>
+#include <zephyr/logging/log.h>
+#include <stdio.h>
+#include <lvgl.h>
+
+#include "latency_stats.h"
+
+LOG_MODULE_REGISTER(latency_stats, LOG_LEVEL_INF);
+
+/* ========== Histograms ========== */
+/* Fixed-width buckets: 8ms x 64 = 0..511ms, plus one overflow bucket.
+ * Percentiles come from a cumulative scan, so they resolve to the upper
+ * edge of a bucket (8ms granularity) - plenty for interval tuning. */
+
+#define BUCKET_MS     8
+#define BUCKET_COUNT  64
+#define LOG_EVERY     50  /* Log a summary after this many totals */
+#define PROBE_TIMEOUT_MS 2000
+
+static uint16_t histogram[LATENCY_STAGE_COUNT][BUCKET_COUNT + 1];
+static uint32_t sample_count[LATENCY_STAGE_COUNT];
+
+static const char *const stage_names[LATENCY_STAGE_COUNT] = {
+    "kbd", "rx>pop", "pop>apply", "apply>flush", "scanner", "total",
+};
+
+static void record(enum latency_stage stage, uint32_t ms) {
+    uint32_t bucket = ms / BUCKET_MS;
+    if (bucket > BUCKET_COUNT) {
+        bucket = BUCKET_COUNT;
+    }
+
+    if (histogram[stage][bucket] == UINT16_MAX) {
+        /* Halve the whole stage so old samples age out instead of clipping */
+        for (int i = 0; i <= BUCKET_COUNT; i++) {
+            histogram[stage][i] /= 2;
+        }
+        sample_count[stage] /= 2;
+    }
+    histogram[stage][bucket]++;
+    sample_count[stage]++;
+}
+
+uint16_t latency_stats_percentile(enum latency_stage stage, uint8_t pct) {
+    if (stage >= LATENCY_STAGE_COUNT || sample_count[stage] == 0) {
+        return 0;
+    }
+
+    uint32_t total = 0;
+    for (int i = 0; i <= BUCKET_COUNT; i++) {
+        total += histogram[stage][i];
+    }
+
+    uint32_t target = (total * pct + 99) / 100;
+    uint32_t seen = 0;
+    for (int i = 0; i <= BUCKET_COUNT; i++) {
+        seen += histogram[stage][i];
+        if (seen >= target && seen > 0) {
+            return (uint16_t)((i + 1) * BUCKET_MS);
+        }
+    }
+    return (uint16_t)((BUCKET_COUNT + 1) * BUCKET_MS);
+}
+
+uint32_t latency_stats_count(enum latency_stage stage) {
+    return (stage < LATENCY_STAGE_COUNT) ? sample_count[stage] : 0;
+}
+
+int latency_stats_format(char *buf, size_t size) {
+    enum latency_stage stage = LATENCY_STAGE_TOTAL;
+    const char *label = "e2e";
+    if (sample_count[LATENCY_STAGE_TOTAL] == 0) {
+        /* Legacy keyboard (no age field): scanner-side part only */
+        stage = LATENCY_STAGE_SCANNER;
+        label = "scan";
+    }
+    if (sample_count[stage] == 0) {
+        return snprintf(buf, size, "lat: --");
+    }
+    return snprintf(buf, size, "%s %u/%u/%ums", label,
+                    latency_stats_percentile(stage, 50),
+                    latency_stats_percentile(stage, 95),
+                    latency_stats_percentile(stage, 99));
+}
+
+static void log_summary(void) {
+    for (int s = 0; s < LATENCY_STAGE_COUNT; s++) {
+        if (sample_count[s] == 0) {
+            continue;
+        }
+        LOG_INF("⏱ %-11s p50=%3ums p95=%3ums p99=%3ums (n=%u)", stage_names[s],
+                latency_stats_percentile(s, 50), latency_stats_percentile(s, 95),
+                latency_stats_percentile(s, 99), sample_count[s]);
+    }
+}
+
+/* ========== Probe ========== */
+/* Single in-flight probe handed from the work queue to the LVGL thread.
+ * Each transition is a CAS, so the two contexts never write the same
+ * fields at the same time. */
+
+enum {
+    PROBE_IDLE = 0,
+    PROBE_BUSY,     /* Owner is writing fields */
+    PROBE_POPPED,   /* Waiting for pending_update_timer_cb */
+    PROBE_APPLIED,  /* Waiting for the display refresh */
+};
+
+static atomic_t probe_state = ATOMIC_INIT(PROBE_IDLE);
+static struct {
+    uint32_t rx_time;
+    uint32_t pop_time;
+    uint32_t apply_time;
+    bool has_kb_age;
+    uint16_t kb_age_ms;
+} probe;
+
+void latency_probe_popped(uint32_t rx_time, bool has_kb_age, uint16_t kb_age_ms) {
+    if (!atomic_cas(&probe_state, PROBE_IDLE, PROBE_BUSY)) {
+        /* Drop a probe the display never picked up (other screen, transition) */
+        bool stale = (k_uptime_get_32() - probe.pop_time) > PROBE_TIMEOUT_MS;
+        if (!stale || !(atomic_cas(&probe_state, PROBE_POPPED, PROBE_BUSY) ||
+                        atomic_cas(&probe_state, PROBE_APPLIED, PROBE_BUSY))) {
+            return;
+        }
+    }
+    probe.rx_time = rx_time;
+    probe.pop_time = k_uptime_get_32();
+    probe.has_kb_age = has_kb_age;
+    probe.kb_age_ms = kb_age_ms;
+    record(LATENCY_STAGE_RX_TO_POP, probe.pop_time - rx_time);
+    atomic_set(&probe_state, PROBE_POPPED);
+}
+
+void latency_probe_applied(void) {
+    if (!atomic_cas(&probe_state, PROBE_POPPED, PROBE_BUSY)) {
+        return;
+    }
+    probe.apply_time = k_uptime_get_32();
+    record(LATENCY_STAGE_POP_TO_APPLY, probe.apply_time - probe.pop_time);
+    atomic_set(&probe_state, PROBE_APPLIED);
+}
+
+/* LV_EVENT_REFR_READY fires at the end of every refresh timer run. With
+ * Zephyr's LVGL glue the flush callback writes to the panel synchronously
+ * (unless LV_Z_FLUSH_THREAD is on: then the last band may still be in the
+ * flush thread), so the first one after apply is when the change reached
+ * the display. */
+static void refr_ready_cb(lv_event_t *e) {
+    ARG_UNUSED(e);
+    if (!atomic_cas(&probe_state, PROBE_APPLIED, PROBE_BUSY)) {
+        return;
+    }
+    uint32_t now = k_uptime_get_32();
+    record(LATENCY_STAGE_APPLY_TO_FLUSH, now - probe.apply_time);
+    record(LATENCY_STAGE_SCANNER, now - probe.rx_time);
+    if (probe.has_kb_age) {
+        record(LATENCY_STAGE_KEYBOARD, probe.kb_age_ms);
+        record(LATENCY_STAGE_TOTAL, probe.kb_age_ms + (now - probe.rx_time));
+        if (sample_count[LATENCY_STAGE_TOTAL] % LOG_EVERY == 0) {
+            log_summary();
+        }
+    } else if (sample_count[LATENCY_STAGE_SCANNER] % LOG_EVERY == 0) {
+        log_summary();
+    }
+    atomic_set(&probe_state, PROBE_IDLE);
+}
+
+void latency_stats_attach_display(void) {
+    lv_display_t *disp = lv_display_get_default();
+    if (!disp) {
+        LOG_WRN("No default display - latency flush stage disabled");
+        return;
+    }
+    lv_display_add_event_cb(disp, refr_ready_cb, LV_EVENT_REFR_READY, NULL);
+    LOG_INF("Latency instrumentation attached");
+}
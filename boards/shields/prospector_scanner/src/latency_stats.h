@@ -0,0 +1,51 @@
+/*
+ * Copyright (c) 2024 The ZMK Contributors
+ *
+ * SPDX-License-Identifier: MIT
+ *
+ * Keypress-to-pixel latency histograms (CONFIG_PROSPECTOR_LATENCY_STATS)
+ *
+ * One change at a time is followed through the pipeline:
+ *   keyboard event → ADV built      (age_ms carried in v3 / extended frames)
+ *   scan_callback → incoming_pop     (scanner_process_incoming, work queue)
+ *   incoming_pop → applied           (pending_update_timer_cb, LVGL thread)
+ *   applied → flushed                (next LVGL refresh, display written)
+ * plus the scanner-side sum and the end-to-end total. The on-air wait
+ * between "ADV built" and scan_callback can't be measured without a
+ * shared clock and is folded into neither stage.
+ */
+
+#pragma once
+
+#include <stdint.h>
+#include <stdbool.h>
+#include <stddef.h>
+
+enum latency_stage {
+    LATENCY_STAGE_KEYBOARD = 0,   // Key event → ADV data set on the keyboard
+    LATENCY_STAGE_RX_TO_POP,      // scan_callback → incoming_pop
+    LATENCY_STAGE_POP_TO_APPLY,   // incoming_pop → widgets updated
+    LATENCY_STAGE_APPLY_TO_FLUSH, // widgets updated → display flushed
+    LATENCY_STAGE_SCANNER,        // scan_callback → display flushed
+    LATENCY_STAGE_TOTAL,          // KEYBOARD + scan_callback → flushed
+    LATENCY_STAGE_COUNT,
+};
+
+/* Work queue: a display-relevant change was popped from the ring.
+ * Ignored while a previous probe is still in flight. */
+void latency_probe_popped(uint32_t rx_time, bool has_kb_age, uint16_t kb_age_ms);
+
+/* LVGL thread: pending data was applied to the widgets */
+void latency_probe_applied(void);
+
+/* LVGL thread: register the display refresh hook (call once after LVGL init) */
+void latency_stats_attach_display(void);
+
+/* Percentile (0-100) of a stage in ms, 0 if no samples */
+uint16_t latency_stats_percentile(enum latency_stage stage, uint8_t pct);
+
+/* Number of samples recorded for a stage */
+uint32_t latency_stats_count(enum latency_stage stage);
+
+/* One-line p50/p95/p99 summary of the total, for the debug widget */
+int latency_stats_format(char *buf, size_t size);
@@ -0,0 +1,199 @@
+/*
+ * Copyright (c) 2024 The ZMK Contributors
+ *
+ * SPDX-License-Identifier: MIT
+ *
+ * Layer name cache - see layer_name_cache.h
+ *
+ * Written only by the scanner work handler (store/find) and, at boot, by
+ * the settings loader before scanning starts. Readers use the strings in
+ * place: a table rewrite is rare (keyboard keymap change) and always
+ * comes with a new static hash, which marks the layer dirty, so a read
+ * racing the rewrite is redrawn on the next update.
+ *
+ * NVS key structure (CONFIG_PROSPECTOR_LAYER_NAME_CACHE_PERSIST):
+ *   "prosp/lnames/<entry>"  - struct layer_name_record
+ */
+
+#include <zephyr/kernel.h>
+#include <zephyr/logging/log.h>
+#include <zephyr/sys/byteorder.h>
+#include <stdio.h>
+#include <string.h>
+#include <stdlib.h>
+#include <zmk/status_scanner.h>
+
+#include "layer_name_cache.h"
+
+#if IS_ENABLED(CONFIG_PROSPECTOR_LAYER_NAME_CACHE_PERSIST)
+#include <zephyr/settings/settings.h>
+#endif
+
+LOG_MODULE_REGISTER(layer_name_cache, LOG_LEVEL_INF);
+
+/* Room for keyboards that come and go, not just those tracked at once */
+#define CACHE_SIZE (ZMK_STATUS_SCANNER_MAX_KEYBOARDS * 2)
+
+#define SAVE_DELAY_MS 10000  /* Batch a keymap being reflashed and re-sent */
+
+struct layer_name_record {
+    uint32_t keyboard_id;
+    uint8_t role;
+    uint8_t hash;         /* Static hash of the table, 0 = entry unused */
+    uint8_t layer_count;
+    uint32_t last_used;   /* use_clock value, for LRU replacement */
+    char names[ZMK_STATUS_ADV_STATIC_MAX_LAYERS][ZMK_STATUS_ADV_EXT_LAYER_NAME_MAX + 1];
+} __packed;
+
+static struct layer_name_record entries[CACHE_SIZE];
+static uint32_t use_clock;
+
+static void entry_touch(int i) {
+    entries[i].last_used = ++use_clock;
+}
+
+static int entry_lookup(uint32_t keyboard_id, uint8_t role) {
+    for (int i = 0; i < CACHE_SIZE; i++) {
+        if (entries[i].hash != 0 && entries[i].keyboard_id == keyboard_id &&
+            entries[i].role == role) {
+            return i;
+        }
+    }
+    return LAYER_NAME_CACHE_NONE;
+}
+
+/* ========== Persistence ========== */
+
+#if IS_ENABLED(CONFIG_PROSPECTOR_LAYER_NAME_CACHE_PERSIST)
+
+static uint32_t save_mask;  /* Entries changed since the last save */
+
+static void save_work_handler(struct k_work *work) {
+    ARG_UNUSED(work);
+    char key[24];
+
+    for (int i = 0; i < CACHE_SIZE; i++) {
+        if (!(save_mask & BIT(i))) {
+            continue;
+        }
+        snprintf(key, sizeof(key), "prosp/lnames/%d", i);
+        int rc = settings_save_one(key, &entries[i], sizeof(entries[i]));
+        if (rc != 0) {
+            LOG_WRN("Saving layer names %d failed: %d", i, rc);
+        }
+    }
+    LOG_INF("Layer names saved (mask 0x%X)", save_mask);
+    save_mask = 0;
+}
+
+static K_WORK_DELAYABLE_DEFINE(save_work, save_work_handler);
+
+static void entry_mark_dirty(int i) {
+    save_mask |= BIT(i);
+    k_work_reschedule(&save_work, K_MSEC(SAVE_DELAY_MS));
+}
+
+static int layer_name_cache_handle_set(const char *name, size_t len,
+                                       settings_read_cb read_cb, void *cb_arg) {
+    char *end;
+    long i = strtol(name, &end, 10);
+
+    if (end == name || *end != '\0' || i < 0 || i >= CACHE_SIZE) {
+        return -ENOENT;  /* Entry beyond a smaller CONFIG_PROSPECTOR_MAX_KEYBOARDS */
+    }
+    if (len != sizeof(entries[i])) {
+        return -EINVAL;  /* Also a record from before entries were keyed by keyboard_id */
+    }
+    int rc = read_cb(cb_arg, &entries[i], sizeof(entries[i]));
+    if (rc < 0) {
+        return rc;
+    }
+    if (entries[i].layer_count > ZMK_STATUS_ADV_STATIC_MAX_LAYERS) {
+        memset(&entries[i], 0, sizeof(entries[i]));
+        return -EINVAL;
+    }
+    use_clock = MAX(use_clock, entries[i].last_used);
+    LOG_INF("Loaded layer names %ld: %d layers (hash 0x%02X)", i, entries[i].layer_count,
+            entries[i].hash);
+    return 0;
+}
+
+SETTINGS_STATIC_HANDLER_DEFINE(prosp_lnames, "prosp/lnames", NULL,
+                               layer_name_cache_handle_set, NULL, NULL);
+
+#else
+
+static void entry_mark_dirty(int i) {
+    ARG_UNUSED(i);
+}
+
+#endif /* CONFIG_PROSPECTOR_LAYER_NAME_CACHE_PERSIST */
+
+/* ========== Public API ========== */
+
+int layer_name_cache_store(const struct zmk_status_adv_data *kb,
+                           const struct zmk_status_adv_static_info *info) {
+    if (info->hash == 0) {
+        return LAYER_NAME_CACHE_NONE;
+    }
+
+    uint32_t keyboard_id = sys_get_be32(kb->keyboard_id);
+    int i = entry_lookup(keyboard_id, kb->device_role);
+    if (i >= 0 && entries[i].hash == info->hash && entries[i].layer_count == info->layer_count) {
+        entry_touch(i);
+        return i;  /* Unchanged: only the LRU stamp moves, not worth a flash write */
+    }
+
+    if (i < 0) {
+        i = 0;
+        for (int j = 0; j < CACHE_SIZE; j++) {
+            if (entries[j].hash == 0) {
+                i = j;
+                break;
+            }
+            if (entries[j].last_used < entries[i].last_used) {
+                i = j;
+            }
+        }
+        entries[i].keyboard_id = keyboard_id;
+        entries[i].role = kb->device_role;
+    }
+
+    entries[i].layer_count = info->layer_count;
+    memcpy(entries[i].names, info->layer_names, sizeof(entries[i].names));
+    entries[i].hash = info->hash;
+    entry_touch(i);
+    entry_mark_dirty(i);
+    return i;
+}
+
+int layer_name_cache_find(const struct zmk_status_adv_data *kb,
+                          struct zmk_status_adv_static_info *out) {
+    int i = entry_lookup(sys_get_be32(kb->keyboard_id), kb->device_role);
+    if (i < 0) {
+        return LAYER_NAME_CACHE_NONE;
+    }
+
+    entry_touch(i);
+    if (out) {
+        out->hash = entries[i].hash;
+        out->layer_count = entries[i].layer_count;
+        memcpy(out->layer_names, entries[i].names, sizeof(out->layer_names));
+    }
+    return i;
+}
+
+const char *layer_name_cache_get(int entry, uint8_t layer) {
+    if (entry < 0 || entry >= CACHE_SIZE || layer >= entries[entry].layer_count ||
+        entries[entry].names[layer][0] == '\0') {
+        return NULL;
+    }
+    return entries[entry].names[layer];
+}
+
+uint8_t layer_name_cache_count(int entry) {
+    if (entry < 0 || entry >= CACHE_SIZE) {
+        return 0;
+    }
+    return entries[entry].layer_count;
+}
@@ -0,0 +1,67 @@
+/*
+ * Copyright (c) 2024 The ZMK Contributors
+ *
+ * SPDX-License-Identifier: MIT
+ *
+ * Layer name cache - per-keyboard layer name tables
+ *
+ * One entry per keyboard (keyboard_id + device role, so an address
+ * rotating or a split half taking over the advertising keeps it), filled
+ * from the keyboard's static packet. Display code reads names by (entry, layer index) as pointers
+ * into the table, so nothing is copied per update. With
+ * CONFIG_PROSPECTOR_LAYER_NAME_CACHE_PERSIST entries are kept in settings
+ * and a known keyboard shows its layer names before its static packet
+ * has been received again after a reboot.
+ */
+
+#pragma once
+
+#include <stdint.h>
+#include <stdbool.h>
+#include <zmk/status_advertisement.h>
+
+#define LAYER_NAME_CACHE_NONE (-1)
+
+/**
+ * @brief Store a keyboard's layer table (work queue context)
+ *
+ * Entries are reused by keyboard_id and role; a new keyboard takes the
+ * least recently used entry. Persisted (deferred) when the table differs
+ * from the stored one.
+ *
+ * @param kb The keyboard's status frame, for its keyboard_id and device_role
+ * @param info Decoded static packet (hash != 0)
+ * @return Entry index, LAYER_NAME_CACHE_NONE if info is empty
+ */
+int layer_name_cache_store(const struct zmk_status_adv_data *kb,
+                           const struct zmk_status_adv_static_info *info);
+
+/**
+ * @brief Find the entry of a keyboard (work queue context)
+ *
+ * @param kb The keyboard's status frame, for its keyboard_id and device_role
+ * @param out Output (optional): the cached table, to seed the keyboard's static_info
+ * @return Entry index, LAYER_NAME_CACHE_NONE if the keyboard is unknown
+ */
+int layer_name_cache_find(const struct zmk_status_adv_data *kb,
+                          struct zmk_status_adv_static_info *out);
+
+/**
+ * @brief Layer name by index (any thread)
+ *
+ * The pointer stays valid while the entry is in use; a keyboard sending
+ * a new table changes its static hash, which redraws the layer anyway.
+ *
+ * @param entry Entry index from store/find
+ * @param layer Layer index
+ * @return Null-terminated name, NULL if the entry has no name for the layer
+ */
+const char *layer_name_cache_get(int entry, uint8_t layer);
+
+/**
+ * @brief Number of layers in an entry's table (any thread)
+ *
+ * @param entry Entry index from store/find
+ * @return Layer count, 0 if the entry is empty or invalid
+ */
+uint8_t layer_name_cache_count(int entry);
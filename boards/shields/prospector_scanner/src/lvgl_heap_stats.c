@@ -0,0 +1,251 @@
+/*
+ * Copyright (c) 2024 The ZMK Contributors
+ *
+ * SPDX-License-Identifier: MIT
+ */
+
+#include <zephyr/kernel.h>
+#include <zephyr/logging/log.h>
+#include <stdio.h>
+#include <lvgl.h>
+
+#include "lvgl_heap_stats.h"
+
+LOG_MODULE_REGISTER(lvgl_heap_stats, LOG_LEVEL_INF);
+
+/* ========== Allocator Wrappers ========== */
+/* Linked with -Wl,--wrap (see CMakeLists.txt): lv_mem.c's calls land here
+ * and __real_* is whatever allocator LVGL was configured with. The 8-byte
+ * header keeps the returned pointer's 8-byte alignment. */
+
+struct blk_hdr {
+    uint32_t size;
+    uint8_t tag;
+    uint8_t reserved[3];
+};
+BUILD_ASSERT(sizeof(struct blk_hdr) == 8, "LVGL block header must keep 8-byte alignment");
+
+/* sys_heap chunk header, used only to estimate free space for frag_pct */
+#define HEAP_CHUNK_OVERHEAD 8
+
+void *__real_lv_malloc_core(size_t size);
+void *__real_lv_realloc_core(void *p, size_t new_size);
+void __real_lv_free_core(void *p);
+
+static struct k_spinlock stats_lock;
+static uint8_t current_tag = LVGL_HEAP_TAG_SHARED;
+static const char *tag_names[LVGL_HEAP_TAG_COUNT];
+static uint32_t used_bytes;
+static uint32_t peak_bytes;
+static uint32_t live_allocs;
+static uint32_t tag_bytes[LVGL_HEAP_TAG_COUNT];
+static uint32_t tag_allocs[LVGL_HEAP_TAG_COUNT];
+
+static void account_alloc(uint8_t tag, uint32_t size) {
+    used_bytes += size;
+    live_allocs++;
+    tag_bytes[tag] += size;
+    tag_allocs[tag]++;
+    if (used_bytes > peak_bytes) {
+        peak_bytes = used_bytes;
+    }
+}
+
+static void account_free(uint8_t tag, uint32_t size) {
+    used_bytes -= size;
+    live_allocs--;
+    tag_bytes[tag] -= size;
+    tag_allocs[tag]--;
+}
+
+void *__wrap_lv_malloc_core(size_t size) {
+    struct blk_hdr *hdr = __real_lv_malloc_core(size + sizeof(*hdr));
+    if (!hdr) {
+        return NULL;
+    }
+
+    k_spinlock_key_t key = k_spin_lock(&stats_lock);
+    hdr->size = size;
+    hdr->tag = current_tag;
+    account_alloc(hdr->tag, size);
+    k_spin_unlock(&stats_lock, key);
+    return hdr + 1;
+}
+
+void __wrap_lv_free_core(void *p) {
+    if (!p) {
+        return;
+    }
+
+    struct blk_hdr *hdr = (struct blk_hdr *)p - 1;
+    k_spinlock_key_t key = k_spin_lock(&stats_lock);
+    account_free(hdr->tag, hdr->size);
+    k_spin_unlock(&stats_lock, key);
+    __real_lv_free_core(hdr);
+}
+
+void *__wrap_lv_realloc_core(void *p, size_t new_size) {
+    if (!p) {
+        return __wrap_lv_malloc_core(new_size);
+    }
+
+    struct blk_hdr *hdr = __real_lv_realloc_core((struct blk_hdr *)p - 1,
+                                                 new_size + sizeof(*hdr));
+    if (!hdr) {
+        return NULL;  /* Old block untouched */
+    }
+
+    /* The block stays with the screen that first allocated it */
+    k_spinlock_key_t key = k_spin_lock(&stats_lock);
+    account_free(hdr->tag, hdr->size);
+    hdr->size = new_size;
+    account_alloc(hdr->tag, new_size);
+    k_spin_unlock(&stats_lock, key);
+    return hdr + 1;
+}
+
+/* ========== Snapshots ========== */
+
+static struct lvgl_heap_snapshot last_snapshot;
+static uint32_t last_snapshot_time;
+static uint32_t last_residue[LVGL_HEAP_TAG_COUNT];
+static bool residue_seen[LVGL_HEAP_TAG_COUNT];
+
+void lvgl_heap_stats_set_tag(uint8_t tag, const char *name) {
+    if (tag >= LVGL_HEAP_TAG_COUNT) {
+        tag = LVGL_HEAP_TAG_SHARED;
+    }
+    k_spinlock_key_t key = k_spin_lock(&stats_lock);
+    current_tag = tag;
+    tag_names[tag] = name;
+    k_spin_unlock(&stats_lock, key);
+}
+
+uint32_t lvgl_heap_stats_tag_bytes(uint8_t tag) {
+    return tag < LVGL_HEAP_TAG_COUNT ? tag_bytes[tag] : 0;
+}
+
+uint32_t lvgl_heap_stats_tag_allocs(uint8_t tag) {
+    return tag < LVGL_HEAP_TAG_COUNT ? tag_allocs[tag] : 0;
+}
+
+/* Largest block the allocator hands out right now, by bisection on real
+ * allocations (each probe is freed at once). Bounded by @p limit. */
+static uint32_t probe_largest_free(uint32_t limit) {
+    uint32_t lo = 0;
+    uint32_t hi = limit;
+    while (lo < hi) {
+        uint32_t mid = lo + (hi - lo + 1) / 2;
+        void *p = __real_lv_malloc_core(mid);
+        if (p) {
+            __real_lv_free_core(p);
+            lo = mid;
+        } else {
+            hi = mid - 1;
+        }
+    }
+    return lo;
+}
+
+void lvgl_heap_stats_sample(struct lvgl_heap_snapshot *out) {
+    struct lvgl_heap_snapshot s = {0};
+
+    k_spinlock_key_t key = k_spin_lock(&stats_lock);
+    s.used = used_bytes;
+    s.peak = peak_bytes;
+    s.alloc_count = live_allocs;
+    k_spin_unlock(&stats_lock, key);
+
+    /* The builtin TLSF allocator reports exact figures; Zephyr's sys_heap
+     * pool reports nothing, so estimate free space and probe instead. */
+    lv_mem_monitor_t mon;
+    lv_mem_monitor(&mon);
+    if (mon.total_size > 0) {
+        s.pool_size = mon.total_size;
+        s.largest_free = mon.free_biggest_size;
+        s.frag_pct = mon.frag_pct;
+    } else {
+#ifdef CONFIG_LV_Z_MEM_POOL_SIZE
+        s.pool_size = CONFIG_LV_Z_MEM_POOL_SIZE;
+#endif
+        uint32_t overhead = s.alloc_count * (sizeof(struct blk_hdr) + HEAP_CHUNK_OVERHEAD);
+        uint32_t free_est = s.pool_size > s.used + overhead ? s.pool_size - s.used - overhead : 0;
+        s.largest_free = probe_largest_free(free_est);
+        if (free_est > 0 && s.largest_free < free_est) {
+            s.frag_pct = 100 - (uint8_t)((uint64_t)s.largest_free * 100 / free_est);
+        }
+    }
+
+    last_snapshot = s;
+    last_snapshot_time = k_uptime_get_32();
+    if (out) {
+        *out = s;
+    }
+}
+
+void lvgl_heap_stats_log_transition(const char *from, uint8_t from_tag, bool from_dropped,
+                                    const char *to, const struct lvgl_heap_snapshot *before) {
+    struct lvgl_heap_snapshot after;
+    lvgl_heap_stats_sample(&after);
+
+    LOG_INF("🧮 %s -> %s: used %u (%+d) allocs %u (%+d) peak %u largest %u frag %u%%",
+            from, to, after.used, (int)(after.used - before->used), after.alloc_count,
+            (int)(after.alloc_count - before->alloc_count), after.peak, after.largest_free,
+            after.frag_pct);
+
+    if (!from_dropped || from_tag >= LVGL_HEAP_TAG_COUNT) {
+        return;
+    }
+
+    /* A destroyed screen should give back the same amount every time;
+     * residue that keeps growing visit after visit is a leak. */
+    uint32_t residue = tag_bytes[from_tag];
+    if (residue_seen[from_tag] && residue > last_residue[from_tag]) {
+        LOG_WRN("🧮 %s left %u bytes in %u blocks after destroy (was %u) - leak?", from,
+                residue, tag_allocs[from_tag], last_residue[from_tag]);
+    } else if (residue > 0) {
+        LOG_DBG("🧮 %s left %u bytes in %u blocks after destroy", from, residue,
+                tag_allocs[from_tag]);
+    }
+    last_residue[from_tag] = residue;
+    residue_seen[from_tag] = true;
+}
+
+int lvgl_heap_stats_format(char *buf, size_t size) {
+    const struct lvgl_heap_snapshot *s = &last_snapshot;
+    if (s->pool_size == 0) {
+        return snprintf(buf, size, "heap %u.%uK peak %u.%uK", s->used / 1024,
+                        (s->used % 1024) * 10 / 1024, s->peak / 1024,
+                        (s->peak % 1024) * 10 / 1024);
+    }
+    return snprintf(buf, size, "heap %u.%u/%uK peak %u.%uK frag %u%%", s->used / 1024,
+                    (s->used % 1024) * 10 / 1024, s->pool_size / 1024, s->peak / 1024,
+                    (s->peak % 1024) * 10 / 1024, s->frag_pct);
+}
+
+#if IS_ENABLED(CONFIG_SHELL)
+#include <zephyr/shell/shell.h>
+
+/* Runs on the shell thread, so it never probes the allocator itself:
+ * the pool figures are from the last snapshot taken on the LVGL thread. */
+static int cmd_lvgl_heap(const struct shell *sh, size_t argc, char **argv) {
+    ARG_UNUSED(argc);
+    ARG_UNUSED(argv);
+    char line[64];
+
+    lvgl_heap_stats_format(line, sizeof(line));
+    shell_print(sh, "%s (snapshot %u ms ago)", line, k_uptime_get_32() - last_snapshot_time);
+    shell_print(sh, "live: %u bytes in %u blocks, largest free %u", used_bytes, live_allocs,
+                last_snapshot.largest_free);
+    for (int i = 0; i < LVGL_HEAP_TAG_COUNT; i++) {
+        if (tag_allocs[i] == 0) {
+            continue;
+        }
+        shell_print(sh, "  %-18s %6u bytes %4u blocks", tag_names[i] ? tag_names[i] : "shared",
+                    tag_bytes[i], tag_allocs[i]);
+    }
+    return 0;
+}
+
+SHELL_CMD_REGISTER(lvgl_heap, NULL, "LVGL heap usage per screen", cmd_lvgl_heap);
+#endif
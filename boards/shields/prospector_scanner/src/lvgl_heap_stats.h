@@ -0,0 +1,52 @@
+/*
+ * Copyright (c) 2024 The ZMK Contributors
+ *
+ * SPDX-License-Identifier: MIT
+ *
+ * LVGL heap instrumentation (CONFIG_PROSPECTOR_LVGL_HEAP_STATS)
+ *
+ * lv_malloc_core / lv_realloc_core / lv_free_core are wrapped at link
+ * time, so every LVGL allocation is counted whichever allocator backs
+ * it (Zephyr sys_heap pool or LVGL's builtin TLSF). Each block carries
+ * a small header with its size and the tag (screen) that was current
+ * when it was allocated, so frees are credited back to the right screen
+ * and a screen's residue after it is destroyed is visible.
+ */
+
+#pragma once
+
+#include <stdint.h>
+#include <stdbool.h>
+#include <stddef.h>
+
+#define LVGL_HEAP_TAG_COUNT 8     // Screens 0..6 + shared
+#define LVGL_HEAP_TAG_SHARED 7    // Allocations before the first screen is tagged
+
+struct lvgl_heap_snapshot {
+    uint32_t pool_size;     // Total pool, 0 if unknown
+    uint32_t used;          // Live bytes requested by LVGL
+    uint32_t peak;          // High-water mark of used since boot
+    uint32_t largest_free;  // Largest block that could be allocated right now
+    uint32_t alloc_count;   // Live allocations
+    uint8_t frag_pct;       // 100 - largest_free * 100 / free
+};
+
+/* Attribute subsequent allocations to @p tag (a screen index); @p name is
+ * kept for reports and must be static */
+void lvgl_heap_stats_set_tag(uint8_t tag, const char *name);
+
+/* LVGL thread: take a snapshot, probing the allocator for the largest free block */
+void lvgl_heap_stats_sample(struct lvgl_heap_snapshot *out);
+
+/* Live bytes / allocations currently attributed to @p tag */
+uint32_t lvgl_heap_stats_tag_bytes(uint8_t tag);
+uint32_t lvgl_heap_stats_tag_allocs(uint8_t tag);
+
+/* LVGL thread: log a transition, comparing against a snapshot taken before it.
+ * @p from_dropped: @p from_tag's widgets were destroyed (not cached), so
+ * whatever is still attributed to it is residue. */
+void lvgl_heap_stats_log_transition(const char *from, uint8_t from_tag, bool from_dropped,
+                                    const char *to, const struct lvgl_heap_snapshot *before);
+
+/* One-line summary of the last snapshot, for the Quick Actions screen */
+int lvgl_heap_stats_format(char *buf, size_t size);
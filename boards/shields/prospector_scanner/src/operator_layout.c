@@ -10,6 +10,10 @@
 #include "operator_layout.h"
 #include "display_settings.h"
 #include "fonts_carrefinho.h"
+#if IS_ENABLED(CONFIG_PROSPECTOR_DIGIT_ATLAS)
+#include "digit_label.h"
+#endif
+#include "ring_gauge.h"
 #include <zephyr/kernel.h>
 #include <zephyr/logging/log.h>
 #include <string.h>
@@ -161,6 +165,120 @@ static const operator_color_palette_t color_palettes[4] = {
 #define PALETTE_COUNT 4
 static uint8_t current_palette = 0;
 
+/* ========== Palette Styles ========== */
+
+/* One shared style per palette role. Widgets take their active color
+ * through LV_STATE_CHECKED, so a palette change only rewrites these styles.
+ * Battery widgets keep their disconnected colors as local styles and take
+ * the palette with CHECKED (connected) and BATTERY_STATE_LOW on top. */
+#define BATTERY_STATE_LOW LV_STATE_USER_1
+
+static struct {
+    lv_style_t mod;
+    lv_style_t mod_active;
+    lv_style_t mod_separator;
+    lv_style_t wpm_bar;
+    lv_style_t wpm_bar_active;
+    lv_style_t wpm_text;
+    lv_style_t layer_text;
+    lv_style_t layer_dot;
+    lv_style_t layer_dot_active;
+    lv_style_t battery_ring;
+    lv_style_t battery_fill;
+    lv_style_t battery_low_ring;
+    lv_style_t battery_low_fill;
+    lv_style_t usb;
+    lv_style_t usb_active;
+    lv_style_t ble;
+    lv_style_t ble_active;
+    lv_style_t slot;
+    lv_style_t slot_active;
+    bool initialized;
+} styles;
+
+static void styles_init(void) {
+    lv_style_t *all[] = {
+        &styles.mod, &styles.mod_active, &styles.mod_separator,
+        &styles.wpm_bar, &styles.wpm_bar_active, &styles.wpm_text, &styles.layer_text,
+        &styles.layer_dot, &styles.layer_dot_active,
+        &styles.battery_ring, &styles.battery_fill,
+        &styles.battery_low_ring, &styles.battery_low_fill,
+        &styles.usb, &styles.usb_active, &styles.ble, &styles.ble_active,
+        &styles.slot, &styles.slot_active,
+    };
+    for (size_t i = 0; i < ARRAY_SIZE(all); i++) {
+        lv_style_init(all[i]);
+    }
+
+    /* Palette independent parts: USB/BLE are outlined when inactive, solid when active */
+    lv_style_set_bg_opa(&styles.usb, LV_OPA_TRANSP);
+    lv_style_set_border_width(&styles.usb, 2);
+    lv_style_set_bg_opa(&styles.usb_active, LV_OPA_COVER);
+    lv_style_set_border_width(&styles.usb_active, 0);
+    lv_style_set_bg_opa(&styles.ble, LV_OPA_TRANSP);
+    lv_style_set_border_width(&styles.ble, 2);
+    lv_style_set_bg_opa(&styles.ble_active, LV_OPA_COVER);
+    lv_style_set_border_width(&styles.ble_active, 0);
+    styles.initialized = true;
+}
+
+/* Ring and fill roles cover both the arcs (arc_color) and the bars
+ * (bg_color); the fill also colors the bar percentage labels */
+static void set_battery_style_colors(lv_style_t *ring, lv_style_t *fill,
+                                     uint32_t ring_color, uint32_t fill_color) {
+    lv_style_set_arc_color(ring, lv_color_hex(ring_color));
+    lv_style_set_bg_color(ring, lv_color_hex(ring_color));
+    lv_style_set_arc_color(fill, lv_color_hex(fill_color));
+    lv_style_set_bg_color(fill, lv_color_hex(fill_color));
+    lv_style_set_text_color(fill, lv_color_hex(fill_color));
+}
+
+static void styles_set_palette(const operator_color_palette_t *p) {
+    if (!styles.initialized) {
+        styles_init();
+    }
+    lv_style_set_text_color(&styles.mod, lv_color_hex(p->mod_inactive));
+    lv_style_set_text_color(&styles.mod_active, lv_color_hex(p->mod_active));
+    lv_style_set_bg_color(&styles.mod_separator, lv_color_hex(p->mod_separator));
+    lv_style_set_bg_color(&styles.wpm_bar, lv_color_hex(p->wpm_bar_inactive));
+    lv_style_set_bg_color(&styles.wpm_bar_active, lv_color_hex(p->wpm_bar_active));
+    lv_style_set_text_color(&styles.wpm_text, lv_color_hex(p->wpm_text));
+    lv_style_set_text_color(&styles.layer_text, lv_color_hex(p->layer_text));
+    lv_style_set_bg_color(&styles.layer_dot, lv_color_hex(p->layer_dot_inactive));
+    lv_style_set_bg_color(&styles.layer_dot_active, lv_color_hex(p->layer_dot_active));
+    set_battery_style_colors(&styles.battery_ring, &styles.battery_fill,
+                             p->battery_ring, p->battery_fill);
+    set_battery_style_colors(&styles.battery_low_ring, &styles.battery_low_fill,
+                             p->battery_low_ring, p->battery_low_fill);
+    /* USB/BLE labels inherit the text color of their box */
+    lv_style_set_border_color(&styles.usb, lv_color_hex(p->usb_inactive_bg));
+    lv_style_set_text_color(&styles.usb, lv_color_hex(p->usb_inactive_bg));
+    lv_style_set_bg_color(&styles.usb_active, lv_color_hex(p->usb_active_bg));
+    lv_style_set_text_color(&styles.usb_active, lv_color_hex(p->output_active_text));
+    lv_style_set_border_color(&styles.ble, lv_color_hex(p->ble_inactive_bg));
+    lv_style_set_text_color(&styles.ble, lv_color_hex(p->ble_inactive_bg));
+    lv_style_set_bg_color(&styles.ble_active, lv_color_hex(p->ble_active_bg));
+    lv_style_set_text_color(&styles.ble_active, lv_color_hex(p->output_active_text));
+    lv_style_set_bg_color(&styles.slot, lv_color_hex(p->slot_inactive_bg));
+    lv_style_set_bg_color(&styles.slot_active, lv_color_hex(p->slot_active_bg));
+}
+
+/* Palette ring/fill (and their low variants) on top of @p obj's local
+ * disconnected colors; pass 0 for a part that has no such role */
+static void add_battery_styles(lv_obj_t *obj, lv_part_t ring_part, lv_part_t fill_part) {
+    if (ring_part) {
+        lv_obj_add_style(obj, &styles.battery_ring, ring_part | LV_STATE_CHECKED);
+        lv_obj_add_style(obj, &styles.battery_low_ring, ring_part | BATTERY_STATE_LOW);
+    }
+    lv_obj_add_style(obj, &styles.battery_fill, fill_part | LV_STATE_CHECKED);
+    lv_obj_add_style(obj, &styles.battery_low_fill, fill_part | BATTERY_STATE_LOW);
+}
+
+static void set_battery_state(lv_obj_t *obj, bool connected, bool low) {
+    lv_obj_set_state(obj, LV_STATE_CHECKED, connected);
+    lv_obj_set_state(obj, BATTERY_STATE_LOW, low);
+}
+
 /* Original positions from carrefinho - no offset needed (hardware handles y-offset) */
 /* Display: 240x280 with hardware y-offset=20, software sees 240x240 */
 
@@ -280,8 +398,6 @@ static const char *modifier_texts[] = {"CTRL", "ALT", "SHFT", "GUI"};
 static lv_obj_t *mod_separators[3] = {NULL};
 
 static void create_modifier_indicator(lv_obj_t *parent) {
-    const operator_color_palette_t *p = &color_palettes[current_palette];
-
     modifier_widgets.container = lv_obj_create(parent);
     lv_obj_set_size(modifier_widgets.container, 230, 24);  /* Original: 230x24 */
     lv_obj_set_pos(modifier_widgets.container, 25, 8);     /* Original: x=25, y=8 */
@@ -297,14 +413,15 @@ static void create_modifier_indicator(lv_obj_t *parent) {
         modifier_widgets.labels[i] = lv_label_create(modifier_widgets.container);
         lv_label_set_text(modifier_widgets.labels[i], modifier_texts[i]);
         lv_obj_set_style_text_font(modifier_widgets.labels[i], &FG_Medium_20, LV_PART_MAIN);
-        lv_obj_set_style_text_color(modifier_widgets.labels[i],
-                                    lv_color_hex(p->mod_inactive), LV_PART_MAIN);
+        lv_obj_add_style(modifier_widgets.labels[i], &styles.mod, LV_PART_MAIN);
+        lv_obj_add_style(modifier_widgets.labels[i], &styles.mod_active,
+                         LV_PART_MAIN | LV_STATE_CHECKED);
 
         /* Add separator after each except last */
         if (i < 3) {
             lv_obj_t *sep = lv_obj_create(modifier_widgets.container);
             lv_obj_set_size(sep, 2, 24);
-            lv_obj_set_style_bg_color(sep, lv_color_hex(p->mod_separator), LV_PART_MAIN);
+            lv_obj_add_style(sep, &styles.mod_separator, LV_PART_MAIN);
             lv_obj_set_style_bg_opa(sep, LV_OPA_COVER, LV_PART_MAIN);
             lv_obj_set_style_border_width(sep, 0, LV_PART_MAIN);
             lv_obj_set_style_radius(sep, 0, LV_PART_MAIN);
@@ -315,8 +432,6 @@ static void create_modifier_indicator(lv_obj_t *parent) {
 }
 
 static void update_modifier_indicator(uint8_t modifier_flags) {
-    const operator_color_palette_t *p = &color_palettes[current_palette];
-
     bool mods[4] = {
         (modifier_flags & 0x11) != 0,  /* CTRL (bit 0 or 4) */
         (modifier_flags & 0x44) != 0,  /* ALT (bit 2 or 6) */
@@ -325,9 +440,7 @@ static void update_modifier_indicator(uint8_t modifier_flags) {
     };
 
     for (int i = 0; i < 4; i++) {
-        lv_color_t color = mods[i] ? lv_color_hex(p->mod_active)
-                                   : lv_color_hex(p->mod_inactive);
-        lv_obj_set_style_text_color(modifier_widgets.labels[i], color, LV_PART_MAIN);
+        lv_obj_set_state(modifier_widgets.labels[i], LV_STATE_CHECKED, mods[i]);
     }
 }
 
@@ -352,8 +465,9 @@ static void create_wpm_meter(lv_obj_t *parent) {
         wpm_widgets.bars[i] = lv_obj_create(wpm_widgets.container);
         lv_obj_set_size(wpm_widgets.bars[i], bar_width, bar_height);
         lv_obj_set_pos(wpm_widgets.bars[i], start_x + i * (bar_width + bar_gap), 0);
-        lv_obj_set_style_bg_color(wpm_widgets.bars[i],
-                                  lv_color_hex(DISPLAY_COLOR_WPM_BAR_INACTIVE), LV_PART_MAIN);
+        lv_obj_add_style(wpm_widgets.bars[i], &styles.wpm_bar, LV_PART_MAIN);
+        lv_obj_add_style(wpm_widgets.bars[i], &styles.wpm_bar_active,
+                         LV_PART_MAIN | LV_STATE_CHECKED);
         lv_obj_set_style_bg_opa(wpm_widgets.bars[i], LV_OPA_COVER, LV_PART_MAIN);
         lv_obj_set_style_border_width(wpm_widgets.bars[i], 0, LV_PART_MAIN);
         lv_obj_set_style_radius(wpm_widgets.bars[i], 1, LV_PART_MAIN);
@@ -370,11 +484,15 @@ static void create_wpm_meter(lv_obj_t *parent) {
     lv_obj_add_flag(wpm_widgets.peak_indicator, LV_OBJ_FLAG_HIDDEN);
 
     /* WPM label */
+#if IS_ENABLED(CONFIG_PROSPECTOR_DIGIT_ATLAS)
+    wpm_widgets.wpm_label = digit_label_create(wpm_widgets.container, &digit_atlas_FR_Medium_32);
+    digit_label_set_text(wpm_widgets.wpm_label, "0");
+#else
     wpm_widgets.wpm_label = lv_label_create(wpm_widgets.container);
     lv_label_set_text(wpm_widgets.wpm_label, "0");
     lv_obj_set_style_text_font(wpm_widgets.wpm_label, &FR_Medium_32, LV_PART_MAIN);
-    lv_obj_set_style_text_color(wpm_widgets.wpm_label,
-                                lv_color_hex(DISPLAY_COLOR_WPM_TEXT), LV_PART_MAIN);
+#endif
+    lv_obj_add_style(wpm_widgets.wpm_label, &styles.wpm_text, LV_PART_MAIN);
     lv_obj_set_style_bg_color(wpm_widgets.wpm_label, lv_color_hex(0x000000), LV_PART_MAIN);
     lv_obj_set_style_bg_opa(wpm_widgets.wpm_label, LV_OPA_COVER, LV_PART_MAIN);
     lv_obj_set_style_pad_hor(wpm_widgets.wpm_label, 6, LV_PART_MAIN);
@@ -385,8 +503,7 @@ static void create_wpm_meter(lv_obj_t *parent) {
     wpm_widgets.layer_label = lv_label_create(wpm_widgets.container);
     lv_label_set_text(wpm_widgets.layer_label, "");
     lv_obj_set_style_text_font(wpm_widgets.layer_label, &DINishExpanded_Light_36, LV_PART_MAIN);
-    lv_obj_set_style_text_color(wpm_widgets.layer_label,
-                                lv_color_hex(DISPLAY_COLOR_LAYER_TEXT), LV_PART_MAIN);
+    lv_obj_add_style(wpm_widgets.layer_label, &styles.layer_text, LV_PART_MAIN);
     lv_obj_set_style_bg_color(wpm_widgets.layer_label, lv_color_hex(0x000000), LV_PART_MAIN);
     lv_obj_set_style_bg_opa(wpm_widgets.layer_label, LV_OPA_COVER, LV_PART_MAIN);
     lv_obj_set_style_pad_hor(wpm_widgets.layer_label, 8, LV_PART_MAIN);
@@ -396,22 +513,21 @@ static void create_wpm_meter(lv_obj_t *parent) {
 }
 
 static void update_wpm_meter(uint8_t wpm, const char *layer_name) {
-    const operator_color_palette_t *p = &color_palettes[current_palette];
-
     /* Update WPM bars */
     int active_bars = (wpm * WPM_BAR_COUNT) / WPM_MAX;
     if (active_bars > WPM_BAR_COUNT) active_bars = WPM_BAR_COUNT;
 
     for (int i = 0; i < WPM_BAR_COUNT; i++) {
-        lv_color_t color = (i < active_bars)
-            ? lv_color_hex(p->wpm_bar_active)
-            : lv_color_hex(p->wpm_bar_inactive);
-        lv_obj_set_style_bg_color(wpm_widgets.bars[i], color, LV_PART_MAIN);
+        lv_obj_set_state(wpm_widgets.bars[i], LV_STATE_CHECKED, i < active_bars);
     }
 
     /* Update WPM label */
     snprintf(op_stbuf_wpm, sizeof(op_stbuf_wpm), "%d", wpm);
+#if IS_ENABLED(CONFIG_PROSPECTOR_DIGIT_ATLAS)
+    digit_label_set_text(wpm_widgets.wpm_label, op_stbuf_wpm);
+#else
     lv_label_set_text_static(wpm_widgets.wpm_label, op_stbuf_wpm);
+#endif
 
     /* Update layer label */
     if (layer_name && layer_name[0]) {
@@ -437,8 +553,9 @@ static void create_layer_display(lv_obj_t *parent) {
     layer_widgets.dot_count = 0;  /* Will be set in update */
     for (int i = 0; i < LAYER_DOT_MAX; i++) {
         layer_widgets.dots[i] = lv_obj_create(layer_widgets.container);
-        lv_obj_set_style_bg_color(layer_widgets.dots[i],
-                                  lv_color_hex(DISPLAY_COLOR_LAYER_DOT_INACTIVE), LV_PART_MAIN);
+        lv_obj_add_style(layer_widgets.dots[i], &styles.layer_dot, LV_PART_MAIN);
+        lv_obj_add_style(layer_widgets.dots[i], &styles.layer_dot_active,
+                         LV_PART_MAIN | LV_STATE_CHECKED);
         lv_obj_set_style_bg_opa(layer_widgets.dots[i], LV_OPA_COVER, LV_PART_MAIN);
         lv_obj_set_style_border_width(layer_widgets.dots[i], 0, LV_PART_MAIN);
         lv_obj_set_style_radius(layer_widgets.dots[i], 2, LV_PART_MAIN);
@@ -472,44 +589,27 @@ static void update_layer_display(uint8_t active_layer) {
     }
 
     /* Update colors */
-    const operator_color_palette_t *p = &color_palettes[current_palette];
     for (int i = 0; i < layer_widgets.dot_count; i++) {
-        lv_color_t color = (i == active_layer)
-            ? lv_color_hex(p->layer_dot_active)
-            : lv_color_hex(p->layer_dot_inactive);
-        lv_obj_set_style_bg_color(layer_widgets.dots[i], color, LV_PART_MAIN);
+        lv_obj_set_state(layer_widgets.dots[i], LV_STATE_CHECKED, i == active_layer);
     }
 }
 
 /* ========== Battery Circles ========== */
 
-static void create_battery_arc(lv_obj_t *parent, lv_obj_t **arc, lv_obj_t **label_box,
-                               lv_obj_t **label, lv_obj_t **battery_label,
-                               int x_pos, const char *title) {
-    int arc_size = 58;
-    int arc_left = 60;
-
-    /* Arc */
-    *arc = lv_arc_create(parent);
-    lv_obj_set_size(*arc, arc_size, arc_size);
-    lv_obj_set_pos(*arc, x_pos, 2);
-    lv_arc_set_range(*arc, 0, 100);
-    lv_arc_set_value(*arc, 0);
-    lv_arc_set_bg_angles(*arc, 0, 360);
-    lv_arc_set_rotation(*arc, 270);
-    lv_obj_set_style_arc_width(*arc, ARC_WIDTH_DISCONNECTED, LV_PART_MAIN);
-    lv_obj_set_style_arc_width(*arc, ARC_WIDTH_DISCONNECTED, LV_PART_INDICATOR);
-    lv_obj_set_style_arc_color(*arc, lv_color_hex(DISPLAY_COLOR_BATTERY_DISCONNECTED_RING), LV_PART_MAIN);
-    lv_obj_set_style_arc_color(*arc, lv_color_hex(DISPLAY_COLOR_BATTERY_DISCONNECTED_FILL), LV_PART_INDICATOR);
-    lv_obj_remove_style(*arc, NULL, LV_PART_KNOB);
-    lv_obj_clear_flag(*arc, LV_OBJ_FLAG_CLICKABLE);
-
-    /* Label box inside arc - not used for 2-peripheral layout */
-    (void)label_box;
-    (void)label;
-    (void)battery_label;
-    (void)title;
-    (void)arc_left;
+/* Ring gauge (270 degrees from 12 o'clock) holding the level box */
+static lv_obj_t *create_battery_ring(lv_obj_t *parent, int size, int x, int y) {
+    lv_obj_t *ring = ring_gauge_create(parent);
+    lv_obj_set_size(ring, size, size);
+    lv_obj_set_pos(ring, x, y);
+    ring_gauge_set_span(ring, 270, 270);
+    lv_obj_set_style_arc_width(ring, ARC_WIDTH_DISCONNECTED, LV_PART_MAIN);
+    lv_obj_set_style_arc_width(ring, ARC_WIDTH_DISCONNECTED, LV_PART_INDICATOR);
+    lv_obj_set_style_arc_rounded(ring, true, LV_PART_MAIN);
+    lv_obj_set_style_arc_rounded(ring, true, LV_PART_INDICATOR);
+    lv_obj_set_style_arc_color(ring, lv_color_hex(DISPLAY_COLOR_BATTERY_DISCONNECTED_RING), LV_PART_MAIN);
+    lv_obj_set_style_arc_color(ring, lv_color_hex(DISPLAY_COLOR_BATTERY_DISCONNECTED_FILL), LV_PART_INDICATOR);
+    add_battery_styles(ring, LV_PART_MAIN, LV_PART_INDICATOR);
+    return ring;
 }
 
 static void create_battery_circles(lv_obj_t *parent) {
@@ -526,21 +626,8 @@ static void create_battery_circles(lv_obj_t *parent) {
     int spacing = 66;
 
     /* Central (left arc) */
-    battery_widgets.central_arc = lv_arc_create(battery_widgets.container);
-    lv_obj_set_size(battery_widgets.central_arc, arc_size, arc_size);
-    lv_obj_set_pos(battery_widgets.central_arc, 0, y_center);
-    lv_arc_set_range(battery_widgets.central_arc, 0, 100);
-    lv_arc_set_value(battery_widgets.central_arc, 0);
-    lv_arc_set_bg_angles(battery_widgets.central_arc, 270, 180);
-    lv_arc_set_rotation(battery_widgets.central_arc, 0);
-    lv_obj_set_style_arc_width(battery_widgets.central_arc, ARC_WIDTH_DISCONNECTED, LV_PART_MAIN);
-    lv_obj_set_style_arc_width(battery_widgets.central_arc, ARC_WIDTH_DISCONNECTED, LV_PART_INDICATOR);
-    lv_obj_set_style_arc_color(battery_widgets.central_arc,
-                               lv_color_hex(DISPLAY_COLOR_BATTERY_DISCONNECTED_RING), LV_PART_MAIN);
-    lv_obj_set_style_arc_color(battery_widgets.central_arc,
-                               lv_color_hex(DISPLAY_COLOR_BATTERY_DISCONNECTED_FILL), LV_PART_INDICATOR);
-    lv_obj_remove_style(battery_widgets.central_arc, NULL, LV_PART_KNOB);
-    lv_obj_clear_flag(battery_widgets.central_arc, LV_OBJ_FLAG_CLICKABLE);
+    battery_widgets.central_arc = create_battery_ring(battery_widgets.container, arc_size,
+                                                      0, y_center);
 
     /* Central label box */
     battery_widgets.central_label_box = lv_obj_create(battery_widgets.central_arc);
@@ -552,6 +639,7 @@ static void create_battery_circles(lv_obj_t *parent) {
     lv_obj_set_style_radius(battery_widgets.central_label_box, 2, LV_PART_MAIN);
     lv_obj_set_style_border_width(battery_widgets.central_label_box, 0, LV_PART_MAIN);
     lv_obj_set_style_pad_all(battery_widgets.central_label_box, 0, LV_PART_MAIN);
+    add_battery_styles(battery_widgets.central_label_box, 0, LV_PART_MAIN);
 
     battery_widgets.central_label = lv_label_create(battery_widgets.central_label_box);
     lv_label_set_text(battery_widgets.central_label, "-");
@@ -562,21 +650,8 @@ static void create_battery_circles(lv_obj_t *parent) {
     lv_obj_align(battery_widgets.central_label, LV_ALIGN_CENTER, 0, 0);
 
     /* Peripheral (right arc) */
-    battery_widgets.peripheral_arc = lv_arc_create(battery_widgets.container);
-    lv_obj_set_size(battery_widgets.peripheral_arc, arc_size, arc_size);
-    lv_obj_set_pos(battery_widgets.peripheral_arc, spacing, y_center);
-    lv_arc_set_range(battery_widgets.peripheral_arc, 0, 100);
-    lv_arc_set_value(battery_widgets.peripheral_arc, 0);
-    lv_arc_set_bg_angles(battery_widgets.peripheral_arc, 270, 180);
-    lv_arc_set_rotation(battery_widgets.peripheral_arc, 0);
-    lv_obj_set_style_arc_width(battery_widgets.peripheral_arc, ARC_WIDTH_DISCONNECTED, LV_PART_MAIN);
-    lv_obj_set_style_arc_width(battery_widgets.peripheral_arc, ARC_WIDTH_DISCONNECTED, LV_PART_INDICATOR);
-    lv_obj_set_style_arc_color(battery_widgets.peripheral_arc,
-                               lv_color_hex(DISPLAY_COLOR_BATTERY_DISCONNECTED_RING), LV_PART_MAIN);
-    lv_obj_set_style_arc_color(battery_widgets.peripheral_arc,
-                               lv_color_hex(DISPLAY_COLOR_BATTERY_DISCONNECTED_FILL), LV_PART_INDICATOR);
-    lv_obj_remove_style(battery_widgets.peripheral_arc, NULL, LV_PART_KNOB);
-    lv_obj_clear_flag(battery_widgets.peripheral_arc, LV_OBJ_FLAG_CLICKABLE);
+    battery_widgets.peripheral_arc = create_battery_ring(battery_widgets.container, arc_size,
+                                                         spacing, y_center);
 
     /* Peripheral label box */
     battery_widgets.peripheral_label_box = lv_obj_create(battery_widgets.peripheral_arc);
@@ -588,6 +663,7 @@ static void create_battery_circles(lv_obj_t *parent) {
     lv_obj_set_style_radius(battery_widgets.peripheral_label_box, 2, LV_PART_MAIN);
     lv_obj_set_style_border_width(battery_widgets.peripheral_label_box, 0, LV_PART_MAIN);
     lv_obj_set_style_pad_all(battery_widgets.peripheral_label_box, 0, LV_PART_MAIN);
+    add_battery_styles(battery_widgets.peripheral_label_box, 0, LV_PART_MAIN);
 
     battery_widgets.peripheral_label = lv_label_create(battery_widgets.peripheral_label_box);
     lv_label_set_text(battery_widgets.peripheral_label, "-");
@@ -601,33 +677,19 @@ static void create_battery_circles(lv_obj_t *parent) {
 static void update_battery_arc(lv_obj_t *arc, lv_obj_t *label_box, lv_obj_t *label,
                                char *text_buf, size_t text_buf_size,
                                uint8_t level, bool connected) {
-    const operator_color_palette_t *p = &color_palettes[current_palette];
     bool low_battery = connected && level > 0 && level <= LOW_BATTERY_THRESHOLD;
 
-    /* Update arc colors */
-    uint32_t ring_color, fill_color;
-    if (low_battery) {
-        ring_color = p->battery_low_ring;
-        fill_color = p->battery_low_fill;
-    } else if (connected) {
-        ring_color = p->battery_ring;
-        fill_color = p->battery_fill;
-    } else {
-        ring_color = DISPLAY_COLOR_BATTERY_DISCONNECTED_RING;
-        fill_color = DISPLAY_COLOR_BATTERY_DISCONNECTED_FILL;
-    }
+    /* Update arc and label box colors */
+    set_battery_state(arc, connected, low_battery);
+    set_battery_state(label_box, connected, low_battery);
 
-    lv_obj_set_style_arc_color(arc, lv_color_hex(ring_color), LV_PART_MAIN);
-    lv_obj_set_style_arc_color(arc, lv_color_hex(fill_color), LV_PART_INDICATOR);
-
-    /* Update arc width and value */
+    /* Update arc width (a style change redraws the whole ring) and value */
     int arc_width = connected ? ARC_WIDTH_CONNECTED : ARC_WIDTH_DISCONNECTED;
-    lv_obj_set_style_arc_width(arc, arc_width, LV_PART_MAIN);
-    lv_obj_set_style_arc_width(arc, arc_width, LV_PART_INDICATOR);
-    lv_arc_set_value(arc, connected ? level : 0);
-
-    /* Update label box color */
-    lv_obj_set_style_bg_color(label_box, lv_color_hex(fill_color), LV_PART_MAIN);
+    if (lv_obj_get_style_arc_width(arc, LV_PART_MAIN) != arc_width) {
+        lv_obj_set_style_arc_width(arc, arc_width, LV_PART_MAIN);
+        lv_obj_set_style_arc_width(arc, arc_width, LV_PART_INDICATOR);
+    }
+    ring_gauge_set_value(arc, connected ? level : 0);
 
     /* Update label (use static buffer to avoid LVGL memory churn) */
     if (connected && level > 0) {
@@ -701,6 +763,7 @@ static void create_battery_bars(lv_obj_t *parent, int count) {
         lv_obj_set_style_radius(battery_widgets.bar_label_boxes[i], 2, LV_PART_MAIN);
         lv_obj_set_style_border_width(battery_widgets.bar_label_boxes[i], 0, LV_PART_MAIN);
         lv_obj_set_style_pad_all(battery_widgets.bar_label_boxes[i], 0, LV_PART_MAIN);
+        add_battery_styles(battery_widgets.bar_label_boxes[i], 0, LV_PART_MAIN);
 
         /* Number label inside box */
         battery_widgets.bar_labels[i] = lv_label_create(battery_widgets.bar_label_boxes[i]);
@@ -718,6 +781,7 @@ static void create_battery_bars(lv_obj_t *parent, int count) {
         lv_obj_set_style_text_color(battery_widgets.bar_pct_labels[i],
                                     lv_color_hex(DISPLAY_COLOR_BATTERY_DISCONNECTED_FILL), LV_PART_MAIN);
         lv_obj_set_style_text_align(battery_widgets.bar_pct_labels[i], LV_TEXT_ALIGN_CENTER, LV_PART_MAIN);
+        add_battery_styles(battery_widgets.bar_pct_labels[i], 0, LV_PART_MAIN);
         lv_obj_align_to(battery_widgets.bar_pct_labels[i],
                         battery_widgets.bar_label_boxes[i], LV_ALIGN_OUT_BOTTOM_MID, 0, 3);
 
@@ -735,36 +799,19 @@ static void create_battery_bars(lv_obj_t *parent, int count) {
                                   lv_color_hex(DISPLAY_COLOR_BATTERY_DISCONNECTED_FILL), LV_PART_INDICATOR);
         lv_obj_set_style_bg_opa(battery_widgets.bars[i], LV_OPA_COVER, LV_PART_MAIN);
         lv_obj_set_style_bg_opa(battery_widgets.bars[i], LV_OPA_COVER, LV_PART_INDICATOR);
+        add_battery_styles(battery_widgets.bars[i], LV_PART_MAIN, LV_PART_INDICATOR);
     }
 }
 
 static void update_battery_bar(int index, uint8_t level, bool connected) {
-    const operator_color_palette_t *p = &color_palettes[current_palette];
     bool low_battery = connected && level > 0 && level <= LOW_BATTERY_THRESHOLD;
 
-    uint32_t ring_color, fill_color;
-    if (low_battery) {
-        ring_color = p->battery_low_ring;
-        fill_color = p->battery_low_fill;
-    } else if (connected) {
-        ring_color = p->battery_ring;
-        fill_color = p->battery_fill;
-    } else {
-        ring_color = DISPLAY_COLOR_BATTERY_DISCONNECTED_RING;
-        fill_color = DISPLAY_COLOR_BATTERY_DISCONNECTED_FILL;
-    }
-
-    /* Update bar colors */
-    lv_obj_set_style_bg_color(battery_widgets.bars[index],
-                              lv_color_hex(ring_color), LV_PART_MAIN);
-    lv_obj_set_style_bg_color(battery_widgets.bars[index],
-                              lv_color_hex(fill_color), LV_PART_INDICATOR);
+    /* Update bar, label box and percentage colors */
+    set_battery_state(battery_widgets.bars[index], connected, low_battery);
+    set_battery_state(battery_widgets.bar_label_boxes[index], connected, low_battery);
+    set_battery_state(battery_widgets.bar_pct_labels[index], connected, low_battery);
     lv_bar_set_value(battery_widgets.bars[index], connected ? level : 0, LV_ANIM_ON);
 
-    /* Update label box */
-    lv_obj_set_style_bg_color(battery_widgets.bar_label_boxes[index],
-                              lv_color_hex(fill_color), LV_PART_MAIN);
-
     /* Update number label color */
     uint32_t label_color = connected ? 0x000000 : DISPLAY_COLOR_BATTERY_DISCONNECTED_LABEL;
     lv_obj_set_style_text_color(battery_widgets.bar_labels[index],
@@ -777,8 +824,6 @@ static void update_battery_bar(int index, uint8_t level, bool connected) {
         snprintf(op_stbuf_bat_bar[index], sizeof(op_stbuf_bat_bar[index]), "-");
     }
     lv_label_set_text_static(battery_widgets.bar_pct_labels[index], op_stbuf_bat_bar[index]);
-    lv_obj_set_style_text_color(battery_widgets.bar_pct_labels[index],
-                                lv_color_hex(fill_color), LV_PART_MAIN);
     /* Re-align after text change (text width changes shift position) */
     lv_obj_align_to(battery_widgets.bar_pct_labels[index],
                     battery_widgets.bar_label_boxes[index], LV_ALIGN_OUT_BOTTOM_MID, 0, 3);
@@ -863,7 +908,6 @@ static void ensure_battery_mode(lv_obj_t *parent, int new_count) {
 /* BLE slot animation timer callback - handles both blink and fade */
 static void ble_slot_anim_timer_cb(lv_timer_t *timer) {
     ARG_UNUSED(timer);
-    const operator_color_palette_t *p = &color_palettes[current_palette];
 
     if (ble_anim_state.active_slot >= 5 || !output_widgets.slot_boxes[ble_anim_state.active_slot]) {
         return;
@@ -876,11 +920,7 @@ static void ble_slot_anim_timer_cb(lv_timer_t *timer) {
     case BLE_PROFILE_STATE_UNREGISTERED:
         /* Simple blink: toggle on/off */
         ble_anim_state.blink_phase = !ble_anim_state.blink_phase;
-        if (ble_anim_state.blink_phase) {
-            lv_obj_set_style_bg_color(slot, lv_color_hex(p->slot_active_bg), LV_PART_MAIN);
-        } else {
-            lv_obj_set_style_bg_color(slot, lv_color_hex(p->slot_inactive_bg), LV_PART_MAIN);
-        }
+        lv_obj_set_state(slot, LV_STATE_CHECKED, ble_anim_state.blink_phase);
         break;
 
     case BLE_PROFILE_STATE_REGISTERED:
@@ -902,7 +942,7 @@ static void ble_slot_anim_timer_cb(lv_timer_t *timer) {
                 ble_anim_state.fade_direction = true;
             }
         }
-        lv_obj_set_style_bg_color(slot, lv_color_hex(p->slot_active_bg), LV_PART_MAIN);
+        lv_obj_add_state(slot, LV_STATE_CHECKED);
         lv_obj_set_style_bg_opa(slot, ble_anim_state.fade_value, LV_PART_MAIN);
         lv_obj_set_style_text_opa(label, ble_anim_state.fade_value, LV_PART_MAIN);
         break;
@@ -948,9 +988,7 @@ static void update_ble_slot_animation(uint8_t ble_profile, ble_profile_state_t n
 
     /* Set initial state for connected (solid) */
     if (new_state == BLE_PROFILE_STATE_CONNECTED && ble_profile < 5) {
-        const operator_color_palette_t *p = &color_palettes[current_palette];
-        lv_obj_set_style_bg_color(output_widgets.slot_boxes[ble_profile],
-                                  lv_color_hex(p->slot_active_bg), LV_PART_MAIN);
+        lv_obj_add_state(output_widgets.slot_boxes[ble_profile], LV_STATE_CHECKED);
         lv_obj_set_style_bg_opa(output_widgets.slot_boxes[ble_profile], LV_OPA_COVER, LV_PART_MAIN);
         lv_obj_set_style_text_opa(output_widgets.slot_labels[ble_profile], LV_OPA_COVER, LV_PART_MAIN);
     }
@@ -968,18 +1006,14 @@ static void create_output_indicator(lv_obj_t *parent) {
     output_widgets.usb_box = lv_obj_create(output_widgets.container);
     lv_obj_set_size(output_widgets.usb_box, 56, 29);
     lv_obj_set_pos(output_widgets.usb_box, 0, 0);
-    lv_obj_set_style_bg_opa(output_widgets.usb_box, LV_OPA_TRANSP, LV_PART_MAIN);
-    lv_obj_set_style_border_width(output_widgets.usb_box, 2, LV_PART_MAIN);
-    lv_obj_set_style_border_color(output_widgets.usb_box,
-                                  lv_color_hex(DISPLAY_COLOR_USB_INACTIVE_BG), LV_PART_MAIN);
+    lv_obj_add_style(output_widgets.usb_box, &styles.usb, LV_PART_MAIN);
+    lv_obj_add_style(output_widgets.usb_box, &styles.usb_active, LV_PART_MAIN | LV_STATE_CHECKED);
     lv_obj_set_style_radius(output_widgets.usb_box, 6, LV_PART_MAIN);
     lv_obj_set_style_pad_all(output_widgets.usb_box, 0, LV_PART_MAIN);
 
     output_widgets.usb_label = lv_label_create(output_widgets.usb_box);
     lv_label_set_text(output_widgets.usb_label, "USB");
     lv_obj_set_style_text_font(output_widgets.usb_label, &FG_Medium_20, LV_PART_MAIN);
-    lv_obj_set_style_text_color(output_widgets.usb_label,
-                                lv_color_hex(DISPLAY_COLOR_USB_INACTIVE_BG), LV_PART_MAIN);
     lv_obj_center(output_widgets.usb_label);
     lv_obj_set_style_translate_y(output_widgets.usb_label, 1, LV_PART_MAIN);
 
@@ -987,18 +1021,14 @@ static void create_output_indicator(lv_obj_t *parent) {
     output_widgets.ble_box = lv_obj_create(output_widgets.container);
     lv_obj_set_size(output_widgets.ble_box, 56, 29);
     lv_obj_set_pos(output_widgets.ble_box, 58, 0);
-    lv_obj_set_style_bg_opa(output_widgets.ble_box, LV_OPA_TRANSP, LV_PART_MAIN);
-    lv_obj_set_style_border_width(output_widgets.ble_box, 2, LV_PART_MAIN);
-    lv_obj_set_style_border_color(output_widgets.ble_box,
-                                  lv_color_hex(DISPLAY_COLOR_BLE_INACTIVE_BG), LV_PART_MAIN);
+    lv_obj_add_style(output_widgets.ble_box, &styles.ble, LV_PART_MAIN);
+    lv_obj_add_style(output_widgets.ble_box, &styles.ble_active, LV_PART_MAIN | LV_STATE_CHECKED);
     lv_obj_set_style_radius(output_widgets.ble_box, 6, LV_PART_MAIN);
     lv_obj_set_style_pad_all(output_widgets.ble_box, 0, LV_PART_MAIN);
 
     output_widgets.ble_label = lv_label_create(output_widgets.ble_box);
     lv_label_set_text(output_widgets.ble_label, "BLE");
     lv_obj_set_style_text_font(output_widgets.ble_label, &FG_Medium_20, LV_PART_MAIN);
-    lv_obj_set_style_text_color(output_widgets.ble_label,
-                                lv_color_hex(DISPLAY_COLOR_BLE_INACTIVE_BG), LV_PART_MAIN);
     lv_obj_center(output_widgets.ble_label);
     lv_obj_set_style_translate_y(output_widgets.ble_label, 1, LV_PART_MAIN);
 
@@ -1011,8 +1041,9 @@ static void create_output_indicator(lv_obj_t *parent) {
         output_widgets.slot_boxes[i] = lv_obj_create(output_widgets.container);
         lv_obj_set_size(output_widgets.slot_boxes[i], slot_width, 29);
         lv_obj_set_pos(output_widgets.slot_boxes[i], i * (slot_width + slot_spacing), slot_y);
-        lv_obj_set_style_bg_color(output_widgets.slot_boxes[i],
-                                  lv_color_hex(DISPLAY_COLOR_SLOT_INACTIVE_BG), LV_PART_MAIN);
+        lv_obj_add_style(output_widgets.slot_boxes[i], &styles.slot, LV_PART_MAIN);
+        lv_obj_add_style(output_widgets.slot_boxes[i], &styles.slot_active,
+                         LV_PART_MAIN | LV_STATE_CHECKED);
         lv_obj_set_style_bg_opa(output_widgets.slot_boxes[i], LV_OPA_COVER, LV_PART_MAIN);
         lv_obj_set_style_radius(output_widgets.slot_boxes[i], 6, LV_PART_MAIN);
         lv_obj_set_style_border_width(output_widgets.slot_boxes[i], 0, LV_PART_MAIN);
@@ -1032,42 +1063,10 @@ static void create_output_indicator(lv_obj_t *parent) {
 
 static void update_output_indicator(bool usb_connected, uint8_t ble_profile,
                                     bool ble_connected, bool ble_bonded) {
-    const operator_color_palette_t *p = &color_palettes[current_palette];
-
-    /* Update USB box - active: solid bg, inactive: border only */
-    if (usb_connected) {
-        lv_obj_set_style_bg_color(output_widgets.usb_box,
-                                  lv_color_hex(p->usb_active_bg), LV_PART_MAIN);
-        lv_obj_set_style_bg_opa(output_widgets.usb_box, LV_OPA_COVER, LV_PART_MAIN);
-        lv_obj_set_style_border_width(output_widgets.usb_box, 0, LV_PART_MAIN);
-        lv_obj_set_style_text_color(output_widgets.usb_label,
-                                    lv_color_hex(p->output_active_text), LV_PART_MAIN);
-    } else {
-        lv_obj_set_style_bg_opa(output_widgets.usb_box, LV_OPA_TRANSP, LV_PART_MAIN);
-        lv_obj_set_style_border_width(output_widgets.usb_box, 2, LV_PART_MAIN);
-        lv_obj_set_style_border_color(output_widgets.usb_box,
-                                      lv_color_hex(p->usb_inactive_bg), LV_PART_MAIN);
-        lv_obj_set_style_text_color(output_widgets.usb_label,
-                                    lv_color_hex(p->usb_inactive_bg), LV_PART_MAIN);
-    }
-
-    /* Update BLE box - active: solid bg, inactive: border only */
+    /* Update USB/BLE boxes - active: solid bg, inactive: border only */
     bool ble_active = !usb_connected && ble_profile < 5;
-    if (ble_active) {
-        lv_obj_set_style_bg_color(output_widgets.ble_box,
-                                  lv_color_hex(p->ble_active_bg), LV_PART_MAIN);
-        lv_obj_set_style_bg_opa(output_widgets.ble_box, LV_OPA_COVER, LV_PART_MAIN);
-        lv_obj_set_style_border_width(output_widgets.ble_box, 0, LV_PART_MAIN);
-        lv_obj_set_style_text_color(output_widgets.ble_label,
-                                    lv_color_hex(p->output_active_text), LV_PART_MAIN);
-    } else {
-        lv_obj_set_style_bg_opa(output_widgets.ble_box, LV_OPA_TRANSP, LV_PART_MAIN);
-        lv_obj_set_style_border_width(output_widgets.ble_box, 2, LV_PART_MAIN);
-        lv_obj_set_style_border_color(output_widgets.ble_box,
-                                      lv_color_hex(p->ble_inactive_bg), LV_PART_MAIN);
-        lv_obj_set_style_text_color(output_widgets.ble_label,
-                                    lv_color_hex(p->ble_inactive_bg), LV_PART_MAIN);
-    }
+    lv_obj_set_state(output_widgets.usb_box, LV_STATE_CHECKED, usb_connected);
+    lv_obj_set_state(output_widgets.ble_box, LV_STATE_CHECKED, ble_active);
 
     /* Determine BLE profile connection state */
     ble_profile_state_t profile_state;
@@ -1084,8 +1083,7 @@ static void update_output_indicator(bool usb_connected, uint8_t ble_profile,
         bool is_active = (i == ble_profile) && ble_active;
         if (!is_active) {
             /* Non-active slots: static inactive appearance */
-            lv_obj_set_style_bg_color(output_widgets.slot_boxes[i],
-                                      lv_color_hex(p->slot_inactive_bg), LV_PART_MAIN);
+            lv_obj_remove_state(output_widgets.slot_boxes[i], LV_STATE_CHECKED);
             lv_obj_set_style_bg_opa(output_widgets.slot_boxes[i], LV_OPA_COVER, LV_PART_MAIN);
             lv_obj_set_style_text_opa(output_widgets.slot_labels[i], LV_OPA_COVER, LV_PART_MAIN);
         }
@@ -1120,6 +1118,8 @@ lv_obj_t *operator_layout_create(lv_obj_t *parent) {
     ble_anim_state.fade_direction = false;
     ble_anim_state.blink_phase = true;
 
+    styles_set_palette(&color_palettes[current_palette]);
+
     layout_container = lv_obj_create(parent);
     lv_obj_set_size(layout_container, 280, 240);  /* Software is landscape, mdac rotates to portrait */
     lv_obj_set_pos(layout_container, 0, 0);
@@ -1225,7 +1225,7 @@ void operator_layout_update(uint8_t active_layer, const char *layer_name,
 
     cached_state.initialized = true;
 
-    /* Note: individual LVGL update functions (lv_label_set_text_static, lv_arc_set_value, etc.)
+    /* Note: individual LVGL update functions (lv_label_set_text_static, ring_gauge_set_value, etc.)
      * already invalidate their own areas when state changes. No blanket invalidation needed.
      * Removing unconditional lv_obj_invalidate() reduces unnecessary full-screen redraws. */
 }
@@ -1276,133 +1276,10 @@ static void apply_palette(void) {
 
     const operator_color_palette_t *p = &color_palettes[current_palette];
 
-    /* Update modifier labels */
-    for (int i = 0; i < 4; i++) {
-        if (modifier_widgets.labels[i]) {
-            lv_obj_set_style_text_color(modifier_widgets.labels[i],
-                                        lv_color_hex(p->mod_inactive), LV_PART_MAIN);
-        }
-    }
-
-    /* Update separators */
-    for (int i = 0; i < 3; i++) {
-        if (mod_separators[i]) {
-            lv_obj_set_style_bg_color(mod_separators[i],
-                                      lv_color_hex(p->mod_separator), LV_PART_MAIN);
-        }
-    }
-
-    /* Update WPM bars (set to inactive color, will be updated properly on next data) */
-    for (int i = 0; i < WPM_BAR_COUNT; i++) {
-        if (wpm_widgets.bars[i]) {
-            lv_obj_set_style_bg_color(wpm_widgets.bars[i],
-                                      lv_color_hex(p->wpm_bar_inactive), LV_PART_MAIN);
-        }
-    }
-
-    /* Update WPM label color */
-    if (wpm_widgets.wpm_label) {
-        lv_obj_set_style_text_color(wpm_widgets.wpm_label,
-                                    lv_color_hex(p->wpm_text), LV_PART_MAIN);
-    }
-
-    /* Update layer label color */
-    if (wpm_widgets.layer_label) {
-        lv_obj_set_style_text_color(wpm_widgets.layer_label,
-                                    lv_color_hex(p->layer_text), LV_PART_MAIN);
-    }
-
-    /* Update layer dots (set to inactive, will be updated on next data) */
-    for (int i = 0; i < LAYER_DOT_MAX; i++) {
-        if (layer_widgets.dots[i]) {
-            lv_obj_set_style_bg_color(layer_widgets.dots[i],
-                                      lv_color_hex(p->layer_dot_inactive), LV_PART_MAIN);
-        }
-    }
-
-    /* Update USB/BLE boxes */
-    if (output_widgets.usb_box) {
-        lv_obj_set_style_bg_color(output_widgets.usb_box,
-                                  lv_color_hex(p->usb_inactive_bg), LV_PART_MAIN);
-        lv_obj_set_style_text_color(output_widgets.usb_label,
-                                    lv_color_hex(p->output_inactive_text), LV_PART_MAIN);
-    }
-
-    if (output_widgets.ble_box) {
-        lv_obj_set_style_bg_color(output_widgets.ble_box,
-                                  lv_color_hex(p->ble_inactive_bg), LV_PART_MAIN);
-        lv_obj_set_style_text_color(output_widgets.ble_label,
-                                    lv_color_hex(p->output_inactive_text), LV_PART_MAIN);
-    }
-
-    /* Update slot boxes */
-    for (int i = 0; i < 5; i++) {
-        if (output_widgets.slot_boxes[i]) {
-            lv_obj_set_style_bg_color(output_widgets.slot_boxes[i],
-                                      lv_color_hex(p->slot_inactive_bg), LV_PART_MAIN);
-        }
-    }
-
-    /* Save current state before invalidating */
-    uint8_t saved_active_layer = cached_state.active_layer;
-    uint8_t saved_wpm = cached_state.wpm;
-    uint8_t saved_modifier_flags = cached_state.modifier_flags;
-    uint8_t saved_battery_level = cached_state.battery_level;
-    bool saved_battery_connected = cached_state.battery_connected;
-    uint8_t saved_peripheral_battery[OPERATOR_MAX_PERIPHERALS];
-    bool saved_peripheral_connected[OPERATOR_MAX_PERIPHERALS];
-    memcpy(saved_peripheral_battery, cached_state.peripheral_battery,
-           sizeof(saved_peripheral_battery));
-    memcpy(saved_peripheral_connected, cached_state.peripheral_connected,
-           sizeof(saved_peripheral_connected));
-    bool saved_usb_connected = cached_state.usb_connected;
-    uint8_t saved_ble_profile = cached_state.ble_profile;
-    bool saved_ble_connected = cached_state.ble_connected;
-    bool saved_ble_bonded = cached_state.ble_bonded;
-    char saved_layer_name[8];
-    strncpy(saved_layer_name, cached_state.layer_name, sizeof(saved_layer_name));
-
-    /* Force cache invalidation */
-    cached_state.initialized = false;
-
-    /* Reset BLE animation state to force re-application */
-    if (ble_anim_state.anim_timer != NULL) {
-        lv_timer_del(ble_anim_state.anim_timer);
-        ble_anim_state.anim_timer = NULL;
-    }
-    ble_anim_state.current_state = BLE_PROFILE_STATE_CONNECTED;  /* Force state change detection */
-    ble_anim_state.active_slot = 255;  /* Invalid slot to force update */
-
-    /* Re-apply current state with new colors */
-    update_modifier_indicator(saved_modifier_flags);
-    update_wpm_meter(saved_wpm, saved_layer_name);
-    update_layer_display(saved_active_layer);
-    if (battery_widgets.mode == BATTERY_MODE_BARS) {
-        update_battery_bars(saved_battery_level, saved_battery_connected,
-                           saved_peripheral_battery, saved_peripheral_connected);
-    } else {
-        update_battery_circles(saved_battery_level, saved_battery_connected,
-                              saved_peripheral_battery[0], saved_peripheral_connected[0]);
-    }
-    update_output_indicator(saved_usb_connected, saved_ble_profile,
-                           saved_ble_connected, saved_ble_bonded);
-
-    /* Restore cache so we don't double-update on next data */
-    cached_state.active_layer = saved_active_layer;
-    cached_state.wpm = saved_wpm;
-    cached_state.modifier_flags = saved_modifier_flags;
-    cached_state.battery_level = saved_battery_level;
-    cached_state.battery_connected = saved_battery_connected;
-    memcpy(cached_state.peripheral_battery, saved_peripheral_battery,
-           sizeof(cached_state.peripheral_battery));
-    memcpy(cached_state.peripheral_connected, saved_peripheral_connected,
-           sizeof(cached_state.peripheral_connected));
-    cached_state.usb_connected = saved_usb_connected;
-    cached_state.ble_profile = saved_ble_profile;
-    cached_state.ble_connected = saved_ble_connected;
-    cached_state.ble_bonded = saved_ble_bonded;
-    strncpy(cached_state.layer_name, saved_layer_name, sizeof(cached_state.layer_name));
-    cached_state.initialized = true;
+    /* Widgets keep their states; refreshing the container's styles
+     * recolors and redraws it and all its children */
+    styles_set_palette(p);
+    lv_obj_refresh_style(layout_container, LV_PART_ANY, LV_STYLE_PROP_ANY);
 
     LOG_INF("Applied palette: %s", p->name);
 }
@@ -0,0 +1,270 @@
+/*
+ * Copyright (c) 2024 The ZMK Contributors
+ *
+ * SPDX-License-Identifier: MIT
+ */
+
+#include <zephyr/kernel.h>
+#include <zephyr/logging/log.h>
+#include <stdio.h>
+#include <string.h>
+#include <lvgl.h>
+
+#include <zmk/status_scanner.h>
+
+#include "perf_panel.h"
+#include "scanner_stub.h"
+#if IS_ENABLED(CONFIG_PROSPECTOR_LVGL_HEAP_STATS)
+#include "lvgl_heap_stats.h"
+#endif
+#if IS_ENABLED(CONFIG_PROSPECTOR_THREAD_MONITOR)
+#include "thread_monitor.h"
+#endif
+#if IS_ENABLED(CONFIG_PROSPECTOR_FONT_EXT_FLASH)
+#include "font_storage.h"
+#endif
+
+LOG_MODULE_DECLARE(zmk, CONFIG_ZMK_LOG_LEVEL);
+
+#define SAMPLE_MS 1000
+
+/* Running totals; each sample shows the difference to the previous one */
+struct perf_totals {
+    uint32_t time_ms;
+    uint32_t reports;
+    struct scanner_pipeline_counts pipe;
+    uint32_t spi_bytes;
+#if IS_ENABLED(CONFIG_SCHED_THREAD_USAGE_ALL)
+    uint64_t cpu_cycles;
+    uint64_t idle_cycles;
+#endif
+};
+
+static lv_obj_t *panel;
+static lv_obj_t *panel_label;
+static lv_timer_t *sample_timer;
+static struct perf_totals last;
+
+/* Frames are counted from the display events, LVGL thread only */
+static uint32_t frame_start_cyc;
+static bool frame_rendering;
+static uint32_t frames;
+static uint32_t frame_us_sum;
+static uint32_t frame_us_max;
+static uint32_t flush_bytes;  /* Pixel data handed to the display driver */
+
+/* ========== Display Events ========== */
+
+/* LV_EVENT_RENDER_START only fires for refresh runs with dirty areas, so
+ * idle timer runs don't count as frames. REFR_READY follows the flush. */
+static void render_start_cb(lv_event_t *e) {
+    ARG_UNUSED(e);
+    frame_start_cyc = k_cycle_get_32();
+    frame_rendering = true;
+}
+
+static void refr_ready_cb(lv_event_t *e) {
+    ARG_UNUSED(e);
+    if (!frame_rendering) {
+        return;
+    }
+    uint32_t us = k_cyc_to_us_floor32(k_cycle_get_32() - frame_start_cyc);
+
+    frame_rendering = false;
+    frames++;
+    frame_us_sum += us;
+    frame_us_max = MAX(frame_us_max, us);
+}
+
+/* Each flushed area goes out to the panel as area x pixel size bytes */
+static void flush_start_cb(lv_event_t *e) {
+    const lv_area_t *area = lv_event_get_param(e);
+    lv_display_t *disp = lv_event_get_target(e);
+
+    if (area) {
+        flush_bytes += lv_area_get_size(area) *
+                       lv_color_format_get_size(lv_display_get_color_format(disp));
+    }
+}
+
+/* ========== Sampling ========== */
+
+static void totals_get(struct perf_totals *t) {
+    t->time_ms = k_uptime_get_32();
+    t->reports = zmk_status_scanner_report_count();
+    scanner_get_pipeline_counts(&t->pipe);
+    t->spi_bytes = flush_bytes;
+#if IS_ENABLED(CONFIG_SCHED_THREAD_USAGE_ALL)
+    k_thread_runtime_stats_t stats;
+
+    k_thread_runtime_stats_all_get(&stats);
+    t->cpu_cycles = stats.execution_cycles;
+    t->idle_cycles = stats.idle_cycles;
+#endif
+}
+
+/* Per second, from a delta over @p ms */
+static uint32_t per_s(uint32_t delta, uint32_t ms) {
+    return ms ? (uint32_t)((uint64_t)delta * 1000U / ms) : 0;
+}
+
+static uint32_t heap_peak(void) {
+#if IS_ENABLED(CONFIG_PROSPECTOR_LVGL_HEAP_STATS)
+    struct lvgl_heap_snapshot snap;
+
+    lvgl_heap_stats_sample(&snap);
+    return snap.peak;
+#else
+    lv_mem_monitor_t mon;
+
+    lv_mem_monitor(&mon);
+    return mon.max_used;  /* 0 when Zephyr's pool backs LVGL */
+#endif
+}
+
+static void sample_timer_cb(lv_timer_t *timer) {
+    ARG_UNUSED(timer);
+    static char text[320];
+    struct perf_totals now;
+
+    totals_get(&now);
+    uint32_t ms = now.time_ms - last.time_ms;
+    uint32_t runs = now.pipe.work_runs - last.pipe.work_runs;
+    uint32_t work_us = runs ? k_cyc_to_us_floor32(now.pipe.work_cycles -
+                                                  last.pipe.work_cycles) / runs : 0;
+    uint32_t frame_avg_us = frames ? frame_us_sum / frames : 0;
+    char idle[8] = "--";
+#if IS_ENABLED(CONFIG_SCHED_THREAD_USAGE_ALL)
+    uint64_t cpu = now.cpu_cycles - last.cpu_cycles;
+
+    if (cpu > 0) {
+        snprintf(idle, sizeof(idle), "%u%%",
+                 (unsigned)((now.idle_cycles - last.idle_cycles) * 100U / cpu));
+    }
+#endif
+
+    snprintf(text, sizeof(text),
+             "BT reports   %6u/s\n"
+             "Status rx    %6u/s\n"
+             "Ring drops %6u +%u/s\n"
+             "Work %4u/s %7u us\n"
+             "Frame %5u us, max %u ms\n"
+             "FPS          %6u\n"
+             "SPI          %6u KB/s\n"
+             "Heap peak    %6u B\n"
+             "CPU idle     %6s",
+             per_s(now.reports - last.reports, ms),
+             per_s(now.pipe.queued - last.pipe.queued, ms),
+             now.pipe.dropped, per_s(now.pipe.dropped - last.pipe.dropped, ms),
+             per_s(runs, ms), work_us,
+             frame_avg_us, frame_us_max / 1000U,
+             per_s(frames, ms),
+             per_s(now.spi_bytes - last.spi_bytes, ms) / 1024U,
+             heap_peak(),
+             idle);
+#if IS_ENABLED(CONFIG_PROSPECTOR_THREAD_MONITOR)
+    struct thread_monitor_entry tight;
+
+    if (thread_monitor_tightest(&tight)) {
+        size_t len = strlen(text);
+        snprintf(text + len, sizeof(text) - len, "\nStack %-12.12s %5u B", tight.name,
+                 tight.stack_unused);
+    }
+#endif
+#if IS_ENABLED(CONFIG_PROSPECTOR_FONT_EXT_FLASH)
+    struct font_storage_stats glyphs;
+    size_t glyph_len = strlen(text);
+
+    font_storage_get_stats(&glyphs);
+    snprintf(text + glyph_len, sizeof(text) - glyph_len, "\nGlyph hit %6u miss %5u",
+             glyphs.hits, glyphs.misses);
+#endif
+    lv_label_set_text_static(panel_label, text);
+
+    last = now;
+    frames = 0;
+    frame_us_sum = 0;
+    frame_us_max = 0;
+}
+
+/* ========== Panel ========== */
+
+static void panel_teardown(bool from_click);
+
+static void panel_event_cb(lv_event_t *e) {
+    if (lv_event_get_code(e) == LV_EVENT_CLICKED) {
+        panel_teardown(true);
+    }
+}
+
+static void panel_open(lv_obj_t *parent) {
+    panel = lv_obj_create(parent);
+    lv_obj_set_size(panel, 224, 142);
+    lv_obj_align(panel, LV_ALIGN_CENTER, 0, 20);  /* Over the action buttons */
+    lv_obj_set_style_bg_color(panel, lv_color_black(), 0);
+    lv_obj_set_style_bg_opa(panel, LV_OPA_COVER, 0);
+    lv_obj_set_style_border_width(panel, 1, 0);
+    lv_obj_set_style_border_color(panel, lv_color_hex(0x404040), 0);
+    lv_obj_set_style_radius(panel, 6, 0);
+    lv_obj_set_style_pad_all(panel, 6, 0);
+    lv_obj_clear_flag(panel, LV_OBJ_FLAG_SCROLLABLE);
+    lv_obj_add_event_cb(panel, panel_event_cb, LV_EVENT_CLICKED, NULL);
+
+    panel_label = lv_label_create(panel);
+    lv_obj_set_style_text_font(panel_label, &lv_font_unscii_8, 0);
+    lv_obj_set_style_text_color(panel_label, lv_color_hex(0xC0C0C0), 0);
+    lv_obj_set_style_text_line_space(panel_label, 5, 0);
+    lv_label_set_text_static(panel_label, "Sampling...");
+    lv_obj_align(panel_label, LV_ALIGN_TOP_LEFT, 0, 0);
+
+    lv_display_t *disp = lv_display_get_default();
+    if (disp) {
+        lv_display_add_event_cb(disp, render_start_cb, LV_EVENT_RENDER_START, NULL);
+        lv_display_add_event_cb(disp, refr_ready_cb, LV_EVENT_REFR_READY, NULL);
+        lv_display_add_event_cb(disp, flush_start_cb, LV_EVENT_FLUSH_START, NULL);
+    }
+    frame_rendering = false;
+    frames = 0;
+    frame_us_sum = 0;
+    frame_us_max = 0;
+    totals_get(&last);
+    sample_timer = lv_timer_create(sample_timer_cb, SAMPLE_MS, NULL);
+    LOG_INF("Performance panel opened");
+}
+
+/* From its own click event the panel can only be deleted once the event is
+ * done; otherwise now, before a screen clean frees it underneath us */
+static void panel_teardown(bool from_click) {
+    if (!panel) {
+        return;
+    }
+    lv_timer_del(sample_timer);
+    sample_timer = NULL;
+
+    lv_display_t *disp = lv_display_get_default();
+    if (disp) {
+        lv_display_remove_event_cb_with_user_data(disp, render_start_cb, NULL);
+        lv_display_remove_event_cb_with_user_data(disp, refr_ready_cb, NULL);
+        lv_display_remove_event_cb_with_user_data(disp, flush_start_cb, NULL);
+    }
+    if (from_click) {
+        lv_obj_del_async(panel);
+    } else {
+        lv_obj_del(panel);
+    }
+    panel = NULL;
+    panel_label = NULL;
+    LOG_INF("Performance panel closed");
+}
+
+void perf_panel_close(void) {
+    panel_teardown(false);
+}
+
+void perf_panel_toggle(lv_obj_t *parent) {
+    if (panel) {
+        perf_panel_close();
+    } else if (parent) {
+        panel_open(parent);
+    }
+}
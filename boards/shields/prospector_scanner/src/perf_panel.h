@@ -0,0 +1,29 @@
+/*
+ * Copyright (c) 2024 The ZMK Contributors
+ *
+ * SPDX-License-Identifier: MIT
+ *
+ * Runtime performance panel (CONFIG_PROSPECTOR_PERF_PANEL)
+ *
+ * An overlay on the Quick Actions screen with per-second figures for each
+ * pipeline stage, refreshed once a second:
+ *   BT RX        scan callback reports, Prospector status frames, ring drops
+ *   work queue   scanner_process_incoming() runs and their average duration
+ *   LVGL         rendered frames, render + flush time, heap peak
+ *   SPI          ST7789V pixel bytes
+ *   kernel       idle share of CPU time (CONFIG_SCHED_THREAD_USAGE_ALL), and
+ *                the thread with the least stack to spare
+ *                (CONFIG_PROSPECTOR_THREAD_MONITOR)
+ * Nothing is sampled, and no display event is hooked, while it is closed.
+ */
+
+#pragma once
+
+#include <stdbool.h>
+#include <lvgl.h>
+
+/* LVGL thread: open the panel over @p parent, or close it if open */
+void perf_panel_toggle(lv_obj_t *parent);
+
+/* LVGL thread: close the panel if open (screen hidden or destroyed) */
+void perf_panel_close(void);
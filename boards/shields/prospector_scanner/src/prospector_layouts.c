@@ -4,25 +4,199 @@
  *
  * Prospector Display Layouts - Scanner Mode Manager
  *
- * Manages switching between Operator and Radii layouts.
+ * Switches between the layouts in the registry below (Field, Operator,
+ * Radii, each behind its own CONFIG_PROSPECTOR_LAYOUT_* option).
  * Use prospector_layouts_next()/prev() to switch layouts.
  */
 
+#include <zephyr/kernel.h>
+#include <zephyr/logging/log.h>
+
 #include "prospector_layouts.h"
+#include "layer_name_cache.h"
+#if IS_ENABLED(CONFIG_PROSPECTOR_LAYOUT_OPERATOR)
 #include "operator_layout.h"
+#endif
+#if IS_ENABLED(CONFIG_PROSPECTOR_LAYOUT_RADII)
 #include "radii_layout.h"
+#endif
+#if IS_ENABLED(CONFIG_PROSPECTOR_LAYOUT_FIELD)
 #include "field_layout.h"
-#include <zephyr/logging/log.h>
+#endif
 
 LOG_MODULE_REGISTER(prospector_layouts, CONFIG_ZMK_LOG_LEVEL);
 
-/* Available layouts: Operator and Radii */
+/* ========== Registry ========== */
+
+#define FIELDS_COMMON (PROSPECTOR_KB_CHANGED_LAYER | PROSPECTOR_KB_CHANGED_MODIFIERS | \
+                       PROSPECTOR_KB_CHANGED_BATTERY | PROSPECTOR_KB_CHANGED_CONNECTION)
+
+/* LVGL pool each layout needs while shown: its widgets plus the draw
+ * tasks of one full frame. Rough figures with some margin; check against
+ * CONFIG_PROSPECTOR_LVGL_HEAP_STATS when a layout changes. */
+#define FIELD_HEAP_BYTES    (6 * 1024)   /* 8 objects, 36 line draw tasks */
+#define OPERATOR_HEAP_BYTES (8 * 1024)   /* ~30 labels and bars */
+#define RADII_HEAP_BYTES    (10 * 1024)  /* Arcs + rotated wheel image draw buffer */
+
+static const char *layer_name_of(const struct prospector_keyboard_data *d) {
+    const char *name = layer_name_cache_get(d->layer_names, d->active_layer);
+    if (name) {
+        return name;
+    }
+    return d->current_layer_name[0] ? d->current_layer_name : "BASE";
+}
+
+static bool battery_connected(const struct prospector_keyboard_data *d, uint8_t level) {
+    return d->has_dynamic_data && level > 0;
+}
+
+#if IS_ENABLED(CONFIG_PROSPECTOR_LAYOUT_FIELD)
+static lv_obj_t *field_create(lv_obj_t *parent) {
+    return field_layout_create(parent);
+}
+
+static void field_update(const struct prospector_keyboard_data *d) {
+    field_layout_update(d->active_layer, layer_name_of(d),
+                        d->battery_level, battery_connected(d, d->battery_level),
+                        d->peripheral_battery[0],
+                        battery_connected(d, d->peripheral_battery[0]),
+                        d->wpm_value, d->modifier_flags,
+                        d->usb_connected, d->profile_slot,
+                        d->ble_connected, d->ble_bonded);
+}
+
+static const struct prospector_layout_ops field_ops = {
+    .name = "Field",
+    .create = field_create,
+    .update = field_update,
+    .destroy = field_layout_destroy,
+    .cycle_palette = field_layout_cycle_palette,
+    .fields = FIELDS_COMMON | PROSPECTOR_KB_CHANGED_WPM,
+    .heap_bytes = FIELD_HEAP_BYTES,
+};
+#endif
+
+#if IS_ENABLED(CONFIG_PROSPECTOR_LAYOUT_OPERATOR)
+static lv_obj_t *operator_create(lv_obj_t *parent) {
+    return operator_layout_create(parent);
+}
+
+static void operator_update(const struct prospector_keyboard_data *d) {
+    /* Peripheral batteries: build arrays for all 3 possible peripherals */
+    uint8_t peripheral_battery[OPERATOR_MAX_PERIPHERALS];
+    bool peripheral_connected[OPERATOR_MAX_PERIPHERALS];
+    for (int i = 0; i < OPERATOR_MAX_PERIPHERALS; i++) {
+        peripheral_battery[i] = d->peripheral_battery[i];
+        peripheral_connected[i] = battery_connected(d, peripheral_battery[i]);
+    }
+
+    operator_layout_update(d->active_layer, layer_name_of(d),
+                           d->battery_level, battery_connected(d, d->battery_level),
+                           peripheral_battery, peripheral_connected,
+                           d->wpm_value, d->modifier_flags,
+                           d->usb_connected, d->profile_slot,
+                           d->ble_connected, d->ble_bonded);
+}
+
+static const struct prospector_layout_ops operator_ops = {
+    .name = "Operator",
+    .create = operator_create,
+    .update = operator_update,
+    .destroy = operator_layout_destroy,
+    .cycle_palette = operator_layout_cycle_palette,
+    .fields = FIELDS_COMMON | PROSPECTOR_KB_CHANGED_WPM,
+    .heap_bytes = OPERATOR_HEAP_BYTES,
+};
+#endif
+
+#if IS_ENABLED(CONFIG_PROSPECTOR_LAYOUT_RADII)
+static lv_obj_t *radii_create(lv_obj_t *parent) {
+    return radii_layout_create(parent);
+}
+
+static void radii_update(const struct prospector_keyboard_data *d) {
+    radii_layout_update(d->active_layer, layer_name_of(d),
+                        d->battery_level, battery_connected(d, d->battery_level),
+                        d->peripheral_battery[0],
+                        battery_connected(d, d->peripheral_battery[0]),
+                        d->modifier_flags, d->usb_connected, d->profile_slot);
+}
+
+static const struct prospector_layout_ops radii_ops = {
+    .name = "Radii",
+    .create = radii_create,
+    .update = radii_update,
+    .destroy = radii_layout_destroy,
+    .cycle_palette = radii_layout_cycle_palette,
+    .fields = FIELDS_COMMON,
+    .heap_bytes = RADII_HEAP_BYTES,
+};
+#endif
+
+/* Indexed by prospector_layout_t; NULL = not a Prospector layout or compiled out */
+static const struct prospector_layout_ops *const layouts[PROSPECTOR_LAYOUT_COUNT] = {
+#if IS_ENABLED(CONFIG_PROSPECTOR_LAYOUT_FIELD)
+    [PROSPECTOR_LAYOUT_FIELD] = &field_ops,
+#endif
+#if IS_ENABLED(CONFIG_PROSPECTOR_LAYOUT_OPERATOR)
+    [PROSPECTOR_LAYOUT_OPERATOR] = &operator_ops,
+#endif
+#if IS_ENABLED(CONFIG_PROSPECTOR_LAYOUT_RADII)
+    [PROSPECTOR_LAYOUT_RADII] = &radii_ops,
+#endif
+};
+
+/* Operator when built in, else the first layout that is */
+static prospector_layout_t default_layout(void) {
+    if (layouts[PROSPECTOR_LAYOUT_OPERATOR]) {
+        return PROSPECTOR_LAYOUT_OPERATOR;
+    }
+    for (int i = 0; i < PROSPECTOR_LAYOUT_COUNT; i++) {
+        if (layouts[i]) {
+            return (prospector_layout_t)i;
+        }
+    }
+    return PROSPECTOR_LAYOUT_OPERATOR;
+}
+
+/* Next registered layout from @p from in direction @p step, wrapping */
+static prospector_layout_t step_layout(prospector_layout_t from, int step) {
+    int i = from;
+    for (int n = 0; n < PROSPECTOR_LAYOUT_COUNT; n++) {
+        i = (i + step + PROSPECTOR_LAYOUT_COUNT) % PROSPECTOR_LAYOUT_COUNT;
+        if (layouts[i]) {
+            return (prospector_layout_t)i;
+        }
+    }
+    return from;
+}
+
+/* Whether the LVGL pool has room for @p ops right now */
+static bool layout_fits(const struct prospector_layout_ops *ops) {
+    lv_mem_monitor_t mon;
+    lv_mem_monitor(&mon);
+    if (mon.total_size > 0) {
+        return mon.free_size >= ops->heap_bytes;
+    }
+
+    /* Zephyr's pool reports nothing: ask for the whole budget at once.
+     * Stricter than needed under fragmentation, which errs on the safe side. */
+    void *probe = lv_malloc(ops->heap_bytes);
+    if (!probe) {
+        return false;
+    }
+    lv_free(probe);
+    return true;
+}
+
+/* ========== State ========== */
+
 static prospector_layout_t current_layout = PROSPECTOR_LAYOUT_OPERATOR;
 static lv_obj_t *parent_obj = NULL;
 static bool initialized = false;
 
 /* Cached data for layout switching */
-static struct prospector_keyboard_data cached_data = {0};
+static struct prospector_keyboard_data cached_data = {.layer_names = LAYER_NAME_CACHE_NONE};
 
 /* Forward declarations */
 static void destroy_current_layout(void);
@@ -38,6 +212,9 @@ void prospector_layouts_init(lv_obj_t *parent) {
     parent_obj = parent;
 
     /* Create initial layout (Operator) */
+    if (!layouts[current_layout]) {
+        current_layout = default_layout();
+    }
     create_current_layout();
 
     initialized = true;
@@ -56,23 +233,31 @@ void prospector_layouts_destroy(void) {
     LOG_INF("Prospector layouts destroyed");
 }
 
+bool prospector_layouts_is_active(void) {
+    return initialized;
+}
+
 void prospector_layouts_set_style(prospector_layout_t layout) {
     if (!initialized) return;
 
-    /* Support Field, Operator, and Radii */
-    if (layout != PROSPECTOR_LAYOUT_FIELD &&
-        layout != PROSPECTOR_LAYOUT_OPERATOR &&
-        layout != PROSPECTOR_LAYOUT_RADII) {
-        layout = PROSPECTOR_LAYOUT_OPERATOR;
+    /* Only layouts in the registry */
+    if (layout >= PROSPECTOR_LAYOUT_COUNT || !layouts[layout]) {
+        layout = default_layout();
     }
 
     if (layout == current_layout) {
         return;
     }
 
-    /* Switch layout */
+    /* Switch layout; the old one's memory is back in the pool before the check */
     destroy_current_layout();
-    current_layout = layout;
+    if (layout_fits(layouts[layout])) {
+        current_layout = layout;
+    } else {
+        LOG_WRN("%s needs %u bytes of LVGL heap, not available; staying on %s",
+                layouts[layout]->name, layouts[layout]->heap_bytes,
+                prospector_layouts_get_name(current_layout));
+    }
     create_current_layout();
     update_current_layout();
 
@@ -86,41 +271,15 @@ prospector_layout_t prospector_layouts_get_style(void) {
 void prospector_layouts_next(void) {
     if (!initialized) return;
 
-    /* Cycle: Field -> Operator -> Radii -> Field */
-    prospector_layout_t next;
-    switch (current_layout) {
-    case PROSPECTOR_LAYOUT_FIELD:
-        next = PROSPECTOR_LAYOUT_OPERATOR;
-        break;
-    case PROSPECTOR_LAYOUT_OPERATOR:
-        next = PROSPECTOR_LAYOUT_RADII;
-        break;
-    case PROSPECTOR_LAYOUT_RADII:
-    default:
-        next = PROSPECTOR_LAYOUT_FIELD;
-        break;
-    }
-    prospector_layouts_set_style(next);
+    /* Cycle: Field -> Operator -> Radii -> Field (registered ones only) */
+    prospector_layouts_set_style(step_layout(current_layout, 1));
 }
 
 void prospector_layouts_prev(void) {
     if (!initialized) return;
 
     /* Cycle reverse: Field <- Operator <- Radii <- Field */
-    prospector_layout_t prev;
-    switch (current_layout) {
-    case PROSPECTOR_LAYOUT_FIELD:
-        prev = PROSPECTOR_LAYOUT_RADII;
-        break;
-    case PROSPECTOR_LAYOUT_OPERATOR:
-        prev = PROSPECTOR_LAYOUT_FIELD;
-        break;
-    case PROSPECTOR_LAYOUT_RADII:
-    default:
-        prev = PROSPECTOR_LAYOUT_OPERATOR;
-        break;
-    }
-    prospector_layouts_set_style(prev);
+    prospector_layouts_set_style(step_layout(current_layout, -1));
 }
 
 void prospector_layouts_update(const struct prospector_keyboard_data *data) {
@@ -131,136 +290,67 @@ void prospector_layouts_update(const struct prospector_keyboard_data *data) {
     /* Cache data for layout switching */
     cached_data = *data;
 
+    const struct prospector_layout_ops *ops = layouts[current_layout];
+    if (!ops || (data->changed & ops->fields) == 0) {
+        return;
+    }
     update_current_layout();
 }
 
 void prospector_layouts_cycle_palette(void) {
     if (!initialized) return;
 
-    switch (current_layout) {
-    case PROSPECTOR_LAYOUT_FIELD:
-        field_layout_cycle_palette();
-        break;
-    case PROSPECTOR_LAYOUT_OPERATOR:
-        operator_layout_cycle_palette();
-        break;
-    case PROSPECTOR_LAYOUT_RADII:
-        radii_layout_cycle_palette();
-        break;
-    default:
-        break;
+    const struct prospector_layout_ops *ops = layouts[current_layout];
+    if (ops && ops->cycle_palette) {
+        ops->cycle_palette();
     }
 }
 
 const char *prospector_layouts_get_name(prospector_layout_t layout) {
-    switch (layout) {
-    case PROSPECTOR_LAYOUT_CLASSIC:
-        return "Classic";
-    case PROSPECTOR_LAYOUT_FIELD:
-        return "Field";
-    case PROSPECTOR_LAYOUT_OPERATOR:
-        return "Operator";
-    case PROSPECTOR_LAYOUT_RADII:
-        return "Radii";
-    default:
-        return "Unknown";
+    if (layout < PROSPECTOR_LAYOUT_COUNT && layouts[layout]) {
+        return layouts[layout]->name;
     }
+    return layout == PROSPECTOR_LAYOUT_CLASSIC ? "Classic" : "Unknown";
 }
 
 /* ========== Internal Functions ========== */
 
 static void destroy_current_layout(void) {
-    switch (current_layout) {
-    case PROSPECTOR_LAYOUT_FIELD:
-        field_layout_destroy();
-        break;
-    case PROSPECTOR_LAYOUT_OPERATOR:
-        operator_layout_destroy();
-        break;
-    case PROSPECTOR_LAYOUT_RADII:
-        radii_layout_destroy();
-        break;
-    default:
-        break;
+    const struct prospector_layout_ops *ops = layouts[current_layout];
+    if (ops) {
+        ops->destroy();
     }
 }
 
 static void create_current_layout(void) {
     if (!parent_obj) return;
 
-    switch (current_layout) {
-    case PROSPECTOR_LAYOUT_FIELD:
-        field_layout_create(parent_obj);
-        break;
-    case PROSPECTOR_LAYOUT_OPERATOR:
-        operator_layout_create(parent_obj);
-        break;
-    case PROSPECTOR_LAYOUT_RADII:
-        radii_layout_create(parent_obj);
-        break;
-    default:
-        /* Fallback to Operator */
-        current_layout = PROSPECTOR_LAYOUT_OPERATOR;
-        operator_layout_create(parent_obj);
-        break;
+    const struct prospector_layout_ops *ops = layouts[current_layout];
+    if (!ops) {
+        return;  /* No layout built in */
     }
-}
-
-static void update_current_layout(void) {
-    /* Convert cached data to layout-specific update calls */
-    uint8_t active_layer = cached_data.active_layer;
-    const char *layer_name = cached_data.current_layer_name[0]
-                             ? cached_data.current_layer_name : "BASE";
 
-    uint8_t battery_level = cached_data.battery_level;
-    bool battery_connected = cached_data.has_dynamic_data && battery_level > 0;
+    if (layout_fits(ops)) {
+        ops->create(parent_obj);
+        return;
+    }
 
-    /* Peripheral batteries: build arrays for all 3 possible peripherals */
-    uint8_t peripheral_battery[OPERATOR_MAX_PERIPHERALS];
-    bool peripheral_connected[OPERATOR_MAX_PERIPHERALS];
-    for (int i = 0; i < OPERATOR_MAX_PERIPHERALS; i++) {
-        peripheral_battery[i] = cached_data.peripheral_battery[i];
-        peripheral_connected[i] = cached_data.has_dynamic_data && peripheral_battery[i] > 0;
+    /* Downgrade to the smallest registered layout */
+    prospector_layout_t smallest = current_layout;
+    for (int i = 0; i < PROSPECTOR_LAYOUT_COUNT; i++) {
+        if (layouts[i] && layouts[i]->heap_bytes < layouts[smallest]->heap_bytes) {
+            smallest = (prospector_layout_t)i;
+        }
     }
+    LOG_WRN("%s needs %u bytes of LVGL heap, not available; showing %s",
+            ops->name, ops->heap_bytes, layouts[smallest]->name);
+    current_layout = smallest;
+    layouts[smallest]->create(parent_obj);
+}
 
-    uint8_t wpm = cached_data.wpm_value;
-    uint8_t modifier_flags = cached_data.modifier_flags;
-
-    bool usb_connected = cached_data.usb_connected;
-    uint8_t ble_profile = cached_data.profile_slot;
-    bool ble_connected = cached_data.ble_connected;
-    bool ble_bonded = cached_data.ble_bonded;
-
-    switch (current_layout) {
-    case PROSPECTOR_LAYOUT_FIELD:
-        field_layout_update(
-            active_layer, layer_name,
-            battery_level, battery_connected,
-            peripheral_battery[0], peripheral_connected[0],
-            wpm, modifier_flags,
-            usb_connected, ble_profile,
-            ble_connected, ble_bonded
-        );
-        break;
-    case PROSPECTOR_LAYOUT_OPERATOR:
-        operator_layout_update(
-            active_layer, layer_name,
-            battery_level, battery_connected,
-            peripheral_battery, peripheral_connected,
-            wpm, modifier_flags,
-            usb_connected, ble_profile,
-            ble_connected, ble_bonded
-        );
-        break;
-    case PROSPECTOR_LAYOUT_RADII:
-        radii_layout_update(
-            active_layer, layer_name,
-            battery_level, battery_connected,
-            peripheral_battery[0], peripheral_connected[0],
-            modifier_flags, usb_connected, ble_profile
-        );
-        break;
-    default:
-        break;
+static void update_current_layout(void) {
+    const struct prospector_layout_ops *ops = layouts[current_layout];
+    if (ops) {
+        ops->update(&cached_data);
     }
 }
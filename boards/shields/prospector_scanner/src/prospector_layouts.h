@@ -20,6 +20,7 @@
 #include <lvgl.h>
 #include <stdint.h>
 #include <stdbool.h>
+#include <zmk/keyboard_names.h>
 
 #ifdef __cplusplus
 extern "C" {
@@ -36,13 +37,22 @@ typedef enum {
     PROSPECTOR_LAYOUT_COUNT
 } prospector_layout_t;
 
+/* prospector_keyboard_data.changed: what differs from the previous update */
+#define PROSPECTOR_KB_CHANGED_LAYER       (1u << 0)  /* active_layer, layer names */
+#define PROSPECTOR_KB_CHANGED_MODIFIERS   (1u << 1)
+#define PROSPECTOR_KB_CHANGED_WPM         (1u << 2)
+#define PROSPECTOR_KB_CHANGED_BATTERY     (1u << 3)
+#define PROSPECTOR_KB_CHANGED_CONNECTION  (1u << 4)  /* USB/BLE state, profile */
+#define PROSPECTOR_KB_CHANGED_NAME        (1u << 5)
+#define PROSPECTOR_KB_CHANGED_ALL         0x3Fu
+
 /**
  * @brief Keyboard data for display (from Periodic ADV)
  */
 struct prospector_keyboard_data {
     /* Dynamic data (from dynamic packet) */
     uint8_t active_layer;
-    char current_layer_name[8];
+    char current_layer_name[8];  /* Only when layer_names has no name for active_layer */
     uint8_t modifier_flags;
     uint8_t wpm_value;
     uint8_t battery_level;
@@ -55,14 +65,33 @@ struct prospector_keyboard_data {
     bool usb_connected;
 
     /* Static data (from static packet) */
-    char keyboard_name[24];
+    zmk_keyboard_name_t keyboard_name;  /* Interned, not referenced */
     uint8_t layer_count;
-    char layer_names[10][8];
-    int8_t peripheral_rssi[3];
+    int8_t layer_names;  /* layer_name_cache entry: layer_name_cache_get(layer_names, i) */
+    int8_t peripheral_rssi[3];  /* Split links at the central (dBm), 0 = unknown */
 
     /* Validity flags */
     bool has_dynamic_data;
     bool has_static_data;
+
+    uint32_t changed;  /* PROSPECTOR_KB_CHANGED_*; 0 is treated as "nothing new" */
+};
+
+/**
+ * @brief One entry of the layout registry
+ *
+ * Each layout compiled in (CONFIG_PROSPECTOR_LAYOUT_*) contributes one of
+ * these; layouts that are compiled out have no entry and are skipped by
+ * set_style/next/prev.
+ */
+struct prospector_layout_ops {
+    const char *name;
+    lv_obj_t *(*create)(lv_obj_t *parent);
+    void (*update)(const struct prospector_keyboard_data *data);
+    void (*destroy)(void);
+    void (*cycle_palette)(void);
+    uint32_t fields;      /* PROSPECTOR_KB_CHANGED_* that update() draws */
+    uint32_t heap_bytes;  /* LVGL pool the layout needs while shown */
 };
 
 /**
@@ -76,6 +105,11 @@ void prospector_layouts_init(lv_obj_t *parent);
  */
 void prospector_layouts_destroy(void);
 
+/**
+ * @brief Whether prospector_layouts_init() has a parent right now
+ */
+bool prospector_layouts_is_active(void);
+
 /**
  * @brief Set the current layout style
  * @param layout Layout style to display
@@ -100,6 +134,9 @@ void prospector_layouts_prev(void);
 
 /**
  * @brief Update display with new keyboard data
+ *
+ * Skipped when data->changed has nothing the current layout draws.
+ *
  * @param data Keyboard data from Periodic ADV
  */
 void prospector_layouts_update(const struct prospector_keyboard_data *data);
@@ -13,6 +13,7 @@
 #include "radii_layout.h"
 #include "fonts_carrefinho.h"
 #include "fonts.h"
+#include "ring_gauge.h"
 #include <zephyr/logging/log.h>
 #include <math.h>
 #include <string.h>
@@ -103,14 +104,57 @@ static const radii_color_palette_t color_palettes[4] = {
 #define PALETTE_COUNT 4
 static uint8_t current_palette = 0;
 
+/* One shared style per palette role (active modifiers and filled battery
+ * arcs via LV_STATE_CHECKED), so a palette change only rewrites these */
+static struct {
+    lv_style_t left_panel;
+    lv_style_t mod_panel;
+    lv_style_t battery_panel;
+    lv_style_t layer_text;
+    lv_style_t wheel;        /* the wheel is drawn white and recolored */
+    lv_style_t mod;
+    lv_style_t mod_active;
+    lv_style_t arc;
+    lv_style_t arc_active;
+    bool initialized;
+} styles;
+
+static void styles_set_palette(const radii_color_palette_t *p) {
+    if (!styles.initialized) {
+        lv_style_init(&styles.left_panel);
+        lv_style_init(&styles.mod_panel);
+        lv_style_init(&styles.battery_panel);
+        lv_style_init(&styles.layer_text);
+        lv_style_init(&styles.wheel);
+        lv_style_set_image_recolor_opa(&styles.wheel, LV_OPA_COVER);
+        lv_style_init(&styles.mod);
+        lv_style_init(&styles.mod_active);
+        lv_style_init(&styles.arc);
+        lv_style_init(&styles.arc_active);
+        styles.initialized = true;
+    }
+    lv_style_set_bg_color(&styles.left_panel, lv_color_hex(p->left_panel_bg));
+    lv_style_set_bg_color(&styles.mod_panel, lv_color_hex(p->mod_panel_bg));
+    lv_style_set_bg_color(&styles.battery_panel, lv_color_hex(p->battery_panel_bg));
+    lv_style_set_text_color(&styles.layer_text, lv_color_hex(p->layer_text));
+    lv_style_set_image_recolor(&styles.wheel, lv_color_hex(p->layer_wheel));
+    lv_style_set_line_color(&styles.wheel, lv_color_hex(p->layer_wheel));
+    lv_style_set_text_color(&styles.mod, lv_color_hex(p->mod_inactive));
+    lv_style_set_text_color(&styles.mod_active, lv_color_hex(p->mod_active));
+    lv_style_set_arc_color(&styles.arc, lv_color_hex(p->arc_bg));
+    lv_style_set_arc_color(&styles.arc_active, lv_color_hex(p->arc_indicator));
+}
+
 /* ========== Static storage ========== */
 static lv_obj_t *parent_screen = NULL;
 static bool layout_created = false;
 
 /* Left panel */
 static lv_obj_t *left_panel = NULL;
+#if !IS_ENABLED(CONFIG_PROSPECTOR_RADII_DIRECT_WHEEL)
 static lv_obj_t *wheel_canvas = NULL;
 static lv_obj_t *wheel_image = NULL;
+#endif
 static lv_obj_t *layer_label = NULL;
 static uint8_t current_layer = 0;
 static uint8_t current_layer_count = 6;
@@ -124,15 +168,93 @@ static lv_obj_t *bat_panel = NULL;
 static lv_obj_t *bat_arc_left = NULL;
 static lv_obj_t *bat_arc_right = NULL;
 
+#if IS_ENABLED(CONFIG_PROSPECTOR_RADII_DIRECT_WHEEL)
+/* Wheel drawn straight into the frame, no canvas or image */
+static lv_obj_t *wheel_obj = NULL;
+static int32_t wheel_rotation = 0;  /* 0.1°, same units as lv_image_set_rotation() */
+#else
 /* Canvas buffer for wheel */
 static uint8_t wheel_canvas_buf[LV_CANVAS_BUF_SIZE(WHEEL_SIZE, WHEEL_SIZE, 32, 1)];
+#endif
 
 /* ========== Wheel Drawing ========== */
 
+#if IS_ENABLED(CONFIG_PROSPECTOR_RADII_DIRECT_WHEEL)
+/* Draws current_layer_count ticks at wheel_rotation. LVGL only calls this
+ * when the wheel's area is redrawn, so a rotation step costs a handful of
+ * short lines instead of a transform of the whole 32-bit image. */
+static void wheel_draw_cb(lv_event_t *e) {
+    lv_obj_t *obj = lv_event_get_target(e);
+    lv_layer_t *layer = lv_event_get_layer(e);
+    lv_area_t coords;
+    lv_obj_get_coords(obj, &coords);
+
+    int num_ticks = (current_layer_count > 0 && current_layer_count <= 16)
+                    ? current_layer_count : 6;
+    int cx = coords.x1 + WHEEL_CENTER;
+    int cy = coords.y1 + WHEEL_CENTER;
+
+    lv_draw_line_dsc_t line_dsc;
+    lv_draw_line_dsc_init(&line_dsc);
+    line_dsc.color = lv_obj_get_style_line_color(obj, LV_PART_MAIN);
+    line_dsc.width = 4;
+    line_dsc.opa = LV_OPA_COVER;
+    line_dsc.round_start = 1;
+    line_dsc.round_end = 1;
+
+    for (int i = 0; i < num_ticks; i++) {
+        float deg = (float)i * 360.0f / num_ticks + wheel_rotation / 10.0f - 90.0f;
+        float angle = deg * M_PI / 180.0f;
+        float c = cosf(angle);
+        float s = sinf(angle);
+
+        line_dsc.p1.x = cx + (int)lroundf(WHEEL_INNER_RADIUS * c);
+        line_dsc.p1.y = cy + (int)lroundf(WHEEL_INNER_RADIUS * s);
+        line_dsc.p2.x = cx + (int)lroundf(WHEEL_OUTER_RADIUS * c);
+        line_dsc.p2.y = cy + (int)lroundf(WHEEL_OUTER_RADIUS * s);
+
+        lv_draw_line(layer, &line_dsc);
+    }
+}
+
+static void wheel_set_rotation(void *obj, int32_t rotation) {
+    wheel_rotation = rotation;
+    lv_obj_invalidate(obj);
+}
+
+/* Tick count changed */
+static void wheel_refresh(void) {
+    if (wheel_obj) {
+        lv_obj_invalidate(wheel_obj);
+    }
+}
+
+static void rotate_wheel(uint8_t target_layer, uint8_t layer_count) {
+    if (!wheel_obj) return;
+
+    int num_layers = (layer_count > 0 && layer_count <= 16) ? layer_count : 6;
+    int32_t angle_per_layer = 3600 / num_layers;
+    int32_t target_angle = -(target_layer * angle_per_layer);
+
+    int32_t current_angle = wheel_rotation;
+
+    int32_t diff = target_angle - current_angle;
+    while (diff > 1800) { target_angle -= 3600; diff = target_angle - current_angle; }
+    while (diff < -1800) { target_angle += 3600; diff = target_angle - current_angle; }
+
+    lv_anim_t a;
+    lv_anim_init(&a);
+    lv_anim_set_var(&a, wheel_obj);
+    lv_anim_set_values(&a, current_angle, target_angle);
+    lv_anim_set_time(&a, 150);
+    lv_anim_set_path_cb(&a, lv_anim_path_ease_in_out);
+    lv_anim_set_exec_cb(&a, wheel_set_rotation);
+    lv_anim_start(&a);
+}
+#else
 static void draw_wheel(uint8_t layer_count) {
     if (!wheel_canvas) return;
 
-    const radii_color_palette_t *p = &color_palettes[current_palette];
     int num_ticks = (layer_count > 0 && layer_count <= 16) ? layer_count : 6;
 
     lv_canvas_fill_bg(wheel_canvas, lv_color_hex(0x000000), LV_OPA_TRANSP);
@@ -142,7 +264,7 @@ static void draw_wheel(uint8_t layer_count) {
 
     lv_draw_line_dsc_t line_dsc;
     lv_draw_line_dsc_init(&line_dsc);
-    line_dsc.color = lv_color_hex(p->layer_wheel);
+    line_dsc.color = lv_color_white();  /* wheel_image recolors it */
     line_dsc.width = 4;
     line_dsc.opa = LV_OPA_COVER;
     line_dsc.round_start = 1;
@@ -162,6 +284,14 @@ static void draw_wheel(uint8_t layer_count) {
     lv_canvas_finish_layer(wheel_canvas, &layer);
 }
 
+/* Tick count changed */
+static void wheel_refresh(void) {
+    if (wheel_canvas && wheel_image) {
+        draw_wheel(current_layer_count);
+        lv_image_set_src(wheel_image, lv_canvas_get_image(wheel_canvas));
+    }
+}
+
 static void rotate_wheel(uint8_t target_layer, uint8_t layer_count) {
     if (!wheel_image) return;
 
@@ -184,17 +314,16 @@ static void rotate_wheel(uint8_t target_layer, uint8_t layer_count) {
     lv_anim_set_exec_cb(&a, (lv_anim_exec_xcb_t)lv_image_set_rotation);
     lv_anim_start(&a);
 }
+#endif /* CONFIG_PROSPECTOR_RADII_DIRECT_WHEEL */
 
 /* ========== Create Functions ========== */
 
 static void create_left_panel(lv_obj_t *parent) {
-    const radii_color_palette_t *p = &color_palettes[current_palette];
-
     /* Left panel: 172x240 at (0, 0) - ORIGINAL POSITION */
     left_panel = lv_obj_create(parent);
     lv_obj_set_size(left_panel, 172, 240);
     lv_obj_set_pos(left_panel, 0, 0);
-    lv_obj_set_style_bg_color(left_panel, lv_color_hex(p->left_panel_bg), LV_PART_MAIN);
+    lv_obj_add_style(left_panel, &styles.left_panel, LV_PART_MAIN);
     lv_obj_set_style_bg_opa(left_panel, LV_OPA_COVER, LV_PART_MAIN);
     lv_obj_set_style_radius(left_panel, 24, LV_PART_MAIN);
     lv_obj_set_style_border_width(left_panel, 0, LV_PART_MAIN);
@@ -213,6 +342,15 @@ static void create_left_panel(lv_obj_t *parent) {
     lv_obj_set_style_pad_row(layer_container, 12, LV_PART_MAIN);
     lv_obj_clear_flag(layer_container, LV_OBJ_FLAG_SCROLLABLE);
 
+#if IS_ENABLED(CONFIG_PROSPECTOR_RADII_DIRECT_WHEEL)
+    wheel_obj = lv_obj_create(layer_container);
+    lv_obj_remove_style_all(wheel_obj);
+    lv_obj_set_size(wheel_obj, WHEEL_SIZE, WHEEL_SIZE);
+    lv_obj_clear_flag(wheel_obj, LV_OBJ_FLAG_CLICKABLE | LV_OBJ_FLAG_SCROLLABLE);
+    lv_obj_add_style(wheel_obj, &styles.wheel, LV_PART_MAIN);
+    lv_obj_add_event_cb(wheel_obj, wheel_draw_cb, LV_EVENT_DRAW_MAIN, NULL);
+    wheel_rotation = 0;
+#else
     /* Wheel canvas (hidden, used as image source) */
     wheel_canvas = lv_canvas_create(layer_container);
     lv_canvas_set_buffer(wheel_canvas, wheel_canvas_buf, WHEEL_SIZE, WHEEL_SIZE, LV_COLOR_FORMAT_ARGB8888);
@@ -224,11 +362,13 @@ static void create_left_panel(lv_obj_t *parent) {
     lv_image_set_src(wheel_image, lv_canvas_get_image(wheel_canvas));
     lv_image_set_pivot(wheel_image, WHEEL_CENTER, WHEEL_CENTER);
     lv_image_set_rotation(wheel_image, 0);
+    lv_obj_add_style(wheel_image, &styles.wheel, LV_PART_MAIN);
+#endif
 
     /* Layer name label - using DINishExpanded_Light_36 */
     layer_label = lv_label_create(layer_container);
     lv_obj_set_style_text_font(layer_label, &DINishExpanded_Light_36, LV_PART_MAIN);
-    lv_obj_set_style_text_color(layer_label, lv_color_hex(p->layer_text), LV_PART_MAIN);
+    lv_obj_add_style(layer_label, &styles.layer_text, LV_PART_MAIN);
     lv_obj_set_width(layer_label, 148);
     lv_label_set_long_mode(layer_label, LV_LABEL_LONG_WRAP);
     lv_label_set_text(layer_label, "BASE");
@@ -238,13 +378,11 @@ static void create_left_panel(lv_obj_t *parent) {
 }
 
 static void create_modifier_panel(lv_obj_t *parent) {
-    const radii_color_palette_t *p = &color_palettes[current_palette];
-
     /* Modifier panel: 108x178, BOTTOM_RIGHT aligned with (0, -62) offset */
     mod_panel = lv_obj_create(parent);
     lv_obj_set_size(mod_panel, 108, 178);
     lv_obj_align(mod_panel, LV_ALIGN_BOTTOM_RIGHT, 0, -62);
-    lv_obj_set_style_bg_color(mod_panel, lv_color_hex(p->mod_panel_bg), LV_PART_MAIN);
+    lv_obj_add_style(mod_panel, &styles.mod_panel, LV_PART_MAIN);
     lv_obj_set_style_bg_opa(mod_panel, LV_OPA_COVER, LV_PART_MAIN);
     lv_obj_set_style_radius(mod_panel, 24, LV_PART_MAIN);
     lv_obj_set_style_border_width(mod_panel, 0, LV_PART_MAIN);
@@ -269,40 +407,32 @@ static void create_modifier_panel(lv_obj_t *parent) {
         mod_labels[i] = lv_label_create(mod_panel);
         lv_label_set_text(mod_labels[i], mod_symbols[i]);
         lv_obj_set_style_text_font(mod_labels[i], &Symbols_Semibold_32, LV_PART_MAIN);
-        lv_obj_set_style_text_color(mod_labels[i], lv_color_hex(p->mod_inactive), LV_PART_MAIN);
+        lv_obj_add_style(mod_labels[i], &styles.mod, LV_PART_MAIN);
+        lv_obj_add_style(mod_labels[i], &styles.mod_active, LV_PART_MAIN | LV_STATE_CHECKED);
         lv_obj_set_pos(mod_labels[i], mod_positions[i][0], mod_positions[i][1]);
     }
 }
 
 static lv_obj_t *create_arc(lv_obj_t *parent, int size, int x, int y, int width) {
-    const radii_color_palette_t *p = &color_palettes[current_palette];
-
-    lv_obj_t *arc = lv_arc_create(parent);
+    lv_obj_t *arc = ring_gauge_create(parent);
     lv_obj_set_size(arc, size, size);
     lv_obj_set_pos(arc, x, y);
-    lv_arc_set_range(arc, 0, 100);
-    lv_arc_set_value(arc, 0);
-    lv_arc_set_bg_angles(arc, 0, 360);
-    lv_arc_set_rotation(arc, 270);
     lv_obj_set_style_arc_width(arc, width, LV_PART_MAIN);
-    lv_obj_set_style_arc_color(arc, lv_color_hex(p->arc_bg), LV_PART_MAIN);
+    lv_obj_add_style(arc, &styles.arc, LV_PART_MAIN);
     lv_obj_set_style_arc_rounded(arc, true, LV_PART_MAIN);
     lv_obj_set_style_arc_width(arc, width, LV_PART_INDICATOR);
-    lv_obj_set_style_arc_color(arc, lv_color_hex(p->arc_bg), LV_PART_INDICATOR);
+    lv_obj_add_style(arc, &styles.arc, LV_PART_INDICATOR);
+    lv_obj_add_style(arc, &styles.arc_active, LV_PART_INDICATOR | LV_STATE_CHECKED);
     lv_obj_set_style_arc_rounded(arc, true, LV_PART_INDICATOR);
-    lv_obj_remove_style(arc, NULL, LV_PART_KNOB);
-    lv_obj_clear_flag(arc, LV_OBJ_FLAG_CLICKABLE);
     return arc;
 }
 
 static void create_battery_panel(lv_obj_t *parent) {
-    const radii_color_palette_t *p = &color_palettes[current_palette];
-
     /* Battery panel: 108x62 at (172, 178) - ORIGINAL POSITION */
     bat_panel = lv_obj_create(parent);
     lv_obj_set_size(bat_panel, 108, 62);
     lv_obj_set_pos(bat_panel, 172, 178);
-    lv_obj_set_style_bg_color(bat_panel, lv_color_hex(p->battery_panel_bg), LV_PART_MAIN);
+    lv_obj_add_style(bat_panel, &styles.battery_panel, LV_PART_MAIN);
     lv_obj_set_style_bg_opa(bat_panel, LV_OPA_COVER, LV_PART_MAIN);
     lv_obj_set_style_radius(bat_panel, 24, LV_PART_MAIN);
     lv_obj_set_style_border_width(bat_panel, 0, LV_PART_MAIN);
@@ -322,8 +452,6 @@ static void create_battery_panel(lv_obj_t *parent) {
 /* ========== Update Functions ========== */
 
 static void update_modifiers(uint8_t flags) {
-    const radii_color_palette_t *p = &color_palettes[current_palette];
-
     /* Order: CMD (GUI), OPT (ALT), CTRL, SHIFT (indices 0-3) */
     /* HID flags: bit 0/4=Ctrl, bit 1/5=Shift, bit 2/6=Alt, bit 3/7=GUI */
     bool mods[4] = {
@@ -335,24 +463,16 @@ static void update_modifiers(uint8_t flags) {
 
     for (int i = 0; i < 4; i++) {
         if (mod_labels[i]) {
-            lv_color_t color = mods[i] ? lv_color_hex(p->mod_active)
-                                       : lv_color_hex(p->mod_inactive);
-            lv_obj_set_style_text_color(mod_labels[i], color, LV_PART_MAIN);
+            lv_obj_set_state(mod_labels[i], LV_STATE_CHECKED, mods[i]);
         }
     }
 }
 
 static void update_battery(lv_obj_t *arc, uint8_t level, bool connected) {
-    const radii_color_palette_t *p = &color_palettes[current_palette];
-
     if (!arc) return;
-    if (connected && level > 0) {
-        lv_arc_set_value(arc, level);
-        lv_obj_set_style_arc_color(arc, lv_color_hex(p->arc_indicator), LV_PART_INDICATOR);
-    } else {
-        lv_arc_set_value(arc, 0);
-        lv_obj_set_style_arc_color(arc, lv_color_hex(p->arc_bg), LV_PART_INDICATOR);
-    }
+    bool shown = connected && level > 0;
+    ring_gauge_set_value(arc, shown ? level : 0);
+    lv_obj_set_state(arc, LV_STATE_CHECKED, shown);
 }
 
 /* ========== Palette Application ========== */
@@ -362,46 +482,11 @@ static void apply_palette(void) {
 
     const radii_color_palette_t *p = &color_palettes[current_palette];
 
-    /* Update left panel background */
-    if (left_panel) {
-        lv_obj_set_style_bg_color(left_panel, lv_color_hex(p->left_panel_bg), LV_PART_MAIN);
-    }
-
-    /* Update layer label text color */
-    if (layer_label) {
-        lv_obj_set_style_text_color(layer_label, lv_color_hex(p->layer_text), LV_PART_MAIN);
-    }
-
-    /* Redraw wheel with new colors */
-    if (wheel_canvas && wheel_image) {
-        draw_wheel(current_layer_count);
-        lv_image_set_src(wheel_image, lv_canvas_get_image(wheel_canvas));
-    }
-
-    /* Update modifier panel background */
-    if (mod_panel) {
-        lv_obj_set_style_bg_color(mod_panel, lv_color_hex(p->mod_panel_bg), LV_PART_MAIN);
-    }
-
-    /* Update modifier labels (inactive color for now) */
-    for (int i = 0; i < 4; i++) {
-        if (mod_labels[i]) {
-            lv_obj_set_style_text_color(mod_labels[i], lv_color_hex(p->mod_inactive), LV_PART_MAIN);
-        }
-    }
-
-    /* Update battery panel background */
-    if (bat_panel) {
-        lv_obj_set_style_bg_color(bat_panel, lv_color_hex(p->battery_panel_bg), LV_PART_MAIN);
-    }
-
-    /* Update battery arc colors */
-    if (bat_arc_left) {
-        lv_obj_set_style_arc_color(bat_arc_left, lv_color_hex(p->arc_bg), LV_PART_MAIN);
-    }
-    if (bat_arc_right) {
-        lv_obj_set_style_arc_color(bat_arc_right, lv_color_hex(p->arc_bg), LV_PART_MAIN);
-    }
+    /* Refreshing each panel's styles recolors and redraws it with its children */
+    styles_set_palette(p);
+    lv_obj_refresh_style(left_panel, LV_PART_ANY, LV_STYLE_PROP_ANY);
+    lv_obj_refresh_style(mod_panel, LV_PART_ANY, LV_STYLE_PROP_ANY);
+    lv_obj_refresh_style(bat_panel, LV_PART_ANY, LV_STYLE_PROP_ANY);
 
     LOG_INF("Applied palette: %s", p->name);
 }
@@ -420,6 +505,8 @@ lv_obj_t *radii_layout_create(lv_obj_t *parent) {
     lv_obj_set_style_bg_color(parent, lv_color_hex(0x000000), LV_PART_MAIN);
     lv_obj_set_style_bg_opa(parent, LV_OPA_COVER, LV_PART_MAIN);
 
+    styles_set_palette(&color_palettes[current_palette]);
+
     /* Create all elements directly on parent - ORIGINAL ORDER */
     create_left_panel(parent);
     create_modifier_panel(parent);
@@ -443,10 +530,9 @@ void radii_layout_update(uint8_t active_layer, const char *layer_name,
 #endif
 
     /* Redraw wheel if layer count changed */
-    if (layer_count != current_layer_count && wheel_canvas && wheel_image) {
-        draw_wheel(layer_count);
-        lv_image_set_src(wheel_image, lv_canvas_get_image(wheel_canvas));
+    if (layer_count != current_layer_count) {
         current_layer_count = layer_count;
+        wheel_refresh();
     }
 
     /* Rotate wheel on layer change */
@@ -495,8 +581,12 @@ void radii_layout_destroy(void) {
     if (bat_panel) { lv_obj_del(bat_panel); bat_panel = NULL; }
 
     /* Clear pointers */
+#if IS_ENABLED(CONFIG_PROSPECTOR_RADII_DIRECT_WHEEL)
+    wheel_obj = NULL;
+#else
     wheel_canvas = NULL;
     wheel_image = NULL;
+#endif
     layer_label = NULL;
     for (int i = 0; i < 4; i++) mod_labels[i] = NULL;
     bat_arc_left = NULL;
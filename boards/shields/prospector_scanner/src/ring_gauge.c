@@ -0,0 +1,129 @@
+/*
+ * Copyright (c) 2024 The ZMK Contributors
+ *
+ * SPDX-License-Identifier: MIT
+ */
+
+#include <lvgl.h>
+
+#include "ring_gauge.h"
+
+struct ring_gauge {
+    uint16_t start;
+    uint16_t sweep;
+    uint8_t value;
+};
+
+static int32_t value_angle(const struct ring_gauge *rg, uint8_t value) {
+    return rg->start + (int32_t)rg->sweep * value / 100;
+}
+
+/* Returns the radius */
+static int32_t ring_geometry(lv_obj_t *obj, lv_point_t *center) {
+    lv_area_t coords;
+    lv_obj_get_coords(obj, &coords);
+    int32_t radius = LV_MIN(lv_area_get_width(&coords), lv_area_get_height(&coords)) / 2;
+    center->x = coords.x1 + radius;
+    center->y = coords.y1 + radius;
+    return radius;
+}
+
+static void draw_arc(lv_layer_t *layer, lv_obj_t *obj, lv_part_t part,
+                     int32_t start, int32_t end) {
+    lv_draw_arc_dsc_t dsc;
+    lv_draw_arc_dsc_init(&dsc);
+    lv_obj_init_draw_arc_dsc(obj, part, &dsc);
+    dsc.radius = ring_geometry(obj, &dsc.center);
+    dsc.start_angle = start;
+    dsc.end_angle = end;
+    lv_draw_arc(layer, &dsc);
+}
+
+/* Segment between two value angles, with room for the wider part's caps */
+static void invalidate_segment(lv_obj_t *obj, int32_t from, int32_t to) {
+    if (from > to) {
+        int32_t tmp = from;
+        from = to;
+        to = tmp;
+    }
+    if (from == to) {
+        return;
+    }
+    if (to - from >= 360) {
+        lv_obj_invalidate(obj);
+        return;
+    }
+
+    lv_point_t center;
+    int32_t radius = ring_geometry(obj, &center);
+    int32_t width = LV_MAX(lv_obj_get_style_arc_width(obj, LV_PART_MAIN),
+                           lv_obj_get_style_arc_width(obj, LV_PART_INDICATOR));
+    bool rounded = lv_obj_get_style_arc_rounded(obj, LV_PART_MAIN) ||
+                   lv_obj_get_style_arc_rounded(obj, LV_PART_INDICATOR);
+
+    lv_area_t area;
+    lv_draw_arc_get_area(center.x, center.y, radius, from % 360, to % 360, width, rounded,
+                         &area);
+    lv_obj_invalidate_area(obj, &area);
+}
+
+static void event_cb(lv_event_t *e) {
+    lv_obj_t *obj = lv_event_get_target(e);
+    struct ring_gauge *rg = lv_obj_get_user_data(obj);
+
+    switch (lv_event_get_code(e)) {
+    case LV_EVENT_DRAW_MAIN: {
+        lv_layer_t *layer = lv_event_get_layer(e);
+        draw_arc(layer, obj, LV_PART_MAIN, rg->start, rg->start + rg->sweep);
+        if (rg->value > 0) {
+            draw_arc(layer, obj, LV_PART_INDICATOR, rg->start, value_angle(rg, rg->value));
+        }
+        break;
+    }
+    case LV_EVENT_DELETE:
+        lv_free(rg);
+        break;
+    default:
+        break;
+    }
+}
+
+lv_obj_t *ring_gauge_create(lv_obj_t *parent) {
+    struct ring_gauge *rg = lv_malloc(sizeof(*rg));
+    if (!rg) {
+        return NULL;
+    }
+    rg->start = 270;
+    rg->sweep = 360;
+    rg->value = 0;
+
+    lv_obj_t *obj = lv_obj_create(parent);
+    lv_obj_remove_style_all(obj);
+    lv_obj_clear_flag(obj, LV_OBJ_FLAG_CLICKABLE | LV_OBJ_FLAG_SCROLLABLE);
+    lv_obj_set_user_data(obj, rg);
+    lv_obj_add_event_cb(obj, event_cb, LV_EVENT_ALL, NULL);
+    return obj;
+}
+
+void ring_gauge_set_span(lv_obj_t *obj, uint16_t start, uint16_t sweep) {
+    struct ring_gauge *rg = lv_obj_get_user_data(obj);
+    if (!rg) {
+        return;
+    }
+    rg->start = start % 360;
+    rg->sweep = LV_CLAMP(1, sweep, 360);
+    lv_obj_invalidate(obj);
+}
+
+void ring_gauge_set_value(lv_obj_t *obj, int value) {
+    struct ring_gauge *rg = lv_obj_get_user_data(obj);
+    if (!rg) {
+        return;
+    }
+    uint8_t shown = LV_CLAMP(0, value, 100);
+    if (shown == rg->value) {
+        return;
+    }
+    invalidate_segment(obj, value_angle(rg, rg->value), value_angle(rg, shown));
+    rg->value = shown;
+}
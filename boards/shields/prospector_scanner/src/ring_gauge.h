@@ -0,0 +1,31 @@
+/*
+ * Copyright (c) 2024 The ZMK Contributors
+ *
+ * SPDX-License-Identifier: MIT
+ *
+ * Battery ring as one custom-drawn object, in place of lv_arc
+ *
+ * The background and value arcs are drawn in the draw callback of a plain
+ * object: no knob part, no theme styles, no input handling. Colors, width
+ * and rounded ends come from the object's arc styles, LV_PART_MAIN for the
+ * background and LV_PART_INDICATOR for the value, so the layouts' shared
+ * styles and state selectors apply unchanged. A value change invalidates
+ * only the ring segment between the old and the new end angle.
+ *
+ * Angles follow LVGL: 0 is 3 o'clock, growing clockwise. The ring is
+ * centered in the object with the radius of its shorter side.
+ */
+
+#pragma once
+
+#include <lvgl.h>
+
+/* LVGL thread: full ring starting at 12 o'clock, value 0, not clickable */
+lv_obj_t *ring_gauge_create(lv_obj_t *parent);
+
+/* LVGL thread: background from @p start clockwise over @p sweep degrees
+ * (1..360); the value arc grows from @p start over the same span */
+void ring_gauge_set_span(lv_obj_t *obj, uint16_t start, uint16_t sweep);
+
+/* LVGL thread: show @p value (clamped to 0..100). The same value is a no-op. */
+void ring_gauge_set_value(lv_obj_t *obj, int value);
@@ -0,0 +1,399 @@
+/*
+ * Copyright (c) 2024 The ZMK Contributors
+ *
+ * SPDX-License-Identifier: MIT
+ */
+
+#include <zephyr/kernel.h>
+#include <zephyr/sys/atomic.h>
+#include <zephyr/logging/log.h>
+#include <zephyr/bluetooth/bluetooth.h>
+#include <zephyr/bluetooth/gap.h>
+#include <string.h>
+#include <zmk/status_scanner.h>
+#include <zmk/status_advertisement.h>
+
+#include "scanner_pipeline_bench.h"
+#include "scanner_stub.h"
+
+LOG_MODULE_REGISTER(pipeline_bench, LOG_LEVEL_INF);
+
+#define BURST_MS 10           /* Injection step; BT RX gets reports in bursts as well */
+#define WARMUP_MS 500         /* First frame and name of each keyboard, then select one */
+#define PROBE_GAP_MS 100      /* Between layer changes of the probed keyboard */
+#define PROBE_TIMEOUT_MS 1000 /* A change the display never showed */
+#define BENCH_MAX_KEYBOARDS 5
+#define BENCH_LAYERS 8
+#define NOISE_DEVICES 16
+
+/* ========== Traffic ========== */
+
+/* Hand-written non-Prospector payloads (same set as the parse bench) */
+static const uint8_t noise_ibeacon[] = {
+    0x02, 0x01, 0x06, 0x1A, 0xFF, 0x4C, 0x00, 0x02, 0x15, 0xE2, 0xC5, 0x6D, 0xB5, 0xDF, 0xFB,
+    0x48, 0xD2, 0xB0, 0x60, 0xD0, 0xF5, 0xA7, 0x10, 0x96, 0xE0, 0x00, 0x01, 0x00, 0x02, 0xC5,
+};
+static const uint8_t noise_apple_nearby[] = {
+    0x02, 0x01, 0x1A, 0x02, 0x0A, 0x0C, 0x0A, 0xFF, 0x4C, 0x00, 0x10, 0x05, 0x01, 0x18, 0x1C,
+    0x2E, 0x4F,
+};
+static const uint8_t noise_mouse[] = {
+    0x02, 0x01, 0x06, 0x03, 0x03, 0x12, 0x18, 0x03, 0x19, 0xC2, 0x03, 0x0D, 0x09, 'M', 'X',
+    ' ', 'M', 'a', 's', 't', 'e', 'r', ' ', '3', 'S',
+};
+static const uint8_t noise_fast_pair[] = {
+    0x02, 0x01, 0x06, 0x06, 0x16, 0x2C, 0xFE, 0x00, 0x0C, 0x7E, 0x03, 0x02, 0x0A, 0xF4,
+};
+static const uint8_t noise_scan_rsp[] = {
+    0x0D, 0x09, 'M', 'a', 'c', 'B', 'o', 'o', 'k', ' ', 'P', 'r', 'o', '6',
+};
+
+static const struct {
+    const uint8_t *data;
+    uint8_t len;
+    uint8_t type;
+} noise[] = {
+    {noise_ibeacon, sizeof(noise_ibeacon), BT_GAP_ADV_TYPE_ADV_NONCONN_IND},
+    {noise_apple_nearby, sizeof(noise_apple_nearby), BT_GAP_ADV_TYPE_ADV_IND},
+    {noise_mouse, sizeof(noise_mouse), BT_GAP_ADV_TYPE_ADV_IND},
+    {noise_fast_pair, sizeof(noise_fast_pair), BT_GAP_ADV_TYPE_ADV_NONCONN_IND},
+    {noise_scan_rsp, sizeof(noise_scan_rsp), BT_GAP_ADV_TYPE_SCAN_RSP},
+};
+
+/* Legacy ADV_IND of a status keyboard: flags + manufacturer data */
+struct bench_frame {
+    uint8_t flags[3];
+    uint8_t md_len;
+    uint8_t md_type;
+    struct zmk_status_adv_data data;
+} __packed;
+
+BUILD_ASSERT(sizeof(struct bench_frame) <= 31, "Status frame must fit a legacy ADV");
+
+static struct {
+    bt_addr_le_t addr;
+    struct bench_frame frame;
+} kbds[BENCH_MAX_KEYBOARDS];
+
+static uint32_t rng_state;
+
+static uint32_t rng_next(void) {
+    /* xorshift32: the same stream every run */
+    rng_state ^= rng_state << 13;
+    rng_state ^= rng_state >> 17;
+    rng_state ^= rng_state << 5;
+    return rng_state;
+}
+
+static void keyboards_init(uint8_t count) {
+    for (int i = 0; i < count; i++) {
+        kbds[i].addr = (bt_addr_le_t){.type = BT_ADDR_LE_RANDOM,
+                                      .a = {.val = {0xB0 + i, 0x00, 0x5E, 0xBE, 0x00, 0xC7}}};
+
+        struct bench_frame *f = &kbds[i].frame;
+        *f = (struct bench_frame){
+            .flags = {0x02, BT_DATA_FLAGS, BT_LE_AD_GENERAL | BT_LE_AD_NO_BREDR},
+            .md_len = sizeof(struct zmk_status_adv_data) + 1,
+            .md_type = BT_DATA_MANUFACTURER_DATA,
+        };
+        struct zmk_status_adv_data *d = &f->data;
+        d->manufacturer_id[0] = 0xFF;
+        d->manufacturer_id[1] = 0xFF;
+        d->service_uuid[0] = ZMK_STATUS_ADV_SERVICE_UUID >> 8;
+        d->service_uuid[1] = ZMK_STATUS_ADV_SERVICE_UUID & 0xFF;
+        d->version = 0x22;
+        d->battery_level = 90 - i * 10;
+        d->profile_slot = 0;
+        d->connection_count = 1;
+        d->status_flags = ZMK_STATUS_FLAG_BLE_CONNECTED | ZMK_STATUS_FLAG_BLE_BONDED;
+        d->device_role = ZMK_DEVICE_ROLE_STANDALONE;
+        d->keyboard_id[0] = 0xBE;
+        d->keyboard_id[1] = 0x4C;
+        d->keyboard_id[3] = i;
+        d->channel = 0;
+    }
+}
+
+/* ========== Results ========== */
+
+static struct {
+    struct pipeline_bench_params p;
+    uint32_t kb_packets;
+    uint32_t noise_packets;
+    uint64_t cb_cycles;
+    uint32_t lat_min_us;
+    uint32_t lat_max_us;
+    uint64_t lat_sum_us;
+    uint32_t lat_count;
+    uint32_t lat_timeouts;
+} run;
+
+static atomic_t running = ATOMIC_INIT(0);
+
+static void inject(const bt_addr_le_t *addr, int8_t rssi, uint8_t type, const void *data,
+                   uint8_t len) {
+    struct net_buf_simple buf;
+
+    net_buf_simple_init_with_data(&buf, (void *)data, len);
+    uint32_t start = k_cycle_get_32();
+    zmk_status_scanner_inject_report(addr, rssi, type, &buf);
+    run.cb_cycles += k_cycle_get_32() - start;
+}
+
+static void inject_noise(void) {
+    uint32_t r = rng_next();
+    bt_addr_le_t addr = {.type = BT_ADDR_LE_RANDOM,
+                         .a = {.val = {r % NOISE_DEVICES, 0x4E, 0x01, 0x5E, 0x00, 0x5A}}};
+    const int n = (r >> 8) % ARRAY_SIZE(noise);
+
+    inject(&addr, -60 - (int8_t)((r >> 16) % 35), noise[n].type, noise[n].data, noise[n].len);
+    run.noise_packets++;
+}
+
+static void inject_keyboard(int i) {
+    struct zmk_status_adv_data *d = &kbds[i].frame.data;
+    uint32_t r = rng_next();
+
+    d->wpm_value = r % 120;
+    inject(&kbds[i].addr, -45 - (int8_t)((r >> 8) % 20), BT_GAP_ADV_TYPE_ADV_IND,
+           &kbds[i].frame, sizeof(kbds[i].frame));
+    run.kb_packets++;
+}
+
+static void inject_name(int i) {
+    uint8_t rsp[] = {0x08, BT_DATA_NAME_COMPLETE, 'B', 'e', 'n', 'c', 'h', ' ', '0' + i};
+
+    inject(&kbds[i].addr, -45, BT_GAP_ADV_TYPE_SCAN_RSP, rsp, sizeof(rsp));
+}
+
+/* ========== Display-Update Probe ========== */
+/* One layer change of the first bench keyboard at a time, from injection
+ * to the LVGL thread taking it with scanner_get_pending_update() */
+
+static atomic_t probe_layer = ATOMIC_INIT(-1);
+static uint32_t probe_cyc;
+
+void pipeline_bench_pending_taken(const struct pending_display_data *out) {
+    atomic_val_t layer = atomic_get(&probe_layer);
+
+    if (layer < 0 || !(out->dirty & PENDING_DIRTY_LAYER) || out->layer != layer) {
+        return;
+    }
+    if (!atomic_cas(&probe_layer, layer, -1)) {
+        return;
+    }
+    uint32_t us = k_cyc_to_us_floor32(k_cycle_get_32() - probe_cyc);
+    if (run.lat_count == 0 || us < run.lat_min_us) {
+        run.lat_min_us = us;
+    }
+    run.lat_max_us = MAX(run.lat_max_us, us);
+    run.lat_sum_us += us;
+    run.lat_count++;
+}
+
+/* Bench thread: true if a new probe may start */
+static bool probe_idle(void) {
+    atomic_val_t layer = atomic_get(&probe_layer);
+
+    if (layer < 0) {
+        return true;
+    }
+    if (k_cyc_to_ms_floor32(k_cycle_get_32() - probe_cyc) < PROBE_TIMEOUT_MS) {
+        return false;
+    }
+    if (atomic_cas(&probe_layer, layer, -1)) {
+        run.lat_timeouts++;
+    }
+    return true;
+}
+
+static void probe_start(void) {
+    struct zmk_status_adv_data *d = &kbds[0].frame.data;
+
+    d->active_layer = (d->active_layer + 1) % BENCH_LAYERS;
+    probe_cyc = k_cycle_get_32();
+    atomic_set(&probe_layer, d->active_layer);
+}
+
+static void select_probe_keyboard(void) {
+    struct zmk_keyboard_status kbd;
+
+    for (int i = 0; i < ZMK_STATUS_SCANNER_MAX_KEYBOARDS; i++) {
+        if (scanner_snapshot_keyboard(i, &kbd, NULL) &&
+            memcmp(kbd.ble_addr, kbds[0].addr.a.val, sizeof(kbd.ble_addr)) == 0) {
+            scanner_set_selected_keyboard(i);
+            return;
+        }
+    }
+    LOG_WRN("⏱ Bench keyboard 0 got no slot - display-update probes will time out");
+}
+
+/* ========== Run ========== */
+
+static void results_log(const struct scanner_pipeline_counts *before,
+                        const struct scanner_pipeline_counts *after) {
+    const struct pipeline_bench_params *p = &run.p;
+    uint32_t injected = run.kb_packets + run.noise_packets;
+    uint32_t queued = after->queued - before->queued;
+    uint32_t dropped = after->dropped - before->dropped;
+    uint32_t processed = after->processed - before->processed;
+    uint32_t offered = queued + dropped;
+    uint32_t drop_permille = offered ? dropped * 1000U / offered : 0;
+
+    LOG_INF("⏱ Pipeline bench: %u keyboards, %u%% noise, %u pps offered for %us",
+            p->keyboards, p->noise_pct, p->pps, p->seconds);
+    LOG_INF("⏱   injected %u pps (%u status, %u noise), scan callback %u cycles/pkt (%u Hz)",
+            injected / p->seconds, run.kb_packets, run.noise_packets,
+            injected ? (uint32_t)(run.cb_cycles / injected) : 0,
+            sys_clock_hw_cycles_per_sec());
+    LOG_INF("⏱   queued %u, dropped %u (%u.%u%%), processed %u/s", queued, dropped,
+            drop_permille / 10, drop_permille % 10, processed / p->seconds);
+    if (run.lat_count == 0) {
+        LOG_INF("⏱   display update: no layer change reached the display (%u timed out)",
+                run.lat_timeouts);
+        return;
+    }
+    LOG_INF("⏱   display update min %u avg %u max %u us (n=%u, %u timed out)",
+            run.lat_min_us, (uint32_t)(run.lat_sum_us / run.lat_count), run.lat_max_us,
+            run.lat_count, run.lat_timeouts);
+}
+
+static void bench_run(void) {
+    const struct pipeline_bench_params *p = &run.p;
+    struct scanner_pipeline_counts before, after;
+    /* Catching up after a slow burst is capped, so an overloaded callback
+     * shows as a lower injected rate instead of starving the work queue */
+    const uint32_t burst_max = p->pps * BURST_MS / 1000U * 2 + 1;
+
+    rng_state = 0x2545F491;
+    keyboards_init(p->keyboards);
+    for (int i = 0; i < p->keyboards; i++) {
+        inject_keyboard(i);
+        inject_name(i);
+    }
+    k_msleep(WARMUP_MS);
+    select_probe_keyboard();
+
+    run.kb_packets = 0;
+    run.noise_packets = 0;
+    run.cb_cycles = 0;
+    scanner_get_pipeline_counts(&before);
+
+    uint32_t start = k_uptime_get_32();
+    uint32_t duration_ms = p->seconds * 1000U;
+    uint32_t sent = 0;
+    uint32_t kb_turn = 0;
+    uint32_t next_probe_ms = 0;
+
+    for (;;) {
+        uint32_t elapsed = k_uptime_get_32() - start;
+        if (elapsed >= duration_ms) {
+            break;
+        }
+        uint32_t due = MIN((uint32_t)((uint64_t)elapsed * p->pps / 1000U), sent + burst_max);
+        for (; sent < due; sent++) {
+            if (rng_next() % 100 < p->noise_pct) {
+                inject_noise();
+                continue;
+            }
+            int i = kb_turn++ % p->keyboards;
+            if (i == 0 && elapsed >= next_probe_ms && probe_idle()) {
+                probe_start();
+                next_probe_ms = elapsed + PROBE_GAP_MS;
+            }
+            inject_keyboard(i);
+        }
+        k_msleep(BURST_MS);
+    }
+
+    /* Let the work handler drain and the last probe land */
+    k_msleep(PROBE_TIMEOUT_MS);
+    probe_idle();
+    scanner_get_pipeline_counts(&after);
+    results_log(&before, &after);
+}
+
+static K_SEM_DEFINE(start_sem, 0, 1);
+
+int pipeline_bench_start(const struct pipeline_bench_params *params) {
+    if (!atomic_cas(&running, 0, 1)) {
+        return -EBUSY;
+    }
+    memset(&run, 0, sizeof(run));
+    run.p = *params;
+    run.p.pps = CLAMP(run.p.pps, 10, 2000);
+    run.p.keyboards = CLAMP(run.p.keyboards, 1,
+                            MIN(BENCH_MAX_KEYBOARDS, ZMK_STATUS_SCANNER_MAX_KEYBOARDS));
+    run.p.noise_pct = MIN(run.p.noise_pct, 95);
+    run.p.seconds = CLAMP(run.p.seconds, 1, 60);
+    k_sem_give(&start_sem);
+    return 0;
+}
+
+static void bench_thread(void *p1, void *p2, void *p3) {
+    ARG_UNUSED(p1);
+    ARG_UNUSED(p2);
+    ARG_UNUSED(p3);
+
+#if CONFIG_PROSPECTOR_SCANNER_PIPELINE_BENCH_START_S > 0
+    const struct pipeline_bench_params boot = {
+        .pps = CONFIG_PROSPECTOR_SCANNER_PIPELINE_BENCH_PPS,
+        .keyboards = CONFIG_PROSPECTOR_SCANNER_PIPELINE_BENCH_KEYBOARDS,
+        .noise_pct = CONFIG_PROSPECTOR_SCANNER_PIPELINE_BENCH_NOISE_PERCENT,
+        .seconds = CONFIG_PROSPECTOR_SCANNER_PIPELINE_BENCH_SECONDS,
+    };
+    LOG_INF("⏱ Scanner pipeline bench starts in %ds",
+            CONFIG_PROSPECTOR_SCANNER_PIPELINE_BENCH_START_S);
+    k_sleep(K_SECONDS(CONFIG_PROSPECTOR_SCANNER_PIPELINE_BENCH_START_S));
+    pipeline_bench_start(&boot);
+#endif
+
+    for (;;) {
+        k_sem_take(&start_sem, K_FOREVER);
+        bench_run();
+        atomic_set(&running, 0);
+    }
+}
+
+/* Same priority and stack as the BT RX thread that normally runs the callback */
+K_THREAD_DEFINE(pipeline_bench_thread, CONFIG_BT_RX_STACK_SIZE, bench_thread, NULL, NULL, NULL,
+                K_PRIO_COOP(CONFIG_BT_RX_PRIO), 0, 0);
+
+#if IS_ENABLED(CONFIG_SHELL)
+#include <zephyr/shell/shell.h>
+#include <stdlib.h>
+
+/* "pipeline_bench [pps] [keyboards] [noise%] [seconds]", Kconfig defaults otherwise */
+static int cmd_pipeline_bench(const struct shell *sh, size_t argc, char **argv) {
+    struct pipeline_bench_params params = {
+        .pps = CONFIG_PROSPECTOR_SCANNER_PIPELINE_BENCH_PPS,
+        .keyboards = CONFIG_PROSPECTOR_SCANNER_PIPELINE_BENCH_KEYBOARDS,
+        .noise_pct = CONFIG_PROSPECTOR_SCANNER_PIPELINE_BENCH_NOISE_PERCENT,
+        .seconds = CONFIG_PROSPECTOR_SCANNER_PIPELINE_BENCH_SECONDS,
+    };
+
+    if (argc > 1) {
+        params.pps = (uint16_t)CLAMP(atoi(argv[1]), 10, 2000);
+    }
+    if (argc > 2) {
+        params.keyboards = (uint8_t)CLAMP(atoi(argv[2]), 1, BENCH_MAX_KEYBOARDS);
+    }
+    if (argc > 3) {
+        params.noise_pct = (uint8_t)CLAMP(atoi(argv[3]), 0, 95);
+    }
+    if (argc > 4) {
+        params.seconds = (uint8_t)CLAMP(atoi(argv[4]), 1, 60);
+    }
+    int rc = pipeline_bench_start(&params);
+    if (rc == -EBUSY) {
+        shell_error(sh, "A run is already in progress");
+        return rc;
+    }
+    shell_print(sh, "Running %us; results go to the log", params.seconds);
+    return 0;
+}
+
+SHELL_CMD_ARG_REGISTER(pipeline_bench, NULL,
+                       "Scanner pipeline bench [pps] [keyboards] [noise%] [seconds]",
+                       cmd_pipeline_bench, 1, 4);
+#endif
@@ -0,0 +1,37 @@
+/*
+ * Copyright (c) 2024 The ZMK Contributors
+ *
+ * SPDX-License-Identifier: MIT
+ *
+ * Scanner pipeline benchmark (CONFIG_PROSPECTOR_SCANNER_PIPELINE_BENCH)
+ *
+ * A bench thread at BT RX priority feeds synthetic advertisement reports
+ * straight into the scanner's scan callback: 1-5 keyboards sending legacy
+ * status frames, mixed with sample non-Prospector payloads, at a fixed
+ * total packet rate. Everything after the radio runs as usual:
+ *   scan callback   fast reject, device cache, parse (cycles per packet)
+ *   ring / mailbox  scanner_msg_send_keyboard_data() (queued vs dropped)
+ *   work handler    scanner_process_incoming() (frames processed per second)
+ *   LVGL thread     scanner_get_pending_update() took a layer change of
+ *                   the first bench keyboard (display-update latency)
+ * Real keyboards in range are processed as well and show up in the counts.
+ */
+
+#pragma once
+
+#include <stdint.h>
+
+struct pending_display_data;
+
+struct pipeline_bench_params {
+    uint16_t pps;        // Packets per second, keyboards and noise together
+    uint8_t keyboards;   // Bench keyboards (1-5)
+    uint8_t noise_pct;   // Share of non-Prospector packets
+    uint8_t seconds;     // Run length
+};
+
+/* LVGL thread: scanner_get_pending_update() is handing out @p out */
+void pipeline_bench_pending_taken(const struct pending_display_data *out);
+
+/* Start a run; -EBUSY if one is running */
+int pipeline_bench_start(const struct pipeline_bench_params *params);
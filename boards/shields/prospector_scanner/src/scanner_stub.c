@@ -10,18 +10,52 @@
  * Key design: Data processing (work handler) is separated from display
  * rendering (LVGL timer), matching v2.1.0's proven architecture.
  * The ring buffer eliminates mutex on the BT RX hot path.
+ *
+ * With CONFIG_PROSPECTOR_SCANNER_EVENT_DRIVEN, each frame kicks the work
+ * handler (with a minimum gap) and the handler wakes the LVGL timer when
+ * pending_data is ready; neither side polls.
+ *
+ * With CONFIG_PROSPECTOR_SCANNER_COALESCE, status frames overwrite a
+ * per-keyboard mailbox instead, and only transitions (layer, modifier,
+ * profile, connection) and static chunks go through the ring.
+ *
+ * With CONFIG_PROSPECTOR_LINK_STATS, every status frame of a slot -
+ * including repeats dropped before the ring - updates its link
+ * statistics (keyboards[].link) in the work handler.
  */
 
 #include <zephyr/kernel.h>
 #include <zephyr/init.h>
 #include <zephyr/logging/log.h>
 #include <zephyr/sys/atomic.h>
+#include <zephyr/sys/byteorder.h>
 #include <zmk/status_scanner.h>
 #include <zmk/status_advertisement.h>
+#include <zmk/keyboard_names.h>
+#include <zmk/prospector_rate.h>
+#include <zmk/prospector_trace.h>
+
+#include "scanner_stub.h"
+#include "layer_name_cache.h"
+
+#if IS_ENABLED(CONFIG_PROSPECTOR_KEYBOARD_REGISTRY)
+#include "keyboard_registry.h"
+#endif
+#if IS_ENABLED(CONFIG_PROSPECTOR_LATENCY_STATS)
+#include "latency_stats.h"
+#endif
+#if IS_ENABLED(CONFIG_PROSPECTOR_BOOT_TIMING)
+#include "boot_timing.h"
+#endif
+#if IS_ENABLED(CONFIG_PROSPECTOR_SCANNER_PIPELINE_BENCH)
+#include "scanner_pipeline_bench.h"
+#endif
 #include <lvgl.h>
 
 #if IS_ENABLED(CONFIG_ZMK_BATTERY_REPORTING)
 #include <zmk/battery.h>
+#include <zmk/event_manager.h>
+#include <zmk/events/battery_state_changed.h>
 #endif
 
 #if IS_ENABLED(CONFIG_USB_DEVICE_STACK)
@@ -33,28 +67,145 @@ LOG_MODULE_REGISTER(scanner_handler, LOG_LEVEL_INF);
 /* External scanner start function (from status_scanner.c) */
 extern int zmk_status_scanner_start(void);
 
+#if IS_ENABLED(CONFIG_PROSPECTOR_SCANNER_DISPLAY_SLEEP)
+/* Defined in custom_status_screen.c: leaves display sleep */
+extern void scanner_display_resume(void);
+#endif
+
 /* ========== Keyboard Data Storage ========== */
-/* Protected by data_mutex: work handler writes, LVGL timer reads */
+/* Written by the work handler with data_mutex held. Other threads read a
+ * slot through scanner_snapshot_keyboard(), which needs no lock. */
 /* Uses struct zmk_keyboard_status from zmk/status_scanner.h as single source of truth */
 
 #define MAX_KEYBOARDS ZMK_STATUS_SCANNER_MAX_KEYBOARDS
-#define MAX_NAME_LEN 32
 
 static struct zmk_keyboard_status keyboards[MAX_KEYBOARDS];
 static int selected_keyboard = 0;
 static struct k_mutex data_mutex;
 static bool mutex_initialized = false;
 
+#if IS_ENABLED(CONFIG_PROSPECTOR_KEYBOARD_REGISTRY)
+/* Inactive slot kept (and indexed) for a keyboard in the registry: its
+ * address, ID, role and name are filled in, so it returns to this slot */
+static bool slot_known[MAX_KEYBOARDS];
+#define SLOT_KNOWN(i) slot_known[i]
+#else
+#define SLOT_KNOWN(i) false
+#endif
+
+/* ========== Slot Seqlock ========== */
+/* Per-slot sequence counter, odd while the work handler is writing the
+ * slot. Readers copy the slot and retry if the counter moved; the even
+ * value doubles as the slot's generation for change detection. */
+
+#define SNAPSHOT_RETRIES 4
+
+static atomic_t slot_seq[MAX_KEYBOARDS];
+
+static void slot_write_begin(int index) {
+    atomic_inc(&slot_seq[index]);
+    __DMB();  /* Counter odd before any field changes */
+}
+
+static void slot_write_end(int index) {
+    __DMB();  /* Fields written before the counter turns even */
+    atomic_inc(&slot_seq[index]);
+}
+
+bool scanner_snapshot_keyboard(int index, struct zmk_keyboard_status *out, uint32_t *gen) {
+    if (index < 0 || index >= MAX_KEYBOARDS) {
+        return false;
+    }
+
+    for (int tries = 0; tries < SNAPSHOT_RETRIES; tries++) {
+        uint32_t seq = (uint32_t)atomic_get(&slot_seq[index]);
+        if (seq & 1) {
+            k_yield();  /* Let a preempted writer finish */
+            continue;
+        }
+        __DMB();
+        *out = keyboards[index];
+        __DMB();
+        if ((uint32_t)atomic_get(&slot_seq[index]) == seq) {
+            if (gen) {
+                *gen = seq;
+            }
+            return out->active;
+        }
+    }
+
+    /* Still contended: every write happens under data_mutex, so waiting
+     * for it gives a consistent copy too */
+    if (!mutex_initialized || k_mutex_lock(&data_mutex, K_MSEC(10)) != 0) {
+        return false;
+    }
+    *out = keyboards[index];
+    if (gen) {
+        *gen = (uint32_t)atomic_get(&slot_seq[index]);
+    }
+    k_mutex_unlock(&data_mutex);
+    return out->active;
+}
+
+uint32_t scanner_keyboard_generation(int index) {
+    if (index < 0 || index >= MAX_KEYBOARDS) {
+        return 0;
+    }
+    return (uint32_t)atomic_get(&slot_seq[index]) & ~1u;
+}
+
+int scanner_for_each_keyboard(uint32_t *seen_gen,
+                              void (*fn)(int index, const struct zmk_keyboard_status *kbd,
+                                         void *user_data),
+                              void *user_data) {
+    struct zmk_keyboard_status kbd;
+    int active = 0;
+
+    for (int i = 0; i < MAX_KEYBOARDS; i++) {
+        uint32_t gen = UINT32_MAX;  /* Odd: never a real generation */
+        if (seen_gen && scanner_keyboard_generation(i) == seen_gen[i]) {
+            active += keyboards[i].active ? 1 : 0;
+            continue;  /* Unchanged since the caller's last pass */
+        }
+        if (!scanner_snapshot_keyboard(i, &kbd, &gen)) {
+            if (seen_gen && gen != UINT32_MAX) {
+                seen_gen[i] = gen;  /* Inactive; failed copies are retried next pass */
+            }
+            continue;
+        }
+        active++;
+        if (seen_gen) {
+            seen_gen[i] = gen;
+        }
+        fn(i, &kbd, user_data);
+    }
+    return active;
+}
+
 /* ========== SPSC Ring Buffer (BT RX → LVGL timer) ========== */
 
 #define INCOMING_BUF_SIZE 16  /* Must be power of 2 */
 
 struct incoming_adv {
-    struct zmk_status_adv_data data;
+    union {
+        struct zmk_status_adv_data data;
+        struct zmk_status_adv_static_frame static_frame;  /* When is_static */
+    };
+    bool is_static;
+    uint32_t rx_time;  /* k_uptime_get_32() in scan_callback */
+    /* No reference of its own (the device cache holds one): read it with
+     * zmk_keyboard_name_copy() or take one with zmk_keyboard_name_set() */
+    zmk_keyboard_name_t name;
     int8_t rssi;
-    char name[MAX_NAME_LEN];
     uint8_t ble_addr[6];
     uint8_t ble_addr_type;
+    struct zmk_status_adv_ext_fields ext;  /* Zeroed for legacy frames */
+#if IS_ENABLED(CONFIG_PROSPECTOR_SCANNER_COALESCE)
+    uint32_t post_seq;  /* Mailbox post order; ring copies of a post keep it */
+#endif
+#if IS_ENABLED(CONFIG_PROSPECTOR_LINK_STATS) && IS_ENABLED(CONFIG_PROSPECTOR_SCANNER_COALESCE)
+    uint16_t frames;  /* Mailbox copies: frames posted since the last one (ring: 0) */
+#endif
 };
 
 static struct incoming_adv incoming_buf[INCOMING_BUF_SIZE];
@@ -67,14 +218,296 @@ static int incoming_push(const struct incoming_adv *entry) {
     uint8_t next = (wi + 1) & (INCOMING_BUF_SIZE - 1);
     uint8_t ri = incoming_read_idx & (INCOMING_BUF_SIZE - 1);
     if (next == ri) {
+        PSPTR_TRACE_MARK("psptr_drop", wi);
         return -ENOMEM;  /* Buffer full, drop */
     }
     incoming_buf[wi] = *entry;
     __DMB();  /* ARM memory barrier: ensure data written before index update */
     incoming_write_idx = next;
+    PSPTR_TRACE_MARK("psptr_push", wi);
     return 0;
 }
 
+/* Changes the display shows immediately rather than on the 1Hz refresh */
+static bool status_transition(const struct zmk_status_adv_data *old_data,
+                              const struct zmk_status_adv_data *new_data) {
+    const uint8_t conn_mask = ZMK_STATUS_FLAG_USB_HID_READY | ZMK_STATUS_FLAG_BLE_CONNECTED;
+
+    return old_data->active_layer != new_data->active_layer ||
+           old_data->modifier_flags != new_data->modifier_flags ||
+           PROSPECTOR_DECODE_PROFILE(old_data->profile_slot) !=
+               PROSPECTOR_DECODE_PROFILE(new_data->profile_slot) ||
+           (old_data->status_flags & conn_mask) != (new_data->status_flags & conn_mask);
+}
+
+#if IS_ENABLED(CONFIG_PROSPECTOR_SCANNER_COALESCE)
+/* ========== Latest-Frame Mailboxes (BT RX → work handler) ========== */
+/* One mailbox per advertiser address, overwritten by every status frame.
+ * Single writer (BT RX), single reader (work handler), guarded by a
+ * sequence counter that is odd while a write is in progress. The reader
+ * retries a torn copy a few times and otherwise picks it up next run. */
+
+#define MAILBOX_COUNT (MAX_KEYBOARDS + 2)  /* Spare for advertisers that never get a slot */
+#define MAILBOX_READ_RETRIES 4
+
+static struct {
+    volatile uint32_t seq;  /* BT RX only writes */
+    uint32_t read_seq;      /* Work handler only: seq of the last snapshot */
+    bool used;              /* BT RX only */
+    struct incoming_adv entry;
+} mailbox[MAILBOX_COUNT];
+
+/* Counts every post across all mailboxes (BT RX only writes), so frames
+ * keep their order even within one millisecond and when a keyboard moves
+ * to another mailbox after an address change */
+static uint32_t mailbox_post_count;
+
+/* post_seq of the newest frame applied per slot: a transition event from
+ * the ring can arrive after the mailbox already delivered a newer frame */
+static uint32_t slot_post_seq[MAX_KEYBOARDS];
+
+/* Mailbox for ble_addr; a new one replaces a free or the longest-silent box */
+static int mailbox_find(const uint8_t *ble_addr, bool *is_new) {
+    int victim = -1;
+
+    for (int i = 0; i < MAILBOX_COUNT; i++) {
+        if (!mailbox[i].used) {
+            if (victim < 0 || mailbox[victim].used) {
+                victim = i;
+            }
+            continue;
+        }
+        if (memcmp(mailbox[i].entry.ble_addr, ble_addr, 6) == 0) {
+            *is_new = false;
+            return i;
+        }
+        if (victim < 0 || (mailbox[victim].used &&
+                           (int32_t)(mailbox[i].entry.rx_time - mailbox[victim].entry.rx_time) < 0)) {
+            victim = i;
+        }
+    }
+    *is_new = true;
+    return victim;
+}
+
+/* BT RX thread (producer) */
+static void mailbox_post(const struct zmk_status_adv_data *adv_data, int8_t rssi,
+                         zmk_keyboard_name_t device_name, const uint8_t *ble_addr,
+                         uint8_t ble_addr_type,
+                         const struct zmk_status_adv_ext_fields *ext) {
+    bool is_new;
+    int i = mailbox_find(ble_addr, &is_new);
+    struct incoming_adv *e = &mailbox[i].entry;
+    bool transition = !is_new && status_transition(&e->data, adv_data);
+
+    mailbox[i].seq++;  /* Odd: write in progress */
+    __DMB();
+    if (is_new) {
+        memset(e, 0, sizeof(*e));
+        memcpy(e->ble_addr, ble_addr, 6);
+        mailbox[i].used = true;
+    }
+    e->data = *adv_data;
+    e->rx_time = k_uptime_get_32();
+    e->post_seq = ++mailbox_post_count;
+    e->rssi = rssi;
+    e->ble_addr_type = ble_addr_type;
+    if (ext) {
+        e->ext = *ext;
+    } else {
+        memset(&e->ext, 0, sizeof(e->ext));
+    }
+    if (device_name != ZMK_KEYBOARD_NAME_NONE) {
+        e->name = device_name;
+    }
+    __DMB();
+    mailbox[i].seq++;
+
+    /* Keep every transition even if a later frame overwrites the mailbox
+     * before the work handler runs. A full ring loses nothing but the
+     * intermediate state: the mailbox still holds the latest frame. */
+    if (transition && incoming_push(e) != 0) {
+        LOG_DBG("Transition queue full, coalesced into mailbox %d", i);
+    }
+}
+
+/* Work handler (consumer): copy out mailbox i if it changed since last run */
+static bool mailbox_snapshot(int i, struct incoming_adv *out) {
+    for (int tries = 0; tries < MAILBOX_READ_RETRIES; tries++) {
+        uint32_t seq = mailbox[i].seq;
+        if (seq == mailbox[i].read_seq) {
+            return false;
+        }
+        if (seq & 1) {
+            continue;
+        }
+        __DMB();
+        *out = mailbox[i].entry;
+        __DMB();
+        if (mailbox[i].seq == seq) {
+#if IS_ENABLED(CONFIG_PROSPECTOR_LINK_STATS)
+            out->frames = (uint16_t)MIN((seq - mailbox[i].read_seq) / 2, UINT16_MAX);
+#endif
+            mailbox[i].read_seq = seq;
+            return true;
+        }
+    }
+    return false;
+}
+#endif
+
+/* ========== Repeat Tally (BT RX → work handler) ========== */
+/* Frames dropped as repeats (same seq) before the ring are most of an
+ * idle keyboard's traffic. With CONFIG_PROSPECTOR_LINK_STATS they are
+ * counted per address and handed to the work handler, so a slot's link
+ * statistics see every frame. BT RX owns addr/used; count and last_rx
+ * are atomic. A box is only reassigned when more sequence-numbered
+ * advertisers than boxes are around. */
+
+#if IS_ENABLED(CONFIG_PROSPECTOR_LINK_STATS)
+#define TALLY_COUNT (MAX_KEYBOARDS + 2)
+
+static struct {
+    uint8_t addr[6];
+    bool used;
+    int8_t rssi;
+    atomic_t last_rx;
+    atomic_t count;
+} repeat_tally[TALLY_COUNT];
+
+/* BT RX thread */
+static void repeat_tally_add(const uint8_t *ble_addr, int8_t rssi) {
+    int box = -1;
+    int victim = 0;  /* Free box, else the longest-silent one */
+
+    for (int i = 0; i < TALLY_COUNT; i++) {
+        if (repeat_tally[i].used && memcmp(repeat_tally[i].addr, ble_addr, 6) == 0) {
+            box = i;
+            break;
+        }
+        if (!repeat_tally[i].used) {
+            victim = i;
+        } else if (repeat_tally[victim].used &&
+                   (int32_t)(atomic_get(&repeat_tally[i].last_rx) -
+                             atomic_get(&repeat_tally[victim].last_rx)) < 0) {
+            victim = i;
+        }
+    }
+    if (box < 0) {
+        box = victim;
+        atomic_clear(&repeat_tally[box].count);
+        memcpy(repeat_tally[box].addr, ble_addr, 6);
+        repeat_tally[box].used = true;
+    }
+    repeat_tally[box].rssi = rssi;
+    atomic_set(&repeat_tally[box].last_rx, (atomic_val_t)k_uptime_get_32());
+    atomic_inc(&repeat_tally[box].count);
+}
+#endif
+
+/* ========== Static Packet Reassembly ========== */
+/* One assembly per keyboard slot. Chunks whose hash matches the slot's
+ * static_info.hash are dropped on arrival, so after the first complete
+ * packet nothing is copied until the keyboard's static info changes. */
+
+static struct {
+    uint8_t hash;       /* Hash being assembled, 0 = idle */
+    uint8_t count;      /* Expected chunks */
+    uint8_t have_mask;  /* Bit per received chunk */
+    uint8_t blob[ZMK_STATUS_ADV_STATIC_MAX_LEN];
+} static_rx[MAX_KEYBOARDS];
+
+/* Layer name cache entry of each slot, LAYER_NAME_CACHE_NONE if none.
+ * An entry handed to another keyboard is dropped from the slot that had it. */
+static int8_t slot_name_entry[MAX_KEYBOARDS];
+
+static void slot_set_name_entry(int index, int entry) {
+    for (int i = 0; i < MAX_KEYBOARDS; i++) {
+        if (entry != LAYER_NAME_CACHE_NONE && slot_name_entry[i] == entry) {
+            slot_name_entry[i] = LAYER_NAME_CACHE_NONE;
+        }
+    }
+    slot_name_entry[index] = entry;
+}
+
+/* Decode a complete blob into keyboards[index]; false if malformed */
+static bool static_decode(int index) {
+    const uint8_t *blob = static_rx[index].blob;
+    const size_t size = static_rx[index].count * ZMK_STATUS_ADV_STATIC_CHUNK_LEN;
+    struct zmk_status_adv_static_info info = {0};
+    char name[ZMK_STATUS_ADV_STATIC_NAME_MAX + 1];
+    size_t pos = 0;
+
+    uint8_t name_len = blob[pos++];
+    if (name_len > ZMK_STATUS_ADV_STATIC_NAME_MAX || pos + name_len + 1 > size) {
+        return false;
+    }
+    memcpy(name, &blob[pos], name_len);
+    name[name_len] = '\0';
+    pos += name_len;
+
+    info.layer_count = blob[pos++];
+    if (info.layer_count > ZMK_STATUS_ADV_STATIC_MAX_LAYERS) {
+        return false;
+    }
+    for (uint8_t i = 0; i < info.layer_count; i++) {
+        if (pos >= size) {
+            return false;
+        }
+        uint8_t len = blob[pos++];
+        if (len > ZMK_STATUS_ADV_EXT_LAYER_NAME_MAX || pos + len > size) {
+            return false;
+        }
+        memcpy(info.layer_names[i], &blob[pos], len);
+        info.layer_names[i][len] = '\0';
+        pos += len;
+    }
+
+    info.hash = static_rx[index].hash;
+    keyboards[index].static_info = info;
+    slot_set_name_entry(index, layer_name_cache_store(&keyboards[index].data, &info));
+    zmk_keyboard_name_set_str(&keyboards[index].name, name, name_len);
+    return true;
+}
+
+/* Feed one chunk; returns true when it completed a new static packet */
+static bool static_assemble(int index, const struct zmk_status_adv_static_frame *frame) {
+    uint8_t chunk = frame->chunk >> 4;
+    uint8_t count = frame->chunk & 0x0F;
+
+    if (frame->static_hash == 0 || frame->static_hash == keyboards[index].static_info.hash) {
+        return false;  /* Already have this one: the common case */
+    }
+    if (count == 0 || count > ZMK_STATUS_ADV_STATIC_MAX_CHUNKS || chunk >= count) {
+        return false;
+    }
+
+    if (static_rx[index].hash != frame->static_hash || static_rx[index].count != count) {
+        static_rx[index].hash = frame->static_hash;
+        static_rx[index].count = count;
+        static_rx[index].have_mask = 0;
+    }
+
+    memcpy(&static_rx[index].blob[chunk * ZMK_STATUS_ADV_STATIC_CHUNK_LEN], frame->data,
+           ZMK_STATUS_ADV_STATIC_CHUNK_LEN);
+    static_rx[index].have_mask |= BIT(chunk);
+
+    if (static_rx[index].have_mask != BIT_MASK(count)) {
+        return false;
+    }
+
+    bool ok = static_decode(index);
+    static_rx[index].hash = 0;
+    if (!ok) {
+        LOG_WRN("Malformed static packet from slot %d (hash 0x%02X)", index, frame->static_hash);
+        return false;
+    }
+    LOG_INF("Static packet slot %d: \"%s\", %d layers (hash 0x%02X)", index,
+            zmk_keyboard_name_str(keyboards[index].name), keyboards[index].static_info.layer_count,
+            keyboards[index].static_info.hash);
+    return true;
+}
+
 /* Pop one entry from LVGL timer context (consumer) */
 static bool incoming_pop(struct incoming_adv *out) {
     uint8_t ri = incoming_read_idx & (INCOMING_BUF_SIZE - 1);
@@ -85,48 +518,28 @@ static bool incoming_pop(struct incoming_adv *out) {
     *out = incoming_buf[ri];
     __DMB();  /* ARM memory barrier: ensure data read before index update */
     incoming_read_idx = (ri + 1) & (INCOMING_BUF_SIZE - 1);
+    PSPTR_TRACE_MARK("psptr_pop", ri);
     return true;
 }
 
-/* ========== Pending Display Data (set by LVGL timer, read by LVGL timer) ========== */
-
-struct pending_display_data {
-    volatile bool update_pending;
-    volatile bool signal_update_pending;  /* Signal widget updates separately (1Hz) */
-    volatile bool no_keyboards;           /* True when all keyboards timed out */
+/* ========== Pending Display Data (set by work handler, read by LVGL timer) ========== */
+/* struct pending_display_data and PENDING_DIRTY_* are in scanner_stub.h */
 
-    char device_name[MAX_NAME_LEN];
-    char layer_name[4];
-    int layer;
-    int wpm;
-    bool usb_ready;
-    bool ble_connected;
-    bool ble_bonded;
-    int profile;
-    uint8_t modifiers;
-    int bat[4];
-    int8_t rssi;
-    float rate_hz;
-    int scanner_battery;
-    bool scanner_battery_pending;
-
-    /* Keyboard firmware version (decoded from version + profile_slot fields) */
-    uint8_t kb_version_major;
-    uint8_t kb_version_minor;
-    uint8_t kb_version_patch;
-    bool kb_version_dev;
-    bool kb_version_valid;       /* True after first keyboard data received */
-};
-
-static struct pending_display_data pending_data = {0};
+static struct pending_display_data pending_data = {.layer_names = LAYER_NAME_CACHE_NONE};
+static atomic_t pending_dirty = ATOMIC_INIT(0);  /* Accumulated until the next take */
 
 /* Getter for pending data - called from LVGL timer in main thread */
 bool scanner_get_pending_update(struct pending_display_data *out) {
     if (!pending_data.update_pending) {
         return false;
     }
-    *out = pending_data;
     pending_data.update_pending = false;
+    uint32_t dirty = (uint32_t)atomic_clear(&pending_dirty);
+    *out = pending_data;
+    out->dirty = dirty;
+#if IS_ENABLED(CONFIG_PROSPECTOR_SCANNER_PIPELINE_BENCH)
+    pipeline_bench_pending_taken(out);
+#endif
     return true;
 }
 
@@ -159,8 +572,7 @@ bool scanner_get_kb_version(uint8_t *major, uint8_t *minor, uint8_t *patch,
     if (patch) *patch = pending_data.kb_version_patch;
     if (is_dev) *is_dev = pending_data.kb_version_dev;
     if (name && name_len > 0) {
-        strncpy(name, pending_data.device_name, name_len - 1);
-        name[name_len - 1] = '\0';
+        zmk_keyboard_name_copy(pending_data.device_name, name, name_len);
     }
     return true;
 }
@@ -176,46 +588,39 @@ bool scanner_get_pending_battery(int *level) {
 }
 
 /* ========== Public API for Display ========== */
-/* All functions accessing keyboards[] are mutex-protected (matching v2.2a) */
+/* Readers copy slots with scanner_snapshot_keyboard() (no lock on the fast path) */
 
 bool scanner_get_keyboard_data(int index, struct zmk_status_adv_data *data,
                                int8_t *rssi, char *name, size_t name_len) {
-    if (!mutex_initialized || index < 0 || index >= MAX_KEYBOARDS) {
-        return false;
-    }
+    struct zmk_keyboard_status kbd;
 
-    if (k_mutex_lock(&data_mutex, K_MSEC(10)) != 0) {
+    if (!scanner_snapshot_keyboard(index, &kbd, NULL)) {
         return false;
     }
-
-    bool result = false;
-    if (keyboards[index].active) {
-        if (data) *data = keyboards[index].data;
-        if (rssi) *rssi = keyboards[index].rssi;
-        if (name && name_len > 0) {
-            strncpy(name, keyboards[index].ble_name, name_len - 1);
-            name[name_len - 1] = '\0';
-        }
-        result = true;
+    if (data) *data = kbd.data;
+    if (rssi) *rssi = kbd.rssi;
+    if (name && name_len > 0) {
+        zmk_keyboard_name_copy(kbd.name, name, name_len);
     }
-
-    k_mutex_unlock(&data_mutex);
-    return result;
+    return true;
 }
 
-int scanner_get_active_keyboard_count(void) {
-    if (!mutex_initialized) return 0;
+bool scanner_get_static_info(struct zmk_status_adv_static_info *out) {
+    struct zmk_keyboard_status kbd;
 
-    if (k_mutex_lock(&data_mutex, K_MSEC(10)) != 0) {
-        return 0;
+    if (!scanner_snapshot_keyboard(selected_keyboard, &kbd, NULL) || kbd.static_info.hash == 0) {
+        return false;
     }
+    *out = kbd.static_info;
+    return true;
+}
 
+int scanner_get_active_keyboard_count(void) {
+    /* Single flags: no snapshot needed for a count */
     int count = 0;
     for (int i = 0; i < MAX_KEYBOARDS; i++) {
         if (keyboards[i].active) count++;
     }
-
-    k_mutex_unlock(&data_mutex);
     return count;
 }
 
@@ -223,10 +628,20 @@ int scanner_get_selected_keyboard(void) {
     return selected_keyboard;
 }
 
+bool scanner_get_keyboard_address(int index, uint8_t *addr, uint8_t *addr_type) {
+    if (index < 0 || index >= MAX_KEYBOARDS ||
+        (!keyboards[index].active && !SLOT_KNOWN(index))) {
+        return false;
+    }
+    memcpy(addr, keyboards[index].ble_addr, 6);
+    *addr_type = keyboards[index].ble_addr_type;
+    return true;
+}
+
 struct zmk_keyboard_status *scanner_get_keyboard_status(int index) {
-    /* Note: Returns pointer under mutex protection. Caller must not hold
-     * the pointer across long operations. For keyboard selection screen,
-     * copy the data immediately. */
+    /* Note: The pointed-to slot keeps changing under the work handler.
+     * Only safe from the work queue itself; other threads should use
+     * scanner_snapshot_keyboard(). */
     if (!mutex_initialized || index < 0 || index >= MAX_KEYBOARDS) {
         return NULL;
     }
@@ -241,39 +656,91 @@ struct zmk_keyboard_status *scanner_get_keyboard_status(int index) {
     return result;
 }
 
-/* Helper: populate pending_data from keyboards[selected_keyboard] */
-static void fill_pending_from_selected(void) {
+/* Store value into pending_data.field, marking bit dirty if it changed */
+#define PENDING_SET(field, value, bit)           \
+    do {                                         \
+        if (pending_data.field != (value)) {     \
+            pending_data.field = (value);        \
+            dirty |= (bit);                      \
+        }                                        \
+    } while (0)
+
+/* Helper: populate pending_data from keyboards[selected_keyboard].
+ * Only changed field groups are marked dirty, and nothing is posted if
+ * none changed. force marks everything (new selection, rebuilt widgets). */
+static void fill_pending_from_selected(bool force) {
     struct zmk_status_adv_data *d;
+    uint32_t dirty = 0;
     if (selected_keyboard < 0 || selected_keyboard >= MAX_KEYBOARDS ||
         !keyboards[selected_keyboard].active) {
         return;
     }
 
     d = &keyboards[selected_keyboard].data;
-    strncpy(pending_data.device_name, keyboards[selected_keyboard].ble_name, MAX_NAME_LEN - 1);
-    pending_data.device_name[MAX_NAME_LEN - 1] = '\0';
-    memcpy(pending_data.layer_name, d->layer_name, sizeof(pending_data.layer_name));
-    pending_data.layer = d->active_layer;
-    pending_data.wpm = d->wpm_value;
-    pending_data.usb_ready = (d->status_flags & ZMK_STATUS_FLAG_USB_HID_READY) != 0;
-    pending_data.ble_connected = (d->status_flags & ZMK_STATUS_FLAG_BLE_CONNECTED) != 0;
-    pending_data.ble_bonded = (d->status_flags & ZMK_STATUS_FLAG_BLE_BONDED) != 0;
-    pending_data.profile = PROSPECTOR_DECODE_PROFILE(d->profile_slot);
-    pending_data.modifiers = d->modifier_flags;
-    pending_data.bat[0] = d->battery_level;
-    pending_data.bat[1] = d->peripheral_battery[0];
-    pending_data.bat[2] = d->peripheral_battery[1];
-    pending_data.bat[3] = d->peripheral_battery[2];
+    PENDING_SET(device_name, keyboards[selected_keyboard].name, PENDING_DIRTY_NAME);
+
+    /* With the static packet's table in the layer name cache the display
+     * reads the name by index, so only the index is passed on. Otherwise
+     * use the full name from extended ADV, else the 4-char compact one. */
+    int8_t names = slot_name_entry[selected_keyboard];
+    PENDING_SET(layer_names, names, PENDING_DIRTY_LAYER);
+    if (!layer_name_cache_get(names, d->active_layer)) {
+        char layer_name[sizeof(pending_data.layer_name)];
+        if (keyboards[selected_keyboard].ext.layer_name[0] != '\0') {
+            strncpy(layer_name, keyboards[selected_keyboard].ext.layer_name,
+                    sizeof(layer_name) - 1);
+            layer_name[sizeof(layer_name) - 1] = '\0';
+        } else {
+            memcpy(layer_name, d->layer_name, sizeof(d->layer_name));
+            layer_name[sizeof(d->layer_name)] = '\0';
+        }
+        if (strcmp(pending_data.layer_name, layer_name) != 0) {
+            memcpy(pending_data.layer_name, layer_name, sizeof(layer_name));
+            dirty |= PENDING_DIRTY_LAYER;
+        }
+    }
+    PENDING_SET(layer, d->active_layer, PENDING_DIRTY_LAYER);
+    PENDING_SET(static_hash, keyboards[selected_keyboard].static_info.hash, PENDING_DIRTY_LAYER);
+    PENDING_SET(wpm, d->wpm_value, PENDING_DIRTY_WPM);
+    PENDING_SET(usb_ready, (d->status_flags & ZMK_STATUS_FLAG_USB_HID_READY) != 0,
+                PENDING_DIRTY_CONNECTION);
+    PENDING_SET(ble_connected, (d->status_flags & ZMK_STATUS_FLAG_BLE_CONNECTED) != 0,
+                PENDING_DIRTY_CONNECTION);
+    PENDING_SET(ble_bonded, (d->status_flags & ZMK_STATUS_FLAG_BLE_BONDED) != 0,
+                PENDING_DIRTY_CONNECTION);
+    PENDING_SET(profile, PROSPECTOR_DECODE_PROFILE(d->profile_slot), PENDING_DIRTY_CONNECTION);
+    PENDING_SET(modifiers, d->modifier_flags, PENDING_DIRTY_MODIFIERS);
+    PENDING_SET(bat[0], d->battery_level, PENDING_DIRTY_BATTERY);
+    PENDING_SET(bat[1], d->peripheral_battery[0], PENDING_DIRTY_BATTERY);
+    PENDING_SET(bat[2], d->peripheral_battery[1], PENDING_DIRTY_BATTERY);
+    PENDING_SET(bat[3], d->peripheral_battery[2], PENDING_DIRTY_BATTERY);
+    for (int i = 0; i < ARRAY_SIZE(pending_data.peripheral_rssi); i++) {
+        PENDING_SET(peripheral_rssi[i], keyboards[selected_keyboard].ext.peripheral_rssi[i],
+                    PENDING_DIRTY_BATTERY);
+    }
 
     /* Decode keyboard firmware version */
-    pending_data.kb_version_major = PROSPECTOR_DECODE_VERSION_MAJOR(d->version);
-    pending_data.kb_version_minor = PROSPECTOR_DECODE_VERSION_MINOR(d->version);
-    pending_data.kb_version_patch = PROSPECTOR_DECODE_PATCH(d->profile_slot);
-    pending_data.kb_version_dev = PROSPECTOR_DECODE_DEV(d->profile_slot);
+    PENDING_SET(kb_version_major, PROSPECTOR_DECODE_VERSION_MAJOR(d->version),
+                PENDING_DIRTY_VERSION);
+    PENDING_SET(kb_version_minor, PROSPECTOR_DECODE_VERSION_MINOR(d->version),
+                PENDING_DIRTY_VERSION);
+    PENDING_SET(kb_version_patch, PROSPECTOR_DECODE_PATCH(d->profile_slot),
+                PENDING_DIRTY_VERSION);
+    PENDING_SET(kb_version_dev, PROSPECTOR_DECODE_DEV(d->profile_slot), PENDING_DIRTY_VERSION);
     pending_data.kb_version_valid = true;
 
+    /* After "Scanning..." the display has reset every widget */
+    if (force || pending_data.no_keyboards) {
+        dirty = PENDING_DIRTY_ALL;
+    }
+    if (pending_data.no_keyboards) {
+        scanner_msg_send_timeout_wake();
+    }
     pending_data.no_keyboards = false;
-    pending_data.update_pending = true;
+    if (dirty) {
+        atomic_or(&pending_dirty, dirty);
+        pending_data.update_pending = true;
+    }
 }
 
 void scanner_set_selected_keyboard(int index) {
@@ -281,8 +748,14 @@ void scanner_set_selected_keyboard(int index) {
         if (mutex_initialized && k_mutex_lock(&data_mutex, K_MSEC(10)) == 0) {
             selected_keyboard = index;
             LOG_INF("Selected keyboard changed to slot %d", index);
-            fill_pending_from_selected();
+#if IS_ENABLED(CONFIG_PROSPECTOR_KEYBOARD_REGISTRY)
+            keyboard_registry_set_selected(index);
+#endif
+            fill_pending_from_selected(true);
             k_mutex_unlock(&data_mutex);
+#if IS_ENABLED(CONFIG_PROSPECTOR_SCANNER_EVENT_DRIVEN)
+            scanner_display_wake();
+#endif
         }
     }
 }
@@ -294,6 +767,25 @@ static void process_work_handler(struct k_work *work);
 static K_WORK_DELAYABLE_DEFINE(process_work, process_work_handler);
 static volatile bool process_pending = false;
 
+#if IS_ENABLED(CONFIG_PROSPECTOR_SCANNER_EVENT_DRIVEN)
+/* Defined in custom_status_screen.c: runs the pending update timer now */
+extern void scanner_display_wake(void);
+
+static volatile uint32_t process_last_run = 0;  /* Work handler only writes */
+
+static void schedule_process(void) {
+    uint32_t since = k_uptime_get_32() - process_last_run;
+    uint32_t delay_ms = since < CONFIG_PROSPECTOR_SCANNER_PROCESS_MIN_GAP_MS
+                        ? CONFIG_PROSPECTOR_SCANNER_PROCESS_MIN_GAP_MS - since : 0;
+
+    /* Pull a later housekeeping wake forward; never push an earlier one back.
+     * A burst of frames within the gap is handled by a single run. */
+    if (!k_work_delayable_is_pending(&process_work) ||
+        k_work_delayable_remaining_get(&process_work) > k_ms_to_ticks_ceil32(delay_ms)) {
+        k_work_reschedule(&process_work, K_MSEC(delay_ms));
+    }
+}
+#else
 static void schedule_process(void) {
     if (!process_pending) {
         process_pending = true;
@@ -301,148 +793,638 @@ static void schedule_process(void) {
         k_work_schedule(&process_work, K_MSEC(50));
     }
 }
+#endif
 
 /* ========== Rate Calculation State ========== */
 
 static atomic_t adv_receive_count = ATOMIC_INIT(0);  /* Incremented by BT RX (atomic) */
+
+#ifdef SCANNER_PIPELINE_COUNTS
+/* Status frames through the pipeline since boot (struct scanner_pipeline_counts) */
+static atomic_t bench_queued = ATOMIC_INIT(0);
+static atomic_t bench_dropped = ATOMIC_INIT(0);
+static atomic_t bench_processed = ATOMIC_INIT(0);
+static atomic_t work_runs = ATOMIC_INIT(0);
+static atomic_t work_cycles = ATOMIC_INIT(0);
+
+void scanner_get_pipeline_counts(struct scanner_pipeline_counts *out) {
+    out->queued = (uint32_t)atomic_get(&bench_queued);
+    out->dropped = (uint32_t)atomic_get(&bench_dropped);
+    out->processed = (uint32_t)atomic_get(&bench_processed);
+    out->work_runs = (uint32_t)atomic_get(&work_runs);
+    out->work_cycles = (uint32_t)atomic_get(&work_cycles);
+}
+#endif
 static uint32_t rate_last_calc_time = 0;
 
+/* Moving average of the last 4 one-second samples (rate × 100, integer) */
 #define RATE_HISTORY_SIZE 4
-static int32_t rate_history_x100[RATE_HISTORY_SIZE] = {0};  /* rate × 100, integer */
-static int rate_history_idx = 0;
-static bool rate_history_filled = false;
+PROSPECTOR_RATE_WINDOW_DEFINE(rate_window, RATE_HISTORY_SIZE);
+static uint32_t rate_sample_seq = 0;  /* Sample number = window tick */
+
+#if IS_ENABLED(CONFIG_ZMK_BATTERY_REPORTING)
+/* Scanner's own battery: state of charge + 1 from the last event, 0 once taken */
+static atomic_t scanner_battery_new = ATOMIC_INIT(0);
+static bool scanner_battery_seeded = false;
+
+static int scanner_battery_listener(const zmk_event_t *eh) {
+    const struct zmk_battery_state_changed *ev = as_zmk_battery_state_changed(eh);
+    if (ev) {
+        atomic_set(&scanner_battery_new, ev->state_of_charge + 1);
+        schedule_process();
+    }
+    return ZMK_EV_EVENT_BUBBLE;
+}
+
+ZMK_LISTENER(prospector_scanner_battery, scanner_battery_listener);
+ZMK_SUBSCRIPTION(prospector_scanner_battery, zmk_battery_state_changed);
+#endif
+
+/* Keyboard timeouts. last_seen only moves forward, so timeout_due, once
+ * the earliest last_seen + timeout, stays a lower bound on every active
+ * keyboard's deadline: nothing is checked until it passes, then the
+ * keyboards are checked and it moves to the new earliest deadline. */
+#ifdef CONFIG_PROSPECTOR_SCANNER_TIMEOUT_MS
+#define SCANNER_TIMEOUT_MS CONFIG_PROSPECTOR_SCANNER_TIMEOUT_MS
+#else
+#define SCANNER_TIMEOUT_MS 480000
+#endif
+static uint32_t timeout_due = 0;
+static bool timeout_armed = false;  /* timeout_due is valid: some keyboard may time out */
+
+/* A keyboard was seen; the first one after none arms the deadline */
+static void timeout_note_seen(uint32_t last_seen) {
+    if (SCANNER_TIMEOUT_MS > 0 && !timeout_armed) {
+        timeout_due = last_seen + SCANNER_TIMEOUT_MS + 1;
+        timeout_armed = true;
+    }
+}
+
+#if IS_ENABLED(CONFIG_PROSPECTOR_SCANNER_ADAPTIVE_DUTY)
+/* Adaptive scan duty: full while status changes, stepping down after
+ * quiet periods. duty_floor is raised when a level starves reception
+ * and reset by the next change, so the policy doesn't oscillate. */
+static uint32_t duty_last_change = 0;
+static int32_t duty_rate_x100 = 0;
+static enum zmk_status_scanner_duty duty_floor = ZMK_STATUS_SCANNER_DUTY_LOW;
+static enum zmk_status_scanner_duty duty_current = ZMK_STATUS_SCANNER_DUTY_FULL;
+static bool duty_rate_fresh = false;
+#define DUTY_MIN_RATE_X100 50  /* 0.5 packets/s per active keyboard */
+
+#if IS_ENABLED(CONFIG_PROSPECTOR_LINK_STATS)
+#define DUTY_MAX_LOSS_PERMILLE 200  /* Changes missed before a level counts as starving */
+#define DUTY_MIN_LOSS_CHANGES 8     /* Changes needed before loss is judged */
+
+/* Any active keyboard received too rarely, or missing too many changes */
+static bool duty_link_starved(uint32_t now) {
+    for (int i = 0; i < MAX_KEYBOARDS; i++) {
+        if (!keyboards[i].active) {
+            continue;
+        }
+        const struct prospector_link_stats *link = &keyboards[i].link;
+        uint32_t pps_x100 = prospector_link_stats_pps_x100(link, now);
+        int loss = prospector_link_stats_loss_permille(link);
+        if (pps_x100 < DUTY_MIN_RATE_X100 ||
+            (link->changes >= DUTY_MIN_LOSS_CHANGES && loss > DUTY_MAX_LOSS_PERMILLE)) {
+            LOG_INF("📶 Slot %d: %u.%02u/s, loss %d/1000 at current duty", i,
+                    pps_x100 / 100, pps_x100 % 100, loss);
+            return true;
+        }
+    }
+    return false;
+}
+#endif
+
+static void scan_duty_update(uint32_t now, bool content_change) {
+    int active = scanner_get_active_keyboard_count();
+    enum zmk_status_scanner_duty target;
+
+    if (content_change || active == 0) {
+        /* Nothing to watch yet: stay at full duty for discovery */
+        duty_last_change = now;
+        duty_floor = ZMK_STATUS_SCANNER_DUTY_LOW;
+    }
+
+    uint32_t quiet = now - duty_last_change;
+    if (quiet < CONFIG_PROSPECTOR_SCANNER_DUTY_ACTIVE_HOLD_MS) {
+        target = ZMK_STATUS_SCANNER_DUTY_FULL;
+    } else if (quiet < CONFIG_PROSPECTOR_SCANNER_DUTY_IDLE_MS) {
+        target = ZMK_STATUS_SCANNER_DUTY_REDUCED;
+    } else {
+        target = ZMK_STATUS_SCANNER_DUTY_LOW;
+    }
 
-/* Scanner battery update interval */
-static uint32_t scanner_battery_last_update = 0;
-#define SCANNER_BATTERY_UPDATE_INTERVAL_MS 5000
+    /* Judge starvation once per rate sample taken at the current level */
+#if IS_ENABLED(CONFIG_PROSPECTOR_LINK_STATS)
+    /* Per keyboard: one starving link is enough, however well the rest do */
+    bool starved = duty_rate_fresh && duty_current != ZMK_STATUS_SCANNER_DUTY_FULL &&
+                   duty_link_starved(now);
+#else
+    bool starved = duty_rate_fresh && duty_current != ZMK_STATUS_SCANNER_DUTY_FULL &&
+                   duty_rate_x100 < DUTY_MIN_RATE_X100 * active;
+#endif
+    if (starved) {
+        duty_floor = duty_current - 1;
+        LOG_INF("📶 Reception %d.%02d/s too low at current duty - holding higher duty",
+                duty_rate_x100 / 100, duty_rate_x100 % 100);
+    }
+    duty_rate_fresh = false;
+    if (target > duty_floor) {
+        target = duty_floor;
+    }
 
-/* Timeout check interval counter */
-static uint32_t process_call_count = 0;
+    if (target != duty_current && zmk_status_scanner_set_duty(target) == 0) {
+        duty_current = target;
+        /* The moving average still holds samples from the old level */
+        prospector_rate_window_reset(&rate_window);
+#if IS_ENABLED(CONFIG_PROSPECTOR_LINK_STATS)
+        /* So is the change loss */
+        for (int i = 0; i < MAX_KEYBOARDS; i++) {
+            slot_write_begin(i);
+            prospector_link_stats_reset_loss(&keyboards[i].link);
+            slot_write_end(i);
+        }
+#endif
+    }
+}
+#endif
 
 /* Low-priority update timer (1Hz) for WPM/battery display updates */
 static uint32_t low_priority_last_update = 0;
 #define LOW_PRIORITY_UPDATE_INTERVAL_MS 1000
 
+/* ========== Slot Index ========== */
+/* address → slot and keyboard_id+role → slot hash tables over the active
+ * slots of keyboards[], so a frame costs one probe instead of linear
+ * passes. Rebuilt whenever a slot's address, ID or role changes or a
+ * slot is freed; all of that is rare next to the per-frame lookups.
+ * Work handler only (data_mutex held). */
+
+#if MAX_KEYBOARDS * 2 <= 8
+#define SLOT_INDEX_SIZE 8
+#elif MAX_KEYBOARDS * 2 <= 16
+#define SLOT_INDEX_SIZE 16
+#else
+#define SLOT_INDEX_SIZE 32
+#endif
+
+static int8_t addr_index[SLOT_INDEX_SIZE];
+static int8_t id_index[SLOT_INDEX_SIZE];
+static uint32_t slot_kb_id[MAX_KEYBOARDS];  /* keyboard_id assembled once per slot */
+
+static uint32_t kb_id_of(const struct zmk_status_adv_data *d) {
+    return ((uint32_t)d->keyboard_id[0] << 24) | ((uint32_t)d->keyboard_id[1] << 16) |
+           ((uint32_t)d->keyboard_id[2] << 8) | d->keyboard_id[3];
+}
+
+static uint32_t addr_hash(const uint8_t *addr) {
+    uint32_t h = 2166136261u;
+    for (int i = 0; i < 6; i++) {
+        h = (h ^ addr[i]) * 16777619u;
+    }
+    return h;
+}
+
+static uint32_t id_hash(uint32_t keyboard_id, uint8_t role) {
+    return (keyboard_id ^ ((uint32_t)role << 30)) * 2654435761u;
+}
+
+static void index_insert(int8_t *table, uint32_t hash, int slot) {
+    for (int i = 0; i < SLOT_INDEX_SIZE; i++) {
+        int pos = (hash + i) & (SLOT_INDEX_SIZE - 1);
+        if (table[pos] < 0) {
+            table[pos] = slot;
+            return;
+        }
+    }
+}
+
+static void slot_index_rebuild(void) {
+    memset(addr_index, -1, sizeof(addr_index));
+    memset(id_index, -1, sizeof(id_index));
+    for (int i = 0; i < MAX_KEYBOARDS; i++) {
+        if (!keyboards[i].active && !SLOT_KNOWN(i)) {
+            continue;
+        }
+        slot_kb_id[i] = kb_id_of(&keyboards[i].data);
+        index_insert(addr_index, addr_hash(keyboards[i].ble_addr), i);
+        index_insert(id_index, id_hash(slot_kb_id[i], keyboards[i].data.device_role), i);
+    }
+}
+
+static int slot_find_addr(const uint8_t *addr) {
+    uint32_t hash = addr_hash(addr);
+    for (int i = 0; i < SLOT_INDEX_SIZE; i++) {
+        int slot = addr_index[(hash + i) & (SLOT_INDEX_SIZE - 1)];
+        if (slot < 0) {
+            return -1;
+        }
+        if (memcmp(keyboards[slot].ble_addr, addr, 6) == 0) {
+            return slot;
+        }
+    }
+    return -1;
+}
+
+static int slot_find_id(uint32_t keyboard_id, uint8_t role) {
+    uint32_t hash = id_hash(keyboard_id, role);
+    for (int i = 0; i < SLOT_INDEX_SIZE; i++) {
+        int slot = id_index[(hash + i) & (SLOT_INDEX_SIZE - 1)];
+        if (slot < 0) {
+            return -1;
+        }
+        if (slot_kb_id[slot] == keyboard_id && keyboards[slot].data.device_role == role) {
+            return slot;
+        }
+    }
+    return -1;
+}
+
+/* Free slot, else one kept for a remembered keyboard, else the
+ * longest-silent one (still active: the caller clears it). The selected
+ * keyboard is only evicted when it is the only slot. */
+static int slot_allocate(uint32_t keyboard_id) {
+    int victim = -1;
+    uint32_t now = k_uptime_get_32();
+
+    for (int i = 0; i < MAX_KEYBOARDS; i++) {
+        if (!keyboards[i].active && !SLOT_KNOWN(i)) {
+            return i;
+        }
+    }
+    for (int i = 0; i < MAX_KEYBOARDS; i++) {
+        if (!keyboards[i].active) {
+            return i;
+        }
+        if (i == selected_keyboard && MAX_KEYBOARDS > 1) {
+            continue;
+        }
+        if (victim < 0 || (now - keyboards[i].last_seen) > (now - keyboards[victim].last_seen)) {
+            victim = i;
+        }
+    }
+
+    /* Copied: the slot's reference is released as soon as it is reused */
+    char name[ZMK_KEYBOARD_NAME_MAX + 1];
+    zmk_keyboard_name_copy(keyboards[victim].name, name, sizeof(name));
+    LOG_INF("stub: all slots in use - evicting slot %d (%s, silent %us) for ID=%08X", victim,
+            name, (now - keyboards[victim].last_seen) / 1000, keyboard_id);
+    return victim;
+}
+
+/* ========== Keyboard Registry ========== */
+
+#if IS_ENABLED(CONFIG_PROSPECTOR_KEYBOARD_REGISTRY)
+static void registry_note(int index) {
+    struct keyboard_registry_record rec = {
+        .addr_type = keyboards[index].ble_addr_type,
+        .role = keyboards[index].data.device_role,
+        .keyboard_id = kb_id_of(&keyboards[index].data),
+    };
+    memcpy(rec.addr, keyboards[index].ble_addr, 6);
+    zmk_keyboard_name_copy(keyboards[index].name, rec.name, sizeof(rec.name));
+    keyboard_registry_update(index, &rec);
+}
+
+/* Reserve the slots of remembered keyboards; before scanning starts */
+static void registry_preload(void) {
+    struct keyboard_registry_record rec;
+    int known = 0;
+
+    for (int i = 0; i < MAX_KEYBOARDS; i++) {
+        if (!keyboard_registry_get(i, &rec)) {
+            continue;
+        }
+        memcpy(keyboards[i].ble_addr, rec.addr, 6);
+        keyboards[i].ble_addr_type = rec.addr_type;
+        keyboards[i].data.device_role = rec.role;
+        sys_put_be32(rec.keyboard_id, keyboards[i].data.keyboard_id);
+        zmk_keyboard_name_set_str(&keyboards[i].name, rec.name, sizeof(rec.name));
+        slot_known[i] = true;
+        known++;
+    }
+
+    int sel = keyboard_registry_get_selected();
+    if (sel >= 0 && sel < MAX_KEYBOARDS && slot_known[sel]) {
+        selected_keyboard = sel;
+    }
+    slot_index_rebuild();
+    LOG_INF("stub: %d keyboard(s) from the registry, slot %d selected", known, selected_keyboard);
+}
+
+/* A remembered keyboard is back: restore what its record has */
+static void registry_revive(int index) {
+    struct keyboard_registry_record rec;
+
+    if (keyboards[index].name == ZMK_KEYBOARD_NAME_NONE && keyboard_registry_get(index, &rec)) {
+        zmk_keyboard_name_set_str(&keyboards[index].name, rec.name, sizeof(rec.name));
+    }
+    if (keyboards[index].static_info.hash == 0) {
+        slot_set_name_entry(index, layer_name_cache_find(&keyboards[index].data,
+                                                         &keyboards[index].static_info));
+    }
+}
+#endif
+
+/* ========== All-Keyboard Watch (dashboard) ========== */
+
+#if IS_ENABLED(CONFIG_PROSPECTOR_DASHBOARD)
+/* Set while every slot is on screen: a change to any of them wakes the
+ * display, not only one to the selected keyboard */
+static atomic_t watch_all = ATOMIC_INIT(0);
+static bool watch_changed;  /* Work handler only */
+
+void scanner_watch_all_keyboards(bool on) {
+    atomic_set(&watch_all, on ? 1 : 0);
+}
+
+static inline void watch_note_change(void) {
+    if (atomic_get(&watch_all)) {
+        watch_changed = true;
+    }
+}
+#else
+static inline void watch_note_change(void) {}
+#endif
+
 /* ========== scanner_process_incoming() - Called from work handler ========== */
 
-void scanner_process_incoming(void) {
-    struct incoming_adv entry;
-    bool high_priority_change = false;
-    bool any_selected_data = false;
+/* Accumulated over one scanner_process_incoming() run */
+struct process_result {
+    bool high_priority_change;
+    bool any_selected_data;
+    bool content_change;
+#if IS_ENABLED(CONFIG_PROSPECTOR_LATENCY_STATS)
+    bool probe_pending;
+    bool probe_has_seq;
+    uint16_t probe_age_ms;
+    uint32_t probe_rx_time;
+#endif
+};
 
-    /* 1. Drain ring buffer: process all pending advertisements
-     * Bounded to INCOMING_BUF_SIZE to prevent infinite loop if indices are corrupted */
-    int drain_limit = INCOMING_BUF_SIZE;
-    while (drain_limit-- > 0 && incoming_pop(&entry)) {
-        /* Find existing keyboard or empty slot */
-        int index = -1;
-        uint32_t keyboard_id = (entry.data.keyboard_id[0] << 24) |
-                               (entry.data.keyboard_id[1] << 16) |
-                               (entry.data.keyboard_id[2] << 8) |
-                               entry.data.keyboard_id[3];
-
-        /* PRIORITY 1: BLE address match */
-        for (int i = 0; i < MAX_KEYBOARDS; i++) {
-            if (keyboards[i].active &&
-                memcmp(keyboards[i].ble_addr, entry.ble_addr, 6) == 0) {
-                index = i;
-                break;
+/* Apply one received frame to keyboards[] */
+static void process_entry(const struct incoming_adv *entry, struct process_result *r) {
+    if (entry->is_static) {
+        /* Static chunks carry no keyboard_id: BLE address match only */
+        int i = slot_find_addr(entry->ble_addr);
+        if (i >= 0) {
+            slot_write_begin(i);
+            keyboards[i].last_seen = k_uptime_get_32();
+            if (static_assemble(i, &entry->static_frame) && i == selected_keyboard) {
+                r->high_priority_change = true;
             }
+            slot_write_end(i);
         }
+        return;
+    }
 
-        /* PRIORITY 2: keyboard_id + device_role match */
-        if (index < 0) {
-            uint8_t incoming_role = entry.data.device_role;
-            for (int i = 0; i < MAX_KEYBOARDS; i++) {
-                if (keyboards[i].active) {
-                    uint32_t stored_id = (keyboards[i].data.keyboard_id[0] << 24) |
-                                         (keyboards[i].data.keyboard_id[1] << 16) |
-                                         (keyboards[i].data.keyboard_id[2] << 8) |
-                                         keyboards[i].data.keyboard_id[3];
-                    if (stored_id == keyboard_id &&
-                        keyboards[i].data.device_role == incoming_role) {
-                        index = i;
-                        if (memcmp(keyboards[i].ble_addr, entry.ble_addr, 6) != 0) {
-                            LOG_INF("stub: slot %d BLE addr updated (ID=%08X)", i, keyboard_id);
-                            memcpy(keyboards[i].ble_addr, entry.ble_addr, 6);
-                        }
-                        break;
-                    }
-                }
+#ifdef SCANNER_PIPELINE_COUNTS
+    atomic_inc(&bench_processed);
+#endif
+
+    /* Find existing keyboard or allocate a slot */
+    uint32_t keyboard_id = kb_id_of(&entry->data);
+    bool reindex = false;
+
+    /* PRIORITY 1: BLE address match */
+    int index = slot_find_addr(entry->ble_addr);
+    bool addr_changed = false;
+    bool new_slot = false;
+    bool name_changed = false;
+
+    /* PRIORITY 2: keyboard_id + device_role match */
+    if (index < 0) {
+        index = slot_find_id(keyboard_id, entry->data.device_role);
+        addr_changed = (index >= 0);
+    }
+
+    /* PRIORITY 3: Free slot, or evict the least recently seen */
+    if (index < 0) {
+        index = slot_allocate(keyboard_id);
+        new_slot = true;
+    } else if (slot_kb_id[index] != keyboard_id ||
+               keyboards[index].data.device_role != entry->data.device_role) {
+        reindex = true;  /* Same address, new identity (e.g. reflashed) */
+    }
+
+#if IS_ENABLED(CONFIG_PROSPECTOR_SCANNER_COALESCE)
+    if (!new_slot && (int32_t)(entry->post_seq - slot_post_seq[index]) <= 0) {
+        return;  /* Already applied, or older than what the mailbox delivered */
+    }
+    slot_post_seq[index] = entry->post_seq;
+#endif
+
+    slot_write_begin(index);
+    if (addr_changed) {
+        LOG_INF("stub: slot %d BLE addr updated (ID=%08X)", index, keyboard_id);
+        memcpy(keyboards[index].ble_addr, entry->ble_addr, 6);
+        reindex = true;  /* Layer names are keyed by ID and role: the entry stays */
+    }
+#if IS_ENABLED(CONFIG_PROSPECTOR_KEYBOARD_REGISTRY)
+    if (!new_slot && !keyboards[index].active) {
+        registry_revive(index);  /* Only remembered slots are found while inactive */
+        name_changed = true;
+    }
+    if (new_slot) {
+        slot_known[index] = false;
+    }
+#endif
+    if (new_slot) {
+        keyboards[index].active = false;  /* Evicted, if it was in use */
+        zmk_keyboard_name_release(keyboards[index].name);
+        keyboards[index].name = ZMK_KEYBOARD_NAME_NONE;
+        memset(&keyboards[index].static_info, 0, sizeof(keyboards[index].static_info));
+        static_rx[index].hash = 0;
+#if IS_ENABLED(CONFIG_PROSPECTOR_LINK_STATS)
+        prospector_link_stats_reset(&keyboards[index].link);
+#endif
+        /* A known keyboard gets its cached table (and hash) back, so its
+         * static chunks are dropped on arrival like after a full packet */
+        slot_set_name_entry(index, layer_name_cache_find(&entry->data,
+                                                         &keyboards[index].static_info));
+        char name[ZMK_KEYBOARD_NAME_MAX + 1];
+        LOG_INF("stub: new slot %d: %s (ID=%08X)", index,
+                zmk_keyboard_name_copy(entry->name, name, sizeof(name)) ? name : "(null)",
+                keyboard_id);
+        reindex = true;
+    }
+
+    /* High-priority change detection BEFORE updating keyboards[]
+     * Only checks selected keyboard - no LVGL calls here, just flag setting */
+    if (index == selected_keyboard && keyboards[index].active) {
+        if (status_transition(&keyboards[index].data, &entry->data)) {
+            r->high_priority_change = true;
+#if IS_ENABLED(CONFIG_PROSPECTOR_LATENCY_STATS)
+            if (!r->probe_pending) {
+                r->probe_rx_time = entry->rx_time;
+                r->probe_has_seq = entry->ext.has_seq;
+                r->probe_age_ms = entry->ext.age_ms;
+                r->probe_pending = true;
             }
+#endif
         }
+    } else if (index == selected_keyboard && !keyboards[index].active) {
+        /* New keyboard appearing in selected slot = high priority */
+        r->high_priority_change = true;
+    }
 
-        /* PRIORITY 3: Empty slot */
-        if (index < 0) {
-            for (int i = 0; i < MAX_KEYBOARDS; i++) {
-                if (!keyboards[i].active) {
-                    index = i;
-                    LOG_INF("stub: new slot %d: %s (ID=%08X)",
-                           index, entry.name[0] ? entry.name : "(null)", keyboard_id);
-                    break;
-                }
+    /* Change accounting from sequence numbers (v3 / extended frames).
+     * A gap of more than half the sequence space is taken as a reboot. */
+    if (entry->ext.has_seq) {
+        uint8_t delta = (uint8_t)(entry->ext.seq - keyboards[index].last_seq);
+        if (keyboards[index].active && keyboards[index].ext.has_seq &&
+            delta > 0 && delta < 128) {
+            keyboards[index].seq_changes += delta;
+            keyboards[index].seq_missed += delta - 1;
+#if IS_ENABLED(CONFIG_PROSPECTOR_LINK_STATS)
+            prospector_link_stats_seq(&keyboards[index].link, delta);
+#endif
+            if (delta > 1) {
+                LOG_DBG("Slot %d missed %d change(s) (age %dms)",
+                        index, delta - 1, entry->ext.age_ms);
             }
+        } else if (!keyboards[index].active) {
+            keyboards[index].seq_changes = 0;
+            keyboards[index].seq_missed = 0;
         }
+        keyboards[index].last_seq = entry->ext.seq;
+    }
+
+    if (!keyboards[index].active ||
+        memcmp(&keyboards[index].data, &entry->data, sizeof(entry->data)) != 0) {
+        r->content_change = true;
+    }
+
+#if IS_ENABLED(CONFIG_PROSPECTOR_LINK_STATS)
+#if IS_ENABLED(CONFIG_PROSPECTOR_SCANNER_COALESCE)
+    uint16_t frames = entry->frames;  /* Ring transitions are counted by their mailbox */
+#else
+    uint16_t frames = 1;
+#endif
+    prospector_link_stats_frames(&keyboards[index].link, entry->rx_time, frames, entry->rssi);
+#endif
 
-        if (index < 0) {
-            LOG_WRN("No slot for keyboard ID=%08X", keyboard_id);
+    /* Store the data */
+    keyboards[index].active = true;
+    memcpy(&keyboards[index].data, &entry->data, sizeof(struct zmk_status_adv_data));
+    keyboards[index].rssi = entry->rssi;
+    keyboards[index].last_seen = k_uptime_get_32();
+    timeout_note_seen(keyboards[index].last_seen);
+    memcpy(keyboards[index].ble_addr, entry->ble_addr, 6);
+    keyboards[index].ble_addr_type = entry->ble_addr_type;
+    keyboards[index].ext = entry->ext;
+
+    /* Update name: interned, so an unchanged name is a handle compare.
+     * Frames without one (or with a name since dropped) keep the slot's. */
+    if (zmk_keyboard_name_set(&keyboards[index].name, entry->name)) {
+        LOG_INF("Keyboard name: %s (slot %d)", zmk_keyboard_name_str(keyboards[index].name),
+                index);
+        name_changed = true;
+    } else if (keyboards[index].name == ZMK_KEYBOARD_NAME_NONE) {
+        char placeholder[16];
+        int len = snprintf(placeholder, sizeof(placeholder), "Keyboard %d", index);
+        zmk_keyboard_name_set_str(&keyboards[index].name, placeholder, len);
+    }
+    slot_write_end(index);
+
+    if (reindex) {
+        slot_index_rebuild();
+    }
+#if IS_ENABLED(CONFIG_PROSPECTOR_KEYBOARD_REGISTRY)
+    if (reindex || name_changed) {
+        registry_note(index);
+    }
+#else
+    ARG_UNUSED(name_changed);
+#endif
+
+    if (index == selected_keyboard) {
+        r->any_selected_data = true;
+    }
+}
+
+#if IS_ENABLED(CONFIG_PROSPECTOR_LINK_STATS)
+/* Repeats counted by the BT RX thread since the last run */
+static void repeat_tally_drain(void) {
+    for (int i = 0; i < TALLY_COUNT; i++) {
+        if (!repeat_tally[i].used) {
+            continue;
+        }
+        atomic_val_t count = atomic_clear(&repeat_tally[i].count);
+        if (count == 0) {
+            continue;
+        }
+        int index = slot_find_addr(repeat_tally[i].addr);
+        if (index < 0 || !keyboards[index].active) {
             continue;
         }
+        slot_write_begin(index);
+        prospector_link_stats_frames(&keyboards[index].link,
+                                     (uint32_t)atomic_get(&repeat_tally[i].last_rx),
+                                     (uint16_t)MIN(count, UINT16_MAX), repeat_tally[i].rssi);
+        slot_write_end(index);
+    }
+}
 
-        /* High-priority change detection BEFORE updating keyboards[]
-         * Only checks selected keyboard - no LVGL calls here, just flag setting */
-        if (index == selected_keyboard && keyboards[index].active) {
-            uint8_t old_profile = PROSPECTOR_DECODE_PROFILE(keyboards[index].data.profile_slot);
-            uint8_t new_profile = PROSPECTOR_DECODE_PROFILE(entry.data.profile_slot);
-            if (keyboards[index].data.active_layer != entry.data.active_layer ||
-                keyboards[index].data.modifier_flags != entry.data.modifier_flags ||
-                old_profile != new_profile ||
-                (keyboards[index].data.status_flags & (ZMK_STATUS_FLAG_USB_HID_READY |
-                    ZMK_STATUS_FLAG_BLE_CONNECTED)) !=
-                (entry.data.status_flags & (ZMK_STATUS_FLAG_USB_HID_READY |
-                    ZMK_STATUS_FLAG_BLE_CONNECTED))) {
-                high_priority_change = true;
-            }
-        } else if (index == selected_keyboard && !keyboards[index].active) {
-            /* New keyboard appearing in selected slot = high priority */
-            high_priority_change = true;
-        }
-
-        /* Store the data */
-        keyboards[index].active = true;
-        memcpy(&keyboards[index].data, &entry.data, sizeof(struct zmk_status_adv_data));
-        keyboards[index].rssi = entry.rssi;
-        keyboards[index].last_seen = k_uptime_get_32();
-        memcpy(keyboards[index].ble_addr, entry.ble_addr, 6);
-        keyboards[index].ble_addr_type = entry.ble_addr_type;
-
-        /* Update name: preserve real name, don't overwrite with "Unknown" */
-        if (entry.name[0] != '\0') {
-            if (keyboards[index].ble_name[0] == '\0') {
-                strncpy(keyboards[index].ble_name, entry.name, MAX_NAME_LEN - 1);
-                keyboards[index].ble_name[MAX_NAME_LEN - 1] = '\0';
-            } else if (strcmp(entry.name, "Unknown") != 0 &&
-                       strcmp(keyboards[index].ble_name, entry.name) != 0) {
-                strncpy(keyboards[index].ble_name, entry.name, MAX_NAME_LEN - 1);
-                keyboards[index].ble_name[MAX_NAME_LEN - 1] = '\0';
-                LOG_INF("Updated keyboard name: %s (slot %d)", entry.name, index);
-            }
-        } else if (keyboards[index].ble_name[0] == '\0') {
-            snprintf(keyboards[index].ble_name, MAX_NAME_LEN, "Keyboard %d", index);
+#define LINK_STATS_LOG_INTERVAL_S 10
+
+static void link_stats_log(uint32_t now) {
+    for (int i = 0; i < MAX_KEYBOARDS; i++) {
+        if (!keyboards[i].active) {
+            continue;
         }
+        const struct prospector_link_stats *l = &keyboards[i].link;
+        uint32_t pps_x100 = prospector_link_stats_pps_x100(l, now);
+        LOG_DBG("📶 Slot %d: %u.%02u/s jitter %ums rssi %d loss %d/1000 "
+                "gaps %u/%u/%u/%u/%u/%u/%u/%u", i, pps_x100 / 100, pps_x100 % 100,
+                prospector_link_stats_jitter_ms(l), prospector_link_stats_rssi(l),
+                prospector_link_stats_loss_permille(l), l->gap_hist[0], l->gap_hist[1],
+                l->gap_hist[2], l->gap_hist[3], l->gap_hist[4], l->gap_hist[5],
+                l->gap_hist[6], l->gap_hist[7]);
+    }
+}
+#endif
+
+void scanner_process_incoming(void) {
+    struct incoming_adv entry;
+    struct process_result r = {0};
+
+#if IS_ENABLED(CONFIG_PROSPECTOR_LINK_STATS)
+    repeat_tally_drain();
+#endif
+
+    /* 1. Drain ring buffer: process all pending advertisements
+     * Bounded to INCOMING_BUF_SIZE to prevent infinite loop if indices are corrupted */
+    int drain_limit = INCOMING_BUF_SIZE;
+    while (drain_limit-- > 0 && incoming_pop(&entry)) {
+        process_entry(&entry, &r);
+    }
 
-        if (index == selected_keyboard) {
-            any_selected_data = true;
+#if IS_ENABLED(CONFIG_PROSPECTOR_SCANNER_COALESCE)
+    /* Then the latest frame of every keyboard that sent one since last run */
+    for (int i = 0; i < MAILBOX_COUNT; i++) {
+        if (mailbox_snapshot(i, &entry)) {
+            process_entry(&entry, &r);
         }
     }
+#endif
+
+    if (r.content_change) {
+        watch_note_change();
+    }
 
     /* 2. Display update scheduling (no LVGL calls - just set pending_data flags)
      *    High-priority (layer/modifier/profile/connection): immediate
      *    Low-priority (WPM/battery): 1Hz interval */
-    if (high_priority_change) {
-        fill_pending_from_selected();
+    if (r.high_priority_change) {
+        fill_pending_from_selected(false);
         LOG_DBG("⚡ High-priority display update (layer/mod/profile change)");
-    } else if (any_selected_data) {
+#if IS_ENABLED(CONFIG_PROSPECTOR_LATENCY_STATS)
+        if (r.probe_pending) {
+            latency_probe_popped(r.probe_rx_time, r.probe_has_seq, r.probe_age_ms);
+        }
+#endif
+    } else if (r.any_selected_data) {
         /* Low-priority data received - update keyboards[] is done above,
          * pending_data will be refreshed on 1Hz cycle below */
     }
@@ -452,7 +1434,7 @@ void scanner_process_incoming(void) {
     if ((now - low_priority_last_update) >= LOW_PRIORITY_UPDATE_INTERVAL_MS) {
         if (selected_keyboard >= 0 && selected_keyboard < MAX_KEYBOARDS &&
             keyboards[selected_keyboard].active) {
-            fill_pending_from_selected();
+            fill_pending_from_selected(false);
         }
         low_priority_last_update = now;
     }
@@ -473,19 +1455,11 @@ void scanner_process_incoming(void) {
             ? (int32_t)((uint32_t)count * 100000U / elapsed_since_calc)
             : 0;
 
-        rate_history_x100[rate_history_idx] = instant_rate_x100;
-        rate_history_idx = (rate_history_idx + 1) % RATE_HISTORY_SIZE;
-        if (rate_history_idx == 0) {
-            rate_history_filled = true;
-        }
+        prospector_rate_window_add(&rate_window, rate_sample_seq++, (uint32_t)instant_rate_x100);
 
-        int32_t avg_rate_x100 = 0;
-        int samples = rate_history_filled ? RATE_HISTORY_SIZE : rate_history_idx;
+        int samples = prospector_rate_window_samples(&rate_window);
         if (samples == 0) samples = 1;
-        for (int i = 0; i < samples; i++) {
-            avg_rate_x100 += rate_history_x100[i];
-        }
-        avg_rate_x100 /= samples;
+        int32_t avg_rate_x100 = (int32_t)(prospector_rate_window_sum(&rate_window) / samples);
 
         int8_t rssi = (selected_keyboard >= 0 && selected_keyboard < MAX_KEYBOARDS &&
                        keyboards[selected_keyboard].active)
@@ -494,50 +1468,72 @@ void scanner_process_incoming(void) {
         set_signal_data(rssi, avg_rate_x100);
         pending_data.signal_update_pending = true;
         rate_last_calc_time = now;
+#if IS_ENABLED(CONFIG_PROSPECTOR_LINK_STATS)
+        if (rate_sample_seq % LINK_STATS_LOG_INTERVAL_S == 0) {
+            link_stats_log(now);
+        }
+#endif
+#if IS_ENABLED(CONFIG_PROSPECTOR_SCANNER_ADAPTIVE_DUTY)
+        duty_rate_x100 = avg_rate_x100;
+        duty_rate_fresh = (samples >= RATE_HISTORY_SIZE);
+#endif
     }
 
-    /* 4. Timeout check (every ~10 calls = ~1 second at 100ms timer) */
-    process_call_count++;
-    if ((process_call_count % 10) == 0) {
-#ifdef CONFIG_PROSPECTOR_SCANNER_TIMEOUT_MS
-        const uint32_t timeout_ms = CONFIG_PROSPECTOR_SCANNER_TIMEOUT_MS;
-#else
-        const uint32_t timeout_ms = 480000;
-#endif
-        if (timeout_ms > 0) {
-            bool any_timed_out = false;
-            for (int i = 0; i < MAX_KEYBOARDS; i++) {
-                if (keyboards[i].active &&
-                    (now - keyboards[i].last_seen) > timeout_ms) {
-                    LOG_INF("Keyboard in slot %d timed out", i);
-                    keyboards[i].active = false;
-                    keyboards[i].ble_name[0] = '\0';
-                    any_timed_out = true;
+#if IS_ENABLED(CONFIG_PROSPECTOR_SCANNER_ADAPTIVE_DUTY)
+    scan_duty_update(now, r.content_change);
+#endif
+
+    /* 4. Timeouts, once the earliest deadline has passed */
+    if (timeout_armed && (int32_t)(now - timeout_due) >= 0) {
+        timeout_armed = false;
+        bool any_timed_out = false;
+        for (int i = 0; i < MAX_KEYBOARDS; i++) {
+            if (!keyboards[i].active) {
+                continue;
+            }
+            uint32_t due = keyboards[i].last_seen + SCANNER_TIMEOUT_MS + 1;
+            if ((int32_t)(now - due) < 0) {
+                /* Still in range: the earliest of these is the next deadline */
+                if (!timeout_armed || (int32_t)(due - timeout_due) < 0) {
+                    timeout_due = due;
                 }
+                timeout_armed = true;
+            } else {
+                LOG_INF("Keyboard in slot %d timed out", i);
+                slot_write_begin(i);
+                keyboards[i].active = false;
+                zmk_keyboard_name_release(keyboards[i].name);
+                keyboards[i].name = ZMK_KEYBOARD_NAME_NONE;
+#if IS_ENABLED(CONFIG_PROSPECTOR_KEYBOARD_REGISTRY)
+                slot_known[i] = true;  /* Its record brings the name back */
+#endif
+                slot_write_end(i);
+                any_timed_out = true;
             }
+        }
 
-            if (any_timed_out) {
-                int active_count = scanner_get_active_keyboard_count();
-                if (active_count == 0) {
-                    LOG_INF("No active keyboards - returning to Scanning... state");
-                    pending_data.no_keyboards = true;
-                    pending_data.update_pending = true;
-                    set_signal_data(-100, -100);
-                    pending_data.signal_update_pending = true;
-                    rate_last_calc_time = 0;
-                    atomic_set(&adv_receive_count, 0);
-                    rate_history_filled = false;
-                    rate_history_idx = 0;
-                } else {
-                    /* Selected keyboard timed out - switch to another */
-                    if (!keyboards[selected_keyboard].active) {
-                        for (int i = 0; i < MAX_KEYBOARDS; i++) {
-                            if (keyboards[i].active) {
-                                selected_keyboard = i;
-                                LOG_INF("Switched to keyboard slot %d", i);
-                                fill_pending_from_selected();
-                                break;
-                            }
+        if (any_timed_out) {
+            slot_index_rebuild();
+            watch_note_change();
+            int active_count = scanner_get_active_keyboard_count();
+            if (active_count == 0) {
+                LOG_INF("No active keyboards - returning to Scanning... state");
+                pending_data.no_keyboards = true;
+                pending_data.update_pending = true;
+                set_signal_data(-100, -100);
+                pending_data.signal_update_pending = true;
+                rate_last_calc_time = 0;
+                atomic_set(&adv_receive_count, 0);
+                prospector_rate_window_reset(&rate_window);
+            } else {
+                /* Selected keyboard timed out - switch to another */
+                if (!keyboards[selected_keyboard].active) {
+                    for (int i = 0; i < MAX_KEYBOARDS; i++) {
+                        if (keyboards[i].active) {
+                            selected_keyboard = i;
+                            LOG_INF("Switched to keyboard slot %d", i);
+                            fill_pending_from_selected(true);
+                            break;
                         }
                     }
                 }
@@ -545,52 +1541,125 @@ void scanner_process_incoming(void) {
         }
     }
 
-    /* 5. Scanner battery (every ~5 seconds) */
-    if (scanner_battery_last_update == 0 ||
-        (now - scanner_battery_last_update) >= SCANNER_BATTERY_UPDATE_INTERVAL_MS) {
-        int scanner_battery_level = 0;
+    /* 5. Scanner battery, on ZMK's battery state-changed event */
 #if IS_ENABLED(CONFIG_ZMK_BATTERY_REPORTING)
-        scanner_battery_level = zmk_battery_state_of_charge();
-#endif
-        if (scanner_battery_level > 0) {
-            pending_data.scanner_battery = scanner_battery_level;
-            pending_data.scanner_battery_pending = true;
-        }
-        scanner_battery_last_update = now;
+    if (!scanner_battery_seeded) {
+        /* The event may have fired before this module was listening */
+        scanner_battery_seeded = true;
+        atomic_cas(&scanner_battery_new, 0, zmk_battery_state_of_charge() + 1);
+    }
+    int scanner_battery_level = (int)atomic_clear(&scanner_battery_new) - 1;
+    if (scanner_battery_level > 0) {
+        pending_data.scanner_battery = scanner_battery_level;
+        pending_data.scanner_battery_pending = true;
     }
+#endif
 }
 
 /* ========== Process Work Handler ========== */
 
+#if IS_ENABLED(CONFIG_PROSPECTOR_SCANNER_EVENT_DRIVEN)
+static uint32_t ms_until(uint32_t due, uint32_t now) {
+    int32_t until = (int32_t)(due - now);
+    return until > 0 ? (uint32_t)until : 0;
+}
+
+#define HOUSEKEEPING_IDLE UINT32_MAX
+
+/* Time until the next rate / low-priority / timeout step, or
+ * HOUSEKEEPING_IDLE when none is due: frames and battery events
+ * schedule the work themselves. */
+static uint32_t housekeeping_delay(uint32_t now) {
+    uint32_t next = timeout_armed ? ms_until(timeout_due, now) : HOUSEKEEPING_IDLE;
+
+    for (int i = 0; i < MAX_KEYBOARDS; i++) {
+        if (keyboards[i].active) {
+            next = MIN(next, ms_until(rate_last_calc_time + 1000, now));
+            next = MIN(next, ms_until(low_priority_last_update + LOW_PRIORITY_UPDATE_INTERVAL_MS,
+                                      now));
+            break;
+        }
+    }
+    return next;
+}
+#endif
+
 static void process_work_handler(struct k_work *work) {
     ARG_UNUSED(work);
+    PSPTR_TRACE_SCOPE("psptr_work",
+                      (incoming_write_idx - incoming_read_idx) & (INCOMING_BUF_SIZE - 1));
     process_pending = false;
+    uint32_t next_ms = 100;
 
     if (mutex_initialized && k_mutex_lock(&data_mutex, K_MSEC(50)) == 0) {
+#ifdef SCANNER_PIPELINE_COUNTS
+        uint32_t work_start = k_cycle_get_32();
         scanner_process_incoming();
+        atomic_add(&work_cycles, (atomic_val_t)(k_cycle_get_32() - work_start));
+        atomic_inc(&work_runs);
+#else
+        scanner_process_incoming();
+#endif
+#if IS_ENABLED(CONFIG_PROSPECTOR_SCANNER_EVENT_DRIVEN)
+        next_ms = housekeeping_delay(k_uptime_get_32());
+#endif
         k_mutex_unlock(&data_mutex);
     }
 
-    /* Reschedule periodically (rate calc, timeout checks, battery) */
-    k_work_schedule(&process_work, K_MSEC(100));
+#if IS_ENABLED(CONFIG_PROSPECTOR_SCANNER_EVENT_DRIVEN)
+    process_last_run = k_uptime_get_32();
+    bool watched = false;
+#if IS_ENABLED(CONFIG_PROSPECTOR_DASHBOARD)
+    watched = watch_changed;
+    watch_changed = false;
+#endif
+    if (pending_data.update_pending || pending_data.signal_update_pending ||
+        pending_data.scanner_battery_pending || watched) {
+        scanner_display_wake();
+    }
+    /* Frames schedule the work themselves: this is housekeeping only.
+     * k_work_schedule() keeps an earlier wake a frame already asked for. */
+    if (next_ms != HOUSEKEEPING_IDLE) {
+        k_work_schedule(&process_work, K_MSEC(next_ms));
+    }
+#else
+    /* Reschedule periodically (rate calc, timeout checks) */
+    k_work_schedule(&process_work, K_MSEC(next_ms));
+#endif
 }
 
 /* ========== Scanner Message Functions ========== */
 
 int scanner_msg_send_keyboard_data(const struct zmk_status_adv_data *adv_data,
-                                   int8_t rssi, const char *device_name,
-                                   const uint8_t *ble_addr, uint8_t ble_addr_type) {
+                                   int8_t rssi, zmk_keyboard_name_t device_name,
+                                   const uint8_t *ble_addr, uint8_t ble_addr_type,
+                                   const struct zmk_status_adv_ext_fields *ext) {
+#if IS_ENABLED(CONFIG_PROSPECTOR_SCANNER_COALESCE)
+    if (ble_addr) {
+        mailbox_post(adv_data, rssi, device_name, ble_addr, ble_addr_type, ext);
+        atomic_inc(&adv_receive_count);
+#ifdef SCANNER_PIPELINE_COUNTS
+        atomic_inc(&bench_queued);
+#endif
+        schedule_process();
+        return 0;
+    }
+#endif
+
     struct incoming_adv entry;
     memcpy(&entry.data, adv_data, sizeof(struct zmk_status_adv_data));
+    entry.is_static = false;
+    entry.rx_time = k_uptime_get_32();
     entry.rssi = rssi;
 
-    if (device_name && device_name[0] != '\0') {
-        strncpy(entry.name, device_name, MAX_NAME_LEN - 1);
-        entry.name[MAX_NAME_LEN - 1] = '\0';
+    if (ext) {
+        entry.ext = *ext;
     } else {
-        entry.name[0] = '\0';
+        memset(&entry.ext, 0, sizeof(entry.ext));
     }
 
+    entry.name = device_name;
+
     if (ble_addr) {
         memcpy(entry.ble_addr, ble_addr, 6);
         entry.ble_addr_type = ble_addr_type;
@@ -601,9 +1670,15 @@ int scanner_msg_send_keyboard_data(const struct zmk_status_adv_data *adv_data,
 
     int ret = incoming_push(&entry);
     if (ret != 0) {
+#ifdef SCANNER_PIPELINE_COUNTS
+        atomic_inc(&bench_dropped);
+#endif
         LOG_WRN("Ring buffer full, advertisement dropped");
         return ret;
     }
+#ifdef SCANNER_PIPELINE_COUNTS
+    atomic_inc(&bench_queued);
+#endif
 
     /* Count for rate calculation (atomic, safe from any thread) */
     atomic_inc(&adv_receive_count);
@@ -614,6 +1689,34 @@ int scanner_msg_send_keyboard_data(const struct zmk_status_adv_data *adv_data,
     return 0;
 }
 
+void scanner_msg_count_repeat(const uint8_t *ble_addr, int8_t rssi) {
+#if IS_ENABLED(CONFIG_PROSPECTOR_LINK_STATS)
+    if (ble_addr) {
+        repeat_tally_add(ble_addr, rssi);
+    }
+#else
+    ARG_UNUSED(ble_addr);
+    ARG_UNUSED(rssi);
+#endif
+    atomic_inc(&adv_receive_count);
+}
+
+int scanner_msg_send_static_frame(const struct zmk_status_adv_static_frame *frame,
+                                  const uint8_t *ble_addr) {
+    struct incoming_adv entry = {0};
+    entry.static_frame = *frame;
+    entry.is_static = true;
+    memcpy(entry.ble_addr, ble_addr, 6);
+
+    /* Not counted in adv_receive_count: the rate shows status updates only */
+    int ret = incoming_push(&entry);
+    if (ret != 0) {
+        return ret;
+    }
+    schedule_process();
+    return 0;
+}
+
 int scanner_msg_send_swipe(int direction) {
     LOG_DBG("Swipe gesture: direction=%d", direction);
     return 0;
@@ -645,14 +1748,22 @@ int scanner_msg_send_display_refresh(void) {
         if (keyboards[i].active) active++;
     }
     if (active > 0) {
-        fill_pending_from_selected();
+        fill_pending_from_selected(true);
     }
 
     k_mutex_unlock(&data_mutex);
+#if IS_ENABLED(CONFIG_PROSPECTOR_SCANNER_EVENT_DRIVEN)
+    if (active > 0) {
+        scanner_display_wake();
+    }
+#endif
     return 0;
 }
 
 int scanner_msg_send_timeout_wake(void) {
+#if IS_ENABLED(CONFIG_PROSPECTOR_SCANNER_DISPLAY_SLEEP)
+    scanner_display_resume();
+#endif
     return 0;
 }
 
@@ -679,17 +1790,36 @@ static K_WORK_DELAYABLE_DEFINE(scanner_start_work, scanner_start_work_handler);
 
 static void scanner_start_work_handler(struct k_work *work) {
     ARG_UNUSED(work);
+#if IS_ENABLED(CONFIG_PROSPECTOR_KEYBOARD_REGISTRY)
+    /* Settings are loaded by now (ZMK main); retries find the slots set */
+    static bool registry_loaded;
+    if (!registry_loaded && k_mutex_lock(&data_mutex, K_FOREVER) == 0) {
+        registry_preload();
+        registry_loaded = true;
+        k_mutex_unlock(&data_mutex);
+    }
+#endif
     LOG_INF("Starting BLE scanner...");
     int ret = zmk_status_scanner_start();
     if (ret == 0) {
         LOG_INF("BLE scanner started successfully");
+#if IS_ENABLED(CONFIG_PROSPECTOR_BOOT_TIMING)
+        boot_timing_mark(BOOT_MARK_SCANNING);
+#endif
     } else {
         LOG_ERR("Failed to start BLE scanner: %d", ret);
         k_work_schedule(&scanner_start_work, K_SECONDS(1));
     }
 }
 
+void scanner_boot_start(void) {
+    k_work_reschedule(&scanner_start_work, K_NO_WAIT);
+    k_work_reschedule(&process_work, K_NO_WAIT);
+}
+
 static int scanner_init_start(void) {
+    slot_index_rebuild();
+    memset(slot_name_entry, LAYER_NAME_CACHE_NONE, sizeof(slot_name_entry));
     k_mutex_init(&data_mutex);
     mutex_initialized = true;
     k_work_schedule(&scanner_start_work, K_MSEC(500));
@@ -10,6 +10,62 @@
 #include <zmk/status_scanner.h>
 #include <zmk/status_advertisement.h>
 
+/* ========== Pending Display Data (work handler → LVGL timer) ========== */
+
+/* pending_display_data.dirty: field groups changed since the last
+ * scanner_get_pending_update(), so the display only touches those widgets */
+#define PENDING_DIRTY_NAME        BIT(0)  /* device_name */
+#define PENDING_DIRTY_LAYER       BIT(1)  /* layer, layer_name, layer_names entry */
+#define PENDING_DIRTY_WPM         BIT(2)  /* wpm */
+#define PENDING_DIRTY_CONNECTION  BIT(3)  /* usb_ready, ble_connected, ble_bonded, profile */
+#define PENDING_DIRTY_MODIFIERS   BIT(4)  /* modifiers */
+#define PENDING_DIRTY_BATTERY     BIT(5)  /* bat[], peripheral_rssi[] */
+#define PENDING_DIRTY_VERSION     BIT(6)  /* kb_version_* */
+#define PENDING_DIRTY_ALL         BIT_MASK(7)
+
+struct pending_display_data {
+    volatile bool update_pending;
+    volatile bool signal_update_pending;  /* Signal widget updates separately (1Hz) */
+    volatile bool no_keyboards;           /* True when all keyboards timed out */
+    uint32_t dirty;                       /* PENDING_DIRTY_* (valid in the copy only) */
+
+    zmk_keyboard_name_t device_name;  /* Not referenced: read with zmk_keyboard_name_copy() */
+    char layer_name[ZMK_STATUS_ADV_EXT_LAYER_NAME_MAX + 1];  /* If layer_names has none */
+    int layer;
+    int8_t layer_names;   /* layer_name_cache entry, LAYER_NAME_CACHE_NONE if none */
+    uint8_t static_hash;  /* static_info.hash the layer name was resolved with */
+    int wpm;
+    bool usb_ready;
+    bool ble_connected;
+    bool ble_bonded;
+    int profile;
+    uint8_t modifiers;
+    int bat[4];
+    int8_t peripheral_rssi[3];  /* Split links as seen by the central, 0 = unknown */
+    int8_t rssi;
+    float rate_hz;
+    int scanner_battery;
+    bool scanner_battery_pending;
+
+    /* Keyboard firmware version (decoded from version + profile_slot fields) */
+    uint8_t kb_version_major;
+    uint8_t kb_version_minor;
+    uint8_t kb_version_patch;
+    bool kb_version_dev;
+    bool kb_version_valid;       /* True after first keyboard data received */
+};
+
+/**
+ * @brief Take the pending display update, if any
+ *
+ * LVGL timer context. out->dirty says which field groups changed; all
+ * other fields hold the values already shown.
+ *
+ * @param out Output: copy of the pending data
+ * @return true if an update was pending
+ */
+bool scanner_get_pending_update(struct pending_display_data *out);
+
 /**
  * @brief Send keyboard data received from BLE advertisement
  *
@@ -19,14 +75,43 @@
  *
  * @param adv_data Parsed advertisement data
  * @param rssi Signal strength
- * @param device_name Keyboard device name
+ * @param device_name Interned device name (the caller's reference, not
+ *                    passed on), ZMK_KEYBOARD_NAME_NONE if not known
  * @param ble_addr BLE MAC address (6 bytes)
  * @param ble_addr_type BLE address type
+ * @param ext Extra fields from an extended advertisement, NULL for legacy frames
  * @return 0 on success, negative error code on failure
  */
 int scanner_msg_send_keyboard_data(const struct zmk_status_adv_data *adv_data,
-                                   int8_t rssi, const char *device_name,
-                                   const uint8_t *ble_addr, uint8_t ble_addr_type);
+                                   int8_t rssi, zmk_keyboard_name_t device_name,
+                                   const uint8_t *ble_addr, uint8_t ble_addr_type,
+                                   const struct zmk_status_adv_ext_fields *ext);
+
+/**
+ * @brief Send one static packet chunk received from BLE advertisement
+ *
+ * Lock-free like scanner_msg_send_keyboard_data(). Chunks are matched to
+ * keyboards by BLE address, so chunks from keyboards not seen yet are
+ * dropped by the consumer.
+ *
+ * @param frame Static frame (26 bytes, service UUID 0xABCF)
+ * @param ble_addr BLE MAC address (6 bytes)
+ * @return 0 on success, negative error code on failure
+ */
+int scanner_msg_send_static_frame(const struct zmk_status_adv_static_frame *frame,
+                                  const uint8_t *ble_addr);
+
+/**
+ * @brief Count a frame dropped as a repeat before reaching the ring
+ *
+ * Keeps the reception rate comparable between keyboards that send
+ * sequence numbers and those that don't, and (CONFIG_PROSPECTOR_LINK_STATS)
+ * the sender's link statistics complete.
+ *
+ * @param ble_addr BLE address of the sender
+ * @param rssi Signal strength of the frame
+ */
+void scanner_msg_count_repeat(const uint8_t *ble_addr, int8_t rssi);
 
 /**
  * @brief Process incoming advertisements from ring buffer
@@ -46,6 +131,16 @@ void scanner_process_incoming(void);
  */
 int scanner_msg_send_timeout_check(void);
 
+/**
+ * @brief Wake the display after all keyboards had timed out
+ *
+ * Leaves display sleep (CONFIG_PROSPECTOR_SCANNER_DISPLAY_SLEEP) so the
+ * returning keyboard is shown with one full refresh. Safe from any thread.
+ *
+ * @return 0 on success, negative error code on failure
+ */
+int scanner_msg_send_timeout_wake(void);
+
 /**
  * @brief Get keyboard data by index
  *
@@ -59,6 +154,14 @@ int scanner_msg_send_timeout_check(void);
 bool scanner_get_keyboard_data(int index, struct zmk_status_adv_data *data,
                                int8_t *rssi, char *name, size_t name_len);
 
+/**
+ * @brief Copy the static packet info of the selected keyboard
+ *
+ * @param out Output: decoded static info
+ * @return true if a complete static packet has been received
+ */
+bool scanner_get_static_info(struct zmk_status_adv_static_info *out);
+
 /**
  * @brief Get the count of active keyboards
  *
@@ -67,16 +170,80 @@ bool scanner_get_keyboard_data(int index, struct zmk_status_adv_data *data,
 int scanner_get_active_keyboard_count(void);
 
 /**
- * @brief Get keyboard status pointer by index (LVGL timer context only)
+ * @brief Get keyboard status pointer by index (work queue context only)
  *
- * Returns a direct pointer to the keyboard status struct.
- * Safe because keyboards[] is only accessed from LVGL timer context.
+ * Returns a direct pointer to the keyboard status struct, which the work
+ * handler keeps updating. Other threads use scanner_snapshot_keyboard().
  *
  * @param index Keyboard index (0 to MAX_KEYBOARDS-1)
  * @return Pointer to keyboard status, NULL if inactive or invalid index
  */
 struct zmk_keyboard_status *scanner_get_keyboard_status(int index);
 
+/**
+ * @brief BLE address of a keyboard slot (work queue context only)
+ *
+ * Also answers for inactive slots kept for a keyboard remembered across
+ * reboots (CONFIG_PROSPECTOR_KEYBOARD_REGISTRY).
+ *
+ * @param index Keyboard index (0 to MAX_KEYBOARDS-1)
+ * @param addr Output: 6-byte address
+ * @param addr_type Output: BLE address type
+ * @return true if the slot has a keyboard
+ */
+bool scanner_get_keyboard_address(int index, uint8_t *addr, uint8_t *addr_type);
+
+/**
+ * @brief Copy out a consistent snapshot of one keyboard slot
+ *
+ * Lock-free (per-slot seqlock) from any thread; falls back to data_mutex
+ * only when a write keeps overlapping the copy.
+ *
+ * @param index Keyboard index (0 to MAX_KEYBOARDS-1)
+ * @param out Output: slot contents (also filled for inactive slots)
+ * @param gen Output (optional): generation of the copy, see
+ *            scanner_keyboard_generation()
+ * @return true if the slot is active and was copied
+ */
+bool scanner_snapshot_keyboard(int index, struct zmk_keyboard_status *out, uint32_t *gen);
+
+/**
+ * @brief Current generation of a keyboard slot
+ *
+ * Changes whenever the work handler writes the slot, so a reader can
+ * skip slots whose generation matches the last copy it took.
+ *
+ * @param index Keyboard index (0 to MAX_KEYBOARDS-1)
+ * @return Generation (always even), 0 for an invalid index
+ */
+uint32_t scanner_keyboard_generation(int index);
+
+/**
+ * @brief Call fn with a snapshot of each active slot
+ *
+ * @param seen_gen Optional per-slot generations (MAX_KEYBOARDS entries,
+ *                 zero-initialised, kept by the caller): slots unchanged
+ *                 since the last pass are skipped, and it is updated
+ * @param fn Callback, given the slot index and its snapshot
+ * @param user_data Passed to fn
+ * @return Number of active slots, including skipped ones
+ */
+int scanner_for_each_keyboard(uint32_t *seen_gen,
+                              void (*fn)(int index, const struct zmk_keyboard_status *kbd,
+                                         void *user_data),
+                              void *user_data);
+
+/**
+ * @brief Wake the display on changes to any keyboard (CONFIG_PROSPECTOR_DASHBOARD)
+ *
+ * Normally only the selected keyboard's updates wake the display. While
+ * a screen shows every slot it turns this on, so each slot's change
+ * reaches it without polling (CONFIG_PROSPECTOR_SCANNER_EVENT_DRIVEN).
+ *
+ * @param on true while such a screen is visible
+ */
+void scanner_watch_all_keyboards(bool on);
+
 /**
  * @brief Get the selected keyboard index
  *
@@ -99,3 +266,35 @@ void scanner_set_selected_keyboard(int index);
  * @return 0 on success, negative error code on failure
  */
 int scanner_msg_send_display_refresh(void);
+
+/**
+ * @brief Start the BLE scanner now instead of after the boot delay
+ *
+ * CONFIG_PROSPECTOR_FAST_BOOT: called at display init, when settings
+ * (and so the keyboard registry) are loaded, so scanning overlaps
+ * building the UI.
+ */
+void scanner_boot_start(void);
+
+/* Pipeline totals, kept for whichever of these reads them */
+#if IS_ENABLED(CONFIG_PROSPECTOR_SCANNER_PIPELINE_BENCH) || \
+    IS_ENABLED(CONFIG_PROSPECTOR_PERF_PANEL)
+#define SCANNER_PIPELINE_COUNTS 1
+#endif
+
+#ifdef SCANNER_PIPELINE_COUNTS
+struct scanner_pipeline_counts {
+    uint32_t queued;       /* Status frames taken by the ring or a mailbox */
+    uint32_t dropped;      /* Status frames lost to a full ring */
+    uint32_t processed;    /* Ring entries and mailbox copies applied to keyboards[] */
+    uint32_t work_runs;    /* scanner_process_incoming() calls */
+    uint32_t work_cycles;  /* k_cycle_get_32() cycles spent in them, wrapping */
+};
+
+/**
+ * @brief Totals since boot, for the pipeline bench and perf panel (any thread)
+ *
+ * @param out Output: counts
+ */
+void scanner_get_pipeline_counts(struct scanner_pipeline_counts *out);
+#endif
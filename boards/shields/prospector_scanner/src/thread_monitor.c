@@ -0,0 +1,203 @@
+/*
+ * Copyright (c) 2024 The ZMK Contributors
+ *
+ * SPDX-License-Identifier: MIT
+ */
+
+#include <zephyr/kernel.h>
+#include <zephyr/init.h>
+#include <zephyr/logging/log.h>
+#include <stdio.h>
+#include <string.h>
+
+#include "thread_monitor.h"
+
+LOG_MODULE_REGISTER(thread_monitor, LOG_LEVEL_INF);
+
+#define MAX_THREADS CONFIG_PROSPECTOR_THREAD_MONITOR_MAX_THREADS
+#define INTERVAL_MS (CONFIG_PROSPECTOR_THREAD_MONITOR_INTERVAL_S * 1000)
+
+/* Sampler state, system work queue only */
+struct thread_slot {
+    const struct k_thread *thread;
+    uint64_t last_cycles;
+    bool seen;
+};
+
+static struct thread_slot slots[MAX_THREADS];
+static uint64_t last_total_cycles;
+
+/* Last sample, shared with the shell and the LVGL thread */
+static struct thread_monitor_entry entries[MAX_THREADS];
+static int entry_count;
+static K_MUTEX_DEFINE(entries_mutex);
+
+/* ========== Sampling ========== */
+
+struct walk {
+    struct thread_monitor_entry out[MAX_THREADS];
+    int count;
+    uint64_t total_delta;
+};
+
+static struct thread_slot *slot_for(const struct k_thread *thread) {
+    struct thread_slot *free_slot = NULL;
+
+    for (int i = 0; i < MAX_THREADS; i++) {
+        if (slots[i].thread == thread) {
+            return &slots[i];
+        }
+        if (!slots[i].thread && !free_slot) {
+            free_slot = &slots[i];
+        }
+    }
+    if (free_slot) {
+        /* First sight: its CPU share starts with the next interval */
+        k_thread_runtime_stats_t stats;
+
+        k_thread_runtime_stats_get((k_tid_t)thread, &stats);
+        free_slot->thread = thread;
+        free_slot->last_cycles = stats.execution_cycles;
+    }
+    return free_slot;
+}
+
+/* Runs with the thread list unlocked: the stack scan below is not short */
+static void walk_thread(const struct k_thread *thread, void *user_data) {
+    struct walk *w = user_data;
+    struct thread_slot *slot = slot_for(thread);
+
+    if (!slot) {
+        return;  /* More threads than MAX_THREADS */
+    }
+    slot->seen = true;
+
+    k_thread_runtime_stats_t stats;
+    k_thread_runtime_stats_get((k_tid_t)thread, &stats);
+    uint64_t delta = stats.execution_cycles - slot->last_cycles;
+    slot->last_cycles = stats.execution_cycles;
+
+    struct thread_monitor_entry *e = &w->out[w->count++];
+    const char *name = k_thread_name_get((k_tid_t)thread);
+
+    if (name && name[0]) {
+        strncpy(e->name, name, sizeof(e->name) - 1);
+        e->name[sizeof(e->name) - 1] = '\0';
+    } else {
+        snprintf(e->name, sizeof(e->name), "%p", (void *)thread);
+    }
+    e->cpu_permille = w->total_delta ? (uint16_t)(delta * 1000U / w->total_delta) : 0;
+    e->stack_size = thread->stack_info.size;
+
+    size_t unused = 0;
+    e->stack_unused = k_thread_stack_space_get(thread, &unused) == 0 ? unused : 0;
+}
+
+static void sample(void) {
+    static struct walk w;
+    k_thread_runtime_stats_t all;
+
+    k_thread_runtime_stats_all_get(&all);
+    w.count = 0;
+    w.total_delta = all.execution_cycles - last_total_cycles;
+    last_total_cycles = all.execution_cycles;
+
+    for (int i = 0; i < MAX_THREADS; i++) {
+        slots[i].seen = false;
+    }
+    k_thread_foreach_unlocked(walk_thread, &w);
+    /* Threads that exited give their slot back */
+    for (int i = 0; i < MAX_THREADS; i++) {
+        if (!slots[i].seen) {
+            slots[i].thread = NULL;
+        }
+    }
+
+    k_mutex_lock(&entries_mutex, K_FOREVER);
+    memcpy(entries, w.out, w.count * sizeof(entries[0]));
+    entry_count = w.count;
+    k_mutex_unlock(&entries_mutex);
+
+#if IS_ENABLED(CONFIG_PROSPECTOR_THREAD_MONITOR_LOG)
+    for (int i = 0; i < w.count; i++) {
+        const struct thread_monitor_entry *e = &w.out[i];
+        LOG_INF("🧵 %-16s cpu %3u.%u%%  stack %5u/%5u used", e->name, e->cpu_permille / 10,
+                e->cpu_permille % 10, e->stack_size - e->stack_unused, e->stack_size);
+    }
+#endif
+}
+
+static void sample_work_handler(struct k_work *work);
+static K_WORK_DELAYABLE_DEFINE(sample_work, sample_work_handler);
+
+static void sample_work_handler(struct k_work *work) {
+    ARG_UNUSED(work);
+    sample();
+    k_work_schedule(&sample_work, K_MSEC(INTERVAL_MS));
+}
+
+/* ========== Readers ========== */
+
+int thread_monitor_get(struct thread_monitor_entry *out, int max) {
+    k_mutex_lock(&entries_mutex, K_FOREVER);
+    int n = MIN(max, entry_count);
+    memcpy(out, entries, n * sizeof(out[0]));
+    k_mutex_unlock(&entries_mutex);
+    return n;
+}
+
+bool thread_monitor_tightest(struct thread_monitor_entry *out) {
+    int best = -1;
+
+    k_mutex_lock(&entries_mutex, K_FOREVER);
+    for (int i = 0; i < entry_count; i++) {
+        if (entries[i].stack_size > 0 &&
+            (best < 0 || entries[i].stack_unused < entries[best].stack_unused)) {
+            best = i;
+        }
+    }
+    if (best >= 0) {
+        *out = entries[best];
+    }
+    k_mutex_unlock(&entries_mutex);
+    return best >= 0;
+}
+
+#if IS_ENABLED(CONFIG_SHELL)
+#include <zephyr/shell/shell.h>
+
+static int cmd_threads(const struct shell *sh, size_t argc, char **argv) {
+    ARG_UNUSED(argc);
+    ARG_UNUSED(argv);
+    static struct thread_monitor_entry copy[MAX_THREADS];
+    int n = thread_monitor_get(copy, MAX_THREADS);
+
+    if (n == 0) {
+        shell_print(sh, "No sample yet");
+        return 0;
+    }
+    shell_print(sh, "%-16s %7s %6s %6s %6s", "thread", "cpu", "stack", "used", "free");
+    for (int i = 0; i < n; i++) {
+        const struct thread_monitor_entry *e = &copy[i];
+        shell_print(sh, "%-16s %3u.%u%% %6u %6u %6u", e->name, e->cpu_permille / 10,
+                    e->cpu_permille % 10, e->stack_size, e->stack_size - e->stack_unused,
+                    e->stack_unused);
+    }
+    shell_print(sh, "CPU over the last %u s, stack use since boot",
+                CONFIG_PROSPECTOR_THREAD_MONITOR_INTERVAL_S);
+    return 0;
+}
+
+SHELL_CMD_REGISTER(threads, NULL, "Thread CPU load and stack high-water marks", cmd_threads);
+#endif
+
+static int thread_monitor_init(void) {
+    k_thread_runtime_stats_t all;
+
+    k_thread_runtime_stats_all_get(&all);
+    last_total_cycles = all.execution_cycles;
+    k_work_schedule(&sample_work, K_MSEC(INTERVAL_MS));
+    return 0;
+}
+
+SYS_INIT(thread_monitor_init, APPLICATION, 99);
@@ -0,0 +1,33 @@
+/*
+ * Copyright (c) 2024 The ZMK Contributors
+ *
+ * SPDX-License-Identifier: MIT
+ *
+ * Thread CPU load and stack high-water monitor (CONFIG_PROSPECTOR_THREAD_MONITOR)
+ *
+ * Every CONFIG_PROSPECTOR_THREAD_MONITOR_INTERVAL_S a work item on the
+ * system work queue walks all kernel threads (BT RX, system and display
+ * work queues, main, LVGL, shell, log, idle) and records each one's
+ * share of CPU time over the interval and the deepest its stack has
+ * gone since boot. "threads" prints the last sample on the shell; the
+ * performance panel shows the thread closest to overflowing.
+ */
+
+#pragma once
+
+#include <stdint.h>
+#include <stdbool.h>
+#include <stddef.h>
+
+struct thread_monitor_entry {
+    char name[16];
+    uint16_t cpu_permille;   // Share of CPU time over the last interval
+    uint32_t stack_size;
+    uint32_t stack_unused;   // Never touched since boot (high-water mark)
+};
+
+/* Copy up to @p max entries of the last sample into @p out; returns the count */
+int thread_monitor_get(struct thread_monitor_entry *out, int max);
+
+/* The thread with the fewest unused stack bytes; false before the first sample */
+bool thread_monitor_tightest(struct thread_monitor_entry *out);
@@ -0,0 +1,224 @@
+/*
+ * Copyright (c) 2024 The ZMK Contributors
+ *
+ * SPDX-License-Identifier: MIT
+ *
+ * Touch gesture engine - see touch_gesture.h
+ *
+ * Contact states:
+ *   TRACKING  finger down, samples going into the ring
+ *   FIRED     this contact produced its gesture; everything else from it
+ *             (later samples, a late controller gesture code) is ignored
+ *             until the next finger down
+ *   IDLE      lifted without a gesture
+ */
+
+#include <zephyr/kernel.h>
+#include <zephyr/logging/log.h>
+#include <stdlib.h>
+#include <zmk/event_manager.h>
+
+#include "touch_gesture.h"
+#include "touch_latency_bench.h"
+
+LOG_MODULE_DECLARE(zmk, CONFIG_ZMK_LOG_LEVEL);
+
+/* Defined weak in touch_handler.c, overridden while a slider is dragged */
+bool display_settings_is_interacting(void);
+
+#define SWIPE_THRESHOLD 30          /* Distance that is a swipe at any speed (pixels) */
+#define FLING_MIN_DISTANCE 15       /* A fast flick only needs this much (pixels) */
+#define FLING_MIN_SPEED 300         /* Release speed of a fling (pixels/s) */
+#define VELOCITY_WINDOW_MS 80       /* Velocity from the samples of the last 80 ms */
+#define VELOCITY_MIN_DT_MS 8        /* Below this span the estimate is noise */
+#define HW_GESTURE_GRACE_MS 150     /* Controller codes may arrive just after the lift */
+#define DOUBLE_TAP_THRESHOLD 10     /* Max movement for a tap (pixels) */
+#define DOUBLE_TAP_INTERVAL_MS 350  /* Max interval between two taps */
+
+#define SAMPLE_RING_SIZE 16  /* Power of two; ~160 ms of reports at 100 Hz */
+
+struct touch_sample {
+    int16_t x;
+    int16_t y;
+    uint32_t t;
+};
+
+enum contact_state {
+    CONTACT_IDLE,
+    CONTACT_TRACKING,
+    CONTACT_FIRED,
+};
+
+/* Only the input thread touches this */
+static struct {
+    enum contact_state state;
+    struct touch_sample start;
+    struct touch_sample ring[SAMPLE_RING_SIZE];
+    uint8_t head;   /* Next write position */
+    uint8_t count;  /* Valid samples, up to SAMPLE_RING_SIZE */
+    uint32_t lift_time;
+    uint32_t last_tap_time;
+} g;
+
+static const char *const dir_name[] = {"UP", "DOWN", "LEFT", "RIGHT", "DOUBLE_TAP"};
+
+static void ring_push(int16_t x, int16_t y, uint32_t t) {
+    g.ring[g.head] = (struct touch_sample){.x = x, .y = y, .t = t};
+    g.head = (g.head + 1) & (SAMPLE_RING_SIZE - 1);
+    if (g.count < SAMPLE_RING_SIZE) {
+        g.count++;
+    }
+}
+
+static const struct touch_sample *ring_at(uint8_t age) {
+    return &g.ring[(g.head - 1 - age) & (SAMPLE_RING_SIZE - 1)];
+}
+
+/* Velocity (pixels/s) between the newest sample and the oldest one
+ * within VELOCITY_WINDOW_MS of it; 0 if the span is too short */
+static void ring_velocity(int32_t *vx, int32_t *vy) {
+    *vx = 0;
+    *vy = 0;
+    if (g.count < 2) {
+        return;
+    }
+
+    const struct touch_sample *newest = ring_at(0);
+    const struct touch_sample *oldest = newest;
+    for (uint8_t age = 1; age < g.count; age++) {
+        const struct touch_sample *s = ring_at(age);
+        if (newest->t - s->t > VELOCITY_WINDOW_MS) {
+            break;
+        }
+        oldest = s;
+    }
+
+    int32_t dt = (int32_t)(newest->t - oldest->t);
+    if (dt < VELOCITY_MIN_DT_MS) {
+        return;
+    }
+    *vx = (newest->x - oldest->x) * 1000 / dt;
+    *vy = (newest->y - oldest->y) * 1000 / dt;
+}
+
+static void raise_gesture(enum swipe_direction direction, uint16_t speed, const char *source) {
+    if (display_settings_is_interacting()) {
+        LOG_DBG("Gesture %s dropped - UI interaction in progress", dir_name[direction]);
+        return;
+    }
+
+    LOG_INF("%s GESTURE: %s (%u px/s)", source, dir_name[direction], speed);
+#if IS_ENABLED(CONFIG_PROSPECTOR_TOUCH_LATENCY_BENCH)
+    touch_bench_mark(TOUCH_BENCH_RAISED);
+#endif
+    raise_zmk_swipe_gesture_event(
+        (struct zmk_swipe_gesture_event){.direction = direction, .speed = speed});
+}
+
+static void deliver(enum swipe_direction direction, uint16_t speed, const char *source) {
+    g.state = CONTACT_FIRED;
+    raise_gesture(direction, speed, source);
+}
+
+/* Swipe direction for the contact so far, SWIPE_DIRECTION_NONE if it is not
+ * one (yet). Before the lift only a fast, clearly one-axis drag counts. */
+static enum swipe_direction classify(bool lifted, uint16_t *speed_out) {
+    const struct touch_sample *now = ring_at(0);
+    int32_t dx = now->x - g.start.x;
+    int32_t dy = now->y - g.start.y;
+    int32_t vx, vy;
+    ring_velocity(&vx, &vy);
+
+    bool horizontal = abs(dx) > abs(dy);
+    int32_t dist = horizontal ? abs(dx) : abs(dy);
+    int32_t minor = horizontal ? abs(dy) : abs(dx);
+    int32_t v = horizontal ? vx : vy;
+    int32_t d = horizontal ? dx : dy;
+
+    /* Moving the way it went, not flicking back */
+    int32_t speed = ((v > 0) == (d > 0)) ? abs(v) : 0;
+    bool fling = speed >= FLING_MIN_SPEED && dist >= FLING_MIN_DISTANCE;
+
+    if (dist <= minor) {
+        return SWIPE_DIRECTION_NONE;
+    }
+    if (!lifted) {
+        if (!fling || dist < SWIPE_THRESHOLD || dist < 2 * minor) {
+            return SWIPE_DIRECTION_NONE;
+        }
+    } else if (dist <= SWIPE_THRESHOLD && !fling) {
+        return SWIPE_DIRECTION_NONE;
+    }
+
+    *speed_out = (uint16_t)MIN(speed, UINT16_MAX);
+    if (horizontal) {
+        return dx > 0 ? SWIPE_DIRECTION_RIGHT : SWIPE_DIRECTION_LEFT;
+    }
+    return dy > 0 ? SWIPE_DIRECTION_DOWN : SWIPE_DIRECTION_UP;
+}
+
+void touch_gesture_down(int16_t x, int16_t y, uint32_t now_ms) {
+    g.state = CONTACT_TRACKING;
+    g.start = (struct touch_sample){.x = x, .y = y, .t = now_ms};
+    g.count = 0;
+    ring_push(x, y, now_ms);
+    LOG_DBG("Touch DOWN at (%d, %d)", x, y);
+}
+
+void touch_gesture_move(int16_t x, int16_t y, uint32_t now_ms) {
+    if (g.state != CONTACT_TRACKING) {
+        return;
+    }
+    ring_push(x, y, now_ms);
+
+    uint16_t speed;
+    enum swipe_direction dir = classify(false, &speed);
+    if (dir != SWIPE_DIRECTION_NONE) {
+        deliver(dir, speed, "EARLY");
+    }
+}
+
+void touch_gesture_up(uint32_t now_ms) {
+    g.lift_time = now_ms;
+    if (g.state != CONTACT_TRACKING) {
+        return;  /* Already fired */
+    }
+    g.state = CONTACT_IDLE;
+
+    uint16_t speed = 0;
+    enum swipe_direction dir = classify(true, &speed);
+    if (dir != SWIPE_DIRECTION_NONE) {
+        deliver(dir, speed, "SW");
+        return;
+    }
+
+    /* Not a swipe: a tap, if it hardly moved */
+    const struct touch_sample *last = ring_at(0);
+    if (abs(last->x - g.start.x) > DOUBLE_TAP_THRESHOLD ||
+        abs(last->y - g.start.y) > DOUBLE_TAP_THRESHOLD) {
+        return;
+    }
+    if (g.last_tap_time != 0 && now_ms - g.last_tap_time < DOUBLE_TAP_INTERVAL_MS) {
+        g.last_tap_time = 0;  /* A third tap starts over */
+        deliver(SWIPE_DIRECTION_DOUBLE_TAP, 0, "TAP");
+    } else {
+        g.last_tap_time = now_ms;
+    }
+}
+
+void touch_gesture_hw(enum swipe_direction direction, uint32_t now_ms) {
+    if (g.state == CONTACT_FIRED) {
+        LOG_DBG("HW gesture %s ignored - contact already fired", dir_name[direction]);
+        return;
+    }
+    if (g.state == CONTACT_IDLE && now_ms - g.lift_time > HW_GESTURE_GRACE_MS) {
+        return;  /* Stale code with no contact behind it */
+    }
+    deliver(direction, 0, "HW");
+}
+
+#if IS_ENABLED(CONFIG_PROSPECTOR_TOUCH_LATENCY_BENCH)
+void touch_gesture_inject(enum swipe_direction direction) {
+    raise_gesture(direction, 0, "BENCH");
+}
+#endif
@@ -0,0 +1,35 @@
+/*
+ * Copyright (c) 2024 The ZMK Contributors
+ *
+ * SPDX-License-Identifier: MIT
+ *
+ * Touch gesture engine (CONFIG_PROSPECTOR_TOUCH_GESTURES)
+ *
+ * Fed from the touch input callback with display-space samples. Keeps a
+ * short timestamped ring per contact, so a swipe is recognised by
+ * distance or by release velocity (fling), and a fast drag fires before
+ * the finger lifts. Each contact yields at most one gesture: the
+ * controller's own gesture codes and the software detection can no
+ * longer both fire, which replaces the fixed swipe cooldown.
+ */
+
+#pragma once
+
+#include <stdint.h>
+#include "events/swipe_gesture_event.h"
+
+/* Input thread: finger down at (x, y), display coordinates */
+void touch_gesture_down(int16_t x, int16_t y, uint32_t now_ms);
+
+/* Input thread: finger still down, now at (x, y) */
+void touch_gesture_move(int16_t x, int16_t y, uint32_t now_ms);
+
+/* Input thread: finger lifted */
+void touch_gesture_up(uint32_t now_ms);
+
+/* Input thread: gesture code decoded by the touch controller */
+void touch_gesture_hw(enum swipe_direction direction, uint32_t now_ms);
+
+/* Latency bench: raise @p direction as if detected, leaving the contact
+ * state alone (called from the bench work item, not the input thread) */
+void touch_gesture_inject(enum swipe_direction direction);
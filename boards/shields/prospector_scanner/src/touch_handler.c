@@ -6,6 +6,8 @@
 
 #include "touch_handler.h"
 #include "events/swipe_gesture_event.h"
+#include "touch_gesture.h"
+#include "touch_latency_bench.h"
 // Message queue removed - using ZMK event system for thread-safe architecture
 
 /* Weak function - overridden by display_settings_widget.c when included */
@@ -44,6 +46,8 @@ static lv_indev_t *lvgl_indev = NULL;
 // Current touch coordinates (accumulated from INPUT_ABS_X/Y events)
 static uint16_t current_x = 0;
 static uint16_t current_y = 0;
+
+#if !IS_ENABLED(CONFIG_PROSPECTOR_TOUCH_GESTURES)
 static bool x_updated = false;
 static bool y_updated = false;
 
@@ -88,6 +92,9 @@ static void raise_swipe_event(enum swipe_direction direction) {
 
     last_swipe_time = now;
     LOG_INF("Raising ZMK swipe event: %s", dir_name[direction]);
+#if IS_ENABLED(CONFIG_PROSPECTOR_TOUCH_LATENCY_BENCH)
+    touch_bench_mark(TOUCH_BENCH_RAISED);
+#endif
 
     // Use ZMK event system - thread-safe, listener runs in main thread
     // No message queue needed - ZMK event manager handles synchronization
@@ -95,6 +102,7 @@ static void raise_swipe_event(enum swipe_direction direction) {
         (struct zmk_swipe_gesture_event){.direction = direction}
     );
 }
+#endif /* !CONFIG_PROSPECTOR_TOUCH_GESTURES */
 
 /**
  * Input event callback for CST816S touch sensor
@@ -104,9 +112,84 @@ static void raise_swipe_event(enum swipe_direction direction) {
 // External callback registration function that can be called from scanner_display.c
 extern void touch_handler_late_register_callback(touch_event_callback_t callback);
 
+/* Latency bench: every report or gesture code may be the one a gesture
+ * comes out of; coordinate events are only part of a report */
+static inline void bench_mark_input(const struct input_event *evt) {
+#if IS_ENABLED(CONFIG_PROSPECTOR_TOUCH_LATENCY_BENCH)
+    if (evt->code != INPUT_ABS_X && evt->code != INPUT_ABS_Y) {
+        touch_bench_mark(TOUCH_BENCH_INPUT);
+    }
+#else
+    ARG_UNUSED(evt);
+#endif
+}
+
+#if IS_ENABLED(CONFIG_PROSPECTOR_TOUCH_GESTURES)
+/* Everything goes to the gesture engine (touch_gesture.c), in display
+ * coordinates; the legacy detection below is not used */
+static void touch_input_callback(struct input_event *evt, void *user_data) {
+    ARG_UNUSED(user_data);
+    uint32_t now = k_uptime_get_32();
+    bench_mark_input(evt);
+
+    switch (evt->code) {
+    case INPUT_KEY_DOWN:
+    case INPUT_KEY_UP:
+    case INPUT_KEY_LEFT:
+    case INPUT_KEY_RIGHT:
+        if (evt->value == 1) {
+            touch_gesture_hw(evt->code == INPUT_KEY_DOWN   ? SWIPE_DIRECTION_DOWN
+                             : evt->code == INPUT_KEY_UP   ? SWIPE_DIRECTION_UP
+                             : evt->code == INPUT_KEY_LEFT ? SWIPE_DIRECTION_LEFT
+                                                           : SWIPE_DIRECTION_RIGHT,
+                             now);
+        }
+        break;
+
+    case INPUT_ABS_X:
+        current_x = (uint16_t)evt->value;
+        break;
+
+    case INPUT_ABS_Y:
+        current_y = (uint16_t)evt->value;
+        break;
+
+    case INPUT_BTN_TOUCH: {
+        /* Each controller report ends with BTN_TOUCH, so this is one sample.
+         * Same transform as lvgl_input_read(): touch Y -> display X,
+         * touch X -> display Y (inverted). */
+        int16_t x = (int16_t)current_y;
+        int16_t y = (int16_t)(239 - current_x);
+
+        touch_active = (evt->value != 0);
+        if (touch_active && !prev_touch_active) {
+            touch_gesture_down(x, y, now);
+        } else if (touch_active) {
+            touch_gesture_move(x, y, now);
+        } else if (prev_touch_active) {
+            touch_gesture_up(now);
+        }
+
+        last_event.x = current_x;
+        last_event.y = current_y;
+        last_event.touched = touch_active;
+        last_event.timestamp = now;
+        if (registered_callback) {
+            registered_callback(&last_event);
+        }
+        prev_touch_active = touch_active;
+        break;
+    }
+
+    default:
+        break;
+    }
+}
+#else
 static void touch_input_callback(struct input_event *evt, void *user_data) {
     ARG_UNUSED(user_data);
     LOG_DBG("INPUT EVENT: type=%d code=%d value=%d", evt->type, evt->code, evt->value);
+    bench_mark_input(evt);
 
     switch (evt->code) {
         case INPUT_KEY_DOWN:
@@ -250,6 +333,18 @@ static void touch_input_callback(struct input_event *evt, void *user_data) {
             break;
     }
 }
+#endif /* CONFIG_PROSPECTOR_TOUCH_GESTURES */
+
+#if IS_ENABLED(CONFIG_PROSPECTOR_TOUCH_LATENCY_BENCH)
+void touch_handler_inject_swipe(enum swipe_direction direction) {
+    touch_bench_mark(TOUCH_BENCH_INPUT);
+#if IS_ENABLED(CONFIG_PROSPECTOR_TOUCH_GESTURES)
+    touch_gesture_inject(direction);
+#else
+    raise_swipe_event(direction);
+#endif
+}
+#endif
 
 // Input callback registration macro (Zephyr 4.x requires 3 args: dev, callback, user_data)
 INPUT_CALLBACK_DEFINE(DEVICE_DT_GET(TOUCH_NODE), touch_input_callback, NULL);
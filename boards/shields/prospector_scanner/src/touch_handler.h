@@ -8,6 +8,7 @@
 
 #include <zephyr/kernel.h>
 #include <zephyr/device.h>
+#include "events/swipe_gesture_event.h"
 
 /**
  * Touch event data structure
@@ -55,3 +56,11 @@ int touch_handler_get_last_event(struct touch_event_data *event);
  * @return 0 on success, negative errno on failure
  */
 int touch_handler_register_lvgl_indev(void);
+
+/**
+ * Feed a synthetic gesture through the swipe path, as if it had just been
+ * detected (CONFIG_PROSPECTOR_TOUCH_LATENCY_BENCH)
+ *
+ * @param direction Gesture to raise
+ */
+void touch_handler_inject_swipe(enum swipe_direction direction);
@@ -0,0 +1,234 @@
+/*
+ * Copyright (c) 2024 The ZMK Contributors
+ *
+ * SPDX-License-Identifier: MIT
+ */
+
+#include <zephyr/kernel.h>
+#include <zephyr/sys/atomic.h>
+#include <zephyr/logging/log.h>
+#include <string.h>
+#include <lvgl.h>
+
+#include "touch_latency_bench.h"
+#include "touch_handler.h"
+
+LOG_MODULE_REGISTER(touch_bench, LOG_LEVEL_INF);
+
+#define PROBE_TIMEOUT_MS 2000  /* A gesture the UI ignored never reaches "flushed" */
+#define STEP_GAP_MS 600        /* Between scripted gestures; above the legacy swipe cooldown */
+#define STEP_POLL_MS 50
+
+/* ========== Stage Statistics ========== */
+/* Stage i runs from mark i to mark i + 1; the last entry is input -> flushed */
+
+#define STAGE_COUNT TOUCH_BENCH_MARK_COUNT
+#define STAGE_TOTAL (STAGE_COUNT - 1)
+
+struct stage_stats {
+    uint32_t min_us;
+    uint32_t max_us;
+    uint64_t sum_us;
+    uint32_t count;
+};
+
+static struct stage_stats stats[STAGE_COUNT];
+
+static const char *const stage_names[STAGE_COUNT] = {
+    "input>raised", "raised>listener", "listener>pickup", "pickup>created",
+    "created>flushed", "total",
+};
+
+static void stats_reset(void) {
+    memset(stats, 0, sizeof(stats));
+}
+
+static void stats_record(int stage, uint32_t us) {
+    struct stage_stats *s = &stats[stage];
+    if (s->count == 0 || us < s->min_us) {
+        s->min_us = us;
+    }
+    if (us > s->max_us) {
+        s->max_us = us;
+    }
+    s->sum_us += us;
+    s->count++;
+}
+
+static void stats_log(const char *what) {
+    LOG_INF("⏱ touch-to-photon, %s (n=%u):", what, stats[STAGE_TOTAL].count);
+    for (int i = 0; i < STAGE_COUNT; i++) {
+        const struct stage_stats *s = &stats[i];
+        if (s->count == 0) {
+            continue;
+        }
+        LOG_INF("⏱   %-16s min %6u avg %6u max %6u us", stage_names[i], s->min_us,
+                (uint32_t)(s->sum_us / s->count), s->max_us);
+    }
+}
+
+/* ========== Probe ========== */
+/* A single gesture in flight. probe_next is the mark expected next; each
+ * context only writes the timestamp of the mark it owns and then hands on. */
+
+static atomic_t probe_next = ATOMIC_INIT(TOUCH_BENCH_INPUT);
+static uint32_t probe_cyc[TOUCH_BENCH_MARK_COUNT];
+static uint32_t probes_done;
+
+static void probe_finish(void) {
+    for (int i = 0; i < STAGE_TOTAL; i++) {
+        stats_record(i, k_cyc_to_us_floor32(probe_cyc[i + 1] - probe_cyc[i]));
+    }
+    uint32_t total_us = k_cyc_to_us_floor32(probe_cyc[TOUCH_BENCH_FLUSHED] -
+                                            probe_cyc[TOUCH_BENCH_INPUT]);
+    stats_record(STAGE_TOTAL, total_us);
+    probes_done++;
+    LOG_DBG("Gesture on screen after %u us", total_us);
+}
+
+void touch_bench_mark(enum touch_bench_mark mark) {
+    uint32_t now = k_cycle_get_32();
+    atomic_val_t next = atomic_get(&probe_next);
+
+    if (mark == TOUCH_BENCH_INPUT) {
+        /* Every touch report restarts the probe until one becomes a gesture */
+        bool stale = k_cyc_to_ms_floor32(now - probe_cyc[TOUCH_BENCH_INPUT]) > PROBE_TIMEOUT_MS;
+        if (next > TOUCH_BENCH_RAISED && !stale) {
+            return;
+        }
+        probe_cyc[TOUCH_BENCH_INPUT] = now;
+        atomic_set(&probe_next, TOUCH_BENCH_RAISED);
+        return;
+    }
+
+    if (next != mark) {
+        return;
+    }
+    probe_cyc[mark] = now;
+    if (mark == TOUCH_BENCH_FLUSHED) {
+        probe_finish();
+        atomic_set(&probe_next, TOUCH_BENCH_INPUT);
+    } else {
+        atomic_set(&probe_next, mark + 1);
+    }
+}
+
+static bool probe_in_flight(void) {
+    return atomic_get(&probe_next) > TOUCH_BENCH_RAISED &&
+           k_cyc_to_ms_floor32(k_cycle_get_32() - probe_cyc[TOUCH_BENCH_INPUT]) <=
+               PROBE_TIMEOUT_MS;
+}
+
+/* LV_EVENT_REFR_READY fires at the end of every refresh timer run; as in
+ * latency_stats.c the flush is synchronous by then, so the first one after
+ * the widgets were created is when the new screen reached the panel. */
+static void refr_ready_cb(lv_event_t *e) {
+    ARG_UNUSED(e);
+    touch_bench_mark(TOUCH_BENCH_FLUSHED);
+}
+
+/* ========== Scripted Run ========== */
+/* main -> display settings -> main -> keyboard select -> main, per round */
+
+static const enum swipe_direction script[] = {
+    SWIPE_DIRECTION_DOWN,
+    SWIPE_DIRECTION_UP,
+    SWIPE_DIRECTION_UP,
+    SWIPE_DIRECTION_DOWN,
+};
+
+static struct {
+    uint8_t rounds_left;
+    uint8_t step;
+    uint32_t probes_at_start;
+    bool running;
+} run;
+
+static void bench_work_handler(struct k_work *work);
+static K_WORK_DELAYABLE_DEFINE(bench_work, bench_work_handler);
+
+static void bench_work_handler(struct k_work *work) {
+    ARG_UNUSED(work);
+
+    if (probe_in_flight()) {
+        k_work_schedule(&bench_work, K_MSEC(STEP_POLL_MS));
+        return;
+    }
+
+    if (run.step == ARRAY_SIZE(script)) {
+        run.step = 0;
+        run.rounds_left--;
+    }
+    if (run.rounds_left == 0) {
+        stats_log("scripted");
+        LOG_INF("⏱ %u gestures reached the panel, the rest timed out",
+                probes_done - run.probes_at_start);
+        run.running = false;
+        return;
+    }
+
+    touch_handler_inject_swipe(script[run.step++]);
+    k_work_schedule(&bench_work, K_MSEC(STEP_GAP_MS));
+}
+
+int touch_bench_start(uint8_t rounds) {
+    if (run.running) {
+        return -EBUSY;
+    }
+    stats_reset();
+    run.rounds_left = MAX(rounds, 1);
+    run.step = 0;
+    run.probes_at_start = probes_done;
+    run.running = true;
+    LOG_INF("⏱ Touch latency bench: %u rounds of %u gestures", run.rounds_left,
+            (unsigned int)ARRAY_SIZE(script));
+    k_work_schedule(&bench_work, K_NO_WAIT);
+    return 0;
+}
+
+void touch_bench_attach_display(void) {
+    lv_display_t *disp = lv_display_get_default();
+    if (!disp) {
+        LOG_WRN("No default display - touch latency bench disabled");
+        return;
+    }
+    lv_display_add_event_cb(disp, refr_ready_cb, LV_EVENT_REFR_READY, NULL);
+
+#if CONFIG_PROSPECTOR_TOUCH_LATENCY_BENCH_START_S > 0
+    stats_reset();
+    run.rounds_left = CONFIG_PROSPECTOR_TOUCH_LATENCY_BENCH_ROUNDS;
+    run.probes_at_start = probes_done;
+    run.running = true;
+    k_work_schedule(&bench_work, K_SECONDS(CONFIG_PROSPECTOR_TOUCH_LATENCY_BENCH_START_S));
+    LOG_INF("⏱ Touch latency bench starts in %ds", CONFIG_PROSPECTOR_TOUCH_LATENCY_BENCH_START_S);
+#endif
+}
+
+#if IS_ENABLED(CONFIG_SHELL)
+#include <zephyr/shell/shell.h>
+#include <stdlib.h>
+
+/* "touch_bench" runs the script; "touch_bench show" logs what real
+ * gestures measured since the last run */
+static int cmd_touch_bench(const struct shell *sh, size_t argc, char **argv) {
+    if (argc > 1 && strcmp(argv[1], "show") == 0) {
+        stats_log("since last run");
+        return 0;
+    }
+
+    uint8_t rounds = CONFIG_PROSPECTOR_TOUCH_LATENCY_BENCH_ROUNDS;
+    if (argc > 1) {
+        rounds = (uint8_t)CLAMP(atoi(argv[1]), 1, 100);
+    }
+    int rc = touch_bench_start(rounds);
+    if (rc == -EBUSY) {
+        shell_error(sh, "A run is already in progress");
+        return rc;
+    }
+    shell_print(sh, "Running %u rounds from the main screen; results go to the log", rounds);
+    return 0;
+}
+
+SHELL_CMD_ARG_REGISTER(touch_bench, NULL, "Touch-to-photon latency bench [rounds|show]",
+                       cmd_touch_bench, 1, 1);
+#endif
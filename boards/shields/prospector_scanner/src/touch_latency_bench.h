@@ -0,0 +1,42 @@
+/*
+ * Copyright (c) 2024 The ZMK Contributors
+ *
+ * SPDX-License-Identifier: MIT
+ *
+ * Touch-to-photon latency benchmark (CONFIG_PROSPECTOR_TOUCH_LATENCY_BENCH)
+ *
+ * One gesture at a time is followed through the transition path:
+ *   input      touch_handler.c got the lift / controller gesture code
+ *   raised     raise_swipe_event() (or the gesture engine) raised the ZMK event
+ *   listener   swipe_gesture_listener() queued it
+ *   pickup     swipe_process_timer_cb() took it on the LVGL thread
+ *   created    the next screen's widgets exist
+ *   flushed    the first display refresh after that has been written
+ * Real gestures are measured too; the scripted run (main -> display
+ * settings -> main -> keyboard select -> main, repeated) injects
+ * synthetic ones and logs min/avg/max per stage when done.
+ */
+
+#pragma once
+
+#include <stdint.h>
+
+enum touch_bench_mark {
+    TOUCH_BENCH_INPUT = 0,
+    TOUCH_BENCH_RAISED,
+    TOUCH_BENCH_LISTENER,
+    TOUCH_BENCH_PICKUP,
+    TOUCH_BENCH_CREATED,
+    TOUCH_BENCH_FLUSHED,
+    TOUCH_BENCH_MARK_COUNT,
+};
+
+/* Any thread: the probe reached @p mark. Out-of-order marks are ignored;
+ * TOUCH_BENCH_INPUT starts a new probe unless one is past "raised". */
+void touch_bench_mark(enum touch_bench_mark mark);
+
+/* LVGL thread: register the display refresh hook (call once after LVGL init) */
+void touch_bench_attach_display(void);
+
+/* Start the scripted run (must begin on the main screen); -EBUSY if one is running */
+int touch_bench_start(uint8_t rounds);
@@ -0,0 +1,54 @@
+/*
+ * Copyright (c) 2024 The ZMK Contributors
+ *
+ * SPDX-License-Identifier: MIT
+ */
+
+#pragma once
+
+#include <stdint.h>
+#include <stdbool.h>
+#include <zephyr/bluetooth/addr.h>
+
+#ifdef __cplusplus
+extern "C" {
+#endif
+
+/**
+ * @brief Advertisement capture and replay (CONFIG_PROSPECTOR_SCANNER_ADV_CAPTURE)
+ *
+ * The scan callback appends every report it gets to a RAM ring, the
+ * oldest records giving way to new ones. "adv_capture dump" prints the
+ * ring as hex lines, one record each, that "adv_capture load" takes back
+ * (on this or another scanner); "adv_capture replay" feeds the records
+ * through the scan callback again - parser, device cache,
+ * scanner_msg_send_keyboard_data() and on - at the recorded pace or
+ * faster.
+ *
+ * Record layout, little endian: the header below, then @c len AD bytes.
+ * The dump starts with "ADVCAP<version> <records> <bytes>".
+ */
+
+#define ZMK_ADV_CAPTURE_VERSION 1
+
+struct zmk_adv_capture_rec {
+    uint8_t len;        // AD bytes following the header (longer reports are cut)
+    uint8_t type;       // Report type as passed to the scan callback
+    int8_t rssi;
+    uint8_t addr_type;
+    uint8_t addr[6];
+    uint16_t dt_ms;     // Since the previous record, saturating at 65535
+} __packed;
+
+/**
+ * @brief Append one report (BT RX thread)
+ *
+ * @param ours The report has Prospector data or a name in it; with
+ *             "adv_capture start ours" only those are kept
+ */
+void zmk_adv_capture_record(const bt_addr_le_t *addr, int8_t rssi, uint8_t type,
+                            const uint8_t *data, uint16_t len, bool ours);
+
+#ifdef __cplusplus
+}
+#endif
@@ -0,0 +1,113 @@
+/*
+ * Copyright (c) 2024 The ZMK Contributors
+ *
+ * SPDX-License-Identifier: MIT
+ */
+
+#pragma once
+
+#include <stdbool.h>
+#include <stddef.h>
+#include <stdint.h>
+
+#ifdef __cplusplus
+extern "C" {
+#endif
+
+/**
+ * @brief Interned keyboard names
+ *
+ * One copy of each distinct keyboard name, referenced by a 16-bit handle
+ * (entry index and generation) instead of a 32-byte string per keyboard
+ * slot, ring entry, mailbox, pending update and display cache. Equal
+ * names intern to the same handle, so "did the name change" is a handle
+ * compare.
+ *
+ * Entries are reference counted. Long-lived owners (the BT RX device
+ * cache, keyboard slots) take a reference; everything else just stores
+ * the handle. An entry freed and reused gets a new generation, so a
+ * stale handle never compares equal to a live one and reads as no name.
+ *
+ * All functions are thread-safe and O(table size) at most.
+ *
+ * Usage:
+ *   zmk_keyboard_name_t name = zmk_keyboard_name_intern(ad_name, ad_len);
+ *   zmk_keyboard_name_copy(name, buf, sizeof(buf));
+ *   zmk_keyboard_name_release(name);
+ */
+
+/* Longest name kept, without the terminator */
+#define ZMK_KEYBOARD_NAME_MAX 31
+
+/* No name (also what a stale handle reads as) */
+#define ZMK_KEYBOARD_NAME_NONE 0
+
+typedef uint16_t zmk_keyboard_name_t;
+
+/**
+ * @brief Reference to the entry for a name, adding it if new
+ *
+ * @param name Name, not necessarily null-terminated
+ * @param len Length; longer names are truncated to ZMK_KEYBOARD_NAME_MAX
+ * @return Handle holding one reference, ZMK_KEYBOARD_NAME_NONE if len is 0
+ *         or the table is full
+ */
+zmk_keyboard_name_t zmk_keyboard_name_intern(const char *name, size_t len);
+
+/**
+ * @brief Take another reference to a handle, if it is still live
+ *
+ * @return The handle, ZMK_KEYBOARD_NAME_NONE if it was NONE or stale
+ */
+zmk_keyboard_name_t zmk_keyboard_name_hold(zmk_keyboard_name_t name);
+
+/**
+ * @brief Drop a reference (NONE and stale handles are ignored)
+ */
+void zmk_keyboard_name_release(zmk_keyboard_name_t name);
+
+/**
+ * @brief Copy the name of a handle
+ *
+ * @param name Handle, referenced or not
+ * @param buf Output, always null-terminated
+ * @param size Size of buf
+ * @return Length copied, 0 if the handle is NONE or stale
+ */
+size_t zmk_keyboard_name_copy(zmk_keyboard_name_t name, char *buf, size_t size);
+
+/**
+ * @brief Name of a handle in place
+ *
+ * Only for a handle the caller holds a reference on (or that one of its
+ * own structures holds): the string stays valid until that reference is
+ * released.
+ *
+ * @return Null-terminated name, "" if the handle is NONE or stale
+ */
+const char *zmk_keyboard_name_str(zmk_keyboard_name_t name);
+
+/**
+ * @brief Replace the referenced handle in @p slot by @p name
+ *
+ * Takes a reference to @p name and drops the slot's old one. The same
+ * handle again is a compare; NONE and stale handles leave the slot as
+ * it is, so a frame that carries no name keeps the last one.
+ *
+ * @return true if the slot's handle changed
+ */
+bool zmk_keyboard_name_set(zmk_keyboard_name_t *slot, zmk_keyboard_name_t name);
+
+/**
+ * @brief Replace the referenced handle in @p slot by the interned @p name
+ *
+ * Like zmk_keyboard_name_set() for a string: an empty name (or a full
+ * table) leaves the slot as it is.
+ *
+ * @return true if the slot's handle changed
+ */
+bool zmk_keyboard_name_set_str(zmk_keyboard_name_t *slot, const char *name, size_t len);
+
+#ifdef __cplusplus
+}
+#endif
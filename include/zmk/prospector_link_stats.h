@@ -0,0 +1,182 @@
+/*
+ * Copyright (c) 2024 The ZMK Contributors
+ *
+ * SPDX-License-Identifier: MIT
+ */
+
+#pragma once
+
+#include <stdint.h>
+#include <stdbool.h>
+#include <string.h>
+
+#ifdef __cplusplus
+extern "C" {
+#endif
+
+/**
+ * @brief Per-keyboard link quality statistics
+ *
+ * Updated once per received status frame at O(1) cost: exponentially
+ * weighted averages of the inter-arrival gap, of its deviation (jitter,
+ * as in RFC 3550) and of RSSI, a log-spaced gap histogram, and change
+ * loss from sequence number gaps (v3 / extended frames).
+ *
+ * Fixed point, integer only. Not thread-safe: update from a single
+ * context or under the caller's lock; readers take a copy.
+ *
+ * Usage:
+ *   prospector_link_stats_frames(&s, rx_time, 1, rssi);
+ *   prospector_link_stats_seq(&s, seq_delta);
+ *   uint32_t pps_x100 = prospector_link_stats_pps_x100(&s, now);
+ */
+
+#define PROSPECTOR_LINK_GAP_BUCKETS 8
+
+/* Upper gap bound (ms, exclusive) of each histogram bucket but the last */
+#define PROSPECTOR_LINK_GAP_EDGES {25, 50, 100, 200, 500, 1000, 2000}
+
+struct prospector_link_stats {
+    uint32_t frames;          // Status frames counted (saturates)
+    uint32_t last_rx;         // Arrival time of the newest frame (ms)
+    uint32_t gap_x16;         // Mean inter-arrival gap, ms x 16 (weight 1/8)
+    uint32_t jitter_x16;      // Mean |gap - mean gap|, ms x 16 (weight 1/16)
+    int16_t rssi_x16;         // Mean RSSI, dBm x 16 (weight 1/8)
+    uint16_t changes;         // Content changes known from seq (decaying)
+    uint16_t missed;          // Of those, never received (decaying)
+    uint16_t gap_hist[PROSPECTOR_LINK_GAP_BUCKETS];  // Gaps per bucket (halved as one fills)
+};
+
+/* Decay time constants are 2^shift samples */
+#define PROSPECTOR_LINK_GAP_SHIFT 3
+#define PROSPECTOR_LINK_JITTER_SHIFT 4
+#define PROSPECTOR_LINK_RSSI_SHIFT 3
+#define PROSPECTOR_LINK_SEQ_WINDOW 512  // Changes kept before both counts are halved
+
+static inline void prospector_link_stats_reset(struct prospector_link_stats *s) {
+    memset(s, 0, sizeof(*s));
+}
+
+static inline uint8_t prospector_link_gap_bucket(uint32_t gap_ms) {
+    static const uint16_t edges[] = PROSPECTOR_LINK_GAP_EDGES;
+    uint8_t b = 0;
+
+    while (b < sizeof(edges) / sizeof(edges[0]) && gap_ms >= edges[b]) {
+        b++;
+    }
+    return b;
+}
+
+/**
+ * @brief Account @p count frames, the newest received at @p rx_time
+ *
+ * @p count > 1 is a batch coalesced by the receiver: its gaps are taken
+ * as evenly spread since the previous frame.
+ */
+static inline void prospector_link_stats_frames(struct prospector_link_stats *s,
+                                                uint32_t rx_time, uint16_t count, int8_t rssi) {
+    if (count == 0) {
+        return;
+    }
+    if (s->frames > 0 && (int32_t)(rx_time - s->last_rx) < 0) {
+        // Older than the newest frame counted: no gap to take from it
+        s->frames = s->frames < UINT32_MAX - count ? s->frames + count : UINT32_MAX;
+        return;
+    }
+
+    int32_t rssi_x16 = (int32_t)rssi * 16;
+    if (s->frames == 0) {
+        s->rssi_x16 = (int16_t)rssi_x16;
+    } else {
+        s->rssi_x16 += (int16_t)((rssi_x16 - s->rssi_x16) / (1 << PROSPECTOR_LINK_RSSI_SHIFT));
+
+        uint32_t gap_x16 = (rx_time - s->last_rx) * 16 / count;
+        if (s->gap_x16 == 0) {
+            s->gap_x16 = gap_x16;  // First gap
+        } else {
+            int32_t dev = (int32_t)gap_x16 - (int32_t)s->gap_x16;
+            s->gap_x16 = (uint32_t)((int32_t)s->gap_x16 + dev / (1 << PROSPECTOR_LINK_GAP_SHIFT));
+            dev = dev < 0 ? -dev : dev;
+            s->jitter_x16 = (uint32_t)((int32_t)s->jitter_x16 +
+                                       (dev - (int32_t)s->jitter_x16) /
+                                           (1 << PROSPECTOR_LINK_JITTER_SHIFT));
+        }
+
+        uint16_t *bucket = &s->gap_hist[prospector_link_gap_bucket(gap_x16 / 16)];
+        if ((uint32_t)*bucket + count > UINT16_MAX) {
+            for (int i = 0; i < PROSPECTOR_LINK_GAP_BUCKETS; i++) {
+                s->gap_hist[i] /= 2;
+            }
+        }
+        *bucket += count;
+    }
+
+    s->frames = s->frames < UINT32_MAX - count ? s->frames + count : UINT32_MAX;
+    s->last_rx = rx_time;
+}
+
+/**
+ * @brief Account a sequence number step of @p delta (1 = nothing missed)
+ */
+static inline void prospector_link_stats_seq(struct prospector_link_stats *s, uint8_t delta) {
+    if (delta == 0) {
+        return;  // Repeat of a known state
+    }
+    if (s->changes + delta > PROSPECTOR_LINK_SEQ_WINDOW) {
+        s->changes /= 2;
+        s->missed /= 2;
+    }
+    s->changes += delta;
+    s->missed += delta - 1;
+}
+
+/**
+ * @brief Forget the change loss, e.g. when reception conditions were changed
+ */
+static inline void prospector_link_stats_reset_loss(struct prospector_link_stats *s) {
+    s->changes = 0;
+    s->missed = 0;
+}
+
+/**
+ * @brief Frames per second x 100 as of @p now
+ *
+ * A longer silence than the mean gap counts as the gap, so a keyboard
+ * that went quiet reads as slow at once instead of keeping its old rate.
+ */
+static inline uint32_t prospector_link_stats_pps_x100(const struct prospector_link_stats *s,
+                                                      uint32_t now) {
+    if (s->frames < 2 || s->gap_x16 == 0) {
+        return 0;
+    }
+    uint32_t gap_x16 = s->gap_x16;
+    uint32_t silent = now - s->last_rx;
+    if (silent < UINT32_MAX / 16 && silent * 16 > gap_x16) {
+        gap_x16 = silent * 16;
+    }
+    return 1000U * 100U * 16U / gap_x16;
+}
+
+static inline uint32_t prospector_link_stats_jitter_ms(const struct prospector_link_stats *s) {
+    return (s->jitter_x16 + 8) / 16;
+}
+
+static inline int8_t prospector_link_stats_rssi(const struct prospector_link_stats *s) {
+    return (int8_t)((s->rssi_x16 + (s->rssi_x16 < 0 ? -8 : 8)) / 16);
+}
+
+/**
+ * @brief Changes missed per mille, over about the last PROSPECTOR_LINK_SEQ_WINDOW
+ *
+ * @return Loss, or -1 while no sequence numbers have been seen
+ */
+static inline int prospector_link_stats_loss_permille(const struct prospector_link_stats *s) {
+    if (s->changes == 0) {
+        return -1;
+    }
+    return (int)((uint32_t)s->missed * 1000U / s->changes);
+}
+
+#ifdef __cplusplus
+}
+#endif
@@ -0,0 +1,137 @@
+/*
+ * Copyright (c) 2024 The ZMK Contributors
+ *
+ * SPDX-License-Identifier: MIT
+ */
+
+#pragma once
+
+#include <stdint.h>
+#include <stdbool.h>
+#include <string.h>
+
+#ifdef __cplusplus
+extern "C" {
+#endif
+
+/**
+ * @brief Sliding-window accumulator with O(1) sum
+ *
+ * Fixed ring of per-tick buckets plus a running sum. Advancing the window
+ * subtracts the evicted bucket instead of re-summing, so reading the sum
+ * costs the same for a 4-tick or a 120-tick window. A "tick" is whatever
+ * the caller uses as time base (seconds for WPM, sample number for the
+ * scanner's reception rate).
+ *
+ * Integer only - no float on the hot path. Not thread-safe: use from a
+ * single context or under the caller's lock.
+ *
+ * Usage:
+ *   PROSPECTOR_RATE_WINDOW_DEFINE(wpm_window, 30);
+ *   prospector_rate_window_add(&wpm_window, now_s, 1);
+ *   prospector_rate_window_advance(&wpm_window, now_s);
+ *   uint32_t keys = prospector_rate_window_sum(&wpm_window);
+ */
+struct prospector_rate_window {
+    uint16_t *buckets;   // Caller-provided storage, `size` entries
+    uint8_t size;        // Window length in ticks
+    uint8_t head;        // Bucket of the current tick
+    uint8_t filled;      // Ticks covered so far (saturates at size)
+    bool started;        // First tick seen
+    uint32_t sum;        // Running sum of all buckets
+    uint32_t last_tick;  // Tick that `head` belongs to
+};
+
+/**
+ * @brief Define a static window with its bucket storage
+ */
+#define PROSPECTOR_RATE_WINDOW_DEFINE(name, ticks)                                  \
+    static uint16_t name##_buckets[(ticks)];                                        \
+    static struct prospector_rate_window name = {                                   \
+        .buckets = name##_buckets,                                                  \
+        .size = (ticks),                                                            \
+    }
+
+/**
+ * @brief Clear all buckets and forget the time base
+ */
+static inline void prospector_rate_window_reset(struct prospector_rate_window *w) {
+    memset(w->buckets, 0, w->size * sizeof(w->buckets[0]));
+    w->head = 0;
+    w->filled = 0;
+    w->started = false;
+    w->sum = 0;
+    w->last_tick = 0;
+}
+
+/**
+ * @brief Roll the window forward to @p tick, evicting expired buckets
+ *
+ * Cost is one step per elapsed tick (bounded by the window size), i.e.
+ * amortised O(1) when called at least once per window.
+ */
+static inline void prospector_rate_window_advance(struct prospector_rate_window *w,
+                                                  uint32_t tick) {
+    if (!w->started) {
+        w->started = true;
+        w->last_tick = tick;
+        w->filled = 1;
+        return;
+    }
+
+    uint32_t elapsed = tick - w->last_tick;
+    if (elapsed == 0) {
+        return;
+    }
+
+    if (elapsed >= w->size) {
+        // Whole window expired - cheaper to clear than to step
+        memset(w->buckets, 0, w->size * sizeof(w->buckets[0]));
+        w->sum = 0;
+        w->head = 0;
+        w->filled = w->size;
+    } else {
+        for (uint32_t i = 0; i < elapsed; i++) {
+            w->head = (w->head + 1) % w->size;
+            w->sum -= w->buckets[w->head];
+            w->buckets[w->head] = 0;
+            if (w->filled < w->size) {
+                w->filled++;
+            }
+        }
+    }
+    w->last_tick = tick;
+}
+
+/**
+ * @brief Add @p value to the bucket of @p tick (saturates at UINT16_MAX)
+ */
+static inline void prospector_rate_window_add(struct prospector_rate_window *w,
+                                              uint32_t tick, uint32_t value) {
+    prospector_rate_window_advance(w, tick);
+
+    uint32_t room = UINT16_MAX - w->buckets[w->head];
+    if (value > room) {
+        value = room;
+    }
+    w->buckets[w->head] += value;
+    w->sum += value;
+}
+
+/**
+ * @brief Sum over the whole window (call advance() first to expire old ticks)
+ */
+static inline uint32_t prospector_rate_window_sum(const struct prospector_rate_window *w) {
+    return w->sum;
+}
+
+/**
+ * @brief Number of ticks covered so far (1..size), 0 before the first tick
+ */
+static inline uint8_t prospector_rate_window_samples(const struct prospector_rate_window *w) {
+    return w->filled;
+}
+
+#ifdef __cplusplus
+}
+#endif
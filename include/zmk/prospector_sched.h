@@ -0,0 +1,88 @@
+/*
+ * Copyright (c) 2024 The ZMK Contributors
+ *
+ * SPDX-License-Identifier: MIT
+ */
+
+#pragma once
+
+#include <stdint.h>
+#include <stdbool.h>
+#include <stddef.h>
+
+#ifdef __cplusplus
+extern "C" {
+#endif
+
+/**
+ * @brief Tiny deadline scheduler for a single work item
+ *
+ * Each traffic class is armed with a due time and a latency budget: it
+ * may be serviced anywhere in [due, due + budget]. The next wake is the
+ * earliest due + budget over all armed classes, and on that wake every
+ * class whose due time has passed is serviced together. Classes with
+ * slack therefore ride along on a tighter neighbour's wake instead of
+ * causing their own.
+ *
+ * Times are k_uptime_get_32() milliseconds; comparisons are wrap-safe.
+ * Not thread-safe: arm and query from the owning work queue only.
+ *
+ * Usage:
+ *   prospector_sched_arm(&classes[STATUS], now, interval_ms, interval_ms / 8);
+ *   if (prospector_sched_due(&classes[STATUS], now)) { ... }
+ *   k_work_schedule(&work, K_MSEC(prospector_sched_next_wake(classes, N, now)));
+ */
+struct prospector_sched_class {
+    uint32_t due;        // Earliest time the class wants service
+    uint32_t budget_ms;  // How long after `due` it may wait for a shared wake
+    bool armed;
+};
+
+#define PROSPECTOR_SCHED_IDLE_MS UINT32_MAX  // next_wake() with nothing armed
+
+/**
+ * @brief (Re)arm @p c to be due @p delay_ms from @p now
+ */
+static inline void prospector_sched_arm(struct prospector_sched_class *c, uint32_t now,
+                                        uint32_t delay_ms, uint32_t budget_ms) {
+    c->due = now + delay_ms;
+    c->budget_ms = budget_ms;
+    c->armed = true;
+}
+
+static inline void prospector_sched_disarm(struct prospector_sched_class *c) {
+    c->armed = false;
+}
+
+/**
+ * @brief True once @p c is armed and its due time has passed
+ */
+static inline bool prospector_sched_due(const struct prospector_sched_class *c, uint32_t now) {
+    return c->armed && (int32_t)(now - c->due) >= 0;
+}
+
+/**
+ * @brief Milliseconds from @p now until the next wake (0 = overdue)
+ *
+ * Only considers the @p count classes starting at @p classes, so a caller
+ * can restrict the wake to one class (e.g. a gate that suppresses the rest).
+ */
+static inline uint32_t prospector_sched_next_wake(const struct prospector_sched_class *classes,
+                                                  size_t count, uint32_t now) {
+    uint32_t wake = PROSPECTOR_SCHED_IDLE_MS;
+    for (size_t i = 0; i < count; i++) {
+        if (!classes[i].armed) {
+            continue;
+        }
+        int32_t until = (int32_t)(classes[i].due + classes[i].budget_ms - now);
+        uint32_t ms = until > 0 ? (uint32_t)until : 0;
+        if (ms < wake) {
+            wake = ms;
+        }
+    }
+    return wake;
+}
+
+#ifdef __cplusplus
+}
+#endif
@@ -0,0 +1,64 @@
+/*
+ * Copyright (c) 2024 The ZMK Contributors
+ *
+ * SPDX-License-Identifier: MIT
+ */
+
+#pragma once
+
+#include <stdint.h>
+
+#ifdef CONFIG_PROSPECTOR_TRACE
+#include <zephyr/tracing/tracing.h>
+#endif
+
+#ifdef __cplusplus
+extern "C" {
+#endif
+
+/**
+ * @brief Pipeline tracing markers (CONFIG_PROSPECTOR_TRACE)
+ *
+ * Stage boundaries of BT RX -> ring -> work queue -> LVGL -> flush raise
+ * Zephyr named trace events (sys_trace_named_event()), so the tracing
+ * backend records them next to the kernel's own thread switches and
+ * ISRs. arg0 is the phase, arg1 a stage-specific value. Without the
+ * option every marker compiles to nothing, arguments included.
+ *
+ * Usage:
+ *   PSPTR_TRACE_SCOPE("psptr_scan", buf->len);  // Begin now, end on any return
+ *   PSPTR_TRACE_MARK("psptr_push", index);      // Single point in time
+ */
+
+#define PSPTR_TRACE_PHASE_END   0
+#define PSPTR_TRACE_PHASE_BEGIN 1
+#define PSPTR_TRACE_PHASE_MARK  2
+
+#ifdef CONFIG_PROSPECTOR_TRACE
+
+#define PSPTR_TRACE_EVENT(name, phase, value)                                                   \
+    sys_trace_named_event((name), (phase), (uint32_t)(value))
+
+static inline void psptr_trace_scope_end(const char *const *name) {
+    sys_trace_named_event(*name, PSPTR_TRACE_PHASE_END, 0);
+}
+
+/* The end event fires when the enclosing block is left, early returns included */
+#define PSPTR_TRACE_SCOPE(name, value)                                                          \
+    PSPTR_TRACE_EVENT(name, PSPTR_TRACE_PHASE_BEGIN, value);                                    \
+    const char *const psptr_trace_scope_ __attribute__((cleanup(psptr_trace_scope_end))) = (name)
+
+#else
+
+#define PSPTR_TRACE_EVENT(name, phase, value) do { } while (0)
+#define PSPTR_TRACE_SCOPE(name, value) do { } while (0)
+
+#endif
+
+#define PSPTR_TRACE_BEGIN(name, value) PSPTR_TRACE_EVENT(name, PSPTR_TRACE_PHASE_BEGIN, value)
+#define PSPTR_TRACE_END(name, value) PSPTR_TRACE_EVENT(name, PSPTR_TRACE_PHASE_END, value)
+#define PSPTR_TRACE_MARK(name, value) PSPTR_TRACE_EVENT(name, PSPTR_TRACE_PHASE_MARK, value)
+
+#ifdef __cplusplus
+}
+#endif
@@ -0,0 +1,51 @@
+/*
+ * Copyright (c) 2024 The ZMK Contributors
+ *
+ * SPDX-License-Identifier: MIT
+ */
+
+#pragma once
+
+#include <stdint.h>
+#include <stdbool.h>
+
+#ifdef __cplusplus
+extern "C" {
+#endif
+
+/**
+ * @brief Split link telemetry (CONFIG_PROSPECTOR_SPLIT_LINK_TELEMETRY)
+ *
+ * Kept by the split central per peripheral slot (same index as
+ * zmk_peripheral_battery_state_changed.source): connection parameters
+ * from connect and parameter update events, RSSI read from the
+ * controller every CONFIG_PROSPECTOR_SPLIT_LINK_SAMPLE_S, and how often
+ * the link had to be re-established since boot.
+ */
+
+#define PSPTR_SPLIT_LINK_RSSI_UNKNOWN 0  // RSSI is always negative when known
+
+struct psptr_split_link {
+    bool connected;
+    uint16_t interval;     // Connection interval, 1.25ms units
+    uint16_t latency;      // Peripheral latency, connection events
+    uint16_t timeout;      // Supervision timeout, 10ms units
+    int8_t rssi;           // dBm, averaged over samples; PSPTR_SPLIT_LINK_RSSI_UNKNOWN if none
+    uint16_t reconnects;   // Connections after the first one (saturates)
+    uint32_t connected_at; // k_uptime_get_32() of the current connection
+};
+
+/**
+ * @brief Copy the telemetry of a peripheral slot
+ *
+ * Safe from any thread.
+ *
+ * @param slot Peripheral slot (0 to ZMK_SPLIT_BLE_PERIPHERAL_COUNT-1)
+ * @param out Output: telemetry
+ * @return false if @p slot is out of range
+ */
+bool psptr_split_link_get(int slot, struct psptr_split_link *out);
+
+#ifdef __cplusplus
+}
+#endif
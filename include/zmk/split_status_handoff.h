@@ -0,0 +1,61 @@
+/*
+ * Copyright (c) 2024 The ZMK Contributors
+ *
+ * SPDX-License-Identifier: MIT
+ */
+
+#pragma once
+
+#include <stdint.h>
+#include <stdbool.h>
+#include <zephyr/bluetooth/uuid.h>
+#include <zmk/status_advertisement.h>
+
+#ifdef __cplusplus
+extern "C" {
+#endif
+
+/**
+ * @brief Split status handoff (CONFIG_PROSPECTOR_SPLIT_ADV_BALANCE)
+ *
+ * The keyboard half peripheral exposes a write-without-response
+ * characteristic on the existing split connection. The central writes
+ * the 26-byte legacy frame it would have advertised, plus a carry flag.
+ * While the flag is set, the peripheral advertises that frame
+ * (non-connectable, its identity address) and the central's own status
+ * ADV stays off. Scanners follow the keyboard across the address change
+ * through keyboard_id + device_role.
+ */
+
+#define PSPTR_STATUS_HANDOFF_SVC_UUID \
+    BT_UUID_128_ENCODE(0x50535054, 0x4841, 0x4e44, 0x8000, 0x000000000000)
+#define PSPTR_STATUS_HANDOFF_CHR_UUID \
+    BT_UUID_128_ENCODE(0x50535054, 0x4841, 0x4e44, 0x8000, 0x000000000001)
+
+#define PSPTR_STATUS_HANDOFF_FLAG_CARRY BIT(0)  // Peripheral advertises the frame
+
+struct psptr_status_handoff_msg {
+    uint8_t flags;
+    uint8_t frame[sizeof(struct zmk_status_adv_data)];  // Manufacturer AD, as on air
+} __packed;
+
+/**
+ * @brief Send a frame to the keyboard half (central only)
+ *
+ * Work queue context. With @p carry false the peripheral stops
+ * advertising and @p frame is ignored.
+ *
+ * @return 0 on success, -ENOTCONN if the half is not connected or has no
+ *         handoff characteristic, -EMSGSIZE if the ATT MTU is too small,
+ *         or the bt_gatt_write_without_response() error
+ */
+int psptr_status_handoff_send(const uint8_t *frame, bool carry);
+
+/**
+ * @brief Whether the keyboard half's handoff characteristic is known (central only)
+ */
+bool psptr_status_handoff_ready(void);
+
+#ifdef __cplusplus
+}
+#endif
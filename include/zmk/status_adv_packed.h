@@ -0,0 +1,161 @@
+/*
+ * Copyright (c) 2024 The ZMK Contributors
+ *
+ * SPDX-License-Identifier: MIT
+ */
+
+#pragma once
+
+#include <stdint.h>
+#include <stdbool.h>
+#include <stddef.h>
+#include <string.h>
+
+#include <zmk/status_advertisement.h>
+
+#ifdef __cplusplus
+extern "C" {
+#endif
+
+/**
+ * @brief Bit-packed v3 wire format (CONFIG_ZMK_STATUS_ADV_PACKED)
+ *
+ * Same 26-byte slot and header as the legacy frame; the version byte
+ * selects the layout: [7:4] = 0xF (never a real module major), [3:0] = 3.
+ * The remaining 21 bytes are an MSB-first bitstream:
+ *
+ *   seq:8  age_ms:10  battery:7  layer:4  profile:3  connections:3
+ *   status_flags:6  role:2  ver_major:4  ver_minor:4  ver_patch:3  ver_dev:1
+ *   peripheral_battery:7 x3  static_hash:8  layer_name:7 x4 (ASCII)
+ *   keyboard_id:32  modifier_flags:8  wpm:8  channel:8       = 168 bits
+ *
+ * struct zmk_status_adv_data stays the decoded in-memory form on both
+ * sides; only the bytes on air differ. seq increments on every content
+ * change, age_ms is the time from that change (or the key press that
+ * caused it) to the frame being built, saturating at 1023 ms. Scanners
+ * use seq to drop repeats early and count missed changes from seq gaps.
+ */
+#define ZMK_STATUS_ADV_PACKED_MARKER   0xF
+#define ZMK_STATUS_ADV_PACKED_LAYOUT   3
+#define ZMK_STATUS_ADV_PACKED_AGE_MAX  1023
+
+#define ZMK_STATUS_ADV_IS_PACKED(version_byte) \
+    (((version_byte) >> 4) == ZMK_STATUS_ADV_PACKED_MARKER && \
+     ((version_byte) & 0x0F) == ZMK_STATUS_ADV_PACKED_LAYOUT)
+
+struct zmk_status_adv_bits {
+    uint8_t *buf;
+    size_t pos;  // Bit position from the start of buf
+};
+
+static inline void zmk_status_adv_put_bits(struct zmk_status_adv_bits *b, uint32_t value,
+                                           uint8_t width) {
+    for (int i = width - 1; i >= 0; i--) {
+        uint8_t mask = 0x80 >> (b->pos & 7);
+        if (value & (1u << i)) {
+            b->buf[b->pos >> 3] |= mask;
+        } else {
+            b->buf[b->pos >> 3] &= ~mask;
+        }
+        b->pos++;
+    }
+}
+
+static inline uint32_t zmk_status_adv_get_bits(struct zmk_status_adv_bits *b, uint8_t width) {
+    uint32_t value = 0;
+    for (uint8_t i = 0; i < width; i++) {
+        value = (value << 1) | ((b->buf[b->pos >> 3] >> (7 - (b->pos & 7))) & 1);
+        b->pos++;
+    }
+    return value;
+}
+
+/**
+ * @brief Encode @p in into a 26-byte v3 frame
+ */
+static inline void zmk_status_adv_pack_v3(const struct zmk_status_adv_data *in, uint8_t seq,
+                                          uint16_t age_ms,
+                                          uint8_t out[sizeof(struct zmk_status_adv_data)]) {
+    memcpy(out, in->manufacturer_id, 2);
+    memcpy(&out[2], in->service_uuid, 2);
+    out[4] = (ZMK_STATUS_ADV_PACKED_MARKER << 4) | ZMK_STATUS_ADV_PACKED_LAYOUT;
+
+    struct zmk_status_adv_bits b = {.buf = &out[5], .pos = 0};
+    zmk_status_adv_put_bits(&b, seq, 8);
+    zmk_status_adv_put_bits(&b, age_ms > ZMK_STATUS_ADV_PACKED_AGE_MAX ?
+                                ZMK_STATUS_ADV_PACKED_AGE_MAX : age_ms, 10);
+    zmk_status_adv_put_bits(&b, in->battery_level, 7);
+    zmk_status_adv_put_bits(&b, in->active_layer, 4);
+    zmk_status_adv_put_bits(&b, PROSPECTOR_DECODE_PROFILE(in->profile_slot), 3);
+    zmk_status_adv_put_bits(&b, in->connection_count, 3);
+    zmk_status_adv_put_bits(&b, in->status_flags, 6);
+    zmk_status_adv_put_bits(&b, in->device_role, 2);
+    zmk_status_adv_put_bits(&b, PROSPECTOR_DECODE_VERSION_MAJOR(in->version), 4);
+    zmk_status_adv_put_bits(&b, PROSPECTOR_DECODE_VERSION_MINOR(in->version), 4);
+    zmk_status_adv_put_bits(&b, PROSPECTOR_DECODE_PATCH(in->profile_slot), 3);
+    zmk_status_adv_put_bits(&b, PROSPECTOR_DECODE_DEV(in->profile_slot), 1);
+    for (int i = 0; i < 3; i++) {
+        zmk_status_adv_put_bits(&b, in->peripheral_battery[i], 7);
+    }
+    zmk_status_adv_put_bits(&b, in->static_hash, 8);
+    for (int i = 0; i < 4; i++) {
+        uint8_t c = (uint8_t)in->layer_name[i];
+        zmk_status_adv_put_bits(&b, c < 0x80 ? c : '?', 7);
+    }
+    for (int i = 0; i < 4; i++) {
+        zmk_status_adv_put_bits(&b, in->keyboard_id[i], 8);
+    }
+    zmk_status_adv_put_bits(&b, in->modifier_flags, 8);
+    zmk_status_adv_put_bits(&b, in->wpm_value, 8);
+    zmk_status_adv_put_bits(&b, in->channel, 8);
+}
+
+/**
+ * @brief Decode a v3 frame back into the in-memory struct
+ *
+ * @return false if @p in is not a v3 frame or is too short
+ */
+static inline bool zmk_status_adv_unpack_v3(const uint8_t *in, size_t len,
+                                            struct zmk_status_adv_data *out,
+                                            uint8_t *seq, uint16_t *age_ms) {
+    if (len < sizeof(struct zmk_status_adv_data) || !ZMK_STATUS_ADV_IS_PACKED(in[4])) {
+        return false;
+    }
+
+    memcpy(out->manufacturer_id, in, 2);
+    memcpy(out->service_uuid, &in[2], 2);
+
+    struct zmk_status_adv_bits b = {.buf = (uint8_t *)&in[5], .pos = 0};
+    *seq = zmk_status_adv_get_bits(&b, 8);
+    *age_ms = zmk_status_adv_get_bits(&b, 10);
+    out->battery_level = zmk_status_adv_get_bits(&b, 7);
+    out->active_layer = zmk_status_adv_get_bits(&b, 4);
+    uint8_t profile = zmk_status_adv_get_bits(&b, 3);
+    out->connection_count = zmk_status_adv_get_bits(&b, 3);
+    out->status_flags = zmk_status_adv_get_bits(&b, 6);
+    out->device_role = zmk_status_adv_get_bits(&b, 2);
+    uint8_t major = zmk_status_adv_get_bits(&b, 4);
+    uint8_t minor = zmk_status_adv_get_bits(&b, 4);
+    uint8_t patch = zmk_status_adv_get_bits(&b, 3);
+    uint8_t dev = zmk_status_adv_get_bits(&b, 1);
+    out->version = (major << 4) | minor;
+    out->profile_slot = (dev << 6) | (patch << 3) | profile;
+    for (int i = 0; i < 3; i++) {
+        out->peripheral_battery[i] = zmk_status_adv_get_bits(&b, 7);
+    }
+    out->static_hash = zmk_status_adv_get_bits(&b, 8);
+    for (int i = 0; i < 4; i++) {
+        out->layer_name[i] = (char)zmk_status_adv_get_bits(&b, 7);
+    }
+    for (int i = 0; i < 4; i++) {
+        out->keyboard_id[i] = zmk_status_adv_get_bits(&b, 8);
+    }
+    out->modifier_flags = zmk_status_adv_get_bits(&b, 8);
+    out->wpm_value = zmk_status_adv_get_bits(&b, 8);
+    out->channel = zmk_status_adv_get_bits(&b, 8);
+    return true;
+}
+
+#ifdef __cplusplus
+}
+#endif
@@ -29,7 +29,7 @@ struct zmk_status_adv_data {
     uint8_t connection_count;      // Number of connected devices 0-5
     uint8_t status_flags;          // Status flags (bit field)
     uint8_t device_role;           // Device role (CENTRAL/PERIPHERAL/STANDALONE)
-    uint8_t device_index;          // Device index for split keyboards
+    uint8_t static_hash;           // 8-bit hash of the static packet (0 = not sent; was device_index)
     uint8_t peripheral_battery[3]; // Battery levels: [0]=Left keyboard, [1]=Right/Aux, [2]=Third device (0=N/A)
     char layer_name[4];            // Layer name (null-terminated, reduced from 6 to 4)
     uint8_t keyboard_id[4];        // Keyboard identifier
@@ -125,6 +125,101 @@ struct zmk_status_adv_data {
  */
 #define ZMK_STATUS_ADV_SERVICE_UUID 0xABCD
 
+/**
+ * @brief Extended advertising format (CONFIG_ZMK_STATUS_ADV_EXTENDED)
+ *
+ * Manufacturer data on a BT5 extended advertising set:
+ *   [0xFF 0xFF] [0xAB 0xCE] [format] [type][len][value...] ...
+ *
+ * Records are TLV; scanners skip unknown types, so new records can be
+ * added without breaking older scanners. The CORE record carries the
+ * legacy 26-byte struct verbatim so both paths decode the same way.
+ */
+#define ZMK_STATUS_ADV_EXT_SERVICE_UUID  0xABCE
+#define ZMK_STATUS_ADV_EXT_FORMAT        1
+#define ZMK_STATUS_ADV_EXT_HEADER_LEN    5   // manufacturer_id + service_uuid + format
+#define ZMK_STATUS_ADV_EXT_MAX_LEN       128 // Well under one AUX_ADV_IND PDU (~250 bytes)
+
+enum zmk_status_adv_ext_tlv {
+    ZMK_STATUS_ADV_TLV_CORE          = 0x01,  // struct zmk_status_adv_data (26 bytes)
+    ZMK_STATUS_ADV_TLV_KEYBOARD_NAME = 0x02,  // BLE device name, not null-terminated
+    ZMK_STATUS_ADV_TLV_LAYER_NAME    = 0x03,  // Full active layer name, not null-terminated
+    ZMK_STATUS_ADV_TLV_LAYER_COUNT   = 0x04,  // uint8_t number of keymap layers
+    ZMK_STATUS_ADV_TLV_STATIC_CHUNK  = 0x05,  // Static frame minus its 4-byte header
+    ZMK_STATUS_ADV_TLV_SEQUENCE      = 0x06,  // [seq][age_ms LE16], see status_adv_packed.h
+    ZMK_STATUS_ADV_TLV_RELAY_ORIGIN  = 0x07,  // struct zmk_status_adv_relay_origin (relay only)
+    ZMK_STATUS_ADV_TLV_SPLIT_LINK    = 0x08,  // {[rssi][reconnects]} per split peripheral, max 3
+};
+
+// Matches prospector_keyboard_data.current_layer_name[8] on the scanner
+#define ZMK_STATUS_ADV_EXT_LAYER_NAME_MAX 7
+
+/**
+ * @brief Extra fields beyond the 26-byte core (scanner side)
+ *
+ * Decoded from extended advertisements, and from v3 packed frames for
+ * the sequence fields.
+ */
+struct zmk_status_adv_ext_fields {
+    char layer_name[ZMK_STATUS_ADV_EXT_LAYER_NAME_MAX + 1];  // Null-terminated, "" if not sent
+    uint8_t layer_count;                                     // 0 = unknown
+    bool has_seq;                                            // seq/age_ms below are valid
+    uint8_t seq;                                             // Increments on every content change
+    uint16_t age_ms;                                         // Change-to-build time of this frame
+    int8_t peripheral_rssi[3];                               // Split link RSSI (dBm), 0 = unknown
+    uint8_t peripheral_reconnects[3];                        // Split reconnects since boot
+};
+
+/**
+ * @brief Relay frame (CONFIG_PROSPECTOR_SCANNER_RELAY)
+ *
+ * A scanner re-advertising a keyboard it hears: the extended TLV layout
+ * under its own service UUID, so scanners that don't listen to relays
+ * ignore it, with a RELAY_ORIGIN record naming the keyboard. The CORE
+ * record keeps the keyboard's own channel byte.
+ */
+#define ZMK_STATUS_ADV_RELAY_SERVICE_UUID 0xABC0
+
+struct zmk_status_adv_relay_origin {
+    uint8_t addr[6];        // Keyboard's BLE address (little-endian, as bt_addr_t)
+    uint8_t addr_type;      // Keyboard's BLE address type
+    int8_t rssi;            // Keyboard as heard by the relay (dBm)
+    uint8_t relay_channel;  // Relay channel 1-255; listeners only take their own
+} __packed;
+
+/**
+ * @brief Static packet (rarely-changing keyboard info)
+ *
+ * Blob layout: [name_len][name...][layer_count]{[len][layer name...]}*
+ * The blob is split into ZMK_STATUS_ADV_STATIC_CHUNK_LEN pieces, each sent
+ * in its own 26-byte frame under service UUID 0xABCF. The dynamic frame's
+ * static_hash tells scanners whether the copy they hold is still current,
+ * so they only re-assemble after it changes.
+ */
+#define ZMK_STATUS_ADV_STATIC_SERVICE_UUID  0xABCF
+#define ZMK_STATUS_ADV_STATIC_CHUNK_LEN     20
+#define ZMK_STATUS_ADV_STATIC_MAX_CHUNKS    6
+#define ZMK_STATUS_ADV_STATIC_MAX_LEN       (ZMK_STATUS_ADV_STATIC_CHUNK_LEN * ZMK_STATUS_ADV_STATIC_MAX_CHUNKS)
+#define ZMK_STATUS_ADV_STATIC_NAME_MAX      23  // Interned whole: <= ZMK_KEYBOARD_NAME_MAX
+#define ZMK_STATUS_ADV_STATIC_MAX_LAYERS    10  // Also sizes layer_name_cache entries
+
+struct zmk_status_adv_static_frame {
+    uint8_t manufacturer_id[2];    // 0xFF, 0xFF
+    uint8_t service_uuid[2];       // 0xAB, 0xCF
+    uint8_t static_hash;           // Same value as zmk_status_adv_data.static_hash
+    uint8_t chunk;                 // [7:4] = chunk index, [3:0] = chunk count
+    uint8_t data[ZMK_STATUS_ADV_STATIC_CHUNK_LEN];
+} __packed;  // Total: 26 bytes (same slot as the dynamic frame)
+
+/**
+ * @brief Static packet decoded by the scanner
+ */
+struct zmk_status_adv_static_info {
+    uint8_t hash;         // static_hash of the assembled blob, 0 = nothing assembled yet
+    uint8_t layer_count;  // 0 = unknown
+    char layer_names[ZMK_STATUS_ADV_STATIC_MAX_LAYERS][ZMK_STATUS_ADV_EXT_LAYER_NAME_MAX + 1];
+};
+
 /**
  * @brief Initialize status advertisement
  * 
@@ -0,0 +1,48 @@
+/*
+ * Copyright (c) 2024 The ZMK Contributors
+ *
+ * SPDX-License-Identifier: MIT
+ */
+
+#pragma once
+
+#include <stdint.h>
+#include <zephyr/bluetooth/uuid.h>
+#include <zmk/status_advertisement.h>
+
+#ifdef __cplusplus
+extern "C" {
+#endif
+
+/**
+ * @brief Prospector status GATT service (CONFIG_ZMK_STATUS_ADV_GATT)
+ *
+ * One read + notify characteristic holding the same 26-byte
+ * struct zmk_status_adv_data the keyboard advertises. A scanner built
+ * with CONFIG_PROSPECTOR_SCANNER_GATT_LINK connects to the selected
+ * keyboard through its (connectable) status ADV set, raises the ATT MTU
+ * so a whole frame fits one notification, and subscribes. No pairing:
+ * the values are what the keyboard broadcasts anyway.
+ */
+
+#define PSPTR_STATUS_GATT_SVC_UUID \
+    BT_UUID_128_ENCODE(0x50535054, 0x5354, 0x4154, 0x8000, 0x000000000000)
+#define PSPTR_STATUS_GATT_CHR_UUID \
+    BT_UUID_128_ENCODE(0x50535054, 0x5354, 0x4154, 0x8000, 0x000000000001)
+
+/* ATT MTU a frame notification needs: opcode + handle + frame */
+#define PSPTR_STATUS_GATT_MIN_MTU (3 + sizeof(struct zmk_status_adv_data))
+
+/**
+ * @brief Store a new status frame and notify subscribed scanners (keyboard only)
+ *
+ * Work queue context. Called on every status build, so an unchanged frame
+ * doubles as a keepalive for the scanner's keyboard timeout.
+ *
+ * @return 0 on success or with nobody subscribed, else the bt_gatt_notify() error
+ */
+int zmk_status_gatt_notify(const struct zmk_status_adv_data *data);
+
+#ifdef __cplusplus
+}
+#endif
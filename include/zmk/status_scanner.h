@@ -9,6 +9,14 @@
 #include <stdint.h>
 #include <stdbool.h>
 #include <zmk/status_advertisement.h>
+#include <zmk/keyboard_names.h>
+#ifdef CONFIG_PROSPECTOR_LINK_STATS
+#include <zmk/prospector_link_stats.h>
+#endif
+#if defined(CONFIG_PROSPECTOR_SCANNER_PIPELINE_BENCH) || \
+    defined(CONFIG_PROSPECTOR_SCANNER_ADV_CAPTURE)
+#include <zephyr/bluetooth/addr.h>
+#endif
 
 #ifdef __cplusplus
 extern "C" {
@@ -19,17 +27,44 @@ extern "C" {
  */
 #define ZMK_STATUS_SCANNER_MAX_KEYBOARDS CONFIG_PROSPECTOR_MAX_KEYBOARDS
 
+/**
+ * @brief Addresses the BT RX thread keeps a name and repeat filter for
+ *
+ * MAX_KEYBOARDS plus as many pending, rounded up to a power of two.
+ */
+#if ZMK_STATUS_SCANNER_MAX_KEYBOARDS * 2 <= 4
+#define ZMK_STATUS_SCANNER_DEVICE_CACHE_SIZE 4
+#elif ZMK_STATUS_SCANNER_MAX_KEYBOARDS * 2 <= 8
+#define ZMK_STATUS_SCANNER_DEVICE_CACHE_SIZE 8
+#elif ZMK_STATUS_SCANNER_MAX_KEYBOARDS * 2 <= 16
+#define ZMK_STATUS_SCANNER_DEVICE_CACHE_SIZE 16
+#else
+#define ZMK_STATUS_SCANNER_DEVICE_CACHE_SIZE 32
+#endif
+
 /**
  * @brief Keyboard status information
+ *
+ * Ordered by alignment so the slot has no padding before ext; the name
+ * is a handle into the interned name table (zmk/keyboard_names.h), on
+ * which the slot holds a reference.
  */
 struct zmk_keyboard_status {
-    bool active;                           // Whether this slot is active
     uint32_t last_seen;                    // Timestamp of last advertisement
+    uint32_t seq_changes;                  // Content changes seen via sequence numbers
+    uint32_t seq_missed;                   // Of those, changes never received (seq gaps)
     struct zmk_status_adv_data data;       // Latest status data
-    int8_t rssi;                          // Signal strength
-    char ble_name[32];                     // BLE device name from advertisement
     uint8_t ble_addr[6];                   // BLE MAC address for unique identification
     uint8_t ble_addr_type;                 // BLE address type (public/random)
+    int8_t rssi;                           // Signal strength
+    zmk_keyboard_name_t name;              // BLE device name, ZMK_KEYBOARD_NAME_NONE if none
+    bool active;                           // Whether this slot is active
+    uint8_t last_seq;                      // Last sequence number (ext.has_seq keyboards)
+    struct zmk_status_adv_ext_fields ext;  // Extras from extended ADV (zeroed for legacy keyboards)
+    struct zmk_status_adv_static_info static_info;  // Layer table from the static packet
+#ifdef CONFIG_PROSPECTOR_LINK_STATS
+    struct prospector_link_stats link;     // Rate, jitter, gaps, RSSI and loss of this link
+#endif
 };
 
 /**
@@ -76,6 +111,26 @@ int zmk_status_scanner_start(void);
  */
 int zmk_status_scanner_stop(void);
 
+/**
+ * @brief Scan duty levels (CONFIG_PROSPECTOR_SCANNER_ADAPTIVE_DUTY)
+ */
+enum zmk_status_scanner_duty {
+    ZMK_STATUS_SCANNER_DUTY_FULL = 0,  // 30ms window every 30ms (100%)
+    ZMK_STATUS_SCANNER_DUTY_REDUCED,   // 30ms window every 120ms (25%)
+    ZMK_STATUS_SCANNER_DUTY_LOW,       // 30ms window every 300ms (10%)
+};
+
+/**
+ * @brief Change the scan window/interval, restarting the scan if running
+ *
+ * Call from the system work queue (same context as the scanner's own
+ * scan restarts).
+ *
+ * @param duty New duty level
+ * @return 0 on success, negative error code on failure
+ */
+int zmk_status_scanner_set_duty(enum zmk_status_scanner_duty duty);
+
 /**
  * @brief Register a callback for scanner events
  * 
@@ -92,6 +147,18 @@ int zmk_status_scanner_register_callback(zmk_status_scanner_callback_t callback)
  */
 struct zmk_keyboard_status *zmk_status_scanner_get_keyboard(int index);
 
+/**
+ * @brief Copy a consistent snapshot of a keyboard's status
+ *
+ * Safe from any thread, unlike the pointer from
+ * zmk_status_scanner_get_keyboard().
+ *
+ * @param index Keyboard index (0 to ZMK_STATUS_SCANNER_MAX_KEYBOARDS-1)
+ * @param out Output: keyboard status
+ * @return true if the keyboard is active
+ */
+bool zmk_status_scanner_copy_keyboard(int index, struct zmk_keyboard_status *out);
+
 /**
  * @brief Get the number of active keyboards
  * 
@@ -106,6 +173,28 @@ int zmk_status_scanner_get_active_count(void);
  */
 int zmk_status_scanner_get_primary_keyboard(void);
 
+#if defined(CONFIG_PROSPECTOR_SCANNER_PIPELINE_BENCH) || \
+    defined(CONFIG_PROSPECTOR_SCANNER_ADV_CAPTURE)
+struct net_buf_simple;
+
+/**
+ * @brief Hand a synthetic or recorded advertisement report to the scan callback
+ *
+ * For the pipeline bench and capture replay: the report takes the same
+ * path as one from the controller. Call from a thread that can stand in
+ * for BT RX.
+ */
+void zmk_status_scanner_inject_report(const bt_addr_le_t *addr, int8_t rssi, uint8_t type,
+                                      struct net_buf_simple *buf);
+#endif
+
+#ifdef CONFIG_PROSPECTOR_PERF_PANEL
+/**
+ * @brief Advertisement reports the scan callback has seen since boot, wrapping
+ */
+uint32_t zmk_status_scanner_report_count(void);
+#endif
+
 #ifdef __cplusplus
 }
 #endif
\ No newline at end of file
@@ -0,0 +1,303 @@
+/*
+ * Copyright (c) 2024 The ZMK Contributors
+ *
+ * SPDX-License-Identifier: MIT
+ *
+ * Advertisement capture ring and replay injector.
+ *
+ *   BT RX thread  → zmk_adv_capture_record() → ring (oldest records dropped)
+ *   Shell         → dump / load / clear / start / stop
+ *   Replay thread → ring → zmk_status_scanner_inject_report() → scan_callback()
+ *
+ * Dump, load and replay only run while recording is off, so they read
+ * the ring without the lock; recording is stopped for them if needed.
+ */
+
+#include <zephyr/kernel.h>
+#include <zephyr/bluetooth/bluetooth.h>
+#include <zephyr/logging/log.h>
+#include <zephyr/net_buf.h>
+#include <zephyr/sys/atomic.h>
+#include <zephyr/sys/util.h>
+#include <zephyr/shell/shell.h>
+#include <string.h>
+#include <stdlib.h>
+
+#include <zmk/adv_capture.h>
+#include <zmk/status_scanner.h>
+
+LOG_MODULE_DECLARE(zmk, CONFIG_ZMK_LOG_LEVEL);
+
+#define RING_SIZE CONFIG_PROSPECTOR_SCANNER_ADV_CAPTURE_SIZE
+#define REC_HDR sizeof(struct zmk_adv_capture_rec)
+#define FAST_BATCH 16  /* Records between 1ms pauses at full speed, so the work queue drains */
+
+enum capture_mode {
+    CAPTURE_OFF = 0,
+    CAPTURE_ALL,
+    CAPTURE_OURS,
+};
+
+/* ========== Ring ========== */
+
+static uint8_t ring[RING_SIZE];
+static uint32_t ring_tail;     /* Offset of the oldest record */
+static uint32_t ring_used;     /* Bytes in the ring */
+static uint32_t ring_records;
+static uint32_t ring_lost;     /* Records dropped for newer ones since the last clear */
+static uint32_t last_ms;
+static struct k_spinlock ring_lock;
+
+static atomic_t mode = ATOMIC_INIT(IS_ENABLED(CONFIG_PROSPECTOR_SCANNER_ADV_CAPTURE_BOOT)
+                                       ? CAPTURE_ALL : CAPTURE_OFF);
+static atomic_t replaying = ATOMIC_INIT(0);
+
+static void ring_put(uint32_t pos, const void *src, uint32_t n) {
+    uint32_t first = MIN(n, RING_SIZE - pos);
+
+    memcpy(&ring[pos], src, first);
+    memcpy(ring, (const uint8_t *)src + first, n - first);
+}
+
+static void ring_get(uint32_t pos, void *dst, uint32_t n) {
+    uint32_t first = MIN(n, RING_SIZE - pos);
+
+    memcpy(dst, &ring[pos], first);
+    memcpy((uint8_t *)dst + first, ring, n - first);
+}
+
+static uint32_t ring_wrap(uint32_t pos) {
+    return pos % RING_SIZE;
+}
+
+/* Caller holds ring_lock or has recording off */
+static void ring_append(const struct zmk_adv_capture_rec *rec, const uint8_t *data) {
+    uint32_t need = REC_HDR + rec->len;
+
+    while (ring_used + need > RING_SIZE) {
+        uint32_t old = REC_HDR + ring[ring_tail];  /* len is the first header byte */
+        ring_tail = ring_wrap(ring_tail + old);
+        ring_used -= old;
+        ring_records--;
+        ring_lost++;
+    }
+    uint32_t head = ring_wrap(ring_tail + ring_used);
+    ring_put(head, rec, REC_HDR);
+    ring_put(ring_wrap(head + REC_HDR), data, rec->len);
+    ring_used += need;
+    ring_records++;
+}
+
+static void ring_clear(void) {
+    K_SPINLOCK(&ring_lock) {
+        ring_tail = 0;
+        ring_used = 0;
+        ring_records = 0;
+        ring_lost = 0;
+    }
+}
+
+void zmk_adv_capture_record(const bt_addr_le_t *addr, int8_t rssi, uint8_t type,
+                            const uint8_t *data, uint16_t len, bool ours) {
+    atomic_val_t m = atomic_get(&mode);
+
+    if (m == CAPTURE_OFF || (m == CAPTURE_OURS && !ours)) {
+        return;
+    }
+
+    struct zmk_adv_capture_rec rec = {
+        .len = (uint8_t)MIN(len, UINT8_MAX),
+        .type = type,
+        .rssi = rssi,
+        .addr_type = addr->type,
+    };
+    memcpy(rec.addr, addr->a.val, sizeof(rec.addr));
+
+    K_SPINLOCK(&ring_lock) {
+        uint32_t now = k_uptime_get_32();
+        rec.dt_ms = ring_records ? (uint16_t)MIN(now - last_ms, UINT16_MAX) : 0;
+        last_ms = now;
+        ring_append(&rec, data);
+    }
+}
+
+/* ========== Replay ========== */
+
+static uint8_t replay_speed;
+static K_SEM_DEFINE(replay_sem, 0, 1);
+
+static void replay_run(uint8_t speed) {
+    uint32_t pos = ring_tail;
+    uint32_t count = ring_records;
+    uint32_t start = k_uptime_get_32();
+    uint64_t timeline_ms = 0;
+
+    LOG_INF("📼 Replaying %u records at %s", count, speed ? "recorded pace" : "full speed");
+    for (uint32_t n = 0; n < count; n++) {
+        struct zmk_adv_capture_rec rec;
+        uint8_t data[UINT8_MAX];
+
+        ring_get(pos, &rec, REC_HDR);
+        ring_get(ring_wrap(pos + REC_HDR), data, rec.len);
+        pos = ring_wrap(pos + REC_HDR + rec.len);
+
+        if (speed) {
+            /* Against the start, so sleeps don't add up their overshoot */
+            timeline_ms += n > 0 ? rec.dt_ms : 0;
+            int32_t wait = (int32_t)(timeline_ms / speed) - (int32_t)(k_uptime_get_32() - start);
+            if (wait > 0) {
+                k_msleep(wait);
+            }
+        } else if (n % FAST_BATCH == FAST_BATCH - 1) {
+            k_msleep(1);
+        }
+
+        bt_addr_le_t addr = {.type = rec.addr_type};
+        memcpy(addr.a.val, rec.addr, sizeof(addr.a.val));
+        struct net_buf_simple buf;
+        net_buf_simple_init_with_data(&buf, data, rec.len);
+        zmk_status_scanner_inject_report(&addr, rec.rssi, rec.type, &buf);
+    }
+    LOG_INF("📼 Replay done: %u records in %u ms", count, k_uptime_get_32() - start);
+}
+
+static void replay_thread(void *p1, void *p2, void *p3) {
+    ARG_UNUSED(p1);
+    ARG_UNUSED(p2);
+    ARG_UNUSED(p3);
+
+    for (;;) {
+        k_sem_take(&replay_sem, K_FOREVER);
+        replay_run(replay_speed);
+        atomic_set(&replaying, 0);
+    }
+}
+
+/* Stands in for the BT RX thread that normally runs the scan callback */
+K_THREAD_DEFINE(adv_replay_thread, CONFIG_BT_RX_STACK_SIZE, replay_thread, NULL, NULL, NULL,
+                K_PRIO_COOP(CONFIG_BT_RX_PRIO), 0, 0);
+
+/* ========== Shell ========== */
+
+/* Recording off for dump / load / replay; false if a replay holds the ring */
+static bool ring_quiesce(const struct shell *sh) {
+    if (atomic_get(&replaying)) {
+        shell_error(sh, "A replay is running");
+        return false;
+    }
+    if (atomic_set(&mode, CAPTURE_OFF) != CAPTURE_OFF) {
+        shell_print(sh, "Recording stopped");
+    }
+    /* A record being appended right now finishes under the lock */
+    K_SPINLOCK(&ring_lock) {
+    }
+    return true;
+}
+
+static int cmd_start(const struct shell *sh, size_t argc, char **argv) {
+    bool ours = argc > 1 && strcmp(argv[1], "ours") == 0;
+
+    if (atomic_get(&replaying)) {
+        shell_error(sh, "A replay is running");
+        return -EBUSY;
+    }
+    atomic_set(&mode, ours ? CAPTURE_OURS : CAPTURE_ALL);
+    shell_print(sh, "Recording %s reports", ours ? "Prospector and name" : "all");
+    return 0;
+}
+
+static int cmd_stop(const struct shell *sh, size_t argc, char **argv) {
+    ARG_UNUSED(argc);
+    ARG_UNUSED(argv);
+    atomic_set(&mode, CAPTURE_OFF);
+    shell_print(sh, "%u records, %u bytes of %u, %u dropped for newer ones", ring_records,
+                ring_used, RING_SIZE, ring_lost);
+    return 0;
+}
+
+static int cmd_clear(const struct shell *sh, size_t argc, char **argv) {
+    ARG_UNUSED(argc);
+    ARG_UNUSED(argv);
+    if (atomic_get(&replaying)) {
+        shell_error(sh, "A replay is running");
+        return -EBUSY;
+    }
+    ring_clear();
+    return 0;
+}
+
+static int cmd_dump(const struct shell *sh, size_t argc, char **argv) {
+    ARG_UNUSED(argc);
+    ARG_UNUSED(argv);
+    if (!ring_quiesce(sh)) {
+        return -EBUSY;
+    }
+
+    shell_print(sh, "ADVCAP%d %u %u", ZMK_ADV_CAPTURE_VERSION, ring_records, ring_used);
+    uint32_t pos = ring_tail;
+    for (uint32_t n = 0; n < ring_records; n++) {
+        uint8_t rec[REC_HDR + UINT8_MAX];
+        char hex[2 * sizeof(rec) + 1];
+        uint32_t size = REC_HDR + ring[pos];
+
+        ring_get(pos, rec, size);
+        bin2hex(rec, size, hex, sizeof(hex));
+        shell_print(sh, "%s", hex);
+        pos = ring_wrap(pos + size);
+    }
+    return 0;
+}
+
+/* One dump line back into the ring; the "ADVCAP" header line is skipped */
+static int cmd_load(const struct shell *sh, size_t argc, char **argv) {
+    ARG_UNUSED(argc);
+    if (strncmp(argv[1], "ADVCAP", 6) == 0) {
+        return 0;
+    }
+    if (!ring_quiesce(sh)) {
+        return -EBUSY;
+    }
+
+    uint8_t rec[REC_HDR + UINT8_MAX];
+    size_t size = hex2bin(argv[1], strlen(argv[1]), rec, sizeof(rec));
+    if (size < REC_HDR || size != REC_HDR + rec[0]) {
+        shell_error(sh, "Not a capture record");
+        return -EINVAL;
+    }
+    K_SPINLOCK(&ring_lock) {
+        ring_append((const struct zmk_adv_capture_rec *)rec, &rec[REC_HDR]);
+    }
+    return 0;
+}
+
+static int cmd_replay(const struct shell *sh, size_t argc, char **argv) {
+    uint8_t speed = 1;
+
+    if (argc > 1) {
+        speed = strcmp(argv[1], "fast") == 0 ? 0 : (uint8_t)CLAMP(atoi(argv[1]), 1, 100);
+    }
+    if (!ring_quiesce(sh)) {
+        return -EBUSY;
+    }
+    if (ring_records == 0) {
+        shell_error(sh, "Nothing captured");
+        return -ENOENT;
+    }
+    atomic_set(&replaying, 1);
+    replay_speed = speed;
+    k_sem_give(&replay_sem);
+    shell_print(sh, "Replaying %u records%s", ring_records,
+                speed > 1 ? " faster than recorded" : "");
+    return 0;
+}
+
+SHELL_STATIC_SUBCMD_SET_CREATE(adv_capture_cmds,
+    SHELL_CMD_ARG(start, NULL, "Record reports [all|ours]", cmd_start, 1, 1),
+    SHELL_CMD(stop, NULL, "Stop recording, show ring usage", cmd_stop),
+    SHELL_CMD(clear, NULL, "Empty the ring", cmd_clear),
+    SHELL_CMD(dump, NULL, "Print the ring, one hex record per line", cmd_dump),
+    SHELL_CMD_ARG(load, NULL, "Append one dumped record <hex>", cmd_load, 2, 0),
+    SHELL_CMD_ARG(replay, NULL, "Feed the ring to the scan callback [speedup 1-100|fast]",
+                  cmd_replay, 1, 1),
+    SHELL_SUBCMD_SET_END);
+SHELL_CMD_REGISTER(adv_capture, &adv_capture_cmds, "Advertisement capture and replay", NULL);
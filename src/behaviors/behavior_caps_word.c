@@ -31,9 +31,16 @@ struct caps_word_continue_item {
     uint8_t implicit_modifiers;
 };
 
+/* Keyboard page usage ids 0-255, one bit each */
+#define CAPS_WORD_BITMAP_WORDS (256 / 32)
+
 struct behavior_caps_word_config {
     zmk_mod_flags_t mods;
     uint8_t index;
+    // Built from continue-list at compile time, so most keys are one bit test
+    uint32_t continue_plain[CAPS_WORD_BITMAP_WORDS];  // Listed without modifiers: continue
+    uint32_t continue_modded[CAPS_WORD_BITMAP_WORDS]; // Listed with implicit modifiers only
+    bool continue_other_pages;                        // Has entries outside the keyboard page
     uint8_t continuations_count;
     struct caps_word_continue_item continuations[];
 };
@@ -97,15 +104,29 @@ static const struct device *devs[DT_NUM_INST_STATUS_OKAY(DT_DRV_COMPAT)];
 static bool caps_word_is_caps_includelist(const struct behavior_caps_word_config *config,
                                           uint16_t usage_page, uint8_t usage_id,
                                           uint8_t implicit_modifiers) {
+    if (usage_page == HID_USAGE_KEY) {
+        uint32_t bit = BIT(usage_id & 0x1F);
+        if (config->continue_plain[usage_id >> 5] & bit) {
+            LOG_DBG("Continuing capsword, found included usage: 0x%02X - 0x%02X", usage_page,
+                    usage_id);
+            return true;
+        }
+        if (!(config->continue_modded[usage_id >> 5] & bit)) {
+            return false;
+        }
+    } else if (!config->continue_other_pages) {
+        return false;
+    }
+
+    // Entries that need implicit modifiers, or from other usage pages
+    uint8_t mods = implicit_modifiers | zmk_hid_get_explicit_mods();
     for (int i = 0; i < config->continuations_count; i++) {
         const struct caps_word_continue_item *continuation = &config->continuations[i];
         LOG_DBG("Comparing with 0x%02X - 0x%02X (with implicit mods: 0x%02X)", continuation->page,
                 continuation->id, continuation->implicit_modifiers);
 
         if (continuation->page == usage_page && continuation->id == usage_id &&
-            (continuation->implicit_modifiers &
-             (implicit_modifiers | zmk_hid_get_explicit_mods())) ==
-                continuation->implicit_modifiers) {
+            (continuation->implicit_modifiers & mods) == continuation->implicit_modifiers) {
             LOG_DBG("Continuing capsword, found included usage: 0x%02X - 0x%02X", usage_page,
                     usage_id);
             return true;
@@ -180,11 +201,36 @@ static int behavior_caps_word_init(const struct device *dev) {
 
 #define BREAK_ITEM(i, n) PARSE_BREAK(DT_INST_PROP_BY_IDX(n, continue_list, i))
 
+#define CONTINUE_USAGE(n, i) DT_INST_PROP_BY_IDX(n, continue_list, i)
+#define CONTINUE_IS_KEY(u) (ZMK_HID_USAGE_PAGE(u) == HID_USAGE_KEY && ZMK_HID_USAGE_ID(u) <= 0xFF)
+#define CONTINUE_BIT(u, w)                                                                         \
+    ((ZMK_HID_USAGE_ID(u) >> 5) == (w) ? BIT(ZMK_HID_USAGE_ID(u) & 0x1F) : 0)
+
+#define PLAIN_BIT(i, n, w)                                                                         \
+    | (CONTINUE_IS_KEY(CONTINUE_USAGE(n, i)) && SELECT_MODS(CONTINUE_USAGE(n, i)) == 0             \
+           ? CONTINUE_BIT(CONTINUE_USAGE(n, i), w)                                                 \
+           : 0)
+#define MODDED_BIT(i, n, w)                                                                        \
+    | (CONTINUE_IS_KEY(CONTINUE_USAGE(n, i)) && SELECT_MODS(CONTINUE_USAGE(n, i)) != 0             \
+           ? CONTINUE_BIT(CONTINUE_USAGE(n, i), w)                                                 \
+           : 0)
+#define OTHER_PAGE(i, n) || !CONTINUE_IS_KEY(CONTINUE_USAGE(n, i))
+
+#define BITMAP_WORD(bit, n, w) (0 LISTIFY(DT_INST_PROP_LEN(n, continue_list), bit, (), n, w))
+#define BITMAP(bit, n)                                                                             \
+    {BITMAP_WORD(bit, n, 0), BITMAP_WORD(bit, n, 1), BITMAP_WORD(bit, n, 2),                       \
+     BITMAP_WORD(bit, n, 3), BITMAP_WORD(bit, n, 4), BITMAP_WORD(bit, n, 5),                       \
+     BITMAP_WORD(bit, n, 6), BITMAP_WORD(bit, n, 7)}
+
 #define KP_INST(n)                                                                                 \
     static struct behavior_caps_word_data behavior_caps_word_data_##n = {.active = false};         \
     static struct behavior_caps_word_config behavior_caps_word_config_##n = {                      \
         .index = n,                                                                                \
         .mods = DT_INST_PROP_OR(n, mods, MOD_LSFT),                                                \
+        .continue_plain = BITMAP(PLAIN_BIT, n),                                                    \
+        .continue_modded = BITMAP(MODDED_BIT, n),                                                  \
+        .continue_other_pages =                                                                    \
+            (0 LISTIFY(DT_INST_PROP_LEN(n, continue_list), OTHER_PAGE, (), n)),                    \
         .continuations = {LISTIFY(DT_INST_PROP_LEN(n, continue_list), BREAK_ITEM, (, ), n)},       \
         .continuations_count = DT_INST_PROP_LEN(n, continue_list),                                 \
     };                                                                                             \
@@ -0,0 +1,163 @@
+/*
+ * Copyright (c) 2024 The ZMK Contributors
+ *
+ * SPDX-License-Identifier: MIT
+ *
+ * Interned keyboard names - see keyboard_names.h
+ *
+ * Written from the BT RX thread (device cache), the system work queue
+ * (keyboard slots, GATT link) and the LVGL thread (name label). All
+ * entry state is under one spinlock; the lookups it covers are a few
+ * dozen short compares, and only happen when a name changes.
+ *
+ * Handle: generation << 8 | entry index. Generations start at 1 and
+ * skip 0, so no live handle is ZMK_KEYBOARD_NAME_NONE.
+ */
+
+#include <zephyr/kernel.h>
+#include <zephyr/logging/log.h>
+#include <string.h>
+#include <zmk/status_scanner.h>
+#include <zmk/keyboard_names.h>
+
+LOG_MODULE_REGISTER(keyboard_names, LOG_LEVEL_INF);
+
+/* Holders of at most one name each: device cache entries, keyboard slots,
+ * the GATT link and the main screen's name label */
+#define TABLE_SIZE (ZMK_STATUS_SCANNER_DEVICE_CACHE_SIZE + ZMK_STATUS_SCANNER_MAX_KEYBOARDS + 2)
+
+/* Every reference is held by one of those, so refs never overflow either */
+BUILD_ASSERT(TABLE_SIZE < 256, "Entry index must fit in the handle's low byte");
+
+struct name_entry {
+    uint8_t refs;  /* 0 = free */
+    uint8_t gen;
+    uint8_t len;
+    char str[ZMK_KEYBOARD_NAME_MAX + 1];
+};
+
+static struct name_entry entries[TABLE_SIZE];
+static struct k_spinlock lock;
+
+/* Live entry of a handle, NULL if NONE or stale. Lock held. */
+static struct name_entry *entry_of(zmk_keyboard_name_t name) {
+    uint8_t idx = name & 0xFF;
+    if (name == ZMK_KEYBOARD_NAME_NONE || idx >= TABLE_SIZE) {
+        return NULL;
+    }
+    struct name_entry *e = &entries[idx];
+    return (e->refs > 0 && e->gen == (name >> 8)) ? e : NULL;
+}
+
+static zmk_keyboard_name_t handle_of(const struct name_entry *e) {
+    return (zmk_keyboard_name_t)((e->gen << 8) | (e - entries));
+}
+
+zmk_keyboard_name_t zmk_keyboard_name_intern(const char *name, size_t len) {
+    struct name_entry *free_entry = NULL;
+    zmk_keyboard_name_t handle = ZMK_KEYBOARD_NAME_NONE;
+
+    len = strnlen(name, MIN(len, ZMK_KEYBOARD_NAME_MAX));
+    if (len == 0) {
+        return ZMK_KEYBOARD_NAME_NONE;
+    }
+
+    k_spinlock_key_t key = k_spin_lock(&lock);
+    for (int i = 0; i < TABLE_SIZE; i++) {
+        struct name_entry *e = &entries[i];
+        if (e->refs == 0) {
+            if (!free_entry) {
+                free_entry = e;
+            }
+            continue;
+        }
+        if (e->len == len && memcmp(e->str, name, len) == 0) {
+            e->refs++;
+            handle = handle_of(e);
+            break;
+        }
+    }
+    if (handle == ZMK_KEYBOARD_NAME_NONE && free_entry) {
+        free_entry->gen = (uint8_t)(free_entry->gen + 1) ?: 1;
+        free_entry->refs = 1;
+        free_entry->len = len;
+        memcpy(free_entry->str, name, len);
+        free_entry->str[len] = '\0';
+        handle = handle_of(free_entry);
+    }
+    k_spin_unlock(&lock, key);
+
+    if (handle == ZMK_KEYBOARD_NAME_NONE) {
+        LOG_WRN("Name table full, '%.*s' not kept", (int)len, name);
+    }
+    return handle;
+}
+
+zmk_keyboard_name_t zmk_keyboard_name_hold(zmk_keyboard_name_t name) {
+    k_spinlock_key_t key = k_spin_lock(&lock);
+    struct name_entry *e = entry_of(name);
+    if (e) {
+        e->refs++;
+    } else {
+        name = ZMK_KEYBOARD_NAME_NONE;
+    }
+    k_spin_unlock(&lock, key);
+    return name;
+}
+
+void zmk_keyboard_name_release(zmk_keyboard_name_t name) {
+    k_spinlock_key_t key = k_spin_lock(&lock);
+    struct name_entry *e = entry_of(name);
+    if (e) {
+        e->refs--;
+    }
+    k_spin_unlock(&lock, key);
+}
+
+size_t zmk_keyboard_name_copy(zmk_keyboard_name_t name, char *buf, size_t size) {
+    size_t len = 0;
+
+    if (size == 0) {
+        return 0;
+    }
+    k_spinlock_key_t key = k_spin_lock(&lock);
+    struct name_entry *e = entry_of(name);
+    if (e) {
+        len = MIN(e->len, size - 1);
+        memcpy(buf, e->str, len);
+    }
+    k_spin_unlock(&lock, key);
+    buf[len] = '\0';
+    return len;
+}
+
+const char *zmk_keyboard_name_str(zmk_keyboard_name_t name) {
+    k_spinlock_key_t key = k_spin_lock(&lock);
+    struct name_entry *e = entry_of(name);
+    k_spin_unlock(&lock, key);
+    return e ? e->str : "";
+}
+
+static bool slot_replace(zmk_keyboard_name_t *slot, zmk_keyboard_name_t held) {
+    if (held == ZMK_KEYBOARD_NAME_NONE) {
+        return false;
+    }
+    if (held == *slot) {
+        zmk_keyboard_name_release(held);
+        return false;
+    }
+    zmk_keyboard_name_release(*slot);
+    *slot = held;
+    return true;
+}
+
+bool zmk_keyboard_name_set(zmk_keyboard_name_t *slot, zmk_keyboard_name_t name) {
+    if (name == *slot) {
+        return false;  /* Per-frame case: nothing to look up or count */
+    }
+    return slot_replace(slot, zmk_keyboard_name_hold(name));
+}
+
+bool zmk_keyboard_name_set_str(zmk_keyboard_name_t *slot, const char *name, size_t len) {
+    return slot_replace(slot, zmk_keyboard_name_intern(name, len));
+}
@@ -0,0 +1,233 @@
+/*
+ * Copyright (c) 2024 The ZMK Contributors
+ *
+ * SPDX-License-Identifier: MIT
+ */
+
+#include <zephyr/types.h>
+#include <zephyr/init.h>
+#include <zephyr/kernel.h>
+
+#include <zephyr/bluetooth/bluetooth.h>
+#include <zephyr/bluetooth/conn.h>
+#include <zephyr/bluetooth/hci.h>
+#include <zephyr/sys/byteorder.h>
+
+#include <zephyr/logging/log.h>
+
+LOG_MODULE_DECLARE(zmk, CONFIG_ZMK_LOG_LEVEL);
+
+#include <zmk/ble.h>
+
+#include <zmk/prospector_compat.h>
+#include <zmk/split_link_telemetry.h>
+#if IS_ENABLED(CONFIG_ZMK_STATUS_ADV_EXTENDED)
+#include <zmk/status_advertisement.h>
+#endif
+
+// Same index as ZMK's peripheral slots (and peripheral battery source),
+// kept across disconnects so reconnects add up. Written from the BT RX
+// thread (conn callbacks) and the work queue (RSSI samples).
+static struct bt_conn *link_conns[ZMK_SPLIT_BLE_PERIPHERAL_COUNT];
+static struct psptr_split_link links[ZMK_SPLIT_BLE_PERIPHERAL_COUNT];
+static bool link_ever_connected[ZMK_SPLIT_BLE_PERIPHERAL_COUNT];
+static struct k_spinlock links_lock;
+
+static void link_sample_work_handler(struct k_work *work);
+static K_WORK_DELAYABLE_DEFINE(link_sample_work, link_sample_work_handler);
+
+#define LINK_SAMPLE_MS (CONFIG_PROSPECTOR_SPLIT_LINK_SAMPLE_S * 1000)
+#define LINK_RSSI_SHIFT 2  // RSSI average over about 4 samples
+
+bool psptr_split_link_get(int slot, struct psptr_split_link *out) {
+    if (slot < 0 || slot >= ZMK_SPLIT_BLE_PERIPHERAL_COUNT) {
+        return false;
+    }
+    K_SPINLOCK(&links_lock) {
+        *out = links[slot];
+    }
+    return true;
+}
+
+// The advertised SPLIT_LINK record changed: don't wait for the next update
+static void link_changed(void) {
+#if IS_ENABLED(CONFIG_ZMK_STATUS_ADV_EXTENDED)
+    zmk_status_advertisement_update();
+#endif
+}
+
+// Lock held; NULL finds a free slot
+static int link_slot_for_conn(struct bt_conn *conn) {
+    for (int i = 0; i < ZMK_SPLIT_BLE_PERIPHERAL_COUNT; i++) {
+        if (link_conns[i] == conn) {
+            return i;
+        }
+    }
+    return -EINVAL;
+}
+
+static void link_connected(struct bt_conn *conn, uint8_t err) {
+    struct bt_conn_info info;
+    int slot = -ENOMEM;
+
+    if (err || bt_conn_get_info(conn, &info) < 0 || info.role != BT_CONN_ROLE_CENTRAL) {
+        return;
+    }
+    // The slot ZMK's central gives this peripheral: the first free one, or
+    // the one its address is stored in (already there, so a lookup)
+#if IS_ENABLED(CONFIG_ZMK_SPLIT_BLE_PREF_WEAK_BOND)
+    int addr_slot = -1;
+#else
+    int addr_slot = zmk_ble_put_peripheral_addr(bt_conn_get_dst(conn));
+    if (addr_slot < 0 || addr_slot >= ZMK_SPLIT_BLE_PERIPHERAL_COUNT) {
+        return;
+    }
+#endif
+    K_SPINLOCK(&links_lock) {
+        slot = addr_slot < 0 ? link_slot_for_conn(NULL) : addr_slot;
+        if (slot < 0 || link_conns[slot] != NULL) {
+            slot = -ENOMEM;
+            K_SPINLOCK_BREAK;
+        }
+        link_conns[slot] = bt_conn_ref(conn);
+        links[slot].connected = true;
+        links[slot].connected_at = k_uptime_get_32();
+        links[slot].rssi = PSPTR_SPLIT_LINK_RSSI_UNKNOWN;
+        links[slot].interval = info.le.interval;
+        links[slot].latency = info.le.latency;
+        links[slot].timeout = info.le.timeout;
+        if (link_ever_connected[slot] && links[slot].reconnects < UINT16_MAX) {
+            links[slot].reconnects++;
+        }
+        link_ever_connected[slot] = true;
+    }
+    if (slot < 0) {
+        LOG_DBG("No peripheral slot for split link telemetry");
+        return;
+    }
+    LOG_DBG("Peripheral %d link up (reconnects: %d)", slot, links[slot].reconnects);
+    link_changed();
+}
+
+static void link_disconnected(struct bt_conn *conn, uint8_t reason) {
+    ARG_UNUSED(reason);
+    struct bt_conn *held = NULL;
+
+    K_SPINLOCK(&links_lock) {
+        int slot = link_slot_for_conn(conn);
+        if (slot < 0) {
+            K_SPINLOCK_BREAK;
+        }
+        held = link_conns[slot];
+        link_conns[slot] = NULL;
+        links[slot].connected = false;
+        links[slot].rssi = PSPTR_SPLIT_LINK_RSSI_UNKNOWN;
+    }
+    if (held) {
+        bt_conn_unref(held);
+        link_changed();
+    }
+}
+
+static void link_le_param_updated(struct bt_conn *conn, uint16_t interval, uint16_t latency,
+                                  uint16_t timeout) {
+    LOG_DBG("Updated connection params: Interval: %d, Latency: %d, Timeout: %d", interval,
+            latency, timeout);
+    K_SPINLOCK(&links_lock) {
+        int slot = link_slot_for_conn(conn);
+        if (slot < 0) {
+            K_SPINLOCK_BREAK;
+        }
+        links[slot].interval = interval;
+        links[slot].latency = latency;
+        links[slot].timeout = timeout;
+    }
+}
+
+static int link_read_rssi(struct bt_conn *conn, int8_t *rssi) {
+    struct bt_hci_cp_read_rssi *cp;
+    struct bt_hci_rp_read_rssi *rp;
+    struct net_buf *buf, *rsp = NULL;
+    uint16_t handle;
+
+    int err = bt_hci_get_conn_handle(conn, &handle);
+    if (err) {
+        return err;
+    }
+
+    buf = bt_hci_cmd_create(BT_HCI_OP_READ_RSSI, sizeof(*cp));
+    if (!buf) {
+        return -ENOBUFS;
+    }
+    cp = net_buf_add(buf, sizeof(*cp));
+    cp->handle = sys_cpu_to_le16(handle);
+
+    err = bt_hci_cmd_send_sync(BT_HCI_OP_READ_RSSI, buf, &rsp);
+    if (err) {
+        return err;
+    }
+    rp = (void *)rsp->data;
+    err = rp->status ? -EIO : 0;
+    if (!err) {
+        *rssi = rp->rssi;
+    }
+    net_buf_unref(rsp);
+    return err;
+}
+
+// Low rate: one HCI round trip per connected peripheral per sample
+static void link_sample_work_handler(struct k_work *work) {
+    ARG_UNUSED(work);
+    bool changed = false;
+
+    for (int i = 0; i < ZMK_SPLIT_BLE_PERIPHERAL_COUNT; i++) {
+        struct bt_conn *conn = NULL;
+        int8_t rssi;
+
+        K_SPINLOCK(&links_lock) {
+            if (link_conns[i]) {
+                conn = bt_conn_ref(link_conns[i]);
+            }
+        }
+        if (conn == NULL) {
+            continue;
+        }
+        int err = link_read_rssi(conn, &rssi);
+        bt_conn_unref(conn);
+        if (err || rssi >= 0) {
+            LOG_DBG("Peripheral %d RSSI read failed (%d)", i, err);
+            continue;  // 127: not available
+        }
+
+        K_SPINLOCK(&links_lock) {
+            int8_t avg = links[i].rssi;
+            links[i].rssi = avg == PSPTR_SPLIT_LINK_RSSI_UNKNOWN
+                                ? rssi
+                                : (int8_t)(avg + (rssi - avg) / (1 << LINK_RSSI_SHIFT));
+            changed |= links[i].rssi != avg;
+        }
+        LOG_DBG("Peripheral %d link: %ddBm (avg %d), interval %dx1.25ms, latency %d, "
+                "reconnects %d", i, rssi, links[i].rssi, links[i].interval,
+                links[i].latency, links[i].reconnects);
+    }
+
+    if (changed) {
+        link_changed();
+    }
+    k_work_schedule(&link_sample_work, K_MSEC(LINK_SAMPLE_MS));
+}
+
+static struct bt_conn_cb link_conn_callbacks = {
+    .connected = link_connected,
+    .disconnected = link_disconnected,
+    .le_param_updated = link_le_param_updated,
+};
+
+static int split_link_telemetry_init(PROSPECTOR_SYS_INIT_ARGS) {
+    PROSPECTOR_SYS_INIT_UNUSED;
+    bt_conn_cb_register(&link_conn_callbacks);
+    k_work_schedule(&link_sample_work, K_MSEC(LINK_SAMPLE_MS));
+    return 0;
+}
+
+SYS_INIT(split_link_telemetry_init, APPLICATION, CONFIG_ZMK_BLE_INIT_PRIORITY);
@@ -0,0 +1,257 @@
+/*
+ * Copyright (c) 2024 The ZMK Contributors
+ *
+ * SPDX-License-Identifier: MIT
+ */
+
+#include <zephyr/types.h>
+#include <zephyr/init.h>
+#include <zephyr/kernel.h>
+#include <zephyr/sys/atomic.h>
+#include <string.h>
+
+#include <zephyr/bluetooth/bluetooth.h>
+#include <zephyr/bluetooth/conn.h>
+#include <zephyr/bluetooth/gatt.h>
+#include <zephyr/bluetooth/uuid.h>
+
+#include <zephyr/logging/log.h>
+
+LOG_MODULE_DECLARE(zmk, CONFIG_ZMK_LOG_LEVEL);
+
+#include <zmk/prospector_compat.h>
+#include <zmk/split_status_handoff.h>
+
+static struct bt_uuid_128 handoff_chr_uuid = BT_UUID_INIT_128(PSPTR_STATUS_HANDOFF_CHR_UUID);
+
+#if IS_ENABLED(CONFIG_ZMK_SPLIT_ROLE_CENTRAL)
+// --- Central: find the half's characteristic, then write frames to it ---
+// The first split peripheral that has the characteristic is the target:
+// only the keyboard half is built with this option.
+
+// Written from the BT RX thread (callbacks), read from the work queue
+static struct bt_conn *handoff_conn;
+static uint16_t handoff_handle;
+static struct k_spinlock handoff_lock;
+static struct bt_gatt_discover_params discover_params;
+
+bool psptr_status_handoff_ready(void) {
+    bool ready;
+
+    K_SPINLOCK(&handoff_lock) {
+        ready = handoff_conn != NULL;
+    }
+    return ready;
+}
+
+static uint8_t handoff_discover_cb(struct bt_conn *conn, const struct bt_gatt_attr *attr,
+                                   struct bt_gatt_discover_params *params) {
+    ARG_UNUSED(params);
+    if (!attr) {
+        LOG_INF("📡 Keyboard half has no status handoff characteristic");
+        return BT_GATT_ITER_STOP;
+    }
+
+    const struct bt_gatt_chrc *chrc = attr->user_data;
+    K_SPINLOCK(&handoff_lock) {
+        if (!handoff_conn) {
+            handoff_conn = bt_conn_ref(conn);
+            handoff_handle = chrc->value_handle;
+        }
+    }
+    LOG_INF("📡 Status handoff ready (handle 0x%04x)", chrc->value_handle);
+    return BT_GATT_ITER_STOP;
+}
+
+// Discovery once the link is encrypted: the characteristic needs it for writes
+static void handoff_security_changed(struct bt_conn *conn, bt_security_t level,
+                                     enum bt_security_err err) {
+    struct bt_conn_info info;
+
+    if (err || level < BT_SECURITY_L2 || bt_conn_get_info(conn, &info) < 0 ||
+        info.role != BT_CONN_ROLE_CENTRAL) {
+        return;  // Host connections are peripheral-role
+    }
+    if (psptr_status_handoff_ready()) {
+        return;
+    }
+
+    discover_params.uuid = &handoff_chr_uuid.uuid;
+    discover_params.func = handoff_discover_cb;
+    discover_params.start_handle = BT_ATT_FIRST_ATTRIBUTE_HANDLE;
+    discover_params.end_handle = BT_ATT_LAST_ATTRIBUTE_HANDLE;
+    discover_params.type = BT_GATT_DISCOVER_CHARACTERISTIC;
+    int ret = bt_gatt_discover(conn, &discover_params);
+    if (ret) {
+        LOG_WRN("Status handoff discovery failed: %d", ret);
+    }
+}
+
+static void handoff_disconnected(struct bt_conn *conn, uint8_t reason) {
+    ARG_UNUSED(reason);
+    struct bt_conn *old = NULL;
+
+    K_SPINLOCK(&handoff_lock) {
+        if (handoff_conn == conn) {
+            old = handoff_conn;
+            handoff_conn = NULL;
+            handoff_handle = 0;
+        }
+    }
+    if (old) {
+        bt_conn_unref(old);
+        LOG_INF("📡 Keyboard half gone - status handoff unavailable");
+    }
+}
+
+int psptr_status_handoff_send(const uint8_t *frame, bool carry) {
+    struct psptr_status_handoff_msg msg = {
+        .flags = carry ? PSPTR_STATUS_HANDOFF_FLAG_CARRY : 0,
+    };
+    struct bt_conn *conn = NULL;
+    uint16_t handle = 0;
+
+    if (carry) {
+        memcpy(msg.frame, frame, sizeof(msg.frame));
+    }
+    K_SPINLOCK(&handoff_lock) {
+        if (handoff_conn) {
+            conn = bt_conn_ref(handoff_conn);
+            handle = handoff_handle;
+        }
+    }
+    if (!conn) {
+        return -ENOTCONN;
+    }
+
+    int err = -EMSGSIZE;
+    if (bt_gatt_get_mtu(conn) >= sizeof(msg) + 3) {  // ATT opcode + handle
+        err = bt_gatt_write_without_response(conn, handle, &msg, sizeof(msg), false);
+    }
+    bt_conn_unref(conn);
+    return err;
+}
+
+static struct bt_conn_cb handoff_conn_callbacks = {
+    .disconnected = handoff_disconnected,
+    .security_changed = handoff_security_changed,
+};
+
+#else
+// --- Peripheral: advertise the central's frame while asked to carry it ---
+
+// Last message from the central (BT RX thread), picked up by the work item
+static uint8_t handoff_frame[sizeof(struct zmk_status_adv_data)];
+static bool handoff_carry;
+static struct k_spinlock handoff_lock;
+static atomic_t handoff_adv_running = ATOMIC_INIT(0);
+
+// Work queue copy that the AD points at
+static uint8_t adv_frame[sizeof(struct zmk_status_adv_data)];
+static struct bt_data handoff_ad[] = {
+    BT_DATA_BYTES(BT_DATA_FLAGS, (BT_LE_AD_GENERAL | BT_LE_AD_NO_BREDR)),
+    BT_DATA(BT_DATA_MANUFACTURER_DATA, adv_frame, sizeof(adv_frame)),
+};
+
+// Same shape as the central's own non-connectable status ADV; identity
+// address so the scanner keeps the slot across handoffs
+static const struct bt_le_adv_param handoff_adv_params = {
+    .id = BT_ID_DEFAULT,
+    .options = BT_LE_ADV_OPT_USE_IDENTITY,
+    .interval_min = BT_GAP_ADV_FAST_INT_MIN_2,  // 100ms
+    .interval_max = BT_GAP_ADV_FAST_INT_MAX_2,  // 150ms
+};
+
+static void handoff_adv_work_handler(struct k_work *work) {
+    ARG_UNUSED(work);
+    bool carry;
+    int err;
+
+    K_SPINLOCK(&handoff_lock) {
+        carry = handoff_carry;
+        memcpy(adv_frame, handoff_frame, sizeof(adv_frame));
+    }
+
+    if (!carry) {
+        if (atomic_cas(&handoff_adv_running, 1, 0)) {
+            bt_le_adv_stop();
+            LOG_INF("📡 Status ADV handed back to the central");
+        }
+        return;
+    }
+
+    if (atomic_get(&handoff_adv_running)) {
+        err = bt_le_adv_update_data(handoff_ad, ARRAY_SIZE(handoff_ad), NULL, 0);
+        if (err != -EAGAIN) {
+            if (err) {
+                LOG_DBG("Handoff ADV update error: %d", err);
+            }
+            return;
+        }
+        atomic_set(&handoff_adv_running, 0);  // Stopped under us: start again
+    }
+    err = bt_le_adv_start(&handoff_adv_params, handoff_ad, ARRAY_SIZE(handoff_ad), NULL, 0);
+    if (err == 0) {
+        atomic_set(&handoff_adv_running, 1);
+        LOG_INF("📡 Carrying the status ADV for the central");
+    } else {
+        LOG_WRN("Failed to start handoff ADV: %d", err);
+    }
+}
+
+static K_WORK_DEFINE(handoff_adv_work, handoff_adv_work_handler);
+
+static ssize_t handoff_write(struct bt_conn *conn, const struct bt_gatt_attr *attr,
+                             const void *buf, uint16_t len, uint16_t offset, uint8_t flags) {
+    ARG_UNUSED(conn);
+    ARG_UNUSED(attr);
+    ARG_UNUSED(flags);
+    const struct psptr_status_handoff_msg *msg = buf;
+
+    if (offset != 0 || len != sizeof(*msg)) {
+        return BT_GATT_ERR(BT_ATT_ERR_INVALID_ATTRIBUTE_LEN);
+    }
+    K_SPINLOCK(&handoff_lock) {
+        handoff_carry = (msg->flags & PSPTR_STATUS_HANDOFF_FLAG_CARRY) != 0;
+        if (handoff_carry) {
+            memcpy(handoff_frame, msg->frame, sizeof(handoff_frame));
+        }
+    }
+    k_work_submit(&handoff_adv_work);
+    return len;
+}
+
+static struct bt_uuid_128 handoff_svc_uuid = BT_UUID_INIT_128(PSPTR_STATUS_HANDOFF_SVC_UUID);
+
+BT_GATT_SERVICE_DEFINE(psptr_status_handoff_svc, BT_GATT_PRIMARY_SERVICE(&handoff_svc_uuid),
+                       BT_GATT_CHARACTERISTIC(&handoff_chr_uuid.uuid,
+                                              BT_GATT_CHRC_WRITE_WITHOUT_RESP,
+                                              BT_GATT_PERM_WRITE_ENCRYPT, NULL, handoff_write,
+                                              NULL));
+
+// Central gone: free the ADV set before ZMK restarts its own advertising
+static void handoff_disconnected(struct bt_conn *conn, uint8_t reason) {
+    ARG_UNUSED(conn);
+    ARG_UNUSED(reason);
+
+    K_SPINLOCK(&handoff_lock) {
+        handoff_carry = false;
+    }
+    if (atomic_cas(&handoff_adv_running, 1, 0)) {
+        bt_le_adv_stop();
+        LOG_INF("📡 Central disconnected - stopped handoff ADV");
+    }
+}
+
+static struct bt_conn_cb handoff_conn_callbacks = {
+    .disconnected = handoff_disconnected,
+};
+#endif // CONFIG_ZMK_SPLIT_ROLE_CENTRAL
+
+static int psptr_status_handoff_init(PROSPECTOR_SYS_INIT_ARGS) {
+    PROSPECTOR_SYS_INIT_UNUSED;
+    bt_conn_cb_register(&handoff_conn_callbacks);
+    return 0;
+}
+
+SYS_INIT(psptr_status_handoff_init, APPLICATION, CONFIG_ZMK_BLE_INIT_PRIORITY);
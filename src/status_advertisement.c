@@ -23,6 +23,18 @@
 #include <zmk/endpoints.h>
 #include <zmk/hid.h>
 #include <zmk/status_advertisement.h>
+#include <zmk/prospector_rate.h>
+#include <zmk/prospector_sched.h>
+#include <zmk/status_adv_packed.h>
+#if IS_ENABLED(CONFIG_PROSPECTOR_SPLIT_LINK_TELEMETRY)
+#include <zmk/split_link_telemetry.h>
+#endif
+#if IS_ENABLED(CONFIG_PROSPECTOR_SPLIT_ADV_BALANCE) && IS_ENABLED(CONFIG_ZMK_SPLIT_ROLE_CENTRAL)
+#include <zmk/split_status_handoff.h>
+#endif
+#if IS_ENABLED(CONFIG_ZMK_STATUS_ADV_GATT)
+#include <zmk/status_gatt.h>
+#endif
 #include <zmk/events/modifiers_state_changed.h>
 #include <zmk/events/activity_state_changed.h>
 #include <zmk/activity.h>
@@ -36,23 +48,18 @@
 #include <zmk/behavior.h>
 #endif
 
-// Custom WPM implementation to avoid ZMK WPM compatibility issues
-static uint32_t key_press_count = 0;
-static uint32_t wpm_start_time = 0;
-static uint8_t current_wpm = 0;
-// Circular buffer for rolling window implementation
-#define WPM_HISTORY_SIZE 60  // 60 seconds of history at 1-second resolution
-static uint8_t wpm_key_history[WPM_HISTORY_SIZE] = {0};  // Keys per second
-static uint32_t wpm_history_index = 0;  // Current position in circular buffer
-static uint32_t wpm_last_second = 0;    // Last second we recorded
-static uint8_t wpm_current_second_keys = 0;  // Keys in current second
-
 // WPM calculation configuration - using Kconfig settings
 // Backward compatibility: provide defaults if Kconfig values not defined
 #ifndef CONFIG_ZMK_STATUS_ADV_WPM_WINDOW_SECONDS
 #define CONFIG_ZMK_STATUS_ADV_WPM_WINDOW_SECONDS 30  // 30 seconds default
 #endif
 
+// Custom WPM implementation to avoid ZMK WPM compatibility issues
+static uint32_t key_press_count = 0;
+static uint8_t current_wpm = 0;
+// Keys per second over the configured window (running-sum ring, O(1) per build)
+PROSPECTOR_RATE_WINDOW_DEFINE(wpm_window, CONFIG_ZMK_STATUS_ADV_WPM_WINDOW_SECONDS);
+
 #ifndef CONFIG_ZMK_STATUS_ADV_WPM_DECAY_TIMEOUT_SECONDS
 #define CONFIG_ZMK_STATUS_ADV_WPM_DECAY_TIMEOUT_SECONDS 0  // Auto-calculate default
 #endif
@@ -86,6 +93,10 @@ LOG_MODULE_DECLARE(zmk, CONFIG_ZMK_LOG_LEVEL);
 // - Disconnected: bt_le_adv_update_data() injects into ZMK's SCAN_RSP
 // - Connected: bt_le_adv_start() with non-connectable ADV (no NRPA)
 // - Disconnect callback stops own ADV before ZMK restarts
+// With CONFIG_ZMK_STATUS_ADV_STATUS_SET none of this applies: the status
+// frame runs on its own set next to ZMK's and is never restarted.
+// CONFIG_ZMK_STATUS_ADV_GATT makes that set connectable and also notifies
+// the frame to GATT link scanners (src/status_gatt.c).
 #pragma message "*** PROSPECTOR HYBRID ADVERTISING ***"
 
 #include <zmk/events/battery_state_changed.h>
@@ -106,6 +117,197 @@ static enum zmk_activity_state last_activity_state = ZMK_ACTIVITY_ACTIVE;
 static bool zmk_adv_was_active = false;        // Piggyback mode: ZMK is advertising
 static bool prospector_adv_active = false;     // Our own ADV is running (MODE 2 or proxy)
 static bool prospector_adv_connectable = false; // true = connectable proxy, false = non-connectable MODE 2
+static bool prospector_adv_burst = false;       // Own ADV was started with burst_adv_params
+
+#if IS_ENABLED(CONFIG_ZMK_STATUS_ADV_SCANNER_PRESENCE)
+// Scanner presence: uptime of the last scan request on the extended set
+// (written from the BT RX thread), and whether the set is on slow params
+#define SCANNER_ABSENT_TIMEOUT_MS   (CONFIG_ZMK_STATUS_ADV_SCANNER_ABSENT_TIMEOUT_S * 1000U)
+#define SCANNER_ABSENT_INTERVAL_MS  CONFIG_ZMK_STATUS_ADV_SCANNER_ABSENT_INTERVAL_MS
+static atomic_t last_scan_request_at = ATOMIC_INIT(0);
+static bool scanner_absent = false;
+
+static inline bool scanner_in_range(void) {
+    return (k_uptime_get_32() - (uint32_t)atomic_get(&last_scan_request_at)) <
+           SCANNER_ABSENT_TIMEOUT_MS;
+}
+#endif
+
+// --- Airtime accounting (CONFIG_ZMK_STATUS_ADV_AIRTIME_STATS) ---
+// Time is charged to whichever mode the work handler left the radio in,
+// up to the next handler run (or stop). Airtime is estimated per ADV event
+// from the PDU size on each of the 3 primary channels:
+//   legacy:   preamble 1 + AA 4 + header 2 + AdvA 6 + AD + CRC 3 @ 8us/byte
+//   extended: ADV_EXT_IND (17 bytes @ 1M, x3) + one AUX_ADV_IND with the
+//             TLV payload on the secondary PHY (4us/byte on 2M)
+// Events are derived from time, not counted by the controller: all our
+// param sets use 100-150ms, i.e. ~130ms average with the 0-10ms adv delay.
+enum adv_stats_mode {
+    ADV_STATS_OFF = 0,
+    ADV_STATS_PIGGYBACK,  // ZMK's own events carry our data; airtime is ZMK's
+    ADV_STATS_OWN_NC,
+    ADV_STATS_PROXY,
+    ADV_STATS_BURST,
+    ADV_STATS_EXTENDED,
+    ADV_STATS_STATUS_SET,
+    ADV_STATS_HANDOFF,    // The keyboard half advertises; airtime is the half's
+    ADV_STATS_SILENT,
+    ADV_STATS_MODE_COUNT,
+};
+
+#if IS_ENABLED(CONFIG_ZMK_STATUS_ADV_AIRTIME_STATS)
+#define ADV_STATS_EVENT_INTERVAL_MS  130
+#define ADV_STATS_LEGACY_OVERHEAD    16  // PDU bytes around the AD payload
+#define ADV_STATS_EXT_IND_BYTES      17  // ADV_EXT_IND with ADI + AuxPtr
+#define ADV_STATS_AUX_OVERHEAD       21  // AUX_ADV_IND around the AD payload (2M preamble)
+#define ADV_STATS_LEGACY_AD_LEN      (3 + 2 + sizeof(struct zmk_status_adv_data))  // Flags + manufacturer
+
+struct adv_mode_stats {
+    uint32_t starts;    // bt_le_adv_start / bt_le_ext_adv_start successes
+    uint32_t updates;   // bt_le_adv_update_data / bt_le_ext_adv_set_data calls
+    uint32_t flips;     // Restarts for a connectable <-> non-connectable switch
+    uint32_t time_ms;   // Time spent in this mode
+    uint64_t airtime_us;
+};
+
+static struct adv_mode_stats adv_stats[ADV_STATS_MODE_COUNT];
+static enum adv_stats_mode adv_stats_mode = ADV_STATS_OFF;
+static uint16_t adv_stats_ad_len;  // AD bytes on air in the current mode
+static uint32_t adv_stats_since;
+static uint32_t adv_stats_last_log;
+
+static const char *const adv_stats_names[ADV_STATS_MODE_COUNT] = {
+    "off", "piggyback", "own_nc", "proxy", "burst", "extended", "status_set", "handoff",
+    "silent",
+};
+
+static uint32_t adv_stats_event_us(enum adv_stats_mode mode, uint16_t ad_len) {
+    switch (mode) {
+    case ADV_STATS_PIGGYBACK:
+    case ADV_STATS_OWN_NC:
+    case ADV_STATS_PROXY:
+    case ADV_STATS_BURST:
+    case ADV_STATS_STATUS_SET:
+        return 3 * (ADV_STATS_LEGACY_OVERHEAD + ad_len) * 8;
+    case ADV_STATS_EXTENDED:
+        return 3 * ADV_STATS_EXT_IND_BYTES * 8 +
+               (ADV_STATS_AUX_OVERHEAD + ad_len) *
+                   (IS_ENABLED(CONFIG_ZMK_STATUS_ADV_EXTENDED_2M) ? 4 : 8);
+    default:
+        return 0;
+    }
+}
+
+// Charge the time since the last call to the previous mode, then switch
+static void adv_stats_set_mode(enum adv_stats_mode mode, uint16_t ad_len) {
+    uint32_t now = k_uptime_get_32();
+    uint32_t elapsed = now - adv_stats_since;
+    struct adv_mode_stats *s = &adv_stats[adv_stats_mode];
+
+    s->time_ms += elapsed;
+    s->airtime_us += (uint64_t)elapsed * adv_stats_event_us(adv_stats_mode, adv_stats_ad_len) /
+                     ADV_STATS_EVENT_INTERVAL_MS;
+    adv_stats_mode = mode;
+    adv_stats_ad_len = ad_len;
+    adv_stats_since = now;
+}
+
+typedef void (*adv_stats_print_fn)(void *ctx, const char *line);
+
+// Works on a copy so the shell thread never writes the work queue's state
+static void adv_stats_report(adv_stats_print_fn print, void *ctx) {
+    struct adv_mode_stats snap[ADV_STATS_MODE_COUNT];
+    enum adv_stats_mode mode = adv_stats_mode;
+    uint32_t pending = k_uptime_get_32() - adv_stats_since;
+    char line[112];
+    uint32_t total_ms = 0;
+    uint64_t own_us = 0;
+
+    memcpy(snap, adv_stats, sizeof(snap));
+    snap[mode].time_ms += pending;
+    snap[mode].airtime_us += (uint64_t)pending * adv_stats_event_us(mode, adv_stats_ad_len) /
+                             ADV_STATS_EVENT_INTERVAL_MS;
+    for (int m = 0; m < ADV_STATS_MODE_COUNT; m++) {
+        total_ms += snap[m].time_ms;
+        if (m != ADV_STATS_PIGGYBACK) {
+            own_us += snap[m].airtime_us;
+        }
+    }
+
+    snprintf(line, sizeof(line), "📻 ADV airtime over %us (now: %s)", total_ms / 1000,
+             adv_stats_names[mode]);
+    print(ctx, line);
+    for (int m = 0; m < ADV_STATS_MODE_COUNT; m++) {
+        const struct adv_mode_stats *s = &snap[m];
+        if (s->time_ms == 0 && s->starts == 0 && s->updates == 0) {
+            continue;
+        }
+        uint32_t air_ms = (uint32_t)(s->airtime_us / 1000);
+        snprintf(line, sizeof(line),
+                 "📻 %-9s time=%6us starts=%4u updates=%6u flips=%3u events~%u airtime~%ums",
+                 adv_stats_names[m], s->time_ms / 1000, s->starts, s->updates, s->flips,
+                 s->time_ms / ADV_STATS_EVENT_INTERVAL_MS, air_ms);
+        print(ctx, line);
+    }
+
+    // us * uA / 3.6e6 = nAh
+    uint32_t charge_nah =
+        (uint32_t)(own_us * CONFIG_ZMK_STATUS_ADV_AIRTIME_TX_CURRENT_UA / 3600000ULL);
+    uint32_t duty_ppm = total_ms ? (uint32_t)(own_us * 1000 / total_ms) : 0;
+    snprintf(line, sizeof(line),
+             "📻 own airtime %ums, duty %u.%04u%%, TX charge ~%u.%03uuAh (piggyback excluded)",
+             (uint32_t)(own_us / 1000), duty_ppm / 10000, duty_ppm % 10000,
+             charge_nah / 1000, charge_nah % 1000);
+    print(ctx, line);
+}
+
+static void adv_stats_log_line(void *ctx, const char *line) {
+    ARG_UNUSED(ctx);
+    LOG_INF("%s", line);
+}
+
+static void adv_stats_maybe_log(void) {
+#if CONFIG_ZMK_STATUS_ADV_AIRTIME_LOG_INTERVAL_S > 0
+    uint32_t now = k_uptime_get_32();
+    if (now - adv_stats_last_log >= CONFIG_ZMK_STATUS_ADV_AIRTIME_LOG_INTERVAL_S * 1000U) {
+        adv_stats_last_log = now;
+        adv_stats_report(adv_stats_log_line, NULL);
+    }
+#endif
+}
+
+#if IS_ENABLED(CONFIG_SHELL)
+#include <zephyr/shell/shell.h>
+
+static void adv_stats_shell_line(void *ctx, const char *line) {
+    shell_print((const struct shell *)ctx, "%s", line);
+}
+
+static int cmd_prospector_airtime(const struct shell *sh, size_t argc, char **argv) {
+    ARG_UNUSED(argc);
+    ARG_UNUSED(argv);
+    adv_stats_report(adv_stats_shell_line, (void *)sh);
+    return 0;
+}
+
+SHELL_STATIC_SUBCMD_SET_CREATE(prospector_cmds,
+    SHELL_CMD(airtime, NULL, "Per-mode advertising airtime estimate", cmd_prospector_airtime),
+    SHELL_SUBCMD_SET_END);
+SHELL_CMD_REGISTER(prospector, &prospector_cmds, "Prospector status advertisement", NULL);
+#endif
+
+#define ADV_STAT_INC(mode, field) (adv_stats[(mode)].field++)
+#else
+#define adv_stats_set_mode(mode, ad_len) do { } while (0)
+#define adv_stats_maybe_log() do { } while (0)
+#define ADV_STAT_INC(mode, field) do { } while (0)
+#endif
+
+// Mode the own legacy ADV is running in (only meaningful while prospector_adv_active)
+static inline enum adv_stats_mode own_adv_stats_mode(void) {
+    return prospector_adv_burst ? ADV_STATS_BURST :
+           prospector_adv_connectable ? ADV_STATS_PROXY : ADV_STATS_OWN_NC;
+}
 
 // Adaptive update intervals based on activity - using Kconfig values for flexibility
 #if IS_ENABLED(CONFIG_ZMK_STATUS_ADV_ACTIVITY_BASED)
@@ -120,6 +322,9 @@ static bool prospector_adv_connectable = false; // true = connectable proxy, fal
 #endif
 
 static uint32_t last_activity_time = 0;
+// Latest key press not yet reflected in a payload change (age_ms origin)
+static uint32_t last_key_event_at = 0;
+static bool key_event_unreported = false;
 static bool is_active = false;
 
 // Burst advertisement for high-priority events (layer/modifier changes)
@@ -128,6 +333,41 @@ static bool is_active = false;
 #define BURST_INTERVAL_MS 15    // Interval between burst advertisements
 static atomic_t burst_remaining = ATOMIC_INIT(0);
 
+// Traffic classes of adv_work_handler. Every run rebuilds and pushes the
+// payload, so the classes only decide when the next run happens and
+// whether it carries a static chunk (see prospector_sched.h).
+enum adv_class {
+    ADV_CLASS_URGENT = 0,   // Burst repeats after a layer/profile/modifier change
+    ADV_CLASS_STATUS,       // Periodic status at the activity-based interval
+    ADV_CLASS_STATIC,       // Next static chunk
+    ADV_CLASS_STATIC_HOLD,  // Put the dynamic frame back after a chunk (legacy only)
+    ADV_CLASS_SPLIT,        // Burst/silent window edge while split is partial
+    ADV_CLASS_COUNT,
+};
+static struct prospector_sched_class adv_classes[ADV_CLASS_COUNT];
+
+// Dirty-field tracking for build_manufacturer_payload()
+// Event listeners mark which fields changed; the builder only re-queries
+// the subsystems behind those fields instead of rebuilding all 26 bytes.
+// STATIC covers fields that never change after boot (header, keyboard_id,
+// role, channel) and is only set once at startup.
+#define ADV_DIRTY_STATIC      BIT(0)
+#define ADV_DIRTY_BATTERY     BIT(1)
+#define ADV_DIRTY_PERIPHERAL  BIT(2)
+#define ADV_DIRTY_LAYER       BIT(3)
+#define ADV_DIRTY_PROFILE     BIT(4)
+#define ADV_DIRTY_MODIFIERS   BIT(5)
+#define ADV_DIRTY_DYNAMIC     (ADV_DIRTY_BATTERY | ADV_DIRTY_PERIPHERAL | ADV_DIRTY_LAYER | \
+                               ADV_DIRTY_PROFILE | ADV_DIRTY_MODIFIERS)
+#define ADV_DIRTY_ALL         (ADV_DIRTY_STATIC | ADV_DIRTY_DYNAMIC)
+static atomic_t payload_dirty = ATOMIC_INIT(ADV_DIRTY_ALL);
+
+// true while our own ADV set carries the current prospector_ad payload
+// (false after a name-in-AD swap or a failed update)
+static bool own_ad_in_sync = false;
+
+static void status_adv_halt(void);
+
 // Latest layer state for accurate tracking (unused currently)
 // static uint8_t latest_layer = 0;
 
@@ -140,12 +380,43 @@ ZMK_LISTENER(prospector_peripheral_battery, peripheral_battery_listener);
 ZMK_SUBSCRIPTION(prospector_peripheral_battery, zmk_peripheral_battery_state_changed);
 #endif
 
+// Peripheral index mapping (backward compatible defaults)
+#ifndef CONFIG_ZMK_STATUS_ADV_HALF_PERIPHERAL
+#define CONFIG_ZMK_STATUS_ADV_HALF_PERIPHERAL 0
+#endif
+#ifndef CONFIG_ZMK_STATUS_ADV_AUX1_PERIPHERAL
+#define CONFIG_ZMK_STATUS_ADV_AUX1_PERIPHERAL 1
+#endif
+#ifndef CONFIG_ZMK_STATUS_ADV_AUX2_PERIPHERAL
+#define CONFIG_ZMK_STATUS_ADV_AUX2_PERIPHERAL 2
+#endif
+
+// Coalesced reschedule for event-driven updates.
+// Instead of cancel + schedule(NO_WAIT) per event (which thrashes the system
+// work queue during fast typing), an update is armed COALESCE_MS out and
+// further events landing inside that window ride along with it. Never
+// pushes an already-closer deadline out, so latency stays <= COALESCE_MS.
+#ifndef CONFIG_ZMK_STATUS_ADV_COALESCE_MS
+#define CONFIG_ZMK_STATUS_ADV_COALESCE_MS 0
+#endif
+#define ADV_COALESCE_MS CONFIG_ZMK_STATUS_ADV_COALESCE_MS
+
+static void schedule_adv_update(void) {
+    if (k_work_delayable_is_pending(&adv_work) &&
+        k_work_delayable_remaining_get(&adv_work) <= k_ms_to_ticks_ceil32(ADV_COALESCE_MS)) {
+        return;  // Update already due within the window - merge into it
+    }
+    k_work_reschedule(&adv_work, K_MSEC(ADV_COALESCE_MS));
+}
+
 // Activity-based update system: key presses trigger high-frequency updates
 static int position_state_listener(const zmk_event_t *eh) {
     const struct zmk_position_state_changed *ev = as_zmk_position_state_changed(eh);
     if (ev && ev->state) { // Only on key press (not release)
         uint32_t now = k_uptime_get_32();
         last_activity_time = now;
+        last_key_event_at = now;
+        key_event_unreported = true;
 
         bool was_active = is_active;
         is_active = true;
@@ -157,31 +428,13 @@ static int position_state_listener(const zmk_event_t *eh) {
 
         // Track keys per second for rolling window
         key_press_count++;
-
-        // Update circular buffer when second changes
-        uint32_t current_second = now / 1000;
-        if (current_second != wpm_last_second) {
-            // Move to next second in circular buffer
-            uint32_t seconds_elapsed = current_second - wpm_last_second;
-
-            // Fill in any missed seconds with 0
-            for (uint32_t i = 0; i < seconds_elapsed && i < WPM_HISTORY_SIZE; i++) {
-                wpm_history_index = (wpm_history_index + 1) % WPM_HISTORY_SIZE;
-                wpm_key_history[wpm_history_index] = (i == 0) ? wpm_current_second_keys : 0;
-            }
-
-            wpm_last_second = current_second;
-            wpm_current_second_keys = 0;
-        }
-
-        wpm_current_second_keys++;
+        prospector_rate_window_add(&wpm_window, now / 1000, 1);
 
         LOG_DBG("🔥 Key activity detected - switching to high frequency updates");
 
         // Immediately trigger update if switching from idle to active
         if (!was_active && adv_started) {
-            k_work_cancel_delayable(&adv_work);
-            k_work_schedule(&adv_work, K_NO_WAIT);
+            schedule_adv_update();
         }
     }
     return ZMK_EV_EVENT_BUBBLE;
@@ -193,10 +446,10 @@ ZMK_SUBSCRIPTION(prospector_position_listener, zmk_position_state_changed);
 // Profile change listener for immediate advertisement updates
 static int profile_changed_listener(const zmk_event_t *eh) {
     LOG_DBG("📡 BLE profile changed - triggering burst advertisement");
+    atomic_or(&payload_dirty, ADV_DIRTY_PROFILE);
     if (adv_started) {
         atomic_set(&burst_remaining, BURST_COUNT);
-        k_work_cancel_delayable(&adv_work);
-        k_work_schedule(&adv_work, K_NO_WAIT);
+        schedule_adv_update();
     }
     return ZMK_EV_EVENT_BUBBLE;
 }
@@ -216,10 +469,10 @@ static int layer_changed_listener(const zmk_event_t *eh) {
         LOG_DBG("🔄 Layer %d %s - triggering burst advertisement (%d×%dms)",
                 ev->layer, ev->state ? "activated" : "deactivated",
                 BURST_COUNT, BURST_INTERVAL_MS);
+        atomic_or(&payload_dirty, ADV_DIRTY_LAYER);
         if (adv_started) {
             atomic_set(&burst_remaining, BURST_COUNT);
-            k_work_cancel_delayable(&adv_work);
-            k_work_schedule(&adv_work, K_NO_WAIT);
+            schedule_adv_update();
         }
     }
     return ZMK_EV_EVENT_BUBBLE;
@@ -241,10 +494,10 @@ static int modifiers_changed_listener(const zmk_event_t *eh) {
         // Trigger on both press (state=true) and release (state=false)
         LOG_DBG("🎹 Modifiers %s (0x%02x) - triggering burst advertisement",
                 ev->state ? "pressed" : "released", ev->modifiers);
+        atomic_or(&payload_dirty, ADV_DIRTY_MODIFIERS);
         if (adv_started) {
             atomic_set(&burst_remaining, BURST_COUNT);
-            k_work_cancel_delayable(&adv_work);
-            k_work_schedule(&adv_work, K_NO_WAIT);
+            schedule_adv_update();
         }
     }
     return ZMK_EV_EVENT_BUBBLE;
@@ -253,6 +506,20 @@ static int modifiers_changed_listener(const zmk_event_t *eh) {
 ZMK_LISTENER(prospector_modifiers_listener, modifiers_changed_listener);
 ZMK_SUBSCRIPTION(prospector_modifiers_listener, zmk_modifiers_state_changed);
 
+#if IS_ENABLED(CONFIG_ZMK_BATTERY_REPORTING)
+// Battery listener: only marks the field dirty, the next regular tick sends it
+// (battery changes are slow and not worth a burst)
+static int battery_state_listener(const zmk_event_t *eh) {
+    if (as_zmk_battery_state_changed(eh)) {
+        atomic_or(&payload_dirty, ADV_DIRTY_BATTERY);
+    }
+    return ZMK_EV_EVENT_BUBBLE;
+}
+
+ZMK_LISTENER(prospector_battery_listener, battery_state_listener);
+ZMK_SUBSCRIPTION(prospector_battery_listener, zmk_battery_state_changed);
+#endif
+
 // Activity state listener for sleep/wake handling
 // This ensures proper advertising restart after system sleep
 static int activity_state_listener(const zmk_event_t *eh) {
@@ -273,16 +540,16 @@ static int activity_state_listener(const zmk_event_t *eh) {
     if (new_state == ZMK_ACTIVITY_SLEEP) {
         LOG_INF("💤 Entering sleep - stopping Prospector updates");
         k_work_cancel_delayable(&adv_work);
-        if (prospector_adv_active) {
-            bt_le_adv_stop();
-            prospector_adv_active = false;
-        }
+        status_adv_halt();
         zmk_adv_was_active = false;
+        adv_stats_set_mode(ADV_STATS_OFF, 0);
     }
     // Handle wake from sleep - restart work handler
     else if (new_state == ZMK_ACTIVITY_ACTIVE &&
              last_activity_state == ZMK_ACTIVITY_SLEEP) {
         LOG_INF("⚡ Waking from sleep - restarting Prospector updates");
+        // Events may have been missed while asleep - re-query everything
+        atomic_or(&payload_dirty, ADV_DIRTY_DYNAMIC);
         if (adv_started) {
             k_work_cancel_delayable(&adv_work);
             k_work_schedule(&adv_work, K_MSEC(500));  // Wait for BLE to stabilize
@@ -348,6 +615,14 @@ static uint32_t get_current_update_interval(void) {
                 ble_connected ? "BLE" : "USB", interval, is_active ? "ACTIVE" : "IDLE");
     }
 
+#if IS_ENABLED(CONFIG_ZMK_STATUS_ADV_SCANNER_PRESENCE)
+    // Nobody is listening: refreshing the payload faster than it goes on
+    // air only costs HCI traffic. A returning scanner reschedules us.
+    if (scanner_absent && interval < SCANNER_ABSENT_INTERVAL_MS) {
+        interval = SCANNER_ABSENT_INTERVAL_MS;
+    }
+#endif
+
     return interval;
 }
 
@@ -365,6 +640,31 @@ _Static_assert(sizeof(struct zmk_status_adv_data) == MAX_MANUF_PAYLOAD,
 
 static struct zmk_status_adv_data manufacturer_data; // Use structured data directly
 
+// Change sequence: bumped whenever the payload content changes, sent in
+// v3 packed frames and the extended SEQUENCE record. The age starts at
+// the key press that caused the change when there is a recent one, so
+// scanners see event-to-air latency rather than just build-to-air.
+static uint8_t adv_seq = 0;
+static uint32_t adv_changed_at = 0;
+
+static void note_payload_change(void) {
+    uint32_t now = k_uptime_get_32();
+    adv_seq++;
+    adv_changed_at = now;
+    if (key_event_unreported && (now - last_key_event_at) <= ZMK_STATUS_ADV_PACKED_AGE_MAX) {
+        adv_changed_at = last_key_event_at;
+    }
+    key_event_unreported = false;
+}
+
+static uint16_t payload_age_ms(void) {
+    return (uint16_t)MIN(k_uptime_get_32() - adv_changed_at, UINT16_MAX);
+}
+
+#if IS_ENABLED(CONFIG_ZMK_STATUS_ADV_PACKED)
+static uint8_t packed_frame[sizeof(struct zmk_status_adv_data)];
+#endif
+
 // =====================================================================
 // HYBRID ADVERTISING
 // =====================================================================
@@ -392,30 +692,734 @@ static struct bt_data zmk_ad_restore[] = {
                   BT_UUID_16_ENCODE(BT_UUID_BAS_VAL)),
 };
 
-static struct bt_data piggyback_sd[] = {
-    BT_DATA(BT_DATA_MANUFACTURER_DATA, (uint8_t *)&manufacturer_data, sizeof(manufacturer_data)),
-};
+static struct bt_data piggyback_sd[] = {
+    BT_DATA(BT_DATA_MANUFACTURER_DATA, (uint8_t *)&manufacturer_data, sizeof(manufacturer_data)),
+};
+#endif
+// Older Zephyr (no FORCE_NAME_IN_AD): piggyback uses prospector_ad for AD, NULL for SD.
+// Zephyr auto-appends device name to SD. Scanner gets manufacturer from AD, name from SD.
+
+// --- MODE 2: Own non-connectable ADV data ---
+static struct bt_data prospector_ad[] = {
+    BT_DATA_BYTES(BT_DATA_FLAGS, (BT_LE_AD_GENERAL | BT_LE_AD_NO_BREDR)),
+    BT_DATA(BT_DATA_MANUFACTURER_DATA, (uint8_t *)&manufacturer_data, sizeof(manufacturer_data)),
+};
+
+// --- Static packet: keyboard name + layer table, sent in chunks ---
+// MODE 2 SCAN_RSP doesn't reach scanner (radio busy with BLE connection),
+// so rarely-changing info rides in the AD slot instead. The dynamic frame
+// carries the blob's hash; scanners drop chunks whose hash they already
+// hold, so steady-state chunks are cheap and can be sent rarely. A full
+// pass goes out at boot and whenever the hash changes.
+#define STATIC_PERIOD_ACTIVE_MS 10000   // One chunk every 10s while typing
+#define STATIC_FRAME_HOLD_MS      500   // Put the dynamic frame back on air after this
+static char name_adv_buffer[ZMK_STATUS_ADV_STATIC_NAME_MAX + 1];
+static uint8_t name_adv_len = 0;
+static uint8_t static_blob[ZMK_STATUS_ADV_STATIC_MAX_LEN];
+static uint8_t static_chunk_count = 0;
+static uint8_t static_next_chunk = 0;
+static uint8_t static_pass_remaining = 0;  // Chunks left in the current full pass
+static bool static_on_air = false;         // Last legacy AD update carried a chunk
+static struct zmk_status_adv_static_frame static_frame;
+
+// 8-bit FNV-1a fold; 0 is reserved for "no static packet"
+static uint8_t static_blob_hash(const uint8_t *data, size_t len) {
+    uint32_t h = 2166136261u;
+    for (size_t i = 0; i < len; i++) {
+        h = (h ^ data[i]) * 16777619u;
+    }
+    uint8_t folded = (uint8_t)(h ^ (h >> 8) ^ (h >> 16) ^ (h >> 24));
+    return folded ? folded : 1;
+}
+
+// Rebuild the blob (layer names may be renamed at runtime, e.g. via Studio)
+// and restart a full pass if its hash moved
+static void refresh_static_blob(void) {
+    size_t pos = 0;
+
+    static_blob[pos++] = name_adv_len;
+    memcpy(&static_blob[pos], name_adv_buffer, name_adv_len);
+    pos += name_adv_len;
+
+    uint8_t layer_count = 0;
+#if (IS_ENABLED(CONFIG_ZMK_SPLIT_ROLE_CENTRAL) || !IS_ENABLED(CONFIG_ZMK_SPLIT)) && \
+    defined(ZMK_KEYMAP_LAYERS_LEN)
+    layer_count = MIN(ZMK_KEYMAP_LAYERS_LEN, ZMK_STATUS_ADV_STATIC_MAX_LAYERS);
+#endif
+    static_blob[pos++] = layer_count;
+#if (IS_ENABLED(CONFIG_ZMK_SPLIT_ROLE_CENTRAL) || !IS_ENABLED(CONFIG_ZMK_SPLIT)) && \
+    defined(ZMK_KEYMAP_LAYERS_LEN)
+    for (uint8_t i = 0; i < layer_count; i++) {
+        const char *layer_name = zmk_keymap_layer_name(i);
+        uint8_t len = layer_name ? MIN(strlen(layer_name), ZMK_STATUS_ADV_EXT_LAYER_NAME_MAX) : 0;
+        static_blob[pos++] = len;
+        if (len > 0) {
+            memcpy(&static_blob[pos], layer_name, len);
+            pos += len;
+        }
+    }
+#endif
+
+    uint8_t hash = static_blob_hash(static_blob, pos);
+    static_chunk_count = (pos + ZMK_STATUS_ADV_STATIC_CHUNK_LEN - 1) / ZMK_STATUS_ADV_STATIC_CHUNK_LEN;
+    memset(&static_blob[pos], 0, sizeof(static_blob) - pos);
+
+    if (hash != manufacturer_data.static_hash) {
+        manufacturer_data.static_hash = hash;
+        note_payload_change();
+        static_next_chunk = 0;
+        static_pass_remaining = static_chunk_count;
+        prospector_sched_arm(&adv_classes[ADV_CLASS_STATIC], k_uptime_get_32(), 0,
+                             STATIC_FRAME_HOLD_MS);
+        LOG_INF("📡 Static packet: %d bytes, %d chunks, hash 0x%02X",
+                (int)pos, static_chunk_count, hash);
+    }
+}
+
+// Spacing between chunks: a full pass alternates chunk / dynamic frame,
+// steady state sends one chunk per idle wake or every 10s while typing
+static uint32_t static_period_ms(void) {
+    if (static_pass_remaining) {
+        return STATIC_FRAME_HOLD_MS;
+    }
+    return is_active ? STATIC_PERIOD_ACTIVE_MS : IDLE_UPDATE_INTERVAL_MS;
+}
+
+// Decide whether this run carries a static chunk; fills static_frame if so.
+// Never two chunks back to back, so the dynamic frame is never starved.
+static bool static_slot_due(uint32_t now) {
+    struct prospector_sched_class *c = &adv_classes[ADV_CLASS_STATIC];
+    if (!prospector_sched_due(c, now)) {
+        return false;
+    }
+    // Retry slot in case this one is blocked or the update fails;
+    // static_chunk_sent() replaces it with the regular spacing
+    prospector_sched_arm(c, now, STATIC_FRAME_HOLD_MS, STATIC_FRAME_HOLD_MS);
+    if (static_on_air || atomic_get(&burst_remaining) > 0) {
+        return false;
+    }
+
+    if (static_next_chunk == 0) {
+        refresh_static_blob();
+    }
+    if (static_chunk_count == 0) {
+        return false;
+    }
+
+    static_frame.manufacturer_id[0] = 0xFF;
+    static_frame.manufacturer_id[1] = 0xFF;
+    static_frame.service_uuid[0] = (ZMK_STATUS_ADV_STATIC_SERVICE_UUID >> 8) & 0xFF;
+    static_frame.service_uuid[1] = ZMK_STATUS_ADV_STATIC_SERVICE_UUID & 0xFF;
+    static_frame.static_hash = manufacturer_data.static_hash;
+    static_frame.chunk = (static_next_chunk << 4) | static_chunk_count;
+    memcpy(static_frame.data, &static_blob[static_next_chunk * ZMK_STATUS_ADV_STATIC_CHUNK_LEN],
+           ZMK_STATUS_ADV_STATIC_CHUNK_LEN);
+    return true;
+}
+
+// Chunk made it on air: move to the next one
+static void static_chunk_sent(void) {
+    LOG_DBG("📡 Static chunk %d/%d sent (hash 0x%02X)",
+            static_next_chunk + 1, static_chunk_count, static_frame.static_hash);
+    static_next_chunk = (static_next_chunk + 1) % static_chunk_count;
+    if (static_pass_remaining) {
+        static_pass_remaining--;
+    }
+    uint32_t period = static_period_ms();
+    prospector_sched_arm(&adv_classes[ADV_CLASS_STATIC], k_uptime_get_32(), period, period / 4);
+}
+
+#if !IS_ENABLED(CONFIG_ZMK_STATUS_ADV_EXTENDED)
+// Point the legacy manufacturer AD entries at either frame (both 26 bytes)
+static void select_legacy_frame(bool send_static) {
+#if IS_ENABLED(CONFIG_ZMK_STATUS_ADV_PACKED)
+    const uint8_t *dynamic_frame = packed_frame;
+    if (!send_static) {
+        zmk_status_adv_pack_v3(&manufacturer_data, adv_seq, payload_age_ms(), packed_frame);
+    }
+#else
+    const uint8_t *dynamic_frame = (const uint8_t *)&manufacturer_data;
+#endif
+    const uint8_t *frame = send_static ? (const uint8_t *)&static_frame : dynamic_frame;
+    prospector_ad[1].data = frame;
+#if defined(BT_LE_ADV_OPT_FORCE_NAME_IN_AD)
+    piggyback_sd[0].data = frame;
+#endif
+}
+#endif
+
+#if IS_ENABLED(CONFIG_ZMK_STATUS_ADV_EXTENDED)
+// --- Extended ADV: dedicated BT5 advertising set with TLV payload ---
+// Runs on its own set next to ZMK's legacy advertising, so none of the
+// piggyback / MODE 2 / proxy arbitration is needed. Name, full layer name
+// and layer count ride in the same PDU, so there is no name-in-AD swap.
+static struct bt_le_ext_adv *ext_adv_set = NULL;
+static bool ext_adv_running = false;
+static uint8_t ext_payload[ZMK_STATUS_ADV_EXT_MAX_LEN];
+static struct bt_data ext_ad[] = {
+    BT_DATA(BT_DATA_MANUFACTURER_DATA, ext_payload, 0), // Length set by build_ext_payload()
+};
+
+// Non-connectable extended ADV on identity address
+// (scanner matches keyboards by address first, so it must stay stable).
+// With scanner presence the set is scannable: extended scannable sets
+// can't carry AD, so the payload moves to the scan response.
+#if IS_ENABLED(CONFIG_ZMK_STATUS_ADV_EXTENDED_2M)
+#define EXT_ADV_PHY_OPTIONS 0
+#else
+#define EXT_ADV_PHY_OPTIONS BT_LE_ADV_OPT_NO_2M
+#endif
+#if IS_ENABLED(CONFIG_ZMK_STATUS_ADV_SCANNER_PRESENCE)
+#define EXT_ADV_SCAN_OPTIONS (BT_LE_ADV_OPT_SCANNABLE | BT_LE_ADV_OPT_NOTIFY_SCAN_REQ)
+#else
+#define EXT_ADV_SCAN_OPTIONS 0
+#endif
+#define EXT_ADV_OPTIONS \
+    (BT_LE_ADV_OPT_EXT_ADV | BT_LE_ADV_OPT_USE_IDENTITY | EXT_ADV_PHY_OPTIONS | EXT_ADV_SCAN_OPTIONS)
+
+static const struct bt_le_adv_param ext_adv_params = {
+    .id = BT_ID_DEFAULT,
+    .options = EXT_ADV_OPTIONS,
+    .interval_min = BT_GAP_ADV_FAST_INT_MIN_2,  // 100ms
+    .interval_max = BT_GAP_ADV_FAST_INT_MAX_2,  // 150ms
+};
+
+#if IS_ENABLED(CONFIG_ZMK_STATUS_ADV_SCANNER_PRESENCE)
+// Same set, slow interval while no scanner is around (units of 0.625ms)
+static const struct bt_le_adv_param ext_adv_absent_params = {
+    .id = BT_ID_DEFAULT,
+    .options = EXT_ADV_OPTIONS,
+    .interval_min = SCANNER_ABSENT_INTERVAL_MS * 8 / 5,
+    .interval_max = SCANNER_ABSENT_INTERVAL_MS * 8 / 5,
+};
+
+// BT RX thread: a scanner asked for our scan response
+static void ext_adv_scanned(struct bt_le_ext_adv *adv, struct bt_le_ext_adv_scanned_info *info) {
+    ARG_UNUSED(adv);
+    ARG_UNUSED(info);
+    atomic_set(&last_scan_request_at, (atomic_val_t)k_uptime_get_32());
+    if (scanner_absent) {
+        // Switch back to fast params now instead of at the next slow wake
+        k_work_reschedule(&adv_work, K_NO_WAIT);
+    }
+}
+
+static const struct bt_le_ext_adv_cb ext_adv_callbacks = {
+    .scanned = ext_adv_scanned,
+};
+#define EXT_ADV_CALLBACKS (&ext_adv_callbacks)
+#else
+#define EXT_ADV_CALLBACKS NULL
+#endif
+
+// Append one TLV record; records that don't fit are dropped
+static size_t ext_put_tlv(size_t pos, uint8_t type, const void *value, size_t len) {
+    if (pos + 2 + len > sizeof(ext_payload)) {
+        return pos;
+    }
+    ext_payload[pos++] = type;
+    ext_payload[pos++] = (uint8_t)len;
+    memcpy(&ext_payload[pos], value, len);
+    return pos + len;
+}
+
+#if IS_ENABLED(CONFIG_PROSPECTOR_SPLIT_LINK_TELEMETRY)
+// Split link TLV value, in the peripheral battery order: half, aux1, aux2
+static const uint8_t split_link_slots[] = {CONFIG_ZMK_STATUS_ADV_HALF_PERIPHERAL,
+                                           CONFIG_ZMK_STATUS_ADV_AUX1_PERIPHERAL,
+                                           CONFIG_ZMK_STATUS_ADV_AUX2_PERIPHERAL};
+static uint8_t split_link_record[2 * ARRAY_SIZE(split_link_slots)];
+static size_t split_link_len = 0;
+
+// Refresh split_link_record from the telemetry; true if it changed.
+// It is sampled every few seconds, so this adds no more than one update each.
+static bool split_link_refresh(void) {
+    uint8_t record[sizeof(split_link_record)];
+    size_t len = 0;
+
+    for (size_t i = 0; i < ARRAY_SIZE(split_link_slots) && i < ZMK_SPLIT_BLE_PERIPHERAL_COUNT;
+         i++) {
+        struct psptr_split_link link = {0};
+        psptr_split_link_get(split_link_slots[i], &link);
+        record[len++] = (uint8_t)(link.connected ? link.rssi : PSPTR_SPLIT_LINK_RSSI_UNKNOWN);
+        record[len++] = (uint8_t)MIN(link.reconnects, UINT8_MAX);
+    }
+    if (len == split_link_len && memcmp(record, split_link_record, len) == 0) {
+        return false;
+    }
+    memcpy(split_link_record, record, len);
+    split_link_len = len;
+    return true;
+}
+#endif
+
+static void build_ext_payload(bool send_static) {
+    size_t pos = 0;
+    ext_payload[pos++] = 0xFF;
+    ext_payload[pos++] = 0xFF;
+    ext_payload[pos++] = (ZMK_STATUS_ADV_EXT_SERVICE_UUID >> 8) & 0xFF;
+    ext_payload[pos++] = ZMK_STATUS_ADV_EXT_SERVICE_UUID & 0xFF;
+    ext_payload[pos++] = ZMK_STATUS_ADV_EXT_FORMAT;
+
+    pos = ext_put_tlv(pos, ZMK_STATUS_ADV_TLV_CORE, &manufacturer_data, sizeof(manufacturer_data));
+    pos = ext_put_tlv(pos, ZMK_STATUS_ADV_TLV_KEYBOARD_NAME, name_adv_buffer, name_adv_len);
+
+#if IS_ENABLED(CONFIG_ZMK_SPLIT_ROLE_CENTRAL) || !IS_ENABLED(CONFIG_ZMK_SPLIT)
+    const char *layer_name = zmk_keymap_layer_name(manufacturer_data.active_layer);
+    if (layer_name && layer_name[0] != '\0') {
+        pos = ext_put_tlv(pos, ZMK_STATUS_ADV_TLV_LAYER_NAME, layer_name,
+                          MIN(strlen(layer_name), ZMK_STATUS_ADV_EXT_LAYER_NAME_MAX));
+    }
+#ifdef ZMK_KEYMAP_LAYERS_LEN
+    uint8_t layer_count = ZMK_KEYMAP_LAYERS_LEN;
+    pos = ext_put_tlv(pos, ZMK_STATUS_ADV_TLV_LAYER_COUNT, &layer_count, 1);
+#endif
+#endif
+
+#if IS_ENABLED(CONFIG_PROSPECTOR_SPLIT_LINK_TELEMETRY)
+    pos = ext_put_tlv(pos, ZMK_STATUS_ADV_TLV_SPLIT_LINK, split_link_record, split_link_len);
+#endif
+
+    uint8_t seq_record[3];
+    uint16_t age_ms = payload_age_ms();
+    seq_record[0] = adv_seq;
+    seq_record[1] = age_ms & 0xFF;
+    seq_record[2] = age_ms >> 8;
+    pos = ext_put_tlv(pos, ZMK_STATUS_ADV_TLV_SEQUENCE, seq_record, sizeof(seq_record));
+
+    if (send_static) {
+        // Same bytes as the legacy static frame, minus manufacturer id/UUID
+        pos = ext_put_tlv(pos, ZMK_STATUS_ADV_TLV_STATIC_CHUNK, &static_frame.static_hash,
+                          sizeof(static_frame) - 4);
+    }
+
+    ext_ad[0].data_len = pos;
+}
+
+#if IS_ENABLED(CONFIG_ZMK_STATUS_ADV_SCANNER_PRESENCE)
+// Move the set between fast and absent params. Params can only change
+// while the set is stopped; ext_adv_update() restarts it right after.
+static void ext_adv_apply_presence(void) {
+    bool absent = !scanner_in_range();
+    if (absent == scanner_absent) {
+        return;
+    }
+
+    if (ext_adv_running) {
+        bt_le_ext_adv_stop(ext_adv_set);
+        ext_adv_running = false;
+    }
+    int err = bt_le_ext_adv_update_param(ext_adv_set,
+                                         absent ? &ext_adv_absent_params : &ext_adv_params);
+    if (err) {
+        LOG_WRN("Failed to update extended ADV params: %d", err);
+        return;  // Retry on the next update
+    }
+    scanner_absent = absent;
+    if (absent) {
+        LOG_INF("🔭 No scanner for %ds - backing off to %dms ADV interval",
+                CONFIG_ZMK_STATUS_ADV_SCANNER_ABSENT_TIMEOUT_S, SCANNER_ABSENT_INTERVAL_MS);
+    } else {
+        LOG_INF("🔭 Scanner in range - fast ADV interval restored");
+    }
+}
+#endif
+
+#if IS_ENABLED(CONFIG_ZMK_STATUS_ADV_PERIODIC)
+// --- Periodic train on the extended set, for scanners that sync to it ---
+// The same TLV payload. Fixed interval: changing it means restarting the
+// train, which drops every synced scanner until its sync times out, so
+// the active update interval is used for the life of the set.
+#if IS_ENABLED(CONFIG_ZMK_STATUS_ADV_ACTIVITY_BASED)
+#define PER_ADV_INTERVAL_MS CONFIG_ZMK_STATUS_ADV_ACTIVE_INTERVAL_MS
+#else
+#define PER_ADV_INTERVAL_MS CONFIG_ZMK_STATUS_ADV_INTERVAL_MS
+#endif
+#define PER_ADV_INTERVAL (PER_ADV_INTERVAL_MS * 4 / 5)  // Units of 1.25ms
+
+static bool per_adv_running = false;
+
+static const struct bt_le_per_adv_param per_adv_params = {
+    .interval_min = PER_ADV_INTERVAL,
+    .interval_max = PER_ADV_INTERVAL,
+    .options = BT_LE_PER_ADV_OPT_NONE,
+};
+
+static void per_adv_update(bool payload_changed) {
+    int err;
+
+    if (payload_changed || !per_adv_running) {
+        err = bt_le_per_adv_set_data(ext_adv_set, ext_ad, ARRAY_SIZE(ext_ad));
+        if (err) {
+            LOG_DBG("Periodic ADV data update error: %d", err);
+            return;
+        }
+    }
+    if (!per_adv_running) {
+        err = bt_le_per_adv_start(ext_adv_set);
+        if (err == 0 || err == -EALREADY) {
+            per_adv_running = true;
+            LOG_INF("📡 Periodic ADV started (%dms interval)", PER_ADV_INTERVAL_MS);
+        } else {
+            LOG_WRN("Failed to start periodic ADV: %d", err);
+        }
+    }
+}
+#endif // CONFIG_ZMK_STATUS_ADV_PERIODIC
+
+static void ext_adv_update(bool payload_changed, bool send_static) {
+    int err;
+
+    if (!ext_adv_set) {
+        err = bt_le_ext_adv_create(&ext_adv_params, EXT_ADV_CALLBACKS, &ext_adv_set);
+        if (err) {
+            LOG_WRN("Failed to create extended ADV set: %d (CONFIG_BT_EXT_ADV_MAX_ADV_SET >= 2?)", err);
+            ext_adv_set = NULL;
+            return;
+        }
+        LOG_INF("📡 Extended ADV set created (%s secondary PHY)",
+                IS_ENABLED(CONFIG_ZMK_STATUS_ADV_EXTENDED_2M) ? "2M" : "1M");
+        payload_changed = true;
+#if IS_ENABLED(CONFIG_ZMK_STATUS_ADV_PERIODIC)
+        err = bt_le_per_adv_set_param(ext_adv_set, &per_adv_params);
+        if (err) {
+            LOG_WRN("Failed to set periodic ADV params: %d", err);
+        }
+#endif
+    }
+
+#if IS_ENABLED(CONFIG_ZMK_STATUS_ADV_SCANNER_PRESENCE)
+    ext_adv_apply_presence();
+#endif
+#if IS_ENABLED(CONFIG_PROSPECTOR_SPLIT_LINK_TELEMETRY)
+    if (split_link_refresh()) {
+        payload_changed = true;
+    }
+#endif
+
+    if (payload_changed || send_static || !ext_adv_running) {
+        build_ext_payload(send_static);
+        ADV_STAT_INC(ADV_STATS_EXTENDED, updates);
+#if IS_ENABLED(CONFIG_ZMK_STATUS_ADV_SCANNER_PRESENCE)
+        err = bt_le_ext_adv_set_data(ext_adv_set, NULL, 0, ext_ad, ARRAY_SIZE(ext_ad));
+#else
+        err = bt_le_ext_adv_set_data(ext_adv_set, ext_ad, ARRAY_SIZE(ext_ad), NULL, 0);
+#endif
+        if (err) {
+            LOG_DBG("Extended ADV data update error: %d", err);
+            return;
+        }
+        if (send_static) {
+            static_chunk_sent();
+        }
+    }
+
+    if (!ext_adv_running) {
+        err = bt_le_ext_adv_start(ext_adv_set, BT_LE_EXT_ADV_START_DEFAULT);
+        if (err == 0 || err == -EALREADY) {
+            ext_adv_running = true;
+            ADV_STAT_INC(ADV_STATS_EXTENDED, starts);
+            LOG_INF("📡 Extended ADV started (%d bytes)", ext_ad[0].data_len);
+        } else {
+            LOG_WRN("Failed to start extended ADV: %d", err);
+        }
+    }
+#if IS_ENABLED(CONFIG_ZMK_STATUS_ADV_PERIODIC)
+    // Static chunks too: a synced scanner may not scan at all
+    per_adv_update(payload_changed || send_static);
+#endif
+}
+
+static void ext_adv_halt(void) {
+#if IS_ENABLED(CONFIG_ZMK_STATUS_ADV_PERIODIC)
+    if (ext_adv_set && per_adv_running) {
+        bt_le_per_adv_stop(ext_adv_set);
+        per_adv_running = false;
+    }
+#endif
+    if (ext_adv_set && ext_adv_running) {
+        bt_le_ext_adv_stop(ext_adv_set);
+        ext_adv_running = false;
+    }
+}
+#endif // CONFIG_ZMK_STATUS_ADV_EXTENDED
+
+#if IS_ENABLED(CONFIG_ZMK_STATUS_ADV_STATUS_SET)
+// --- Status set: persistent non-connectable set carrying the legacy frame ---
+// ZMK keeps its own set for connectable advertising, so a profile
+// connecting or dropping never touches this one: it is started once and
+// then only gets its AD replaced. Identity address, like the extended set,
+// because the scanner matches keyboards by address first.
+static struct bt_le_ext_adv *status_set = NULL;
+static bool status_set_running = false;
+
+static struct bt_le_adv_param status_set_params = {
+    .id = BT_ID_DEFAULT,
+    .options = BT_LE_ADV_OPT_USE_IDENTITY,  // Legacy ADV_NONCONN_IND, AD only
+    .interval_min = BT_GAP_ADV_FAST_INT_MIN_2,  // 100ms
+    .interval_max = BT_GAP_ADV_FAST_INT_MAX_2,  // 150ms
+};
+
+#if IS_ENABLED(CONFIG_ZMK_STATUS_ADV_GATT)
+// Connectable (ADV_IND) so a GATT link scanner can connect: ZMK's own
+// set is not connectable while the active profile is connected. Without
+// a free connection the set runs non-connectable until one frees up.
+//
+// Anything can connect to it, and ZMK's connected() asks every peripheral
+// connection for security, which would let a stranger pair into an open
+// profile. So the set gets an identity of its own (STATUS_SET_ID, kept in
+// settings by the stack) and pairing on connections to it is refused; if
+// that identity can't be had, the set stays non-connectable.
+#define STATUS_SET_ID 1
+static uint8_t status_set_id = BT_ID_DEFAULT;  // .id of both parameter sets once created
+static struct bt_le_adv_param status_set_conn_params = {
+    .id = BT_ID_DEFAULT,
+    .options = BT_LE_ADV_OPT_CONNECTABLE | BT_LE_ADV_OPT_USE_IDENTITY,
+    .interval_min = BT_GAP_ADV_FAST_INT_MIN_2,
+    .interval_max = BT_GAP_ADV_FAST_INT_MAX_2,
+};
+static bool status_set_connectable = true;  // Created connectable
+static atomic_t status_set_conn_taken = ATOMIC_INIT(0);  // Connect ended the set's ADV
+static atomic_t status_set_conn_freed = ATOMIC_INIT(0);  // A disconnect freed one
+
+// BT RX thread: a scanner connected, which ended the set's advertising
+static void status_set_connected(struct bt_le_ext_adv *adv,
+                                 struct bt_le_ext_adv_connected_info *info) {
+    ARG_UNUSED(adv);
+    ARG_UNUSED(info);
+    atomic_set(&status_set_conn_taken, 1);
+    LOG_INF("📡 Scanner connected through the status ADV set");
+    k_work_reschedule(&adv_work, K_NO_WAIT);  // Restart it for everyone else
+}
+
+static const struct bt_le_ext_adv_cb status_set_callbacks = {
+    .connected = status_set_connected,
+};
+
+// Identity restored from settings, or a new one
+static int status_set_identity(void) {
+    bt_addr_le_t addrs[CONFIG_BT_ID_MAX];
+    size_t count = ARRAY_SIZE(addrs);
+
+    bt_id_get(addrs, &count);
+    if (count > STATUS_SET_ID) {
+        return STATUS_SET_ID;
+    }
+    int id = bt_id_create(NULL, NULL);
+    return (id == STATUS_SET_ID) ? id : -ENOMEM;
+}
+
+static enum bt_security_err status_set_pairing_accept(struct bt_conn *conn,
+                                                      const struct bt_conn_pairing_feat *feat) {
+    ARG_UNUSED(conn);
+    ARG_UNUSED(feat);
+    return BT_SECURITY_ERR_PAIR_NOT_ALLOWED;
+}
+
+// Overlaid on connections to the status set in place of ZMK's callbacks
+static const struct bt_conn_auth_cb status_set_auth_cb = {
+    .pairing_accept = status_set_pairing_accept,
+};
+
+static bool status_set_conn(struct bt_conn *conn) {
+    struct bt_conn_info info;
+    return status_set_id != BT_ID_DEFAULT && bt_conn_get_info(conn, &info) == 0 &&
+           info.role == BT_CONN_ROLE_PERIPHERAL && info.id == status_set_id;
+}
+#define STATUS_SET_CALLBACKS (&status_set_callbacks)
+#else
+#define STATUS_SET_PARAMS    (&status_set_params)
+#define STATUS_SET_CALLBACKS NULL
+#endif
+
+// Start the set: connectable while a connection object is free
+// (CONFIG_ZMK_STATUS_ADV_GATT), else as plain ADV_NONCONN_IND
+static int status_set_start(void) {
+#if IS_ENABLED(CONFIG_ZMK_STATUS_ADV_GATT)
+    if (!status_set_connectable && status_set_id != BT_ID_DEFAULT &&
+        atomic_cas(&status_set_conn_freed, 1, 0) &&
+        bt_le_ext_adv_update_param(status_set, &status_set_conn_params) == 0) {
+        status_set_connectable = true;
+    }
+    int err = bt_le_ext_adv_start(status_set, BT_LE_EXT_ADV_START_DEFAULT);
+    if (err == -ENOMEM && status_set_connectable &&
+        bt_le_ext_adv_update_param(status_set, &status_set_params) == 0) {
+        status_set_connectable = false;
+        atomic_clear(&status_set_conn_freed);  // Only disconnects from here on count
+        err = bt_le_ext_adv_start(status_set, BT_LE_EXT_ADV_START_DEFAULT);
+    }
+    return err;
+#else
+    return bt_le_ext_adv_start(status_set, BT_LE_EXT_ADV_START_DEFAULT);
+#endif
+}
+
+static void status_set_update(bool payload_changed, bool send_static) {
+    bool static_was_on_air = static_on_air;
+    int err;
+
+    static_on_air = false;
+    if (!status_set) {
+#if IS_ENABLED(CONFIG_ZMK_STATUS_ADV_GATT)
+        err = status_set_identity();
+        if (err < 0) {
+            LOG_WRN("No identity for the status ADV set (CONFIG_BT_ID_MAX >= 2?) - "
+                    "running it non-connectable");
+            status_set_connectable = false;
+        } else {
+            status_set_id = err;
+        }
+        status_set_params.id = status_set_id;
+        status_set_conn_params.id = status_set_id;
+        err = bt_le_ext_adv_create(status_set_connectable ? &status_set_conn_params
+                                                          : &status_set_params,
+                                   STATUS_SET_CALLBACKS, &status_set);
+#else
+        err = bt_le_ext_adv_create(STATUS_SET_PARAMS, STATUS_SET_CALLBACKS, &status_set);
+#endif
+        if (err) {
+            LOG_WRN("Failed to create status ADV set: %d (CONFIG_BT_EXT_ADV_MAX_ADV_SET >= 2?)",
+                    err);
+            status_set = NULL;
+            return;
+        }
+        LOG_INF("📡 Status ADV set created");
+        own_ad_in_sync = false;
+    }
+
+    // Skip the HCI round-trip while the set already carries the current
+    // frame; a static chunk, and the dynamic frame after it, always go out
+    if (send_static || payload_changed || static_was_on_air || !own_ad_in_sync) {
+        select_legacy_frame(send_static);
+        ADV_STAT_INC(ADV_STATS_STATUS_SET, updates);
+        err = bt_le_ext_adv_set_data(status_set, prospector_ad, ARRAY_SIZE(prospector_ad),
+                                     NULL, 0);
+        if (err) {
+            LOG_DBG("Status ADV data update error: %d", err);
+            own_ad_in_sync = false;
+            return;
+        }
+        own_ad_in_sync = !send_static;
+        if (send_static) {
+            static_on_air = true;
+            static_chunk_sent();
+        }
+    } else {
+        LOG_DBG("📡 Payload unchanged - skipped ADV data update");
+    }
+
+#if IS_ENABLED(CONFIG_ZMK_STATUS_ADV_GATT)
+    if (atomic_cas(&status_set_conn_taken, 1, 0)) {
+        status_set_running = false;
+    } else if (status_set_running && !status_set_connectable &&
+               atomic_get(&status_set_conn_freed)) {
+        // Parameters only change while stopped: restart as connectable
+        bt_le_ext_adv_stop(status_set);
+        status_set_running = false;
+    }
 #endif
-// Older Zephyr (no FORCE_NAME_IN_AD): piggyback uses prospector_ad for AD, NULL for SD.
-// Zephyr auto-appends device name to SD. Scanner gets manufacturer from AD, name from SD.
+    if (!status_set_running) {
+        err = status_set_start();
+        if (err == 0 || err == -EALREADY) {
+            status_set_running = true;
+            ADV_STAT_INC(ADV_STATS_STATUS_SET, starts);
+            LOG_INF("📡 Status ADV set started");
+        } else {
+            LOG_WRN("Failed to start status ADV set: %d", err);
+        }
+    }
+}
 
-// --- MODE 2: Own non-connectable ADV data ---
-static struct bt_data prospector_ad[] = {
-    BT_DATA_BYTES(BT_DATA_FLAGS, (BT_LE_AD_GENERAL | BT_LE_AD_NO_BREDR)),
-    BT_DATA(BT_DATA_MANUFACTURER_DATA, (uint8_t *)&manufacturer_data, sizeof(manufacturer_data)),
-};
+static void status_set_halt(void) {
+    if (status_set && status_set_running) {
+        bt_le_ext_adv_stop(status_set);
+        status_set_running = false;
+    }
+}
+#endif // CONFIG_ZMK_STATUS_ADV_STATUS_SET
+
+// Stop whichever own status ADV is running; ZMK's advertising is left alone
+static void status_adv_halt(void) {
+#if IS_ENABLED(CONFIG_ZMK_STATUS_ADV_EXTENDED)
+    ext_adv_halt();
+#elif IS_ENABLED(CONFIG_ZMK_STATUS_ADV_STATUS_SET)
+    status_set_halt();
+#endif
+    if (prospector_adv_active) {
+        bt_le_adv_stop();
+        prospector_adv_active = false;
+    }
+}
 
-// --- Name-in-AD: Periodic name broadcast ---
-// MODE 2 SCAN_RSP doesn't reach scanner (radio busy with BLE connection).
-// Periodically swap AD data to send device name directly in ADV packet.
-#define NAME_ADV_INTERVAL_ACTIVE  25  // Every 25th cycle (~5s at 200ms)
-#define NAME_ADV_INTERVAL_IDLE     1  // Every cycle when idle (30s interval)
-static uint32_t adv_cycle_counter = 0;
-static char name_adv_buffer[29]; // Max name in 31-byte AD: 31 - 2(flags) = 29
-static struct bt_data name_ad[] = {
-    BT_DATA_BYTES(BT_DATA_FLAGS, (BT_LE_AD_GENERAL | BT_LE_AD_NO_BREDR)),
-    BT_DATA(BT_DATA_NAME_COMPLETE, name_adv_buffer, 0), // Length set dynamically
-};
+#if IS_ENABLED(CONFIG_PROSPECTOR_SPLIT_ADV_BALANCE) && IS_ENABLED(CONFIG_ZMK_SPLIT_ROLE_CENTRAL)
+// --- Battery balance: the keyboard half may carry the status ADV ---
+// Only while the active profile is connected; disconnected, the frame
+// rides on ZMK's own advertising and costs the central nothing extra.
+#define HANDOFF_HYSTERESIS CONFIG_PROSPECTOR_SPLIT_ADV_BALANCE_HYSTERESIS
+static bool handoff_active = false;   // The keyboard half advertises our frame
+static bool handoff_in_sync = false;  // ... and has the current one
+
+static bool handoff_wanted(void) {
+    if (!psptr_status_handoff_ready()) {
+        return false;
+    }
+#if IS_ENABLED(CONFIG_ZMK_BLE)
+    if (!zmk_ble_active_profile_is_connected()) {
+        return false;
+    }
+#endif
+    int central = MIN(zmk_battery_state_of_charge(), 100);
+    int half = peripheral_batteries[CONFIG_ZMK_STATUS_ADV_HALF_PERIPHERAL];
+    if (half == 0) {
+        return false;  // Not reported yet
+    }
+    // Swap only once the other half leads by the hysteresis
+    return handoff_active ? central < half + HANDOFF_HYSTERESIS
+                          : half >= central + HANDOFF_HYSTERESIS;
+}
+
+// Returns true if the keyboard half carries this run's frame
+static bool handoff_update(bool payload_changed, bool send_static) {
+    if (!handoff_wanted()) {
+        if (handoff_active) {
+            int err = psptr_status_handoff_send(NULL, false);
+            if (err && err != -ENOTCONN) {
+                LOG_DBG("Status handoff stop error: %d", err);
+                return false;  // Central advertises meanwhile; retried next run
+            }
+            handoff_active = false;
+            LOG_INF("📡 Status ADV back on the central (battery %d%%)",
+                    zmk_battery_state_of_charge());
+        }
+        return false;
+    }
+
+    bool static_was_on_air = static_on_air;
+    static_on_air = false;
+    if (!handoff_active || !handoff_in_sync || payload_changed || send_static ||
+        static_was_on_air) {
+        select_legacy_frame(send_static);
+        int err = psptr_status_handoff_send(prospector_ad[1].data, true);
+        handoff_in_sync = (err == 0) && !send_static;
+        if (err) {
+            LOG_DBG("Status handoff write error: %d", err);
+            return handoff_active;  // The half keeps its last frame on air
+        }
+        if (send_static) {
+            static_on_air = true;
+            static_chunk_sent();
+        }
+    }
+    if (!handoff_active) {
+        handoff_active = true;
+        own_ad_in_sync = false;
+        LOG_INF("📡 Status ADV handed to the keyboard half (battery %d%% vs %d%%)",
+                peripheral_batteries[CONFIG_ZMK_STATUS_ADV_HALF_PERIPHERAL],
+                zmk_battery_state_of_charge());
+    }
+    return true;
+}
+#endif
 
 // Non-connectable ADV params (MODE 2: when active profile IS connected)
 // SCANNABLE + USE_NAME: scanner can get device name via SCAN_RSP
@@ -480,6 +1484,14 @@ static inline bool prospector_split_fully_connected(void) {
 // --- Connect callback: count split peripherals and refresh adv params ---
 static void prospector_ble_connected(struct bt_conn *conn, uint8_t err) {
     if (err) return;
+#if IS_ENABLED(CONFIG_ZMK_STATUS_ADV_GATT)
+    // Before pairing can start; if that is already too late, drop it
+    if (status_set_conn(conn) && bt_conn_auth_cb_overlay(conn, &status_set_auth_cb) != 0) {
+        LOG_WRN("📡 Can't refuse pairing on the status set link - disconnecting");
+        bt_conn_disconnect(conn, BT_HCI_ERR_AUTH_FAIL);
+        return;
+    }
+#endif
 #if IS_ENABLED(CONFIG_ZMK_SPLIT_ROLE_CENTRAL)
     struct bt_conn_info info;
     if (bt_conn_get_info(conn, &info) < 0) return;
@@ -487,14 +1499,19 @@ static void prospector_ble_connected(struct bt_conn *conn, uint8_t err) {
     atomic_inc(&split_peripheral_count);
     // Re-evaluate adv params now that connectivity changed.
     if (adv_started) {
-        k_work_cancel_delayable(&adv_work);
-        k_work_schedule(&adv_work, K_NO_WAIT);
+        schedule_adv_update();
     }
 #endif
 }
 
 // --- Disconnect callback: stop own ADV before ZMK restarts ---
 static void prospector_ble_disconnected(struct bt_conn *conn, uint8_t reason) {
+#if IS_ENABLED(CONFIG_ZMK_STATUS_ADV_GATT)
+    atomic_set(&status_set_conn_freed, 1);
+    if (adv_started) {
+        schedule_adv_update();
+    }
+#endif
     if (prospector_adv_active) {
         bt_le_adv_stop();
         prospector_adv_active = false;
@@ -511,9 +1528,25 @@ static void prospector_ble_disconnected(struct bt_conn *conn, uint8_t reason) {
 #endif
 }
 
+#if IS_ENABLED(CONFIG_ZMK_STATUS_ADV_GATT)
+// Backstop for the pairing refusal: the link never needs security
+static void prospector_ble_security_changed(struct bt_conn *conn, bt_security_t level,
+                                            enum bt_security_err err) {
+    if (err || level < BT_SECURITY_L2 || !status_set_conn(conn)) {
+        return;
+    }
+    LOG_WRN("📡 Status set link got encrypted - disconnecting and unpairing");
+    bt_conn_disconnect(conn, BT_HCI_ERR_AUTH_FAIL);
+    bt_unpair(status_set_id, bt_conn_get_dst(conn));
+}
+#endif
+
 static struct bt_conn_cb prospector_conn_callbacks = {
     .connected = prospector_ble_connected,
     .disconnected = prospector_ble_disconnected,
+#if IS_ENABLED(CONFIG_ZMK_STATUS_ADV_GATT)
+    .security_changed = prospector_ble_security_changed,
+#endif
 };
 
 #if IS_ENABLED(CONFIG_ZMK_SPLIT_BLE) && IS_ENABLED(CONFIG_ZMK_SPLIT_ROLE_CENTRAL)
@@ -525,64 +1558,40 @@ static int peripheral_battery_listener(const zmk_event_t *eh) {
         if (ev->source < 3) {
             peripheral_batteries[ev->source] = ev->state_of_charge;
         }
+        atomic_or(&payload_dirty, ADV_DIRTY_PERIPHERAL);
         // Trigger immediate status update when peripheral battery changes
         if (adv_started) {
-            k_work_cancel_delayable(&adv_work);
-            k_work_schedule(&adv_work, K_NO_WAIT);
+            schedule_adv_update();
         }
     }
     return ZMK_EV_EVENT_BUBBLE;
 }
 #endif
 
-static void build_manufacturer_payload(void) {
-    // Build 26-byte structured manufacturer data
-    memset(&manufacturer_data, 0, sizeof(manufacturer_data));
+// Returns true if any payload byte differs from the previous build.
+// Never called on split peripherals (adv_work_handler() returns early there).
+static bool build_manufacturer_payload(void) {
+    // Patch the 26-byte structured manufacturer data in place
+    struct zmk_status_adv_data prev = manufacturer_data;
+    atomic_val_t dirty = atomic_clear(&payload_dirty);
 
     // Apply WPM decay based on inactivity
     uint32_t now = k_uptime_get_32();
     uint32_t time_since_activity = now - last_activity_time;
 
-    // Calculate WPM from circular buffer (rolling window)
-    uint32_t current_second = now / 1000;
-
-    // Update circular buffer when second changes (even without key presses)
-    if (current_second != wpm_last_second && wpm_last_second > 0) {
-        uint32_t seconds_elapsed = current_second - wpm_last_second;
-
-        // Fill in any missed seconds with 0
-        for (uint32_t i = 0; i < seconds_elapsed && i < WPM_HISTORY_SIZE; i++) {
-            wpm_history_index = (wpm_history_index + 1) % WPM_HISTORY_SIZE;
-            wpm_key_history[wpm_history_index] = (i == 0) ? wpm_current_second_keys : 0;
-        }
-
-        wpm_last_second = current_second;
-        wpm_current_second_keys = 0;
-    }
-
-    // Initialize last_second if first time
-    if (wpm_last_second == 0) {
-        wpm_last_second = current_second;
-    }
+    // Expire seconds that rolled out of the window (even without key presses)
+    prospector_rate_window_advance(&wpm_window, now / 1000);
 
     // Calculate WPM from last N seconds (configurable window)
-    uint32_t window_keys = 0;
+    uint32_t window_keys = prospector_rate_window_sum(&wpm_window);
     uint32_t window_seconds = CONFIG_ZMK_STATUS_ADV_WPM_WINDOW_SECONDS;
 
-    // Sum keys from the last window_seconds
-    for (uint32_t i = 0; i < window_seconds && i < WPM_HISTORY_SIZE; i++) {
-        uint32_t idx = (wpm_history_index + WPM_HISTORY_SIZE - i) % WPM_HISTORY_SIZE;
-        window_keys += wpm_key_history[idx];
-    }
-
-    // Add current second's keys (not yet in buffer)
-    window_keys += wpm_current_second_keys;
-
     // Calculate WPM: (keys * 60) / (window_seconds * 5)
     // Simplified: (keys * 12) / window_seconds
     // But we use the multiplier for correct scaling
     if (window_seconds > 0 && window_keys > 0) {
         uint32_t new_wpm = (window_keys * 12 * WPM_WINDOW_MULTIPLIER) / window_seconds;
+        if (new_wpm > 255) new_wpm = 255;
 
         // Smooth transition (avoid jumps)
         if (current_wpm == 0 || abs((int)new_wpm - (int)current_wpm) > 50) {
@@ -592,93 +1601,175 @@ static void build_manufacturer_payload(void) {
             current_wpm = (new_wpm * 7 + current_wpm * 3) / 10;
         }
 
-        if (current_wpm > 255) current_wpm = 255;
-
         LOG_DBG("📊 WPM calculated: %d (keys: %d, window: %ds, mult: %dx)",
                 current_wpm, window_keys, window_seconds, WPM_WINDOW_MULTIPLIER);
     }
 
     if (time_since_activity > WPM_DECAY_TIMEOUT_MS) {
         // Reset WPM after timeout
+        if (current_wpm > 0 || prospector_rate_window_sum(&wpm_window) > 0) {
+            LOG_DBG("📊 WPM reset due to %dms inactivity", WPM_DECAY_TIMEOUT_MS);
+        }
         current_wpm = 0;
-        memset(wpm_key_history, 0, sizeof(wpm_key_history));
-        wpm_history_index = 0;
-        wpm_current_second_keys = 0;
-        wpm_last_second = 0;
-        LOG_DBG("📊 WPM reset due to %dms inactivity", WPM_DECAY_TIMEOUT_MS);
+        prospector_rate_window_reset(&wpm_window);
     } else if (time_since_activity > 5000 && current_wpm > 0) {
-        // Apply smooth decay after 5 seconds of inactivity
-        float idle_seconds = (time_since_activity - 5000) / 1000.0f;
-        // Adjust decay rate for configurable window (faster decay for shorter window)
-        float decay_factor = 1.0f - (idle_seconds / (WPM_WINDOW_MS / 1000.0f));
-        if (decay_factor < 0.0f) decay_factor = 0.0f;
-
-        // Apply decay to current WPM
-        uint8_t decayed_wpm = (uint8_t)(current_wpm * decay_factor);
+        // Apply linear decay after 5 seconds of inactivity (integer fixed-point):
+        // factor = 1 - idle / window, faster decay for shorter window
+        uint32_t idle_ms = time_since_activity - 5000;
+        uint8_t decayed_wpm = (idle_ms >= WPM_WINDOW_MS) ? 0 :
+            (uint8_t)((uint32_t)current_wpm * (WPM_WINDOW_MS - idle_ms) / WPM_WINDOW_MS);
         if (decayed_wpm != current_wpm) {
-            LOG_DBG("📊 WPM decay: %d -> %d (idle: %.1fs)",
-                    current_wpm, decayed_wpm, idle_seconds + 5.0f);
+            LOG_DBG("📊 WPM decay: %d -> %d (idle: %dms)",
+                    current_wpm, decayed_wpm, time_since_activity);
             current_wpm = decayed_wpm;
         }
     }
 
-    // Fixed header fields
-    manufacturer_data.manufacturer_id[0] = 0xFF;
-    manufacturer_data.manufacturer_id[1] = 0xFF;
-    manufacturer_data.service_uuid[0] = 0xAB;
-    manufacturer_data.service_uuid[1] = 0xCD;
-    manufacturer_data.version = PROSPECTOR_ENCODE_VERSION();
+    // ---- Static fields (computed once at boot) ----
+    if (dirty & ADV_DIRTY_STATIC) {
+        manufacturer_data.manufacturer_id[0] = 0xFF;
+        manufacturer_data.manufacturer_id[1] = 0xFF;
+        manufacturer_data.service_uuid[0] = 0xAB;
+        manufacturer_data.service_uuid[1] = 0xCD;
+        manufacturer_data.version = PROSPECTOR_ENCODE_VERSION();
 
-    // Central/Standalone battery level
-    uint8_t battery_level = zmk_battery_state_of_charge();
-    if (battery_level > 100) {
-        battery_level = 100;
-    }
-    manufacturer_data.battery_level = battery_level;
+#if IS_ENABLED(CONFIG_ZMK_SPLIT_ROLE_CENTRAL)
+        manufacturer_data.device_role = ZMK_DEVICE_ROLE_CENTRAL;
+#else
+        manufacturer_data.device_role = ZMK_DEVICE_ROLE_STANDALONE;
+#endif
+        // static_hash is owned by refresh_static_blob()
 
-    // Layer information - proper ZMK split-aware approach
-    uint8_t layer = 0;
+        // Keyboard ID (4 bytes) - hardware-unique ID from HWINFO (FICR on nRF52840)
+        // This ensures the same physical device always has the same ID,
+        // even when BLE MAC address changes across profile switches.
+        uint8_t hwid[16];
+        ssize_t hwid_len = hwinfo_get_device_id(hwid, sizeof(hwid));
+        uint32_t id_hash = 0;
 
-    /*
-     * Central or Standalone (Split disabled): keymap API available
-     * Peripheral (Split enabled but not Central): no keymap, layer = 0
-     */
-#if IS_ENABLED(CONFIG_ZMK_SPLIT_ROLE_CENTRAL) || !IS_ENABLED(CONFIG_ZMK_SPLIT)
-    // Central/Standalone: Use keymap API for layer detection
-    // active_layer is uint8_t (0-255), no artificial limit needed
-    layer = zmk_keymap_highest_layer_active();
+        if (hwid_len > 0) {
+            // Hash hardware device ID to 4 bytes
+            for (ssize_t i = 0; i < hwid_len; i++) {
+                id_hash = id_hash * 31 + hwid[i];
+            }
+            LOG_DBG("keyboard_id from HWINFO (%d bytes): %08X", (int)hwid_len, id_hash);
+        } else {
+            // Fallback: hash keyboard name (for boards without HWINFO)
+            const char *keyboard_name = CONFIG_ZMK_STATUS_ADV_KEYBOARD_NAME;
+            if (strlen(keyboard_name) == 0) {
+                keyboard_name = CONFIG_BT_DEVICE_NAME;
+            }
+            for (int i = 0; keyboard_name[i]; i++) {
+                id_hash = id_hash * 31 + keyboard_name[i];
+            }
+            LOG_WRN("HWINFO unavailable, using name-hash for keyboard_id: %08X", id_hash);
+        }
+        memcpy(manufacturer_data.keyboard_id, &id_hash, 4);
+
+        // Channel number (0 = broadcast to all scanners)
+#ifdef CONFIG_PROSPECTOR_CHANNEL
+        manufacturer_data.channel = CONFIG_PROSPECTOR_CHANNEL;
 #else
-    // Peripheral: No keymap available, always layer 0
-    // Layer information comes from Central side via split communication
-    layer = 0;
+        manufacturer_data.channel = 0;  // Default: broadcast to all
 #endif
+    }
 
-    manufacturer_data.active_layer = layer;
+    // ---- Battery (central/standalone + split peripherals) ----
+    if (dirty & (ADV_DIRTY_BATTERY | ADV_DIRTY_PERIPHERAL)) {
+        uint8_t battery_level = zmk_battery_state_of_charge();
+        if (battery_level > 100) {
+            battery_level = 100;
+        }
+        manufacturer_data.battery_level = battery_level;
 
-    // Profile slot (0-4) as selected in ZMK's settings
-    manufacturer_data.profile_slot = PROSPECTOR_ENCODE_PROFILE_SLOT(get_active_profile_slot());
-    LOG_DBG("📡 Active profile slot: %d (raw: 0x%02X)",
-            get_active_profile_slot(), manufacturer_data.profile_slot);
+#if IS_ENABLED(CONFIG_ZMK_SPLIT_ROLE_CENTRAL)
+        // Handle battery placement based on central side configuration
+        // Default to "RIGHT" if not configured (backward compatibility)
+        const char *central_side = "RIGHT";
+#ifdef CONFIG_ZMK_STATUS_ADV_CENTRAL_SIDE
+        central_side = CONFIG_ZMK_STATUS_ADV_CENTRAL_SIDE;
+#endif
 
-    // Connection count approximation - count active BLE connections + USB
-    uint8_t connection_count = 1; // Assume at least one connection (BLE advertising implies connection capability)
-#if IS_ENABLED(CONFIG_ZMK_USB)
-    if (zmk_usb_is_hid_ready()) {
-        connection_count++;
+        // Get peripheral batteries using configurable indices
+        uint8_t half_battery = peripheral_batteries[CONFIG_ZMK_STATUS_ADV_HALF_PERIPHERAL];
+        uint8_t aux1_battery = peripheral_batteries[CONFIG_ZMK_STATUS_ADV_AUX1_PERIPHERAL];
+        uint8_t aux2_battery = peripheral_batteries[CONFIG_ZMK_STATUS_ADV_AUX2_PERIPHERAL];
+
+        /*
+         * Scanner display mapping:
+         *   battery_level         -> LEFT arc on screen
+         *   peripheral_battery[0] -> RIGHT arc on screen
+         *
+         * So we map:
+         *   LEFT physical side battery  -> battery_level
+         *   RIGHT physical side battery -> peripheral_battery[0]
+         */
+        if (strcmp(central_side, "LEFT") == 0) {
+            // Central is on LEFT physical side
+            // battery_level (LEFT arc) = central battery (already in battery_level)
+            // peripheral_battery[0] (RIGHT arc) = peripheral half
+            manufacturer_data.peripheral_battery[0] = half_battery;    // Right physical -> Right arc
+            manufacturer_data.peripheral_battery[1] = aux1_battery;    // Aux1 (e.g., trackball)
+            manufacturer_data.peripheral_battery[2] = aux2_battery;    // Aux2
+        } else {
+            // Central is on RIGHT physical side (default)
+            // battery_level (LEFT arc) = peripheral half (swap needed)
+            // peripheral_battery[0] (RIGHT arc) = central (swap needed)
+            manufacturer_data.battery_level = half_battery;            // Left physical (peripheral) -> Left arc
+            manufacturer_data.peripheral_battery[0] = battery_level;   // Right physical (central) -> Right arc
+            manufacturer_data.peripheral_battery[1] = aux1_battery;    // Aux1 (e.g., trackball)
+            manufacturer_data.peripheral_battery[2] = aux2_battery;    // Aux2
+        }
+#else
+        memset(manufacturer_data.peripheral_battery, 0, 3);
+#endif
+    }
+
+    // ---- Layer index + compact layer name ----
+#if IS_ENABLED(CONFIG_ZMK_SPLIT_ROLE_CENTRAL) || !IS_ENABLED(CONFIG_ZMK_SPLIT)
+    if (dirty & ADV_DIRTY_LAYER) {
+        // Central/Standalone: Use keymap API for layer detection
+        // active_layer is uint8_t (0-255), no artificial limit needed
+        uint8_t layer = zmk_keymap_highest_layer_active();
+        manufacturer_data.active_layer = layer;
+
+        // Compact layer name (4 bytes, NOT null-terminated, full 4 chars usable)
+        // Receiver must use %.4s or memcpy+null, never raw %s
+        memset(manufacturer_data.layer_name, 0, sizeof(manufacturer_data.layer_name));
+        const char *layer_name = zmk_keymap_layer_name(layer);
+        if (layer_name && layer_name[0] != '\0') {
+            size_t len = strlen(layer_name);
+            if (len > sizeof(manufacturer_data.layer_name)) {
+                len = sizeof(manufacturer_data.layer_name);
+            }
+            memcpy(manufacturer_data.layer_name, layer_name, len);
+        } else {
+            snprintf(manufacturer_data.layer_name, sizeof(manufacturer_data.layer_name),
+                     "L%d", layer % 10);
+        }
     }
 #endif
-    manufacturer_data.connection_count = connection_count;
 
-    // Status flags - YADS compatible connection status
+    // ---- Profile slot (0-4) as selected in ZMK's settings ----
+    if (dirty & ADV_DIRTY_PROFILE) {
+        manufacturer_data.profile_slot = PROSPECTOR_ENCODE_PROFILE_SLOT(get_active_profile_slot());
+        LOG_DBG("📡 Active profile slot: %d (raw: 0x%02X)",
+                get_active_profile_slot(), manufacturer_data.profile_slot);
+    }
+
+    // ---- Connection count / status flags ----
+    // Polled every build: USB power/HID and BLE bond state change without
+    // any event we subscribe to, and these getters are plain state reads.
+    uint8_t connection_count = 1; // Assume at least one connection (BLE advertising implies connection capability)
     uint8_t flags = 0;
 
-    // USB status flags
 #if IS_ENABLED(CONFIG_ZMK_USB)
     if (zmk_usb_is_powered()) {
         flags |= ZMK_STATUS_FLAG_USB_CONNECTED;
     }
     if (zmk_usb_is_hid_ready()) {
         flags |= ZMK_STATUS_FLAG_USB_HID_READY;
+        connection_count++;
     }
 #endif
 
@@ -692,132 +1783,17 @@ static void build_manufacturer_payload(void) {
     }
 #endif
 
+    manufacturer_data.connection_count = connection_count;
     manufacturer_data.status_flags = flags;
 
-    // Device role and peripheral batteries
-#if IS_ENABLED(CONFIG_ZMK_SPLIT_ROLE_CENTRAL)
-    manufacturer_data.device_role = ZMK_DEVICE_ROLE_CENTRAL;
-    manufacturer_data.device_index = 0; // Central is always index 0
-
-    // Handle battery placement based on central side configuration
-    // Default to "RIGHT" if not configured (backward compatibility)
-    const char *central_side = "RIGHT";
-#ifdef CONFIG_ZMK_STATUS_ADV_CENTRAL_SIDE
-    central_side = CONFIG_ZMK_STATUS_ADV_CENTRAL_SIDE;
-#endif
-
-    // Peripheral index mapping (backward compatible defaults)
-#ifndef CONFIG_ZMK_STATUS_ADV_HALF_PERIPHERAL
-#define CONFIG_ZMK_STATUS_ADV_HALF_PERIPHERAL 0
-#endif
-#ifndef CONFIG_ZMK_STATUS_ADV_AUX1_PERIPHERAL
-#define CONFIG_ZMK_STATUS_ADV_AUX1_PERIPHERAL 1
-#endif
-#ifndef CONFIG_ZMK_STATUS_ADV_AUX2_PERIPHERAL
-#define CONFIG_ZMK_STATUS_ADV_AUX2_PERIPHERAL 2
-#endif
-
-    // Get peripheral batteries using configurable indices
-    uint8_t half_battery = peripheral_batteries[CONFIG_ZMK_STATUS_ADV_HALF_PERIPHERAL];
-    uint8_t aux1_battery = peripheral_batteries[CONFIG_ZMK_STATUS_ADV_AUX1_PERIPHERAL];
-    uint8_t aux2_battery = peripheral_batteries[CONFIG_ZMK_STATUS_ADV_AUX2_PERIPHERAL];
-
-    /*
-     * Scanner display mapping:
-     *   battery_level         -> LEFT arc on screen
-     *   peripheral_battery[0] -> RIGHT arc on screen
-     *
-     * So we map:
-     *   LEFT physical side battery  -> battery_level
-     *   RIGHT physical side battery -> peripheral_battery[0]
-     */
-    if (strcmp(central_side, "LEFT") == 0) {
-        // Central is on LEFT physical side
-        // battery_level (LEFT arc) = central battery (already in battery_level)
-        // peripheral_battery[0] (RIGHT arc) = peripheral half
-        manufacturer_data.peripheral_battery[0] = half_battery;    // Right physical -> Right arc
-        manufacturer_data.peripheral_battery[1] = aux1_battery;    // Aux1 (e.g., trackball)
-        manufacturer_data.peripheral_battery[2] = aux2_battery;    // Aux2
-        // battery_level already has central battery, no change needed
-    } else {
-        // Central is on RIGHT physical side (default)
-        // battery_level (LEFT arc) = peripheral half (swap needed)
-        // peripheral_battery[0] (RIGHT arc) = central (swap needed)
-        uint8_t central_battery = battery_level;
-        manufacturer_data.battery_level = half_battery;            // Left physical (peripheral) -> Left arc
-        manufacturer_data.peripheral_battery[0] = central_battery; // Right physical (central) -> Right arc
-        manufacturer_data.peripheral_battery[1] = aux1_battery;    // Aux1 (e.g., trackball)
-        manufacturer_data.peripheral_battery[2] = aux2_battery;    // Aux2
-    }
-
-#elif IS_ENABLED(CONFIG_ZMK_SPLIT) && !IS_ENABLED(CONFIG_ZMK_SPLIT_ROLE_CENTRAL)
-    // Peripheral: Skip advertising to preserve split communication
-    return;
-#else
-    manufacturer_data.device_role = ZMK_DEVICE_ROLE_STANDALONE;
-    manufacturer_data.device_index = 0;
-    memset(manufacturer_data.peripheral_battery, 0, 3);
-#endif
-
-    // Compact layer name (4 bytes, NOT null-terminated, full 4 chars usable)
-    // Receiver must use %.4s or memcpy+null, never raw %s
-    memset(manufacturer_data.layer_name, 0, sizeof(manufacturer_data.layer_name));
-#if IS_ENABLED(CONFIG_ZMK_SPLIT_ROLE_CENTRAL) || !IS_ENABLED(CONFIG_ZMK_SPLIT)
-    const char *layer_name = zmk_keymap_layer_name(layer);
-    if (layer_name && layer_name[0] != '\0') {
-        size_t len = strlen(layer_name);
-        if (len > sizeof(manufacturer_data.layer_name)) {
-            len = sizeof(manufacturer_data.layer_name);
-        }
-        memcpy(manufacturer_data.layer_name, layer_name, len);
-    } else {
-        snprintf(manufacturer_data.layer_name, sizeof(manufacturer_data.layer_name),
-                 "L%d", layer % 10);
-    }
-#else
-    // Peripheral: no layer name available
-    snprintf(manufacturer_data.layer_name, sizeof(manufacturer_data.layer_name),
-             "L%d", layer % 10);
-#endif
-
-    // Keyboard ID (4 bytes) - hardware-unique ID from HWINFO (FICR on nRF52840)
-    // This ensures the same physical device always has the same ID,
-    // even when BLE MAC address changes across profile switches.
-    {
-        uint8_t hwid[16];
-        ssize_t hwid_len = hwinfo_get_device_id(hwid, sizeof(hwid));
-        uint32_t id_hash = 0;
-
-        if (hwid_len > 0) {
-            // Hash hardware device ID to 4 bytes
-            for (ssize_t i = 0; i < hwid_len; i++) {
-                id_hash = id_hash * 31 + hwid[i];
-            }
-            LOG_DBG("keyboard_id from HWINFO (%d bytes): %08X", (int)hwid_len, id_hash);
-        } else {
-            // Fallback: hash keyboard name (for boards without HWINFO)
-            const char *keyboard_name = CONFIG_ZMK_STATUS_ADV_KEYBOARD_NAME;
-            if (strlen(keyboard_name) == 0) {
-                keyboard_name = CONFIG_BT_DEVICE_NAME;
-            }
-            for (int i = 0; keyboard_name[i]; i++) {
-                id_hash = id_hash * 31 + keyboard_name[i];
-            }
-            LOG_WRN("HWINFO unavailable, using name-hash for keyboard_id: %08X", id_hash);
-        }
-        memcpy(manufacturer_data.keyboard_id, &id_hash, 4);
-    }
-
-    // Modifier keys status - using exact YADS approach
-    uint8_t modifier_flags = 0;
+    // ---- Modifier keys status - using exact YADS approach ----
+    if (dirty & ADV_DIRTY_MODIFIERS) {
+        uint8_t modifier_flags = 0;
 
-    // Get current keyboard report with null check and memory validation
-    struct zmk_hid_keyboard_report *report = zmk_hid_get_keyboard_report();
-    if (report && report != NULL) {
-        uint8_t mods = report->body.modifiers;
+        struct zmk_hid_keyboard_report *report = zmk_hid_get_keyboard_report();
+        if (report) {
+            uint8_t mods = report->body.modifiers;
 
-        // SAFETY: Validate modifier data is reasonable (not corrupted memory)
-        if (mods <= 0xFF) {  // Valid HID modifier range
             // Map HID modifiers using YADS constants approach
             // Note: MOD_LCTL=0x01, MOD_RCTL=0x10, etc. (standard HID modifier bits)
             if (mods & (0x01 | 0x10)) modifier_flags |= ZMK_MOD_FLAG_LCTL | ZMK_MOD_FLAG_RCTL;  // MOD_LCTL | MOD_RCTL
@@ -825,52 +1801,91 @@ static void build_manufacturer_payload(void) {
             if (mods & (0x04 | 0x40)) modifier_flags |= ZMK_MOD_FLAG_LALT | ZMK_MOD_FLAG_RALT;  // MOD_LALT | MOD_RALT
             if (mods & (0x08 | 0x80)) modifier_flags |= ZMK_MOD_FLAG_LGUI | ZMK_MOD_FLAG_RGUI;  // MOD_LGUI | MOD_RGUI
         }
-        // If mods is corrupted, modifier_flags stays 0 (safe default)
-
-        // CRITICAL: Ensure no test code remains that forces modifier flags
-        // NO TEST CODE SHOULD BE HERE - removed any periodic flag setting
 
+        manufacturer_data.modifier_flags = modifier_flags;
     }
 
-    manufacturer_data.modifier_flags = modifier_flags;
-
-    // WPM (Words Per Minute) data collection - custom implementation
-#if IS_ENABLED(CONFIG_ZMK_SPLIT_ROLE_CENTRAL) || !IS_ENABLED(CONFIG_ZMK_SPLIT)
-    // WPM only available on Central or non-Split devices
+    // WPM (Words Per Minute) - custom implementation, refreshed every build
     manufacturer_data.wpm_value = current_wpm;
     LOG_DBG("⚡ Custom WPM: %d (key presses: %d)", current_wpm, key_press_count);
-#else
-    // Peripheral: no WPM data
-    manufacturer_data.wpm_value = 0;
-#endif
 
-    // Channel number (0 = broadcast to all scanners)
-#ifdef CONFIG_PROSPECTOR_CHANNEL
-    manufacturer_data.channel = CONFIG_PROSPECTOR_CHANNEL;
+    bool changed = memcmp(&prev, &manufacturer_data, sizeof(manufacturer_data)) != 0;
+    if (changed) {
+        note_payload_change();
+    }
+
+#if IS_ENABLED(CONFIG_ZMK_SPLIT_BLE) && IS_ENABLED(CONFIG_ZMK_SPLIT_ROLE_CENTRAL)
+    LOG_DBG("Prospector CENTRAL: Battery %d%%, Peripheral [%d,%d,%d], Layer %d, dirty 0x%02x%s",
+            manufacturer_data.battery_level,
+            peripheral_batteries[0], peripheral_batteries[1], peripheral_batteries[2],
+            manufacturer_data.active_layer, (unsigned int)dirty, changed ? "" : " (unchanged)");
 #else
-    manufacturer_data.channel = 0;  // Default: broadcast to all
+    LOG_DBG("Prospector: Battery %d%%, Layer %d, dirty 0x%02x%s",
+            manufacturer_data.battery_level, manufacturer_data.active_layer,
+            (unsigned int)dirty, changed ? "" : " (unchanged)");
 #endif
 
-    const char *role_str =
-#if IS_ENABLED(CONFIG_ZMK_SPLIT_ROLE_CENTRAL)
-        "CENTRAL";
-#elif IS_ENABLED(CONFIG_ZMK_SPLIT_ROLE_PERIPHERAL)
-        "PERIPHERAL";
-#else
-        "STANDALONE";
+    return changed;
+}
+
+
+// Arm the traffic classes after a run and schedule the next one
+static void adv_schedule_next(uint32_t now) {
+    // Urgent class: a few quick repeats so the scanner catches the change
+    int remaining = atomic_get(&burst_remaining);
+    if (remaining > 0) {
+        atomic_dec(&burst_remaining);
+        LOG_DBG("⚡ Burst advertisement %d/%d", BURST_COUNT - remaining + 1, BURST_COUNT);
+        prospector_sched_arm(&adv_classes[ADV_CLASS_URGENT], now, BURST_INTERVAL_MS, 0);
+    } else {
+        prospector_sched_disarm(&adv_classes[ADV_CLASS_URGENT]);
+    }
+
+    // Status class: this run was the status update. Due in the last eighth
+    // of the adaptive interval, so a nearby static or hold wake can take it.
+    uint32_t interval_ms = get_current_update_interval();
+    prospector_sched_arm(&adv_classes[ADV_CLASS_STATUS], now, interval_ms - interval_ms / 8,
+                         interval_ms / 8);
+
+#if !IS_ENABLED(CONFIG_ZMK_STATUS_ADV_EXTENDED)
+    // A static chunk only needs a few ADV events; don't leave it on air
+    // for a whole idle interval in place of the dynamic frame
+    if (static_on_air) {
+        prospector_sched_arm(&adv_classes[ADV_CLASS_STATIC_HOLD], now, STATIC_FRAME_HOLD_MS, 0);
+    } else {
+        prospector_sched_disarm(&adv_classes[ADV_CLASS_STATIC_HOLD]);
+    }
 #endif
 
-#if IS_ENABLED(CONFIG_ZMK_SPLIT_BLE) && IS_ENABLED(CONFIG_ZMK_SPLIT_ROLE_CENTRAL)
-    LOG_DBG("Prospector %s: Central %d%%, Peripheral [%d,%d,%d], Layer %d",
-            role_str, battery_level,
-            peripheral_batteries[0], peripheral_batteries[1], peripheral_batteries[2],
-            layer);
+    uint32_t wake_ms = prospector_sched_next_wake(adv_classes, ADV_CLASS_COUNT, now);
+
+    // Periodic logging (every 20th update to avoid spam)
+    static int update_counter = 0;
+    update_counter++;
+    if (update_counter % 20 == 0) {
+#if IS_ENABLED(CONFIG_ZMK_STATUS_ADV_PERIODIC)
+        const char *mode_str = !ext_adv_running ? "EXT_WAITING" :
+                               per_adv_running ? "EXT_PERIODIC" : "EXTENDED";
+#elif IS_ENABLED(CONFIG_ZMK_STATUS_ADV_EXTENDED)
+        const char *mode_str = ext_adv_running ? "EXTENDED" : "EXT_WAITING";
+#elif IS_ENABLED(CONFIG_ZMK_STATUS_ADV_STATUS_SET)
+        const char *mode_str = status_set_running ? "STATUS_SET" : "SET_WAITING";
 #else
-    LOG_DBG("Prospector %s: Battery %d%%, Layer %d",
-            role_str, battery_level, layer);
+        const char *mode_str =
+            prospector_adv_active ? (prospector_adv_connectable ? "PROXY_CONN" : "OWN_NC") :
+            zmk_adv_was_active ? "PIGGYBACK" : "WAITING";
 #endif
-}
+#if IS_ENABLED(CONFIG_PROSPECTOR_SPLIT_ADV_BALANCE) && IS_ENABLED(CONFIG_ZMK_SPLIT_ROLE_CENTRAL)
+        if (handoff_active) {
+            mode_str = "HANDOFF";
+        }
+#endif
+        LOG_INF("📊 PROSPECTOR: %dms intervals, next wake %dms (%s) - %s",
+                interval_ms, wake_ms, is_active ? "ACTIVE" : "IDLE", mode_str);
+    }
 
+    k_work_schedule(&adv_work, K_MSEC(wake_ms));
+}
 
 // =====================================================================
 // Work handler - hybrid: piggyback / own ADV (profile-aware)
@@ -891,7 +1906,14 @@ static void adv_work_handler(struct k_work *work) {
     return;
 #endif
 
-    build_manufacturer_payload();
+    uint32_t now = k_uptime_get_32();
+    bool payload_changed = build_manufacturer_payload();
+
+#if IS_ENABLED(CONFIG_ZMK_STATUS_ADV_GATT)
+    // Linked scanners get every build, before any radio arbitration below:
+    // changes at once, and unchanged frames as their keepalive
+    zmk_status_gatt_notify(&manufacturer_data);
+#endif
 
     // ---- Burst/silent cycle gate (split central waiting for peripherals) ----
     //
@@ -904,28 +1926,64 @@ static void adv_work_handler(struct k_work *work) {
         const uint32_t burst_ms = CONFIG_PROSPECTOR_SPLIT_PARTIAL_BURST_MS;
         const uint32_t silent_ms = CONFIG_PROSPECTOR_SPLIT_PARTIAL_SILENT_MS;
         const uint32_t cycle_ms = burst_ms + silent_ms;
-        uint32_t now = k_uptime_get_32();
         uint32_t phase = now % cycle_ms;
         bool in_silent = (phase >= burst_ms);
+        struct prospector_sched_class *split = &adv_classes[ADV_CLASS_SPLIT];
 
         if (in_silent) {
             // Stop own adv if running; release the adv set entirely.
+#if IS_ENABLED(CONFIG_ZMK_STATUS_ADV_EXTENDED)
+            ext_adv_halt();
+#elif IS_ENABLED(CONFIG_ZMK_STATUS_ADV_STATUS_SET)
+            status_set_halt();
+#endif
             if (prospector_adv_active) {
                 bt_le_adv_stop();
                 prospector_adv_active = false;
                 LOG_DBG("📡 SILENT phase: yielded radio for split scan/connect");
             }
             zmk_adv_was_active = false;
-            // Wake at the start of the next BURST window.
-            uint32_t until_burst = cycle_ms - phase;
-            k_work_schedule(&adv_work, K_MSEC(until_burst));
+            adv_stats_set_mode(ADV_STATS_SILENT, 0);
+            // Silence suppresses every other class: wake only at the start
+            // of the next BURST window.
+            prospector_sched_arm(split, now, cycle_ms - phase, 0);
+            k_work_schedule(&adv_work, K_MSEC(prospector_sched_next_wake(split, 1, now)));
             return;
         }
-        // BURST phase: fall through to advertise. Schedule next wake at end
-        // of burst so we don't overshoot into silent.
+        // BURST phase: fall through to advertise, and wake at the end of
+        // the window so we go silent on time (the idle interval would
+        // otherwise let the burst run for 30s).
+        prospector_sched_arm(split, now, burst_ms - phase, 0);
+    } else {
+        prospector_sched_disarm(&adv_classes[ADV_CLASS_SPLIT]);
+    }
+#endif
+
+    bool send_static = static_slot_due(now);
+
+#if IS_ENABLED(CONFIG_PROSPECTOR_SPLIT_ADV_BALANCE) && IS_ENABLED(CONFIG_ZMK_SPLIT_ROLE_CENTRAL)
+    if (handoff_update(payload_changed, send_static)) {
+        // The keyboard half advertises the frame: our own ADV stays off
+        status_adv_halt();
+        zmk_adv_was_active = false;
+        adv_stats_set_mode(ADV_STATS_HANDOFF, 0);
+        adv_stats_maybe_log();
+        adv_schedule_next(now);
+        return;
     }
 #endif
 
+#if IS_ENABLED(CONFIG_ZMK_STATUS_ADV_EXTENDED)
+    // Dedicated extended set: no piggyback / own-ADV arbitration needed.
+    // The static chunk rides as one more TLV next to the core record.
+    ext_adv_update(payload_changed, send_static);
+#elif IS_ENABLED(CONFIG_ZMK_STATUS_ADV_STATUS_SET)
+    // Own persistent set next to ZMK's: no piggyback / MODE 2 / proxy
+    // arbitration and no restart when the active profile's state flips
+    status_set_update(payload_changed, send_static);
+#else
+    bool static_was_on_air = static_on_air;
+    static_on_air = false;
     // Determine if active profile needs connectable advertising
     bool active_connected = false;
 #if IS_ENABLED(CONFIG_ZMK_BLE) && (IS_ENABLED(CONFIG_ZMK_SPLIT_ROLE_CENTRAL) || !IS_ENABLED(CONFIG_ZMK_SPLIT))
@@ -938,6 +1996,7 @@ static void adv_work_handler(struct k_work *work) {
 
         if (need_connectable != prospector_adv_connectable) {
             // Profile state changed - switch ADV type
+            ADV_STAT_INC(own_adv_stats_mode(), flips);
             bt_le_adv_stop();
             prospector_adv_active = false;
             LOG_INF("📡 Profile state changed (%s→%s) - restarting ADV",
@@ -946,24 +2005,27 @@ static void adv_work_handler(struct k_work *work) {
             // Fall through to start new ADV below
         } else {
             // Same type - update AD data.
-            // Periodically send device name instead of manufacturer data so scanner
-            // can learn the name even when SCAN_RSP is blocked by radio congestion.
-            adv_cycle_counter++;
-            uint32_t name_interval = is_active ? NAME_ADV_INTERVAL_ACTIVE : NAME_ADV_INTERVAL_IDLE;
-            bool in_burst = (atomic_get(&burst_remaining) > 0);
-            bool send_name = !in_burst &&
-                             (adv_cycle_counter % name_interval == 0) &&
-                             name_ad[1].data_len > 0;
-
-            int err;
-            if (send_name) {
-                err = bt_le_adv_update_data(name_ad, ARRAY_SIZE(name_ad), NULL, 0);
+            // Skip the HCI round-trip entirely when the set already carries
+            // the current payload. Periodic static chunks still force a
+            // refresh, which also bounds how long an external stop of our
+            // ADV can go unnoticed (-EAGAIN below).
+            int err = 0;
+            select_legacy_frame(send_static);
+            if (send_static) {
+                ADV_STAT_INC(own_adv_stats_mode(), updates);
+                err = bt_le_adv_update_data(prospector_ad, ARRAY_SIZE(prospector_ad), NULL, 0);
+                own_ad_in_sync = false;
                 if (err == 0) {
-                    LOG_DBG("📡 Name-in-AD sent: \"%s\"", name_adv_buffer);
+                    static_on_air = true;
+                    static_chunk_sent();
                 }
-            } else {
+            } else if (payload_changed || !own_ad_in_sync || static_was_on_air) {
+                ADV_STAT_INC(own_adv_stats_mode(), updates);
                 err = bt_le_adv_update_data(prospector_ad, ARRAY_SIZE(prospector_ad),
                                             NULL, 0);
+                own_ad_in_sync = (err == 0);
+            } else {
+                LOG_DBG("📡 Payload unchanged - skipped ADV data update");
             }
             if (err == -EAGAIN) {
                 // ADV stopped externally (PC connected through proxy, or ZMK took over)
@@ -977,6 +2039,11 @@ static void adv_work_handler(struct k_work *work) {
 
     if (!prospector_adv_active) {
         // Try piggyback on ZMK's advertising
+        // Always refreshed, even if the payload is unchanged: ZMK may restart
+        // its advertising with its own data at any time, and this call is
+        // also our only probe for "ZMK stopped advertising" (-EAGAIN).
+        select_legacy_frame(send_static);
+        ADV_STAT_INC(ADV_STATS_PIGGYBACK, updates);
 #if defined(BT_LE_ADV_OPT_FORCE_NAME_IN_AD)
         // Newer Zephyr: ZMK puts name in AD → SD is free for manufacturer data
         int err = bt_le_adv_update_data(zmk_ad_restore, ARRAY_SIZE(zmk_ad_restore),
@@ -989,13 +2056,18 @@ static void adv_work_handler(struct k_work *work) {
 #endif
 
         if (err == 0) {
+            if (send_static) {
+                static_on_air = true;
+                static_chunk_sent();
+            }
             if (!zmk_adv_was_active) {
                 LOG_INF("📡 Piggyback active (ZMK advertising)");
                 zmk_adv_was_active = true;
             }
         } else if (err == -EAGAIN) {
-            // ZMK not advertising → start our own ADV
+            // ZMK not advertising → start our own ADV (always with the dynamic frame)
             zmk_adv_was_active = false;
+            select_legacy_frame(false);
 
             if (!prospector_split_fully_connected()) {
                 // BURST phase of the burst/silent cycle (silent phase is
@@ -1008,6 +2080,9 @@ static void adv_work_handler(struct k_work *work) {
                 if (err == 0) {
                     prospector_adv_active = true;
                     prospector_adv_connectable = false;
+                    prospector_adv_burst = true;
+                    own_ad_in_sync = true;
+                    ADV_STAT_INC(ADV_STATS_BURST, starts);
                     LOG_INF("📡 BURST ADV (split partial, %dms window)",
                             CONFIG_PROSPECTOR_SPLIT_PARTIAL_BURST_MS);
                 } else if (err != -EALREADY) {
@@ -1021,6 +2096,9 @@ static void adv_work_handler(struct k_work *work) {
                 if (err == 0) {
                     prospector_adv_active = true;
                     prospector_adv_connectable = false;
+                    prospector_adv_burst = false;
+                    own_ad_in_sync = true;
+                    ADV_STAT_INC(ADV_STATS_OWN_NC, starts);
                     LOG_INF("📡 MODE 2: Non-connectable ADV (profile connected)");
                 } else if (err != -EALREADY) {
                     LOG_WRN("Failed to start non-connectable ADV: %d", err);
@@ -1035,6 +2113,9 @@ static void adv_work_handler(struct k_work *work) {
                 if (err == 0) {
                     prospector_adv_active = true;
                     prospector_adv_connectable = true;
+                    prospector_adv_burst = false;
+                    own_ad_in_sync = true;
+                    ADV_STAT_INC(ADV_STATS_PROXY, starts);
                     LOG_INF("📡 Connectable proxy ADV (profile not connected)");
                 } else if (err != -EALREADY) {
                     LOG_WRN("Failed to start connectable proxy ADV: %d", err);
@@ -1045,47 +2126,25 @@ static void adv_work_handler(struct k_work *work) {
         }
     }
 
-    // Check if we're in burst mode (high-priority event)
-    int remaining = atomic_get(&burst_remaining);
-    if (remaining > 0) {
-        atomic_dec(&burst_remaining);
-        LOG_DBG("⚡ Burst advertisement %d/%d", BURST_COUNT - remaining + 1, BURST_COUNT);
-        k_work_schedule(&adv_work, K_MSEC(BURST_INTERVAL_MS));
-        return;
-    }
-
-    // Schedule next update with adaptive interval
-    uint32_t interval_ms = get_current_update_interval();
-
-    // During the BURST phase of split partial cycle, cap the wake so we
-    // transition to SILENT on time. Without this, the idle 30s schedule
-    // would let the burst run for 30s before the silent check fires.
-#if IS_ENABLED(CONFIG_ZMK_SPLIT_ROLE_CENTRAL)
-    if (!prospector_split_fully_connected()) {
-        const uint32_t burst_ms = CONFIG_PROSPECTOR_SPLIT_PARTIAL_BURST_MS;
-        const uint32_t silent_ms = CONFIG_PROSPECTOR_SPLIT_PARTIAL_SILENT_MS;
-        const uint32_t cycle_ms = burst_ms + silent_ms;
-        uint32_t phase = k_uptime_get_32() % cycle_ms;
-        if (phase < burst_ms) {
-            uint32_t until_silent = burst_ms - phase;
-            if (until_silent < interval_ms) {
-                interval_ms = until_silent;
-            }
-        }
-    }
+#endif // CONFIG_ZMK_STATUS_ADV_EXTENDED
+
+#if IS_ENABLED(CONFIG_ZMK_STATUS_ADV_EXTENDED) && IS_ENABLED(CONFIG_ZMK_STATUS_ADV_SCANNER_PRESENCE)
+    // Payload only goes out in scan responses, which aren't counted
+    adv_stats_set_mode(ext_adv_running ? ADV_STATS_EXTENDED : ADV_STATS_OFF, 0);
+#elif IS_ENABLED(CONFIG_ZMK_STATUS_ADV_EXTENDED)
+    adv_stats_set_mode(ext_adv_running ? ADV_STATS_EXTENDED : ADV_STATS_OFF,
+                       ext_ad[0].data_len + 2);
+#elif IS_ENABLED(CONFIG_ZMK_STATUS_ADV_STATUS_SET)
+    adv_stats_set_mode(status_set_running ? ADV_STATS_STATUS_SET : ADV_STATS_OFF,
+                       ADV_STATS_LEGACY_AD_LEN);
+#else
+    adv_stats_set_mode(prospector_adv_active ? own_adv_stats_mode() :
+                       zmk_adv_was_active ? ADV_STATS_PIGGYBACK : ADV_STATS_OFF,
+                       ADV_STATS_LEGACY_AD_LEN);
 #endif
+    adv_stats_maybe_log();
 
-    // Periodic logging (every 20th update to avoid spam)
-    static int update_counter = 0;
-    update_counter++;
-    if (update_counter % 20 == 0) {
-        LOG_INF("📊 PROSPECTOR: %dms intervals (%s) - %s",
-                interval_ms, is_active ? "ACTIVE" : "IDLE",
-                prospector_adv_active ? (prospector_adv_connectable ? "PROXY_CONN" : "OWN_NC") :
-                zmk_adv_was_active ? "PIGGYBACK" : "WAITING");
-    }
-
-    k_work_schedule(&adv_work, K_MSEC(interval_ms));
+    adv_schedule_next(now);
 }
 
 // Initialize Prospector simple advertising system
@@ -1132,7 +2191,7 @@ static int init_prospector_status(PROSPECTOR_SYS_INIT_ARGS) {
     }
 #endif
 
-    // Initialize name-in-AD buffer for periodic name broadcast
+    // Keyboard name for the static packet (and the extended NAME record)
     {
         const char *adv_name = CONFIG_ZMK_STATUS_ADV_KEYBOARD_NAME;
         if (strlen(adv_name) == 0) {
@@ -1141,8 +2200,8 @@ static int init_prospector_status(PROSPECTOR_SYS_INIT_ARGS) {
         size_t name_len = MIN(strlen(adv_name), sizeof(name_adv_buffer) - 1);
         memcpy(name_adv_buffer, adv_name, name_len);
         name_adv_buffer[name_len] = '\0';
-        name_ad[1].data_len = name_len;
-        LOG_INF("Name-in-AD initialized: \"%s\" (%d bytes)", name_adv_buffer, (int)name_len);
+        name_adv_len = name_len;
+        refresh_static_blob();
     }
 
     // Initialize activity tracking
@@ -1161,8 +2220,14 @@ static int init_prospector_status(PROSPECTOR_SYS_INIT_ARGS) {
     // Start hybrid advertising with initial burst for immediate scanner detection
     adv_started = true;
     atomic_set(&burst_remaining, BURST_COUNT);  // Burst on boot so scanner shows profile immediately
+    prospector_sched_arm(&adv_classes[ADV_CLASS_STATIC], k_uptime_get_32(), 0, 0);
     k_work_schedule(&adv_work, K_SECONDS(1)); // Wait for ZMK BLE to start
+#if IS_ENABLED(CONFIG_ZMK_STATUS_ADV_STATUS_SET)
+    LOG_INF("Prospector: Status set mode - own ADV set next to ZMK's%s",
+            IS_ENABLED(CONFIG_ZMK_STATUS_ADV_GATT) ? ", connectable for GATT link" : "");
+#else
     LOG_INF("Prospector: Hybrid mode - piggyback when disconnected, own ADV when connected");
+#endif
 
     return 0;
 }
@@ -1196,11 +2261,9 @@ int zmk_status_advertisement_start(void) {
 int zmk_status_advertisement_stop(void) {
     if (adv_started) {
         k_work_cancel_delayable(&adv_work);
-        if (prospector_adv_active) {
-            bt_le_adv_stop();
-            prospector_adv_active = false;
-        }
+        status_adv_halt();
         zmk_adv_was_active = false;
+        adv_stats_set_mode(ADV_STATS_OFF, 0);
         LOG_INF("Stopped Prospector status updates");
     }
     return 0;
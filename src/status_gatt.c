@@ -0,0 +1,73 @@
+/*
+ * Copyright (c) 2024 The ZMK Contributors
+ *
+ * SPDX-License-Identifier: MIT
+ */
+
+#include <zephyr/types.h>
+#include <zephyr/kernel.h>
+#include <string.h>
+
+#include <zephyr/bluetooth/bluetooth.h>
+#include <zephyr/bluetooth/conn.h>
+#include <zephyr/bluetooth/gatt.h>
+#include <zephyr/bluetooth/uuid.h>
+
+#include <zephyr/logging/log.h>
+
+LOG_MODULE_DECLARE(zmk, CONFIG_ZMK_LOG_LEVEL);
+
+#include <zmk/status_gatt.h>
+
+// Snapshot the characteristic reads; written from the work queue, read
+// from the BT RX thread (reads, notifications go out right away)
+static struct zmk_status_adv_data gatt_frame;
+static struct k_spinlock gatt_lock;
+static bool gatt_subscribed;
+
+static ssize_t status_gatt_read(struct bt_conn *conn, const struct bt_gatt_attr *attr, void *buf,
+                                uint16_t len, uint16_t offset) {
+    struct zmk_status_adv_data frame;
+
+    K_SPINLOCK(&gatt_lock) {
+        frame = gatt_frame;
+    }
+    return bt_gatt_attr_read(conn, attr, buf, len, offset, &frame, sizeof(frame));
+}
+
+static void status_gatt_ccc_changed(const struct bt_gatt_attr *attr, uint16_t value) {
+    ARG_UNUSED(attr);
+    gatt_subscribed = (value == BT_GATT_CCC_NOTIFY);
+    LOG_INF("📡 Status GATT notifications %s", gatt_subscribed ? "on" : "off");
+}
+
+static struct bt_uuid_128 status_gatt_svc_uuid = BT_UUID_INIT_128(PSPTR_STATUS_GATT_SVC_UUID);
+static struct bt_uuid_128 status_gatt_chr_uuid = BT_UUID_INIT_128(PSPTR_STATUS_GATT_CHR_UUID);
+
+// Open permissions on purpose: the same bytes are on air in the status ADV
+BT_GATT_SERVICE_DEFINE(psptr_status_gatt_svc, BT_GATT_PRIMARY_SERVICE(&status_gatt_svc_uuid),
+                       BT_GATT_CHARACTERISTIC(&status_gatt_chr_uuid.uuid,
+                                              BT_GATT_CHRC_READ | BT_GATT_CHRC_NOTIFY,
+                                              BT_GATT_PERM_READ, status_gatt_read, NULL,
+                                              NULL),
+                       BT_GATT_CCC(status_gatt_ccc_changed,
+                                   BT_GATT_PERM_READ | BT_GATT_PERM_WRITE));
+
+int zmk_status_gatt_notify(const struct zmk_status_adv_data *data) {
+    K_SPINLOCK(&gatt_lock) {
+        gatt_frame = *data;
+    }
+    if (!gatt_subscribed) {
+        return 0;
+    }
+
+    // attrs[1] is the characteristic declaration; notify sends its value.
+    // A subscriber whose MTU is too small for a frame gets nothing; the
+    // scanner raises the MTU before subscribing.
+    int err = bt_gatt_notify(NULL, &psptr_status_gatt_svc.attrs[1], data, sizeof(*data));
+    if (err && err != -ENOTCONN) {
+        LOG_DBG("Status GATT notify error: %d", err);
+        return err;
+    }
+    return 0;
+}
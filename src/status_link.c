@@ -0,0 +1,286 @@
+/*
+ * Copyright (c) 2024 The ZMK Contributors
+ *
+ * SPDX-License-Identifier: MIT
+ *
+ * GATT status link (CONFIG_PROSPECTOR_SCANNER_GATT_LINK)
+ *
+ * Connects to the selected keyboard's Prospector status service and takes
+ * its frames as notifications; passive ADV scanning is off while linked.
+ *   Work queue  → link_work_handler() → connect / RSSI / selection check
+ *   BT RX       → MTU exchange → discovery → subscribe → link_notify()
+ *               → scanner_msg_send_keyboard_data(), as scan_callback() does
+ * On disconnect, or a keyboard without the service, scanning restarts and
+ * that keyboard is left to its advertisements for LINK_SKIP_MS.
+ */
+
+#include <zephyr/kernel.h>
+#include <zephyr/init.h>
+#include <zephyr/sys/atomic.h>
+#include <zephyr/sys/byteorder.h>
+#include <zephyr/bluetooth/bluetooth.h>
+#include <zephyr/bluetooth/conn.h>
+#include <zephyr/bluetooth/gatt.h>
+#include <zephyr/bluetooth/hci.h>
+#include <zephyr/bluetooth/uuid.h>
+#include <zephyr/logging/log.h>
+#include <string.h>
+
+#include <zmk/prospector_compat.h>
+#include <zmk/status_scanner.h>
+#include <zmk/status_gatt.h>
+
+#include "../boards/shields/prospector_scanner/src/scanner_stub.h"
+
+LOG_MODULE_DECLARE(zmk, CONFIG_ZMK_LOG_LEVEL);
+
+/* Our RX MTU comes from the ACL buffer: one frame per notification */
+BUILD_ASSERT(CONFIG_BT_BUF_ACL_RX_SIZE >= PSPTR_STATUS_GATT_MIN_MTU + 4,
+             "GATT status link needs CONFIG_BT_BUF_ACL_RX_SIZE >= 33");
+
+#define LINK_POLL_MS 2000   /* Connect attempts, RSSI reads, selection check */
+#define LINK_SKIP_MS 60000  /* A keyboard that failed stays on ADV this long */
+
+/* 15-30ms interval; the keyboard may skip 4 idle events, not a notification */
+static const struct bt_le_conn_param link_conn_param = BT_LE_CONN_PARAM_INIT(12, 24, 4, 400);
+
+static struct bt_uuid_128 link_chr_uuid = BT_UUID_INIT_128(PSPTR_STATUS_GATT_CHR_UUID);
+
+/* Set by the work handler before connecting, stable while the link lives */
+static bt_addr_le_t link_addr;
+static zmk_keyboard_name_t link_name;  /* Referenced: outlives an evicted slot */
+static struct bt_conn *link_conn;
+
+/* BT RX thread → work handler */
+static atomic_t link_down = ATOMIC_INIT(0);
+static atomic_t link_rssi = ATOMIC_INIT(0);
+static bool link_subscribed;
+
+/* Work queue only */
+static bt_addr_le_t skip_addr;
+static uint32_t skip_until;
+
+static struct bt_gatt_exchange_params mtu_params;
+static struct bt_gatt_discover_params discover_params;
+static struct bt_gatt_subscribe_params subscribe_params;
+
+static void link_work_handler(struct k_work *work);
+static K_WORK_DELAYABLE_DEFINE(link_work, link_work_handler);
+
+/* BT RX thread: drop the link; the work handler cleans up */
+static void link_fail(struct bt_conn *conn, const char *why, int err) {
+    LOG_WRN("GATT link: %s (%d) - back to scanning", why, err);
+    bt_conn_disconnect(conn, BT_HCI_ERR_REMOTE_USER_TERM_CONN);
+}
+
+static uint8_t link_notify(struct bt_conn *conn, struct bt_gatt_subscribe_params *params,
+                           const void *data, uint16_t length) {
+    ARG_UNUSED(conn);
+    if (!data) {
+        params->value_handle = 0;  /* Unsubscribed */
+        return BT_GATT_ITER_STOP;
+    }
+
+    const struct zmk_status_adv_data *frame = data;
+    if (length != sizeof(*frame) || frame->service_uuid[0] != (ZMK_STATUS_ADV_SERVICE_UUID >> 8) ||
+        frame->service_uuid[1] != (ZMK_STATUS_ADV_SERVICE_UUID & 0xFF)) {
+        LOG_DBG("GATT link: unexpected %u-byte notification", length);
+        return BT_GATT_ITER_CONTINUE;
+    }
+
+    int ret = scanner_msg_send_keyboard_data(frame, (int8_t)atomic_get(&link_rssi), link_name,
+                                             link_addr.a.val, link_addr.type, NULL);
+    if (ret != 0) {
+        LOG_DBG("Ring buffer full, notification dropped");
+    }
+    return BT_GATT_ITER_CONTINUE;
+}
+
+static void link_subscribed_cb(struct bt_conn *conn, uint8_t err,
+                               struct bt_gatt_subscribe_params *params) {
+    ARG_UNUSED(params);
+    if (err) {
+        link_fail(conn, "subscribe failed", err);
+        return;
+    }
+    link_subscribed = true;
+    LOG_INF("🔗 GATT link to '%s' up - scanning paused", zmk_keyboard_name_str(link_name));
+}
+
+static uint8_t link_discover_cb(struct bt_conn *conn, const struct bt_gatt_attr *attr,
+                                struct bt_gatt_discover_params *params) {
+    ARG_UNUSED(params);
+    if (!attr) {
+        link_fail(conn, "keyboard has no status service", -ENOENT);
+        return BT_GATT_ITER_STOP;
+    }
+
+    const struct bt_gatt_chrc *chrc = attr->user_data;
+    subscribe_params.notify = link_notify;
+    subscribe_params.subscribe = link_subscribed_cb;
+    subscribe_params.value = BT_GATT_CCC_NOTIFY;
+    subscribe_params.value_handle = chrc->value_handle;
+    /* Our own service: the CCC descriptor directly follows the value */
+    subscribe_params.ccc_handle = chrc->value_handle + 1;
+    int err = bt_gatt_subscribe(conn, &subscribe_params);
+    if (err && err != -EALREADY) {
+        link_fail(conn, "subscribe failed", err);
+    }
+    return BT_GATT_ITER_STOP;
+}
+
+static void link_mtu_cb(struct bt_conn *conn, uint8_t err, struct bt_gatt_exchange_params *params) {
+    ARG_UNUSED(params);
+    if (err || bt_gatt_get_mtu(conn) < PSPTR_STATUS_GATT_MIN_MTU) {
+        link_fail(conn, "ATT MTU too small for a frame", bt_gatt_get_mtu(conn));
+        return;
+    }
+
+    discover_params.uuid = &link_chr_uuid.uuid;
+    discover_params.func = link_discover_cb;
+    discover_params.start_handle = BT_ATT_FIRST_ATTRIBUTE_HANDLE;
+    discover_params.end_handle = BT_ATT_LAST_ATTRIBUTE_HANDLE;
+    discover_params.type = BT_GATT_DISCOVER_CHARACTERISTIC;
+    int ret = bt_gatt_discover(conn, &discover_params);
+    if (ret) {
+        link_fail(conn, "discovery failed", ret);
+    }
+}
+
+static void link_connected(struct bt_conn *conn, uint8_t err) {
+    if (conn != link_conn) {
+        return;
+    }
+    if (err) {
+        /* No disconnected() follows a failed connect */
+        LOG_WRN("GATT link: connect to '%s' failed (0x%02x) - back to scanning",
+                zmk_keyboard_name_str(link_name), err);
+        atomic_set(&link_down, 1);
+        k_work_reschedule(&link_work, K_NO_WAIT);
+        return;
+    }
+
+    mtu_params.func = link_mtu_cb;
+    int ret = bt_gatt_exchange_mtu(conn, &mtu_params);
+    if (ret) {
+        link_fail(conn, "MTU exchange failed", ret);
+    }
+}
+
+static void link_disconnected(struct bt_conn *conn, uint8_t reason) {
+    if (conn != link_conn) {
+        return;
+    }
+    LOG_INF("🔗 GATT link to '%s' down (0x%02x)", zmk_keyboard_name_str(link_name), reason);
+    atomic_set(&link_down, 1);
+    k_work_reschedule(&link_work, K_NO_WAIT);
+}
+
+static struct bt_conn_cb link_conn_callbacks = {
+    .connected = link_connected,
+    .disconnected = link_disconnected,
+};
+
+/* Work queue: HCI Read RSSI, shown like an ADV report's RSSI */
+static void link_read_rssi(void) {
+    struct bt_hci_cp_read_rssi *cp;
+    struct net_buf *buf, *rsp = NULL;
+    uint16_t handle;
+
+    if (bt_hci_get_conn_handle(link_conn, &handle)) {
+        return;
+    }
+    buf = bt_hci_cmd_create(BT_HCI_OP_READ_RSSI, sizeof(*cp));
+    if (!buf) {
+        return;
+    }
+    cp = net_buf_add(buf, sizeof(*cp));
+    cp->handle = sys_cpu_to_le16(handle);
+    if (bt_hci_cmd_send_sync(BT_HCI_OP_READ_RSSI, buf, &rsp) == 0) {
+        const struct bt_hci_rp_read_rssi *rp = (const void *)rsp->data;
+        atomic_set(&link_rssi, rp->rssi);
+        net_buf_unref(rsp);
+    }
+}
+
+/* Work queue: connect to the selected keyboard if it is in range */
+static void link_try_connect(uint32_t now) {
+    struct zmk_keyboard_status kbd;
+
+    /* A copy: the scanner's work handler may be rewriting the slot */
+    if (!scanner_snapshot_keyboard(scanner_get_selected_keyboard(), &kbd, NULL)) {
+        return;
+    }
+
+    bt_addr_le_t addr = {.type = kbd.ble_addr_type};
+    memcpy(addr.a.val, kbd.ble_addr, sizeof(addr.a.val));
+    if (bt_addr_le_cmp(&addr, &skip_addr) == 0 && (int32_t)(skip_until - now) > 0) {
+        return;
+    }
+
+    link_addr = addr;
+    zmk_keyboard_name_release(link_name);
+    link_name = zmk_keyboard_name_hold(kbd.name);
+    atomic_set(&link_rssi, kbd.rssi);
+    link_subscribed = false;
+
+    /* The link replaces scanning; the controller can't connect while scanning */
+    zmk_status_scanner_stop();
+    int err = bt_conn_le_create(&link_addr, BT_CONN_LE_CREATE_CONN, &link_conn_param, &link_conn);
+    if (err) {
+        LOG_WRN("GATT link: connect to '%s' not started (%d)", zmk_keyboard_name_str(link_name),
+                err);
+        link_conn = NULL;
+        skip_addr = link_addr;
+        skip_until = now + LINK_SKIP_MS;
+        zmk_status_scanner_start();
+        return;
+    }
+    LOG_INF("🔗 GATT link: connecting to '%s'", zmk_keyboard_name_str(link_name));
+}
+
+static void link_work_handler(struct k_work *work) {
+    ARG_UNUSED(work);
+    uint32_t now = k_uptime_get_32();
+
+    if (atomic_cas(&link_down, 1, 0) && link_conn) {
+        /* A link that never came up is not tried again for a while */
+        if (!link_subscribed) {
+            skip_addr = link_addr;
+            skip_until = now + LINK_SKIP_MS;
+        }
+        bt_conn_unref(link_conn);
+        link_conn = NULL;
+        link_subscribed = false;
+        zmk_status_scanner_start();
+    }
+
+    if (!link_conn) {
+        link_try_connect(now);
+    } else if (link_subscribed) {
+        /* Follow the selection: another keyboard means another link */
+        uint8_t addr[6];
+        uint8_t type;
+        int sel = scanner_get_selected_keyboard();
+        if (!scanner_get_keyboard_address(sel, addr, &type) || type != link_addr.type ||
+            memcmp(addr, link_addr.a.val, sizeof(addr)) != 0) {
+            LOG_INF("🔗 GATT link: selection changed - dropping '%s'",
+                    zmk_keyboard_name_str(link_name));
+            bt_conn_disconnect(link_conn, BT_HCI_ERR_REMOTE_USER_TERM_CONN);
+        } else {
+            link_read_rssi();
+        }
+    }
+
+    k_work_schedule(&link_work, K_MSEC(LINK_POLL_MS));
+}
+
+static int status_link_init(PROSPECTOR_SYS_INIT_ARGS) {
+    PROSPECTOR_SYS_INIT_UNUSED;
+    bt_conn_cb_register(&link_conn_callbacks);
+    /* The first poll finds keyboards the scan has listed by then */
+    k_work_schedule(&link_work, K_MSEC(LINK_POLL_MS));
+    return 0;
+}
+
+SYS_INIT(status_link_init, APPLICATION, CONFIG_APPLICATION_INIT_PRIORITY);
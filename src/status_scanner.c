@@ -8,6 +8,7 @@
  * Architecture:
  *   BT RX thread → scan_callback() → parse ADV → scanner_msg_send_keyboard_data()
  *   LVGL timer   → scanner_process_incoming() (in scanner_stub.c) → keyboards[] → widget
+ *   Work queue   → relay_work_handler() → keyboards[] snapshots → relay ADV set
  *
  * This file does NOT touch keyboards[] or any display state.
  * All keyboard state management is in scanner_stub.c (LVGL timer context only).
@@ -23,6 +24,12 @@
 
 #include <zmk/status_scanner.h>
 #include <zmk/status_advertisement.h>
+#include <zmk/keyboard_names.h>
+#include <zmk/status_adv_packed.h>
+#include <zmk/prospector_trace.h>
+#if IS_ENABLED(CONFIG_PROSPECTOR_SCANNER_ADV_CAPTURE)
+#include <zmk/adv_capture.h>
+#endif
 
 // Scanner stub functions for lock-free ring buffer push
 #include "../boards/shields/prospector_scanner/src/scanner_stub.h"
@@ -33,170 +40,1180 @@ LOG_MODULE_DECLARE(zmk, CONFIG_ZMK_LOG_LEVEL);
 
 static bool scanning = false;
 
-/* ========== Temporary Device Name Cache ========== */
-/* Correlates BLE address with device name from SCAN_RSP packets.
- * Only used within scan_callback context (BT RX thread). */
+/* ========== Device Cache ========== */
+/* Per-address state of the BT RX thread: the name from ADV/SCAN_RSP
+ * packets (interned, the entry holds a reference) and the v3 repeat
+ * filter. Open-addressed hash table keyed on the address, sized for
+ * MAX_KEYBOARDS plus as many pending entries.
+ * Only addresses that sent Prospector manufacturer data get an entry;
+ * names from other packets are only stored for addresses already here.
+ * Entries are replaced in place (never deleted), so probe chains stay
+ * intact. Only used within scan_callback context (BT RX thread). */
+
+#define DEVICE_CACHE_SIZE ZMK_STATUS_SCANNER_DEVICE_CACHE_SIZE
+
+/* A keyboard repeats the same frame on every ADV event until its content
+ * changes. With a sequence number, repeats can be dropped here instead of
+ * costing a ring slot and a full keyboards[] update each. One repeat per
+ * REPEAT_PASS_MS still goes through to refresh last_seen and RSSI. */
+#define REPEAT_PASS_MS 1000
 
 static struct {
     bt_addr_le_t addr;
-    char name[32];
-    uint32_t timestamp;
-} temp_device_names[5];
+    bool used;
+    bool verified;       /* Sent a frame that was accepted (not just Prospector-like) */
+    zmk_keyboard_name_t name;
+    uint32_t timestamp;  /* Last Prospector frame, for eviction */
+    bool has_seq;
+    uint8_t seq;
+    uint32_t pushed_at;
+} device_cache[DEVICE_CACHE_SIZE];
+
+static uint32_t device_hash(const bt_addr_le_t *addr) {
+    uint32_t h = 2166136261u ^ addr->type;
+    for (int i = 0; i < 6; i++) {
+        h = (h ^ addr->a.val[i]) * 16777619u;
+    }
+    return h;
+}
 
-static void store_device_name(const bt_addr_le_t *addr, const char *name) {
+static int find_device(const bt_addr_le_t *addr) {
+    uint32_t home = device_hash(addr);
+    for (int i = 0; i < DEVICE_CACHE_SIZE; i++) {
+        int idx = (home + i) & (DEVICE_CACHE_SIZE - 1);
+        if (!device_cache[idx].used) {
+            return -1;  /* End of probe chain */
+        }
+        if (bt_addr_le_cmp(&device_cache[idx].addr, addr) == 0) {
+            return idx;
+        }
+    }
+    return -1;
+}
+
+/* Existing entry for addr, or a new one with no name. When the table is
+ * full, unverified entries go first, then the longest silent one. */
+static int track_device(const bt_addr_le_t *addr) {
     uint32_t now = k_uptime_get_32();
-    int oldest_idx = 0;
-    uint32_t oldest_time = UINT32_MAX;
-
-    for (int i = 0; i < 5; i++) {
-        /* Exact match: update existing entry */
-        if (bt_addr_le_cmp(&temp_device_names[i].addr, addr) == 0) {
-            strncpy(temp_device_names[i].name, name, sizeof(temp_device_names[i].name) - 1);
-            temp_device_names[i].name[sizeof(temp_device_names[i].name) - 1] = '\0';
-            temp_device_names[i].timestamp = now;
-            return;
+    uint32_t home = device_hash(addr);
+    int victim = -1;
+
+    for (int i = 0; i < DEVICE_CACHE_SIZE; i++) {
+        int idx = (home + i) & (DEVICE_CACHE_SIZE - 1);
+        if (!device_cache[idx].used) {
+            victim = idx;
+            break;
+        }
+        if (bt_addr_le_cmp(&device_cache[idx].addr, addr) == 0) {
+            device_cache[idx].timestamp = now;
+            return idx;
         }
-        /* Track oldest entry for LRU eviction */
-        if (temp_device_names[i].timestamp < oldest_time) {
-            oldest_time = temp_device_names[i].timestamp;
-            oldest_idx = i;
+        if (victim < 0 ||
+            (device_cache[victim].verified && !device_cache[idx].verified) ||
+            (device_cache[victim].verified == device_cache[idx].verified &&
+             (now - device_cache[idx].timestamp) > (now - device_cache[victim].timestamp))) {
+            victim = idx;
         }
     }
 
-    /* No match found: evict oldest entry (LRU) */
-    bt_addr_le_copy(&temp_device_names[oldest_idx].addr, addr);
-    strncpy(temp_device_names[oldest_idx].name, name, sizeof(temp_device_names[oldest_idx].name) - 1);
-    temp_device_names[oldest_idx].name[sizeof(temp_device_names[oldest_idx].name) - 1] = '\0';
-    temp_device_names[oldest_idx].timestamp = now;
+    if (device_cache[victim].used) {
+        LOG_DBG("Device cache full - evicting %s entry '%s'",
+                device_cache[victim].verified ? "verified" : "pending",
+                zmk_keyboard_name_str(device_cache[victim].name));
+        zmk_keyboard_name_release(device_cache[victim].name);
+    }
+    memset(&device_cache[victim], 0, sizeof(device_cache[victim]));
+    bt_addr_le_copy(&device_cache[victim].addr, addr);
+    device_cache[victim].used = true;
+    device_cache[victim].timestamp = now;
+    return victim;
+}
+
+/* name is not null-terminated (straight from the AD structure). Keyboards
+ * repeat their name in every SCAN_RSP, so an unchanged name is only
+ * compared against the entry's own and not looked up in the table. */
+static void store_device_name(int idx, const uint8_t *name, uint8_t len, bool shortened) {
+    const char *str = (const char *)name;
+    const char *cur = zmk_keyboard_name_str(device_cache[idx].name);
+    size_t n = MIN(len, ZMK_KEYBOARD_NAME_MAX);
+
+    if (shortened && n >= 7 && memcmp(name, "LalaPad", 7) == 0) {
+        str = "LalaPadmini";
+        n = strlen(str);
+        LOG_DBG("Expanded shortened name to: %s", str);
+    }
+    if (strnlen(cur, n + 1) != n || memcmp(cur, str, n) != 0) {
+        zmk_keyboard_name_set_str(&device_cache[idx].name, str, n);
+    }
+}
+
+static bool is_repeat_frame(int idx, uint8_t seq) {
+    uint32_t now = k_uptime_get_32();
+
+    if (device_cache[idx].has_seq && device_cache[idx].seq == seq &&
+        (now - device_cache[idx].pushed_at) < REPEAT_PASS_MS) {
+        return true;
+    }
+    device_cache[idx].has_seq = true;
+    device_cache[idx].seq = seq;
+    device_cache[idx].pushed_at = now;
+    return false;
+}
+
+/* ========== Channel Filter ========== */
+
+/* Channel this scanner listens on (runtime setting, else Kconfig) */
+static uint8_t scanner_channel_get(void) {
+    extern uint8_t scanner_get_runtime_channel(void) __attribute__((weak));
+    uint8_t scanner_channel = 0;
+    if (scanner_get_runtime_channel) {
+        scanner_channel = scanner_get_runtime_channel();
+    }
+#ifdef CONFIG_PROSPECTOR_SCANNER_CHANNEL
+    else {
+        scanner_channel = CONFIG_PROSPECTOR_SCANNER_CHANNEL;
+    }
+#endif
+    return scanner_channel;
+}
+
+/* Returns true if a keyboard on keyboard_channel should be shown here */
+static bool channel_accepts(uint8_t keyboard_channel, uint8_t scanner_channel) {
+    bool channel_match = (scanner_channel == 0 ||
+                          scanner_channel >= 10 ||
+                          keyboard_channel == 0 ||
+                          scanner_channel == keyboard_channel);
+    if (!channel_match) {
+        LOG_DBG("Channel mismatch - KB Ch:%d, Scanner Ch:%d (filtered)",
+                keyboard_channel, scanner_channel);
+    }
+    return channel_match;
 }
 
-static const char *get_device_name(const bt_addr_le_t *addr) {
-    for (int i = 0; i < 5; i++) {
-        if (bt_addr_le_cmp(&temp_device_names[i].addr, addr) == 0) {
-            return temp_device_names[i].name;
+/* ========== Extended ADV TLV Parser ========== */
+/* Format: see ZMK_STATUS_ADV_EXT_* in status_advertisement.h.
+ * Returns the CORE record (pointing into buf), NULL if absent/malformed.
+ * Name and layer extras are written to name_out / ext_out when present;
+ * a static chunk record is rebuilt into a full frame in static_out
+ * (static_hash stays 0 when absent). A relay origin record is only read
+ * with origin_out (relay_channel stays 0 when absent). */
+
+static const struct zmk_status_adv_data *
+parse_ext_payload(const uint8_t *buf, uint8_t len, char *name_out, size_t name_size,
+                  struct zmk_status_adv_ext_fields *ext_out,
+                  struct zmk_status_adv_static_frame *static_out,
+                  struct zmk_status_adv_relay_origin *origin_out) {
+    const struct zmk_status_adv_data *core = NULL;
+
+    if (buf[4] != ZMK_STATUS_ADV_EXT_FORMAT) {
+        LOG_DBG("Unsupported extended format %d", buf[4]);
+        return NULL;
+    }
+
+    uint8_t pos = ZMK_STATUS_ADV_EXT_HEADER_LEN;
+    while (pos + 2 <= len) {
+        uint8_t type = buf[pos];
+        uint8_t vlen = buf[pos + 1];
+        const uint8_t *value = &buf[pos + 2];
+        if (pos + 2 + vlen > len) {
+            break;  /* Truncated record */
+        }
+
+        switch (type) {
+        case ZMK_STATUS_ADV_TLV_CORE:
+            if (vlen >= sizeof(struct zmk_status_adv_data)) {
+                core = (const struct zmk_status_adv_data *)value;
+            }
+            break;
+        case ZMK_STATUS_ADV_TLV_KEYBOARD_NAME:
+            if (vlen > 0) {
+                size_t n = MIN(vlen, name_size - 1);
+                memcpy(name_out, value, n);
+                name_out[n] = '\0';
+            }
+            break;
+        case ZMK_STATUS_ADV_TLV_LAYER_NAME: {
+            size_t n = MIN(vlen, ZMK_STATUS_ADV_EXT_LAYER_NAME_MAX);
+            memcpy(ext_out->layer_name, value, n);
+            ext_out->layer_name[n] = '\0';
+            break;
         }
+        case ZMK_STATUS_ADV_TLV_STATIC_CHUNK:
+            /* Rebuild a full frame so both paths share one reassembler */
+            if (vlen >= sizeof(struct zmk_status_adv_static_frame) - 4) {
+                memcpy(&static_out->static_hash, value,
+                       sizeof(struct zmk_status_adv_static_frame) - 4);
+            }
+            break;
+        case ZMK_STATUS_ADV_TLV_SEQUENCE:
+            if (vlen >= 3) {
+                ext_out->has_seq = true;
+                ext_out->seq = value[0];
+                ext_out->age_ms = value[1] | (value[2] << 8);
+            }
+            break;
+        case ZMK_STATUS_ADV_TLV_LAYER_COUNT:
+            if (vlen >= 1) {
+                ext_out->layer_count = value[0];
+            }
+            break;
+        case ZMK_STATUS_ADV_TLV_SPLIT_LINK:
+            for (uint8_t i = 0; i < MIN(vlen / 2, ARRAY_SIZE(ext_out->peripheral_rssi)); i++) {
+                ext_out->peripheral_rssi[i] = (int8_t)value[2 * i];
+                ext_out->peripheral_reconnects[i] = value[2 * i + 1];
+            }
+            break;
+        case ZMK_STATUS_ADV_TLV_RELAY_ORIGIN:
+            if (origin_out && vlen >= sizeof(*origin_out)) {
+                memcpy(origin_out, value, sizeof(*origin_out));
+            }
+            break;
+        default:
+            break;  /* Unknown record: skip (forward compatible) */
+        }
+        pos += 2 + vlen;
+    }
+
+    return core;
+}
+
+/* ========== Fast-Reject AD Scan ========== */
+/* One pass over the AD structures without copying: remembers where the
+ * first Prospector manufacturer record (0xFF 0xFF 0xAB 0xCx) and the name
+ * are, nothing else. Everything else in range (phones, mice, beacons) is
+ * rejected on this result alone. */
+
+struct ad_scan_result {
+    const uint8_t *md;     /* Prospector manufacturer data, NULL if none */
+    uint8_t md_len;
+    const uint8_t *name;   /* Name AD value, not null-terminated */
+    uint8_t name_len;
+    bool name_shortened;
+};
+
+static void ad_scan(const uint8_t *data, uint16_t len, struct ad_scan_result *out) {
+    uint16_t pos = 0;
+
+    memset(out, 0, sizeof(*out));
+    while (pos + 1 < len) {
+        uint8_t field_len = data[pos];
+        if (field_len == 0 || pos + 1 + field_len > len) {
+            break;
+        }
+
+        uint8_t ad_type = data[pos + 1];
+        const uint8_t *value = &data[pos + 2];
+        uint8_t vlen = field_len - 1;
+
+        if (ad_type == BT_DATA_MANUFACTURER_DATA) {
+            if (!out->md && vlen >= 4 && value[0] == 0xFF && value[1] == 0xFF &&
+                value[2] == 0xAB && (value[3] & 0xF0) == 0xC0) {
+                out->md = value;
+                out->md_len = vlen;
+            }
+        } else if ((ad_type == BT_DATA_NAME_COMPLETE || ad_type == BT_DATA_NAME_SHORTENED) &&
+                   vlen > 0) {
+            out->name = value;
+            out->name_len = vlen;
+            out->name_shortened = (ad_type == BT_DATA_NAME_SHORTENED);
+        }
+        pos += 1 + field_len;
     }
-    return "Unknown";
 }
 
+#if IS_ENABLED(CONFIG_PROSPECTOR_SCANNER_RELAY_LISTEN)
+/* ========== Relay Listener ========== */
+/* Frames re-advertised by a relay scanner (CONFIG_PROSPECTOR_SCANNER_RELAY)
+ * name the keyboard they came from, so from here on they are handled
+ * like a frame heard from the keyboard itself: same device cache entry,
+ * repeat filter, slot and RSSI (as heard by the relay). */
+
+static void relay_frame_received(const uint8_t *md, uint8_t len, uint8_t scanner_channel) {
+    struct zmk_status_adv_ext_fields ext_fields = {0};
+    struct zmk_status_adv_static_frame ext_static = {0};
+    struct zmk_status_adv_relay_origin origin = {0};
+    char name[32] = {0};
+
+    if (len <= ZMK_STATUS_ADV_EXT_HEADER_LEN) {
+        return;
+    }
+    const struct zmk_status_adv_data *data =
+        parse_ext_payload(md, len, name, sizeof(name), &ext_fields, &ext_static, &origin);
+    if (!data || origin.relay_channel != CONFIG_PROSPECTOR_SCANNER_RELAY_CHANNEL) {
+        LOG_DBG("Relay frame for relay channel %d ignored", origin.relay_channel);
+        return;
+    }
+    if (!channel_accepts(data->channel, scanner_channel)) {
+        return;
+    }
+
+    bt_addr_le_t addr = {.type = origin.addr_type};
+    memcpy(addr.a.val, origin.addr, sizeof(addr.a.val));
+    int idx = track_device(&addr);
+    device_cache[idx].verified = true;
+    if (name[0] != '\0') {
+        store_device_name(idx, (const uint8_t *)name, strlen(name), false);
+    }
+    if (ext_fields.has_seq && is_repeat_frame(idx, ext_fields.seq)) {
+        scanner_msg_count_repeat(addr.a.val, origin.rssi);
+        return;
+    }
+
+    int ret = scanner_msg_send_keyboard_data(data, origin.rssi, device_cache[idx].name,
+                                             addr.a.val, addr.type, &ext_fields);
+    if (ret != 0) {
+        LOG_DBG("Ring buffer full, relayed advertisement dropped");
+    }
+}
+#endif /* CONFIG_PROSPECTOR_SCANNER_RELAY_LISTEN */
+
 /* ========== BLE Scan Callback ========== */
 /* Runs in BT RX thread. Parses ADV packets, pushes to ring buffer. */
 
+/* Reports seen since boot, read from any thread */
+static uint32_t scan_count;
+
+
+/* Also takes periodic train reports (CONFIG_PROSPECTOR_SCANNER_PERIODIC_SYNC),
+ * which keep coming while the scan itself is stopped */
+static void process_report(const bt_addr_le_t *addr, int8_t rssi, uint8_t type,
+                           struct net_buf_simple *buf) {
+    struct ad_scan_result ad;
+    ad_scan(buf->data, buf->len, &ad);
+
+#if IS_ENABLED(CONFIG_PROSPECTOR_SCANNER_ADV_CAPTURE)
+    zmk_adv_capture_record(addr, rssi, type, buf->data, buf->len, ad.md || ad.name);
+#endif
+
+    if (!ad.md) {
+        /* Not ours - only a SCAN_RSP name for a keyboard we already track */
+        if (ad.name) {
+            int idx = find_device(addr);
+            if (idx >= 0) {
+                store_device_name(idx, ad.name, ad.name_len, ad.name_shortened);
+                LOG_DBG("%s name for tracked device: '%s'",
+                        (type & BT_HCI_LE_ADV_EVT_TYPE_SCAN_RSP) ? "SCAN_RSP" : "ADV",
+                        zmk_keyboard_name_str(device_cache[idx].name));
+            }
+        }
+        return;
+    }
+
+#if IS_ENABLED(CONFIG_PROSPECTOR_SCANNER_RELAY_LISTEN)
+    /* Only the relay is listened to; keyboards heard directly are ignored */
+    if (ad.md[3] == (ZMK_STATUS_ADV_RELAY_SERVICE_UUID & 0xFF)) {
+        relay_frame_received(ad.md, ad.md_len, scanner_channel_get());
+    }
+    return;
+#endif
+
+    int name_idx = track_device(addr);
+    if (ad.name) {
+        store_device_name(name_idx, ad.name, ad.name_len, ad.name_shortened);
+    }
+
+    const struct zmk_status_adv_data *prospector_data = NULL;
+    const struct zmk_status_adv_static_frame *static_frame = NULL;
+    struct zmk_status_adv_ext_fields ext_fields = {0};
+    struct zmk_status_adv_static_frame ext_static = {0};
+    struct zmk_status_adv_data unpacked;
+    bool has_ext = false;
+    const uint8_t *md = ad.md;
+    uint8_t len = ad.md_len;
+    uint8_t scanner_channel = scanner_channel_get();
+
+    if (md[3] == (ZMK_STATUS_ADV_SERVICE_UUID & 0xFF) &&
+        len >= sizeof(struct zmk_status_adv_data) && ZMK_STATUS_ADV_IS_PACKED(md[4])) {
+        /* Bit-packed v3 frame: decode to the usual struct */
+        if (zmk_status_adv_unpack_v3(md, len, &unpacked, &ext_fields.seq,
+                                     &ext_fields.age_ms) &&
+            channel_accepts(unpacked.channel, scanner_channel)) {
+            prospector_data = &unpacked;
+            ext_fields.has_seq = true;
+            has_ext = true;
+        }
+    } else if (md[3] == (ZMK_STATUS_ADV_SERVICE_UUID & 0xFF) &&
+               len >= sizeof(struct zmk_status_adv_data)) {
+        /* Legacy 26-byte frame */
+        const struct zmk_status_adv_data *data = (const struct zmk_status_adv_data *)md;
+        LOG_DBG("Prospector data found - Length: %d", len);
+        if (channel_accepts(data->channel, scanner_channel)) {
+            prospector_data = data;
+            LOG_DBG("Valid Prospector data: Ch:%d Ver=%d Bat=%d%%",
+                    data->channel, data->version, data->battery_level);
+        }
+    } else if (md[3] == (ZMK_STATUS_ADV_EXT_SERVICE_UUID & 0xFF) &&
+               len > ZMK_STATUS_ADV_EXT_HEADER_LEN) {
+        /* Extended TLV frame (CONFIG_ZMK_STATUS_ADV_EXTENDED keyboards) */
+        char ext_name[32] = {0};
+        const struct zmk_status_adv_data *data =
+            parse_ext_payload(md, len, ext_name, sizeof(ext_name), &ext_fields,
+                              &ext_static, NULL);
+        if (data && channel_accepts(data->channel, scanner_channel)) {
+            prospector_data = data;
+            has_ext = true;
+            if (ext_static.static_hash != 0) {
+                static_frame = &ext_static;
+            }
+            if (ext_name[0] != '\0') {
+                store_device_name(name_idx, (const uint8_t *)ext_name, strlen(ext_name), false);
+            }
+            LOG_DBG("Valid extended Prospector data: %d bytes, layer '%s'/%d",
+                    len, ext_fields.layer_name, ext_fields.layer_count);
+        }
+    } else if (md[3] == (ZMK_STATUS_ADV_STATIC_SERVICE_UUID & 0xFF) &&
+               len >= sizeof(struct zmk_status_adv_static_frame)) {
+        /* Static packet chunk (name + layer table); no channel byte,
+         * the consumer only accepts it for keyboards already listed */
+        static_frame = (const struct zmk_status_adv_static_frame *)md;
+    } else {
+        LOG_DBG("Prospector-like manufacturer data ignored (%d bytes)", len);
+    }
+
+    if (prospector_data) {
+        device_cache[name_idx].verified = true;
+    }
+    if (prospector_data && ext_fields.has_seq && is_repeat_frame(name_idx, ext_fields.seq)) {
+        scanner_msg_count_repeat(addr->a.val, rssi);
+        prospector_data = NULL;
+    }
+
+    /* Push to ring buffer for LVGL timer to process */
+    if (prospector_data) {
+        LOG_DBG("Central=%d%%, Peripheral=[%d,%d,%d], Layer=%d",
+               prospector_data->battery_level, prospector_data->peripheral_battery[0],
+               prospector_data->peripheral_battery[1], prospector_data->peripheral_battery[2],
+               prospector_data->active_layer);
+
+        int ret = scanner_msg_send_keyboard_data(prospector_data, rssi,
+                                                  device_cache[name_idx].name,
+                                                  addr->a.val, addr->type,
+                                                  has_ext ? &ext_fields : NULL);
+        if (ret != 0) {
+            LOG_DBG("Ring buffer full, advertisement dropped");
+        }
+    }
+
+    if (static_frame) {
+        scanner_msg_send_static_frame(static_frame, addr->a.val);
+    }
+}
+
 static void scan_callback(const bt_addr_le_t *addr, int8_t rssi, uint8_t type,
                          struct net_buf_simple *buf) {
-    static int scan_count = 0;
+    PSPTR_TRACE_SCOPE("psptr_scan", buf->len);
     scan_count++;
 
     if (scan_count % 100 == 1) {
-        LOG_INF("BLE scan #%d (RSSI: %d)", scan_count, rssi);
+        LOG_INF("BLE scan #%u (RSSI: %d)", scan_count, rssi);
     }
 
     if (!scanning) {
         return;
     }
+    process_report(addr, rssi, type, buf);
+}
 
-    const struct zmk_status_adv_data *prospector_data = NULL;
+#if IS_ENABLED(CONFIG_PROSPECTOR_SCANNER_PIPELINE_BENCH) || \
+    IS_ENABLED(CONFIG_PROSPECTOR_SCANNER_ADV_CAPTURE)
+void zmk_status_scanner_inject_report(const bt_addr_le_t *addr, int8_t rssi, uint8_t type,
+                                      struct net_buf_simple *buf) {
+    scan_callback(addr, rssi, type, buf);
+}
+#endif
 
-    /* Parse advertisement data to extract both name and Prospector data */
-    struct net_buf_simple buf_copy = *buf;
-    while (buf_copy.len > 1) {
-        uint8_t len = net_buf_simple_pull_u8(&buf_copy);
-        if (len == 0 || len > buf_copy.len) {
-            break;
+#if IS_ENABLED(CONFIG_PROSPECTOR_PERF_PANEL)
+uint32_t zmk_status_scanner_report_count(void) {
+    return scan_count;
+}
+#endif
+
+/* ========== Scan Control ========== */
+
+/* Window/interval per duty level, in 0.625ms units */
+static const struct {
+    uint16_t interval;
+    uint16_t window;
+} scan_duty_params[] = {
+    [ZMK_STATUS_SCANNER_DUTY_FULL]    = {BT_GAP_SCAN_FAST_WINDOW, BT_GAP_SCAN_FAST_WINDOW},
+    [ZMK_STATUS_SCANNER_DUTY_REDUCED] = {BT_GAP_SCAN_FAST_WINDOW * 4, BT_GAP_SCAN_FAST_WINDOW},
+    [ZMK_STATUS_SCANNER_DUTY_LOW]     = {BT_GAP_SCAN_FAST_WINDOW * 10, BT_GAP_SCAN_FAST_WINDOW},
+};
+static enum zmk_status_scanner_duty scan_duty = ZMK_STATUS_SCANNER_DUTY_FULL;
+
+#if IS_ENABLED(CONFIG_PROSPECTOR_SCANNER_RELAY_LISTEN)
+/* Relay frames carry the name, so no scan requests go out from here */
+#define SCAN_TYPE BT_LE_SCAN_TYPE_PASSIVE
+#else
+#define SCAN_TYPE BT_LE_SCAN_TYPE_ACTIVE
+#endif
+
+static int scan_start(bool filtered) {
+    struct bt_le_scan_param scan_param = {
+        .type = SCAN_TYPE,
+        .options = filtered ? BT_LE_SCAN_OPT_FILTER_ACCEPT_LIST : BT_LE_SCAN_OPT_NONE,
+        .interval = scan_duty_params[scan_duty].interval,
+        .window = scan_duty_params[scan_duty].window,
+    };
+
+    /* With CONFIG_BT_EXT_ADV the host uses extended scan commands, so
+     * reports from the secondary channel (1M/2M) reach scan_callback too */
+    return bt_le_scan_start(&scan_param, scan_callback);
+}
+
+#if IS_ENABLED(CONFIG_PROSPECTOR_SCANNER_ACCEPT_LIST)
+/* ========== Filter Accept List ========== */
+/* Alternates between a short unfiltered discovery window and long filtered
+ * stretches that only pass known keyboards (and their SCAN_RSP). Runs on
+ * the system work queue like scanner_stub.c's process_work, so keyboards[]
+ * is read from its owning context. The list can only change while the
+ * scan is stopped, which costs one short gap per switch. */
+
+#define DISCOVERY_INTERVAL_MS (CONFIG_PROSPECTOR_SCANNER_DISCOVERY_INTERVAL_S * 1000)
+#define DISCOVERY_WINDOW_MS   CONFIG_PROSPECTOR_SCANNER_DISCOVERY_WINDOW_MS
+
+static bool scan_filtered = false;
+
+static void accept_list_work_handler(struct k_work *work);
+static K_WORK_DELAYABLE_DEFINE(accept_list_work, accept_list_work_handler);
+
+/* Load known keyboards (active, or remembered from before a reboot) into
+ * the accept list. Returns the number added, or 0 if any of them can't be
+ * filtered by address (RPA changes). */
+static int accept_list_load(void) {
+    int added = 0;
+
+    bt_le_filter_accept_list_clear();
+    for (int i = 0; i < ZMK_STATUS_SCANNER_MAX_KEYBOARDS; i++) {
+        bt_addr_le_t addr;
+        if (!scanner_get_keyboard_address(i, addr.a.val, &addr.type)) {
+            continue;
         }
 
-        uint8_t ad_type = net_buf_simple_pull_u8(&buf_copy);
-        len--;
+        if (addr.type == BT_ADDR_LE_RANDOM && !BT_ADDR_IS_STATIC(&addr.a)) {
+            LOG_DBG("Slot %d uses a private address - staying unfiltered", i);
+            return 0;
+        }
 
-        /* Extract device name */
-        if ((ad_type == BT_DATA_NAME_COMPLETE || ad_type == BT_DATA_NAME_SHORTENED) && len > 0) {
-            char device_name[32];
-            memcpy(device_name, buf_copy.data, MIN(len, sizeof(device_name) - 1));
-            device_name[MIN(len, sizeof(device_name) - 1)] = '\0';
+        int err = bt_le_filter_accept_list_add(&addr);
+        if (err) {
+            LOG_WRN("Accept list add failed for slot %d: %d", i, err);
+            return 0;
+        }
+        added++;
+    }
+    return added;
+}
+
+static void accept_list_work_handler(struct k_work *work) {
+    ARG_UNUSED(work);
+
+    if (!scanning) {
+        return;
+    }
+
+    /* Both directions restart the scan: stop, (re)load, start */
+    int err = bt_le_scan_stop();
+    if (err && err != -EALREADY) {
+        LOG_WRN("Accept list: scan stop failed: %d", err);
+        k_work_schedule(&accept_list_work, K_SECONDS(1));
+        return;
+    }
+
+    bool filter = !scan_filtered && accept_list_load() > 0;
+    err = scan_start(filter);
+    if (err && filter) {
+        LOG_WRN("Filtered scan failed (%d) - falling back to unfiltered", err);
+        filter = false;
+        err = scan_start(false);
+    }
+    if (err) {
+        LOG_ERR("Failed to restart scanning: %d", err);
+        k_work_schedule(&accept_list_work, K_SECONDS(1));
+        return;
+    }
+
+    scan_filtered = filter;
+    if (filter) {
+        LOG_DBG("Accept list active - next discovery in %ds",
+                CONFIG_PROSPECTOR_SCANNER_DISCOVERY_INTERVAL_S);
+        k_work_schedule(&accept_list_work, K_MSEC(DISCOVERY_INTERVAL_MS));
+    } else {
+        LOG_DBG("Discovery window (%dms)", DISCOVERY_WINDOW_MS);
+        k_work_schedule(&accept_list_work, K_MSEC(DISCOVERY_WINDOW_MS));
+    }
+}
+#endif /* CONFIG_PROSPECTOR_SCANNER_ACCEPT_LIST */
+
+#if IS_ENABLED(CONFIG_PROSPECTOR_SCANNER_RELAY)
+/* ========== Relay ========== */
+/* Re-advertises the keyboards heard at PROSPECTOR_SCANNER_RELAY_MIN_RSSI
+ * or better for scanners built with PROSPECTOR_SCANNER_RELAY_LISTEN, one
+ * keyboard per RELAY_ROTATE_MS on a non-connectable, non-scannable
+ * extended set. Keyboards whose status changed go first, unless another
+ * one has waited RELAY_CHANGE_BONUS_MS longer. Listeners scan passively,
+ * so this scanner is the only one still sending scan requests to the
+ * keyboards. Runs on the system work queue and only reads keyboards[]
+ * through snapshots. */
+
+#define RELAY_ROTATE_MS       100
+#define RELAY_IDLE_MS         1000  /* Poll period while nothing is relayed */
+#define RELAY_STALE_MS        5000  /* Not heard for this long: stop relaying */
+#define RELAY_CHANGE_BONUS_MS 500
+#define RELAY_RSSI_HYST_DB    5     /* Below the threshold before a relayed keyboard is dropped */
+
+static struct {
+    bool relaying;     /* Heard well enough (with hysteresis) */
+    bool changed;      /* Status changed since it was last advertised */
+    uint32_t gen;      /* scanner_keyboard_generation() at the last look */
+    uint32_t heard_at;
+    uint32_t sent_at;
+    struct zmk_status_adv_data data;  /* Status as last advertised */
+} relay_slots[ZMK_STATUS_SCANNER_MAX_KEYBOARDS];
 
-            LOG_DBG("%s packet - %s name (len=%d): '%s'",
-                   (type & BT_HCI_LE_ADV_EVT_TYPE_SCAN_RSP) ? "SCAN_RSP" : "ADV",
-                   (ad_type == BT_DATA_NAME_COMPLETE) ? "COMPLETE" : "SHORTENED",
-                   len, device_name);
+static struct bt_le_ext_adv *relay_adv_set = NULL;
+static bool relay_adv_running = false;
+static uint8_t relay_payload[ZMK_STATUS_ADV_EXT_MAX_LEN];
+static struct bt_data relay_ad[] = {
+    BT_DATA(BT_DATA_MANUFACTURER_DATA, relay_payload, 0),  /* Length set by relay_build() */
+};
 
-            if (ad_type == BT_DATA_NAME_SHORTENED && strncmp(device_name, "LalaPad", 7) == 0) {
-                strcpy(device_name, "LalaPadmini");
-                LOG_INF("Expanded shortened name to: %s", device_name);
+/* 2-3 ADV events per keyboard and turn */
+static const struct bt_le_adv_param relay_adv_params = {
+    .id = BT_ID_DEFAULT,
+    .options = BT_LE_ADV_OPT_EXT_ADV | BT_LE_ADV_OPT_NO_2M,
+    .interval_min = BT_GAP_ADV_FAST_INT_MIN_1,  /* 30ms */
+    .interval_max = BT_GAP_ADV_FAST_INT_MAX_1,  /* 60ms */
+};
+
+static void relay_work_handler(struct k_work *work);
+static K_WORK_DELAYABLE_DEFINE(relay_work, relay_work_handler);
+
+static int8_t relay_rssi_of(const struct zmk_keyboard_status *kbd) {
+#if IS_ENABLED(CONFIG_PROSPECTOR_LINK_STATS)
+    if (kbd->link.frames > 0) {
+        return prospector_link_stats_rssi(&kbd->link);
+    }
+#endif
+    return kbd->rssi;
+}
+
+/* Append one TLV record; records that don't fit are dropped */
+static size_t relay_put_tlv(size_t pos, uint8_t type, const void *value, size_t len) {
+    if (pos + 2 + len > sizeof(relay_payload)) {
+        return pos;
+    }
+    relay_payload[pos++] = type;
+    relay_payload[pos++] = (uint8_t)len;
+    memcpy(&relay_payload[pos], value, len);
+    return pos + len;
+}
+
+static void relay_build(const struct zmk_keyboard_status *kbd, uint32_t now) {
+    struct zmk_status_adv_relay_origin origin = {
+        .addr_type = kbd->ble_addr_type,
+        .rssi = relay_rssi_of(kbd),
+        .relay_channel = CONFIG_PROSPECTOR_SCANNER_RELAY_CHANNEL,
+    };
+    size_t pos = 0;
+
+    memcpy(origin.addr, kbd->ble_addr, sizeof(origin.addr));
+    relay_payload[pos++] = 0xFF;
+    relay_payload[pos++] = 0xFF;
+    relay_payload[pos++] = (ZMK_STATUS_ADV_RELAY_SERVICE_UUID >> 8) & 0xFF;
+    relay_payload[pos++] = ZMK_STATUS_ADV_RELAY_SERVICE_UUID & 0xFF;
+    relay_payload[pos++] = ZMK_STATUS_ADV_EXT_FORMAT;
+
+    pos = relay_put_tlv(pos, ZMK_STATUS_ADV_TLV_RELAY_ORIGIN, &origin, sizeof(origin));
+    pos = relay_put_tlv(pos, ZMK_STATUS_ADV_TLV_CORE, &kbd->data, sizeof(kbd->data));
+    char name[ZMK_KEYBOARD_NAME_MAX + 1];
+    size_t name_len = zmk_keyboard_name_copy(kbd->name, name, sizeof(name));
+    if (name_len > 0) {
+        pos = relay_put_tlv(pos, ZMK_STATUS_ADV_TLV_KEYBOARD_NAME, name, name_len);
+    }
+
+    /* Listeners get no static packet: send the active layer's name from it */
+    const char *layer_name = kbd->ext.layer_name;
+    uint8_t layer_count = kbd->ext.layer_count;
+    uint8_t layer = kbd->data.active_layer;
+    if (kbd->static_info.hash != 0) {
+        if (layer_name[0] == '\0' && layer < kbd->static_info.layer_count &&
+            layer < ZMK_STATUS_ADV_STATIC_MAX_LAYERS) {
+            layer_name = kbd->static_info.layer_names[layer];
+        }
+        if (layer_count == 0) {
+            layer_count = kbd->static_info.layer_count;
+        }
+    }
+    if (layer_name[0] != '\0') {
+        pos = relay_put_tlv(pos, ZMK_STATUS_ADV_TLV_LAYER_NAME, layer_name,
+                            strnlen(layer_name, ZMK_STATUS_ADV_EXT_LAYER_NAME_MAX));
+    }
+    if (layer_count > 0) {
+        pos = relay_put_tlv(pos, ZMK_STATUS_ADV_TLV_LAYER_COUNT, &layer_count, 1);
+    }
+
+    uint8_t link_record[2 * ARRAY_SIZE(kbd->ext.peripheral_rssi)];
+    bool has_link = false;
+    for (size_t i = 0; i < ARRAY_SIZE(kbd->ext.peripheral_rssi); i++) {
+        link_record[2 * i] = (uint8_t)kbd->ext.peripheral_rssi[i];
+        link_record[2 * i + 1] = kbd->ext.peripheral_reconnects[i];
+        has_link |= link_record[2 * i] != 0 || link_record[2 * i + 1] != 0;
+    }
+    if (has_link) {
+        pos = relay_put_tlv(pos, ZMK_STATUS_ADV_TLV_SPLIT_LINK, link_record, sizeof(link_record));
+    }
+
+    if (kbd->ext.has_seq) {
+        /* Keyboard's own seq, so listeners filter repeats and count loss
+         * as usual; the age grows by the time spent here */
+        uint32_t age_ms = MIN(kbd->ext.age_ms + (now - kbd->last_seen),
+                              ZMK_STATUS_ADV_PACKED_AGE_MAX);
+        uint8_t seq_record[3] = {kbd->ext.seq, age_ms & 0xFF, age_ms >> 8};
+        pos = relay_put_tlv(pos, ZMK_STATUS_ADV_TLV_SEQUENCE, seq_record, sizeof(seq_record));
+    }
+
+    relay_ad[0].data_len = pos;
+}
+
+/* Take a fresh look at a slot whose generation moved */
+static void relay_slot_refresh(int i) {
+    struct zmk_keyboard_status kbd;
+
+    if (!scanner_snapshot_keyboard(i, &kbd, NULL)) {
+        relay_slots[i].relaying = false;
+        return;
+    }
+
+    int8_t rssi = relay_rssi_of(&kbd);
+    int threshold = CONFIG_PROSPECTOR_SCANNER_RELAY_MIN_RSSI -
+                    (relay_slots[i].relaying ? RELAY_RSSI_HYST_DB : 0);
+    bool relaying = rssi >= threshold;
+    if (relaying != relay_slots[i].relaying) {
+        LOG_INF("📡 Relay %s keyboard %d '%s' (%ddBm)", relaying ? "forwards" : "drops",
+                i, zmk_keyboard_name_str(kbd.name), rssi);
+    }
+    relay_slots[i].relaying = relaying;
+    relay_slots[i].heard_at = kbd.last_seen;
+    if (memcmp(&kbd.data, &relay_slots[i].data, sizeof(kbd.data)) != 0) {
+        relay_slots[i].changed = true;
+    }
+}
+
+static void relay_adv_stop(void) {
+    if (relay_adv_set && relay_adv_running) {
+        bt_le_ext_adv_stop(relay_adv_set);
+        relay_adv_running = false;
+        LOG_INF("📡 Relay ADV stopped");
+    }
+}
+
+static void relay_work_handler(struct k_work *work) {
+    ARG_UNUSED(work);
+    uint32_t now = k_uptime_get_32();
+    int next = -1;
+    uint32_t next_wait = 0;
+
+    if (!scanning) {
+        return;
+    }
+
+    for (int i = 0; i < ZMK_STATUS_SCANNER_MAX_KEYBOARDS; i++) {
+        uint32_t gen = scanner_keyboard_generation(i);
+        if (gen != relay_slots[i].gen) {
+            relay_slots[i].gen = gen;
+            relay_slot_refresh(i);
+        }
+        if (relay_slots[i].relaying && (now - relay_slots[i].heard_at) >= RELAY_STALE_MS) {
+            LOG_INF("📡 Relay drops keyboard %d (not heard for %dms)", i, RELAY_STALE_MS);
+            relay_slots[i].relaying = false;
+        }
+        if (!relay_slots[i].relaying) {
+            continue;
+        }
+
+        uint32_t wait = (now - relay_slots[i].sent_at) +
+                        (relay_slots[i].changed ? RELAY_CHANGE_BONUS_MS : 0);
+        if (next < 0 || wait > next_wait) {
+            next = i;
+            next_wait = wait;
+        }
+    }
+
+    struct zmk_keyboard_status kbd;
+    if (next < 0 || !scanner_snapshot_keyboard(next, &kbd, NULL)) {
+        relay_adv_stop();
+        k_work_schedule(&relay_work, K_MSEC(RELAY_IDLE_MS));
+        return;
+    }
+
+    if (!relay_adv_set) {
+        int err = bt_le_ext_adv_create(&relay_adv_params, NULL, &relay_adv_set);
+        if (err) {
+            LOG_WRN("Failed to create relay ADV set: %d (CONFIG_BT_EXT_ADV_MAX_ADV_SET?)", err);
+            relay_adv_set = NULL;
+            k_work_schedule(&relay_work, K_MSEC(RELAY_IDLE_MS));
+            return;
+        }
+    }
+
+    relay_build(&kbd, now);
+    int err = bt_le_ext_adv_set_data(relay_adv_set, relay_ad, ARRAY_SIZE(relay_ad), NULL, 0);
+    if (err) {
+        LOG_DBG("Relay ADV data update error: %d", err);
+    } else {
+        relay_slots[next].sent_at = now;
+        relay_slots[next].changed = false;
+        relay_slots[next].data = kbd.data;
+        if (!relay_adv_running) {
+            err = bt_le_ext_adv_start(relay_adv_set, BT_LE_EXT_ADV_START_DEFAULT);
+            if (err == 0 || err == -EALREADY) {
+                relay_adv_running = true;
+                LOG_INF("📡 Relay ADV started (relay channel %d)",
+                        CONFIG_PROSPECTOR_SCANNER_RELAY_CHANNEL);
+            } else {
+                LOG_WRN("Failed to start relay ADV: %d", err);
             }
+        }
+    }
+    k_work_schedule(&relay_work, K_MSEC(RELAY_ROTATE_MS));
+}
+#endif /* CONFIG_PROSPECTOR_SCANNER_RELAY */
+
+#if IS_ENABLED(CONFIG_PROSPECTOR_SCANNER_PERIODIC_SYNC)
+/* ========== Periodic Advertising Sync ========== */
+/* Keyboards built with CONFIG_ZMK_STATUS_ADV_PERIODIC announce a periodic
+ * train in their extended ADV. Verified keyboards get a sync, up to
+ * CONFIG_BT_PER_ADV_SYNC_MAX; their frames then arrive at the train's
+ * events through process_report(). Once every slot is synced the scan
+ * stops and the radio only wakes for those events; a lost sync starts
+ * it again. The BT RX thread offers candidates, the system work queue
+ * creates syncs (one pending at a time) and starts/stops the scan. */
 
-            store_device_name(addr, device_name);
+#define SYNC_LOSS_EVENTS 6     /* Missed train events before a sync counts as lost */
+#define SYNC_CREATE_MS   5000  /* Give up on a sync that doesn't establish */
+
+static struct {
+    struct bt_le_per_adv_sync *sync;  /* NULL: slot free */
+    bt_addr_le_t addr;
+    bool established;
+} sync_slots[CONFIG_BT_PER_ADV_SYNC_MAX];
+
+static struct {
+    bool valid;
+    bt_addr_le_t addr;
+    uint8_t sid;
+    uint16_t interval;  /* 1.25ms units */
+} sync_candidate;
+
+static struct k_spinlock sync_lock;  /* sync_slots[] and sync_candidate */
+static bool sync_paused_scan;        /* Work queue only */
+static uint32_t sync_create_at;      /* Work queue only */
+
+static void sync_work_handler(struct k_work *work);
+static K_WORK_DELAYABLE_DEFINE(sync_work, sync_work_handler);
+
+static int sync_slot_of(const struct bt_le_per_adv_sync *sync) {
+    for (int i = 0; i < ARRAY_SIZE(sync_slots); i++) {
+        if (sync_slots[i].sync == sync) {
+            return i;
         }
+    }
+    return -1;
+}
 
-        /* Check for Prospector manufacturer data */
-        if (ad_type == BT_DATA_MANUFACTURER_DATA) {
-            if (len >= sizeof(struct zmk_status_adv_data)) {
-                const struct zmk_status_adv_data *data = (const struct zmk_status_adv_data *)buf_copy.data;
+/* BT RX thread: extended reports with a periodic train (interval != 0) */
+static void sync_scan_recv(const struct bt_le_scan_recv_info *info, struct net_buf_simple *buf) {
+    ARG_UNUSED(buf);
+    if (info->interval == 0 || !scanning) {
+        return;
+    }
+    int idx = find_device(info->addr);
+    if (idx < 0 || !device_cache[idx].verified) {
+        return;  /* Not a Prospector keyboard (yet) */
+    }
 
-                if (data->manufacturer_id[0] == 0xFF && data->manufacturer_id[1] == 0xFF &&
-                    data->service_uuid[0] == 0xAB && data->service_uuid[1] == 0xCD) {
+    bool offered = false;
+    K_SPINLOCK(&sync_lock) {
+        bool known = false;
+        bool room = false;
+        for (int i = 0; i < ARRAY_SIZE(sync_slots); i++) {
+            if (!sync_slots[i].sync) {
+                room = true;
+            } else if (bt_addr_le_cmp(&sync_slots[i].addr, info->addr) == 0) {
+                known = true;
+            }
+        }
+        if (!known && room && !sync_candidate.valid) {
+            bt_addr_le_copy(&sync_candidate.addr, info->addr);
+            sync_candidate.sid = info->sid;
+            sync_candidate.interval = info->interval;
+            sync_candidate.valid = true;
+            offered = true;
+        }
+    }
+    if (offered) {
+        k_work_reschedule(&sync_work, K_NO_WAIT);
+    }
+}
 
-                    LOG_DBG("Prospector data found - Length: %d", len);
+static struct bt_le_scan_cb sync_scan_cb = {
+    .recv = sync_scan_recv,
+};
 
-                    /* Channel filtering */
-                    extern uint8_t scanner_get_runtime_channel(void) __attribute__((weak));
-                    uint8_t scanner_channel = 0;
-                    if (scanner_get_runtime_channel) {
-                        scanner_channel = scanner_get_runtime_channel();
-                    }
-#ifdef CONFIG_PROSPECTOR_SCANNER_CHANNEL
-                    else {
-                        scanner_channel = CONFIG_PROSPECTOR_SCANNER_CHANNEL;
-                    }
-#endif
-                    uint8_t keyboard_channel = data->channel;
-
-                    bool channel_match = (scanner_channel == 0 ||
-                                        scanner_channel >= 10 ||
-                                        keyboard_channel == 0 ||
-                                        scanner_channel == keyboard_channel);
-
-                    if (channel_match) {
-                        prospector_data = data;
-                        LOG_DBG("Valid Prospector data: Ch:%d->%d Ver=%d Bat=%d%%",
-                               keyboard_channel, scanner_channel, data->version, data->battery_level);
-                    } else {
-                        LOG_DBG("Channel mismatch - KB Ch:%d, Scanner Ch:%d (filtered)",
-                                keyboard_channel, scanner_channel);
-                    }
-                } else {
-                    LOG_DBG("Non-Prospector device: %02X%02X %02X%02X",
-                           data->manufacturer_id[0], data->manufacturer_id[1],
-                           data->service_uuid[0], data->service_uuid[1]);
-                }
+static void sync_synced(struct bt_le_per_adv_sync *sync,
+                        struct bt_le_per_adv_sync_synced_info *info) {
+    K_SPINLOCK(&sync_lock) {
+        int i = sync_slot_of(sync);
+        if (i >= 0) {
+            sync_slots[i].established = true;
+        }
+    }
+    LOG_INF("📶 Synced to periodic train (SID %u, %ums)", info->sid, info->interval * 5 / 4);
+    k_work_reschedule(&sync_work, K_NO_WAIT);
+}
+
+static void sync_term(struct bt_le_per_adv_sync *sync,
+                      const struct bt_le_per_adv_sync_term_info *info) {
+    bool ours = false;
+    K_SPINLOCK(&sync_lock) {
+        int i = sync_slot_of(sync);
+        if (i >= 0) {
+            sync_slots[i].sync = NULL;
+            sync_slots[i].established = false;
+            ours = true;
+        }
+    }
+    if (ours) {
+        LOG_INF("📶 Periodic sync lost (reason 0x%02x)", info->reason);
+        k_work_reschedule(&sync_work, K_NO_WAIT);
+    }
+}
+
+static void sync_recv(struct bt_le_per_adv_sync *sync,
+                      const struct bt_le_per_adv_sync_recv_info *info,
+                      struct net_buf_simple *buf) {
+    ARG_UNUSED(sync);
+    process_report(info->addr, info->rssi, BT_GAP_ADV_TYPE_EXT_ADV, buf);
+}
+
+static struct bt_le_per_adv_sync_cb sync_cb = {
+    .synced = sync_synced,
+    .term = sync_term,
+    .recv = sync_recv,
+};
+
+/* Work queue: create the offered sync */
+static void sync_create(int slot, const bt_addr_le_t *addr, uint8_t sid, uint16_t interval,
+                        uint32_t now) {
+    /* Interval is in 1.25ms units, the timeout in 10ms units */
+    uint32_t timeout = interval * 5 / 4 * SYNC_LOSS_EVENTS / 10;
+    struct bt_le_per_adv_sync_param param = {
+        .sid = sid,
+        .skip = 0,
+        .timeout = CLAMP(timeout, BT_GAP_PER_ADV_MIN_TIMEOUT, BT_GAP_PER_ADV_MAX_TIMEOUT),
+    };
+    struct bt_le_per_adv_sync *sync = NULL;
+
+    bt_addr_le_copy(&param.addr, addr);
+    int err = bt_le_per_adv_sync_create(&param, &sync);
+    if (err) {
+        LOG_WRN("Periodic sync create failed: %d", err);
+        return;
+    }
+    K_SPINLOCK(&sync_lock) {
+        sync_slots[slot].sync = sync;
+        sync_slots[slot].addr = *addr;
+        sync_slots[slot].established = false;
+    }
+    sync_create_at = now;
+}
+
+static void sync_work_handler(struct k_work *work) {
+    ARG_UNUSED(work);
+    uint32_t now = k_uptime_get_32();
+    int free_slot = -1;
+    int pending = -1;
+    int established = 0;
+    bool have_candidate;
+    bt_addr_le_t addr;
+    uint8_t sid = 0;
+    uint16_t interval = 0;
+
+    K_SPINLOCK(&sync_lock) {
+        for (int i = 0; i < ARRAY_SIZE(sync_slots); i++) {
+            if (!sync_slots[i].sync) {
+                free_slot = i;
+            } else if (sync_slots[i].established) {
+                established++;
             } else {
-                LOG_DBG("Manufacturer data too short: %d bytes", len);
+                pending = i;
             }
         }
+        have_candidate = sync_candidate.valid;
+        addr = sync_candidate.addr;
+        sid = sync_candidate.sid;
+        interval = sync_candidate.interval;
+        sync_candidate.valid = false;
+    }
+
+    if (pending >= 0 && now - sync_create_at >= SYNC_CREATE_MS) {
+        /* Keyboard gone or out of range: cancel, try later candidates */
+        struct bt_le_per_adv_sync *stale;
+        K_SPINLOCK(&sync_lock) {
+            stale = sync_slots[pending].sync;
+            sync_slots[pending].sync = NULL;
+        }
+        if (stale) {
+            bt_le_per_adv_sync_delete(stale);
+        }
+        LOG_DBG("Periodic sync not established - cancelled");
+        free_slot = pending;
+        pending = -1;
+    }
+    if (have_candidate && pending < 0 && free_slot >= 0) {
+        sync_create(free_slot, &addr, sid, interval, now);
+        pending = free_slot;
+    }
 
+    /* Every slot synced: nothing left to scan for */
+    if (established == ARRAY_SIZE(sync_slots) && !sync_paused_scan) {
+        zmk_status_scanner_stop();
+        sync_paused_scan = true;
+        LOG_INF("📶 All periodic syncs up - scanning stopped");
+    } else if (established < ARRAY_SIZE(sync_slots) && sync_paused_scan) {
+        sync_paused_scan = false;
+        zmk_status_scanner_start();
+    }
+
+    if (pending >= 0) {
+        k_work_reschedule(&sync_work, K_MSEC(SYNC_CREATE_MS));
+    }
+}
+#endif /* CONFIG_PROSPECTOR_SCANNER_PERIODIC_SYNC */
+
+#if IS_ENABLED(CONFIG_PROSPECTOR_SCANNER_PARSE_BENCH)
+/* ========== Parser Micro-Benchmark ========== */
+/* Hand-written AD payloads in common advertiser formats, run through the
+ * old copy-and-walk loop (reconstructed below) and through ad_scan() plus
+ * the reject decision. Logs cycles per packet once at boot. */
+
+static const uint8_t bench_ibeacon[] = {
+    0x02, 0x01, 0x06, 0x1A, 0xFF, 0x4C, 0x00, 0x02, 0x15, 0xE2, 0xC5, 0x6D, 0xB5, 0xDF, 0xFB,
+    0x48, 0xD2, 0xB0, 0x60, 0xD0, 0xF5, 0xA7, 0x10, 0x96, 0xE0, 0x00, 0x01, 0x00, 0x02, 0xC5,
+};
+static const uint8_t bench_apple_nearby[] = {
+    0x02, 0x01, 0x1A, 0x02, 0x0A, 0x0C, 0x0A, 0xFF, 0x4C, 0x00, 0x10, 0x05, 0x01, 0x18, 0x1C,
+    0x2E, 0x4F,
+};
+static const uint8_t bench_mouse[] = {
+    0x02, 0x01, 0x06, 0x03, 0x03, 0x12, 0x18, 0x03, 0x19, 0xC2, 0x03, 0x0D, 0x09, 'M', 'X',
+    ' ', 'M', 'a', 's', 't', 'e', 'r', ' ', '3', 'S',
+};
+static const uint8_t bench_fast_pair[] = {
+    0x02, 0x01, 0x06, 0x06, 0x16, 0x2C, 0xFE, 0x00, 0x0C, 0x7E, 0x03, 0x02, 0x0A, 0xF4,
+};
+static const uint8_t bench_scan_rsp[] = {
+    0x0D, 0x09, 'M', 'a', 'c', 'B', 'o', 'o', 'k', ' ', 'P', 'r', 'o', '6',
+};
+static const uint8_t bench_prospector[] = {
+    0x02, 0x01, 0x06, 0x1B, 0xFF, 0xFF, 0xFF, 0xAB, 0xCD, 0x22, 0x55, 0x01, 0x11, 0x02, 0x3B,
+    0x01, 0x00, 0x5A, 0x00, 0x00, 'N', 'A', 'V', 0x00, 0x12, 0x34, 0x56, 0x78, 0x00, 0x2A,
+    0x00,
+};
+
+static const struct {
+    const uint8_t *data;
+    uint8_t len;
+} bench_packets[] = {
+    {bench_ibeacon, sizeof(bench_ibeacon)},
+    {bench_apple_nearby, sizeof(bench_apple_nearby)},
+    {bench_mouse, sizeof(bench_mouse)},
+    {bench_fast_pair, sizeof(bench_fast_pair)},
+    {bench_scan_rsp, sizeof(bench_scan_rsp)},
+    {bench_prospector, sizeof(bench_prospector)},
+};
+
+#define BENCH_ROUNDS 200
+
+static volatile uint32_t bench_sink;
+
+/* Per-packet work of the previous scan_callback loop up to its decision */
+static void bench_old_walk(const bt_addr_le_t *addr, struct net_buf_simple *buf) {
+    struct net_buf_simple buf_copy = *buf;
+    while (buf_copy.len > 1) {
+        uint8_t len = net_buf_simple_pull_u8(&buf_copy);
+        if (len == 0 || len > buf_copy.len) {
+            break;
+        }
+        uint8_t ad_type = net_buf_simple_pull_u8(&buf_copy);
+        len--;
+        if ((ad_type == BT_DATA_NAME_COMPLETE || ad_type == BT_DATA_NAME_SHORTENED) && len > 0) {
+            char device_name[32];
+            memcpy(device_name, buf_copy.data, MIN(len, sizeof(device_name) - 1));
+            device_name[MIN(len, sizeof(device_name) - 1)] = '\0';
+            bench_sink += (uint32_t)strncmp(device_name, "LalaPad", 7);
+            /* store_device_name() lookup of the old 5-entry linear cache */
+            for (int i = 0; i < MIN(5, DEVICE_CACHE_SIZE); i++) {
+                bench_sink += (uint32_t)bt_addr_le_cmp(&device_cache[i].addr, addr);
+            }
+        }
+        if (ad_type == BT_DATA_MANUFACTURER_DATA && len >= 4 &&
+            buf_copy.data[0] == 0xFF && buf_copy.data[1] == 0xFF && buf_copy.data[2] == 0xAB) {
+            bench_sink += scanner_channel_get();
+        }
         net_buf_simple_pull(&buf_copy, len);
     }
+}
 
-    /* Push to ring buffer for LVGL timer to process */
-    if (prospector_data) {
-        LOG_DBG("Central=%d%%, Peripheral=[%d,%d,%d], Layer=%d",
-               prospector_data->battery_level, prospector_data->peripheral_battery[0],
-               prospector_data->peripheral_battery[1], prospector_data->peripheral_battery[2],
-               prospector_data->active_layer);
+static void bench_new_scan(const bt_addr_le_t *addr, struct net_buf_simple *buf) {
+    struct ad_scan_result ad;
+    ad_scan(buf->data, buf->len, &ad);
+    if (!ad.md) {
+        if (ad.name) {
+            bench_sink += (uint32_t)find_device(addr);
+        }
+        return;
+    }
+    bench_sink += scanner_channel_get();
+}
 
-        const char *device_name = get_device_name(addr);
-        int ret = scanner_msg_send_keyboard_data(prospector_data, rssi, device_name,
-                                                  addr->a.val, addr->type);
-        if (ret != 0) {
-            LOG_DBG("Ring buffer full, advertisement dropped");
+static uint32_t bench_run(void (*fn)(const bt_addr_le_t *, struct net_buf_simple *)) {
+    const bt_addr_le_t addr = {.type = BT_ADDR_LE_RANDOM,
+                               .a = {.val = {0x11, 0x22, 0x33, 0x44, 0x55, 0xC6}}};
+    uint32_t start = k_cycle_get_32();
+    for (int r = 0; r < BENCH_ROUNDS; r++) {
+        for (size_t i = 0; i < ARRAY_SIZE(bench_packets); i++) {
+            struct net_buf_simple buf;
+            net_buf_simple_init_with_data(&buf, (void *)bench_packets[i].data,
+                                          bench_packets[i].len);
+            fn(&addr, &buf);
         }
     }
+    return (k_cycle_get_32() - start) / (BENCH_ROUNDS * ARRAY_SIZE(bench_packets));
+}
+
+static void parse_bench(void) {
+    unsigned int key = irq_lock();
+    uint32_t old_cycles = bench_run(bench_old_walk);
+    uint32_t new_cycles = bench_run(bench_new_scan);
+    irq_unlock(key);
+
+    LOG_INF("⏱ AD parse bench (%d packets x %d): copy+walk %u cycles/pkt, "
+            "fast-reject %u cycles/pkt (%u Hz clock)",
+            (int)ARRAY_SIZE(bench_packets), BENCH_ROUNDS, old_cycles, new_cycles,
+            sys_clock_hw_cycles_per_sec());
 }
+#endif /* CONFIG_PROSPECTOR_SCANNER_PARSE_BENCH */
 
 /* ========== Public API ========== */
 /* All keyboard state queries delegate to scanner_stub.c (single source of truth) */
 
 int zmk_status_scanner_init(void) {
     LOG_INF("Status scanner initialized (lock-free architecture)");
+#if IS_ENABLED(CONFIG_PROSPECTOR_SCANNER_PARSE_BENCH)
+    parse_bench();
+#endif
     return 0;
 }
 
@@ -205,21 +1222,40 @@ int zmk_status_scanner_start(void) {
         return 0;
     }
 
-    struct bt_le_scan_param scan_param = {
-        .type = BT_LE_SCAN_TYPE_ACTIVE,
-        .options = BT_LE_SCAN_OPT_NONE,
-        .interval = BT_GAP_SCAN_FAST_WINDOW,
-        .window = BT_GAP_SCAN_FAST_WINDOW,
-    };
-
-    int err = bt_le_scan_start(&scan_param, scan_callback);
+    int err = scan_start(false);
     if (err) {
         LOG_ERR("Failed to start scanning: %d", err);
         return err;
     }
 
     scanning = true;
-    LOG_INF("Status scanner started (ACTIVE mode, 100%% duty cycle)");
+#if IS_ENABLED(CONFIG_PROSPECTOR_SCANNER_PERIODIC_SYNC)
+    static bool sync_cb_registered;
+    if (!sync_cb_registered) {
+        bt_le_scan_cb_register(&sync_scan_cb);
+        bt_le_per_adv_sync_cb_register(&sync_cb);
+        sync_cb_registered = true;
+    }
+#endif
+    LOG_INF("Status scanner started (%s mode, %d%% duty cycle%s)",
+            SCAN_TYPE == BT_LE_SCAN_TYPE_ACTIVE ? "ACTIVE" : "PASSIVE relay listener",
+            scan_duty_params[scan_duty].window * 100 / scan_duty_params[scan_duty].interval,
+            IS_ENABLED(CONFIG_PROSPECTOR_SCANNER_EXTENDED_SCAN) ? ", extended" : "");
+#if IS_ENABLED(CONFIG_PROSPECTOR_SCANNER_RELAY)
+    k_work_schedule(&relay_work, K_MSEC(RELAY_IDLE_MS));
+#endif
+#if IS_ENABLED(CONFIG_PROSPECTOR_SCANNER_ACCEPT_LIST)
+    /* Boot is the first discovery window, unless the keyboard registry
+     * already knows who to listen to: then filter right away */
+    scan_filtered = false;
+    bool known = false;
+    for (int i = 0; i < ZMK_STATUS_SCANNER_MAX_KEYBOARDS && !known; i++) {
+        uint8_t addr[6];
+        uint8_t type;
+        known = scanner_get_keyboard_address(i, addr, &type);
+    }
+    k_work_schedule(&accept_list_work, known ? K_NO_WAIT : K_MSEC(DISCOVERY_WINDOW_MS));
+#endif
     return 0;
 }
 
@@ -229,6 +1265,14 @@ int zmk_status_scanner_stop(void) {
     }
 
     scanning = false;
+#if IS_ENABLED(CONFIG_PROSPECTOR_SCANNER_ACCEPT_LIST)
+    k_work_cancel_delayable(&accept_list_work);
+    scan_filtered = false;
+#endif
+#if IS_ENABLED(CONFIG_PROSPECTOR_SCANNER_RELAY)
+    k_work_cancel_delayable(&relay_work);
+    relay_adv_stop();
+#endif
 
     int err = bt_le_scan_stop();
     if (err) {
@@ -240,6 +1284,40 @@ int zmk_status_scanner_stop(void) {
     return 0;
 }
 
+int zmk_status_scanner_set_duty(enum zmk_status_scanner_duty duty) {
+    if (duty >= ARRAY_SIZE(scan_duty_params) || duty == scan_duty) {
+        return 0;
+    }
+
+    enum zmk_status_scanner_duty previous = scan_duty;
+    scan_duty = duty;
+    if (!scanning) {
+        return 0;  // Applied on the next start
+    }
+
+    int err = bt_le_scan_stop();
+    if (err && err != -EALREADY) {
+        LOG_WRN("Duty change: scan stop failed: %d", err);
+        scan_duty = previous;
+        return err;
+    }
+#if IS_ENABLED(CONFIG_PROSPECTOR_SCANNER_ACCEPT_LIST)
+    err = scan_start(scan_filtered);
+#else
+    err = scan_start(false);
+#endif
+    if (err) {
+        /* Keep the old level recorded so the next call retries the restart */
+        LOG_ERR("Duty change: failed to restart scanning: %d", err);
+        scan_duty = previous;
+        return err;
+    }
+
+    LOG_INF("📶 Scan duty: %d%%", scan_duty_params[duty].window * 100 /
+                                   scan_duty_params[duty].interval);
+    return 0;
+}
+
 int zmk_status_scanner_register_callback(zmk_status_scanner_callback_t callback) {
     /* No-op: callbacks removed in lock-free architecture.
      * Display updates via pending_data in scanner_stub.c. */
@@ -251,6 +1329,10 @@ struct zmk_keyboard_status *zmk_status_scanner_get_keyboard(int index) {
     return scanner_get_keyboard_status(index);
 }
 
+bool zmk_status_scanner_copy_keyboard(int index, struct zmk_keyboard_status *out) {
+    return scanner_snapshot_keyboard(index, out, NULL);
+}
+
 int zmk_status_scanner_get_active_count(void) {
     return scanner_get_active_keyboard_count();
 }
@@ -261,9 +1343,9 @@ int zmk_status_scanner_get_primary_keyboard(void) {
     uint32_t latest_seen = 0;
 
     for (int i = 0; i < ZMK_STATUS_SCANNER_MAX_KEYBOARDS; i++) {
-        struct zmk_keyboard_status *kbd = scanner_get_keyboard_status(i);
-        if (kbd && kbd->last_seen > latest_seen) {
-            latest_seen = kbd->last_seen;
+        struct zmk_keyboard_status kbd;
+        if (scanner_snapshot_keyboard(i, &kbd, NULL) && kbd.last_seen > latest_seen) {
+            latest_seen = kbd.last_seen;
             primary = i;
         }
     }